@@ -56,6 +56,12 @@ Methods of initialising KMEANS:
     * INITCLUSTER_DIAGONAL_STDDEV_ATTACH = 4
     * INITCLUSTER_KPP = 5
 
+Methods of sampling image pixels:
+
+    * PXL_SAMPLE_STRIDE = 0
+    * PXL_SAMPLE_RESERVOIR = 1
+    * PXL_SAMPLE_STRATIFIED = 2
+
 
 Methods of calculating distance:
 
@@ -207,6 +213,10 @@ INITCLUSTER_DIAGONAL_FULL_ATTACH = 3
 INITCLUSTER_DIAGONAL_STDDEV_ATTACH = 4
 INITCLUSTER_KPP = 5
 
+PXL_SAMPLE_STRIDE = 0
+PXL_SAMPLE_RESERVOIR = 1
+PXL_SAMPLE_STRATIFIED = 2
+
 SHARP_RES_IGNORE = 0
 SHARP_RES_LOW = 1
 SHARP_RES_HIGH = 2
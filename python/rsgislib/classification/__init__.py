@@ -631,6 +631,7 @@ def split_sample_train_valid_test(
     train_sample=None,
     rnd_seed=42,
     datatype=None,
+    shuffle=False,
 ):
     """
     A function to split a HDF5 samples file (from rsgislib.zonalstats.extract_zone_img_band_values_to_hdf)
@@ -647,63 +648,23 @@ def split_sample_train_valid_test(
     :param rnd_seed: The random seed to be used to randomly select the sub-samples.
     :param datatype: is the data type used for the output HDF5 file (e.g., rsgislib.TYPE_32FLOAT). If None (default)
                      then the output data type will be float32.
+    :param shuffle: if True the rows of the output files are shuffled, otherwise they are in the input order.
 
     """
-    import rsgislib.tools.utils
-    import rsgislib.tools.filetools
     import rsgislib.zonalstats
-    import os
 
-    uid_str = rsgislib.tools.utils.uid_generator()
-    out_dir = os.path.split(os.path.abspath(test_h5_file))[0]
     if datatype is None:
         datatype = rsgislib.TYPE_32FLOAT
-    tmp_train_valid_sample_file = os.path.join(
-        out_dir, "train_valid_tmp_sample_{}.h5".format(uid_str)
-    )
-    rsgislib.zonalstats.split_sample_hdf5_file(
-        in_h5_file,
-        test_h5_file,
-        tmp_train_valid_sample_file,
-        test_sample,
-        rnd_seed,
-        datatype,
+
+    # The three outputs are sampled (without replacement) in a single pass over the input file.
+    rsgislib.zonalstats.split_sample_hdf5_files(
+        [in_h5_file],
+        [test_h5_file, valid_h5_file, train_h5_file],
+        [test_sample, valid_sample, train_sample],
+        rnd_seed=rnd_seed,
+        datatype=datatype,
+        shuffle=shuffle,
     )
-    if train_sample is not None:
-        tmp_train_sample_file = os.path.join(
-            out_dir, "train_tmp_sample_{}.h5".format(uid_str)
-        )
-        rsgislib.zonalstats.split_sample_hdf5_file(
-            tmp_train_valid_sample_file,
-            valid_h5_file,
-            tmp_train_sample_file,
-            valid_sample,
-            rnd_seed,
-            datatype,
-        )
-        tmp_remain_sample_file = os.path.join(
-            out_dir, "remain_tmp_sample_{}.h5".format(uid_str)
-        )
-        rsgislib.zonalstats.split_sample_hdf5_file(
-            tmp_train_sample_file,
-            train_h5_file,
-            tmp_remain_sample_file,
-            train_sample,
-            rnd_seed,
-            datatype,
-        )
-        rsgislib.tools.filetools.delete_file_silent(tmp_train_sample_file)
-        rsgislib.tools.filetools.delete_file_silent(tmp_remain_sample_file)
-    else:
-        rsgislib.zonalstats.split_sample_hdf5_file(
-            tmp_train_valid_sample_file,
-            valid_h5_file,
-            train_h5_file,
-            valid_sample,
-            rnd_seed,
-            datatype,
-        )
-    rsgislib.tools.filetools.delete_file_silent(tmp_train_valid_sample_file)
 
 
 def split_chip_sample_train_valid_test(
@@ -430,6 +430,65 @@ def apply_sklearn_classifier(
         rat_dataset = None
 
 
+def export_sklearn_tree_ensemble(sk_classifier: BaseEstimator, out_mdl_file: str):
+    """
+    A function which exports a trained scikit-learn random forest or extra trees
+    classifier (or a single decision tree) to the rsgislib tree ensemble text
+    format so it can be applied to an image, across threads, using
+    rsgislib.classification.apply_tree_ensemble_classifier. As predict_proba,
+    the class probabilities are the mean over the trees of the class fractions
+    of the leaves and the class indexes are in the order of
+    sk_classifier.classes_.
+
+    :param sk_classifier: a trained instance of a scikit-learn
+                          RandomForestClassifier, ExtraTreesClassifier or
+                          DecisionTreeClassifier.
+    :param out_mdl_file: the output file path.
+
+    """
+    if hasattr(sk_classifier, "estimators_"):
+        estimators = sk_classifier.estimators_
+    elif hasattr(sk_classifier, "tree_"):
+        estimators = [sk_classifier]
+    else:
+        raise rsgislib.RSGISPyException(
+            "The classifier must be a trained scikit-learn forest or decision tree."
+        )
+    if getattr(sk_classifier, "n_outputs_", 1) != 1:
+        raise rsgislib.RSGISPyException("Multi-output classifiers are not supported.")
+    n_classes = len(sk_classifier.classes_)
+
+    def _vals_str(vals):
+        return " ".join([str(val) for val in vals.tolist()])
+
+    with open(out_mdl_file, "w") as out_file:
+        out_file.write("rsgislib_tree_ensemble\n")
+        out_file.write("ensemble_type=average\n")
+        out_file.write("num_features={}\n".format(sk_classifier.n_features_in_))
+        out_file.write("num_classes={}\n".format(n_classes))
+        out_file.write("output_transform=none\n")
+        out_file.write("split_compare=le\n\n")
+        for i, estimator in enumerate(estimators):
+            tree = estimator.tree_
+            leaves = tree.children_left < 0
+            split_feature = numpy.where(leaves, -1, tree.feature)
+            leaf_vals = tree.value[leaves, 0, :].astype(numpy.float64)
+            leaf_sums = leaf_vals.sum(axis=1, keepdims=True)
+            leaf_sums[leaf_sums == 0] = 1
+            leaf_vals = leaf_vals / leaf_sums
+            if hasattr(tree, "missing_go_to_left"):
+                default_left = tree.missing_go_to_left.astype(numpy.int32)
+            else:
+                default_left = numpy.zeros_like(split_feature)
+            out_file.write("Tree={}\n".format(i))
+            out_file.write("split_feature={}\n".format(_vals_str(split_feature)))
+            out_file.write("threshold={}\n".format(_vals_str(tree.threshold)))
+            out_file.write("left_child={}\n".format(_vals_str(tree.children_left)))
+            out_file.write("right_child={}\n".format(_vals_str(tree.children_right)))
+            out_file.write("default_left={}\n".format(_vals_str(default_left)))
+            out_file.write("leaf_value={}\n\n".format(_vals_str(leaf_vals.flatten())))
+
+
 def apply_sklearn_classifier_rat(
     clumps_img: str,
     variables: List[str],
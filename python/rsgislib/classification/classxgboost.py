@@ -63,6 +63,7 @@ from sklearn.metrics import accuracy_score
 import gc
 
 import json
+import math
 
 
 def optimise_xgboost_binary_classifier(
@@ -1525,3 +1526,105 @@ def apply_xgboost_multiclass_classifier_rat(
     ratapplier.apply(
         _apply_rat_classifier, in_rats, out_rats, otherargs=otherargs, controls=None
     )
+
+
+def export_xgboost_tree_ensemble(xgb_mdl, out_mdl_file: str):
+    """
+    A function which exports a trained xgboost classifier (binary:logistic,
+    binary:logitraw, multi:softprob or multi:softmax objectives, gbtree booster
+    without categorical splits) to the rsgislib tree ensemble text format so it
+    can be applied to an image, across threads, using
+    rsgislib.classification.apply_tree_ensemble_classifier. Binary models have
+    two classes, where the second class is the positive class.
+
+    :param xgb_mdl: a trained xgboost Booster or XGBClassifier or the file path of
+                    a saved model which can be loaded with xgb.Booster(model_file=...).
+    :param out_mdl_file: the output file path.
+
+    """
+    if not HAVE_XGBOOST:
+        raise rsgislib.RSGISPyException("Do not have xgboost module installed.")
+
+    if isinstance(xgb_mdl, str):
+        booster = xgb.Booster(model_file=xgb_mdl)
+    elif hasattr(xgb_mdl, "get_booster"):
+        booster = xgb_mdl.get_booster()
+    else:
+        booster = xgb_mdl
+    model = json.loads(booster.save_raw(raw_format="json"))
+
+    learner = model["learner"]
+    num_class = int(learner["learner_model_param"]["num_class"])
+    num_feature = int(learner["learner_model_param"]["num_feature"])
+    base_score = float(
+        str(learner["learner_model_param"]["base_score"]).strip("[]").split(",")[0]
+    )
+    objective = learner["objective"]["name"]
+    gbooster = learner["gradient_booster"]
+    if gbooster["name"] != "gbtree":
+        raise rsgislib.RSGISPyException(
+            "Only the gbtree booster is supported not '{}'".format(gbooster["name"])
+        )
+
+    if objective in ["binary:logistic", "binary:logitraw"]:
+        n_classes = 2
+        n_outputs = 1
+        out_transform = "sigmoid"
+        if objective == "binary:logistic":
+            # The base score is a probability for the logistic objective.
+            base_score = math.log(base_score / (1.0 - base_score))
+    elif objective in ["multi:softprob", "multi:softmax"]:
+        n_classes = num_class
+        n_outputs = num_class
+        out_transform = "softmax"
+    else:
+        raise rsgislib.RSGISPyException(
+            "Only classification objectives are supported not '{}'".format(objective)
+        )
+
+    def _vals_str(vals):
+        return " ".join([str(val) for val in vals])
+
+    trees = gbooster["model"]["trees"]
+    tree_info = gbooster["model"]["tree_info"]
+    with open(out_mdl_file, "w") as out_file:
+        out_file.write("rsgislib_tree_ensemble\n")
+        out_file.write("ensemble_type=boosted\n")
+        out_file.write("num_features={}\n".format(num_feature))
+        out_file.write("num_classes={}\n".format(n_classes))
+        out_file.write("num_outputs={}\n".format(n_outputs))
+        out_file.write("output_transform={}\n".format(out_transform))
+        out_file.write("base_score={}\n".format(_vals_str([base_score] * n_outputs)))
+        out_file.write("split_compare=lt\n\n")
+        for i, tree in enumerate(trees):
+            if any([split_type != 0 for split_type in tree.get("split_type", [])]):
+                raise rsgislib.RSGISPyException(
+                    "Models with categorical splits are not supported."
+                )
+            left_children = tree["left_children"]
+            split_feature = [
+                -1 if left_child < 0 else split_idx
+                for left_child, split_idx in zip(left_children, tree["split_indices"])
+            ]
+            # For the leaves the split condition is the leaf value.
+            leaf_vals = [
+                split_cond
+                for left_child, split_cond in zip(
+                    left_children, tree["split_conditions"]
+                )
+                if left_child < 0
+            ]
+            out_file.write("Tree={}\n".format(i))
+            out_file.write("tree_class={}\n".format(tree_info[i] if n_outputs > 1 else 0))
+            out_file.write("split_feature={}\n".format(_vals_str(split_feature)))
+            out_file.write(
+                "threshold={}\n".format(_vals_str(tree["split_conditions"]))
+            )
+            out_file.write("left_child={}\n".format(_vals_str(left_children)))
+            out_file.write(
+                "right_child={}\n".format(_vals_str(tree["right_children"]))
+            )
+            out_file.write(
+                "default_left={}\n".format(_vals_str(tree["default_left"]))
+            )
+            out_file.write("leaf_value={}\n\n".format(_vals_str(leaf_vals)))
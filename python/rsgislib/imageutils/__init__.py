@@ -92,6 +92,35 @@ class SharpBandInfo(object):
         self.name = name
 
 
+class BitFieldInfo(object):
+    """
+    Create a list of these objects to pass to the decode_bit_fields function to
+    define the bit fields (e.g., within a QA band) to be decoded.
+
+    :param name: is a name for the bit field, used as the output band name.
+    :param bit_offset: is the index of the first bit of the field (the least
+                       significant bit is 0).
+    :param bit_length: is the number of bits in the field.
+    :param out_band: is the output band (band numbering starts at 1) or, if the
+                     masks are being packed, the output bit + 1.
+
+    """
+
+    def __init__(self, name=None, bit_offset=None, bit_length=1, out_band=None):
+        """
+        :param name: is a name for the bit field, used as the output band name.
+        :param bit_offset: is the index of the first bit of the field (the least
+                           significant bit is 0).
+        :param bit_length: is the number of bits in the field.
+        :param out_band: is the output band (band numbering starts at 1) or, if the
+                         masks are being packed, the output bit + 1.
+        """
+        self.name = name
+        self.bit_offset = bit_offset
+        self.bit_length = bit_length
+        self.out_band = out_band
+
+
 class ImageBandInfo(object):
     """
     Create a list of these objects to pass to functions to specifying individual
@@ -2027,10 +2056,12 @@ def create_img_for_each_vec_feat(
     gdalformat: str,
     datatype: int,
     snap_to_grid: int = False,
-):
+    n_threads: int = 1,
+) -> List[str]:
     """
     A function to create a set of image files representing the extent of each
-    feature in the inputted vector file.
+    feature in the inputted vector file. The layer is read once and the images
+    are created in parallel.
 
     :param vec_file: the input vector file.
     :param vec_lyr: the input vector layer
@@ -2046,59 +2077,23 @@ def create_img_for_each_vec_feat(
                      output image.
     :param snap_to_grid: optional variable to snap the image to a grid of whole
                          numbers with respect to the image pixel resolution.
-    """
-
-    dsVecFile = gdal.OpenEx(vec_file, gdal.OF_VECTOR)
-    if dsVecFile is None:
-        raise rsgislib.RSGISPyException("Could not open '" + vec_file + "'")
-
-    lyrVecObj = dsVecFile.GetLayerByName(vec_lyr)
-    if lyrVecObj is None:
-        raise rsgislib.RSGISPyException("Could not find layer '" + vec_lyr + "'")
-
-    lyrSpatRef = lyrVecObj.GetSpatialRef()
-    if lyrSpatRef is not None:
-        wktstr = lyrSpatRef.ExportToWkt()
-    else:
-        wktstr = ""
-
-    colExists = False
-    feat_idx = 0
-    lyrDefn = lyrVecObj.GetLayerDefn()
-    for i in range(lyrDefn.GetFieldCount()):
-        if lyrDefn.GetFieldDefn(i).GetName().lower() == file_name_col.lower():
-            feat_idx = i
-            colExists = True
-            break
-
-    if not colExists:
-        dsVecFile = None
-        raise rsgislib.RSGISPyException(
-            "The specified column does not exist in the input layer; "
-            "check case as some drivers are case sensitive."
-        )
-
-    lyrVecObj.ResetReading()
-    for feat in lyrVecObj:
-        geom = feat.GetGeometryRef()
-        if geom is not None:
-            env = geom.GetEnvelope()
-            tilebasename = feat.GetFieldAsString(feat_idx)
-            outputImg = os.path.join(
-                out_img_path, "{0}.{1}".format(tilebasename, out_img_ext)
-            )
-            print(outputImg)
-            create_blank_img_from_bbox(
-                env,
-                wktstr,
-                outputImg,
-                out_img_res,
-                out_img_pxl_val,
-                out_img_n_bands,
-                gdalformat,
-                datatype,
-                snap_to_grid,
-            )
+    :param n_threads: the number of threads used to create the images.
+    :return: list of the output images.
+    """
+    return create_img_for_each_vec_feat_native(
+        vec_file,
+        vec_lyr,
+        file_name_col,
+        os.path.join(out_img_path, ""),
+        out_img_ext,
+        out_img_pxl_val,
+        out_img_n_bands,
+        out_img_res,
+        gdalformat,
+        datatype,
+        snap_to_grid=snap_to_grid,
+        n_threads=n_threads,
+    )
 
 
 def resample_img_to_match(
@@ -2110,6 +2105,7 @@ def resample_img_to_match(
     datatype: int = None,
     no_data_val: float = None,
     multicore: bool = False,
+    use_native: bool = False,
 ):
     """
     A utility function to resample an existing image to the projection
@@ -2126,7 +2122,36 @@ def resample_img_to_match(
     :param datatype: is the rsgislib datatype of the output image (if none then
                      it will be the same as the input file).
     :param multicore: use multiple processing cores (Default = False)
-    """
+    :param use_native: is a bool specifying whether the RSGISLib resampler
+                       (rsgislib.imageutils.resample_imgs_to_match) should be used
+                       rather than gdal.Warp for nearest neighbour, bilinear, cubic,
+                       average and mode. Note, the native average uses the source
+                       pixels with their centre within the output pixel rather than
+                       weighting by area. Default=False.
+
+    """
+    if use_native and interp_method in [
+        rsgislib.INTERP_NEAREST_NEIGHBOUR,
+        rsgislib.INTERP_BILINEAR,
+        rsgislib.INTERP_CUBIC,
+        rsgislib.INTERP_AVERAGE,
+        rsgislib.INTERP_MODE,
+    ]:
+        n_threads = 1
+        if multicore:
+            n_threads = 0
+        resample_imgs_to_match(
+            in_ref_img,
+            [in_process_img],
+            [output_img],
+            gdalformat,
+            interp_method=interp_method,
+            datatype=datatype,
+            no_data_val=no_data_val,
+            n_threads=n_threads,
+        )
+        return
+
     numBands = get_img_band_count(in_process_img)
     if no_data_val is None:
         no_data_val = get_img_no_data_value(in_process_img)
@@ -2563,20 +2588,6 @@ def subset_pxl_bbox(
     subset_bbox(input_img, output_img, gdalformat, datatype, xMin, xMax, yMin, yMax)
 
 
-def _run_subset(tileinfo):
-    """Internal function for create_tiles_multi_core for multiprocessing Pool."""
-    subset_pxl_bbox(
-        tileinfo["input_img"],
-        tileinfo["outfile"],
-        tileinfo["gdalformat"],
-        tileinfo["datatype"],
-        tileinfo["bbox"][0],
-        tileinfo["bbox"][1],
-        tileinfo["bbox"][2],
-        tileinfo["bbox"][3],
-    )
-
-
 def create_tiles_multi_core(
     input_img: str,
     out_img_base: str,
@@ -2588,7 +2599,9 @@ def create_tiles_multi_core(
     n_cores: int = 1,
 ):
     """
-    Function to generate a set of tiles for the input image.
+    Function to generate a set of tiles for the input image. The tiles are
+    named out_img_base_x{col}y{row}.out_img_ext where row 1 is the top of
+    the image.
 
     :param input_img: input image to be subset.
     :param out_img_base: output image files base path.
@@ -2599,10 +2612,9 @@ def create_tiles_multi_core(
                      of the output image.
     :param out_img_ext: output file extension to be added to the base image
                         path (e.g., kea)
-    :param n_cores: number of cores to be used; uses python multiprocessing module.
+    :param n_cores: number of threads used to write the tiles.
 
     """
-    import multiprocessing
     import rsgislib.tools.filetools
 
     if not (
@@ -2611,168 +2623,16 @@ def create_tiles_multi_core(
     ):
         raise rsgislib.RSGISPyException("Output path is not valid or exist.")
 
-    x_size, y_size = get_img_size(input_img)
-
-    n_full_xtiles = math.floor(x_size / width)
-    x_remain_width = x_size - (n_full_xtiles * width)
-    n_full_ytiles = math.floor(y_size / height)
-    y_remain_height = y_size - (n_full_ytiles * height)
-
-    tiles = []
-
-    for y_tile in range(n_full_ytiles):
-        y_pxl_min = y_tile * height
-        y_pxl_max = y_pxl_min + height
-
-        for x_tile in range(n_full_xtiles):
-            x_pxl_min = x_tile * width
-            x_pxl_max = x_pxl_min + width
-            tiles.append(
-                {
-                    "tile": "x{0}y{1}".format(x_tile + 1, y_tile + 1),
-                    "bbox": [x_pxl_min, x_pxl_max, y_pxl_min, y_pxl_max],
-                }
-            )
-
-        if x_remain_width > 0:
-            x_pxl_min = n_full_xtiles * width
-            x_pxl_max = x_pxl_min + x_remain_width
-            tiles.append(
-                {
-                    "tile": "x{0}y{1}".format(n_full_xtiles + 1, y_tile + 1),
-                    "bbox": [x_pxl_min, x_pxl_max, y_pxl_min, y_pxl_max],
-                }
-            )
-
-    if y_remain_height > 0:
-        y_pxl_min = n_full_ytiles * height
-        y_pxl_max = y_pxl_min + y_remain_height
-
-        for x_tile in range(n_full_xtiles):
-            x_pxl_min = x_tile * width
-            x_pxl_max = x_pxl_min + width
-            tiles.append(
-                {
-                    "tile": "x{0}y{1}".format(x_tile + 1, n_full_ytiles + 1),
-                    "bbox": [x_pxl_min, x_pxl_max, y_pxl_min, y_pxl_max],
-                }
-            )
-
-        if x_remain_width > 0:
-            x_pxl_min = n_full_xtiles * width
-            x_pxl_max = x_pxl_min + x_remain_width
-            tiles.append(
-                {
-                    "tile": "x{0}y{1}".format(n_full_xtiles + 1, n_full_ytiles + 1),
-                    "bbox": [x_pxl_min, x_pxl_max, y_pxl_min, y_pxl_max],
-                }
-            )
-
-    for tile in tiles:
-        tile["input_img"] = input_img
-        tile["outfile"] = "{0}_{1}.{2}".format(out_img_base, tile["tile"], out_img_ext)
-        tile["gdalformat"] = gdalformat
-        tile["datatype"] = datatype
-
-    poolobj = multiprocessing.Pool(n_cores)
-    poolobj.map(_run_subset, tiles)
-
-
-def calc_pixel_locations(input_img: str, output_img: str, gdalformat: str):
-    """
-    Function which produces a 2 band output image with the X and Y locations
-    of the image pixels.
-
-    :param input_img: the input reference image
-    :param output_img: the output image file name and path (will be same
-                       dimensions as the input)
-    :param gdalformat: the GDAL image file format of the output image file.
-
-    """
-    try:
-        import tqdm
-
-        progress_bar = rsgislib.TQDMProgressBar()
-    except:
-        from rios import cuiprogress
-
-        progress_bar = cuiprogress.GDALProgressBar()
-
-    infiles = applier.FilenameAssociations()
-    infiles.image1 = input_img
-    outfiles = applier.FilenameAssociations()
-    outfiles.outimage = output_img
-    otherargs = applier.OtherInputs()
-    aControls = applier.ApplierControls()
-    aControls.progress = progress_bar
-    aControls.drivername = gdalformat
-    aControls.omitPyramids = True
-    aControls.calcStats = False
-
-    def _getXYPxlLocs(info, inputs, outputs, otherargs):
-        """
-        This is an internal rios function
-        """
-        xBlock, yBlock = info.getBlockCoordArrays()
-        outputs.outimage = numpy.stack((xBlock, yBlock))
-
-    applier.apply(_getXYPxlLocs, infiles, outfiles, otherargs, controls=aControls)
-
-
-def calc_wgs84_pixel_area(
-    input_img: str, output_img: str, scale: float = 10000, gdalformat: str = "KEA"
-):
-    """
-    A function which calculates the area (in metres) of the pixel projected in WGS84.
-
-    :param input_img: input image, for which the per-pixel area will be calculated.
-    :param output_img: output image file.
-    :param scale: scale the output area to unit of interest. Scale=10000(Ha),
-                        Scale=1(sq m), Scale=1000000(sq km), Scale=4046.856(Acre),
-                        Scale=2590000(sq miles), Scale=0.0929022668(sq feet)
-
-    """
-    import rsgislib.tools.projection
-    from rios import applier
-
-    try:
-        progress_bar = rsgislib.TQDMProgressBar()
-    except:
-        from rios import cuiprogress
-
-        progress_bar = cuiprogress.GDALProgressBar()
-
-    x_res, y_res = get_img_res(input_img, abs_vals=True)
-
-    infiles = applier.FilenameAssociations()
-    infiles.input_img = input_img
-    outfiles = applier.FilenameAssociations()
-    outfiles.outimage = output_img
-    otherargs = applier.OtherInputs()
-    otherargs.x_res = x_res
-    otherargs.y_res = y_res
-    otherargs.scale = float(scale)
-    aControls = applier.ApplierControls()
-    aControls.progress = progress_bar
-    aControls.drivername = gdalformat
-    aControls.omitPyramids = False
-    aControls.calcStats = False
-
-    def _calcPixelArea(info, inputs, outputs, otherargs):
-        xBlock, yBlock = info.getBlockCoordArrays()
-
-        x_res_arr = numpy.zeros_like(yBlock, dtype=float)
-        x_res_arr[...] = otherargs.x_res
-        y_res_arr = numpy.zeros_like(yBlock, dtype=float)
-        y_res_arr[...] = otherargs.y_res
-        x_res_arr_m, y_res_arr_m = rsgislib.tools.projection.degrees_to_metres(
-            yBlock, x_res_arr, y_res_arr
-        )
-        outputs.outimage = numpy.expand_dims(
-            (x_res_arr_m * y_res_arr_m) / otherargs.scale, axis=0
-        )
-
-    applier.apply(_calcPixelArea, infiles, outfiles, otherargs, controls=aControls)
+    tiles = plan_img_tiles(input_img, width, height)
+    create_img_tiles(
+        input_img,
+        tiles,
+        out_img_base,
+        out_img_ext,
+        gdalformat,
+        datatype,
+        n_threads=n_cores,
+    )
 
 
 def do_images_overlap(in_a_img: str, in_b_img: str, over_thres: int = 0.0):
@@ -4190,59 +4050,6 @@ def spectral_smoothing(
         )
 
 
-def calc_wsg84_pixel_size(input_img: str, output_img: str, gdalformat: str = "KEA"):
-    """
-    A function which calculates the x and y pixel resolution (in metres) of each
-    pixel projected in WGS84.
-
-    :param input_img: input image, for which the per-pixel area will be calculated.
-    :param output_img: output image file where band 1 is X and band 2 is the Y
-                       pixel resolution.
-    :param gdalformat: the output image file format (default: KEA).
-
-    """
-    import rsgislib.tools.projection
-    from rios import applier
-
-    try:
-        import tqdm
-
-        progress_bar = rsgislib.TQDMProgressBar()
-    except:
-        from rios import cuiprogress
-
-        progress_bar = cuiprogress.GDALProgressBar()
-
-    x_res, y_res = get_img_res(input_img, abs_vals=True)
-
-    infiles = applier.FilenameAssociations()
-    infiles.img = input_img
-    outfiles = applier.FilenameAssociations()
-    outfiles.outimage = output_img
-    otherargs = applier.OtherInputs()
-    otherargs.x_res = x_res
-    otherargs.y_res = y_res
-    aControls = applier.ApplierControls()
-    aControls.progress = progress_bar
-    aControls.drivername = gdalformat
-    aControls.omitPyramids = False
-    aControls.calcStats = False
-
-    def _calcPixelRes(info, inputs, outputs, otherargs):
-        xBlock, yBlock = info.getBlockCoordArrays()
-
-        x_res_arr = numpy.zeros_like(yBlock, dtype=float)
-        x_res_arr[...] = otherargs.x_res
-        y_res_arr = numpy.zeros_like(yBlock, dtype=float)
-        y_res_arr[...] = otherargs.y_res
-        x_res_arr_m, y_res_arr_m = rsgislib.tools.projection.degrees_to_metres(
-            yBlock, x_res_arr, y_res_arr
-        )
-        outputs.outimage = numpy.stack((x_res_arr_m, y_res_arr_m), axis=0)
-
-    applier.apply(_calcPixelRes, infiles, outfiles, otherargs, controls=aControls)
-
-
 def mask_all_band_zero_vals(
     input_img: str, output_img: str, gdalformat: str, out_val: int = 1
 ):
@@ -59,6 +59,8 @@ def create_img_extent_lut(
 ):
     """
     Create a vector layer look up table (LUT) for a directory of images.
+    For large archives of images see rsgislib.imageutils.create_img_footprint_idx,
+    which creates a spatial index which can be queried much more quickly.
 
     :param input_imgs: list of input images for the LUT. All input images should be
                        the same projection/coordinate system.
@@ -151,7 +153,9 @@ def create_img_extent_lut(
 
 def query_img_lut(scn_bbox: List[float], lut_db_file: str, lyr_name: str) -> List[str]:
     """
-    A function for querying the LUT DB spatially filtering using a BBOX
+    A function for querying the LUT DB spatially filtering using a BBOX. Note,
+    rsgislib.imageutils.query_img_footprint_idx provides the same query for a
+    footprint index.
 
     :param scn_bbox: A bbox (MinX, MaxX, MinY, MaxY) in the same projection as
                      the LUT for the area of interest.
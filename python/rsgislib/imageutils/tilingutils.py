@@ -99,9 +99,13 @@ def create_min_data_tiles(
     force=True,
     tmpdir="tilestemp",
     inImgNoDataVal=0.0,
+    n_threads=1,
 ):
     """
     A function to create a tiling for an input image where each tile has a minimum amount of valid data.
+    The tiling is planned from a single pass over the input image (see
+    rsgislib.imageutils.plan_img_tiles); tiles with less valid data than the threshold
+    are merged with a neighbouring tile and tiles without valid data are removed.
 
     :param inputImage: is a string for the image to be tiled
     :param outshp: is a string for the output shapefile the tiling will be written to (if None a shapefile won't be outputted).
@@ -109,65 +113,27 @@ def create_min_data_tiles(
     :param width: is an int for the width of the tiles
     :param height: is an int for the height of the tiles
     :param validDataThreshold: is a float (0-1) with the proportion of valid data needed within a tile.
+    :param maskIntersect: is an optional image (same size as the input) where tiles which are only
+                          inImgNoDataVal within the mask are removed.
+    :param offset: is a boolean (default False) to offset the tiling grid by half a tile.
     :param force: is a boolean (default True) to delete the output shapefile if it already exists.
-    :param tmpdir: is a string with a temporary directory for temp outputs to be stored (they will be deleted).
-                  if tmpdir doesn't exist it will be created and then deleted during the processing.
+    :param tmpdir: is no longer used as no temporary outputs are created.
     :param inImgNoDataVal: is a float for providing the input image no data value (Default: 0.0)
+    :param n_threads: is the number of threads used to count the valid pixels (0 uses all the cores).
     """
-    tmpPresent = True
-    if not os.path.exists(tmpdir):
-        print("WARNING: tmpdir directory does not exist so creating it...")
-        os.makedirs(tmpdir)
-        tmpPresent = False
-
-    inImgBaseName = os.path.splitext(os.path.basename(inputImage))[0]
-
-    tileClumpsImage = os.path.join(tmpdir, inImgBaseName + "_tilesimg.kea")
-
-    segmentation.generateRegularGrid(
-        inputImage, tileClumpsImage, "KEA", width, height, offset
-    )
-    rastergis.pop_rat_img_stats(tileClumpsImage, True, True)
-
-    if not maskIntersect is None:
-        bs = []
-        bs.append(rastergis.BandAttStats(band=1, maxField="Mask"))
-        rastergis.populate_rat_with_stats(maskIntersect, tileClumpsImage, bs)
-        ratDS = gdal.Open(tileClumpsImage, gdal.GA_Update)
-        MaskField = rat.readColumn(ratDS, "Mask")
-        Selected = numpy.zeros_like(MaskField, dtype=int)
-        Selected[MaskField == inImgNoDataVal] = 1
-        rat.writeColumn(ratDS, "Selected", Selected)
-        ratDS = None
-
-        tileClumpsImageDropClumps = os.path.join(
-            tmpdir, inImgBaseName + "_tilesimgdropped.kea"
-        )
-
-        segmentation.dropSelectedClumps(
-            tileClumpsImage, tileClumpsImageDropClumps, "KEA", "Selected"
-        )
-        rsgislib.tools.filetools.delete_file_silent(tileClumpsImage)
-        tileClumpsImage = tileClumpsImageDropClumps
-
-    rastergis.populateRATWithPropValidPxls(
-        inputImage, tileClumpsImage, "ValidPxls", inImgNoDataVal
-    )
-
-    ratDS = gdal.Open(tileClumpsImage, gdal.GA_Update)
-    ValidPxls = rat.readColumn(ratDS, "ValidPxls")
-    Selected = numpy.zeros_like(ValidPxls, dtype=int)
-    NoDataClumps = numpy.zeros_like(ValidPxls, dtype=int)
-    Selected[ValidPxls < validDataThreshold] = 1
-    NoDataClumps[ValidPxls == 0] = 1
-    Selected[ValidPxls == 0] = 0
-    rat.writeColumn(ratDS, "Selected", Selected)
-    rat.writeColumn(ratDS, "NoDataClumps", NoDataClumps)
-    ratDS = None
-
-    segmentation.mergeSegments2Neighbours(
-        tileClumpsImage, inputImage, outclumpsFile, "KEA", "Selected", "NoDataClumps"
+    imageutils.plan_img_tiles(
+        inputImage,
+        width,
+        height,
+        valid_thres=validDataThreshold,
+        offset=offset,
+        no_data_val=inImgNoDataVal,
+        mask_img=maskIntersect,
+        out_tiles_img=outclumpsFile,
+        gdalformat="KEA",
+        n_threads=n_threads,
     )
+    rastergis.pop_rat_img_stats(outclumpsFile, True, True)
 
     if not outshp is None:
         tilesDS = gdal.Open(outclumpsFile, gdal.GA_ReadOnly)
@@ -188,11 +154,6 @@ def create_min_data_tiles(
         tilesDS = None
         dst_ds = None
 
-    if not tmpPresent:
-        shutil.rmtree(tmpdir, ignore_errors=True)
-    else:
-        rsgislib.tools.filetools.delete_file_silent(tileClumpsImage)
-
 
 def create_tile_mask_images_from_shp(
     inputImage,
@@ -201,73 +162,66 @@ def create_tile_mask_images_from_shp(
     tilesMaskDIR,
     tmpdir="tilestemp",
     imgFormat="KEA",
+    n_threads=1,
 ):
     """
     A function to create individual image masks from the tiles shapefile which can be
     individually used to mask (using rsgislib mask function) each tile from the inputimage.
+    Each mask is the extent of the tile on the pixel grid of the input image and the masks
+    are rasterised in a single pass over the tiles (see
+    rsgislib.imageutils.create_vec_feat_mask_imgs).
 
     :param inputImage: is the input image being tiled.
     :param tileShp: is a shapefile containing the shapefile tiles.
     :param tilesNameBase: is the base file name for the tile masks
     :param tilesMaskDIR: is the directory where the output images will be outputted
-    :param tmpdir: is a string with a temporary directory for temp outputs to be stored (they will be deleted)
-                   If tmpdir doesn't exist it will be created and then deleted during the processing.
+    :param tmpdir: is no longer used as no temporary files are created.
+    :param imgFormat: is the output image file format of the tile masks
+    :param n_threads: is the number of threads used to rasterise and write the masks.
+    :return: list of the output mask images.
     """
-
-    tmpPresent = True
-    if not os.path.exists(tmpdir):
-        print("WARNING: tmpdir directory does not exist so creating it...")
-        os.makedirs(tmpdir)
-        tmpPresent = False
-
-    shpTilesBase = os.path.join(tmpdir, tilesNameBase + "_tileshp")
-
-    vectorutils.splitFeatures(tileShp, shpTilesBase, True)
-
-    drv = ogr.GetDriverByName("ESRI Shapefile")
-    shpFiles = glob.glob(shpTilesBase + "*.shp")
-    idx = 1
-    for shpFile in shpFiles:
-        imgTileFile = os.path.join(tilesMaskDIR, tilesNameBase + str(idx) + ".kea")
-        shpFileLyr = os.path.splitext(os.path.basename(shpFile))[0]
-        rsgislib.vectorutils.createrasters.rasterise_vec_lyr(
-            shpFile,
-            shpFileLyr,
-            inputImage,
-            imgTileFile,
-            gdalformat=imgFormat,
-            burn_val=1,
-            datatype=rsgislib.TYPE_8UINT,
-            att_column=None,
-            use_vec_extent=False,
-            thematic=True,
-            no_data_val=0,
-        )
-        drv.DeleteDataSource(shpFile)
-        idx = idx + 1
-
-    if not tmpPresent:
-        shutil.rmtree(tmpdir, ignore_errors=True)
+    tileShpLyr = os.path.splitext(os.path.basename(tileShp))[0]
+    outImgExt = rsgislib.imageutils.get_file_img_extension(imgFormat)
+    return imageutils.create_vec_feat_mask_imgs(
+        tileShp,
+        tileShpLyr,
+        inputImage,
+        os.path.join(tilesMaskDIR, tilesNameBase),
+        outImgExt,
+        imgFormat,
+        file_name_col=None,
+        burn_val=1,
+        datatype=rsgislib.TYPE_8UINT,
+        n_threads=n_threads,
+    )
 
 
 def create_tile_mask_images_from_clumps(
-    clumpsImage, tilesNameBase, tilesMaskDIR, gdalformat="KEA"
+    clumpsImage, tilesNameBase, tilesMaskDIR, gdalformat="KEA", n_threads=1
 ):
     """
     A function to create individual image masks from the tiles shapefile which can be
     individually used to mask (using rsgislib mask function) each tile from the inputimage.
+    Each mask is the extent of the clump and the masks are created in a single sweep
+    of the clumps image (see rsgislib.imageutils.create_clump_mask_imgs).
 
     :param clumpsImage: is an image file with RAT where each clump represented a tile region.
     :param tilesNameBase: is the base file name for the tile masks
     :param tilesMaskDIR: is the directory where the output images will be outputted
     :param gdalformat: is the output image file format of the tile masks
+    :param n_threads: is the number of threads used to write the masks.
+    :return: list of the output mask images.
     """
-    import rsgislib.tools.filetools
-
     outBaseImg = os.path.join(tilesMaskDIR, tilesNameBase)
-    outImgExt = rsgislib.imageutils.get_file_img_extension(gdalformat)[1:]
-    rastergis.exportClumps2Images(
-        clumpsImage, outBaseImg, True, outImgExt, gdalformat, 1
+    outImgExt = rsgislib.imageutils.get_file_img_extension(gdalformat)
+    return imageutils.create_clump_mask_imgs(
+        clumpsImage,
+        outBaseImg,
+        outImgExt,
+        gdalformat,
+        binary_out=True,
+        datatype=rsgislib.TYPE_8UINT,
+        n_threads=n_threads,
     )
 
 
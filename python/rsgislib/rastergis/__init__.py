@@ -384,11 +384,15 @@ def get_column_data(clumps_img: str, col_name: str) -> numpy.array:
     """
     from rios import rat
 
-    col_names = get_rat_columns(clumps_img)
+    col_info = get_rat_columns_info(clumps_img)
 
-    if col_name not in col_names:
+    if col_name not in col_info:
         raise rsgislib.RSGISPyException("Column specified is not within the RAT.")
 
+    if col_info[col_name]["type"] in (gdal.GFT_Integer, gdal.GFT_Real):
+        # Read directly into a contiguous array (no per-value conversion).
+        return numpy.asarray(read_rat_column(clumps_img, col_name))
+
     rat_dataset = gdal.Open(clumps_img, gdal.GA_ReadOnly)
     if rat_dataset is None:
         raise rsgislib.RSGISPyException("The input image could not be opened.")
@@ -29,9 +29,17 @@ def polygonise_raster_to_vec_lyr(
     replace_lyr: bool = True,
     pxl_val_fieldname: str = "PXLVAL",
     use_8_conn: bool = False,
+    use_native: bool = False,
 ):
     """
-    A utility to polygonise a raster to a OGR vector layer.
+    A utility to polygonise a raster to a OGR vector layer. By default the
+    gdal.Polygonize function is used. If use_native is True the
+    rsgislib.vectorutils.polygonise_img function is used instead, which merges
+    runs of pixels into regions row by row rather than tracing the region
+    boundaries within the image. Note, the native function does not output
+    polygons for pixels equal to the image no data value and, for floating
+    point images, the regions are of equal value (rather than the truncated
+    integer value) with the value written to a real field.
 
     :param out_vec_file: is a string specifying the output vector file path. If it
                          exists it will be deleted and overwritten.
@@ -52,8 +60,31 @@ def polygonise_raster_to_vec_lyr(
                               representing the pixel value within the input image.
     :param use_8_conn: is a bool specifying whether 8 connectedness or 4 connectedness
                        should be used (4 is RSGISLib/GDAL default)
+    :param use_native: is a bool specifying whether the RSGISLib implementation
+                       (rsgislib.vectorutils.polygonise_img) should be used rather
+                       than gdal.Polygonize. Default=False.
 
     """
+    if use_native:
+        import rsgislib.vectorutils
+
+        print("Polygonising...")
+        rsgislib.vectorutils.polygonise_img(
+            input_img,
+            img_band,
+            out_vec_file,
+            out_vec_lyr,
+            out_format,
+            mask_img=mask_img,
+            mask_band=mask_band,
+            pxl_val_fieldname=pxl_val_fieldname,
+            use_8_conn=use_8_conn,
+            replace_file=replace_file,
+            replace_lyr=replace_lyr,
+        )
+        print("Completed")
+        return
+
     gdalImgDS = gdal.Open(input_img)
     imgBand = gdalImgDS.GetRasterBand(img_band)
     imgsrs = osr.SpatialReference()
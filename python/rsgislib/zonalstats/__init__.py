@@ -39,6 +39,19 @@ respect to the method of intersection. The options for intersection are:
 * METHOD_PIXELAREAINPOLY = 8             # Percent of pixel area that is within
                                          # the polygon
 * METHOD_POLYAREAINPIXEL = 9             # Percent of polygon area that is within pixel
+
+For sampling image bands at many points (e.g., field or GNSS points) use
+rsgislib.zonalstats.sample_pts_band_values_file, or
+rsgislib.zonalstats.sample_img_band_values for coordinates held in memory,
+which read each image tile once. The sampling methods are:
+
+* SAMPLE_NEAREST = 0                     # The pixel containing the point
+* SAMPLE_BILINEAR = 1                    # Bilinear interpolation of the 4 nearest pixels
+* SAMPLE_WIN_MEAN = 2                    # Mean of the window around the point
+* SAMPLE_WIN_MIN = 3                     # Min of the window around the point
+* SAMPLE_WIN_MAX = 4                     # Max of the window around the point
+* SAMPLE_WIN_MEDIAN = 5                  # Median of the window around the point
+* SAMPLE_WIN_STDDEV = 6                  # Standard deviation of the window around the point
 """
 
 # import the C++ extension into this level
@@ -71,6 +84,14 @@ METHOD_PIXELAREAINPOLY = 8  # Percent of pixel area that is within
 # the polygon
 METHOD_POLYAREAINPIXEL = 9  # Percent of polygon area that is within pixel
 
+SAMPLE_NEAREST = 0  # The pixel containing the point
+SAMPLE_BILINEAR = 1  # Bilinear interpolation of the 4 nearest pixels
+SAMPLE_WIN_MEAN = 2  # Mean of the window around the point
+SAMPLE_WIN_MIN = 3  # Min of the window around the point
+SAMPLE_WIN_MAX = 4  # Max of the window around the point
+SAMPLE_WIN_MEDIAN = 5  # Median of the window around the point
+SAMPLE_WIN_STDDEV = 6  # Standard deviation of the window around the point
+
 
 def calc_zonal_band_stats_file(
     vec_file,
@@ -89,11 +110,15 @@ def calc_zonal_band_stats_file(
     mode_field=None,
     median_field=None,
     vec_def_epsg=None,
+    n_threads=1,
 ):
     """
     A function which calculates zonal statistics for a particular image band.
     If you know that the pixels in the values image are small with respect to
-    the polygons then use this function.
+    the polygons then use this function. The statistics for all the polygons
+    are calculated in a single pass over the image (in C++) so this is much
+    faster than calc_zonal_band_stats for layers with many polygons. Pixels
+    are within a polygon if the pixel centre is within the polygon.
 
     :param vec_file: input vector file
     :param vec_lyr: input vector layer within the input file which specifies the
@@ -127,10 +152,30 @@ def calc_zonal_band_stats_file(
     :param vec_def_epsg: an EPSG code can be specified for the vector layer is the
                          projection is not well defined within the inputted
                          vector layer.
+    :param n_threads: the number of threads used to process the rows of the
+                      image (0 uses the number of cores).
 
     """
     try:
-        vecDS = gdal.OpenEx(vec_file, gdal.OF_VECTOR | gdal.OF_UPDATE)
+        out_fields = [
+            min_field,
+            max_field,
+            mean_field,
+            stddev_field,
+            sum_field,
+            count_field,
+            mode_field,
+            median_field,
+        ]
+        if all(out_field is None for out_field in out_fields):
+            raise rsgislib.RSGISPyException(
+                "At least one field needs to be specified for there is to an output."
+            )
+        out_fields = [
+            None if out_field is None else out_field.lower() for out_field in out_fields
+        ]
+
+        vecDS = gdal.OpenEx(vec_file, gdal.OF_VECTOR)
         if vecDS is None:
             raise rsgislib.RSGISPyException("Could not open '{}'".format(vec_file))
 
@@ -138,25 +183,44 @@ def calc_zonal_band_stats_file(
         if vec_lyr_obj is None:
             raise rsgislib.RSGISPyException("Could not open layer '{}'".format(vec_lyr))
 
-        calc_zonal_band_stats(
-            vec_lyr_obj,
+        imgDS = gdal.OpenEx(input_img, gdal.GA_ReadOnly)
+        if imgDS is None:
+            raise rsgislib.RSGISPyException("Could not open '{}'".format(input_img))
+        img_spatial_ref = osr.SpatialReference()
+        img_spatial_ref.ImportFromWkt(imgDS.GetProjection())
+        img_spatial_ref.AutoIdentifyEPSG()
+        epsg_img_spatial = img_spatial_ref.GetAuthorityCode(None)
+        imgDS = None
+
+        if vec_def_epsg is None:
+            veclyr_spatial_ref = vec_lyr_obj.GetSpatialRef()
+            if veclyr_spatial_ref is None:
+                raise rsgislib.RSGISPyException(
+                    "Could not retrieve a projection object from the vector layer - "
+                    "projection might not be be defined."
+                )
+            epsg_vec_spatial = veclyr_spatial_ref.GetAuthorityCode(None)
+        else:
+            epsg_vec_spatial = vec_def_epsg
+        vecDS = None
+
+        if str(epsg_vec_spatial) != str(epsg_img_spatial):
+            raise rsgislib.RSGISPyException(
+                "Inputted raster and vector layers have different "
+                "projections: ('{0}' '{1}') ".format(vec_file, input_img)
+            )
+
+        calc_zonal_band_stats_native(
+            vec_file,
+            vec_lyr,
             input_img,
             img_band,
             min_thres,
             max_thres,
             out_no_data_val,
-            min_field,
-            max_field,
-            mean_field,
-            stddev_field,
-            sum_field,
-            count_field,
-            mode_field,
-            median_field,
-            vec_def_epsg,
+            *out_fields,
+            n_threads=n_threads,
         )
-
-        vecDS = None
     except Exception as e:
         print("Error Vector File: {}".format(vec_file), file=sys.stderr)
         print("Error Vector Layer: {}".format(vec_lyr), file=sys.stderr)
@@ -184,7 +248,9 @@ def calc_zonal_band_stats(
     """
     A function which calculates zonal statistics for a particular image band.
     If you know that the pixels in the values image are small with respect to
-    the polygons then use this function.
+    the polygons then use this function. Each polygon is read and rasterised
+    separately so for layers with many polygons calc_zonal_band_stats_file
+    will be much faster.
 
     :param vec_lyr_obj: OGR vector layer object containing the geometries being
                         processed and to which the stats will be written.
@@ -523,12 +589,13 @@ def calc_zonal_band_stats(
 
 
 def calc_zonal_poly_pts_band_stats_file(
-    vec_file, vec_lyr, input_img, img_band, out_field, vec_def_epsg=None
+    vec_file, vec_lyr, input_img, img_band, out_field, vec_def_epsg=None, n_threads=1
 ):
     """
     A funtion which extracts zonal stats for a polygon using the polygon centroid.
     This is useful when you are intersecting a low resolution image with respect to
-    the polygon resolution.
+    the polygon resolution. The centroids are sampled in a single pass over the
+    image (see sample_pts_band_values_file).
 
     :param vec_file: input vector file
     :param vec_lyr: input vector layer within the input file which specifies the
@@ -541,22 +608,38 @@ def calc_zonal_poly_pts_band_stats_file(
     :param vec_def_epsg: an EPSG code can be specified for the vector layer is the
                          projection is not well defined within the inputted
                          vector layer.
+    :param n_threads: the number of threads used to sample the centroids (0 uses
+                      the number of cores).
 
     """
     try:
-        vecDS = gdal.OpenEx(vec_file, gdal.OF_VECTOR | gdal.OF_UPDATE)
-        if vecDS is None:
-            raise rsgislib.RSGISPyException("Could not open '{}'".format(vec_file))
-
-        vec_lyr_obj = vecDS.GetLayerByName(vec_lyr)
-        if vec_lyr_obj is None:
-            raise rsgislib.RSGISPyException("Could not open layer '{}'".format(vec_lyr))
+        imgDS = gdal.OpenEx(input_img, gdal.GA_ReadOnly)
+        if imgDS is None:
+            raise rsgislib.RSGISPyException("Could not open '{}'".format(input_img))
+        img_band_obj = imgDS.GetRasterBand(img_band)
+        if img_band_obj is None:
+            raise rsgislib.RSGISPyException(
+                "Could not find image band '{}'".format(img_band)
+            )
+        img_no_data_val = img_band_obj.GetNoDataValue()
+        imgDS = None
+        if img_no_data_val is None:
+            img_no_data_val = 0.0
 
-        calc_zonal_poly_pts_band_stats(
-            vec_lyr_obj, input_img, img_band, out_field, vec_def_epsg
+        sample_pts_band_values_file(
+            vec_file,
+            vec_lyr,
+            input_img,
+            [img_band],
+            [out_field],
+            -math.inf,
+            math.inf,
+            img_no_data_val,
+            sample_method=SAMPLE_NEAREST,
+            reproj_vec=False,
+            vec_def_epsg=vec_def_epsg,
+            n_threads=n_threads,
         )
-
-        vecDS = None
     except Exception as e:
         print("Error Vector File: {}".format(vec_file), file=sys.stderr)
         print("Error Vector Layer: {}".format(vec_lyr), file=sys.stderr)
@@ -1333,7 +1416,9 @@ def ext_point_band_values_file(
 ):
     """
     A function which extracts point values for an input vector file for a
-    particular image band.
+    particular image band. For layers with many points, or to sample several
+    bands, sample_pts_band_values_file is much faster as it reads each image
+    tile once rather than reading the image for each point.
 
     :param vec_file: input vector file
     :param vec_lyr: input vector layer within the input file which specifies the
@@ -1595,19 +1680,154 @@ def ext_point_band_values(
         raise e
 
 
-def merge_extracted_hdf5_data(h5_files, out_h5_file, datatype=None):
+def sample_pts_band_values_file(
+    vec_file: str,
+    vec_lyr: str,
+    input_img: str,
+    img_bands: List[int],
+    out_fields: List[str],
+    min_thres: float,
+    max_thres: float,
+    out_no_data_val: float,
+    sample_method: int = SAMPLE_NEAREST,
+    win_size: int = 3,
+    reproj_vec: bool = False,
+    vec_def_epsg: int = None,
+    n_threads: int = 1,
+):
+    """
+    A function which samples image bands at the points of a vector layer (for
+    other geometry types the centroid is used), writing a field for each band.
+    The points are sorted by the image tile they fall within so each tile is
+    read once for each band (in C++), which is much faster than
+    ext_point_band_values for layers with many points.
+
+    :param vec_file: input vector file
+    :param vec_lyr: input vector layer within the input file which specifies the
+                    features and where the output values will be written.
+    :param input_img: the values image
+    :param img_bands: a list of the bands (starting at 1) to be sampled. If defined
+                      the no data value of the band will be ignored.
+    :param out_fields: a list of the output field names (one for each band).
+    :param min_thres: a lower threshold for values which will be included.
+    :param max_thres: a upper threshold for values which will be included.
+    :param out_no_data_val: output no data value for points outside the image or
+                            without valid pixel values.
+    :param sample_method: the sampling method (rsgislib.zonalstats.SAMPLE_*).
+                          SAMPLE_NEAREST uses the pixel containing the point,
+                          SAMPLE_BILINEAR interpolates the 4 nearest pixels and
+                          the SAMPLE_WIN_* methods calculate a statistic for the
+                          window centred on the pixel containing the point.
+    :param win_size: the size of the window (odd) for the SAMPLE_WIN_* methods.
+    :param reproj_vec: boolean to specify whether the points should be reprojected
+                       on the fly during processing if the projections are
+                       different. Default: False to ensure it is the users intention.
+    :param vec_def_epsg: an EPSG code can be specified for the vector layer is the
+                         projection is not well defined within the inputted
+                         vector layer.
+    :param n_threads: the number of threads used to sample the points within
+                      each image tile (0 uses the number of cores).
+
+    """
+    try:
+        if len(img_bands) != len(out_fields):
+            raise rsgislib.RSGISPyException(
+                "There must be an output field for each image band."
+            )
+        for out_field in out_fields:
+            if (out_field is None) or (out_field == ""):
+                raise rsgislib.RSGISPyException(
+                    "Output field specified as none or empty, a name needs to be given."
+                )
+        out_fields = [out_field.lower() for out_field in out_fields]
+
+        vecDS = gdal.OpenEx(vec_file, gdal.OF_VECTOR)
+        if vecDS is None:
+            raise rsgislib.RSGISPyException("Could not open '{}'".format(vec_file))
+
+        vec_lyr_obj = vecDS.GetLayerByName(vec_lyr)
+        if vec_lyr_obj is None:
+            raise rsgislib.RSGISPyException("Could not open layer '{}'".format(vec_lyr))
+
+        imgDS = gdal.OpenEx(input_img, gdal.GA_ReadOnly)
+        if imgDS is None:
+            raise rsgislib.RSGISPyException("Could not open '{}'".format(input_img))
+        img_spatial_ref = osr.SpatialReference()
+        img_spatial_ref.ImportFromWkt(imgDS.GetProjection())
+        img_spatial_ref.AutoIdentifyEPSG()
+        epsg_img_spatial = img_spatial_ref.GetAuthorityCode(None)
+        imgDS = None
+
+        if vec_def_epsg is None:
+            veclyr_spatial_ref = vec_lyr_obj.GetSpatialRef()
+            if veclyr_spatial_ref is None:
+                raise rsgislib.RSGISPyException(
+                    "Could not retrieve a projection object from the vector layer - "
+                    "projection might not be be defined."
+                )
+            epsg_vec_spatial = veclyr_spatial_ref.GetAuthorityCode(None)
+        else:
+            epsg_vec_spatial = vec_def_epsg
+        vecDS = None
+
+        pt_reprj = False
+        if str(epsg_vec_spatial) != str(epsg_img_spatial):
+            if reproj_vec:
+                pt_reprj = True
+            else:
+                raise rsgislib.RSGISPyException(
+                    "Input vector and image datasets are in different "
+                    "projections (EPSG:{} / EPSG:{})."
+                    "You can select option to reproject.".format(
+                        epsg_vec_spatial, epsg_img_spatial
+                    )
+                )
+
+        sample_pts_band_values_native(
+            vec_file,
+            vec_lyr,
+            input_img,
+            img_bands,
+            out_fields,
+            min_thres,
+            max_thres,
+            out_no_data_val,
+            sample_method=sample_method,
+            win_size=win_size,
+            reproj_vec=pt_reprj,
+            vec_def_epsg=0 if vec_def_epsg is None else int(vec_def_epsg),
+            n_threads=n_threads,
+        )
+    except Exception as e:
+        print("Error Vector File: {}".format(vec_file), file=sys.stderr)
+        print("Error Vector Layer: {}".format(vec_lyr), file=sys.stderr)
+        print("Error Image File: {}".format(input_img), file=sys.stderr)
+        raise e
+
+
+def merge_extracted_hdf5_data(
+    h5_files, out_h5_file, datatype=None, shuffle=False, rnd_seed=42, n_threads=1
+):
     """
     A function to merge a list of HDF files (e.g., from
     rsgislib.zonalstats.extractZoneImageBandValues2HDF)
     with the same number of variables (i.e., columns) into a single
     file. For example, if class training regions have been sourced
-    from multiple images.
+    from multiple images. The rows are copied a block at a time
+    so the files do not need to fit in memory.
 
     :param h5_files: a list of input files.
     :param out_h5_file: the output file.
     :param datatype: is the data type used for the output HDF5 file
                      (e.g., rsgislib.TYPE_32FLOAT). If None (default)
                      then the output data type will be float32.
+    :param shuffle: if True the rows of the output file are shuffled (blocks
+                    of rows are read in a random order and the rows within a
+                    window of blocks are shuffled). Default: False.
+    :param rnd_seed: the seed for the random number generator used to shuffle
+                     the rows.
+    :param n_threads: the number of threads used to shuffle the rows.
+    :return: the number of rows within the output file.
 
     .. code:: python
 
@@ -1617,58 +1837,17 @@ def merge_extracted_hdf5_data(h5_files, out_h5_file, datatype=None):
         rsgislib.zonalstats.merge_extracted_hdf5_data(inTrainSamples, cloudTrainSamples)
 
     """
-    import h5py
-
     if datatype is None:
         datatype = rsgislib.TYPE_32FLOAT
 
-    first = True
-    numVars = 0
-    numVals = 0
-    for h5File in h5_files:
-        fH5 = h5py.File(h5File, "r")
-        dataShp = fH5["DATA/DATA"].shape
-        if first:
-            numVars = dataShp[1]
-            first = False
-        elif numVars is not dataShp[1]:
-            raise rsgislib.RSGISPyException(
-                "The number of variables within the "
-                "inputted HDF5 files was not the same."
-            )
-        numVals += dataShp[0]
-        fH5.close()
-
-    dataArr = numpy.zeros([numVals, numVars], dtype=float)
-
-    rowInit = 0
-    for h5File in h5_files:
-        fH5 = h5py.File(h5File, "r")
-        numRows = fH5["DATA/DATA"].shape[0]
-        dataArr[rowInit : (rowInit + numRows)] = fH5["DATA/DATA"]
-        rowInit += numRows
-        fH5.close()
-
-    chunk_len = 1000
-    if numVals < chunk_len:
-        chunk_len = numVals
-
-    h5_dtype = rsgislib.get_numpy_char_codes_datatype(datatype)
-
-    fH5Out = h5py.File(out_h5_file, "w")
-    dataGrp = fH5Out.create_group("DATA")
-    metaGrp = fH5Out.create_group("META-DATA")
-    dataGrp.create_dataset(
-        "DATA",
-        data=dataArr,
-        chunks=(chunk_len, numVars),
-        compression="gzip",
-        shuffle=True,
-        dtype=h5_dtype,
+    return merge_extracted_hdf5_data_native(
+        h5_files,
+        out_h5_file,
+        datatype=datatype,
+        shuffle=shuffle,
+        rnd_seed=rnd_seed,
+        n_threads=n_threads,
     )
-    describDS = metaGrp.create_dataset("DESCRIPTION", (1,), dtype="S10")
-    describDS[0] = "Merged".encode()
-    fH5Out.close()
 
 
 def extract_chip_zone_image_band_values_to_hdf(
@@ -1679,11 +1858,15 @@ def extract_chip_zone_image_band_values_to_hdf(
     output_hdf,
     rotate_chips=None,
     datatype=None,
+    n_threads=1,
 ):
     """
     A function which extracts a chip/window of image pixel values. The expectation is
     that this is used to train a classifier (see deep learning functions
     in classification) but it could be used to extract image 'chips' for other purposes.
+    Without rotation the chips are extracted in C++, reading the image once and
+    writing the chips to the HDF5 file in compressed chunks, so the chips do not
+    need to fit in memory.
 
     :param input_image_info: is a list of rsgislib.imageutils.ImageBandInfo objects
                              specifying the input images and bands
@@ -1701,16 +1884,31 @@ def extract_chip_zone_image_band_values_to_hdf(
     :param datatype: is the data type used for the output HDF5 file (e.g.,
                      rsgislib.TYPE_32FLOAT). If None (default)
                      then the output data type will be float32.
+    :param n_threads: the number of threads used to cut the chips when they are
+                      not rotated (0 uses the number of cores).
 
     """
+    if datatype is None:
+        datatype = rsgislib.TYPE_32FLOAT
+
+    if rotate_chips is None:
+        n_chips = extract_chip_zone_img_band_values_to_hdf_native(
+            input_image_info,
+            image_mask,
+            mask_value,
+            chip_size,
+            output_hdf,
+            datatype=datatype,
+            n_threads=n_threads,
+        )
+        print("There were {} pixel samples in the mask.".format(n_chips))
+        return
+
     # Import the RIOS image reader
     from rios.imagereader import ImageReader
     import h5py
     import tqdm
 
-    if datatype is None:
-        datatype = rsgislib.TYPE_32FLOAT
-
     chip_size_odd = False
     if (chip_size % 2) != 0:
         chip_size_odd = True
@@ -2035,68 +2233,14 @@ def merge_extracted_hdf5_chip_data(h5_files, out_h5_file, datatype=None):
                                                            cloudTrainSamples)
 
     """
-    import h5py
-
     if datatype is None:
         datatype = rsgislib.TYPE_32FLOAT
 
-    first = True
-    n_feats = 0
-    chip_size = 0
-    n_bands = 0
-    for h5File in h5_files:
-        fH5 = h5py.File(h5File, "r")
-        data_shp = fH5["DATA/DATA"].shape
-        if first:
-            n_bands = data_shp[3]
-            chip_size = data_shp[1]
-            first = False
-        else:
-            if n_bands != data_shp[3]:
-                raise rsgislib.RSGISPyException(
-                    "The number of bands (variables) within the inputted "
-                    "HDF5 files was not the same."
-                )
-            if chip_size != data_shp[1]:
-                raise rsgislib.RSGISPyException(
-                    "The chip size within the inputted HDF5 files was not the same."
-                )
-        n_feats += data_shp[0]
-        fH5.close()
-
-    feat_arr = numpy.zeros(
-        [n_feats, chip_size, chip_size, n_bands], dtype=numpy.float32
+    # The files are copied a chunk at a time (in C++) so do not need to fit in memory.
+    merge_extracted_hdf5_chip_files_native(
+        h5_files, out_h5_file, datatype=datatype, with_ref=False
     )
 
-    row_init = 0
-    for h5File in h5_files:
-        fH5 = h5py.File(h5File, "r")
-        n_rows = fH5["DATA/DATA"].shape[0]
-        feat_arr[row_init : (row_init + n_rows)] = fH5["DATA/DATA"]
-        row_init += n_rows
-        fH5.close()
-
-    h5_dtype = rsgislib.get_numpy_char_codes_datatype(datatype)
-
-    chunk_size = 250
-    if n_feats < chunk_size:
-        chunk_size = n_feats
-
-    fH5Out = h5py.File(out_h5_file, "w")
-    dataGrp = fH5Out.create_group("DATA")
-    metaGrp = fH5Out.create_group("META-DATA")
-    dataGrp.create_dataset(
-        "DATA",
-        data=feat_arr,
-        chunks=(chunk_size, chip_size, chip_size, n_bands),
-        compression="gzip",
-        shuffle=True,
-        dtype=h5_dtype,
-    )
-    describDS = metaGrp.create_dataset("DESCRIPTION", (1,), dtype="S10")
-    describDS[0] = "Merged".encode()
-    fH5Out.close()
-
 
 def extract_ref_chip_zone_image_band_values_to_hdf(
     input_image_info,
@@ -2108,11 +2252,15 @@ def extract_ref_chip_zone_image_band_values_to_hdf(
     output_hdf,
     rotate_chips=None,
     datatype=None,
+    n_threads=1,
 ):
     """
     A function which extracts a chip/window of image pixel values. The expectation is
     that this is used to train a classifier (see deep learning functions in
     classification) but it could be used to extract image 'chips' for other purposes.
+    Without rotation the chips are extracted in C++, reading the images once and
+    writing the chips to the HDF5 file in compressed chunks, so the chips do not
+    need to fit in memory.
 
     :param input_image_info: is a list of rsgislib.imageutils.ImageBandInfo objects
                              specifying the input images and bands
@@ -2134,19 +2282,36 @@ def extract_ref_chip_zone_image_band_values_to_hdf(
     :param datatype: is the data type used for the output HDF5 file
                      (e.g., rsgislib.TYPE_32FLOAT). If None (default)
                      then the output data type will be float32.
+    :param n_threads: the number of threads used to cut the chips when they are
+                      not rotated (0 uses the number of cores).
 
     """
-    # Import the RIOS image reader
-    from rios.imagereader import ImageReader
-    import h5py
-    import tqdm
-
     if datatype is None:
         datatype = rsgislib.TYPE_32FLOAT
 
     if (chip_size % 2) != 0:
         raise rsgislib.RSGISPyException("The chip size must be an even number.")
 
+    if rotate_chips is None:
+        n_chips = extract_chip_zone_img_band_values_to_hdf_native(
+            input_image_info,
+            image_mask,
+            mask_value,
+            chip_size,
+            output_hdf,
+            datatype=datatype,
+            ref_img=ref_img,
+            ref_img_band=ref_img_band,
+            n_threads=n_threads,
+        )
+        print("There were {} pixel samples in the mask.".format(n_chips))
+        return
+
+    # Import the RIOS image reader
+    from rios.imagereader import ImageReader
+    import h5py
+    import tqdm
+
     chipHSize = math.floor(chip_size / 2)
 
     rotate = False
@@ -2507,77 +2672,13 @@ def merge_extracted_hdf5_chip_ref_data(h5_files, out_h5_file, datatype=None):
                                                                cloudTrainSamples)
 
     """
-    import h5py
-
     if datatype is None:
         datatype = rsgislib.TYPE_32FLOAT
 
-    first = True
-    n_feats = 0
-    chip_size = 0
-    n_bands = 0
-    for h5File in h5_files:
-        fH5 = h5py.File(h5File, "r")
-        data_shp = fH5["DATA/DATA"].shape
-        if first:
-            n_bands = data_shp[3]
-            chip_size = data_shp[1]
-            first = False
-        else:
-            if n_bands != data_shp[3]:
-                raise rsgislib.RSGISPyException(
-                    "The number of bands (variables) within the inputted "
-                    "HDF5 files was not the same."
-                )
-            if chip_size != data_shp[1]:
-                raise rsgislib.RSGISPyException(
-                    "The chip size within the inputted HDF5 files was not the same."
-                )
-        n_feats += data_shp[0]
-        fH5.close()
-
-    feat_arr = numpy.zeros(
-        [n_feats, chip_size, chip_size, n_bands], dtype=numpy.float32
-    )
-    feat_ref_arr = numpy.zeros([n_feats, chip_size, chip_size], dtype=numpy.uint16)
-
-    row_init = 0
-    for h5File in h5_files:
-        fH5 = h5py.File(h5File, "r")
-        n_rows = fH5["DATA/DATA"].shape[0]
-        feat_arr[row_init : (row_init + n_rows)] = fH5["DATA/DATA"]
-        feat_ref_arr[row_init : (row_init + n_rows)] = fH5["DATA/REF"]
-        row_init += n_rows
-        fH5.close()
-
-    h5_dtype = rsgislib.get_numpy_char_codes_datatype(datatype)
-
-    chunk_size = 250
-    if n_feats < chunk_size:
-        chunk_size = n_feats
-
-    fH5Out = h5py.File(out_h5_file, "w")
-    dataGrp = fH5Out.create_group("DATA")
-    metaGrp = fH5Out.create_group("META-DATA")
-    dataGrp.create_dataset(
-        "DATA",
-        data=feat_arr,
-        chunks=(chunk_size, chip_size, chip_size, n_bands),
-        compression="gzip",
-        shuffle=True,
-        dtype=h5_dtype,
+    # The files are copied a chunk at a time (in C++) so do not need to fit in memory.
+    merge_extracted_hdf5_chip_files_native(
+        h5_files, out_h5_file, datatype=datatype, with_ref=True
     )
-    dataGrp.create_dataset(
-        "REF",
-        data=feat_ref_arr,
-        chunks=(chunk_size, chip_size, chip_size),
-        compression="gzip",
-        shuffle=True,
-        dtype="H",
-    )
-    describDS = metaGrp.create_dataset("DESCRIPTION", (1,), dtype="S10")
-    describDS[0] = "Merged".encode()
-    fH5Out.close()
 
 
 def msk_h5_smpls_to_finite_values(
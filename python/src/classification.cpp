@@ -237,6 +237,149 @@ static PyObject *Classification_PopClassInfoAccuracyPts(PyObject *self, PyObject
 
 
 
+// Reads a sequence of objects with 'file_name' and 'bands' attributes (e.g., rsgislib.imageutils.ImageBandInfo).
+static bool Classification_ReadImageFileInfo(PyObject *self, PyObject *inputImageFileInfoObj, std::vector<std::pair<std::string, std::vector<unsigned int> > > *imageFilesInfo)
+{
+    if( !PySequence_Check(inputImageFileInfoObj))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "First argument (imageFileInfo) must be a sequence");
+        return false;
+    }
+
+    Py_ssize_t nFileInfo = PySequence_Size(inputImageFileInfoObj);
+    imageFilesInfo->reserve(nFileInfo);
+    std::string tmpFileName = "";
+
+    for( Py_ssize_t n = 0; n < nFileInfo; n++ )
+    {
+        PyObject *o = PySequence_GetItem(inputImageFileInfoObj, n);
+
+        PyObject *pFileName = PyObject_GetAttrString(o, "file_name");
+        if( ( pFileName == nullptr ) || ( pFileName == Py_None ) || !RSGISPY_CHECK_STRING(pFileName) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, "Could not find string attribute \'file_name\'" );
+            Py_XDECREF(pFileName);
+            Py_DECREF(o);
+            return false;
+        }
+
+        PyObject *pBands = PyObject_GetAttrString(o, "bands");
+        if( ( pBands == nullptr ) || ( pBands == Py_None ) || !PySequence_Check(pBands) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, "Could not find sequence attribute \'bands\'" );
+            Py_DECREF(pFileName);
+            Py_XDECREF(pBands);
+            Py_DECREF(o);
+            return false;
+        }
+
+        Py_ssize_t nBands = PySequence_Size(pBands);
+        if(nBands == 0)
+        {
+            PyErr_SetString(GETSTATE(self)->error, "Sequence attribute \'bands\' is empty." );
+            Py_DECREF(pFileName);
+            Py_DECREF(pBands);
+            Py_DECREF(o);
+            return false;
+        }
+        std::vector<unsigned int> bandsVec = std::vector<unsigned int>();
+        bandsVec.reserve(nBands);
+        for( Py_ssize_t i = 0; i < nBands; i++ )
+        {
+            PyObject *bO = PySequence_GetItem(pBands, i);
+            if( ( bO == nullptr ) || ( bO == Py_None ) || !RSGISPY_CHECK_INT(bO) )
+            {
+                PyErr_SetString(GETSTATE(self)->error, "Element of 'bands' list was not an integer." );
+                Py_XDECREF(bO);
+
+                Py_DECREF(pFileName);
+                Py_DECREF(pBands);
+                Py_DECREF(o);
+                return false;
+            }
+            bandsVec.push_back(RSGISPY_INT_EXTRACT(bO));
+            Py_DECREF(bO);
+        }
+
+        tmpFileName = std::string(RSGISPY_STRING_EXTRACT(pFileName));
+        imageFilesInfo->push_back(std::pair<std::string, std::vector<unsigned int> >(tmpFileName, bandsVec));
+        Py_DECREF(pFileName);
+        Py_DECREF(pBands);
+        Py_DECREF(o);
+    }
+    return true;
+}
+
+static PyObject *Classification_ApplyTreeEnsembleClassifier(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("model_file"), RSGIS_PY_C_TEXT("in_msk_img"),
+                             RSGIS_PY_C_TEXT("img_mask_val"), RSGIS_PY_C_TEXT("img_file_info"),
+                             RSGIS_PY_C_TEXT("out_class_img"), RSGIS_PY_C_TEXT("out_score_img"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("cls_out_ids"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszModelFile, *pszMaskImage, *pszOutClassImage;
+    const char *pszOutScoreImage = nullptr;
+    const char *pszGDALFormat = "KEA";
+    float maskVal = 1;
+    PyObject *imgFileInfoObj;
+    PyObject *clsOutIDsObj = Py_None;
+    unsigned int nThreads = 0;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssfOs|zsOI:apply_tree_ensemble_classifier", kwlist, &pszModelFile, &pszMaskImage, &maskVal,
+                                     &imgFileInfoObj, &pszOutClassImage, &pszOutScoreImage, &pszGDALFormat, &clsOutIDsObj, &nThreads))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFilesInfo;
+    if(!Classification_ReadImageFileInfo(self, imgFileInfoObj, &imageFilesInfo))
+    {
+        return nullptr;
+    }
+
+    std::vector<unsigned int> clsOutIDs;
+    if(clsOutIDsObj != Py_None)
+    {
+        if(!PySequence_Check(clsOutIDsObj))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "cls_out_ids must be a sequence of integers.");
+            return nullptr;
+        }
+        Py_ssize_t nIDs = PySequence_Size(clsOutIDsObj);
+        for(Py_ssize_t i = 0; i < nIDs; ++i)
+        {
+            PyObject *idObj = PySequence_GetItem(clsOutIDsObj, i);
+            if( ( idObj == nullptr ) || !RSGISPY_CHECK_INT(idObj) )
+            {
+                PyErr_SetString(GETSTATE(self)->error, "Element of cls_out_ids was not an integer.");
+                Py_XDECREF(idObj);
+                return nullptr;
+            }
+            clsOutIDs.push_back(RSGISPY_INT_EXTRACT(idObj));
+            Py_DECREF(idObj);
+        }
+    }
+
+    std::string outScoreImage = "";
+    if(pszOutScoreImage != nullptr)
+    {
+        outScoreImage = std::string(pszOutScoreImage);
+    }
+
+    try
+    {
+        rsgis::cmds::executeApplyTreeEnsemble(std::string(pszModelFile), imageFilesInfo, std::string(pszMaskImage), maskVal,
+                                              std::string(pszOutClassImage), outScoreImage, std::string(pszGDALFormat), clsOutIDs, nThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+
 
 // Our list of functions in this module
 static PyMethodDef ClassificationMethods[] = {
@@ -303,6 +446,34 @@ static PyMethodDef ClassificationMethods[] = {
 ":param vec_class_col: is a string specifying the output column in the vector file for the classified class names.\n"
 ":param vec_ref_col: is an optional string specifying an output column in the vector file which can be used in the accuracy assessment for the reference data.\n"
 ":param vec_process_col: is an optional string specifying an output column in the vector file which is used allocate points as processed or otherwise."
+},
+
+{"apply_tree_ensemble_classifier", (PyCFunction)Classification_ApplyTreeEnsembleClassifier, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.classification.apply_tree_ensemble_classifier(model_file, in_msk_img, img_mask_val, img_file_info, out_class_img, out_score_img=None, gdalformat='KEA', cls_out_ids=None, n_threads=0)\n"
+"Applies a tree ensemble classifier to an image in C++, evaluating the pixels of each image block across threads.\n"
+"The model can be a LightGBM text model (Booster.save_model; linear trees and categorical splits are not supported)\n"
+"or an rsgislib tree ensemble file exported from a\n"
+"scikit-learn random forest / extra trees classifier (rsgislib.classification.classsklearn.export_sklearn_tree_ensemble)\n"
+"or an XGBoost classifier (rsgislib.classification.classxgboost.export_xgboost_tree_ensemble).\n"
+"\n"
+":param model_file: the file path of the model.\n"
+":param in_msk_img: is an image file (1 band) providing a mask to specify where should be classified.\n"
+":param img_mask_val: the pixel value within the mask for the pixels to be classified.\n"
+":param img_file_info: a list of rsgislib.imageutils.ImageBandInfo objects identifying the images and bands\n"
+"                      used as the features, in the order used to train the model.\n"
+":param out_class_img: the output image with the class IDs (0 outside the mask).\n"
+":param out_score_img: an optional output image with the probability of each class (a band per class).\n"
+":param gdalformat: is the output image format.\n"
+":param cls_out_ids: optional list of the output class ID for each class (index) of the model; default is the class index + 1.\n"
+":param n_threads: the number of threads used (0 uses the number of cores).\n"
+"\n"
+".. code:: python\n"
+"\n"
+"   import rsgislib.classification\n"
+"   import rsgislib.imageutils\n"
+"   img_file_info = [rsgislib.imageutils.ImageBandInfo('sen2_img.kea', 'sen2', [1, 2, 3, 4])]\n"
+"   rsgislib.classification.apply_tree_ensemble_classifier('lgbm_model.txt', 'valid_msk.kea', 1, img_file_info, 'out_cls.kea', out_score_img='out_score.kea')\n"
+"\n"
 },
 
     {nullptr}        /* Sentinel */
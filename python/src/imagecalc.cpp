@@ -42,13 +42,16 @@ static PyObject *ImageCalc_BandMath(PyObject *self, PyObject *args, PyObject *ke
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("output_img"), RSGIS_PY_C_TEXT("exp"), RSGIS_PY_C_TEXT("gdalformat"),
                              RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("band_defs"), RSGIS_PY_C_TEXT("exp_band_name"),
-                             RSGIS_PY_C_TEXT("output_exists"), nullptr};
+                             RSGIS_PY_C_TEXT("output_exists"), RSGIS_PY_C_TEXT("skip_no_data_blocks"),
+                             RSGIS_PY_C_TEXT("no_data_val"), nullptr};
     const char *pszOutputFile, *pszExpression, *pszGDALFormat;
     int nDataType;
     int bExpBandName = 0;
     int bOutputImgExists = 0;
+    int bSkipNoDataBlocks = 0;
+    float noDataVal = 0.0;
     PyObject *pBandDefnObj;
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssiO|ii:band_math", kwlist, &pszOutputFile, &pszExpression, &pszGDALFormat, &nDataType, &pBandDefnObj, &bExpBandName, &bOutputImgExists))
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssiO|iiif:band_math", kwlist, &pszOutputFile, &pszExpression, &pszGDALFormat, &nDataType, &pBandDefnObj, &bExpBandName, &bOutputImgExists, &bSkipNoDataBlocks, &noDataVal))
     {
         return nullptr;
     }
@@ -114,7 +117,7 @@ static PyObject *ImageCalc_BandMath(PyObject *self, PyObject *args, PyObject *ke
         rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType)nDataType;
         bool useExpAsbandName = (bool)bExpBandName;
         bool outputImgExists = (bool)bOutputImgExists;
-        rsgis::cmds::executeBandMaths(pRSGISStruct, nBandDefns, pszOutputFile, pszExpression, pszGDALFormat, type, useExpAsbandName, outputImgExists);
+        rsgis::cmds::executeBandMaths(pRSGISStruct, nBandDefns, pszOutputFile, pszExpression, pszGDALFormat, type, useExpAsbandName, outputImgExists, (bool)bSkipNoDataBlocks, noDataVal);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -131,12 +134,15 @@ static PyObject *ImageCalc_ImageMath(PyObject *self, PyObject *args, PyObject *k
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"), RSGIS_PY_C_TEXT("exp"),
                              RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("exp_band_name"),
-                             RSGIS_PY_C_TEXT("output_exists"), nullptr};
+                             RSGIS_PY_C_TEXT("output_exists"), RSGIS_PY_C_TEXT("skip_no_data_blocks"),
+                             RSGIS_PY_C_TEXT("no_data_val"), nullptr};
     const char *pszInputImage, *pszOutputFile, *pszExpression, *pszGDALFormat;
     int nDataType;
     int bExpBandName = 0;
     int bOutputImgExists = 0;
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssssi|ii:image_math", kwlist, &pszInputImage, &pszOutputFile, &pszExpression, &pszGDALFormat, &nDataType, &bExpBandName, &bOutputImgExists))
+    int bSkipNoDataBlocks = 0;
+    float noDataVal = 0.0;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssssi|iiif:image_math", kwlist, &pszInputImage, &pszOutputFile, &pszExpression, &pszGDALFormat, &nDataType, &bExpBandName, &bOutputImgExists, &bSkipNoDataBlocks, &noDataVal))
     {
         return nullptr;
     }
@@ -146,7 +152,7 @@ static PyObject *ImageCalc_ImageMath(PyObject *self, PyObject *args, PyObject *k
         rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType)nDataType;
         bool useExpAsbandName = (bool)bExpBandName;
         bool outputImgExists = (bool)bOutputImgExists;
-        rsgis::cmds::executeImageMaths(pszInputImage, pszOutputFile, pszExpression, pszGDALFormat, type, useExpAsbandName, outputImgExists);
+        rsgis::cmds::executeImageMaths(pszInputImage, pszOutputFile, pszExpression, pszGDALFormat, type, useExpAsbandName, outputImgExists, (bool)bSkipNoDataBlocks, noDataVal);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -192,15 +198,22 @@ static PyObject *ImageCalc_KMeansClustering(PyObject *self, PyObject *args, PyOb
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("out_file"),
                              RSGIS_PY_C_TEXT("n_clusters"), RSGIS_PY_C_TEXT("max_n_iters"),
                              RSGIS_PY_C_TEXT("sub_sample"), RSGIS_PY_C_TEXT("ignore_zeros"),
-                             RSGIS_PY_C_TEXT("degree_change"), RSGIS_PY_C_TEXT("init_cluster_method"), nullptr};
+                             RSGIS_PY_C_TEXT("degree_change"), RSGIS_PY_C_TEXT("init_cluster_method"),
+                             RSGIS_PY_C_TEXT("sample_method"), RSGIS_PY_C_TEXT("n_samples"),
+                             RSGIS_PY_C_TEXT("rnd_seed"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
 
     const char *pszInputImage, *pszOutputFile;
     unsigned int nNumClusters, nMaxNumIterations, nSubSample;
     int nIgnoreZeros; // passed as a bool - seems the only way to pass into C
     float fDegreeOfChange;
     int nClusterMethod;
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssIIIifi:kmeans_clustering", kwlist, &pszInputImage, &pszOutputFile, &nNumClusters,
-                                &nMaxNumIterations, &nSubSample, &nIgnoreZeros, &fDegreeOfChange, &nClusterMethod ))
+    int nSampleMethod = 0;
+    unsigned long nSamples = 0;
+    unsigned int nRndSeed = 0;
+    unsigned int nThreads = 0;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssIIIifi|ikII:kmeans_clustering", kwlist, &pszInputImage, &pszOutputFile, &nNumClusters,
+                                &nMaxNumIterations, &nSubSample, &nIgnoreZeros, &fDegreeOfChange, &nClusterMethod,
+                                &nSampleMethod, &nSamples, &nRndSeed, &nThreads ))
     {
         return nullptr;
     }
@@ -208,7 +221,8 @@ static PyObject *ImageCalc_KMeansClustering(PyObject *self, PyObject *args, PyOb
     try
     {
         rsgis::cmds::executeKMeansClustering(pszInputImage, pszOutputFile, nNumClusters, nMaxNumIterations,
-                            nSubSample, nIgnoreZeros, fDegreeOfChange, (rsgis::cmds::RSGISInitClustererMethods)nClusterMethod);
+                            nSubSample, nIgnoreZeros, fDegreeOfChange, (rsgis::cmds::RSGISInitClustererMethods)nClusterMethod,
+                            (rsgis::cmds::RSGISPxlSampleMethods)nSampleMethod, nSamples, nRndSeed, nThreads);
         
     }
     catch(rsgis::cmds::RSGISCmdException &e)
@@ -228,17 +242,23 @@ static PyObject *ImageCalc_ISODataClustering(PyObject *self, PyObject *args, PyO
                              RSGIS_PY_C_TEXT("degree_change"), RSGIS_PY_C_TEXT("init_cluster_method"),
                              RSGIS_PY_C_TEXT("min_dist_clusters"), RSGIS_PY_C_TEXT("min_n_feats"),
                              RSGIS_PY_C_TEXT("max_std_dev"), RSGIS_PY_C_TEXT("min_n_clusters"),
-                             RSGIS_PY_C_TEXT("start_iter"), RSGIS_PY_C_TEXT("end_iter"), nullptr};
+                             RSGIS_PY_C_TEXT("start_iter"), RSGIS_PY_C_TEXT("end_iter"),
+                             RSGIS_PY_C_TEXT("sample_method"), RSGIS_PY_C_TEXT("n_samples"),
+                             RSGIS_PY_C_TEXT("rnd_seed"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
     const char *pszInputImage, *pszOutputFile;
     unsigned int nNumClusters, nMaxNumIterations, nSubSample, minNumFeatures, minNumClusters;
     unsigned int startIteration, endIteration;
     int nIgnoreZeros; // passed as a bool - seems the only way to pass into C
     float fDegreeOfChange, fMinDistBetweenClusters, maxStdDev;
     int nClusterMethod;
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssIIIififIfIII:isodata_clustering", kwlist, &pszInputImage, &pszOutputFile, &nNumClusters,
+    int nSampleMethod = 0;
+    unsigned long nSamples = 0;
+    unsigned int nRndSeed = 0;
+    unsigned int nThreads = 0;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssIIIififIfIII|ikII:isodata_clustering", kwlist, &pszInputImage, &pszOutputFile, &nNumClusters,
                                 &nMaxNumIterations, &nSubSample, &nIgnoreZeros, &fDegreeOfChange, &nClusterMethod,
                                 &fMinDistBetweenClusters, &minNumFeatures, &maxStdDev, &minNumClusters,
-                                &startIteration, &endIteration ))
+                                &startIteration, &endIteration, &nSampleMethod, &nSamples, &nRndSeed, &nThreads ))
     {
         return nullptr;
     }
@@ -247,7 +267,8 @@ static PyObject *ImageCalc_ISODataClustering(PyObject *self, PyObject *args, PyO
     {
         rsgis::cmds::executeISODataClustering(pszInputImage, pszOutputFile, nNumClusters, nMaxNumIterations,
                             nSubSample, nIgnoreZeros, fDegreeOfChange, (rsgis::cmds::RSGISInitClustererMethods)nClusterMethod, fMinDistBetweenClusters,
-                            minNumFeatures, maxStdDev, minNumClusters, startIteration, endIteration);
+                            minNumFeatures, maxStdDev, minNumClusters, startIteration, endIteration,
+                            (rsgis::cmds::RSGISPxlSampleMethods)nSampleMethod, nSamples, nRndSeed, nThreads);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -659,12 +680,14 @@ static PyObject *ImageCalc_PCA(PyObject *self, PyObject *args, PyObject *keywds)
 static PyObject *ImageCalc_CalculateRMSE(PyObject *self, PyObject *args, PyObject *keywds)
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("in_a_img"), RSGIS_PY_C_TEXT("img_a_band"),
-                             RSGIS_PY_C_TEXT("in_b_img"), RSGIS_PY_C_TEXT("img_b_band"), nullptr};
+                             RSGIS_PY_C_TEXT("in_b_img"), RSGIS_PY_C_TEXT("img_b_band"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
 
     const char *inputImageA, *inputImageB;
     unsigned int bandA, bandB;
+    unsigned int numThreads = 0;
 
-    if(!PyArg_ParseTupleAndKeywords(args, keywds, "sIsI:calculate_img_band_rmse", kwlist, &inputImageA, &bandA, &inputImageB, &bandB))
+    if(!PyArg_ParseTupleAndKeywords(args, keywds, "sIsI|I:calculate_img_band_rmse", kwlist, &inputImageA, &bandA, &inputImageB, &bandB, &numThreads))
     {
         return nullptr;
     }
@@ -672,7 +695,7 @@ static PyObject *ImageCalc_CalculateRMSE(PyObject *self, PyObject *args, PyObjec
     PyObject *outVal = PyTuple_New(1);
     try
     {
-        double rmseVal = rsgis::cmds::executeCalculateRMSE(inputImageA, bandA, inputImageB, bandB);
+        double rmseVal = rsgis::cmds::executeCalculateRMSE(inputImageA, bandA, inputImageB, bandB, numThreads);
         if(PyTuple_SetItem(outVal, 0, Py_BuildValue("d", rmseVal)) == -1)
         {
             throw rsgis::cmds::RSGISCmdException("Failed to add \'RMSE\' value to the list...");
@@ -688,6 +711,38 @@ static PyObject *ImageCalc_CalculateRMSE(PyObject *self, PyObject *args, PyObjec
 }
 
 
+static PyObject *ImageCalc_CalcImgBandPairStats(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("in_a_img"), RSGIS_PY_C_TEXT("img_a_band"),
+                             RSGIS_PY_C_TEXT("in_b_img"), RSGIS_PY_C_TEXT("img_b_band"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+
+    const char *inputImageA, *inputImageB;
+    unsigned int bandA, bandB;
+    unsigned int numThreads = 0;
+
+    if(!PyArg_ParseTupleAndKeywords(args, keywds, "sIsI|I:calc_img_band_pair_stats", kwlist, &inputImageA, &bandA, &inputImageB, &bandB, &numThreads))
+    {
+        return nullptr;
+    }
+
+    rsgis::cmds::ImagePairStatsCmds pairStats;
+    try
+    {
+        pairStats = rsgis::cmds::executeCalcImageBandPairStats(inputImageA, bandA, inputImageB, bandB, numThreads);
+    }
+    catch (rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return Py_BuildValue("{s:k,s:d,s:d,s:d,s:d,s:d,s:d,s:d}", "n", pairStats.n, "mean_a", pairStats.meanA,
+                         "mean_b", pairStats.meanB, "var_a", pairStats.varianceA, "var_b", pairStats.varianceB,
+                         "covariance", pairStats.covariance, "correlation", pairStats.correlation, "rmse", pairStats.rmse);
+}
+
+
 static PyObject *ImageCalc_AllBandsEqualTo(PyObject *self, PyObject *args, PyObject *keywds)
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
@@ -751,14 +806,15 @@ static PyObject *ImageCalc_GetHistogram(PyObject *self, PyObject *args, PyObject
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("img_band"),
                              RSGIS_PY_C_TEXT("bin_width"), RSGIS_PY_C_TEXT("calc_min_max"),
-                             RSGIS_PY_C_TEXT("min_val"), RSGIS_PY_C_TEXT("max_val"), nullptr};
+                             RSGIS_PY_C_TEXT("min_val"), RSGIS_PY_C_TEXT("max_val"), RSGIS_PY_C_TEXT("as_array"), nullptr};
 
     const char *inputImage;
     float binWidth, inMin, inMax;
     int calcInMinMax;
     unsigned int imgBand;
+    int asArray = false;
     
-    if(!PyArg_ParseTupleAndKeywords(args, keywds, "sIfiff:get_histogram", kwlist, &inputImage, &imgBand, &binWidth, &calcInMinMax, &inMin, &inMax))
+    if(!PyArg_ParseTupleAndKeywords(args, keywds, "sIfiff|i:get_histogram", kwlist, &inputImage, &imgBand, &binWidth, &calcInMinMax, &inMin, &inMax, &asArray))
     {
         return nullptr;
     }
@@ -772,24 +828,36 @@ static PyObject *ImageCalc_GetHistogram(PyObject *self, PyObject *args, PyObject
         double inMaxVal = inMax;
         unsigned int *bins = rsgis::cmds::executeGetHistogram(inputImage, imgBand, binWidth, &nBins, calcInMinMax, &inMinVal, &inMaxVal);
         
-        Py_ssize_t listLen = nBins;
-        
-        
-        binsList = PyTuple_New(listLen);
-        if(binsList == nullptr)
+        if(asArray)
         {
-            delete[] bins;
-            throw rsgis::cmds::RSGISCmdException("Could not create a python list...");
+            // Takes ownership of bins.
+            binsList = RSGISPY_CREATE_ARRAY(bins, nBins);
+            if(binsList == nullptr)
+            {
+                Py_DECREF(outList);
+                return nullptr;
+            }
         }
-        
-        for(unsigned int i = 0; i < nBins; ++i)
+        else
         {
-            if(PyTuple_SetItem(binsList, i, Py_BuildValue("I", bins[i])) == -1)
+            Py_ssize_t listLen = nBins;
+            
+            binsList = PyTuple_New(listLen);
+            if(binsList == nullptr)
+            {
+                delete[] bins;
+                throw rsgis::cmds::RSGISCmdException("Could not create a python list...");
+            }
+            
+            for(unsigned int i = 0; i < nBins; ++i)
             {
-                throw rsgis::cmds::RSGISCmdException("Failed to add a value to the list...");
+                if(PyTuple_SetItem(binsList, i, Py_BuildValue("I", bins[i])) == -1)
+                {
+                    throw rsgis::cmds::RSGISCmdException("Failed to add a value to the list...");
+                }
             }
+            delete[] bins;
         }
-        delete[] bins;
         
         if(PyTuple_SetItem(outList, 0, binsList) == -1)
         {
@@ -1794,10 +1862,51 @@ static PyObject *ImageCalc_CalcImgMeanInMask(PyObject *self, PyObject *args, PyO
     return outVal;
 }
 
+static PyObject *ImageCalc_CalcBayesianPosteriorStats(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("fx_exp"),
+                             RSGIS_PY_C_TEXT("variance"), RSGIS_PY_C_TEXT("interval"),
+                             RSGIS_PY_C_TEXT("min_val"), RSGIS_PY_C_TEXT("max_val"),
+                             RSGIS_PY_C_TEXT("lower_lim"), RSGIS_PY_C_TEXT("upper_lim"),
+                             RSGIS_PY_C_TEXT("use_cache"), RSGIS_PY_C_TEXT("cache_tol"),
+                             RSGIS_PY_C_TEXT("max_cache_entries"), nullptr};
+    const char *pInputImage = "";
+    const char *pOutputImage = "";
+    const char *pGDALFormat = "";
+    const char *pFxExp = "";
+    double variance = 0.0;
+    double interval = 0.0;
+    double minVal = 0.0;
+    double maxVal = 0.0;
+    double lowerLimit = 0.025;
+    double upperLimit = 0.975;
+    int useCache = true;
+    double cacheTol = 0.0;
+    unsigned long maxCacheEntries = 1048576;
+    
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssssdddd|ddidk:calc_bayesian_posterior_stats", kwlist, &pInputImage, &pOutputImage, &pGDALFormat, &pFxExp, &variance, &interval, &minVal, &maxVal, &lowerLimit, &upperLimit, &useCache, &cacheTol, &maxCacheEntries))
+    {
+        return nullptr;
+    }
+    
+    try
+    {
+        rsgis::cmds::executeCalcBaysianPosteriorStats(std::string(pInputImage), std::string(pOutputImage), std::string(pGDALFormat), std::string(pFxExp), variance, interval, minVal, maxVal, lowerLimit, upperLimit, (bool)useCache, cacheTol, maxCacheEntries);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+    
+    Py_RETURN_NONE;
+}
+
 // Our list of functions in this module
 static PyMethodDef ImageCalcMethods[] = {
     {"band_math", (PyCFunction)ImageCalc_BandMath, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagecalc.band_math(output_img:str, exp:str, gdalformat:str, datatype:int, band_defs:list, exp_band_name:bool, output_exists:bool)\n"
+"rsgislib.imagecalc.band_math(output_img:str, exp:str, gdalformat:str, datatype:int, band_defs:list, exp_band_name:bool, output_exists:bool, skip_no_data_blocks:bool, no_data_val:float)\n"
 "Performs band math calculation.\n"
 "The syntax for the expression is from the `muparser library <http://muparser.beltoforion.de>`_ "
 "`see here for available operations and syntax <http://beltoforion.de/article.php?a=muparser&hl=en&p=features&s=idPageTop>`_"
@@ -1808,7 +1917,9 @@ static PyMethodDef ImageCalcMethods[] = {
 ":param datatype: is an containing one of the values from rsgislib.TYPE_*\n"
 ":param band_defs: is a sequence of rsgislib.imagecalc.BandDefn objects that define the inputs\n"
 ":param exp_band_name: is an optional bool specifying whether the band name should be the expression (Default = False).\n"
-":param output_exists: is an optional bool specifying whether the output image already exists and it should be edited rather than overwritten (Default=False)."
+":param output_exists: is an optional bool specifying whether the output image already exists and it should be edited rather than overwritten (Default=False).\n"
+":param skip_no_data_blocks: is an optional bool specifying whether blocks where all the input bands are no data should be skipped, with the output set to no_data_val. The input band no data value is used if defined, otherwise no_data_val. Not used if output_exists is True. (Default=False)\n"
+":param no_data_val: is an optional float with the input and output no data value used when skip_no_data_blocks is True (Default=0)."
 "\n"
 "\n"
 ".. code:: python\n"
@@ -1830,7 +1941,7 @@ static PyMethodDef ImageCalcMethods[] = {
 "\n\n"},
 
 {"image_math", (PyCFunction)ImageCalc_ImageMath, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagecalc.image_math(input_img, output_img, exp, gdalformat, datatype, exp_band_name, output_exists)\n"
+"rsgislib.imagecalc.image_math(input_img, output_img, exp, gdalformat, datatype, exp_band_name, output_exists, skip_no_data_blocks, no_data_val)\n"
 "Performs image math calculations. Produces an output image file with the same number of bands as the input image.\n"
 "This function applies the same calculation to each image band (i.e., b1 is the only variable).\n"
 "The syntax for the expression is from the `muparser library <http://muparser.beltoforion.de>`_ "
@@ -1842,7 +1953,9 @@ static PyMethodDef ImageCalcMethods[] = {
 ":param gdalformat: is a string containing the GDAL format for the output file - eg 'KEA'\n"
 ":param datatype: is an containing one of the values from rsgislib.TYPE_*\n"
 ":param exp_band_name: is an optional bool specifying whether the band name should be the expression (Default = False).\n"
-":param output_exists: is an optional bool specifying whether the output image already exists and it should be edited rather than overwritten (Default=False)."
+":param output_exists: is an optional bool specifying whether the output image already exists and it should be edited rather than overwritten (Default=False).\n"
+":param skip_no_data_blocks: is an optional bool specifying whether blocks where all the input bands are no data should be skipped, with the output set to no_data_val. The input band no data value is used if defined, otherwise no_data_val. Not used if output_exists is True. (Default=False)\n"
+":param no_data_val: is an optional float with the input and output no data value used when skip_no_data_blocks is True (Default=0)."
 "\n"
 "\n"
 ".. code:: python\n"
@@ -1886,7 +1999,7 @@ static PyMethodDef ImageCalcMethods[] = {
 "\n"},
 
 {"kmeans_clustering", (PyCFunction)ImageCalc_KMeansClustering, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagecalc.kmeans_clustering(input_img, out_file, n_clusters, max_n_iters, sub_sample, ignore_zeros, degree_change, init_cluster_method)\n"
+"rsgislib.imagecalc.kmeans_clustering(input_img, out_file, n_clusters, max_n_iters, sub_sample, ignore_zeros, degree_change, init_cluster_method, sample_method, n_samples, rnd_seed, n_threads)\n"
 "Performs K Means Clustering and saves cluster centres to a text file.\n"
 "\n"
 ":param input_img: is a string providing the input image\n"
@@ -1897,6 +2010,10 @@ static PyMethodDef ImageCalcMethods[] = {
 ":param ignore_zeros: is a bool specifying if zeros in the image should be treated as no data.\n"
 ":param degree_change: is a float providing the minimum change between iterations before terminating.\n"
 ":param init_cluster_method: the method for initialising the clusters and is one of INITCLUSTER_* values\n"
+":param sample_method: is an optional rsgislib.PXL_SAMPLE_* value for how the pixels are sampled: every sub_sample pixel (STRIDE; default), a random sample of n_samples pixels (RESERVOIR) or one random pixel from every sub_sample pixels (STRATIFIED).\n"
+":param n_samples: is the number of pixels sampled with PXL_SAMPLE_RESERVOIR.\n"
+":param rnd_seed: is the seed for the random sampling methods (Default=0).\n"
+":param n_threads: is the number of threads used to read the image (Default=0; all available cores).\n"
 "\n"
 ".. code:: python\n"
 "\n"
@@ -1913,7 +2030,7 @@ static PyMethodDef ImageCalcMethods[] = {
 "\n"},
 
 {"isodata_clustering", (PyCFunction)ImageCalc_ISODataClustering, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagecalc.isodata_clustering(input_img, out_file, n_clusters, max_n_iters, sub_sample, ignore_zeros, degree_change, init_cluster_method, min_dist_clusters, min_n_feats, max_std_dev, min_n_clusters, start_iter, end_iter)\n"
+"rsgislib.imagecalc.isodata_clustering(input_img, out_file, n_clusters, max_n_iters, sub_sample, ignore_zeros, degree_change, init_cluster_method, min_dist_clusters, min_n_feats, max_std_dev, min_n_clusters, start_iter, end_iter, sample_method, n_samples, rnd_seed, n_threads)\n"
 "Performs ISO Data Clustering and saves cluster centres to a text file.\n"
 "\n"
 ":param input_img: is a string providing the input image\n"
@@ -1930,6 +2047,10 @@ static PyMethodDef ImageCalcMethods[] = {
 ":param min_n_clusters: is an int\n"
 ":param start_iter: is an int\n"
 ":param end_iter: is an int\n"
+":param sample_method: is an optional rsgislib.PXL_SAMPLE_* value for how the pixels are sampled: every sub_sample pixel (STRIDE; default), a random sample of n_samples pixels (RESERVOIR) or one random pixel from every sub_sample pixels (STRATIFIED).\n"
+":param n_samples: is the number of pixels sampled with PXL_SAMPLE_RESERVOIR.\n"
+":param rnd_seed: is the seed for the random sampling methods (Default=0).\n"
+":param n_threads: is the number of threads used to read the image (Default=0; all available cores).\n"
 "\n"
 ".. code:: python\n"
 "\n"
@@ -2028,17 +2149,32 @@ static PyMethodDef ImageCalcMethods[] = {
 },
 
 {"calculate_img_band_rmse", (PyCFunction)ImageCalc_CalculateRMSE, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagecalc.calculate_img_band_rmse(in_a_img, img_a_band, in_b_img, img_b_band)\n"
+"rsgislib.imagecalc.calculate_img_band_rmse(in_a_img, img_a_band, in_b_img, img_b_band, n_threads=0)\n"
 "Calculates the root mean squared error between two images\n"
 "\n"
 ":param in_a_img: is a string containing the name of the first input image file\n"
 ":param img_a_band: is an integer defining which band should be processed from inputImageA\n"
 ":param in_b_img: is a string containing the name of the second input image file\n"
 ":param img_b_band: is an integer defining which band should be processed from inputImageB\n"
+":param n_threads: is the number of threads used to process the images (Default: 0, i.e., all the available cores)\n"
 ":return: float\n"
 "\n"
 },
 
+{"calc_img_band_pair_stats", (PyCFunction)ImageCalc_CalcImgBandPairStats, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imagecalc.calc_img_band_pair_stats(in_a_img, img_a_band, in_b_img, img_b_band, n_threads=0)\n"
+"Calculates the RMSE, covariance and correlation between bands of two images, along with\n"
+"the mean and variance of each band, in a single pass over the overlap of the images.\n"
+"\n"
+":param in_a_img: is a string containing the name of the first input image file\n"
+":param img_a_band: is an integer defining which band should be processed from in_a_img (starts at 1)\n"
+":param in_b_img: is a string containing the name of the second input image file\n"
+":param img_b_band: is an integer defining which band should be processed from in_b_img (starts at 1)\n"
+":param n_threads: is the number of threads used to process the images (Default: 0, i.e., all the available cores)\n"
+":return: dict with the keys n, mean_a, mean_b, var_a, var_b, covariance, correlation and rmse\n"
+"\n"
+},
+
 {"all_bands_equal_to", (PyCFunction)ImageCalc_AllBandsEqualTo, METH_VARARGS | METH_KEYWORDS,
 "rsgislib.imagecalc.all_bands_equal_to(input_img, output_img,  img_val, out_true_val, out_false_val, gdalformat, datatype)\n"
 "Tests whether all bands are equal to the same value\n"
@@ -2070,7 +2206,7 @@ static PyMethodDef ImageCalcMethods[] = {
 },
     
 {"get_histogram", (PyCFunction)ImageCalc_GetHistogram, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagecalc.get_histogram(input_img, img_band, bin_width, calc_min_max, min_val, max_val)\n"
+"rsgislib.imagecalc.get_histogram(input_img, img_band, bin_width, calc_min_max, min_val, max_val, as_array=False)\n"
 "Generates and returns a histogram for the image.\n"
 "\n"
 ":param input_img: is a string containing the name of the input image file\n"
@@ -2079,8 +2215,11 @@ static PyMethodDef ImageCalcMethods[] = {
 ":param calc_min_max: is a boolean specifying whether inMin and inMax should be calculated\n"
 ":param min_val: is a float for the minimum image value to be included in the histogram\n"
 ":param max_val: is a float or the maximum image value to be included in the histogram\n"
+":param as_array: is a boolean specifying whether the bins are returned as a memoryview of the bin counts\n"
+"                 (unsigned ints), which can be used as a numpy array without a copy using numpy.asarray(bins),\n"
+"                 rather than a tuple of ints (Default: False).\n"
 "\n"
-":return: list of ints"
+":return: tuple (bins, min_val, max_val)"
 "\n"
 },
 
@@ -2434,6 +2573,28 @@ static PyMethodDef ImageCalcMethods[] = {
 ":return: float with mean value.\n"
 "\n"},
 
+{"calc_bayesian_posterior_stats", (PyCFunction)ImageCalc_CalcBayesianPosteriorStats, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imagecalc.calc_bayesian_posterior_stats(input_img=string, output_img=string, gdalformat=string, fx_exp=string, variance=float, interval=float, min_val=float, max_val=float, lower_lim=float, upper_lim=float, use_cache=boolean, cache_tol=float, max_cache_entries=int)\n"
+"A function to calculate, for each pixel of a single band image, the posterior (no prior) of\n"
+"the parameter x given the observed pixel value, where the observation is modelled as fx_exp plus\n"
+"gaussian noise. The posterior is integrated between min_val and max_val. The output image has\n"
+"5 bands: the lower value, the maximum likelihood value, the upper value, delta- and delta+.\n"
+"\n"
+":param input_img: is a string specifying input image file.\n"
+":param output_img: is a string specifying the output image file.\n"
+":param gdalformat: is a string specifying the output image format (e.g., KEA).\n"
+":param fx_exp: is a string with the muparser expression of the model function of the variable x.\n"
+":param variance: is a float with the noise term of the likelihood.\n"
+":param interval: is a float with the integration interval.\n"
+":param min_val: is a float with the minimum value of x to integrate from.\n"
+":param max_val: is a float with the maximum value of x to integrate to.\n"
+":param lower_lim: is the proportion of the area under the posterior for the lower value (Default = 0.025).\n"
+":param upper_lim: is the proportion of the area under the posterior for the upper value (Default = 0.975).\n"
+":param use_cache: is a boolean specifying whether the posterior is only calculated once for each pixel value (Default = True).\n"
+":param cache_tol: is a float which, if greater than 0, bins the pixel values to this width and calculates the posterior at the bin centre (Default = 0).\n"
+":param max_cache_entries: is the maximum number of values cached; further values are calculated directly (Default = 1048576).\n"
+"\n"},
+
 {nullptr}        /* Sentinel */
 };
 
@@ -1660,6 +1660,36 @@ static PyObject *ImageCalibration_calcCloudShadowMask(PyObject *self, PyObject *
     Py_RETURN_NONE;
 }
 
+static PyObject *ImageCalibration_CloudMajorityFilter(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("win_size"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+
+    const char *pszInputFile, *pszOutputFile;
+    const char *pszGDALFormat = "KEA";
+    unsigned int winSize = 5;
+    unsigned int nThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ss|sII:apply_cloud_majority_filter", kwlist, &pszInputFile, &pszOutputFile,
+                                     &pszGDALFormat, &winSize, &nThreads))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        rsgis::cmds::executeCloudMajorityFilter(std::string(pszInputFile), std::string(pszOutputFile), std::string(pszGDALFormat), winSize, nThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
 // Our list of functions in this module
 static PyMethodDef ImageCalibrationMethods[] = {
 {"landsat_to_radiance", (PyCFunction)ImageCalibration_landsat2Radiance, METH_VARARGS | METH_KEYWORDS,
@@ -1970,6 +2000,18 @@ static PyMethodDef ImageCalibrationMethods[] = {
 ":param sensor_zenith: is the sensor azimuth of the input image\n"
 ":param rm_tmp_imgs: is a bool specifying whether the tmp images should be deleted at the end of the processing (Optional; Default = True)\n"
 "\n"
+},
+
+{"apply_cloud_majority_filter", (PyCFunction)ImageCalibration_CloudMajorityFilter, METH_VARARGS | METH_KEYWORDS,
+"imagecalibration.apply_cloud_majority_filter(input_img, output_img, gdalformat='KEA', win_size=5, n_threads=1)\n"
+"Apply the majority filter used within the cloud masking to a binary cloud mask (1 is cloud).\n"
+"\n"
+":param input_img: is a string containing the name of the input single band cloud mask\n"
+":param output_img: is a string containing the name of the output image file\n"
+":param gdalformat: is a string containing the GDAL format for the output file - eg 'KEA'\n"
+":param win_size: is an (odd) unsigned int specifying the size of the filter window (Default = 5)\n"
+":param n_threads: is the number of threads used to process the image in strips; 1 processes the image serially and 0 uses all the available cores (Default = 1)\n"
+"\n"
 },
     
     {nullptr}        /* Sentinel */
@@ -290,15 +290,16 @@ static PyObject *ImageMorphology_ImageLocalMinima(PyObject *self, PyObject *args
     int morphOpSize;
     int outputSequencial;
     int allowEquals;
+    int resolvePlateaus = false;
     
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
                              RSGIS_PY_C_TEXT("sequencial_out"), RSGIS_PY_C_TEXT("allow_equal"),
                              RSGIS_PY_C_TEXT("morph_op_file"), RSGIS_PY_C_TEXT("use_op_file"),
                              RSGIS_PY_C_TEXT("op_size"), RSGIS_PY_C_TEXT("gdalformat"),
-                             RSGIS_PY_C_TEXT("datatype"), nullptr};
-    if(!PyArg_ParseTupleAndKeywords(args, keywds, "ssiisiisi:image_local_minima", kwlist, &pszInputImage, &pszOutputImage,
+                             RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("resolve_plateaus"), nullptr};
+    if(!PyArg_ParseTupleAndKeywords(args, keywds, "ssiisiisi|i:image_local_minima", kwlist, &pszInputImage, &pszOutputImage,
                                     &outputSequencial, &allowEquals, &pszMorphOperator, &useOperatorFile, &morphOpSize,
-                                    &pszImageFormat, &datatype))
+                                    &pszImageFormat, &datatype, &resolvePlateaus))
     {
         return nullptr;
     }
@@ -308,7 +309,7 @@ static PyObject *ImageMorphology_ImageLocalMinima(PyObject *self, PyObject *args
         rsgis::cmds::executeImageLocalMinima(std::string(pszInputImage), std::string(pszOutputImage),
                                              (bool)outputSequencial, (bool)allowEquals,
                                              std::string(pszMorphOperator), (bool)useOperatorFile,
-                                             morphOpSize, std::string(pszImageFormat), (rsgis::RSGISLibDataType)datatype);
+                                             morphOpSize, std::string(pszImageFormat), (rsgis::RSGISLibDataType)datatype, (bool)resolvePlateaus);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -329,15 +330,16 @@ static PyObject *ImageMorphology_ImageLocalMinimaCombinedOut(PyObject *self, PyO
     int morphOpSize;
     int outputSequencial;
     int allowEquals;
+    int resolvePlateaus = false;
     
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
                              RSGIS_PY_C_TEXT("sequencial_out"), RSGIS_PY_C_TEXT("allow_equal"),
                              RSGIS_PY_C_TEXT("morph_op_file"), RSGIS_PY_C_TEXT("use_op_file"),
                              RSGIS_PY_C_TEXT("op_size"), RSGIS_PY_C_TEXT("gdalformat"),
-                             RSGIS_PY_C_TEXT("datatype"), nullptr};
-    if(!PyArg_ParseTupleAndKeywords(args, keywds, "ssiisiisi:image_local_minima_combined_out", kwlist, &pszInputImage,
+                             RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("resolve_plateaus"), nullptr};
+    if(!PyArg_ParseTupleAndKeywords(args, keywds, "ssiisiisi|i:image_local_minima_combined_out", kwlist, &pszInputImage,
                                     &pszOutputImage, &outputSequencial, &allowEquals, &pszMorphOperator, &useOperatorFile,
-                                    &morphOpSize, &pszImageFormat, &datatype))
+                                    &morphOpSize, &pszImageFormat, &datatype, &resolvePlateaus))
     {
         return nullptr;
     }
@@ -347,7 +349,7 @@ static PyObject *ImageMorphology_ImageLocalMinimaCombinedOut(PyObject *self, PyO
         rsgis::cmds::executeImageLocalMinimaCombinedOut(std::string(pszInputImage), std::string(pszOutputImage),
                                                         (bool)outputSequencial, (bool)allowEquals,
                                                         std::string(pszMorphOperator), (bool)useOperatorFile,
-                                                        morphOpSize, std::string(pszImageFormat), (rsgis::RSGISLibDataType)datatype);
+                                                        morphOpSize, std::string(pszImageFormat), (rsgis::RSGISLibDataType)datatype, (bool)resolvePlateaus);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -621,7 +623,7 @@ static PyMethodDef ImageMorphologyMethods[] = {
 "\n"},
     
 {"image_local_minima", (PyCFunction)ImageMorphology_ImageLocalMinima, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagemorphology.image_local_minima(input_img:str, output_img:str, sequencial_out:bool, allow_equal:bool, morph_op_file:str, use_op_file:bool, op_size:int, gdalformat:str, datatype:int)\n"
+"rsgislib.imagemorphology.image_local_minima(input_img:str, output_img:str, sequencial_out:bool, allow_equal:bool, morph_op_file:str, use_op_file:bool, op_size:int, gdalformat:str, datatype:int, resolve_plateaus:bool=False)\n"
 "Uses image morphology to find local minima. \n"
 "\n"
 "\n"
@@ -634,10 +636,11 @@ static PyMethodDef ImageMorphologyMethods[] = {
 ":param op_size: is a integer specifying the square operator size (only used if use_op_file is False)\n"
 ":param gdalformat: is a string specifying the GDAL image format (e.g., KEA)\n"
 ":param datatype: is an int containing one of the values from rsgislib.TYPE_*\n"
+":param resolve_plateaus: is a boolean specifying whether plateaus (connected regions of equal value) are identified, where a plateau is a minima if none of its pixels has a lower neighbour and all its pixels are given the same label. allow_equal is not used if True. (Default: False)\n"
 "\n"},
     
 {"image_local_minima_combined_out", (PyCFunction)ImageMorphology_ImageLocalMinimaCombinedOut, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imagemorphology.image_local_minima_combined_out(input_img:str, output_img:str, sequencial_out:bool, allow_equal:bool, morph_op_file:str, use_op_file:bool, op_size:int, gdalformat:str, datatype:int)\n"
+"rsgislib.imagemorphology.image_local_minima_combined_out(input_img:str, output_img:str, sequencial_out:bool, allow_equal:bool, morph_op_file:str, use_op_file:bool, op_size:int, gdalformat:str, datatype:int, resolve_plateaus:bool=False)\n"
 "Uses image morphology to find local minima, where the outputs will be combined into a single image.\n"
 "\n"
 "\n"
@@ -650,6 +653,7 @@ static PyMethodDef ImageMorphologyMethods[] = {
 ":param op_size: is a integer specifying the square operator size (only used if use_op_file is False)\n"
 ":param gdalformat: is a string specifying the GDAL image format (e.g., KEA)\n"
 ":param datatype: is an int containing one of the values from rsgislib.TYPE_*\n"
+":param resolve_plateaus: is a boolean specifying whether plateaus (connected regions of equal value) are identified, where a plateau is a minima if none of its pixels has a lower neighbour and all its pixels are given the same label. allow_equal is not used if True. (Default: False)\n"
 "\n"},
 
 {"image_opening", (PyCFunction)ImageMorphology_ImageOpening, METH_VARARGS | METH_KEYWORDS,
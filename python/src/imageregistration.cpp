@@ -42,17 +42,20 @@ static PyObject *ImageRegistration_FindImageOffset(PyObject *self, PyObject *arg
     static char *kwlist[] = {RSGIS_PY_C_TEXT("in_ref_img"), RSGIS_PY_C_TEXT("in_float_img"),
                              RSGIS_PY_C_TEXT("ref_img_bands"), RSGIS_PY_C_TEXT("flt_img_bands"),
                              RSGIS_PY_C_TEXT("metric_type"), RSGIS_PY_C_TEXT("x_search"),
-                             RSGIS_PY_C_TEXT("y_search"), RSGIS_PY_C_TEXT("sub_pxl_res"),  nullptr};
+                             RSGIS_PY_C_TEXT("y_search"), RSGIS_PY_C_TEXT("sub_pxl_res"),
+                             RSGIS_PY_C_TEXT("n_pyramid_levels"), RSGIS_PY_C_TEXT("use_phase_corr"), nullptr};
     const char *pszInputRefImage, *pszInputFloatImage;
     int subPixelResolution = 0;
+    unsigned int numPyramidLevels = 0;
+    int usePhaseCorr = false;
     int metricType = 0;
     int xImgSearch, yImgSearch = 0;
     PyObject *pRefImageBandsObj;
     PyObject *pFltImageBandsObj;
 
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssOOiii|i:find_image_offset", kwlist, &pszInputRefImage,
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssOOiii|iIp:find_image_offset", kwlist, &pszInputRefImage,
                                      &pszInputFloatImage, &pRefImageBandsObj, &pFltImageBandsObj, &metricType,
-                                     &xImgSearch, &yImgSearch, &subPixelResolution))
+                                     &xImgSearch, &yImgSearch, &subPixelResolution, &numPyramidLevels, &usePhaseCorr))
     {
         return nullptr;
     }
@@ -90,7 +93,8 @@ static PyObject *ImageRegistration_FindImageOffset(PyObject *self, PyObject *arg
                                                                                  std::string(pszInputFloatImage),
                                                                                  refImageBands, fltImageBands,
                                                                                  xImgSearch, yImgSearch,
-                                                                                 metricType, subPixelResolution);
+                                                                                 metricType, subPixelResolution,
+                                                                                 numPyramidLevels, usePhaseCorr);
 
         if(PyTuple_SetItem(outVal, 0, Py_BuildValue("d", offsets.first)) == -1)
         {
@@ -119,14 +123,16 @@ static PyObject *ImageRegistration_BasicRegistration(PyObject *self, PyObject *a
                              RSGIS_PY_C_TEXT("threshold"), RSGIS_PY_C_TEXT("win_size"),
                              RSGIS_PY_C_TEXT("search_area"), RSGIS_PY_C_TEXT("sd_ref_thres"),
                              RSGIS_PY_C_TEXT("sd_flt_thres"), RSGIS_PY_C_TEXT("sub_pxl_res"),
-                             RSGIS_PY_C_TEXT("metric_type"), RSGIS_PY_C_TEXT("output_type"),  nullptr};
+                             RSGIS_PY_C_TEXT("metric_type"), RSGIS_PY_C_TEXT("output_type"),
+                             RSGIS_PY_C_TEXT("n_pyramid_levels"), nullptr};
     const char *pszInputReferenceImage, *pszInputFloatingmage, *pszOutputGCPFile;
     int pixelGap, windowSize, searchArea, subPixelResolution, metricType, outputType;
     float threshold, stdDevRefThreshold, stdDevFloatThreshold;
+    unsigned int numPyramidLevels = 0;
     
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssifiiffiii:basic_registration", kwlist, &pszInputReferenceImage, &pszInputFloatingmage,
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssifiiffiii|I:basic_registration", kwlist, &pszInputReferenceImage, &pszInputFloatingmage,
                                      &pszOutputGCPFile, &pixelGap, &threshold, &windowSize, &searchArea, &stdDevRefThreshold,
-                                     &stdDevFloatThreshold, &subPixelResolution, &metricType, &outputType))
+                                     &stdDevFloatThreshold, &subPixelResolution, &metricType, &outputType, &numPyramidLevels))
     {
         return nullptr;
     }
@@ -136,7 +142,7 @@ static PyObject *ImageRegistration_BasicRegistration(PyObject *self, PyObject *a
         rsgis::cmds:: excecuteBasicRegistration(pszInputReferenceImage, pszInputFloatingmage, pixelGap,
                                     threshold, windowSize, searchArea, stdDevRefThreshold,
                                     stdDevFloatThreshold, subPixelResolution, metricType,
-                                    outputType, pszOutputGCPFile);
+                                    outputType, pszOutputGCPFile, numPyramidLevels);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -240,10 +246,49 @@ static PyObject *ImageRegistration_ApplyOffset2Image(PyObject *self, PyObject *a
     Py_RETURN_NONE;
 }
 
+static PyObject *ImageRegistration_WarpWithGCPs(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("in_ref_img"), RSGIS_PY_C_TEXT("in_process_img"),
+                             RSGIS_PY_C_TEXT("in_gcp_file"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("datatype"),
+                             RSGIS_PY_C_TEXT("interp_method"), RSGIS_PY_C_TEXT("use_tps"),
+                             RSGIS_PY_C_TEXT("poly_order"), RSGIS_PY_C_TEXT("grid_step"),
+                             RSGIS_PY_C_TEXT("no_data_val"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszInputRefImage, *pszInputImage, *pszInputGCPFile, *pszOutputImage, *pszGDALFormat;
+    int nOutDataType;
+    unsigned int interpMethod = 0;
+    int useTPS = false;
+    unsigned int polyOrder = 2;
+    unsigned int gridStep = 16;
+    float noDataVal = 0.0;
+    unsigned int numThreads = 0;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssssi|IiIIfI:warp_with_gcps", kwlist, &pszInputRefImage, &pszInputImage,
+                                     &pszInputGCPFile, &pszOutputImage, &pszGDALFormat, &nOutDataType, &interpMethod,
+                                     &useTPS, &polyOrder, &gridStep, &noDataVal, &numThreads))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        rsgis::cmds::executeWarpImageGCPs(std::string(pszInputRefImage), std::string(pszInputImage), std::string(pszInputGCPFile),
+                                          std::string(pszOutputImage), std::string(pszGDALFormat), (rsgis::RSGISLibDataType) nOutDataType,
+                                          interpMethod, useTPS, polyOrder, gridStep, noDataVal, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
 // Our list of functions in this module
 static PyMethodDef ImageRegistrationMethods[] = {
 {"find_image_offset", (PyCFunction)ImageRegistration_FindImageOffset, METH_VARARGS | METH_KEYWORDS,
-"imageregistration.find_image_offset(in_ref_img:str, in_float_img:str, ref_img_bands:list, flt_img_bands:list, metric_type:int, x_search:int,  y_search:int, sub_pxl_res:int)\n"
+"imageregistration.find_image_offset(in_ref_img:str, in_float_img:str, ref_img_bands:list, flt_img_bands:list, metric_type:int, x_search:int,  y_search:int, sub_pxl_res:int, n_pyramid_levels:int=0, use_phase_corr:bool=False)\n"
 "Calculate and X/Y offset between the input reference and float images.\n"
 "This function will calculate the similarity intersecting regions of the\n"
 "two images and identified an X/Y where the similarity is greatest.\n"
@@ -256,13 +301,15 @@ static PyMethodDef ImageRegistrationMethods[] = {
 ":param x_search: is the number of pixels in the x-axis the image can be moved either side of the centre.\n"
 ":param y_search: is the number of pixels in the y-axis the image can be moved either side of the centre.\n"
 ":param sub_pxl_res: is an optional (if not specified then no sub-pixel component will be estimated) int specifying the sub-pixel resolution to which the pixel shifts are estimated. Note that the values are positive integers such that a value of 2 will result in a sub pixel resolution of 0.5 of a pixel and a value 4 will be 0.25 of a pixel. \n"
+":param n_pyramid_levels: is an optional int specifying the number of image pyramid levels (each half the resolution of the previous level) to use. If greater than 1, the images are read into memory, the full search is only carried out at the coarsest level and the offset is refined at each finer level, which is much faster for large search distances. (Default: 0; i.e., search at the native resolution only)\n"
+":param use_phase_corr: is an optional bool specifying that the offset at the coarsest pyramid level should be estimated using phase correlation rather than searching all the offsets. (Default: False)\n"
 ":return: (x_offset, y_offset)\n"
 "\n"
 "\n"
 },
 
 {"basic_registration", (PyCFunction)ImageRegistration_BasicRegistration, METH_VARARGS | METH_KEYWORDS,
-"imageregistration.basic_registration(in_ref_img:str, in_float_img:str, out_gcp_file:str, pixel_gap:int, threshold:float, win_size:int, search_area:int, sd_ref_thres:float, sd_flt_thres:float, sub_pxl_res:float, metric_type:int, output_type:int)\n"
+"imageregistration.basic_registration(in_ref_img:str, in_float_img:str, out_gcp_file:str, pixel_gap:int, threshold:float, win_size:int, search_area:int, sd_ref_thres:float, sd_flt_thres:float, sub_pxl_res:float, metric_type:int, output_type:int, n_pyramid_levels:int=0)\n"
 "Generate tie points between floating and reference image using basic algorithm.\n"
 "\n"
 ":param in_ref_img: is a string providing reference image which to which the floating image is to be registered.n"
@@ -277,6 +324,7 @@ static PyMethodDef ImageRegistrationMethods[] = {
 ":param sub_pxl_res: is an int specifying the sub-pixel resolution to which the pixel shifts are estimated. Note that the values are positive integers such that a value of 2 will result in a sub pixel resolution of 0.5 of a pixel and a value 4 will be 0.25 of a pixel. \n"
 ":param metric_type: is an the similarity metric used to compare images of type rsgislib.imageregistration.METRIC_* \n"
 ":param output_type: is an the format of the output file of type rsgislib.imageregistration.TYPE_* \n"
+":param n_pyramid_levels: is an optional int specifying the number of in-memory image pyramid levels used to find the tie point offsets. If greater than 1, the search area is searched at the coarser levels and the tie points are then only refined by up to 2 pixels at the native resolution. (Default: 0; i.e., search at the native resolution only)\n"
 "\n"
 ".. code:: python\n"
 "\n"
@@ -379,6 +427,37 @@ static PyMethodDef ImageRegistrationMethods[] = {
 "    datatype = rsgislib.TYPE_32INT\n"
 "    imageregistration.apply_offset_to_image(inputImage, outputImage, gdalformat, datatype, -3.0, -3.0)\n"
 "\n"
+},
+
+{"warp_with_gcps", (PyCFunction)ImageRegistration_WarpWithGCPs, METH_VARARGS | METH_KEYWORDS,
+"imageregistration.warp_with_gcps(in_ref_img:str, in_process_img:str, in_gcp_file:str, output_img:str, gdalformat:str, datatype:int, interp_method:int=rsgislib.INTERP_NEAREST_NEIGHBOUR, use_tps:bool=False, poly_order:int=2, grid_step:int=16, no_data_val:float=0, n_threads:int=0)\n"
+"Warp an image using the tie points from basic_registration or single_layer_registration\n"
+"(TYPE_RSGIS_IMG2MAP) onto the pixel grid of the reference image, without needing a separate\n"
+"GDAL warp. The transform is fitted once and evaluated on a coarse grid of output pixels, with\n"
+"the location of each output pixel interpolated from that grid, and the output is resampled\n"
+"in parallel.\n"
+"\n"
+":param in_ref_img: is a string providing the reference image which defines the output pixel grid.\n"
+":param in_process_img: is a string providing the image to be warped (the floating image).\n"
+":param in_gcp_file: is a string providing the input text file containing the tie points.\n"
+":param output_img: is a string providing the output image.\n"
+":param gdalformat: is a string providing the output format (e.g., KEA).\n"
+":param datatype: is a rsgislib.TYPE_* value providing the output data type.\n"
+":param interp_method: is the interpolation method, one of rsgislib.INTERP_NEAREST_NEIGHBOUR,\n"
+"                      rsgislib.INTERP_BILINEAR or rsgislib.INTERP_CUBIC.\n"
+":param use_tps: if True a thin plate spline (rubber sheet) transform is used rather than a polynomial.\n"
+":param poly_order: is the order of the polynomial transform (1, 2 or 3).\n"
+":param grid_step: is the spacing, in output pixels, of the grid on which the transform is evaluated (1 evaluates\n"
+"                  every pixel).\n"
+":param no_data_val: is the output no data value, also used for the input if it does not define one.\n"
+":param n_threads: is the number of threads used for the resampling (0 uses all the cores).\n"
+"\n"
+".. code:: python\n"
+"\n"
+"    import rsgislib\n"
+"    from rsgislib import imageregistration\n"
+"    imageregistration.warp_with_gcps('ref.kea', 'float.kea', 'tie_points.txt', 'float_warped.kea', 'KEA', rsgislib.TYPE_16UINT, rsgislib.INTERP_CUBIC, poly_order=2)\n"
+"\n"
 },
     
 	{nullptr}        /* Sentinel */
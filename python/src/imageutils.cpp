@@ -275,6 +275,54 @@ static PyObject *ImageUtils_maskImage(PyObject *self, PyObject *args, PyObject *
     Py_RETURN_NONE;
 }
 
+static PyObject *ImageUtils_RelabelPxlValsLUT(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("datatype"),
+                             RSGIS_PY_C_TEXT("lut"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszInputImage, *pszOutputImage, *pszGDALFormat;
+    int nDataType;
+    PyObject *lutObj;
+    unsigned int numThreads = 0;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssiO|I:relabel_pxl_vals", kwlist, &pszInputImage, &pszOutputImage, &pszGDALFormat, &nDataType, &lutObj, &numThreads))
+    {
+        return nullptr;
+    }
+
+    if( !PyDict_Check(lutObj))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "The LUT must be a dict of input to output values.");
+        return nullptr;
+    }
+
+    std::vector<double> inVals;
+    std::vector<double> outVals;
+    PyObject *keyObj, *valObj;
+    Py_ssize_t pos = 0;
+    while(PyDict_Next(lutObj, &pos, &keyObj, &valObj))
+    {
+        if((!(RSGISPY_CHECK_FLOAT(keyObj) || RSGISPY_CHECK_INT(keyObj))) || (!(RSGISPY_CHECK_FLOAT(valObj) || RSGISPY_CHECK_INT(valObj))))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "The LUT keys and values must be numeric.");
+            return nullptr;
+        }
+        inVals.push_back(RSGISPY_FLOAT_EXTRACT(keyObj));
+        outVals.push_back(RSGISPY_FLOAT_EXTRACT(valObj));
+    }
+
+    try
+    {
+        rsgis::cmds::executeRelabelPxlValsLUT(pszInputImage, pszOutputImage, pszGDALFormat, (rsgis::RSGISLibDataType)nDataType, inVals, outVals, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *ImageUtils_createTiles(PyObject *self, PyObject *args, PyObject *keywds)
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("out_img_base"),
@@ -895,6 +943,503 @@ static PyObject *ImageUtils_Subset2Img(PyObject *self, PyObject *args, PyObject
     Py_RETURN_NONE;
 }
 
+static PyObject *ImageUtils_Subset2Polys(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("vec_file"),
+                             RSGIS_PY_C_TEXT("vec_lyr"), RSGIS_PY_C_TEXT("att_unq_val_col"),
+                             RSGIS_PY_C_TEXT("out_img_base"), RSGIS_PY_C_TEXT("gdalformat"),
+                             RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("out_img_ext"),
+                             RSGIS_PY_C_TEXT("mask_to_poly"), RSGIS_PY_C_TEXT("no_data_val"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszInputImage, *pszInputVectorFile, *pszInputVectorLyr, *pszAttCol, *pszImageBase, *pszGDALFormat, *pszExt;
+    int nOutDataType;
+    int maskToPoly = false;
+    float noDataVal = 0.0;
+    unsigned int numThreads = 0;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssssssis|ifI:subset_to_polys", kwlist, &pszInputImage, &pszInputVectorFile, &pszInputVectorLyr, &pszAttCol, &pszImageBase, &pszGDALFormat, &nOutDataType, &pszExt, &maskToPoly, &noDataVal, &numThreads))
+    {
+        return nullptr;
+    }
+
+    PyObject *pOutList;
+    try
+    {
+        std::vector<std::string> outFileNames;
+        rsgis::cmds::executeSubset2Polys(std::string(pszInputImage), std::string(pszInputVectorFile),
+                                         std::string(pszInputVectorLyr), std::string(pszAttCol),
+                                         std::string(pszImageBase), std::string(pszGDALFormat),
+                                         (rsgis::RSGISLibDataType)nOutDataType, std::string(pszExt),
+                                         &outFileNames, maskToPoly, noDataVal, numThreads);
+
+        pOutList = PyList_New(outFileNames.size());
+        Py_ssize_t nIndex = 0;
+        for( auto itr = outFileNames.begin(); itr != outFileNames.end(); itr++)
+        {
+            PyObject *pVal = RSGISPY_CREATE_STRING((*itr).c_str());
+            PyList_SetItem(pOutList, nIndex, pVal ); // steals a reference
+            nIndex++;
+        }
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return pOutList;
+}
+
+static PyObject *ImageUtils_CreateFileList(std::vector<std::string> &outFileNames)
+{
+    PyObject *pOutList = PyList_New(outFileNames.size());
+    Py_ssize_t nIndex = 0;
+    for( auto itr = outFileNames.begin(); itr != outFileNames.end(); itr++)
+    {
+        PyObject *pVal = RSGISPY_CREATE_STRING((*itr).c_str());
+        PyList_SetItem(pOutList, nIndex, pVal ); // steals a reference
+        nIndex++;
+    }
+    return pOutList;
+}
+
+static PyObject *ImageUtils_CreateImgForEachVecFeat(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("vec_file"), RSGIS_PY_C_TEXT("vec_lyr"),
+                             RSGIS_PY_C_TEXT("file_name_col"), RSGIS_PY_C_TEXT("out_img_base"),
+                             RSGIS_PY_C_TEXT("out_img_ext"), RSGIS_PY_C_TEXT("out_img_pxl_val"),
+                             RSGIS_PY_C_TEXT("out_img_n_bands"), RSGIS_PY_C_TEXT("out_img_res"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("datatype"),
+                             RSGIS_PY_C_TEXT("snap_to_grid"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszVecFile, *pszVecLyr, *pszFileNameCol, *pszImageBase, *pszExt, *pszGDALFormat;
+    float pxlVal = 0.0;
+    unsigned int numBands = 1;
+    double imgRes = 0.0;
+    int nOutDataType;
+    int snapToGrid = false;
+    unsigned int numThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssssfIdsi|pI:create_img_for_each_vec_feat_native", kwlist, &pszVecFile, &pszVecLyr, &pszFileNameCol, &pszImageBase, &pszExt, &pxlVal, &numBands, &imgRes, &pszGDALFormat, &nOutDataType, &snapToGrid, &numThreads))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::string> outFileNames;
+    try
+    {
+        outFileNames = rsgis::cmds::executeCreateImgForEachVecFeat(std::string(pszVecFile), std::string(pszVecLyr), std::string(pszFileNameCol),
+                                                                   std::string(pszImageBase), std::string(pszExt), pxlVal, numBands, imgRes,
+                                                                   std::string(pszGDALFormat), (rsgis::RSGISLibDataType)nOutDataType, snapToGrid, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return ImageUtils_CreateFileList(outFileNames);
+}
+
+static PyObject *ImageUtils_CreateVecFeatMaskImgs(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("vec_file"), RSGIS_PY_C_TEXT("vec_lyr"),
+                             RSGIS_PY_C_TEXT("ref_img"), RSGIS_PY_C_TEXT("out_img_base"),
+                             RSGIS_PY_C_TEXT("out_img_ext"), RSGIS_PY_C_TEXT("gdalformat"),
+                             RSGIS_PY_C_TEXT("file_name_col"), RSGIS_PY_C_TEXT("burn_val"),
+                             RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszVecFile, *pszVecLyr, *pszRefImage, *pszImageBase, *pszExt, *pszGDALFormat;
+    PyObject *pFileNameCol = Py_None;
+    float burnVal = 1.0;
+    int nOutDataType = rsgis::rsgis_8uint;
+    unsigned int numThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssssss|OfiI:create_vec_feat_mask_imgs", kwlist, &pszVecFile, &pszVecLyr, &pszRefImage, &pszImageBase, &pszExt, &pszGDALFormat, &pFileNameCol, &burnVal, &nOutDataType, &numThreads))
+    {
+        return nullptr;
+    }
+
+    std::string fileNameCol = "";
+    if(pFileNameCol != Py_None)
+    {
+        if(!RSGISPY_CHECK_STRING(pFileNameCol))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "file_name_col must be a string or None");
+            return nullptr;
+        }
+        fileNameCol = std::string(RSGISPY_STRING_EXTRACT(pFileNameCol));
+    }
+
+    std::vector<std::string> outFileNames;
+    try
+    {
+        outFileNames = rsgis::cmds::executeCreateVecFeatMaskImgs(std::string(pszVecFile), std::string(pszVecLyr), std::string(pszRefImage),
+                                                                 std::string(pszImageBase), std::string(pszExt), fileNameCol, burnVal,
+                                                                 std::string(pszGDALFormat), (rsgis::RSGISLibDataType)nOutDataType, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return ImageUtils_CreateFileList(outFileNames);
+}
+
+static PyObject *ImageUtils_CreateClumpMaskImgs(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("clumps_img"), RSGIS_PY_C_TEXT("out_img_base"),
+                             RSGIS_PY_C_TEXT("out_img_ext"), RSGIS_PY_C_TEXT("gdalformat"),
+                             RSGIS_PY_C_TEXT("binary_out"), RSGIS_PY_C_TEXT("clumps_band"),
+                             RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszClumpsImage, *pszImageBase, *pszExt, *pszGDALFormat;
+    int binaryOut = true;
+    unsigned int clumpsBand = 1;
+    int nOutDataType = rsgis::rsgis_32uint;
+    unsigned int numThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssss|pIiI:create_clump_mask_imgs", kwlist, &pszClumpsImage, &pszImageBase, &pszExt, &pszGDALFormat, &binaryOut, &clumpsBand, &nOutDataType, &numThreads))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::string> outFileNames;
+    try
+    {
+        outFileNames = rsgis::cmds::executeCreateClumpMaskImgs(std::string(pszClumpsImage), clumpsBand, std::string(pszImageBase), std::string(pszExt),
+                                                               binaryOut, std::string(pszGDALFormat), (rsgis::RSGISLibDataType)nOutDataType, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return ImageUtils_CreateFileList(outFileNames);
+}
+
+static PyObject *ImageUtils_PlanImgTiles(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("width"),
+                             RSGIS_PY_C_TEXT("height"), RSGIS_PY_C_TEXT("valid_thres"),
+                             RSGIS_PY_C_TEXT("offset"), RSGIS_PY_C_TEXT("no_data_val"),
+                             RSGIS_PY_C_TEXT("mask_img"), RSGIS_PY_C_TEXT("shrink_to_valid"),
+                             RSGIS_PY_C_TEXT("out_tiles_img"), RSGIS_PY_C_TEXT("gdalformat"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszInputImage;
+    unsigned int tileWidth, tileHeight;
+    float validThres = 0.0;
+    int offset = false;
+    PyObject *pNoDataVal = Py_None;
+    const char *pszMaskImage = nullptr;
+    int shrinkToValid = false;
+    const char *pszTilesImage = nullptr;
+    const char *pszGDALFormat = "KEA";
+    unsigned int numThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sII|fpOzpzsI:plan_img_tiles", kwlist, &pszInputImage, &tileWidth, &tileHeight, &validThres, &offset, &pNoDataVal, &pszMaskImage, &shrinkToValid, &pszTilesImage, &pszGDALFormat, &numThreads))
+    {
+        return nullptr;
+    }
+
+    bool useNoData = false;
+    double noDataVal = 0.0;
+    if(pNoDataVal != Py_None)
+    {
+        if(!RSGISPY_CHECK_FLOAT(pNoDataVal) && !RSGISPY_CHECK_INT(pNoDataVal))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "no_data_val must be a number or None.");
+            return nullptr;
+        }
+        noDataVal = RSGISPY_FLOAT_EXTRACT(pNoDataVal);
+        useNoData = true;
+    }
+    std::string maskImage = "";
+    if(pszMaskImage != nullptr)
+    {
+        maskImage = std::string(pszMaskImage);
+    }
+    std::string tilesImage = "";
+    if(pszTilesImage != nullptr)
+    {
+        tilesImage = std::string(pszTilesImage);
+    }
+
+    PyObject *outList = nullptr;
+    try
+    {
+        std::vector<rsgis::cmds::RSGISCmdImageTileInfo> tiles = rsgis::cmds::executePlanImageTiles(std::string(pszInputImage), tileWidth, tileHeight, offset, useNoData, noDataVal, validThres,
+                                                                                                   maskImage, shrinkToValid, tilesImage, std::string(pszGDALFormat), numThreads);
+
+        outList = PyList_New(tiles.size());
+        if(outList == nullptr)
+        {
+            throw rsgis::cmds::RSGISCmdException("Could not create a python list...");
+        }
+        for(size_t i = 0; i < tiles.size(); ++i)
+        {
+            const rsgis::cmds::RSGISCmdImageTileInfo &tile = tiles.at(i);
+            PyObject *item = Py_BuildValue("{s:s,s:[l,l,l,l],s:k}", "tile", tile.name.c_str(), "bbox", tile.xMin, tile.xMax, tile.yMin, tile.yMax,
+                                           "n_valid", tile.numValidPxls);
+            if(item == nullptr)
+            {
+                Py_DECREF(outList);
+                throw rsgis::cmds::RSGISCmdException("Failed to create a list item...");
+            }
+            PyList_SET_ITEM(outList, i, item);
+        }
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return outList;
+}
+
+static PyObject *ImageUtils_CreateImgTiles(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("tiles"),
+                             RSGIS_PY_C_TEXT("out_img_base"), RSGIS_PY_C_TEXT("out_img_ext"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("datatype"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszInputImage, *pszImageBase, *pszExt, *pszGDALFormat;
+    PyObject *pTiles;
+    int nOutDataType;
+    unsigned int numThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sOsssi|I:create_img_tiles", kwlist, &pszInputImage, &pTiles, &pszImageBase, &pszExt, &pszGDALFormat, &nOutDataType, &numThreads))
+    {
+        return nullptr;
+    }
+
+    if(!PySequence_Check(pTiles))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "tiles must be a list of dicts with 'tile' and 'bbox' keys.");
+        return nullptr;
+    }
+
+    std::vector<rsgis::cmds::RSGISCmdImageTileInfo> tiles;
+    Py_ssize_t nTiles = PySequence_Size(pTiles);
+    for(Py_ssize_t i = 0; i < nTiles; ++i)
+    {
+        PyObject *pTile = PySequence_GetItem(pTiles, i);
+        PyObject *pName = nullptr;
+        PyObject *pBBOX = nullptr;
+        if(PyDict_Check(pTile))
+        {
+            pName = PyDict_GetItemString(pTile, "tile");
+            pBBOX = PyDict_GetItemString(pTile, "bbox");
+        }
+        if((pName == nullptr) || (pBBOX == nullptr) || !RSGISPY_CHECK_STRING(pName) || !PySequence_Check(pBBOX) || (PySequence_Size(pBBOX) != 4))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "Each tile must be a dict with a 'tile' name and a 'bbox' of 4 pixel values (x_min, x_max, y_min, y_max).");
+            Py_DECREF(pTile);
+            return nullptr;
+        }
+        rsgis::cmds::RSGISCmdImageTileInfo tile;
+        tile.name = RSGISPY_STRING_EXTRACT(pName);
+        long bbox[4];
+        for(int n = 0; n < 4; ++n)
+        {
+            PyObject *valObj = PySequence_GetItem(pBBOX, n);
+            if(!RSGISPY_CHECK_INT(valObj))
+            {
+                PyErr_SetString(GETSTATE(self)->error, "The tile bbox values must be integer pixel values.");
+                Py_DECREF(valObj);
+                Py_DECREF(pTile);
+                return nullptr;
+            }
+            bbox[n] = RSGISPY_INT_EXTRACT(valObj);
+            Py_DECREF(valObj);
+        }
+        Py_DECREF(pTile);
+        tile.xMin = bbox[0];
+        tile.xMax = bbox[1];
+        tile.yMin = bbox[2];
+        tile.yMax = bbox[3];
+        tile.numValidPxls = 0;
+        tiles.push_back(tile);
+    }
+
+    std::vector<std::string> outFileNames;
+    try
+    {
+        outFileNames = rsgis::cmds::executeCreateImageTiles(std::string(pszInputImage), tiles, std::string(pszImageBase), std::string(pszExt),
+                                                            std::string(pszGDALFormat), (rsgis::RSGISLibDataType)nOutDataType, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return ImageUtils_CreateFileList(outFileNames);
+}
+
+static PyObject *ImageUtils_CalcPixelLocations(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("out_epsg"), nullptr};
+    const char *pszInputImage, *pszOutputImage;
+    const char *pszGDALFormat = "KEA";
+    PyObject *pOutEPSG = Py_None;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ss|sO:calc_pixel_locations", kwlist, &pszInputImage, &pszOutputImage, &pszGDALFormat, &pOutEPSG))
+    {
+        return nullptr;
+    }
+
+    int outEPSG = 0;
+    if(pOutEPSG != Py_None)
+    {
+        if(!RSGISPY_CHECK_INT(pOutEPSG))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "out_epsg must be an integer EPSG code or None.");
+            return nullptr;
+        }
+        outEPSG = RSGISPY_INT_EXTRACT(pOutEPSG);
+    }
+
+    try
+    {
+        rsgis::cmds::executeCalcPixelLocations(std::string(pszInputImage), std::string(pszOutputImage), std::string(pszGDALFormat), outEPSG);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *ImageUtils_CalcWGS84PixelArea(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("scale"), RSGIS_PY_C_TEXT("gdalformat"), nullptr};
+    const char *pszInputImage, *pszOutputImage;
+    double scale = 10000;
+    const char *pszGDALFormat = "KEA";
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ss|ds:calc_wgs84_pixel_area", kwlist, &pszInputImage, &pszOutputImage, &scale, &pszGDALFormat))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        rsgis::cmds::executeCalcPixelAreas(std::string(pszInputImage), std::string(pszOutputImage), std::string(pszGDALFormat), scale);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *ImageUtils_CalcWGS84PixelSize(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("gdalformat"), nullptr};
+    const char *pszInputImage, *pszOutputImage;
+    const char *pszGDALFormat = "KEA";
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ss|s:calc_wsg84_pixel_size", kwlist, &pszInputImage, &pszOutputImage, &pszGDALFormat))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        rsgis::cmds::executeCalcPixelSizes(std::string(pszInputImage), std::string(pszOutputImage), std::string(pszGDALFormat));
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *ImageUtils_ResampleImgsToMatch(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("in_ref_img"), RSGIS_PY_C_TEXT("in_process_imgs"),
+                             RSGIS_PY_C_TEXT("output_imgs"), RSGIS_PY_C_TEXT("gdalformat"),
+                             RSGIS_PY_C_TEXT("interp_method"), RSGIS_PY_C_TEXT("datatype"),
+                             RSGIS_PY_C_TEXT("no_data_val"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszRefImage, *pszGDALFormat;
+    PyObject *pInputImages, *pOutputImages;
+    int interpMethod = 0;
+    PyObject *pDataType = Py_None;
+    PyObject *pNoDataVal = Py_None;
+    unsigned int numThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sOOs|iOOI:resample_imgs_to_match", kwlist, &pszRefImage, &pInputImages, &pOutputImages,
+                                     &pszGDALFormat, &interpMethod, &pDataType, &pNoDataVal, &numThreads))
+    {
+        return nullptr;
+    }
+
+    if(!PySequence_Check(pInputImages) || !PySequence_Check(pOutputImages))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "in_process_imgs and output_imgs must be lists of image file paths.");
+        return nullptr;
+    }
+    std::vector<std::string> inputImages = ExtractStringVectorFromSequence(pInputImages);
+    std::vector<std::string> outputImages = ExtractStringVectorFromSequence(pOutputImages);
+    if(inputImages.size() != outputImages.size())
+    {
+        PyErr_SetString(GETSTATE(self)->error, "The number of input and output images must be the same.");
+        return nullptr;
+    }
+
+    bool useOutDataType = false;
+    int nOutDataType = 0;
+    if(pDataType != Py_None)
+    {
+        if(!RSGISPY_CHECK_INT(pDataType))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "datatype must be a rsgislib.TYPE_* value or None.");
+            return nullptr;
+        }
+        nOutDataType = RSGISPY_INT_EXTRACT(pDataType);
+        useOutDataType = true;
+    }
+
+    // If a no data value is not provided the no data value of each input image is used.
+    bool useImgNoData = true;
+    bool useNoData = false;
+    double noDataVal = 0.0;
+    if(pNoDataVal != Py_None)
+    {
+        if(!(RSGISPY_CHECK_FLOAT(pNoDataVal) | RSGISPY_CHECK_INT(pNoDataVal)))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "no_data_val must be a number or None.");
+            return nullptr;
+        }
+        noDataVal = RSGISPY_FLOAT_EXTRACT(pNoDataVal);
+        useImgNoData = false;
+        useNoData = true;
+    }
+
+    try
+    {
+        rsgis::cmds::executeResampleImgsToMatch(std::string(pszRefImage), inputImages, outputImages, std::string(pszGDALFormat), interpMethod,
+                                                useOutDataType, (rsgis::RSGISLibDataType)nOutDataType, useImgNoData, useNoData, noDataVal, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *ImageUtils_StackImageBands(PyObject *self, PyObject *args, PyObject *keywds)
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_imgs"), RSGIS_PY_C_TEXT("band_names"),
@@ -1081,90 +1626,298 @@ static PyObject *ImageUtils_CreateCopyImageDefExtent(PyObject *self, PyObject *a
         PyErr_SetString(GETSTATE(self)->error, e.what());
         return nullptr;
     }
-    
+    
+    Py_RETURN_NONE;
+}
+
+static PyObject *ImageUtils_CreateCopyImageVecExtent(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    const char *pszInputImage, *pszOutputImage, *pszInputVectorFile, *pszInputVectorLyr, *pszGDALFormat;
+    int nOutDataType;
+    unsigned int numBands;
+    float pxlVal = 0;
+
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("vec_file"),
+                             RSGIS_PY_C_TEXT("vec_lyr"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("n_bands"), RSGIS_PY_C_TEXT("pxl_val"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("datatype"), nullptr};
+    
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssssIfsi:create_copy_img_vec_extent", kwlist, &pszInputImage, &pszInputVectorFile, &pszInputVectorLyr,
+                                     &pszOutputImage, &numBands, &pxlVal, &pszGDALFormat, &nOutDataType))
+    {
+        return nullptr;
+    }
+    
+    try
+    {
+        rsgis::cmds::executeCreateCopyBlankImageVecExtent(std::string(pszInputImage), std::string(pszInputVectorFile),
+                                                          std::string(pszInputVectorLyr), std::string(pszOutputImage),
+                                                          numBands, pxlVal, std::string(pszGDALFormat),
+                                                          (rsgis::RSGISLibDataType)nOutDataType);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+    
+    Py_RETURN_NONE;
+}
+
+static PyObject *ImageUtils_OrderImagesUsingPropValidData(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_imgs"), RSGIS_PY_C_TEXT("no_data_val"),
+                             RSGIS_PY_C_TEXT("idx_file"), nullptr};
+    float noDataValue;
+    PyObject *pInputImages; // List of input images
+    const char *pszFootprintIdxFile = nullptr;
+    
+    // Check parameters are present and of correct type
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Of|z:order_img_using_prop_valid_pxls", kwlist, &pInputImages, &noDataValue, &pszFootprintIdxFile))
+    {
+        return nullptr;
+    }
+    
+    // TODO: Look into this function - doesn't seem to catch when only a single image is provided.
+    if(!PySequence_Check(pInputImages)) {
+        PyErr_SetString(GETSTATE(self)->error, "First argument must be a sequence");
+        return nullptr;
+    }
+    
+    // Extract list of images to array of strings.
+    std::vector<std::string> inputImages = ExtractStringVectorFromSequence(pInputImages);
+    int numImages = inputImages.size();
+    if(numImages == 0)
+    {
+        PyErr_SetString(GETSTATE(self)->error, "No input images provided");
+        return nullptr;
+    }
+
+    PyObject *outImagesList = nullptr;
+    try
+    {
+        std::string footprintIdxFile = "";
+        if(pszFootprintIdxFile != nullptr)
+        {
+            footprintIdxFile = std::string(pszFootprintIdxFile);
+        }
+        std::vector<std::string> orderedInputImages = rsgis::cmds::executeOrderImageUsingValidDataProp(inputImages, noDataValue, footprintIdxFile);
+        
+        outImagesList = PyTuple_New(orderedInputImages.size());
+        
+        if(outImagesList == nullptr)
+        {
+            throw rsgis::cmds::RSGISCmdException("Could not create a python list...");
+        }
+        
+        for(unsigned int i = 0; i < orderedInputImages.size(); ++i)
+        {
+            //std::cout << i << " = " << orderedInputImages.at(i) << std::endl;
+            if(PyTuple_SetItem(outImagesList, i, Py_BuildValue("s", orderedInputImages.at(i).c_str())) == -1)
+            {
+                throw rsgis::cmds::RSGISCmdException("Failed to add a value to the list...");
+            }
+        }
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+    
+    return outImagesList;
+}
+
+
+static PyObject *ImageUtils_CreateImgFootprintIdx(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_imgs"), RSGIS_PY_C_TEXT("idx_file"),
+                             RSGIS_PY_C_TEXT("idx_epsg"), RSGIS_PY_C_TEXT("calc_valid_frac"),
+                             RSGIS_PY_C_TEXT("no_data_val"), nullptr};
+    PyObject *pInputImages;
+    const char *pszFootprintIdxFile = "";
+    int idxEPSG = 0;
+    int calcValidFrac = false;
+    PyObject *pNoDataVal = Py_None;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Os|ipO:create_img_footprint_idx", kwlist, &pInputImages, &pszFootprintIdxFile, &idxEPSG, &calcValidFrac, &pNoDataVal))
+    {
+        return nullptr;
+    }
+
+    if(!PySequence_Check(pInputImages))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "input_imgs must be a list of images");
+        return nullptr;
+    }
+    std::vector<std::string> inputImages = ExtractStringVectorFromSequence(pInputImages);
+
+    bool useNoDataVal = false;
+    float noDataVal = 0.0;
+    if(pNoDataVal != Py_None)
+    {
+        if(!RSGISPY_CHECK_FLOAT(pNoDataVal) && !RSGISPY_CHECK_INT(pNoDataVal))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "no_data_val must be a number or None.");
+            return nullptr;
+        }
+        useNoDataVal = true;
+        noDataVal = RSGISPY_FLOAT_EXTRACT(pNoDataVal);
+    }
+
+    try
+    {
+        rsgis::cmds::executeCreateImageFootprintIndex(inputImages, std::string(pszFootprintIdxFile), idxEPSG, calcValidFrac, useNoDataVal, noDataVal);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
     Py_RETURN_NONE;
 }
 
-static PyObject *ImageUtils_CreateCopyImageVecExtent(PyObject *self, PyObject *args, PyObject *keywds)
+static PyObject *ImageUtils_UpdateImgFootprintIdx(PyObject *self, PyObject *args, PyObject *keywds)
 {
-    const char *pszInputImage, *pszOutputImage, *pszInputVectorFile, *pszInputVectorLyr, *pszGDALFormat;
-    int nOutDataType;
-    unsigned int numBands;
-    float pxlVal = 0;
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("idx_file"), RSGIS_PY_C_TEXT("input_imgs"),
+                             RSGIS_PY_C_TEXT("remove_missing"), RSGIS_PY_C_TEXT("calc_valid_frac"),
+                             RSGIS_PY_C_TEXT("no_data_val"), nullptr};
+    const char *pszFootprintIdxFile = "";
+    PyObject *pInputImages = Py_None;
+    int removeMissing = false;
+    int calcValidFrac = false;
+    PyObject *pNoDataVal = Py_None;
 
-    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("vec_file"),
-                             RSGIS_PY_C_TEXT("vec_lyr"), RSGIS_PY_C_TEXT("output_img"),
-                             RSGIS_PY_C_TEXT("n_bands"), RSGIS_PY_C_TEXT("pxl_val"),
-                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("datatype"), nullptr};
-    
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssssIfsi:create_copy_img_vec_extent", kwlist, &pszInputImage, &pszInputVectorFile, &pszInputVectorLyr,
-                                     &pszOutputImage, &numBands, &pxlVal, &pszGDALFormat, &nOutDataType))
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "s|OppO:update_img_footprint_idx", kwlist, &pszFootprintIdxFile, &pInputImages, &removeMissing, &calcValidFrac, &pNoDataVal))
     {
         return nullptr;
     }
-    
+
+    std::vector<std::string> inputImages;
+    if(pInputImages != Py_None)
+    {
+        if(!PySequence_Check(pInputImages))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "input_imgs must be a list of images");
+            return nullptr;
+        }
+        inputImages = ExtractStringVectorFromSequence(pInputImages);
+    }
+
+    bool useNoDataVal = false;
+    float noDataVal = 0.0;
+    if(pNoDataVal != Py_None)
+    {
+        if(!RSGISPY_CHECK_FLOAT(pNoDataVal) && !RSGISPY_CHECK_INT(pNoDataVal))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "no_data_val must be a number or None.");
+            return nullptr;
+        }
+        useNoDataVal = true;
+        noDataVal = RSGISPY_FLOAT_EXTRACT(pNoDataVal);
+    }
+
+    size_t numRead = 0;
     try
     {
-        rsgis::cmds::executeCreateCopyBlankImageVecExtent(std::string(pszInputImage), std::string(pszInputVectorFile),
-                                                          std::string(pszInputVectorLyr), std::string(pszOutputImage),
-                                                          numBands, pxlVal, std::string(pszGDALFormat),
-                                                          (rsgis::RSGISLibDataType)nOutDataType);
+        numRead = rsgis::cmds::executeUpdateImageFootprintIndex(std::string(pszFootprintIdxFile), inputImages, removeMissing, calcValidFrac, useNoDataVal, noDataVal);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
         PyErr_SetString(GETSTATE(self)->error, e.what());
         return nullptr;
     }
-    
-    Py_RETURN_NONE;
+
+    return PyLong_FromSize_t(numRead);
 }
 
-static PyObject *ImageUtils_OrderImagesUsingPropValidData(PyObject *self, PyObject *args, PyObject *keywds)
+static PyObject *ImageUtils_QueryImgFootprintIdx(PyObject *self, PyObject *args, PyObject *keywds)
 {
-    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_imgs"), RSGIS_PY_C_TEXT("no_data_val"), nullptr};
-    float noDataValue;
-    PyObject *pInputImages; // List of input images
-    
-    // Check parameters are present and of correct type
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Of:order_img_using_prop_valid_pxls", kwlist, &pInputImages, &noDataValue))
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("idx_file"), RSGIS_PY_C_TEXT("bbox"),
+                             RSGIS_PY_C_TEXT("get_info"), nullptr};
+    const char *pszFootprintIdxFile = "";
+    PyObject *pBBOX = Py_None;
+    int getInfo = false;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "s|Op:query_img_footprint_idx", kwlist, &pszFootprintIdxFile, &pBBOX, &getInfo))
     {
         return nullptr;
     }
-    
-    // TODO: Look into this function - doesn't seem to catch when only a single image is provided.
-    if(!PySequence_Check(pInputImages)) {
-        PyErr_SetString(GETSTATE(self)->error, "First argument must be a sequence");
-        return nullptr;
-    }
-    
-    // Extract list of images to array of strings.
-    std::vector<std::string> inputImages = ExtractStringVectorFromSequence(pInputImages);
-    int numImages = inputImages.size();
-    if(numImages == 0)
+
+    bool useBBOX = false;
+    double bbox[4] = {0, 0, 0, 0};
+    if(pBBOX != Py_None)
     {
-        PyErr_SetString(GETSTATE(self)->error, "No input images provided");
-        return nullptr;
+        if(!PySequence_Check(pBBOX) || (PySequence_Size(pBBOX) != 4))
+        {
+            PyErr_SetString(GETSTATE(self)->error, "bbox must be a sequence of 4 values (MinX, MaxX, MinY, MaxY).");
+            return nullptr;
+        }
+        for(int i = 0; i < 4; ++i)
+        {
+            PyObject *valObj = PySequence_GetItem(pBBOX, i);
+            if(!RSGISPY_CHECK_FLOAT(valObj) && !RSGISPY_CHECK_INT(valObj))
+            {
+                PyErr_SetString(GETSTATE(self)->error, "bbox values must be numbers.");
+                Py_DECREF(valObj);
+                return nullptr;
+            }
+            bbox[i] = RSGISPY_FLOAT_EXTRACT(valObj);
+            Py_DECREF(valObj);
+        }
+        useBBOX = true;
     }
 
-    PyObject *outImagesList = nullptr;
+    PyObject *outList = nullptr;
     try
     {
-        std::vector<std::string> orderedInputImages = rsgis::cmds::executeOrderImageUsingValidDataProp(inputImages, noDataValue);
-        
-        outImagesList = PyTuple_New(orderedInputImages.size());
-        
-        if(outImagesList == nullptr)
+        std::vector<rsgis::cmds::RSGISCmdImageFootprintInfo> footprints = rsgis::cmds::executeQueryImageFootprintIndex(std::string(pszFootprintIdxFile), useBBOX, bbox[0], bbox[1], bbox[2], bbox[3]);
+
+        outList = PyList_New(footprints.size());
+        if(outList == nullptr)
         {
             throw rsgis::cmds::RSGISCmdException("Could not create a python list...");
         }
-        
-        for(unsigned int i = 0; i < orderedInputImages.size(); ++i)
+        for(size_t i = 0; i < footprints.size(); ++i)
         {
-            //std::cout << i << " = " << orderedInputImages.at(i) << std::endl;
-            if(PyTuple_SetItem(outImagesList, i, Py_BuildValue("s", orderedInputImages.at(i).c_str())) == -1)
+            const rsgis::cmds::RSGISCmdImageFootprintInfo &info = footprints.at(i);
+            PyObject *item = nullptr;
+            if(getInfo)
             {
-                throw rsgis::cmds::RSGISCmdException("Failed to add a value to the list...");
+                PyObject *pNoData = Py_None;
+                if(info.hasNoData)
+                {
+                    pNoData = PyFloat_FromDouble(info.noDataVal);
+                }
+                else
+                {
+                    Py_INCREF(Py_None);
+                }
+                PyObject *pValidFrac = Py_None;
+                if(info.validPxlFrac >= 0)
+                {
+                    pValidFrac = PyFloat_FromDouble(info.validPxlFrac);
+                }
+                else
+                {
+                    Py_INCREF(Py_None);
+                }
+                item = Py_BuildValue("{s:s,s:[d,d,d,d],s:I,s:I,s:I,s:N,s:N,s:s}", "file", info.imageFile.c_str(),
+                                     "bbox", info.minX, info.maxX, info.minY, info.maxY, "n_bands", info.numBands,
+                                     "x_size", info.xSize, "y_size", info.ySize, "no_data_val", pNoData,
+                                     "valid_frac", pValidFrac, "wkt", info.crsWKT.c_str());
+            }
+            else
+            {
+                item = Py_BuildValue("s", info.imageFile.c_str());
+            }
+            if(item == nullptr)
+            {
+                Py_DECREF(outList);
+                throw rsgis::cmds::RSGISCmdException("Failed to create a list item...");
             }
+            PyList_SET_ITEM(outList, i, item);
         }
     }
     catch(rsgis::cmds::RSGISCmdException &e)
@@ -1172,8 +1925,8 @@ static PyObject *ImageUtils_OrderImagesUsingPropValidData(PyObject *self, PyObje
         PyErr_SetString(GETSTATE(self)->error, e.what());
         return nullptr;
     }
-    
-    return outImagesList;
+
+    return outList;
 }
 
 
@@ -1292,6 +2045,54 @@ static PyObject *ImageUtils_GenValidMask(PyObject *self, PyObject *args, PyObjec
     Py_RETURN_NONE;
 }
 
+static PyObject *ImageUtils_GenMultiImgValidMasks(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_imgs"), RSGIS_PY_C_TEXT("output_img"),
+                             RSGIS_PY_C_TEXT("gdalformat"), RSGIS_PY_C_TEXT("out_packed_img"),
+                             RSGIS_PY_C_TEXT("no_data_val"), RSGIS_PY_C_TEXT("use_img_no_data"),
+                             RSGIS_PY_C_TEXT("check_finite"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    PyObject *pInputImages;
+    const char *pszOutputImage = "";
+    const char *pszGDALFormat = "";
+    const char *pszOutPackedImage = "";
+    double noDataVal = 0.0;
+    int useImgNoData = true;
+    int checkFinite = true;
+    unsigned int numThreads = 0;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Oss|sdiiI:gen_multi_img_valid_masks", kwlist, &pInputImages, &pszOutputImage,
+                                     &pszGDALFormat, &pszOutPackedImage, &noDataVal, &useImgNoData, &checkFinite, &numThreads))
+    {
+        return nullptr;
+    }
+
+    if(!PySequence_Check(pInputImages))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "First argument must be a sequence");
+        return nullptr;
+    }
+
+    std::vector<std::string> inputImages = ExtractStringVectorFromSequence(pInputImages);
+    if(inputImages.empty())
+    {
+        PyErr_SetString(GETSTATE(self)->error, "No input images provided");
+        return nullptr;
+    }
+
+    try
+    {
+        rsgis::cmds::executeMultiImgValidMasks(inputImages, std::string(pszOutputImage), std::string(pszOutPackedImage),
+                                               std::string(pszGDALFormat), noDataVal, useImgNoData, checkFinite, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *ImageUtils_GenImageEdgeMask(PyObject *self, PyObject *args, PyObject *keywds)
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("output_img"),
@@ -1921,6 +2722,106 @@ static PyObject *ImageUtils_UnPackPixelVals(PyObject *self, PyObject *args, PyOb
     Py_RETURN_NONE;
 }
 
+static PyObject *ImageUtils_DecodeBitFields(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("img_band"),
+                             RSGIS_PY_C_TEXT("output_img"), RSGIS_PY_C_TEXT("gdalformat"),
+                             RSGIS_PY_C_TEXT("bit_fields"), RSGIS_PY_C_TEXT("pack_masks"), nullptr};
+    const char *pszInputImage, *pszOutputImage, *pszGDALFormat;
+    unsigned int imgBand;
+    PyObject *bitFieldsPyObj;
+    int packMasks = false;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sIssO|i:decode_bit_fields", kwlist, &pszInputImage, &imgBand,
+                                     &pszOutputImage, &pszGDALFormat, &bitFieldsPyObj, &packMasks))
+    {
+        return nullptr;
+    }
+
+    if( !PySequence_Check(bitFieldsPyObj))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "bit_fields must be a sequence");
+        return nullptr;
+    }
+
+    Py_ssize_t nBitFields = PySequence_Size(bitFieldsPyObj);
+    std::vector<rsgis::cmds::RSGISCmdBitField> bitFields;
+    bitFields.reserve(nBitFields);
+
+    for( Py_ssize_t n = 0; n < nBitFields; n++ )
+    {
+        PyObject *o = PySequence_GetItem(bitFieldsPyObj, n);
+
+        PyObject *pName = PyObject_GetAttrString(o, "name");
+        if( ( pName == nullptr ) || ( pName == Py_None ) || !RSGISPY_CHECK_STRING(pName) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, "could not find string attribute \'name\'" );
+            Py_XDECREF(pName);
+            Py_DECREF(o);
+            return nullptr;
+        }
+
+        PyObject *pBitOffset = PyObject_GetAttrString(o, "bit_offset");
+        if( ( pBitOffset == nullptr ) || ( pBitOffset == Py_None ) || !RSGISPY_CHECK_INT(pBitOffset) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, "could not find int attribute \'bit_offset\'" );
+            Py_XDECREF(pBitOffset);
+            Py_DECREF(pName);
+            Py_DECREF(o);
+            return nullptr;
+        }
+
+        PyObject *pBitLength = PyObject_GetAttrString(o, "bit_length");
+        if( ( pBitLength == nullptr ) || ( pBitLength == Py_None ) || !RSGISPY_CHECK_INT(pBitLength) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, "could not find int attribute \'bit_length\'" );
+            Py_XDECREF(pBitLength);
+            Py_DECREF(pBitOffset);
+            Py_DECREF(pName);
+            Py_DECREF(o);
+            return nullptr;
+        }
+
+        PyObject *pOutBand = PyObject_GetAttrString(o, "out_band");
+        if( ( pOutBand == nullptr ) || ( pOutBand == Py_None ) || !RSGISPY_CHECK_INT(pOutBand) )
+        {
+            PyErr_SetString(GETSTATE(self)->error, "could not find int attribute \'out_band\'" );
+            Py_XDECREF(pOutBand);
+            Py_DECREF(pBitLength);
+            Py_DECREF(pBitOffset);
+            Py_DECREF(pName);
+            Py_DECREF(o);
+            return nullptr;
+        }
+
+        rsgis::cmds::RSGISCmdBitField bitField = rsgis::cmds::RSGISCmdBitField();
+        bitField.name = RSGISPY_STRING_EXTRACT(pName);
+        bitField.bitOffset = RSGISPY_UINT_EXTRACT(pBitOffset);
+        bitField.bitLength = RSGISPY_UINT_EXTRACT(pBitLength);
+        bitField.outBand = RSGISPY_UINT_EXTRACT(pOutBand);
+        bitFields.push_back(bitField);
+
+        Py_DECREF(pOutBand);
+        Py_DECREF(pBitLength);
+        Py_DECREF(pBitOffset);
+        Py_DECREF(pName);
+        Py_DECREF(o);
+    }
+
+    try
+    {
+        rsgis::cmds::executeDecodeBitFields(std::string(pszInputImage), imgBand, std::string(pszOutputImage),
+                                            std::string(pszGDALFormat), bitFields, packMasks);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    Py_RETURN_NONE;
+}
+
 
 // Our list of functions in this module
 static PyMethodDef ImageUtilsMethods[] = {
@@ -2058,6 +2959,28 @@ static PyMethodDef ImageUtilsMethods[] = {
 "   imageutils.pop_img_stats(outImg, True, 0.0, True)\n"
 "\n"},
 
+{"relabel_pxl_vals", (PyCFunction)ImageUtils_RelabelPxlValsLUT, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.relabel_pxl_vals(input_img, output_img, gdalformat, datatype, lut, n_threads)\n"
+"Relabels the pixel values of all the bands of an image using a look up table. Pixel values\n"
+"not within the LUT are copied to the output unchanged. The LUT is compiled to a dense array\n"
+"(integer input values within a bounded range) or a hash table so large LUTs can be used.\n"
+"\n"
+":param input_img: is a string containing the name and path of the input image file.\n"
+":param output_img: is a string containing the name and path for the output image.\n"
+":param gdalformat: is a string representing the output image file format (e.g., KEA, ENVI, GTIFF, HFA etc).\n"
+":param datatype: is a rsgislib.TYPE_* value for the data type of the output image.\n"
+":param lut: is a dict with the input pixel values as keys and the output values as the values.\n"
+":param n_threads: is an optional number of threads used to relabel the pixels (Default=0; all available cores).\n"
+"\n"
+".. code:: python\n"
+"\n"
+"   import rsgislib\n"
+"   from rsgislib import imageutils\n"
+"   \n"
+"   lut = {1: 10, 2: 10, 3: 20}\n"
+"   imageutils.relabel_pxl_vals('classes.kea', 'classes_relbl.kea', 'KEA', rsgislib.TYPE_8UINT, lut)\n"
+"\n"},
+
 {"create_tiles", (PyCFunction)ImageUtils_createTiles, METH_VARARGS | METH_KEYWORDS,
 "rsgislib.imageutils.create_tiles(input_img, out_img_base, tile_width, tile_height, tile_overlap, offset_tiles, gdalformat, datatype, out_img_ext)\n"
 "Create tiles from a larger image, useful for splitting a large image into multiple smaller ones for processing.\n"
@@ -2359,9 +3282,208 @@ static PyMethodDef ImageUtilsMethods[] = {
 "   gdalformat = 'KEA'\n"
 "   gdaltype = rsgislib.TYPE_32FLOAT\n"
 "   imageutils.subset_to_img(inputImage, inputROIimage, outputImage, gdalformat, datatype)\n"
+"\n"},
+
+    {"subset_to_polys", (PyCFunction)ImageUtils_Subset2Polys, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.subset_to_polys(input_img, vec_file, vec_lyr, att_unq_val_col, out_img_base, gdalformat, datatype, out_img_ext, mask_to_poly=False, no_data_val=0, n_threads=0)\n"
+"Subset an image to the bounding box of each polygon within a vector layer, producing\n"
+"an output image per polygon. The input image is read once, block by block, and each block\n"
+"is copied to all the polygon subsets it intersects; the subsets are written in parallel.\n"
+"Polygons which do not intersect the image are ignored. The vector layer is assumed to\n"
+"have the same projection as the image.\n"
+"\n"
+":param input_img: is a string providing the name of the input file.\n"
+":param vec_file: is a string providing the vector file with the polygons.\n"
+":param vec_lyr: is a string specifying the layer within the vector file to be used.\n"
+":param att_unq_val_col: is the column with a unique value for each polygon which is used\n"
+"                        within the output file name.\n"
+":param out_img_base: is the output images base path and file name.\n"
+":param gdalformat: is a string providing the gdalformat of the output images (e.g., KEA).\n"
+":param datatype: is a rsgislib.TYPE_* value providing the data type of the output images.\n"
+":param out_img_ext: is the output image file extension (e.g., kea).\n"
+":param mask_to_poly: if True the pixels outside of the polygon are set to no_data_val.\n"
+":param no_data_val: the no data value used when masking to the polygon.\n"
+":param n_threads: the number of threads used to write the outputs (0 uses all the cores).\n"
+":return: list of the output image files.\n"
+"\n"
+".. code:: python\n"
+"\n"
+"   import rsgislib\n"
+"   from rsgislib import imageutils\n"
+"   input_img = 'sen2_20210527_aber.kea'\n"
+"   vec_file = 'aber_osgb_multi_polys.geojson'\n"
+"   vec_lyr = 'aber_osgb_multi_polys'\n"
+"   out_imgs = imageutils.subset_to_polys(input_img, vec_file, vec_lyr, 'tile_name', './tiles/sen2_', 'KEA', rsgislib.TYPE_16UINT, 'kea', mask_to_poly=True)\n"
+"\n"},
+
+    {"create_img_for_each_vec_feat_native", (PyCFunction)ImageUtils_CreateImgForEachVecFeat, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.create_img_for_each_vec_feat_native(vec_file, vec_lyr, file_name_col, out_img_base, out_img_ext, out_img_pxl_val, out_img_n_bands, out_img_res, gdalformat, datatype, snap_to_grid=False, n_threads=1)\n"
+"Creates an image, filled with out_img_pxl_val, of the extent of each feature within a vector layer\n"
+"reading the layer once and writing the images in parallel.\n"
+"Use rsgislib.imageutils.create_img_for_each_vec_feat rather than calling directly.\n"
+"\n"
+":param vec_file: the input vector file.\n"
+":param vec_lyr: the input vector layer.\n"
+":param file_name_col: the column with the value used within the output file names.\n"
+":param out_img_base: the output images base path and file name.\n"
+":param out_img_ext: the output image file extension (e.g., kea).\n"
+":param out_img_pxl_val: the output image pixel value.\n"
+":param out_img_n_bands: the number of image bands in the output images.\n"
+":param out_img_res: the output image resolution (square pixels).\n"
+":param gdalformat: the output image file format.\n"
+":param datatype: is a rsgislib.TYPE_* value providing the data type of the output images.\n"
+":param snap_to_grid: if True the images are on a grid of the output resolution with an origin at 0,0.\n"
+":param n_threads: the number of threads used to write the outputs (0 uses all the cores).\n"
+":return: list of the output image files.\n"
+"\n"},
+
+    {"create_vec_feat_mask_imgs", (PyCFunction)ImageUtils_CreateVecFeatMaskImgs, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.create_vec_feat_mask_imgs(vec_file, vec_lyr, ref_img, out_img_base, out_img_ext, gdalformat, file_name_col=None, burn_val=1, datatype=rsgislib.TYPE_8UINT, n_threads=1)\n"
+"Creates a mask image for each feature within a vector layer, where the image is the envelope of\n"
+"the feature snapped to the pixel grid of the reference image (and clipped to the reference image).\n"
+"Pixels whose centre is within the feature are burn_val and other pixels 0 (the no data value).\n"
+"The layer is read once, and the features rasterised and written in parallel, so this is much\n"
+"faster than rasterising the features individually when there are many features (e.g., tiles).\n"
+"The vector layer is assumed to have the same projection as the reference image and features\n"
+"which do not intersect the reference image are ignored.\n"
+"\n"
+":param vec_file: the input vector file.\n"
+":param vec_lyr: the input vector layer.\n"
+":param ref_img: the reference image defining the pixel grid and projection of the outputs.\n"
+":param out_img_base: the output images base path and file name.\n"
+":param out_img_ext: the output image file extension (e.g., kea).\n"
+":param gdalformat: the output image file format.\n"
+":param file_name_col: the column with a unique value for each feature which is used within the output\n"
+"                      file names. If None the feature number (starting at 1) is used.\n"
+":param burn_val: the value of the pixels within the feature.\n"
+":param datatype: is a rsgislib.TYPE_* value providing the data type of the output images.\n"
+":param n_threads: the number of threads used to write the outputs (0 uses all the cores).\n"
+":return: list of the output image files.\n"
+"\n"
+".. code:: python\n"
+"\n"
+"   from rsgislib import imageutils\n"
+"   out_imgs = imageutils.create_vec_feat_mask_imgs('tiles.gpkg', 'tiles', 'sen2_20210527_aber.kea', './tiles/tile_mask_', 'kea', 'KEA', n_threads=4)\n"
+"\n"},
+
+    {"create_clump_mask_imgs", (PyCFunction)ImageUtils_CreateClumpMaskImgs, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.create_clump_mask_imgs(clumps_img, out_img_base, out_img_ext, gdalformat, binary_out=True, clumps_band=1, datatype=rsgislib.TYPE_32UINT, n_threads=1)\n"
+"Creates an image, of the extent of the clump, for each clump within a clumps image (named\n"
+"out_img_base + 'C' + clump ID). The clumps image is read in strips twice (to find the extent\n"
+"of each clump and then to fill the outputs) and each output is written, in parallel, once the\n"
+"strip with its last row has been read.\n"
+"\n"
+":param clumps_img: the input clumps image.\n"
+":param out_img_base: the output images base path and file name.\n"
+":param out_img_ext: the output image file extension (e.g., kea).\n"
+":param gdalformat: the output image file format.\n"
+":param binary_out: if True the pixels of the clump are 1, otherwise the clump ID. Other pixels are 0.\n"
+":param clumps_band: the band of the clumps image with the clumps.\n"
+":param datatype: is a rsgislib.TYPE_* value providing the data type of the output images.\n"
+":param n_threads: the number of threads used to write the outputs (0 uses all the cores).\n"
+":return: list of the output image files.\n"
 "\n"},
     
     
+    {"plan_img_tiles", (PyCFunction)ImageUtils_PlanImgTiles, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.plan_img_tiles(input_img, width, height, valid_thres=0.0, offset=False, no_data_val=None, mask_img=None, shrink_to_valid=False, out_tiles_img=None, gdalformat='KEA', n_threads=1)\n"
+"Plans a tiling of an image on a regular grid of width x height pixels. The image is read once\n"
+"to count the valid pixels (finite and not no_data_val in all bands) within each grid cell and a\n"
+"summed-area table of the counts is used to merge tiles with a proportion of valid pixels below\n"
+"valid_thres with a neighbouring tile (where the merged tile is still a rectangle). Tiles without\n"
+"any valid pixels are removed.\n"
+"\n"
+":param input_img: the input image to be tiled.\n"
+":param width: the width of the tiles in pixels.\n"
+":param height: the height of the tiles in pixels.\n"
+":param valid_thres: the minimum proportion (0-1) of valid pixels within a tile.\n"
+":param offset: if True the grid is offset by half a tile (i.e., the first row and column are half tiles).\n"
+":param no_data_val: the no data value of the input image. If None all the pixels are valid.\n"
+":param mask_img: an optional image (same size as the input) where tiles which are only no_data_val\n"
+"                 in the mask are removed.\n"
+":param shrink_to_valid: if True each tile is reduced to the extent of its valid pixels.\n"
+":param out_tiles_img: an optional output image where the pixels of each tile are its index plus 1.\n"
+":param gdalformat: the output tiles image file format.\n"
+":param n_threads: the number of threads used to count the valid pixels (0 uses all the cores).\n"
+":return: list of dicts with the tile name ('tile'), pixel bbox ('bbox'; [x_min, x_max, y_min, y_max]\n"
+"         where the max values are exclusive and y is from the top of the image) and number of valid\n"
+"         pixels ('n_valid').\n"
+"\n"},
+
+    {"create_img_tiles", (PyCFunction)ImageUtils_CreateImgTiles, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.create_img_tiles(input_img, tiles, out_img_base, out_img_ext, gdalformat, datatype, n_threads=1)\n"
+"Writes the tiles of an image (e.g., from plan_img_tiles) to out_img_base + '_' + tile name + '.' + out_img_ext,\n"
+"with each thread reading the input image through its own handle.\n"
+"\n"
+":param input_img: the input image to be tiled.\n"
+":param tiles: list of dicts with the tile name ('tile') and pixel bbox ('bbox'; [x_min, x_max, y_min, y_max]).\n"
+":param out_img_base: the output images base path and file name.\n"
+":param out_img_ext: the output image file extension (e.g., kea).\n"
+":param gdalformat: the output image file format.\n"
+":param datatype: is a rsgislib.TYPE_* value providing the data type of the output images.\n"
+":param n_threads: the number of threads used to write the tiles (0 uses all the cores).\n"
+":return: list of the output image files.\n"
+"\n"},
+
+    {"calc_pixel_locations", (PyCFunction)ImageUtils_CalcPixelLocations, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.calc_pixel_locations(input_img, output_img, gdalformat='KEA', out_epsg=None)\n"
+"Function which produces a 2 band output image with the X and Y locations of the image pixels\n"
+"(pixel centres). If out_epsg is provided the locations are transformed to that projection, a\n"
+"row of pixels at a time.\n"
+"\n"
+":param input_img: the input reference image\n"
+":param output_img: the output image file name and path (will be same dimensions as the input)\n"
+":param gdalformat: the GDAL image file format of the output image file.\n"
+":param out_epsg: optional EPSG code of the projection for the locations (Default: None; the\n"
+"                 projection of the input image).\n"
+"\n"},
+
+    {"calc_wgs84_pixel_area", (PyCFunction)ImageUtils_CalcWGS84PixelArea, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.calc_wgs84_pixel_area(input_img, output_img, scale=10000, gdalformat='KEA')\n"
+"A function which calculates the area (in metres) of the pixel projected in WGS84. The area\n"
+"is the area of the ellipsoid between the latitudes of the top and bottom of the pixel, which\n"
+"is calculated once per row. If the input image has a projected coordinate system the area\n"
+"is calculated from the pixel resolution.\n"
+"\n"
+":param input_img: input image, for which the per-pixel area will be calculated.\n"
+":param output_img: output image file.\n"
+":param scale: scale the output area to unit of interest. Scale=10000(Ha),\n"
+"              Scale=1(sq m), Scale=1000000(sq km), Scale=4046.856(Acre),\n"
+"              Scale=2590000(sq miles), Scale=0.0929022668(sq feet)\n"
+":param gdalformat: the output image file format (default: KEA).\n"
+"\n"},
+
+    {"calc_wsg84_pixel_size", (PyCFunction)ImageUtils_CalcWGS84PixelSize, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.calc_wsg84_pixel_size(input_img, output_img, gdalformat='KEA')\n"
+"A function which calculates the x and y pixel resolution (in metres) of each\n"
+"pixel projected in WGS84.\n"
+"\n"
+":param input_img: input image, for which the per-pixel size will be calculated.\n"
+":param output_img: output image file where band 1 is X and band 2 is the Y\n"
+"                   pixel resolution.\n"
+":param gdalformat: the output image file format (default: KEA).\n"
+"\n"},
+
+    {"resample_imgs_to_match", (PyCFunction)ImageUtils_ResampleImgsToMatch, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.resample_imgs_to_match(in_ref_img, in_process_imgs, output_imgs, gdalformat, interp_method=rsgislib.INTERP_NEAREST_NEIGHBOUR, datatype=None, no_data_val=None, n_threads=1)\n"
+"Resamples a list of images onto the pixel grid (extent, pixel size and projection) of a reference\n"
+"image. The transformation from the reference grid to the projection of each input is calculated\n"
+"on a lattice of pixels and cached, so images with the same projection share it, and the output\n"
+"is processed in blocks in parallel.\n"
+"\n"
+":param in_ref_img: is the input reference image to which the images are resampled.\n"
+":param in_process_imgs: is a list of the images to be resampled.\n"
+":param output_imgs: is a list of the output image files (same length as in_process_imgs).\n"
+":param gdalformat: is the gdal format for the output images.\n"
+":param interp_method: is the interpolation method (rsgislib.INTERP_NEAREST_NEIGHBOUR,\n"
+"                      INTERP_BILINEAR, INTERP_CUBIC, INTERP_AVERAGE or INTERP_MODE).\n"
+":param datatype: is the rsgislib datatype of the output images (if None then it will be\n"
+"                 the same as the input file).\n"
+":param no_data_val: the no data value of the inputs and outputs (if None then the no data\n"
+"                    value of each input image is used, where defined).\n"
+":param n_threads: the number of threads used to resample each image (0 uses all the cores).\n"
+"\n"},
+
 {"stack_img_bands", (PyCFunction)ImageUtils_StackImageBands, METH_VARARGS | METH_KEYWORDS,
 "rsgislib.imageutils.stack_img_bands(input_imgs, band_names, output_img, skip_value, no_data_val, gdalformat, datatype)\n"
 "Create a single image from list of input images through band stacking.\n"
@@ -2468,16 +3590,75 @@ static PyMethodDef ImageUtilsMethods[] = {
 "\n"},
 
 {"order_img_using_prop_valid_pxls", (PyCFunction)ImageUtils_OrderImagesUsingPropValidData, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.imageutils.order_img_using_prop_valid_pxls(input_imgs, no_data_val)\n"
+"rsgislib.imageutils.order_img_using_prop_valid_pxls(input_imgs, no_data_val, idx_file=None)\n"
 "Order the list of input images based on the their proportion of valid image pixels.\n"
 "The primary use of this function is expected to be order (rank) images ahead of mosaicing.\n"
 "\n"
 ":param input_imgs: is a list of string containing the name and path for the input images.\n"
 ":param no_data_val: is a float which specifies the no data value used to defined \'invalid\' pixels.\n"
+":param idx_file: optionally, a footprint index (see create_img_footprint_idx) from which the valid pixel\n"
+"                 fractions (calculated with no_data_val) of the images which have not changed are used\n"
+"                 rather than reading the images.\n"
 "\n"
 ":return: a list of images ordered, from low to high (i.e., the first image will be the image with the smallest number of valid image pixels).\n"
 "\n"},
 
+{"create_img_footprint_idx", (PyCFunction)ImageUtils_CreateImgFootprintIdx, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.create_img_footprint_idx(input_imgs, idx_file, idx_epsg=0, calc_valid_frac=False, no_data_val=None)\n"
+"Create a footprint index for a set of images. The index is a packed R-tree of the image\n"
+"bounding boxes with cached metadata for each image (number of bands, image size, no data\n"
+"value, projection and optionally the proportion of valid pixels) within a single file which\n"
+"is memory mapped when queried, so it is much faster than a vector LUT for large archives.\n"
+"\n"
+":param input_imgs: is a list of the input images.\n"
+":param idx_file: is the output footprint index file.\n"
+":param idx_epsg: is the EPSG code the image bounding boxes are reprojected to. If 0 (default)\n"
+"                 the bounding boxes are in the image coordinates and all the images must be\n"
+"                 in the same projection.\n"
+":param calc_valid_frac: if True the proportion of valid pixels is calculated for each image\n"
+"                        (this requires each image to be read).\n"
+":param no_data_val: the no data value for the valid pixel proportion. If None the no data\n"
+"                    value of each image is used.\n"
+"\n"
+".. code:: python\n"
+"\n"
+"   import glob\n"
+"   import rsgislib.imageutils\n"
+"   imgs = glob.glob('/data/sen2/*.kea')\n"
+"   rsgislib.imageutils.create_img_footprint_idx(imgs, 'sen2_imgs.idx', idx_epsg=4326)\n"
+"\n"},
+
+{"update_img_footprint_idx", (PyCFunction)ImageUtils_UpdateImgFootprintIdx, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.update_img_footprint_idx(idx_file, input_imgs=None, remove_missing=False, calc_valid_frac=False, no_data_val=None)\n"
+"Update a footprint index. Images which are not within the index are added and those which have\n"
+"changed (file size or modification time) since they were indexed are re-read; the cached\n"
+"metadata is reused for all other images.\n"
+"\n"
+":param idx_file: is the footprint index file to be updated.\n"
+":param input_imgs: is a list of images to be added to or refreshed within the index.\n"
+":param remove_missing: if True images within the index which no longer exist are removed.\n"
+":param calc_valid_frac: if True the proportion of valid pixels is calculated for the images\n"
+"                        read and for the input images without a current value.\n"
+":param no_data_val: the no data value for the valid pixel proportion. If None the no data\n"
+"                    value of each image is used.\n"
+"\n"
+":return: the number of images which were read.\n"
+"\n"},
+
+{"query_img_footprint_idx", (PyCFunction)ImageUtils_QueryImgFootprintIdx, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.query_img_footprint_idx(idx_file, bbox=None, get_info=False)\n"
+"Query a footprint index for the images which intersect a bounding box.\n"
+"\n"
+":param idx_file: is the footprint index file.\n"
+":param bbox: is the bbox (MinX, MaxX, MinY, MaxY) in the projection of the index. If None\n"
+"             all the images are returned.\n"
+":param get_info: if True a dict of the cached metadata is returned for each image (keys: file,\n"
+"                 bbox, n_bands, x_size, y_size, no_data_val, valid_frac and wkt) rather than\n"
+"                 the file path. no_data_val and valid_frac are None if not defined.\n"
+"\n"
+":return: a list of image file paths (or dicts if get_info is True).\n"
+"\n"},
+
 {"gen_sampling_grid", (PyCFunction)ImageUtils_GenSamplingGrid, METH_VARARGS | METH_KEYWORDS,
 "rsgislib.imageutils.gen_sampling_grid(input_img, output_img, gdalformat, pxl_res, min_val, max_val, single_line)\n"
 "Generate a regular sampling grid.\n"
@@ -2524,6 +3705,35 @@ static PyMethodDef ImageUtilsMethods[] = {
 "   imageutils.gen_valid_mask(inputImage, outputImage, \'KEA\', 0.0)\n"
 "\n"},
 
+{"gen_multi_img_valid_masks", (PyCFunction)ImageUtils_GenMultiImgValidMasks, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.gen_multi_img_valid_masks(input_imgs=list, output_img=string, gdalformat=string, out_packed_img='', no_data_val=0.0, use_img_no_data=True, check_finite=True, n_threads=0)\n"
+"Calculate the validity of a stack of images (e.g., a time series) in a single pass. A pixel is valid\n"
+"within an image if none of the bands are equal to the no data value (and are finite if check_finite is True).\n"
+"The images must be on the same pixel grid but can have different extents; the output covers the union of\n"
+"the input images. The output image has 5 bands: 1) the number of valid images, 2) all images valid,\n"
+"3) any images valid, 4) the first valid image and 5) the last valid image (image indexes start at 1\n"
+"and 0 is used where no image is valid). The output is Byte unless there are more than 254 images.\n"
+"\n"
+":param input_imgs: is a list of input images.\n"
+":param output_img: is a string containing the name of the output file (can be an empty string if only\n"
+"                   the packed output is required).\n"
+":param gdalformat: is a string with the GDAL output file format.\n"
+":param out_packed_img: is an optional output image where bit i (starting at 0) of a single band is set\n"
+"                       if image i is valid. Up to 32 images are supported.\n"
+":param no_data_val: is a float defining the no data value (Optional and default is 0.0)\n"
+":param use_img_no_data: if True the no data value defined in the image header is used where available.\n"
+":param check_finite: if True non-finite values (NaN and Inf) are also treated as not valid. A NaN\n"
+"                     no data value always marks NaN pixels as not valid.\n"
+":param n_threads: the number of threads used for the per-row validity calculations; the input\n"
+"                  images are read serially (0 uses all the cores).\n"
+"\n"
+"\n.. code:: python\n"
+"\n"
+"   from rsgislib import imageutils\n"
+"   input_imgs = ['./sen2_20210527_aber.kea', './sen2_20210602_aber.kea', './sen2_20210612_aber.kea']\n"
+"   imageutils.gen_multi_img_valid_masks(input_imgs, './sen2_valid_summary.kea', 'KEA', out_packed_img='./sen2_valid_packed.kea')\n"
+"\n"},
+
 {"gen_img_edge_mask", (PyCFunction)ImageUtils_GenImageEdgeMask, METH_VARARGS | METH_KEYWORDS,
 "rsgislib.imageutils.gen_img_edge_mask(input_img=string, output_img=string, gdalformat=string, n_edge_pxls=int)\n"
 "Generate a binary image mask defining the edges of the pixel. The n_edge_pxls parameter specifies the \n"
@@ -2757,6 +3967,30 @@ static PyMethodDef ImageUtilsMethods[] = {
 "\n"
 "\n"},
 
+{"decode_bit_fields", (PyCFunction)ImageUtils_DecodeBitFields, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.imageutils.decode_bit_fields(input_img=string, img_band=int, output_img=string, gdalformat=string, bit_fields=list, pack_masks=False)\n"
+"This function decodes bit fields (e.g., from a Landsat or Sentinel-2 QA band) into a Byte output image\n"
+"with one band per field. Alternatively, each field can be treated as a boolean mask (field != 0) and\n"
+"the masks packed into the bits of a single output band (Byte, UInt16 or UInt32 depending on the number of masks).\n"
+"\n"
+":param input_img: is a string specifying the input image file.\n"
+":param img_band: is the image band in the input image to use (index starts at 1).\n"
+":param output_img: is a string specifying the output image file\n"
+":param gdalformat: is a string specifying the GDAL image file format for the output file.\n"
+":param bit_fields: is a list of rsgislib.imageutils.BitFieldInfo objects defining the fields to decode.\n"
+"                   Each output band (or bit if packing) must be used by one field.\n"
+":param pack_masks: if True the fields are output as bits within a single band rather than as separate bands.\n"
+"\n"
+".. code:: python\n"
+"\n"
+"   import rsgislib.imageutils\n"
+"   bit_fields = list()\n"
+"   bit_fields.append(rsgislib.imageutils.BitFieldInfo(name='cloud', bit_offset=3, bit_length=1, out_band=1))\n"
+"   bit_fields.append(rsgislib.imageutils.BitFieldInfo(name='cloud_shadow', bit_offset=4, bit_length=1, out_band=2))\n"
+"   bit_fields.append(rsgislib.imageutils.BitFieldInfo(name='cloud_conf', bit_offset=8, bit_length=2, out_band=3))\n"
+"   rsgislib.imageutils.decode_bit_fields('LC08_QA_PIXEL.tif', 1, 'LC08_QA_decoded.kea', 'KEA', bit_fields)\n"
+"\n"},
+
 {nullptr}        /* Sentinel */
 };
 
@@ -1617,6 +1617,39 @@ static PyObject *RasterGIS_ExportClumps2Images(PyObject *self, PyObject *args, P
     Py_RETURN_NONE;
 }
 
+static PyObject *RasterGIS_ReadRATColumn(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    const char *clumpsImage, *colName;
+    unsigned int ratBand = 1;
+
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("clumps_img"), RSGIS_PY_C_TEXT("col_name"),
+                             RSGIS_PY_C_TEXT("rat_band"), nullptr};
+
+    if(!PyArg_ParseTupleAndKeywords(args, keywds, "ss|I:read_rat_column", kwlist, &clumpsImage, &colName, &ratBand))
+    {
+        return nullptr;
+    }
+
+    std::vector<int> intVals;
+    std::vector<double> realVals;
+    bool isIntCol = false;
+    try
+    {
+        isIntCol = rsgis::cmds::executeReadRATColumn(std::string(clumpsImage), std::string(colName), &intVals, &realVals, ratBand);
+    }
+    catch (rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    if(isIntCol)
+    {
+        return RSGISPY_CREATE_ARRAY(std::move(intVals));
+    }
+    return RSGISPY_CREATE_ARRAY(std::move(realVals));
+}
+
 
 static PyMethodDef RasterGISMethods[] = {
     {"pop_rat_img_stats", (PyCFunction)RasterGIS_PopulateStats, METH_VARARGS | METH_KEYWORDS,
@@ -2241,6 +2274,17 @@ static PyMethodDef RasterGISMethods[] = {
 ":return: double for distance\n"
 "\n"},
 
+{"read_rat_column", (PyCFunction)RasterGIS_ReadRATColumn, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.rastergis.read_rat_column(clumps_img, col_name, rat_band=1)\n"
+"Reads an integer or real column of the RAT into memory without converting each value to a python object.\n"
+"\n"
+":param clumps_img: is a string containing the name of the input image file with RAT\n"
+":param col_name: is a string with the name of the column to be read (string columns are not supported).\n"
+":param rat_band: is an optional (default = 1) integer parameter specifying the image band to which the RAT is associated.\n"
+"\n"
+":return: a memoryview of int32 (integer columns) or float64 (real columns) values, use numpy.asarray to access as a numpy array without a copy.\n"
+"\n"},
+
 {"export_clumps_to_images", (PyCFunction)RasterGIS_ExportClumps2Images, METH_VARARGS | METH_KEYWORDS,
 "rsgislib.rastergis.export_clumps_to_images(clumps_img, out_img_base, bin_out, out_img_ext, gdalformat, rat_band=1)\n"
 "Exports each clump to a seperate raster which is the minimum extent for the clump.\n"
@@ -26,6 +26,8 @@
 #include <Python.h>
 #include <limits>
 #include <string>
+#include <vector>
+#include <utility>
 #include <string.h>
 
 #include "common/RSGISCommons.h"
@@ -118,4 +120,140 @@ inline double RSGISPY_FLOAT_EXTRACT(PyObject *o)
 }
 
 
+// An object owning a contiguous C++ array which is exported through the buffer
+// protocol, so results can be returned to python (and used with numpy.asarray)
+// without building a python object for each element.
+struct RSGISPyArrayObject
+{
+    PyObject_HEAD
+    void *data;
+    void *owner;
+    void (*freeOwner)(void *owner);
+    const char *format;
+    int nDims;
+    Py_ssize_t itemSize;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+};
+
+inline void RSGISPyArray_dealloc(PyObject *self)
+{
+    RSGISPyArrayObject *arr = (RSGISPyArrayObject*)self;
+    if(arr->freeOwner != nullptr)
+    {
+        arr->freeOwner(arr->owner);
+    }
+    PyObject_Del(self);
+}
+
+inline int RSGISPyArray_getbuffer(PyObject *self, Py_buffer *view, int flags)
+{
+    RSGISPyArrayObject *arr = (RSGISPyArrayObject*)self;
+    view->obj = self;
+    Py_INCREF(self);
+    view->buf = arr->data;
+    view->len = arr->itemSize * arr->shape[0] * ((arr->nDims == 2)?arr->shape[1]:1);
+    view->readonly = 0;
+    view->itemsize = arr->itemSize;
+    view->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT)?const_cast<char*>(arr->format):nullptr;
+    // Without PyBUF_ND the shape is not provided so the (contiguous) data must be
+    // presented as one dimensional.
+    view->ndim = ((flags & PyBUF_ND) == PyBUF_ND)?arr->nDims:1;
+    view->shape = ((flags & PyBUF_ND) == PyBUF_ND)?arr->shape:nullptr;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES)?arr->strides:nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+// The type is created once for each extension module.
+inline PyTypeObject *RSGISPY_ARRAY_TYPE()
+{
+    static PyBufferProcs arrayBufferProcs;
+    static PyTypeObject arrayType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+    static bool typeReady = false;
+    if(!typeReady)
+    {
+        arrayBufferProcs.bf_getbuffer = RSGISPyArray_getbuffer;
+        arrayBufferProcs.bf_releasebuffer = nullptr;
+        arrayType.tp_name = "rsgislib.RSGISPyArray";
+        arrayType.tp_basicsize = sizeof(RSGISPyArrayObject);
+        arrayType.tp_dealloc = RSGISPyArray_dealloc;
+        arrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+        arrayType.tp_as_buffer = &arrayBufferProcs;
+        arrayType.tp_doc = "A contiguous array returned by rsgislib, use numpy.asarray to access as a numpy array without a copy.";
+        if(PyType_Ready(&arrayType) < 0)
+        {
+            return nullptr;
+        }
+        typeReady = true;
+    }
+    return &arrayType;
+}
+
+template<typename T> inline const char *RSGISPY_BUFFER_FORMAT();
+template<> inline const char *RSGISPY_BUFFER_FORMAT<float>() {return "f";}
+template<> inline const char *RSGISPY_BUFFER_FORMAT<double>() {return "d";}
+template<> inline const char *RSGISPY_BUFFER_FORMAT<int>() {return "i";}
+template<> inline const char *RSGISPY_BUFFER_FORMAT<unsigned int>() {return "I";}
+template<> inline const char *RSGISPY_BUFFER_FORMAT<long long>() {return "q";}
+template<> inline const char *RSGISPY_BUFFER_FORMAT<unsigned long long>() {return "Q";}
+
+template<typename T> inline void RSGISPY_FREE_VECTOR(void *owner)
+{
+    delete (std::vector<T>*)owner;
+}
+
+template<typename T> inline void RSGISPY_FREE_NEW_ARRAY(void *owner)
+{
+    delete[] (T*)owner;
+}
+
+template<typename T>
+inline PyObject *RSGISPY_WRAP_ARRAY(T *data, void *owner, void (*freeOwner)(void*), Py_ssize_t nRows, Py_ssize_t nCols)
+{
+    PyTypeObject *arrayType = RSGISPY_ARRAY_TYPE();
+    RSGISPyArrayObject *arr = nullptr;
+    if(arrayType != nullptr)
+    {
+        arr = PyObject_New(RSGISPyArrayObject, arrayType);
+    }
+    if(arr == nullptr)
+    {
+        freeOwner(owner);
+        return nullptr;
+    }
+    arr->data = data;
+    arr->owner = owner;
+    arr->freeOwner = freeOwner;
+    arr->format = RSGISPY_BUFFER_FORMAT<T>();
+    arr->itemSize = sizeof(T);
+    arr->nDims = (nCols > 0)?2:1;
+    arr->shape[0] = nRows;
+    arr->shape[1] = nCols;
+    arr->strides[0] = sizeof(T) * ((nCols > 0)?nCols:1);
+    arr->strides[1] = sizeof(T);
+
+    PyObject *view = PyMemoryView_FromObject((PyObject*)arr);
+    Py_DECREF(arr);
+    return view;
+}
+
+// Returns a memoryview of shape (nRows) or, if nCols > 0, (nRows, nCols) over an
+// array allocated with new[], which is freed when no longer referenced from python.
+template<typename T>
+inline PyObject *RSGISPY_CREATE_ARRAY(T *data, Py_ssize_t nRows, Py_ssize_t nCols=0)
+{
+    return RSGISPY_WRAP_ARRAY<T>(data, data, RSGISPY_FREE_NEW_ARRAY<T>, nRows, nCols);
+}
+
+// As above but the data is moved (not copied) out of vals, which must have nRows x nCols values.
+template<typename T>
+inline PyObject *RSGISPY_CREATE_ARRAY(std::vector<T> &&vals, Py_ssize_t nCols=0)
+{
+    std::vector<T> *owner = new std::vector<T>(std::move(vals));
+    Py_ssize_t nRows = (nCols > 0)?(owner->size() / nCols):owner->size();
+    return RSGISPY_WRAP_ARRAY<T>(owner->data(), owner, RSGISPY_FREE_VECTOR<T>, nRows, nCols);
+}
+
 #endif // RSGISPY_COMMON_H
@@ -209,6 +209,53 @@ static PyObject *VectorUtils_CheckValidateGeometries(PyObject *self, PyObject *a
 }
 
 
+static PyObject *VectorUtils_PolygoniseImg(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("img_band"),
+                             RSGIS_PY_C_TEXT("out_vec_file"), RSGIS_PY_C_TEXT("out_vec_lyr"),
+                             RSGIS_PY_C_TEXT("out_format"), RSGIS_PY_C_TEXT("mask_img"),
+                             RSGIS_PY_C_TEXT("mask_band"), RSGIS_PY_C_TEXT("pxl_val_fieldname"),
+                             RSGIS_PY_C_TEXT("use_8_conn"), RSGIS_PY_C_TEXT("replace_file"),
+                             RSGIS_PY_C_TEXT("replace_lyr"), nullptr};
+    const char *pszInputImg, *pszOutputVectorFile, *pszOutputVectorLyr, *pszOutFormat;
+    const char *pszMaskImg = "";
+    const char *pszPxlValFieldName = "PXLVAL";
+    unsigned int imgBand = 1;
+    unsigned int maskBand = 1;
+    int use8Conn = false;
+    int replaceFile = true;
+    int replaceLyr = true;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sIsss|zIsiii:polygonise_img", kwlist, &pszInputImg, &imgBand,
+                                     &pszOutputVectorFile, &pszOutputVectorLyr, &pszOutFormat, &pszMaskImg, &maskBand,
+                                     &pszPxlValFieldName, &use8Conn, &replaceFile, &replaceLyr))
+    {
+        return nullptr;
+    }
+
+    if(pszMaskImg == nullptr)
+    {
+        pszMaskImg = "";
+    }
+
+    unsigned long numFeats = 0;
+    try
+    {
+        numFeats = rsgis::cmds::executePolygoniseImage(std::string(pszInputImg), imgBand, std::string(pszMaskImg), maskBand,
+                                                       std::string(pszOutputVectorFile), std::string(pszOutputVectorLyr),
+                                                       std::string(pszOutFormat), std::string(pszPxlValFieldName),
+                                                       (bool)use8Conn, (bool)replaceFile, (bool)replaceLyr);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return PyLong_FromUnsignedLong(numFeats);
+}
+
+
 // Our list of functions in this module
 static PyMethodDef VectorUtilsMethods[] = {
 
@@ -256,6 +303,34 @@ static PyMethodDef VectorUtilsMethods[] = {
 ":param print_err_geoms: is a bool, specifying whether were errors are found they are printed to the console.\n"
 ":param del_exist_vec: is a bool, specifying whether to force removal of the output vector if it exists\n"
 "\n"},
+
+{"polygonise_img", (PyCFunction)VectorUtils_PolygoniseImg, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.vectorutils.polygonise_img(input_img:str, img_band:int, out_vec_file:str, out_vec_lyr:str, out_format:str, mask_img:str=None, mask_band:int=1, pxl_val_fieldname:str='PXLVAL', use_8_conn:bool=False, replace_file:bool=True, replace_lyr:bool=True)\n"
+"A function to polygonise an image band, creating a feature for each connected region of\n"
+"pixels with the same value. The image is processed as runs of pixels which are merged\n"
+"into regions row by row, with each region written once it is complete, so the memory\n"
+"used depends on the width of the image rather than the number of pixels.\n"
+"Pixels which are zero in the mask, are the image no data value or are NaN are ignored.\n"
+"With 4 connectedness the features are polygons, with 8 connectedness multi-polygons.\n"
+"\n"
+":param input_img: is a string specifying the input image file to be polygonised\n"
+":param img_band: is an int specifying the image band to be polygonised (starts at 1).\n"
+":param out_vec_file: is a string containing the output vector file path\n"
+":param out_vec_lyr: is a string containing the name of the output vector layer name\n"
+":param out_format: is a string specifying the output vector GDAL/OGR driver (e.g., GPKG).\n"
+":param mask_img: is an optional string specifying a mask image, where pixels with a value\n"
+"                 of zero will not be polygonised (Default: None).\n"
+":param mask_band: is an int specifying the band within the mask image (Default: 1).\n"
+":param pxl_val_fieldname: is a string with the name of the output column for the pixel\n"
+"                          value. For floating point images the column is real otherwise\n"
+"                          it is an integer.\n"
+":param use_8_conn: is a bool specifying whether 8 connectedness or 4 connectedness\n"
+"                   should be used (Default: False; i.e., 4 connectedness).\n"
+":param replace_file: is a bool specifying whether the vector file should be replaced,\n"
+"                     otherwise the layer is added to the existing file (Default: True).\n"
+":param replace_lyr: is a bool specifying whether an existing layer should be replaced (Default: True).\n"
+":return: the number of features written.\n"
+"\n"},
     
 {nullptr}        /* Sentinel */
 };
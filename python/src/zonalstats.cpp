@@ -104,34 +104,17 @@ static PyObject *ZonalStats_ExtractZoneImageValues2HDF(PyObject *self, PyObject
     Py_RETURN_NONE;
 }
 
-static PyObject *ZonalStats_ExtractZoneImageBandValues2HDF(PyObject *self, PyObject *args, PyObject *keywds)
+// Reads a sequence of objects with 'file_name' and 'bands' attributes (e.g., rsgislib.imageutils.ImageBandInfo).
+static bool ZonalStats_ReadImageFileInfo(PyObject *self, PyObject *inputImageFileInfoObj, std::vector<std::pair<std::string, std::vector<unsigned int> > > *imageFilesInfo)
 {
-    PyObject *inputImageFileInfoObj;
-    const char *pszInputMaskImage;
-    const char *pszOutputFile;
-    float maskValue = 0;
-    int nDataType = 9;
-
-    static char *kwlist[] = {RSGIS_PY_C_TEXT("in_img_info"), RSGIS_PY_C_TEXT("in_msk_img"),
-                             RSGIS_PY_C_TEXT("out_h5_file"), RSGIS_PY_C_TEXT("mask_val"),
-                             RSGIS_PY_C_TEXT("datatype"), nullptr};
-
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Ossf|i:extract_zone_img_band_values_to_hdf", kwlist, &inputImageFileInfoObj, &pszInputMaskImage, &pszOutputFile, &maskValue, &nDataType))
-    {
-        return nullptr;
-    }
-
     if( !PySequence_Check(inputImageFileInfoObj))
     {
         PyErr_SetString(GETSTATE(self)->error, "First argument (imageFileInfo) must be a sequence");
-        return nullptr;
+        return false;
     }
 
-    rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType)nDataType;
-
     Py_ssize_t nFileInfo = PySequence_Size(inputImageFileInfoObj);
-    std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFilesInfo;
-    imageFilesInfo.reserve(nFileInfo);
+    imageFilesInfo->reserve(nFileInfo);
     std::string tmpFileName = "";
 
     for( Py_ssize_t n = 0; n < nFileInfo; n++ )
@@ -144,7 +127,7 @@ static PyObject *ZonalStats_ExtractZoneImageBandValues2HDF(PyObject *self, PyObj
             PyErr_SetString(GETSTATE(self)->error, "Could not find string attribute \'file_name\'" );
             Py_XDECREF(pFileName);
             Py_DECREF(o);
-            return nullptr;
+            return false;
         }
 
         PyObject *pBands = PyObject_GetAttrString(o, "bands");
@@ -154,7 +137,7 @@ static PyObject *ZonalStats_ExtractZoneImageBandValues2HDF(PyObject *self, PyObj
             Py_DECREF(pFileName);
             Py_XDECREF(pBands);
             Py_DECREF(o);
-            return nullptr;
+            return false;
         }
 
         Py_ssize_t nBands = PySequence_Size(pBands);
@@ -164,7 +147,7 @@ static PyObject *ZonalStats_ExtractZoneImageBandValues2HDF(PyObject *self, PyObj
             Py_DECREF(pFileName);
             Py_DECREF(pBands);
             Py_DECREF(o);
-            return nullptr;
+            return false;
         }
         std::vector<unsigned int> bandsVec = std::vector<unsigned int>();
         bandsVec.reserve(nBands);
@@ -179,13 +162,44 @@ static PyObject *ZonalStats_ExtractZoneImageBandValues2HDF(PyObject *self, PyObj
                 Py_DECREF(pFileName);
                 Py_DECREF(pBands);
                 Py_DECREF(o);
-                return nullptr;
+                return false;
             }
             bandsVec.push_back(RSGISPY_INT_EXTRACT(bO));
+            Py_DECREF(bO);
         }
 
         tmpFileName = std::string(RSGISPY_STRING_EXTRACT(pFileName));
-        imageFilesInfo.push_back(std::pair<std::string, std::vector<unsigned int> >(tmpFileName, bandsVec));
+        imageFilesInfo->push_back(std::pair<std::string, std::vector<unsigned int> >(tmpFileName, bandsVec));
+        Py_DECREF(pFileName);
+        Py_DECREF(pBands);
+        Py_DECREF(o);
+    }
+    return true;
+}
+
+static PyObject *ZonalStats_ExtractZoneImageBandValues2HDF(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *inputImageFileInfoObj;
+    const char *pszInputMaskImage;
+    const char *pszOutputFile;
+    float maskValue = 0;
+    int nDataType = 9;
+
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("in_img_info"), RSGIS_PY_C_TEXT("in_msk_img"),
+                             RSGIS_PY_C_TEXT("out_h5_file"), RSGIS_PY_C_TEXT("mask_val"),
+                             RSGIS_PY_C_TEXT("datatype"), nullptr};
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Ossf|i:extract_zone_img_band_values_to_hdf", kwlist, &inputImageFileInfoObj, &pszInputMaskImage, &pszOutputFile, &maskValue, &nDataType))
+    {
+        return nullptr;
+    }
+
+    rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType)nDataType;
+
+    std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFilesInfo;
+    if(!ZonalStats_ReadImageFileInfo(self, inputImageFileInfoObj, &imageFilesInfo))
+    {
+        return nullptr;
     }
 
     try
@@ -203,17 +217,54 @@ static PyObject *ZonalStats_ExtractZoneImageBandValues2HDF(PyObject *self, PyObj
 }
 
 
+static PyObject *ZonalStats_ExtractZoneImageBandValues(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *inputImageFileInfoObj;
+    const char *pszInputMaskImage;
+    float maskValue = 0;
+
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("in_img_info"), RSGIS_PY_C_TEXT("in_msk_img"),
+                             RSGIS_PY_C_TEXT("mask_val"), nullptr};
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Osf:extract_zone_img_band_values", kwlist, &inputImageFileInfoObj, &pszInputMaskImage, &maskValue))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFilesInfo;
+    if(!ZonalStats_ReadImageFileInfo(self, inputImageFileInfoObj, &imageFilesInfo))
+    {
+        return nullptr;
+    }
+
+    std::vector<float> pxlVals;
+    unsigned int numBands = 0;
+    try
+    {
+        numBands = rsgis::cmds::executeImageBandRasterZone2Array(imageFilesInfo, std::string(pszInputMaskImage), maskValue, &pxlVals);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return RSGISPY_CREATE_ARRAY(std::move(pxlVals), numBands);
+}
+
 static PyObject *ZonalStats_RandomSampleHDF5File(PyObject *self, PyObject *args, PyObject *keywds)
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("in_h5_file"), RSGIS_PY_C_TEXT("out_h5_file"),
-                             RSGIS_PY_C_TEXT("sample"), RSGIS_PY_C_TEXT("rnd_seed"), RSGIS_PY_C_TEXT("datatype"), nullptr};
+                             RSGIS_PY_C_TEXT("sample"), RSGIS_PY_C_TEXT("rnd_seed"), RSGIS_PY_C_TEXT("datatype"),
+                             RSGIS_PY_C_TEXT("shuffle"), nullptr};
     const char *pInputH5 = "";
     const char *pOutputH5 = "";
     unsigned int sampleSize = 0;
     int seed = 0;
     int nDataType = 9;
+    int shuffle = false;
 
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssIi|i:random_sample_hdf5_file", kwlist, &pInputH5, &pOutputH5, &sampleSize, &seed, &nDataType))
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "ssIi|ip:random_sample_hdf5_file", kwlist, &pInputH5, &pOutputH5, &sampleSize, &seed, &nDataType, &shuffle))
     {
         return nullptr;
     }
@@ -222,7 +273,7 @@ static PyObject *ZonalStats_RandomSampleHDF5File(PyObject *self, PyObject *args,
 
     try
     {
-        rsgis::cmds::executeRandomSampleH5File(std::string(pInputH5), std::string(pOutputH5), sampleSize, seed, type);
+        rsgis::cmds::executeRandomSampleH5File(std::string(pInputH5), std::string(pOutputH5), sampleSize, seed, type, shuffle);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -237,15 +288,16 @@ static PyObject *ZonalStats_SplitSampleHDF5File(PyObject *self, PyObject *args,
 {
     static char *kwlist[] = {RSGIS_PY_C_TEXT("in_h5_file"), RSGIS_PY_C_TEXT("out_h5_p1_file"),
                              RSGIS_PY_C_TEXT("out_h5_p2_file"), RSGIS_PY_C_TEXT("sample"),
-                             RSGIS_PY_C_TEXT("rnd_seed"), RSGIS_PY_C_TEXT("datatype"), nullptr};
+                             RSGIS_PY_C_TEXT("rnd_seed"), RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("shuffle"), nullptr};
     const char *pInputH5 = "";
     const char *pOutputP1H5 = "";
     const char *pOutputP2H5 = "";
     unsigned int sampleSize = 0;
     int seed = 0;
     int nDataType = 9;
+    int shuffle = false;
 
-    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssIi|i:split_sample_hdf5_file", kwlist, &pInputH5, &pOutputP1H5, &pOutputP2H5, &sampleSize, &seed, &nDataType))
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssIi|ip:split_sample_hdf5_file", kwlist, &pInputH5, &pOutputP1H5, &pOutputP2H5, &sampleSize, &seed, &nDataType, &shuffle))
     {
         return nullptr;
     }
@@ -254,7 +306,7 @@ static PyObject *ZonalStats_SplitSampleHDF5File(PyObject *self, PyObject *args,
 
     try
     {
-        rsgis::cmds::executeSplitSampleH5File(std::string(pInputH5), std::string(pOutputP1H5), std::string(pOutputP2H5), sampleSize, seed, type);
+        rsgis::cmds::executeSplitSampleH5File(std::string(pInputH5), std::string(pOutputP1H5), std::string(pOutputP2H5), sampleSize, seed, type, shuffle);
     }
     catch(rsgis::cmds::RSGISCmdException &e)
     {
@@ -266,6 +318,463 @@ static PyObject *ZonalStats_SplitSampleHDF5File(PyObject *self, PyObject *args,
 }
 
 
+static PyObject *ZonalStats_CalcZonalBandStats(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("vec_file"), RSGIS_PY_C_TEXT("vec_lyr"),
+                             RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("img_band"),
+                             RSGIS_PY_C_TEXT("min_thres"), RSGIS_PY_C_TEXT("max_thres"),
+                             RSGIS_PY_C_TEXT("out_no_data_val"), RSGIS_PY_C_TEXT("min_field"),
+                             RSGIS_PY_C_TEXT("max_field"), RSGIS_PY_C_TEXT("mean_field"),
+                             RSGIS_PY_C_TEXT("stddev_field"), RSGIS_PY_C_TEXT("sum_field"),
+                             RSGIS_PY_C_TEXT("count_field"), RSGIS_PY_C_TEXT("mode_field"),
+                             RSGIS_PY_C_TEXT("median_field"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszVecFile, *pszVecLyr, *pszInputImage;
+    unsigned int imgBand = 1;
+    double minThres, maxThres, outNoDataVal;
+    const char *pszFields[8] = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+    unsigned int nThreads = 1;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssIddd|zzzzzzzzI:calc_zonal_band_stats_native", kwlist, &pszVecFile, &pszVecLyr, &pszInputImage,
+                                     &imgBand, &minThres, &maxThres, &outNoDataVal, &pszFields[0], &pszFields[1], &pszFields[2], &pszFields[3],
+                                     &pszFields[4], &pszFields[5], &pszFields[6], &pszFields[7], &nThreads))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::string> statFields;
+    for(int i = 0; i < 8; ++i)
+    {
+        statFields.push_back((pszFields[i] == nullptr)?std::string(""):std::string(pszFields[i]));
+    }
+
+    unsigned long nFeats = 0;
+    try
+    {
+        nFeats = rsgis::cmds::executeCalcZonalBandStats(std::string(pszVecFile), std::string(pszVecLyr), std::string(pszInputImage), imgBand,
+                                                        minThres, maxThres, outNoDataVal, statFields, nThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return PyLong_FromUnsignedLong(nFeats);
+}
+
+
+// Reads a sequence (or a contiguous float64 buffer, such as a numpy array) of numbers.
+static bool ZonalStats_ReadDoubleSeq(PyObject *self, PyObject *seqObj, const char *name, std::vector<double> *vals)
+{
+    Py_buffer view;
+    if(PyObject_CheckBuffer(seqObj) && (PyObject_GetBuffer(seqObj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == 0))
+    {
+        bool isDouble = (view.format != nullptr) && (std::string(view.format) == "d") && (view.itemsize == sizeof(double));
+        if(isDouble)
+        {
+            const double *data = (const double*)view.buf;
+            vals->assign(data, data + (view.len / sizeof(double)));
+        }
+        PyBuffer_Release(&view);
+        if(isDouble)
+        {
+            return true;
+        }
+    }
+    PyErr_Clear();
+
+    PyObject *seqFast = PySequence_Fast(seqObj, "");
+    if(seqFast == nullptr)
+    {
+        PyErr_Format(GETSTATE(self)->error, "%s must be a sequence of numbers", name);
+        return false;
+    }
+    Py_ssize_t nVals = PySequence_Fast_GET_SIZE(seqFast);
+    vals->reserve(nVals);
+    for(Py_ssize_t i = 0; i < nVals; ++i)
+    {
+        double val = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(seqFast, i));
+        if((val == -1.0) && PyErr_Occurred())
+        {
+            Py_DECREF(seqFast);
+            PyErr_Format(GETSTATE(self)->error, "%s must be a sequence of numbers", name);
+            return false;
+        }
+        vals->push_back(val);
+    }
+    Py_DECREF(seqFast);
+    return true;
+}
+
+static bool ZonalStats_ReadBandsList(PyObject *self, PyObject *bandsObj, std::vector<unsigned int> *bands)
+{
+    PyObject *seqFast = PySequence_Fast(bandsObj, "");
+    if(seqFast == nullptr)
+    {
+        PyErr_SetString(GETSTATE(self)->error, "img_bands must be a sequence of band numbers");
+        return false;
+    }
+    Py_ssize_t nBands = PySequence_Fast_GET_SIZE(seqFast);
+    for(Py_ssize_t i = 0; i < nBands; ++i)
+    {
+        PyObject *o = PySequence_Fast_GET_ITEM(seqFast, i);
+        if(!RSGISPY_CHECK_INT(o))
+        {
+            Py_DECREF(seqFast);
+            PyErr_SetString(GETSTATE(self)->error, "img_bands must be a sequence of band numbers");
+            return false;
+        }
+        bands->push_back(RSGISPY_UINT_EXTRACT(o));
+    }
+    Py_DECREF(seqFast);
+    return true;
+}
+
+static PyObject *ZonalStats_SamplePtsBandValues(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("vec_file"), RSGIS_PY_C_TEXT("vec_lyr"),
+                             RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("img_bands"),
+                             RSGIS_PY_C_TEXT("out_fields"), RSGIS_PY_C_TEXT("min_thres"),
+                             RSGIS_PY_C_TEXT("max_thres"), RSGIS_PY_C_TEXT("out_no_data_val"),
+                             RSGIS_PY_C_TEXT("sample_method"), RSGIS_PY_C_TEXT("win_size"),
+                             RSGIS_PY_C_TEXT("reproj_vec"), RSGIS_PY_C_TEXT("vec_def_epsg"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszVecFile, *pszVecLyr, *pszInputImage;
+    PyObject *imgBandsObj, *outFieldsObj;
+    double minThres, maxThres, outNoDataVal;
+    unsigned int sampleMethod = 0;
+    unsigned int winSize = 3;
+    int reprojVec = false;
+    int vecDefEPSG = 0;
+    unsigned int nThreads = 1;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sssOOddd|IIpiI:sample_pts_band_values_native", kwlist, &pszVecFile, &pszVecLyr, &pszInputImage,
+                                     &imgBandsObj, &outFieldsObj, &minThres, &maxThres, &outNoDataVal, &sampleMethod, &winSize,
+                                     &reprojVec, &vecDefEPSG, &nThreads))
+    {
+        return nullptr;
+    }
+
+    std::vector<unsigned int> imgBands;
+    if(!ZonalStats_ReadBandsList(self, imgBandsObj, &imgBands))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::string> outFields;
+    PyObject *fieldsSeq = PySequence_Fast(outFieldsObj, "");
+    if(fieldsSeq == nullptr)
+    {
+        PyErr_SetString(GETSTATE(self)->error, "out_fields must be a sequence of field names");
+        return nullptr;
+    }
+    for(Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(fieldsSeq); ++i)
+    {
+        PyObject *o = PySequence_Fast_GET_ITEM(fieldsSeq, i);
+        if(!RSGISPY_CHECK_STRING(o))
+        {
+            Py_DECREF(fieldsSeq);
+            PyErr_SetString(GETSTATE(self)->error, "out_fields must be a sequence of field names");
+            return nullptr;
+        }
+        outFields.push_back(RSGISPY_STRING_EXTRACT(o));
+    }
+    Py_DECREF(fieldsSeq);
+
+    unsigned long nFeats = 0;
+    try
+    {
+        nFeats = rsgis::cmds::executeSamplePointBandValues(std::string(pszVecFile), std::string(pszVecLyr), std::string(pszInputImage), imgBands, outFields,
+                                                           sampleMethod, winSize, minThres, maxThres, outNoDataVal, reprojVec, vecDefEPSG, nThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return PyLong_FromUnsignedLong(nFeats);
+}
+
+static PyObject *ZonalStats_SampleImgBandValues(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("input_img"), RSGIS_PY_C_TEXT("img_bands"),
+                             RSGIS_PY_C_TEXT("x_coords"), RSGIS_PY_C_TEXT("y_coords"),
+                             RSGIS_PY_C_TEXT("min_thres"), RSGIS_PY_C_TEXT("max_thres"),
+                             RSGIS_PY_C_TEXT("out_no_data_val"), RSGIS_PY_C_TEXT("sample_method"),
+                             RSGIS_PY_C_TEXT("win_size"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    const char *pszInputImage;
+    PyObject *imgBandsObj, *xCoordsObj, *yCoordsObj;
+    double minThres, maxThres, outNoDataVal;
+    unsigned int sampleMethod = 0;
+    unsigned int winSize = 3;
+    unsigned int nThreads = 1;
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "sOOOddd|III:sample_img_band_values", kwlist, &pszInputImage, &imgBandsObj,
+                                     &xCoordsObj, &yCoordsObj, &minThres, &maxThres, &outNoDataVal, &sampleMethod, &winSize, &nThreads))
+    {
+        return nullptr;
+    }
+
+    std::vector<unsigned int> imgBands;
+    if(!ZonalStats_ReadBandsList(self, imgBandsObj, &imgBands))
+    {
+        return nullptr;
+    }
+    std::vector<double> xCoords;
+    std::vector<double> yCoords;
+    if(!ZonalStats_ReadDoubleSeq(self, xCoordsObj, "x_coords", &xCoords) || !ZonalStats_ReadDoubleSeq(self, yCoordsObj, "y_coords", &yCoords))
+    {
+        return nullptr;
+    }
+
+    std::vector<double> outVals;
+    try
+    {
+        rsgis::cmds::executeSampleImageBandValues(std::string(pszInputImage), imgBands, xCoords, yCoords, sampleMethod, winSize,
+                                                  minThres, maxThres, outNoDataVal, &outVals, nThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return RSGISPY_CREATE_ARRAY(std::move(outVals), imgBands.size());
+}
+
+static PyObject *ZonalStats_ExtractChipZoneImageBandValues2HDF(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    PyObject *inputImageFileInfoObj;
+    const char *pszInputMaskImage;
+    const char *pszOutputFile;
+    const char *pszRefImage = nullptr;
+    float maskValue = 0;
+    unsigned int chipSize = 0;
+    int nDataType = 9;
+    unsigned int refImgBand = 1;
+    unsigned int nThreads = 1;
+
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("in_img_info"), RSGIS_PY_C_TEXT("in_msk_img"),
+                             RSGIS_PY_C_TEXT("mask_val"), RSGIS_PY_C_TEXT("chip_size"),
+                             RSGIS_PY_C_TEXT("out_h5_file"), RSGIS_PY_C_TEXT("datatype"),
+                             RSGIS_PY_C_TEXT("ref_img"), RSGIS_PY_C_TEXT("ref_img_band"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "OsfIs|izII:extract_chip_zone_img_band_values_to_hdf_native", kwlist, &inputImageFileInfoObj, &pszInputMaskImage,
+                                     &maskValue, &chipSize, &pszOutputFile, &nDataType, &pszRefImage, &refImgBand, &nThreads))
+    {
+        return nullptr;
+    }
+
+    rsgis::RSGISLibDataType type = (rsgis::RSGISLibDataType)nDataType;
+
+    std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFilesInfo;
+    if(!ZonalStats_ReadImageFileInfo(self, inputImageFileInfoObj, &imageFilesInfo))
+    {
+        return nullptr;
+    }
+
+    size_t nChips = 0;
+    try
+    {
+        nChips = rsgis::cmds::executeImageBandChipZone2HDF(imageFilesInfo, std::string(pszInputMaskImage), maskValue, chipSize, std::string(pszOutputFile), type,
+                                                           (pszRefImage == nullptr)?std::string(""):std::string(pszRefImage), refImgBand, nThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return PyLong_FromSize_t(nChips);
+}
+
+static PyObject *ZonalStats_MergeChipHDF5Files(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("h5_files"), RSGIS_PY_C_TEXT("out_h5_file"),
+                             RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("with_ref"), nullptr};
+    PyObject *inputFilesObj;
+    const char *pszOutputH5;
+    int nDataType = 9;
+    int withRef = false;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Os|ip:merge_extracted_hdf5_chip_files_native", kwlist, &inputFilesObj, &pszOutputH5, &nDataType, &withRef))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::string> inputFiles;
+    PyObject *filesSeq = PySequence_Fast(inputFilesObj, "");
+    if(filesSeq == nullptr)
+    {
+        PyErr_SetString(GETSTATE(self)->error, "h5_files must be a sequence of file paths");
+        return nullptr;
+    }
+    for(Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(filesSeq); ++i)
+    {
+        PyObject *o = PySequence_Fast_GET_ITEM(filesSeq, i);
+        if(!RSGISPY_CHECK_STRING(o))
+        {
+            Py_DECREF(filesSeq);
+            PyErr_SetString(GETSTATE(self)->error, "h5_files must be a sequence of file paths");
+            return nullptr;
+        }
+        inputFiles.push_back(RSGISPY_STRING_EXTRACT(o));
+    }
+    Py_DECREF(filesSeq);
+
+    size_t nChips = 0;
+    try
+    {
+        nChips = rsgis::cmds::executeMergeChipH5Files(inputFiles, std::string(pszOutputH5), (rsgis::RSGISLibDataType)nDataType, withRef);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return PyLong_FromSize_t(nChips);
+}
+
+
+static bool ZonalStats_GetFileList(PyObject *filesObj, std::vector<std::string> *files)
+{
+    PyObject *filesSeq = PySequence_Fast(filesObj, "");
+    if(filesSeq == nullptr)
+    {
+        return false;
+    }
+    for(Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(filesSeq); ++i)
+    {
+        PyObject *o = PySequence_Fast_GET_ITEM(filesSeq, i);
+        if(!RSGISPY_CHECK_STRING(o))
+        {
+            Py_DECREF(filesSeq);
+            return false;
+        }
+        files->push_back(RSGISPY_STRING_EXTRACT(o));
+    }
+    Py_DECREF(filesSeq);
+    return true;
+}
+
+static PyObject *ZonalStats_MergeHDF5Files(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("h5_files"), RSGIS_PY_C_TEXT("out_h5_file"),
+                             RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("shuffle"),
+                             RSGIS_PY_C_TEXT("rnd_seed"), RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    PyObject *inputFilesObj;
+    const char *pszOutputH5;
+    int nDataType = 9;
+    int shuffle = false;
+    int seed = 42;
+    unsigned int numThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "Os|ipiI:merge_extracted_hdf5_data_native", kwlist, &inputFilesObj, &pszOutputH5, &nDataType, &shuffle, &seed, &numThreads))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::string> inputFiles;
+    if(!ZonalStats_GetFileList(inputFilesObj, &inputFiles))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "h5_files must be a sequence of file paths");
+        return nullptr;
+    }
+
+    size_t nRows = 0;
+    try
+    {
+        nRows = rsgis::cmds::executeMergeH5Files(inputFiles, std::string(pszOutputH5), (rsgis::RSGISLibDataType)nDataType, shuffle, seed, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    return PyLong_FromSize_t(nRows);
+}
+
+static PyObject *ZonalStats_SplitSampleHDF5Files(PyObject *self, PyObject *args, PyObject *keywds)
+{
+    static char *kwlist[] = {RSGIS_PY_C_TEXT("in_h5_files"), RSGIS_PY_C_TEXT("out_h5_files"),
+                             RSGIS_PY_C_TEXT("n_samples"), RSGIS_PY_C_TEXT("rnd_seed"),
+                             RSGIS_PY_C_TEXT("datatype"), RSGIS_PY_C_TEXT("shuffle"),
+                             RSGIS_PY_C_TEXT("n_threads"), nullptr};
+    PyObject *inputFilesObj;
+    PyObject *outputFilesObj;
+    PyObject *nSamplesObj;
+    int seed = 42;
+    int nDataType = 9;
+    int shuffle = false;
+    unsigned int numThreads = 1;
+
+    if( !PyArg_ParseTupleAndKeywords(args, keywds, "OOO|iipI:split_sample_hdf5_files", kwlist, &inputFilesObj, &outputFilesObj, &nSamplesObj, &seed, &nDataType, &shuffle, &numThreads))
+    {
+        return nullptr;
+    }
+
+    std::vector<std::string> inputFiles;
+    if(!ZonalStats_GetFileList(inputFilesObj, &inputFiles))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "in_h5_files must be a sequence of file paths");
+        return nullptr;
+    }
+    std::vector<std::string> outputFiles;
+    if(!ZonalStats_GetFileList(outputFilesObj, &outputFiles))
+    {
+        PyErr_SetString(GETSTATE(self)->error, "out_h5_files must be a sequence of file paths");
+        return nullptr;
+    }
+
+    std::vector<size_t> nSamples;
+    int remainOut = -1;
+    PyObject *samplesSeq = PySequence_Fast(nSamplesObj, "");
+    if(samplesSeq == nullptr)
+    {
+        PyErr_SetString(GETSTATE(self)->error, "n_samples must be a sequence of integers");
+        return nullptr;
+    }
+    for(Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(samplesSeq); ++i)
+    {
+        PyObject *o = PySequence_Fast_GET_ITEM(samplesSeq, i);
+        if((o == Py_None) && (remainOut < 0))
+        {
+            remainOut = i;
+            nSamples.push_back(0);
+        }
+        else if(RSGISPY_CHECK_INT(o) && (RSGISPY_INT_EXTRACT(o) >= 0))
+        {
+            nSamples.push_back(RSGISPY_INT_EXTRACT(o));
+        }
+        else
+        {
+            Py_DECREF(samplesSeq);
+            PyErr_SetString(GETSTATE(self)->error, "n_samples must be a sequence of non-negative integers, with at most one None for the remaining samples");
+            return nullptr;
+        }
+    }
+    Py_DECREF(samplesSeq);
+
+    std::vector<size_t> outNumRows;
+    try
+    {
+        outNumRows = rsgis::cmds::executeSplitH5Files(inputFiles, outputFiles, nSamples, remainOut, seed, (rsgis::RSGISLibDataType)nDataType, shuffle, numThreads);
+    }
+    catch(rsgis::cmds::RSGISCmdException &e)
+    {
+        PyErr_SetString(GETSTATE(self)->error, e.what());
+        return nullptr;
+    }
+
+    PyObject *pOutList = PyList_New(outNumRows.size());
+    for(size_t k = 0; k < outNumRows.size(); ++k)
+    {
+        PyList_SetItem(pOutList, k, PyLong_FromSize_t(outNumRows.at(k)));
+    }
+    return pOutList;
+}
+
 
 // Our list of functions in this module
 static PyMethodDef ZonalStatsMethods[] = {
@@ -323,20 +832,44 @@ static PyMethodDef ZonalStatsMethods[] = {
 "   rsgislib.zonalstats.extract_zone_img_band_values_to_hdf(fileInfo, 'ClassMask.kea', 'ForestRefl.h5', 1.0)\n"
 "\n\n"},
 
+{"extract_zone_img_band_values", (PyCFunction)ZonalStats_ExtractZoneImageBandValues, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.zonalstats.extract_zone_img_band_values(in_img_info, in_msk_img, mask_val)\n"
+"Extract the all the pixel values for raster regions into memory (1 column for each image band),\n"
+"rather than writing them to a HDF5 file as extract_zone_img_band_values_to_hdf does.\n"
+"Multiple input rasters can be provided and the bands extracted selected.\n"
+"\n"
+":param in_img_info: is a list of rsgislib::imageutils::ImageBandInfo objects with the file names and list of image bands within that file to be extracted.\n"
+":param in_msk_img: is a string containing the name and path of the input image mask file; the mask file must have only 1 image band.\n"
+":param mask_val: is a float containing the value of the pixel within the mask for which values are to be extracted\n"
+":return: a 2D (n pixels x n bands) float32 memoryview, use numpy.asarray to access as a numpy array without a copy.\n"
+"\n"
+".. code:: python\n"
+"\n"
+"   import numpy\n"
+"   import rsgislib.zonalstats\n"
+"   import rsgislib.imageutils\n"
+"   fileInfo = []\n"
+"   fileInfo.append(rsgislib.imageutils.ImageBandInfo('InputImg1.kea', 'Image1', [1,3,4]))\n"
+"   fileInfo.append(rsgislib.imageutils.ImageBandInfo('InputImg2.kea', 'Image2', [2]))\n"
+"   pxl_vals = numpy.asarray(rsgislib.zonalstats.extract_zone_img_band_values(fileInfo, 'ClassMask.kea', 1.0))\n"
+"\n\n"},
+
 {"random_sample_hdf5_file", (PyCFunction)ZonalStats_RandomSampleHDF5File, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.zonalstats.random_sample_hdf5_file(in_h5_file, out_h5_file, sample, rnd_seed, datatype)\n"
-"A function which randomly samples a HDF5 of extracted values.\n"
+"rsgislib.zonalstats.random_sample_hdf5_file(in_h5_file, out_h5_file, sample, rnd_seed, datatype, shuffle=False)\n"
+"A function which randomly samples a HDF5 of extracted values. The sample is taken without\n"
+"replacement in a single pass over the input file, reading only the blocks of rows with selected rows.\n"
 "\n"
 ":param in_h5_file: is a string with the path to the input file.\n"
 ":param out_h5_file: is a string with the path to the output file.\n"
 ":param sample: is an integer with the number values to be sampled from the input file.\n"
 ":param rnd_seed: is an integer which seeds the random number generator.\n"
 ":param datatype: is a rsgislib.TYPE_* value providing the data type of the output image.\n"
+":param shuffle: if True the rows of the output are shuffled, otherwise they are in the input order.\n"
 "\n\n"
 },
 
 {"split_sample_hdf5_file", (PyCFunction)ZonalStats_SplitSampleHDF5File, METH_VARARGS | METH_KEYWORDS,
-"rsgislib.zonalstats.split_sample_hdf5_file(in_h5_file, out_h5_p1_file, out_h5_p2_file, sample, rnd_seed, datatype)\n"
+"rsgislib.zonalstats.split_sample_hdf5_file(in_h5_file, out_h5_p1_file, out_h5_p2_file, sample, rnd_seed, datatype, shuffle=False)\n"
 "A function which splits samples a HDF5 of extracted values.\n"
 "\n"
 ":param in_h5_file: is a string with the path to the input file.\n"
@@ -345,6 +878,157 @@ static PyMethodDef ZonalStatsMethods[] = {
 ":param sample: is an integer with the number values to be sampled from the input file.\n"
 ":param rnd_seed: is an integer which seeds the random number generator.\n"
 ":param datatype: is a rsgislib.TYPE_* value providing the data type of the output image.\n"
+":param shuffle: if True the rows of the outputs are shuffled, otherwise they are in the input order.\n"
+"\n\n"
+},
+
+{"merge_extracted_hdf5_data_native", (PyCFunction)ZonalStats_MergeHDF5Files, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.zonalstats.merge_extracted_hdf5_data_native(h5_files, out_h5_file, datatype=rsgislib.TYPE_32FLOAT, shuffle=False, rnd_seed=42, n_threads=1)\n"
+"Merges the rows of a set of HDF5 files of extracted values (which must have the same number of variables),\n"
+"a block of rows at a time. Use rsgislib.zonalstats.merge_extracted_hdf5_data rather than calling directly.\n"
+"\n"
+":param h5_files: a list of input HDF5 files.\n"
+":param out_h5_file: the output HDF5 file.\n"
+":param datatype: is a rsgislib.TYPE_* value providing the data type of the output file.\n"
+":param shuffle: if True the rows of the output are block shuffled (blocks of rows are read in a\n"
+"                random order and the rows within a window of blocks are shuffled).\n"
+":param rnd_seed: is an integer which seeds the random number generator used for shuffling.\n"
+":param n_threads: the number of threads used to shuffle the rows (0 uses the number of cores).\n"
+":return: the number of rows within the output file.\n"
+"\n\n"
+},
+
+{"split_sample_hdf5_files", (PyCFunction)ZonalStats_SplitSampleHDF5Files, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.zonalstats.split_sample_hdf5_files(in_h5_files, out_h5_files, n_samples, rnd_seed=42, datatype=rsgislib.TYPE_32FLOAT, shuffle=False, n_threads=1)\n"
+"Randomly splits the rows of a set of HDF5 files of extracted values into a number of outputs\n"
+"(e.g., training, validation and testing) in a single pass over the input files, without replacement.\n"
+"\n"
+":param in_h5_files: a list of input HDF5 files, which are treated as a single set of rows.\n"
+":param out_h5_files: a list of output HDF5 files.\n"
+":param n_samples: a list with the number of rows for each output. One value can be None, in which\n"
+"                  case that output receives all the rows not within the other outputs; otherwise\n"
+"                  the rows not within an output are discarded.\n"
+":param rnd_seed: is an integer which seeds the random number generator.\n"
+":param datatype: is a rsgislib.TYPE_* value providing the data type of the output files.\n"
+":param shuffle: if True the rows of the outputs are block shuffled, otherwise they are in the input order.\n"
+":param n_threads: the number of threads used to shuffle the rows (0 uses the number of cores).\n"
+":return: a list with the number of rows within each output.\n"
+"\n"
+".. code:: python\n"
+"\n"
+"   import rsgislib.zonalstats\n"
+"   n_rows = rsgislib.zonalstats.split_sample_hdf5_files(['cls_a_1.h5', 'cls_a_2.h5'], ['cls_a_test.h5', 'cls_a_valid.h5', 'cls_a_train.h5'], [500, 500, None], rnd_seed=42)\n"
+"\n\n"
+},
+
+{"calc_zonal_band_stats_native", (PyCFunction)ZonalStats_CalcZonalBandStats, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.zonalstats.calc_zonal_band_stats_native(vec_file, vec_lyr, input_img, img_band, min_thres, max_thres, out_no_data_val, min_field=None, max_field=None, mean_field=None, stddev_field=None, sum_field=None, count_field=None, mode_field=None, median_field=None, n_threads=1)\n"
+"Calculates zonal statistics for an image band for all the polygons of a vector layer in a single\n"
+"pass over the image, where a pixel is within a polygon if its centre is within the polygon\n"
+"(as gdal.RasterizeLayer). The statistics are written to the layer, creating the fields if needed.\n"
+"Use rsgislib.zonalstats.calc_zonal_band_stats_file, which checks the projections, rather than calling directly.\n"
+"\n"
+":param vec_file: is a string containing the vector file path (opened for update).\n"
+":param vec_lyr: is a string containing the name of the vector layer.\n"
+":param input_img: is a string containing the name of the input image (which must not be rotated).\n"
+":param img_band: is the band (starting at 1) for which the stats are calculated; the band no data value is ignored.\n"
+":param min_thres: a lower threshold for values which will be included in the stats calculation.\n"
+":param max_thres: a upper threshold for values which will be included in the stats calculation.\n"
+":param out_no_data_val: output no data value if no valid pixels are within the polygon.\n"
+":param min_field: the name of the field for the min value (None to be ignored).\n"
+":param max_field: the name of the field for the max value (None to be ignored).\n"
+":param mean_field: the name of the field for the mean value (None to be ignored).\n"
+":param stddev_field: the name of the field for the (population) standard deviation (None to be ignored).\n"
+":param sum_field: the name of the field for the sum value (None to be ignored).\n"
+":param count_field: the name of the field for the pixel count (None to be ignored).\n"
+":param mode_field: the name of the field for the mode value (None to be ignored).\n"
+":param median_field: the name of the field for the median value (None to be ignored).\n"
+":param n_threads: the number of threads used to process the rows of the image (0 uses the number of cores).\n"
+":return: the number of features processed.\n"
+"\n\n"
+},
+
+{"sample_pts_band_values_native", (PyCFunction)ZonalStats_SamplePtsBandValues, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.zonalstats.sample_pts_band_values_native(vec_file, vec_lyr, input_img, img_bands, out_fields, min_thres, max_thres, out_no_data_val, sample_method=SAMPLE_NEAREST, win_size=3, reproj_vec=False, vec_def_epsg=0, n_threads=1)\n"
+"Samples image bands at the points (or, for other geometries, the centroids) of a vector layer. The points\n"
+"are sorted by the image tile they fall within so each tile is read once for each band, rather than\n"
+"reading the image for each point. The values are written to the layer in batched transactions.\n"
+"Use rsgislib.zonalstats.sample_pts_band_values_file, which checks the projections, rather than calling directly.\n"
+"\n"
+":param vec_file: is a string containing the vector file path (opened for update).\n"
+":param vec_lyr: is a string containing the name of the vector layer.\n"
+":param input_img: is a string containing the name of the input image.\n"
+":param img_bands: is a list of the bands (starting at 1) to be sampled; the band no data values are ignored.\n"
+":param out_fields: is a list of the output field names (one for each band), which are created if needed.\n"
+":param min_thres: a lower threshold for values which will be included.\n"
+":param max_thres: a upper threshold for values which will be included.\n"
+":param out_no_data_val: output value for points outside the image or without valid pixel values.\n"
+":param sample_method: the rsgislib.zonalstats.SAMPLE_* method: SAMPLE_NEAREST (the pixel containing the point), SAMPLE_BILINEAR or a statistic of the window (SAMPLE_WIN_MEAN, SAMPLE_WIN_MIN, SAMPLE_WIN_MAX, SAMPLE_WIN_MEDIAN, SAMPLE_WIN_STDDEV).\n"
+":param win_size: the size (odd) of the window centred on the pixel containing the point for the window methods.\n"
+":param reproj_vec: if True the points are reprojected to the image projection if the projections are different, otherwise the points must be in the image projection.\n"
+":param vec_def_epsg: an EPSG code for the vector layer if the projection is not well defined (0 to use the layer projection).\n"
+":param n_threads: the number of threads used to sample the points within each tile (0 uses the number of cores).\n"
+":return: the number of features processed.\n"
+"\n\n"
+},
+
+{"sample_img_band_values", (PyCFunction)ZonalStats_SampleImgBandValues, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.zonalstats.sample_img_band_values(input_img, img_bands, x_coords, y_coords, min_thres, max_thres, out_no_data_val, sample_method=SAMPLE_NEAREST, win_size=3, n_threads=1)\n"
+"Samples image bands at a set of points (in the projection of the image), returning the values in memory.\n"
+"The points are sorted by the image tile they fall within so each tile is read once for each band.\n"
+"\n"
+":param input_img: is a string containing the name of the input image.\n"
+":param img_bands: is a list of the bands (starting at 1) to be sampled; the band no data values are ignored.\n"
+":param x_coords: the x coordinates of the points (a sequence or float64 numpy array).\n"
+":param y_coords: the y coordinates of the points (a sequence or float64 numpy array).\n"
+":param min_thres: a lower threshold for values which will be included.\n"
+":param max_thres: a upper threshold for values which will be included.\n"
+":param out_no_data_val: output value for points outside the image or without valid pixel values.\n"
+":param sample_method: the rsgislib.zonalstats.SAMPLE_* method (see sample_pts_band_values_file).\n"
+":param win_size: the size (odd) of the window centred on the pixel containing the point for the window methods.\n"
+":param n_threads: the number of threads used to sample the points within each tile (0 uses the number of cores).\n"
+":return: a float64 memoryview with shape (n_points, n_bands), use numpy.asarray to access as an array without a copy.\n"
+"\n"
+"Example::\n"
+"\n"
+"   import numpy\n"
+"   import rsgislib.zonalstats\n"
+"   vals = numpy.asarray(rsgislib.zonalstats.sample_img_band_values('Image.kea', [1, 2, 3], x_coords, y_coords, 0, 10000, -1, sample_method=rsgislib.zonalstats.SAMPLE_BILINEAR))\n"
+"\n\n"
+},
+
+{"extract_chip_zone_img_band_values_to_hdf_native", (PyCFunction)ZonalStats_ExtractChipZoneImageBandValues2HDF, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.zonalstats.extract_chip_zone_img_band_values_to_hdf_native(in_img_info, in_msk_img, mask_val, chip_size, out_h5_file, datatype=rsgislib.TYPE_32FLOAT, ref_img=None, ref_img_band=1, n_threads=1)\n"
+"Extracts a chip (chip_size x chip_size) of the image bands for each pixel within the mask to a HDF5\n"
+"file (/DATA/DATA with shape (chips, chip_size, chip_size, bands) and, if ref_img is specified, /DATA/REF\n"
+"with shape (chips, chip_size, chip_size)). The image is read in strips, the chips cut in parallel and\n"
+"written a whole compressed chunk at a time. Use rsgislib.zonalstats.extract_chip_zone_image_band_values_to_hdf\n"
+"or extract_ref_chip_zone_image_band_values_to_hdf rather than calling directly.\n"
+"\n"
+":param in_img_info: is a list of rsgislib.imageutils.ImageBandInfo objects specifying the images and bands.\n"
+":param in_msk_img: is a single band image specifying the regions of interest.\n"
+":param mask_val: is the pixel value within the mask specifying the region of interest.\n"
+":param chip_size: is the size of the chips.\n"
+":param out_h5_file: is the output HDF5 file (overwritten if it exists).\n"
+":param datatype: is a rsgislib.TYPE_* value for the output chip values.\n"
+":param ref_img: is an optional reference image (same size as the mask) to also extract chips from (as uint16).\n"
+":param ref_img_band: is the band of the reference image.\n"
+":param n_threads: the number of threads used to cut the chips (0 uses the number of cores).\n"
+":return: the number of chips extracted.\n"
+"\n\n"
+},
+
+{"merge_extracted_hdf5_chip_files_native", (PyCFunction)ZonalStats_MergeChipHDF5Files, METH_VARARGS | METH_KEYWORDS,
+"rsgislib.zonalstats.merge_extracted_hdf5_chip_files_native(h5_files, out_h5_file, datatype=rsgislib.TYPE_32FLOAT, with_ref=False)\n"
+"Merges HDF5 chip files into a single file, copying a chunk of chips at a time rather than loading the\n"
+"files into memory. Use rsgislib.zonalstats.merge_extracted_hdf5_chip_data or merge_extracted_hdf5_chip_ref_data\n"
+"rather than calling directly.\n"
+"\n"
+":param h5_files: is a list of the input files, which must have the same chip size and number of bands.\n"
+":param out_h5_file: is the output file.\n"
+":param datatype: is a rsgislib.TYPE_* value for the output chip values.\n"
+":param with_ref: if True the reference chips (/DATA/REF) are also merged.\n"
+":return: the number of chips in the output file.\n"
 "\n\n"
 },
 
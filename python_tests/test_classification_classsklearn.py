@@ -410,3 +410,111 @@ def test_apply_sklearn_classifier_rat(tmp_path):
         read_out_cls = False
 
     assert read_out_cls
+
+
+@pytest.mark.skipif(SKLEARN_NOT_AVAIL, reason="scikit-learn dependency not available")
+def test_export_sklearn_tree_ensemble(tmp_path):
+    import numpy
+    import rsgislib.classification.classsklearn
+    from sklearn.ensemble import RandomForestClassifier
+
+    rng = numpy.random.default_rng(42)
+    x_data = rng.random((200, 3))
+    y_data = (x_data[:, 0] > 0.5).astype(int) + (x_data[:, 1] > 0.5).astype(int)
+    sk_classifier = RandomForestClassifier(n_estimators=5, max_depth=4)
+    sk_classifier.fit(x_data, y_data)
+
+    out_mdl_file = os.path.join(tmp_path, "out_rf_mdl.txt")
+    rsgislib.classification.classsklearn.export_sklearn_tree_ensemble(
+        sk_classifier, out_mdl_file
+    )
+
+    with open(out_mdl_file) as mdl_file:
+        mdl_lines = mdl_file.read().splitlines()
+    assert mdl_lines[0] == "rsgislib_tree_ensemble"
+    assert "num_classes=3" in mdl_lines
+    assert len([line for line in mdl_lines if line.startswith("Tree=")]) == 5
+
+
+@pytest.mark.skipif(
+    (H5PY_NOT_AVAIL or SKLEARN_NOT_AVAIL),
+    reason="h5py or scikit-learn dependencies not available",
+)
+def test_apply_tree_ensemble_classifier_sklearn(tmp_path):
+    import rsgislib.imageutils
+    import rsgislib.imagecalc
+    import rsgislib.classification
+    import rsgislib.classification.classsklearn
+    from sklearn.ensemble import RandomForestClassifier
+
+    cls_info_dict = dict()
+    for cls_id, cls_name in enumerate(["Forest", "Grass", "Urban", "Water"]):
+        cls_file_base = "cls_{}_smpls_bal".format(cls_name.lower())
+        cls_info_dict[cls_name] = rsgislib.classification.ClassInfoObj(
+            id=cls_id,
+            out_id=cls_id + 1,
+            train_file_h5=os.path.join(
+                CLASSIFICATION_DATA_DIR, "{}_train.h5".format(cls_file_base)
+            ),
+            test_file_h5=os.path.join(
+                CLASSIFICATION_DATA_DIR, "{}_test.h5".format(cls_file_base)
+            ),
+            valid_file_h5=os.path.join(
+                CLASSIFICATION_DATA_DIR, "{}_valid.h5".format(cls_file_base)
+            ),
+            red=120,
+            green=120,
+            blue=120,
+        )
+
+    s2_img = os.path.join(DATA_DIR, "sen2_20210527_aber_subset.kea")
+    s2_vld_img = os.path.join(DATA_DIR, "sen2_20210527_aber_subset_vldmsk.kea")
+
+    img_band_info = []
+    img_band_info.append(
+        rsgislib.imageutils.ImageBandInfo(s2_img, "s2", [1, 2, 3, 4, 5, 6, 7, 8, 9, 10])
+    )
+
+    sk_classifier = RandomForestClassifier(n_estimators=20, random_state=42)
+    rsgislib.classification.classsklearn.train_sklearn_classifier(
+        cls_info_dict, sk_classifier
+    )
+
+    sk_cls_img = os.path.join(tmp_path, "out_sk_cls_img.kea")
+    rsgislib.classification.classsklearn.apply_sklearn_classifier(
+        cls_info_dict,
+        sk_classifier,
+        s2_vld_img,
+        1,
+        img_band_info,
+        sk_cls_img,
+        "KEA",
+        class_clr_names=False,
+    )
+
+    out_mdl_file = os.path.join(tmp_path, "out_rf_mdl.txt")
+    rsgislib.classification.classsklearn.export_sklearn_tree_ensemble(
+        sk_classifier, out_mdl_file
+    )
+    # The class indexes of the model are in the order of sk_classifier.classes_ (the class ids).
+    cls_out_ids = [
+        cls_info_dict[cls_name].out_id
+        for cls_name in sorted(cls_info_dict, key=lambda name: cls_info_dict[name].id)
+    ]
+    native_cls_img = os.path.join(tmp_path, "out_native_cls_img.kea")
+    rsgislib.classification.apply_tree_ensemble_classifier(
+        out_mdl_file,
+        s2_vld_img,
+        1,
+        img_band_info,
+        native_cls_img,
+        gdalformat="KEA",
+        cls_out_ids=cls_out_ids,
+        n_threads=2,
+    )
+
+    img_eq, prop_match = rsgislib.imagecalc.are_img_bands_equal(
+        sk_cls_img, 1, native_cls_img, 1
+    )
+    print(prop_match)
+    assert img_eq
@@ -165,6 +165,26 @@ def test_image_local_minima(tmp_path):
     assert img_eq
 
 
+def test_image_local_minima_resolve_plateaus(tmp_path):
+    import rsgislib.imagemorphology
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber_NDVI_lt5_bin.kea")
+    output_img = os.path.join(tmp_path, "sen2_20210527_aber_imgLocalMinimaPlateaus.kea")
+    rsgislib.imagemorphology.image_local_minima(
+        input_img,
+        output_img,
+        sequencial_out=True,
+        allow_equal=False,
+        morph_op_file="",
+        use_op_file=False,
+        op_size=9,
+        gdalformat="KEA",
+        datatype=rsgislib.TYPE_32UINT,
+        resolve_plateaus=True,
+    )
+    assert os.path.exists(output_img)
+
+
 def test_image_local_minima_combined_out(tmp_path):
     import rsgislib.imagemorphology
     import rsgislib.imagecalc
@@ -226,6 +246,34 @@ def test_image_opening(tmp_path):
     assert img_eq
 
 
+def test_image_opening_scratch_spill(tmp_path):
+    # The scratch memory budget is read once per process, so run in a new
+    # interpreter with a zero budget to force the memory mapped file path.
+    import subprocess
+    import sys
+    import rsgislib.imagecalc
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber_NDVI_lt5_bin.kea")
+    output_img = os.path.join(tmp_path, "sen2_20210527_aber_imgOpening_spill.kea")
+    morph_op_file = os.path.join(DATA_DIR, "CircularOp.gmtxt")
+    script = (
+        "import rsgislib, rsgislib.imagemorphology\n"
+        "rsgislib.imagemorphology.image_opening({!r}, {!r}, '', {!r}, True, 5, "
+        "'KEA', rsgislib.TYPE_8UINT, 1)\n".format(
+            input_img, output_img, morph_op_file
+        )
+    )
+    env = dict(os.environ)
+    env["RSGISLIB_SCRATCH_MEM_MB"] = "0"
+    env["RSGISLIB_SCRATCH_DIR"] = str(tmp_path)
+    subprocess.run([sys.executable, "-c", script], env=env, check=True)
+
+    ref_img = os.path.join(DATA_DIR, "sen2_20210527_aber_imgOpening.kea")
+    img_eq, prop_match = rsgislib.imagecalc.are_imgs_equal(ref_img, output_img)
+    print(prop_match)
+    assert img_eq
+
+
 def test_image_closing(tmp_path):
     import rsgislib.imagemorphology
     import rsgislib.imagecalc
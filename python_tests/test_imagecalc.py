@@ -133,6 +133,85 @@ def test_band_maths_sgl_band(tmp_path):
     assert img_eq
 
 
+def test_band_maths_sgl_band_skip_no_data_blocks(tmp_path):
+    import rsgislib.imagecalc
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    band_def_seq = list()
+    band_def_seq.append(
+        rsgislib.imagecalc.BandDefn(band_name="Blue", input_img=input_img, img_band=1)
+    )
+    output_img = os.path.join(tmp_path, "sen2_20210527_aber_b1_skip.kea")
+    rsgislib.imagecalc.band_math(
+        output_img,
+        "Blue",
+        "KEA",
+        rsgislib.TYPE_16UINT,
+        band_defs=band_def_seq,
+        skip_no_data_blocks=True,
+        no_data_val=0,
+    )
+
+    img_eq, prop_match = rsgislib.imagecalc.are_img_bands_equal(
+        input_img, 1, output_img, 1
+    )
+    assert img_eq
+
+
+def test_band_maths_skip_no_data_blocks_diagonal(tmp_path, capfd):
+    import re
+    import numpy
+    from osgeo import gdal
+    import rsgislib.imagecalc
+
+    # A tiled image where a diagonal swath is no data, so few rows of blocks are empty.
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    in_ds = gdal.Open(input_img)
+    arr = in_ds.GetRasterBand(1).ReadAsArray().astype(numpy.float32)
+    y_idxs, x_idxs = numpy.indices(arr.shape)
+    arr[numpy.abs(x_idxs - y_idxs) > 200] = 0
+    diag_img = os.path.join(tmp_path, "diag_img.tif")
+    diag_ds = gdal.GetDriverByName("GTiff").Create(
+        diag_img,
+        arr.shape[1],
+        arr.shape[0],
+        1,
+        gdal.GDT_Float32,
+        options=["TILED=YES", "BLOCKXSIZE=64", "BLOCKYSIZE=64"],
+    )
+    diag_ds.SetGeoTransform(in_ds.GetGeoTransform())
+    diag_ds.SetProjection(in_ds.GetProjection())
+    diag_ds.GetRasterBand(1).SetNoDataValue(0)
+    diag_ds.GetRasterBand(1).WriteArray(arr)
+    diag_ds = None
+    in_ds = None
+
+    band_def_seq = [
+        rsgislib.imagecalc.BandDefn(band_name="Blue", input_img=diag_img, img_band=1)
+    ]
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    rsgislib.imagecalc.band_math(
+        output_img, "Blue*2", "KEA", rsgislib.TYPE_32FLOAT, band_defs=band_def_seq
+    )
+    output_skip_img = os.path.join(tmp_path, "out_skip_img.kea")
+    capfd.readouterr()
+    rsgislib.imagecalc.band_math(
+        output_skip_img,
+        "Blue*2",
+        "KEA",
+        rsgislib.TYPE_32FLOAT,
+        band_defs=band_def_seq,
+        skip_no_data_blocks=True,
+        no_data_val=0,
+    )
+    out, err = capfd.readouterr()
+    n_skipped = int(re.search(r"Skipped (\d+) of (\d+) blocks", out).group(1))
+    assert n_skipped > 0
+
+    img_eq, prop_match = rsgislib.imagecalc.are_imgs_equal(output_img, output_skip_img)
+    assert img_eq
+
+
 def test_band_maths_multi_band(tmp_path):
     import rsgislib.imagecalc
 
@@ -678,6 +757,38 @@ def test_kmeans_clustering(tmp_path):
     assert os.path.exists(out_ext_file)
 
 
+def test_kmeans_clustering_reservoir(tmp_path):
+    import rsgislib.imagecalc
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    # The same seed must give the same sample, and so the same cluster centres.
+    out_ext_files = []
+    for i in range(2):
+        out_file = os.path.join(tmp_path, "out_file_{}".format(i))
+        rsgislib.imagecalc.kmeans_clustering(
+            input_img,
+            out_file,
+            10,
+            20,
+            1,
+            True,
+            0.0025,
+            rsgislib.INITCLUSTER_DIAGONAL_FULL_ATTACH,
+            sample_method=rsgislib.PXL_SAMPLE_RESERVOIR,
+            n_samples=5000,
+            rnd_seed=42,
+        )
+        out_ext_file = "{}.gmtxt".format(out_file)
+        assert os.path.exists(out_ext_file)
+        out_ext_files.append(out_ext_file)
+
+    with open(out_ext_files[0], "r") as f:
+        centres_1 = f.read()
+    with open(out_ext_files[1], "r") as f:
+        centres_2 = f.read()
+    assert centres_1 == centres_2
+
+
 def test_isodata_clustering(tmp_path):
     import rsgislib.imagecalc
 
@@ -867,6 +978,22 @@ def test_calculate_img_band_rmse():
     rsgislib.imagecalc.calculate_img_band_rmse(input_img, 1, input_img, 2)
 
 
+def test_calc_img_band_pair_stats():
+    import rsgislib.imagecalc
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber_subset.kea")
+    pair_stats = rsgislib.imagecalc.calc_img_band_pair_stats(
+        input_img, 1, input_img, 2, n_threads=2
+    )
+    rmse = rsgislib.imagecalc.calculate_img_band_rmse(input_img, 0, input_img, 1)[0]
+    assert pair_stats["rmse"] == pytest.approx(rmse)
+
+    same_stats = rsgislib.imagecalc.calc_img_band_pair_stats(input_img, 1, input_img, 1)
+    assert same_stats["rmse"] == pytest.approx(0.0)
+    assert same_stats["correlation"] == pytest.approx(1.0)
+    assert same_stats["covariance"] == pytest.approx(same_stats["var_a"])
+
+
 def test_correlation_window(tmp_path):
     import rsgislib.imagecalc
 
@@ -921,6 +1048,22 @@ def test_get_histogram():
     rsgislib.imagecalc.get_histogram(input_img, 1, 1, True, 0, 0)
 
 
+def test_get_histogram_as_array():
+    import numpy
+    import rsgislib.imagecalc
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber_subset.kea")
+    bins, min_val, max_val = rsgislib.imagecalc.get_histogram(
+        input_img, 1, 1, True, 0, 0
+    )
+    assert isinstance(bins, tuple)
+    arr_bins, arr_min_val, arr_max_val = rsgislib.imagecalc.get_histogram(
+        input_img, 1, 1, True, 0, 0, as_array=True
+    )
+    assert (arr_min_val == min_val) and (arr_max_val == max_val)
+    assert numpy.asarray(arr_bins).tolist() == list(bins)
+
+
 def test_get_2d_img_histogram(tmp_path):
     import rsgislib.imagecalc
 
@@ -1038,3 +1181,106 @@ def test_mahalanobis_dist_to_img_filter(tmp_path):
         input_img, output_img, 5, "KEA", rsgislib.TYPE_32FLOAT
     )
     assert os.path.exists(output_img)
+
+
+def _create_bayes_test_img(output_img, vals):
+    from osgeo import gdal
+
+    in_ds = gdal.Open(os.path.join(DATA_DIR, "sen2_20210527_aber.kea"))
+    out_ds = gdal.GetDriverByName("GTiff").Create(
+        output_img, vals.shape[1], vals.shape[0], 1, gdal.GDT_Float32
+    )
+    out_ds.SetGeoTransform(in_ds.GetGeoTransform())
+    out_ds.SetProjection(in_ds.GetProjection())
+    out_ds.GetRasterBand(1).WriteArray(vals)
+    out_ds = None
+    in_ds = None
+
+
+def _read_bayes_test_img(input_img):
+    from osgeo import gdal
+
+    img_ds = gdal.Open(input_img)
+    arr = img_ds.ReadAsArray()
+    img_ds = None
+    return arr
+
+
+@pytest.mark.parametrize("max_cache_entries", [1048576, 5])
+def test_calc_bayesian_posterior_stats_cache(tmp_path, max_cache_entries):
+    import numpy
+    import rsgislib.imagecalc
+
+    # Values repeat, so most pixels are read from the cache unless the
+    # cache is limited to a few entries.
+    rng = numpy.random.default_rng(42)
+    vals = (rng.integers(0, 40, size=(32, 32)) * 0.5).astype(numpy.float32)
+    input_img = os.path.join(tmp_path, "in_vals.tif")
+    _create_bayes_test_img(input_img, vals)
+
+    out_imgs = dict()
+    for use_cache in [False, True]:
+        out_imgs[use_cache] = os.path.join(tmp_path, f"out_cache_{use_cache}.kea")
+        rsgislib.imagecalc.calc_bayesian_posterior_stats(
+            input_img,
+            out_imgs[use_cache],
+            "KEA",
+            "x*2",
+            variance=0.5,
+            interval=0.01,
+            min_val=0,
+            max_val=10,
+            use_cache=use_cache,
+            max_cache_entries=max_cache_entries,
+        )
+    assert numpy.array_equal(
+        _read_bayes_test_img(out_imgs[False]), _read_bayes_test_img(out_imgs[True])
+    )
+
+
+def test_calc_bayesian_posterior_stats_cache_tol(tmp_path):
+    import numpy
+    import rsgislib.imagecalc
+
+    cache_tol = 0.25
+    rng = numpy.random.default_rng(42)
+    vals = (rng.random((32, 32)) * 20).astype(numpy.float32)
+    input_img = os.path.join(tmp_path, "in_vals.tif")
+    _create_bayes_test_img(input_img, vals)
+
+    # With a tolerance the posterior is calculated at the bin centre, so
+    # should match the uncached result for the binned values.
+    binned_vals = (
+        numpy.floor((vals.astype(numpy.float64) / cache_tol) + 0.5) * cache_tol
+    ).astype(numpy.float32)
+    binned_img = os.path.join(tmp_path, "in_binned_vals.tif")
+    _create_bayes_test_img(binned_img, binned_vals)
+
+    output_img = os.path.join(tmp_path, "out_cache_tol.kea")
+    rsgislib.imagecalc.calc_bayesian_posterior_stats(
+        input_img,
+        output_img,
+        "KEA",
+        "x*2",
+        variance=0.5,
+        interval=0.01,
+        min_val=0,
+        max_val=10,
+        use_cache=True,
+        cache_tol=cache_tol,
+    )
+    output_binned_img = os.path.join(tmp_path, "out_binned_no_cache.kea")
+    rsgislib.imagecalc.calc_bayesian_posterior_stats(
+        binned_img,
+        output_binned_img,
+        "KEA",
+        "x*2",
+        variance=0.5,
+        interval=0.01,
+        min_val=0,
+        max_val=10,
+        use_cache=False,
+    )
+    assert numpy.array_equal(
+        _read_bayes_test_img(output_img), _read_bayes_test_img(output_binned_img)
+    )
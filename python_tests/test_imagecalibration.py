@@ -0,0 +1,59 @@
+import os
+import pytest
+
+DATA_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "data")
+
+
+def _create_cloud_mask(cloud_msk_img, n_rows, n_cols):
+    import numpy
+    from osgeo import gdal
+
+    # Random blobs of cloud, with some touching the first/last rows and
+    # straddling the strip boundaries so the halo rows are exercised.
+    rng = numpy.random.default_rng(42)
+    arr = (rng.random((n_rows, n_cols)) > 0.85).astype(numpy.uint8)
+    y_idxs, x_idxs = numpy.indices(arr.shape)
+    for y_c in [0, 5, 255, 256, 512, 700, n_rows - 3, n_rows - 1]:
+        x_c = rng.integers(0, n_cols)
+        arr[((y_idxs - y_c) ** 2 + (x_idxs - x_c) ** 2) < 12**2] = 1
+
+    in_ds = gdal.Open(os.path.join(DATA_DIR, "sen2_20210527_aber.kea"))
+    geo_trans = in_ds.GetGeoTransform()
+    proj_wkt = in_ds.GetProjection()
+    in_ds = None
+
+    # A striped image so the rows are not a multiple of the strip height.
+    msk_ds = gdal.GetDriverByName("GTiff").Create(
+        cloud_msk_img, n_cols, n_rows, 1, gdal.GDT_Byte
+    )
+    msk_ds.SetGeoTransform(geo_trans)
+    msk_ds.SetProjection(proj_wkt)
+    msk_ds.GetRasterBand(1).WriteArray(arr)
+    msk_ds = None
+
+
+@pytest.mark.parametrize("n_threads", [2, 4, 0])
+def test_apply_cloud_majority_filter_strips(tmp_path, n_threads):
+    import rsgislib.imagecalc
+    import rsgislib.imagecalibration
+
+    cloud_msk_img = os.path.join(tmp_path, "cloud_msk.tif")
+    _create_cloud_mask(cloud_msk_img, 947, 300)
+
+    output_img = os.path.join(tmp_path, "cloud_msk_filt.kea")
+    rsgislib.imagecalibration.apply_cloud_majority_filter(
+        cloud_msk_img, output_img, gdalformat="KEA", win_size=5, n_threads=1
+    )
+    output_strips_img = os.path.join(tmp_path, "cloud_msk_filt_strips.kea")
+    rsgislib.imagecalibration.apply_cloud_majority_filter(
+        cloud_msk_img,
+        output_strips_img,
+        gdalformat="KEA",
+        win_size=5,
+        n_threads=n_threads,
+    )
+
+    img_eq, prop_match = rsgislib.imagecalc.are_imgs_equal(
+        output_img, output_strips_img
+    )
+    assert img_eq
@@ -26,6 +26,30 @@ def test_find_image_offset():
     assert abs((x_off - 3) < 0.5) and abs((y_off - 3) < 0.5)
 
 
+def test_find_image_offset_pyramid():
+    import rsgislib.imageregistration
+
+    in_ref_img = os.path.join(DATA_DIR, "sen2_20210527_aber_subset_b123.kea")
+    in_float_img = os.path.join(
+        IMGREG_DATA_DIR, "sen2_20210527_aber_subset_b123_offset.kea"
+    )
+    x_off, y_off = rsgislib.imageregistration.find_image_offset(
+        in_ref_img,
+        in_float_img,
+        [1, 2, 3],
+        [1, 2, 3],
+        rsgislib.imageregistration.METRIC_CORELATION,
+        16,
+        16,
+        4,
+        n_pyramid_levels=3,
+        use_phase_corr=True,
+    )
+    print("x_off: {}".format(x_off))
+    print("y_off: {}".format(y_off))
+    assert abs(x_off - 3) < 0.5 and abs(y_off - 3) < 0.5
+
+
 def test_apply_offset_to_image(tmp_path):
     import rsgislib.imageregistration
 
@@ -126,3 +150,52 @@ def test_warp_with_gcps_with_gdal(tmp_path):
         poly_order=2,
         use_multi_thread=False,
     )
+
+
+def test_warp_with_gcps_poly(tmp_path):
+    import rsgislib.imageregistration
+    import rsgislib.imageutils
+
+    in_ref_img = os.path.join(DATA_DIR, "sen2_20210527_aber_subset_b123.kea")
+    in_process_img = os.path.join(
+        IMGREG_DATA_DIR, "sen2_20210527_aber_subset_b123_offset.kea"
+    )
+    in_gcp_file = os.path.join(IMGREG_DATA_DIR, "reg_gcps.txt")
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    rsgislib.imageregistration.warp_with_gcps(
+        in_ref_img,
+        in_process_img,
+        in_gcp_file,
+        output_img,
+        "KEA",
+        rsgislib.TYPE_16UINT,
+        rsgislib.INTERP_CUBIC,
+        use_tps=False,
+        poly_order=2,
+    )
+    assert os.path.exists(output_img) and rsgislib.imageutils.do_img_res_match(
+        in_ref_img, output_img
+    )
+
+
+def test_warp_with_gcps_tps(tmp_path):
+    import rsgislib.imageregistration
+
+    in_ref_img = os.path.join(DATA_DIR, "sen2_20210527_aber_subset_b123.kea")
+    in_process_img = os.path.join(
+        IMGREG_DATA_DIR, "sen2_20210527_aber_subset_b123_offset.kea"
+    )
+    in_gcp_file = os.path.join(IMGREG_DATA_DIR, "reg_gcps.txt")
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    rsgislib.imageregistration.warp_with_gcps(
+        in_ref_img,
+        in_process_img,
+        in_gcp_file,
+        output_img,
+        "KEA",
+        rsgislib.TYPE_16UINT,
+        rsgislib.INTERP_BILINEAR,
+        use_tps=True,
+        grid_step=8,
+    )
+    assert os.path.exists(output_img)
@@ -1,5 +1,6 @@
 import os
 import pytest
+import rsgislib
 from shutil import copy2
 
 GEOPANDAS_NOT_AVAIL = False
@@ -501,6 +502,129 @@ def test_resample_img_to_match(tmp_path):
     assert os.path.exists(output_img)
 
 
+def test_resample_img_to_match_native(tmp_path):
+    import rsgislib.imageutils
+
+    input_utm_img = os.path.join(DATA_DIR, "sen2_20210527_aber_utm30n.kea")
+    input_osgb_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+
+    output_img = os.path.join(tmp_path, "output_img.kea")
+    rsgislib.imageutils.resample_img_to_match(
+        input_utm_img,
+        input_osgb_img,
+        output_img,
+        "KEA",
+        interp_method=rsgislib.INTERP_BILINEAR,
+        use_native=True,
+    )
+
+    assert rsgislib.imageutils.get_img_size(
+        output_img
+    ) == rsgislib.imageutils.get_img_size(input_utm_img)
+
+
+def test_resample_imgs_to_match(tmp_path):
+    import rsgislib.imageutils
+
+    input_utm_img = os.path.join(DATA_DIR, "sen2_20210527_aber_utm30n.kea")
+    input_osgb_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+
+    output_imgs = [
+        os.path.join(tmp_path, "output_bilinear_img_1.kea"),
+        os.path.join(tmp_path, "output_bilinear_img_2.kea"),
+    ]
+    rsgislib.imageutils.resample_imgs_to_match(
+        input_utm_img,
+        [input_osgb_img, input_osgb_img],
+        output_imgs,
+        "KEA",
+        interp_method=rsgislib.INTERP_BILINEAR,
+        n_threads=2,
+    )
+    for output_img in output_imgs:
+        assert os.path.exists(output_img)
+        assert rsgislib.imageutils.get_img_size(
+            output_img
+        ) == rsgislib.imageutils.get_img_size(input_utm_img)
+
+
+@pytest.mark.parametrize(
+    "interp_method, resample_alg, out_res, in_img_name",
+    [
+        (rsgislib.INTERP_NEAREST_NEIGHBOUR, "near", 10, "sen2_20210527_aber.kea"),
+        (rsgislib.INTERP_BILINEAR, "bilinear", 10, "sen2_20210527_aber.kea"),
+        (rsgislib.INTERP_CUBIC, "cubic", 10, "sen2_20210527_aber.kea"),
+        (rsgislib.INTERP_AVERAGE, "average", 30, "sen2_20210527_aber.kea"),
+        (rsgislib.INTERP_MODE, "mode", 30, "sen2_20210527_aber_cls.kea"),
+    ],
+)
+def test_resample_imgs_to_match_gdal_warp(
+    tmp_path, interp_method, resample_alg, out_res, in_img_name
+):
+    import numpy
+    from osgeo import gdal
+    import rsgislib.imageutils
+
+    input_utm_img = os.path.join(DATA_DIR, "sen2_20210527_aber_utm30n.kea")
+    input_img = os.path.join(DATA_DIR, in_img_name)
+
+    # The average and mode are compared when downsampling, onto a coarser UTM grid.
+    ref_img = os.path.join(tmp_path, "ref_img.tif")
+    gdal.Translate(ref_img, input_utm_img, bandList=[1], xRes=out_res, yRes=out_res)
+    ref_ds = gdal.Open(ref_img)
+    geo_trans = ref_ds.GetGeoTransform()
+    x_size = ref_ds.RasterXSize
+    y_size = ref_ds.RasterYSize
+    ref_wkt = ref_ds.GetProjection()
+    ref_ds = None
+
+    output_img = os.path.join(tmp_path, "output_img.kea")
+    rsgislib.imageutils.resample_imgs_to_match(
+        ref_img, [input_img], [output_img], "KEA", interp_method=interp_method
+    )
+    gdal_img = os.path.join(tmp_path, "gdal_img.kea")
+    gdal.Warp(
+        gdal_img,
+        input_img,
+        format="KEA",
+        outputBounds=[
+            geo_trans[0],
+            geo_trans[3] + (y_size * geo_trans[5]),
+            geo_trans[0] + (x_size * geo_trans[1]),
+            geo_trans[3],
+        ],
+        width=x_size,
+        height=y_size,
+        dstSRS=ref_wkt,
+        resampleAlg=resample_alg,
+    )
+
+    out_ds = gdal.Open(output_img)
+    gdal_ds = gdal.Open(gdal_img)
+    assert out_ds.RasterCount == gdal_ds.RasterCount
+    for band in range(1, out_ds.RasterCount + 1):
+        out_arr = out_ds.GetRasterBand(band).ReadAsArray().astype(float)
+        gdal_arr = gdal_ds.GetRasterBand(band).ReadAsArray().astype(float)
+        # Only the pixels with data in both are compared, as the edges of the image differ.
+        vld_msk = (out_arr != 0) & (gdal_arr != 0)
+        assert vld_msk.sum() > (0.5 * x_size * y_size)
+        out_vals = out_arr[vld_msk]
+        gdal_vals = gdal_arr[vld_msk]
+        if resample_alg in ["near", "mode"]:
+            # Pixels on the boundary between source pixels (or with a tie
+            # for the mode) may be assigned differently.
+            min_same = 0.98 if resample_alg == "near" else 0.85
+            assert (out_vals == gdal_vals).mean() >= min_same
+        else:
+            # GDAL weights the average by the area of each source pixel
+            # within the output pixel rather than using the pixel centres.
+            max_diff = 0.01 if resample_alg != "average" else 0.05
+            mean_diff = numpy.abs(out_vals - gdal_vals).mean()
+            assert mean_diff <= (max_diff * gdal_vals.mean())
+    out_ds = None
+    gdal_ds = None
+
+
 def test_reproject_image(tmp_path):
     import rsgislib.imageutils
 
@@ -701,6 +825,54 @@ def test_create_tiles_multi_core_outpath_exp(tmp_path):
         )
 
 
+def test_plan_img_tiles():
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    x_size, y_size = rsgislib.imageutils.get_img_size(input_img)
+    tiles = rsgislib.imageutils.plan_img_tiles(input_img, 200, 200)
+    assert len(tiles) == 25
+    assert sum([tile["n_valid"] for tile in tiles]) == x_size * y_size
+
+    tiles = rsgislib.imageutils.plan_img_tiles(
+        input_img, 200, 200, valid_thres=0.5, no_data_val=0, n_threads=2
+    )
+    assert 0 < len(tiles) <= 25
+    for tile in tiles:
+        x_min, x_max, y_min, y_max = tile["bbox"]
+        assert 0 <= x_min < x_max <= x_size
+        assert 0 <= y_min < y_max <= y_size
+        assert tile["n_valid"] / ((x_max - x_min) * (y_max - y_min)) >= 0.5
+
+
+def test_create_img_tiles(tmp_path):
+    import rsgislib
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    out_tiles_img = os.path.join(tmp_path, "tiles.kea")
+    tiles = rsgislib.imageutils.plan_img_tiles(
+        input_img,
+        150,
+        150,
+        valid_thres=0.3,
+        offset=True,
+        no_data_val=0,
+        shrink_to_valid=True,
+        out_tiles_img=out_tiles_img,
+    )
+    out_img_base = os.path.join(tmp_path, "out_img")
+    out_imgs = rsgislib.imageutils.create_img_tiles(
+        input_img, tiles, out_img_base, "kea", "KEA", rsgislib.TYPE_16UINT, n_threads=2
+    )
+    assert len(out_imgs) == len(tiles)
+    for tile, out_img in zip(tiles, out_imgs):
+        x_min, x_max, y_min, y_max = tile["bbox"]
+        assert os.path.exists(out_img)
+        assert rsgislib.imageutils.get_img_size(out_img) == (x_max - x_min, y_max - y_min)
+    assert os.path.exists(out_tiles_img)
+
+
 def test_stretch_img(tmp_path):
     import rsgislib
     import rsgislib.imageutils
@@ -840,6 +1012,62 @@ def test_mask_img(tmp_path):
     assert os.path.exists(output_img)
 
 
+def test_relabel_pxl_vals(tmp_path):
+    import rsgislib.imageutils
+    import rsgislib.imagecalc
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber_vldmsk.kea")
+
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    rsgislib.imageutils.relabel_pxl_vals(
+        input_img, output_img, "KEA", rsgislib.TYPE_8UINT, lut={0: 5, 1: 7}
+    )
+
+    band_defs = [
+        rsgislib.imagecalc.BandDefn(band_name="vld", input_img=input_img, img_band=1)
+    ]
+    ref_img = os.path.join(tmp_path, "ref_img.kea")
+    rsgislib.imagecalc.band_math(
+        ref_img, "vld==1?7:vld==0?5:vld", "KEA", rsgislib.TYPE_8UINT, band_defs
+    )
+
+    img_eq, prop_match = rsgislib.imagecalc.are_img_bands_equal(
+        ref_img, 1, output_img, 1
+    )
+    assert img_eq
+
+
+def test_relabel_pxl_vals_sparse(tmp_path):
+    import rsgislib.imageutils
+    import rsgislib.imagecalc
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber_vldmsk.kea")
+
+    # The LUT values are widely spaced so the hash table, rather than the
+    # dense array, is used.
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    rsgislib.imageutils.relabel_pxl_vals(
+        input_img,
+        output_img,
+        "KEA",
+        rsgislib.TYPE_8UINT,
+        lut={0: 5, 1: 7, 16000000: 9},
+    )
+
+    band_defs = [
+        rsgislib.imagecalc.BandDefn(band_name="vld", input_img=input_img, img_band=1)
+    ]
+    ref_img = os.path.join(tmp_path, "ref_img.kea")
+    rsgislib.imagecalc.band_math(
+        ref_img, "vld==1?7:vld==0?5:vld", "KEA", rsgislib.TYPE_8UINT, band_defs
+    )
+
+    img_eq, prop_match = rsgislib.imagecalc.are_img_bands_equal(
+        ref_img, 1, output_img, 1
+    )
+    assert img_eq
+
+
 def test_gen_finite_mask(tmp_path):
     import rsgislib.imageutils
 
@@ -862,6 +1090,70 @@ def test_gen_valid_mask(tmp_path):
     assert os.path.exists(output_img)
 
 
+def test_gen_multi_img_valid_masks(tmp_path):
+    import rsgislib.imageutils
+
+    input_imgs = [
+        os.path.join(DATA_DIR, "sen2_20210527_aber.kea"),
+        os.path.join(DATA_DIR, "sen2_20210527_aber_subset.kea"),
+    ]
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    out_packed_img = os.path.join(tmp_path, "out_packed_img.kea")
+    rsgislib.imageutils.gen_multi_img_valid_masks(
+        input_imgs,
+        output_img,
+        gdalformat="KEA",
+        out_packed_img=out_packed_img,
+        no_data_val=0.0,
+    )
+
+    assert (
+        os.path.exists(output_img)
+        and os.path.exists(out_packed_img)
+        and (rsgislib.imageutils.get_img_band_count(output_img) == 5)
+    )
+
+
+def test_gen_multi_img_valid_masks_nan_no_data(tmp_path):
+    import numpy
+    from osgeo import gdal
+    import rsgislib.imageutils
+
+    in_ds = gdal.Open(os.path.join(DATA_DIR, "sen2_20210527_aber.kea"))
+    rng = numpy.random.default_rng(42)
+    vals = rng.random((2, 40, 40)).astype(numpy.float32)
+    vals[0, rng.random((40, 40)) > 0.8] = numpy.nan
+    vals[1, rng.random((40, 40)) > 0.8] = numpy.nan
+    # Inf is not the no data value so is valid when finite values are not checked.
+    vals[1, 0:5, 0:5] = numpy.inf
+    input_img = os.path.join(tmp_path, "in_nan_img.tif")
+    img_ds = gdal.GetDriverByName("GTiff").Create(
+        input_img, 40, 40, 2, gdal.GDT_Float32
+    )
+    img_ds.SetGeoTransform(in_ds.GetGeoTransform())
+    img_ds.SetProjection(in_ds.GetProjection())
+    for n in range(2):
+        img_ds.GetRasterBand(n + 1).WriteArray(vals[n])
+    img_ds = None
+    in_ds = None
+
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    rsgislib.imageutils.gen_multi_img_valid_masks(
+        [input_img],
+        output_img,
+        gdalformat="KEA",
+        no_data_val=float("nan"),
+        use_img_no_data=False,
+        check_finite=False,
+    )
+
+    out_ds = gdal.Open(output_img)
+    n_valid = out_ds.GetRasterBand(1).ReadAsArray()
+    out_ds = None
+    exp_valid = (~numpy.isnan(vals).any(axis=0)).astype(n_valid.dtype)
+    assert numpy.array_equal(n_valid, exp_valid)
+
+
 def test_gen_img_edge_mask(tmp_path):
     import rsgislib.imageutils
 
@@ -963,6 +1255,121 @@ def test_subset_to_img(tmp_path):
     assert os.path.exists(output_img)
 
 
+def test_subset_to_polys(tmp_path):
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    vec_file = os.path.join(DATA_DIR, "aber_osgb_multi_polys.geojson")
+    vec_lyr = "aber_osgb_multi_polys"
+    out_img_base = os.path.join(tmp_path, "out_img_")
+    out_imgs = rsgislib.imageutils.subset_to_polys(
+        input_img,
+        vec_file,
+        vec_lyr,
+        "tile_name",
+        out_img_base,
+        "KEA",
+        rsgislib.TYPE_16UINT,
+        "kea",
+        mask_to_poly=True,
+        no_data_val=0,
+    )
+
+    assert (len(out_imgs) > 0) and all([os.path.exists(img) for img in out_imgs])
+
+
+@pytest.mark.skipif(GEOPANDAS_NOT_AVAIL, reason="geopandas dependency not available")
+def test_subset_to_polys_match_geoms_bbox(tmp_path):
+    import json
+    from osgeo import gdal
+    import rsgislib.imagecalc
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    img_ds = gdal.Open(input_img)
+    x_min, x_res, _, y_max, _, y_res = img_ds.GetGeoTransform()
+    img_ds = None
+
+    # Rectangles aligned to the pixel grid (two overlapping) so the chip windows
+    # do not depend on how each function rounds the envelope to pixels.
+    pxl_bboxs = {
+        "a": (10, 250, 20, 180),
+        "b": (200, 610, 100, 420),
+        "c": (500, 931, 700, 947),
+    }
+    feats = list()
+    for tile_name, (px_min, px_max, py_min, py_max) in pxl_bboxs.items():
+        bx_min = x_min + px_min * x_res
+        bx_max = x_min + px_max * x_res
+        by_max = y_max + py_min * y_res
+        by_min = y_max + py_max * y_res
+        feats.append(
+            {
+                "type": "Feature",
+                "properties": {"tile_name": tile_name},
+                "geometry": {
+                    "type": "Polygon",
+                    "coordinates": [
+                        [
+                            [bx_min, by_max],
+                            [bx_max, by_max],
+                            [bx_max, by_min],
+                            [bx_min, by_min],
+                            [bx_min, by_max],
+                        ]
+                    ],
+                },
+            }
+        )
+    vec_file = os.path.join(tmp_path, "pxl_rects.geojson")
+    vec_lyr = "pxl_rects"
+    with open(vec_file, "w") as out_file:
+        json.dump(
+            {
+                "type": "FeatureCollection",
+                "name": vec_lyr,
+                "crs": {
+                    "type": "name",
+                    "properties": {"name": "urn:ogc:def:crs:EPSG::27700"},
+                },
+                "features": feats,
+            },
+            out_file,
+        )
+
+    out_polys_base = os.path.join(tmp_path, "out_polys_")
+    out_imgs = rsgislib.imageutils.subset_to_polys(
+        input_img,
+        vec_file,
+        vec_lyr,
+        "tile_name",
+        out_polys_base,
+        "KEA",
+        rsgislib.TYPE_16UINT,
+        "kea",
+        mask_to_poly=False,
+    )
+    assert len(out_imgs) == len(pxl_bboxs)
+
+    out_bbox_base = os.path.join(tmp_path, "out_bbox_")
+    rsgislib.imageutils.subset_to_geoms_bbox(
+        input_img,
+        vec_file,
+        vec_lyr,
+        "tile_name",
+        out_bbox_base,
+        gdalformat="KEA",
+        datatype=None,
+        out_img_ext="kea",
+    )
+
+    for tile_name in pxl_bboxs:
+        img_eq, prop_match = rsgislib.imagecalc.are_imgs_equal(
+            f"{out_bbox_base}{tile_name}.kea", f"{out_polys_base}{tile_name}.kea"
+        )
+        assert img_eq
+
+
 @pytest.mark.skipif(GEOPANDAS_NOT_AVAIL, reason="geopandas dependency not available")
 def test_subset_to_geoms_bbox(tmp_path):
     import rsgislib.imageutils
@@ -1231,6 +1638,74 @@ def test_create_img_for_each_vec_feat(tmp_path):
     assert len(glob.glob(os.path.join(tmp_path, "*.kea"))) == 4
 
 
+def test_create_vec_feat_mask_imgs(tmp_path):
+    import rsgislib.imageutils
+
+    ref_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    vec_file = os.path.join(DATA_DIR, "aber_osgb_multi_polys.geojson")
+    vec_lyr = "aber_osgb_multi_polys"
+    out_imgs = rsgislib.imageutils.create_vec_feat_mask_imgs(
+        vec_file,
+        vec_lyr,
+        ref_img,
+        os.path.join(tmp_path, "mask_"),
+        "kea",
+        "KEA",
+        file_name_col="tile_name",
+        n_threads=2,
+    )
+    assert (len(out_imgs) == 4) and all([os.path.exists(img) for img in out_imgs])
+
+    # The polygons do not overlap so the number of pixels within each mask
+    # should equal the number of pixels with its value when rasterised.
+    import rsgislib.imagecalc
+    import rsgislib.vectorutils.createrasters
+
+    rast_img = os.path.join(tmp_path, "rast_img.kea")
+    rsgislib.vectorutils.createrasters.rasterise_vec_lyr(
+        vec_file, vec_lyr, ref_img, rast_img, gdalformat="KEA", att_column="val"
+    )
+    feat_vals = {"tile_1": 1, "tile_2": 2, "tile_3": 4, "tile_4": 3}
+    rast_counts = rsgislib.imagecalc.count_pxls_of_val(
+        rast_img, vals=list(feat_vals.values()), img_band=1
+    )
+    for tile_name, rast_count in zip(feat_vals.keys(), rast_counts):
+        mask_img = os.path.join(tmp_path, "mask_{}.kea".format(tile_name))
+        assert mask_img in out_imgs
+        mask_count = rsgislib.imagecalc.count_pxls_of_val(
+            mask_img, vals=[1], img_band=1
+        )[0]
+        assert mask_count == rast_count
+
+
+def test_create_clump_mask_imgs(tmp_path):
+    import rsgislib.imageutils
+
+    clumps_img = os.path.join(DATA_DIR, "rastergis", "sen2_grid_clumps.kea")
+    out_imgs = rsgislib.imageutils.create_clump_mask_imgs(
+        clumps_img,
+        os.path.join(tmp_path, "clump_mask_"),
+        "kea",
+        "KEA",
+        binary_out=True,
+        datatype=rsgislib.TYPE_8UINT,
+        n_threads=2,
+    )
+    assert (len(out_imgs) > 0) and all([os.path.exists(img) for img in out_imgs])
+
+    # The number of pixels within each mask should equal the clump histogram.
+    import rsgislib.imagecalc
+    import rsgislib.rastergis
+
+    clump_hist = rsgislib.rastergis.get_column_data(clumps_img, "Histogram")
+    for out_img in out_imgs[:5]:
+        clump_id = int(os.path.basename(out_img)[len("clump_mask_C") : -len(".kea")])
+        mask_count = rsgislib.imagecalc.count_pxls_of_val(
+            out_img, vals=[1], img_band=1
+        )[0]
+        assert mask_count == clump_hist[clump_id]
+
+
 def test_create_copy_img_vec_extent(tmp_path):
     import rsgislib.imageutils
 
@@ -1419,6 +1894,34 @@ def test_calc_wgs84_pixel_area(tmp_path):
     assert os.path.exists(output_img)
 
 
+def test_calc_wgs84_pixel_area_vals(tmp_path):
+    from osgeo import gdal
+    import rsgislib.imageutils
+    import rsgislib.tools.projection
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber_wgs84.kea")
+    output_img = os.path.join(tmp_path, "out_img.kea")
+
+    rsgislib.imageutils.calc_wgs84_pixel_area(
+        input_img, output_img, scale=1, gdalformat="KEA"
+    )
+
+    in_ds = gdal.Open(input_img)
+    geo_trans = in_ds.GetGeoTransform()
+    row = in_ds.RasterYSize // 2
+    in_ds = None
+    lat = geo_trans[3] + ((row + 0.5) * geo_trans[5])
+    x_size, y_size = rsgislib.tools.projection.degrees_to_metres(
+        lat, abs(geo_trans[1]), abs(geo_trans[5])
+    )
+
+    out_ds = gdal.Open(output_img)
+    areas = out_ds.GetRasterBand(1).ReadAsArray(0, row, out_ds.RasterXSize, 1)
+    out_ds = None
+    assert areas[0, 0] == pytest.approx(x_size * y_size, rel=1e-6)
+    assert (areas == areas[0, 0]).all()
+
+
 def test_calc_wsg84_pixel_size(tmp_path):
     import rsgislib.imageutils
 
@@ -1430,6 +1933,33 @@ def test_calc_wsg84_pixel_size(tmp_path):
     assert os.path.exists(output_img)
 
 
+def test_calc_wsg84_pixel_size_vals(tmp_path):
+    from osgeo import gdal
+    import rsgislib.imageutils
+    import rsgislib.tools.projection
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber_wgs84.kea")
+    output_img = os.path.join(tmp_path, "out_img.kea")
+
+    rsgislib.imageutils.calc_wsg84_pixel_size(input_img, output_img, gdalformat="KEA")
+
+    in_ds = gdal.Open(input_img)
+    geo_trans = in_ds.GetGeoTransform()
+    row = in_ds.RasterYSize // 2
+    in_ds = None
+    lat = geo_trans[3] + ((row + 0.5) * geo_trans[5])
+    x_size, y_size = rsgislib.tools.projection.degrees_to_metres(
+        lat, abs(geo_trans[1]), abs(geo_trans[5])
+    )
+
+    out_ds = gdal.Open(output_img)
+    x_sizes = out_ds.GetRasterBand(1).ReadAsArray(0, row, out_ds.RasterXSize, 1)
+    y_sizes = out_ds.GetRasterBand(2).ReadAsArray(0, row, out_ds.RasterXSize, 1)
+    out_ds = None
+    assert x_sizes[0, 0] == pytest.approx(x_size, rel=1e-9)
+    assert y_sizes[0, 0] == pytest.approx(y_size, rel=1e-9)
+
+
 def test_calc_pixel_locations(tmp_path):
     import rsgislib.imageutils
 
@@ -1441,6 +1971,20 @@ def test_calc_pixel_locations(tmp_path):
     assert os.path.exists(output_img)
 
 
+def test_calc_pixel_locations_epsg(tmp_path):
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    output_img = os.path.join(tmp_path, "out_img.kea")
+
+    rsgislib.imageutils.calc_pixel_locations(
+        input_img, output_img, gdalformat="KEA", out_epsg=4326
+    )
+
+    assert os.path.exists(output_img)
+    assert rsgislib.imageutils.get_img_band_count(output_img) == 2
+
+
 def test_get_file_img_extension_kea():
     import rsgislib.imageutils
 
@@ -1695,3 +2239,95 @@ def test_get_img_pxl_coords():
         and (x_pxl_coords[1] == 284)
         and (y_pxl_coords[1] == 325)
     )
+
+
+def _read_img_band_arr(input_img, img_band):
+    from osgeo import gdal
+
+    img_ds = gdal.Open(input_img)
+    arr = img_ds.GetRasterBand(img_band).ReadAsArray()
+    img_ds = None
+    return arr
+
+
+def test_unpack_pxl_vals(tmp_path):
+    import numpy
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    rsgislib.imageutils.unpack_pxl_vals(input_img, 1, output_img, "KEA")
+
+    assert os.path.exists(output_img) and (
+        rsgislib.imageutils.get_img_band_count(output_img) == 16
+    )
+
+    in_vals = _read_img_band_arr(input_img, 1).astype(numpy.uint32)
+    for i in range(16):
+        out_vals = _read_img_band_arr(output_img, i + 1)
+        assert numpy.array_equal(out_vals, (in_vals >> i) & 1)
+
+
+def test_decode_bit_fields(tmp_path):
+    import numpy
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    bit_fields = list()
+    bit_fields.append(
+        rsgislib.imageutils.BitFieldInfo(
+            name="bit0", bit_offset=0, bit_length=1, out_band=1
+        )
+    )
+    bit_fields.append(
+        rsgislib.imageutils.BitFieldInfo(
+            name="bits4to7", bit_offset=4, bit_length=4, out_band=2
+        )
+    )
+    rsgislib.imageutils.decode_bit_fields(input_img, 1, output_img, "KEA", bit_fields)
+
+    assert os.path.exists(output_img) and (
+        rsgislib.imageutils.get_img_band_count(output_img) == 2
+    )
+
+    in_vals = _read_img_band_arr(input_img, 1).astype(numpy.uint32)
+    for bit_field in bit_fields:
+        out_vals = _read_img_band_arr(output_img, bit_field.out_band)
+        exp_vals = (in_vals >> bit_field.bit_offset) & (
+            (1 << bit_field.bit_length) - 1
+        )
+        assert numpy.array_equal(out_vals, exp_vals)
+
+
+def test_decode_bit_fields_packed(tmp_path):
+    import numpy
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    output_img = os.path.join(tmp_path, "out_img.kea")
+    bit_fields = list()
+    for i in range(10):
+        bit_fields.append(
+            rsgislib.imageutils.BitFieldInfo(
+                name=f"bit{i}", bit_offset=i, bit_length=1, out_band=i + 1
+            )
+        )
+    rsgislib.imageutils.decode_bit_fields(
+        input_img, 1, output_img, "KEA", bit_fields, pack_masks=True
+    )
+
+    assert os.path.exists(output_img) and (
+        rsgislib.imageutils.get_img_band_count(output_img) == 1
+    )
+
+    # Each single bit field is packed into bit (out_band - 1) of the output.
+    in_vals = _read_img_band_arr(input_img, 1).astype(numpy.uint32)
+    exp_vals = numpy.zeros_like(in_vals)
+    for bit_field in bit_fields:
+        field_vals = (in_vals >> bit_field.bit_offset) & (
+            (1 << bit_field.bit_length) - 1
+        )
+        exp_vals |= (field_vals != 0).astype(numpy.uint32) << (bit_field.out_band - 1)
+    out_vals = _read_img_band_arr(output_img, 1).astype(numpy.uint32)
+    assert numpy.array_equal(out_vals, exp_vals)
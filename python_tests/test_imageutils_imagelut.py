@@ -194,3 +194,68 @@ def test_query_file_lut_cp(tmp_path):
     rsgislib.imageutils.imagelut.query_file_lut(
         vec_file, vec_lyr, roi_file, roi_lyr, tmp_path, False, True
     )
+
+
+def test_create_img_footprint_idx_query(tmp_path):
+    import rsgislib.imageutils
+    import glob
+
+    input_imgs = sorted(
+        glob.glob(os.path.join(IMGUTILS_DATA_DIR, "s2_tiles", "*.kea"))
+    )
+    idx_file = os.path.join(tmp_path, "test_footprints.idx")
+    rsgislib.imageutils.create_img_footprint_idx(
+        input_imgs, idx_file, calc_valid_frac=True, no_data_val=0
+    )
+    assert sorted(rsgislib.imageutils.query_img_footprint_idx(idx_file)) == input_imgs
+
+    img_bbox = rsgislib.imageutils.get_img_bbox(input_imgs[0])
+    in_bbox = [
+        (img_bbox[0] + img_bbox[1]) / 2,
+        (img_bbox[0] + img_bbox[1]) / 2,
+        (img_bbox[2] + img_bbox[3]) / 2,
+        (img_bbox[2] + img_bbox[3]) / 2,
+    ]
+    imgs_info = rsgislib.imageutils.query_img_footprint_idx(
+        idx_file, in_bbox, get_info=True
+    )
+    assert input_imgs[0] in [img_info["file"] for img_info in imgs_info]
+    for img_info in imgs_info:
+        assert 0 <= img_info["valid_frac"] <= 1
+        assert img_info["n_bands"] == rsgislib.imageutils.get_img_band_count(
+            img_info["file"]
+        )
+
+
+def test_update_img_footprint_idx(tmp_path):
+    import rsgislib.imageutils
+    import glob
+
+    input_imgs = sorted(
+        glob.glob(os.path.join(IMGUTILS_DATA_DIR, "s2_tiles", "*.kea"))
+    )
+    idx_file = os.path.join(tmp_path, "test_footprints.idx")
+    rsgislib.imageutils.create_img_footprint_idx(input_imgs[1:], idx_file)
+    n_read = rsgislib.imageutils.update_img_footprint_idx(idx_file, input_imgs)
+    assert n_read == 1
+    assert sorted(rsgislib.imageutils.query_img_footprint_idx(idx_file)) == input_imgs
+
+
+def test_order_img_using_prop_valid_pxls_footprint_idx(tmp_path):
+    import rsgislib.imageutils
+    import glob
+
+    input_imgs = sorted(
+        glob.glob(os.path.join(IMGUTILS_DATA_DIR, "s2_tiles", "*.kea"))
+    )
+    idx_file = os.path.join(tmp_path, "test_footprints.idx")
+    rsgislib.imageutils.create_img_footprint_idx(
+        input_imgs, idx_file, calc_valid_frac=True, no_data_val=0
+    )
+    ordered_imgs = rsgislib.imageutils.order_img_using_prop_valid_pxls(
+        input_imgs, no_data_val=0
+    )
+    ordered_idx_imgs = rsgislib.imageutils.order_img_using_prop_valid_pxls(
+        input_imgs, no_data_val=0, idx_file=idx_file
+    )
+    assert list(ordered_idx_imgs) == list(ordered_imgs)
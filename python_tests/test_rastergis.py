@@ -517,6 +517,22 @@ def test_get_column_data():
     assert hist_col_vals
 
 
+def test_read_rat_column():
+    import rsgislib.rastergis
+    import numpy
+
+    ref_clumps_img = os.path.join(
+        RASTERGIS_DATA_DIR, "sen2_20210527_aber_clumps_attref.kea"
+    )
+
+    hist_col_vals = numpy.asarray(
+        rsgislib.rastergis.read_rat_column(ref_clumps_img, "Histogram")
+    )
+
+    assert hist_col_vals.shape[0] == 11949
+    assert numpy.max(hist_col_vals) <= 80174
+
+
 def test_set_column_data(tmp_path):
     import rsgislib.rastergis
     import numpy
@@ -54,6 +54,108 @@ def test_polygonise_raster_to_vec_lyr_8_conn(tmp_path):
     assert os.path.exists(out_vec_file)
 
 
+def _get_vec_lyr_area_validity(vec_file, vec_lyr):
+    from osgeo import ogr
+
+    vec_ds = ogr.Open(vec_file)
+    lyr_obj = vec_ds.GetLayerByName(vec_lyr)
+    total_area = 0.0
+    all_valid = True
+    for feat in lyr_obj:
+        geom = feat.GetGeometryRef()
+        total_area += geom.GetArea()
+        all_valid = all_valid and geom.IsValid()
+    vec_ds = None
+    return total_area, all_valid
+
+
+def test_polygonise_raster_to_vec_lyr_native_gdal(tmp_path):
+    import rsgislib.vectorutils
+    import rsgislib.vectorutils.createvectors
+
+    input_img = os.path.join(DATA_DIR, "aber_osgb_multi_polys_rasters.kea")
+
+    for use_8_conn in [False, True]:
+        out_rsgis_vec_file = os.path.join(tmp_path, f"out_rsgis_{use_8_conn}.gpkg")
+        out_gdal_vec_file = os.path.join(tmp_path, f"out_gdal_{use_8_conn}.gpkg")
+        out_vec_lyr = "out_vec"
+
+        for out_vec_file, use_native in [
+            (out_rsgis_vec_file, True),
+            (out_gdal_vec_file, False),
+        ]:
+            rsgislib.vectorutils.createvectors.polygonise_raster_to_vec_lyr(
+                out_vec_file,
+                out_vec_lyr,
+                out_format="GPKG",
+                input_img=input_img,
+                img_band=1,
+                mask_img=input_img,
+                mask_band=1,
+                use_8_conn=use_8_conn,
+                use_native=use_native,
+            )
+
+        assert rsgislib.vectorutils.get_vec_feat_count(
+            out_rsgis_vec_file, out_vec_lyr
+        ) == rsgislib.vectorutils.get_vec_feat_count(out_gdal_vec_file, out_vec_lyr)
+
+        rsgis_area, rsgis_valid = _get_vec_lyr_area_validity(
+            out_rsgis_vec_file, out_vec_lyr
+        )
+        gdal_area, gdal_valid = _get_vec_lyr_area_validity(
+            out_gdal_vec_file, out_vec_lyr
+        )
+        assert rsgis_valid
+        assert abs(rsgis_area - gdal_area) < (gdal_area * 1e-9)
+
+
+def test_polygonise_img_pinch_vertices(tmp_path):
+    import numpy
+    from osgeo import gdal
+    import rsgislib.vectorutils
+
+    # Pixels touching only at a corner: a hole touching the outer boundary
+    # and a chequerboard.
+    img_arr = numpy.array(
+        [
+            [1, 1, 1, 0, 0, 1, 0, 1],
+            [1, 0, 1, 0, 1, 0, 1, 0],
+            [1, 1, 0, 0, 0, 1, 0, 1],
+            [0, 0, 0, 1, 0, 0, 0, 0],
+            [1, 1, 1, 1, 1, 0, 1, 0],
+            [1, 0, 1, 0, 1, 0, 0, 1],
+            [1, 1, 0, 1, 1, 0, 1, 0],
+            [1, 1, 1, 1, 1, 0, 0, 0],
+        ],
+        dtype=numpy.uint8,
+    )
+    input_img = os.path.join(tmp_path, "pinch_img.tif")
+    img_ds = gdal.GetDriverByName("GTiff").Create(
+        input_img, img_arr.shape[1], img_arr.shape[0], 1, gdal.GDT_Byte
+    )
+    img_ds.SetGeoTransform([1000.0, 10.0, 0.0, 2000.0, 0.0, -10.0])
+    img_ds.GetRasterBand(1).WriteArray(img_arr)
+    img_ds = None
+
+    for use_8_conn in [False, True]:
+        out_vec_file = os.path.join(tmp_path, f"out_vec_{use_8_conn}.gpkg")
+        out_vec_lyr = "out_vec"
+        rsgislib.vectorutils.polygonise_img(
+            input_img,
+            1,
+            out_vec_file,
+            out_vec_lyr,
+            "GPKG",
+            mask_img=input_img,
+            mask_band=1,
+            use_8_conn=use_8_conn,
+        )
+        total_area, all_valid = _get_vec_lyr_area_validity(out_vec_file, out_vec_lyr)
+        assert all_valid
+        assert abs(total_area - (img_arr.sum() * 100.0)) < 1e-6
+
+
 @pytest.mark.skipif(GEOPANDAS_NOT_AVAIL, reason="geopandas dependency not available")
 def test_vectorise_pxls_to_pts(tmp_path):
     import rsgislib.vectorutils.createvectors
@@ -632,6 +632,72 @@ def test_calc_zonal_poly_pts_band_stats_file(tmp_path):
     assert vals_eq
 
 
+def test_calc_zonal_poly_pts_band_stats_file_float64(tmp_path):
+    import numpy
+    from osgeo import gdal, ogr
+    import rsgislib.zonalstats
+    import rsgislib.vectorutils
+    import rsgislib.vectorattrs
+
+    vec_file = os.path.join(ZONALSTATS_DATA_DIR, "sen2_20210527_aber_polygons.geojson")
+    vec_lyr = "sen2_20210527_aber_polygons"
+    out_vec_file = os.path.join(tmp_path, "out_vec.geojson")
+    out_vec_lyr = "out_vec"
+    rsgislib.vectorutils.create_copy_vector_lyr(
+        vec_file,
+        vec_lyr,
+        out_vec_file,
+        out_vec_lyr,
+        "GEOJSON",
+        replace=True,
+        in_memory=True,
+    )
+
+    # A Float64 image with values and a no data value (-9999.9) which are not
+    # representable as float32; the first polygon's centroid pixel is no data.
+    no_data_val = -9999.9
+    in_ds = gdal.Open(os.path.join(DATA_DIR, "sen2_20210527_aber.kea"))
+    geo_trans = in_ds.GetGeoTransform()
+    img_arr = in_ds.GetRasterBand(1).ReadAsArray().astype(numpy.float64) + 0.123456789
+
+    vec_ds = ogr.Open(vec_file)
+    cntr_pxls = []
+    for feat in vec_ds.GetLayer():
+        cntr = feat.GetGeometryRef().Centroid()
+        cntr_pxls.append(
+            (
+                int((cntr.GetY() - geo_trans[3]) / geo_trans[5]),
+                int((cntr.GetX() - geo_trans[0]) / geo_trans[1]),
+            )
+        )
+    vec_ds = None
+    img_arr[cntr_pxls[0]] = no_data_val
+
+    input_img = os.path.join(tmp_path, "sen2_20210527_aber_b1_f64.tif")
+    out_ds = gdal.GetDriverByName("GTiff").Create(
+        input_img, in_ds.RasterXSize, in_ds.RasterYSize, 1, gdal.GDT_Float64
+    )
+    out_ds.SetGeoTransform(geo_trans)
+    out_ds.SetProjection(in_ds.GetProjection())
+    out_band = out_ds.GetRasterBand(1)
+    out_band.SetNoDataValue(no_data_val)
+    out_band.WriteArray(img_arr)
+    out_ds = None
+    in_ds = None
+
+    rsgislib.zonalstats.calc_zonal_poly_pts_band_stats_file(
+        out_vec_file, out_vec_lyr, input_img, 1, "testcolval", vec_def_epsg=None
+    )
+
+    vals = rsgislib.vectorattrs.read_vec_column(out_vec_file, out_vec_lyr, "testcolval")
+    print(vals)
+    ref_vals = [img_arr[cntr_pxl] for cntr_pxl in cntr_pxls]
+    assert ref_vals[0] == no_data_val
+    assert len(vals) == len(ref_vals)
+    for val, ref_val in zip(vals, ref_vals):
+        assert abs(val - ref_val) < 1e-9
+
+
 def test_calc_zonal_band_stats_file_Min(tmp_path):
     import rsgislib.zonalstats
     import rsgislib.vectorutils
@@ -1054,6 +1120,63 @@ def test_calc_zonal_band_stats_file_Median(tmp_path):
     assert vals_eq
 
 
+def test_calc_zonal_band_stats_file_MultiThreads(tmp_path):
+    import rsgislib.zonalstats
+    import rsgislib.vectorutils
+    import rsgislib.vectorattrs
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    vec_file = os.path.join(ZONALSTATS_DATA_DIR, "sen2_20210527_aber_polygons.geojson")
+    vec_lyr = "sen2_20210527_aber_polygons"
+
+    out_vec_file = os.path.join(tmp_path, "out_vec.geojson")
+    out_vec_lyr = "out_vec"
+    rsgislib.vectorutils.create_copy_vector_lyr(
+        vec_file,
+        vec_lyr,
+        out_vec_file,
+        out_vec_lyr,
+        "GEOJSON",
+        replace=True,
+        in_memory=True,
+    )
+
+    rsgislib.zonalstats.calc_zonal_band_stats_file(
+        out_vec_file,
+        out_vec_lyr,
+        input_img,
+        1,
+        0,
+        1000,
+        0,
+        min_field="minval",
+        mean_field="meanval",
+        median_field="medianval",
+        n_threads=2,
+    )
+
+    ref_vals = {
+        "minval": [26.0, 38.0, 37.0, 163.0, 65.0, 41.0],
+        "meanval": [
+            29.299145299145298,
+            43.858108108108105,
+            41.67605633802817,
+            309.48275862068965,
+            69.29411764705883,
+            46.58974358974359,
+        ],
+        "medianval": [29.0, 45.0, 42.0, 326.0, 69.0, 47.0],
+    }
+    vals_eq = True
+    for col_name in ref_vals:
+        vals = rsgislib.vectorattrs.read_vec_column(out_vec_file, out_vec_lyr, col_name)
+        for val, ref_val in zip(vals, ref_vals[col_name]):
+            if abs(val - ref_val) > 0.0001:
+                vals_eq = False
+                break
+    assert vals_eq
+
+
 def test_image_zone_to_hdf(tmp_path):
     import rsgislib.zonalstats
 
@@ -1112,6 +1235,31 @@ def test_extract_zone_img_band_values_to_hdf(tmp_path):
     assert os.path.exists(out_h5_file)
 
 
+def test_extract_zone_img_band_values():
+    import numpy
+    import rsgislib.zonalstats
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    in_msk_img = os.path.join(ZONALSTATS_DATA_DIR, "sen2_20210527_aber_polys.kea")
+
+    in_img_info = []
+    in_img_info.append(
+        rsgislib.imageutils.ImageBandInfo(input_img, "Image1", [1, 3, 4])
+    )
+    in_img_info.append(rsgislib.imageutils.ImageBandInfo(input_img, "Image2", [2]))
+
+    pxl_vals_view = rsgislib.zonalstats.extract_zone_img_band_values(
+        in_img_info, in_msk_img, 1
+    )
+    pxl_vals = numpy.asarray(pxl_vals_view)
+
+    assert (pxl_vals.ndim == 2) and (pxl_vals.shape[1] == 4)
+    assert pxl_vals.dtype == numpy.float32
+    # A simple (shapeless) buffer request for the underlying array is flat.
+    assert len(bytes(pxl_vals_view.obj)) == (pxl_vals.size * 4)
+
+
 def test_random_sample_hdf5_file(tmp_path):
     import rsgislib.zonalstats
 
@@ -1153,6 +1301,71 @@ def test_merge_extracted_hdf5_data(tmp_path):
     assert os.path.exists(out_h5_file)
 
 
+@pytest.mark.skipif(H5PY_NOT_AVAIL, reason="h5py dependency not available")
+def test_merge_extracted_hdf5_data_shuffle(tmp_path):
+    import rsgislib.zonalstats
+    import numpy
+
+    in_h5_file = os.path.join(ZONALSTATS_DATA_DIR, "sen2_20210527_aber_b1-6_vals.h5")
+    out_h5_file = os.path.join(tmp_path, "out_h5_file.h5")
+
+    n_rows = rsgislib.zonalstats.merge_extracted_hdf5_data(
+        [in_h5_file, in_h5_file],
+        out_h5_file,
+        datatype=rsgislib.TYPE_32FLOAT,
+        shuffle=True,
+        rnd_seed=42,
+        n_threads=2,
+    )
+
+    with h5py.File(in_h5_file, "r") as f_h5:
+        in_data = numpy.array(f_h5["DATA/DATA"], dtype=numpy.float32)
+    with h5py.File(out_h5_file, "r") as f_h5:
+        out_data = numpy.array(f_h5["DATA/DATA"])
+
+    assert n_rows == 1406
+    in_data = numpy.concatenate([in_data, in_data])
+    assert numpy.array_equal(
+        in_data[numpy.lexsort(in_data.T)], out_data[numpy.lexsort(out_data.T)]
+    )
+
+
+@pytest.mark.skipif(H5PY_NOT_AVAIL, reason="h5py dependency not available")
+def test_split_sample_hdf5_files(tmp_path):
+    import rsgislib.zonalstats
+    import numpy
+
+    in_h5_file = os.path.join(ZONALSTATS_DATA_DIR, "sen2_20210527_aber_b1-6_vals.h5")
+    out_h5_files = [
+        os.path.join(tmp_path, "out_test.h5"),
+        os.path.join(tmp_path, "out_valid.h5"),
+        os.path.join(tmp_path, "out_train.h5"),
+    ]
+
+    n_rows = rsgislib.zonalstats.split_sample_hdf5_files(
+        [in_h5_file, in_h5_file],
+        out_h5_files,
+        [300, 200, None],
+        rnd_seed=42,
+        datatype=rsgislib.TYPE_32FLOAT,
+        shuffle=True,
+    )
+
+    assert n_rows == [300, 200, 906]
+    out_data = []
+    for out_h5_file, n_out_rows in zip(out_h5_files, n_rows):
+        with h5py.File(out_h5_file, "r") as f_h5:
+            assert f_h5["DATA/DATA"].shape[0] == n_out_rows
+            out_data.append(numpy.array(f_h5["DATA/DATA"]))
+    with h5py.File(in_h5_file, "r") as f_h5:
+        in_data = numpy.array(f_h5["DATA/DATA"], dtype=numpy.float32)
+    in_data = numpy.concatenate([in_data, in_data])
+    out_data = numpy.concatenate(out_data)
+    assert numpy.array_equal(
+        in_data[numpy.lexsort(in_data.T)], out_data[numpy.lexsort(out_data.T)]
+    )
+
+
 @pytest.mark.skipif(H5PY_NOT_AVAIL, reason="h5py dependency not available")
 def test_get_var_from_hdf5_data():
     import rsgislib.zonalstats
@@ -1317,6 +1530,87 @@ def test_extract_ref_chip_zone_image_band_values_to_hdf_with_rot(tmp_path):
     assert os.path.exists(out_h5_file)
 
 
+def _sort_chips(chip_arr):
+    # The order the chips are extracted in depends on how the image is read,
+    # so compare the chips in the order of their values.
+    chip_keys = [chip.tobytes() for chip in chip_arr]
+    return chip_arr[sorted(range(len(chip_keys)), key=lambda i: chip_keys[i])]
+
+
+@pytest.mark.skipif(H5PY_NOT_AVAIL, reason="h5py dependency not available")
+def test_extract_chip_zone_image_band_values_to_hdf_vals(tmp_path):
+    import numpy
+    import rsgislib.zonalstats
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    in_msk_img = os.path.join(ZONALSTATS_DATA_DIR, "sen2_20210527_aber_pts.kea")
+    in_img_info = [
+        rsgislib.imageutils.ImageBandInfo(input_img, "Image", [1, 2, 3, 4, 5, 6])
+    ]
+
+    out_h5_file = os.path.join(tmp_path, "out_h5_file.h5")
+    rsgislib.zonalstats.extract_chip_zone_image_band_values_to_hdf(
+        in_img_info,
+        in_msk_img,
+        1,
+        20,
+        out_h5_file,
+        rotate_chips=None,
+        datatype=rsgislib.TYPE_16INT,
+        n_threads=2,
+    )
+
+    ref_h5_file = os.path.join(
+        ZONALSTATS_DATA_DIR, "sen2_20210527_aber_b1-6_chip_vals.h5"
+    )
+    with h5py.File(out_h5_file, "r") as out_h5, h5py.File(ref_h5_file, "r") as ref_h5:
+        out_chips = out_h5["DATA/DATA"][...]
+        ref_chips = ref_h5["DATA/DATA"][...]
+    assert out_chips.shape == ref_chips.shape
+    assert numpy.array_equal(_sort_chips(out_chips), _sort_chips(ref_chips))
+
+
+@pytest.mark.skipif(H5PY_NOT_AVAIL, reason="h5py dependency not available")
+def test_extract_ref_chip_zone_image_band_values_to_hdf_vals(tmp_path):
+    import numpy
+    import rsgislib.zonalstats
+    import rsgislib.imageutils
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    in_ref_img = os.path.join(DATA_DIR, "sen2_20210527_aber_vldmsk.kea")
+    in_msk_img = os.path.join(ZONALSTATS_DATA_DIR, "sen2_20210527_aber_pts.kea")
+    in_img_info = [
+        rsgislib.imageutils.ImageBandInfo(input_img, "Image", [1, 2, 3, 4, 5, 6])
+    ]
+
+    out_h5_file = os.path.join(tmp_path, "out_h5_file.h5")
+    rsgislib.zonalstats.extract_ref_chip_zone_image_band_values_to_hdf(
+        in_img_info,
+        in_ref_img,
+        1,
+        in_msk_img,
+        1,
+        20,
+        out_h5_file,
+        rotate_chips=None,
+        datatype=rsgislib.TYPE_16INT,
+        n_threads=2,
+    )
+
+    ref_h5_file = os.path.join(
+        ZONALSTATS_DATA_DIR, "sen2_20210527_aber_b1-6_refchip_vals.h5"
+    )
+    with h5py.File(out_h5_file, "r") as out_h5, h5py.File(ref_h5_file, "r") as ref_h5:
+        out_chips = out_h5["DATA/DATA"][...]
+        ref_chips = ref_h5["DATA/DATA"][...]
+        out_ref_chips = out_h5["DATA/REF"][...]
+        ref_ref_chips = ref_h5["DATA/REF"][...]
+    assert out_chips.shape == ref_chips.shape
+    assert numpy.array_equal(_sort_chips(out_chips), _sort_chips(ref_chips))
+    assert numpy.array_equal(_sort_chips(out_ref_chips), _sort_chips(ref_ref_chips))
+
+
 @pytest.mark.skipif(H5PY_NOT_AVAIL, reason="h5py dependency not available")
 def test_split_sample_chip_hdf5_file(tmp_path):
     import rsgislib.zonalstats
@@ -1381,3 +1675,91 @@ def test_merge_extracted_hdf5_chip_ref_data(tmp_path):
     )
 
     assert os.path.exists(out_h5_file)
+
+
+def test_sample_pts_band_values_file(tmp_path):
+    import numpy
+    from osgeo import gdal
+    import rsgislib.zonalstats
+    import rsgislib.vectorutils
+    import rsgislib.vectorattrs
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    vec_file = os.path.join(
+        ZONALSTATS_DATA_DIR, "sen2_20210527_aber_pt_samples.geojson"
+    )
+    vec_lyr = "sen2_20210527_aber_pt_samples"
+
+    out_vec_file = os.path.join(tmp_path, "out_vec.geojson")
+    out_vec_lyr = "out_vec"
+    rsgislib.vectorutils.create_copy_vector_lyr(
+        vec_file,
+        vec_lyr,
+        out_vec_file,
+        out_vec_lyr,
+        "GEOJSON",
+        replace=True,
+        in_memory=True,
+    )
+
+    rsgislib.zonalstats.sample_pts_band_values_file(
+        out_vec_file,
+        out_vec_lyr,
+        input_img,
+        [1, 2],
+        ["b1val", "b2val"],
+        0,
+        1000,
+        0,
+        sample_method=rsgislib.zonalstats.SAMPLE_NEAREST,
+        n_threads=2,
+    )
+
+    vec_ds = gdal.OpenEx(vec_file, gdal.OF_VECTOR)
+    vec_lyr_obj = vec_ds.GetLayerByName(vec_lyr)
+    x_coords = []
+    y_coords = []
+    for feat in vec_lyr_obj:
+        x_coords.append(feat.GetGeometryRef().GetX())
+        y_coords.append(feat.GetGeometryRef().GetY())
+    vec_ds = None
+
+    pt_vals = numpy.asarray(
+        rsgislib.zonalstats.sample_img_band_values(
+            input_img,
+            [1, 2],
+            numpy.array(x_coords),
+            numpy.array(y_coords),
+            0,
+            1000,
+            0,
+        )
+    )
+    assert pt_vals.shape == (len(x_coords), 2)
+
+    b1_vals = rsgislib.vectorattrs.read_vec_column(out_vec_file, out_vec_lyr, "b1val")
+    b2_vals = rsgislib.vectorattrs.read_vec_column(out_vec_file, out_vec_lyr, "b2val")
+    assert numpy.allclose(b1_vals, pt_vals[:, 0])
+    assert numpy.allclose(b2_vals, pt_vals[:, 1])
+
+
+def test_sample_img_band_values_WinMean():
+    import numpy
+    import rsgislib.zonalstats
+
+    input_img = os.path.join(DATA_DIR, "sen2_20210527_aber.kea")
+    pt_vals = numpy.asarray(
+        rsgislib.zonalstats.sample_img_band_values(
+            input_img,
+            [1],
+            [-1.0e9],
+            [-1.0e9],
+            0,
+            1000,
+            -999,
+            sample_method=rsgislib.zonalstats.SAMPLE_WIN_MEAN,
+            win_size=3,
+        )
+    )
+    # The point is outside of the image.
+    assert pt_vals[0, 0] == -999
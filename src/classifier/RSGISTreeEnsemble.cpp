@@ -0,0 +1,708 @@
+/*
+ *  RSGISTreeEnsemble.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISTreeEnsemble.h"
+
+namespace rsgis{ namespace classifier{
+
+    RSGISTreeEnsemble::RSGISTreeEnsemble()
+    {
+        this->averaged = false;
+        this->averageOutput = false;
+        this->numFeatures = 0;
+        this->numClasses = 0;
+        this->numOutputs = 0;
+        this->transform = transformNone;
+        this->sigmoidScale = 1.0;
+    }
+
+    void RSGISTreeEnsemble::loadModel(std::string modelFile)
+    {
+        std::ifstream modelStream(modelFile.c_str());
+        if(!modelStream.is_open())
+        {
+            throw RSGISClassificationException("Could not open model file: " + modelFile);
+        }
+
+        std::string firstLine = "";
+        while(std::getline(modelStream, firstLine))
+        {
+            firstLine.erase(firstLine.find_last_not_of(" \t\r\n") + 1);
+            if(firstLine != "")
+            {
+                break;
+            }
+        }
+
+        this->averaged = false;
+        this->averageOutput = false;
+        this->numFeatures = 0;
+        this->numClasses = 0;
+        this->numOutputs = 0;
+        this->transform = transformNone;
+        this->sigmoidScale = 1.0;
+        this->baseScore.clear();
+        this->nodes.clear();
+        this->leafVals.clear();
+        this->treeRoots.clear();
+        this->treeOutputs.clear();
+
+        RSGISModelSection header;
+        std::vector<RSGISModelSection> trees;
+        if(firstLine == "tree")
+        {
+            this->readSections(modelStream, &header, &trees);
+            this->readLightGBMModel(header, trees);
+        }
+        else if(firstLine == "rsgislib_tree_ensemble")
+        {
+            this->readSections(modelStream, &header, &trees);
+            this->readRSGISModel(header, trees);
+        }
+        else
+        {
+            throw RSGISClassificationException("Model file format was not recognised (expecting a LightGBM text model or rsgislib tree ensemble): " + modelFile);
+        }
+        modelStream.close();
+
+        this->checkModel();
+    }
+
+    unsigned int RSGISTreeEnsemble::predict(const float *features, double *probs) const
+    {
+        size_t numTrees = this->treeRoots.size();
+        if(this->averaged)
+        {
+            for(unsigned int k = 0; k < this->numClasses; ++k)
+            {
+                probs[k] = 0.0;
+            }
+            for(size_t t = 0; t < numTrees; ++t)
+            {
+                const double *vals = &this->leafVals[this->findLeaf(features, this->treeRoots[t])->left];
+                for(unsigned int k = 0; k < this->numClasses; ++k)
+                {
+                    probs[k] += vals[k];
+                }
+            }
+            for(unsigned int k = 0; k < this->numClasses; ++k)
+            {
+                probs[k] = probs[k] / numTrees;
+            }
+        }
+        else if(this->numOutputs == 1)
+        {
+            double margin = this->baseScore[0];
+            for(size_t t = 0; t < numTrees; ++t)
+            {
+                margin += this->leafVals[this->findLeaf(features, this->treeRoots[t])->left];
+            }
+            if(this->averageOutput)
+            {
+                margin = margin / numTrees;
+            }
+            probs[1] = 1.0 / (1.0 + std::exp(-this->sigmoidScale * margin));
+            probs[0] = 1.0 - probs[1];
+        }
+        else
+        {
+            for(unsigned int k = 0; k < this->numClasses; ++k)
+            {
+                probs[k] = this->baseScore[k];
+            }
+            for(size_t t = 0; t < numTrees; ++t)
+            {
+                probs[this->treeOutputs[t]] += this->leafVals[this->findLeaf(features, this->treeRoots[t])->left];
+            }
+            if(this->averageOutput)
+            {
+                double treesPerClass = ((double)numTrees) / this->numClasses;
+                for(unsigned int k = 0; k < this->numClasses; ++k)
+                {
+                    probs[k] = probs[k] / treesPerClass;
+                }
+            }
+            if(this->transform == transformSoftmax)
+            {
+                double maxMargin = probs[0];
+                for(unsigned int k = 1; k < this->numClasses; ++k)
+                {
+                    maxMargin = std::max(maxMargin, probs[k]);
+                }
+                double sum = 0.0;
+                for(unsigned int k = 0; k < this->numClasses; ++k)
+                {
+                    probs[k] = std::exp(probs[k] - maxMargin);
+                    sum += probs[k];
+                }
+                for(unsigned int k = 0; k < this->numClasses; ++k)
+                {
+                    probs[k] = probs[k] / sum;
+                }
+            }
+            else if(this->transform == transformSigmoid)
+            {
+                for(unsigned int k = 0; k < this->numClasses; ++k)
+                {
+                    probs[k] = 1.0 / (1.0 + std::exp(-this->sigmoidScale * probs[k]));
+                }
+            }
+        }
+
+        unsigned int maxIdx = 0;
+        for(unsigned int k = 1; k < this->numClasses; ++k)
+        {
+            if(probs[k] > probs[maxIdx])
+            {
+                maxIdx = k;
+            }
+        }
+        return maxIdx;
+    }
+
+    const RSGISTreeNode* RSGISTreeEnsemble::findLeaf(const float *features, int root) const
+    {
+        const RSGISTreeNode *node = &this->nodes[root];
+        while(node->feature >= 0)
+        {
+            double val = features[node->feature];
+            bool missing = false;
+            if(std::isnan(val))
+            {
+                if(node->flags & (nodeMissingNaN | nodeMissingZero))
+                {
+                    missing = true;
+                }
+                else
+                {
+                    val = 0.0;
+                }
+            }
+            else if((node->flags & nodeMissingZero) && (std::fabs(val) <= 1e-35))
+            {
+                missing = true;
+            }
+
+            bool goLeft = false;
+            if(missing)
+            {
+                goLeft = (node->flags & nodeDefaultLeft) != 0;
+            }
+            else if(node->flags & nodeCompareLess)
+            {
+                goLeft = val < node->threshold;
+            }
+            else
+            {
+                goLeft = val <= node->threshold;
+            }
+            node = &this->nodes[goLeft?node->left:node->right];
+        }
+        return node;
+    }
+
+    void RSGISTreeEnsemble::readSections(std::ifstream &modelStream, RSGISModelSection *header, std::vector<RSGISModelSection> *trees)
+    {
+        RSGISModelSection *section = header;
+        std::string line = "";
+        while(std::getline(modelStream, line))
+        {
+            line.erase(line.find_last_not_of(" \t\r\n") + 1);
+            line.erase(0, line.find_first_not_of(" \t"));
+            if(line == "")
+            {
+                continue;
+            }
+            // LightGBM models have the feature importances and parameters after the trees.
+            if(line == "end of trees")
+            {
+                break;
+            }
+            if(line.compare(0, 5, "Tree=") == 0)
+            {
+                trees->push_back(RSGISModelSection());
+                section = &trees->back();
+                continue;
+            }
+            size_t eqPos = line.find('=');
+            if(eqPos == std::string::npos)
+            {
+                (*section)[line] = "";
+            }
+            else
+            {
+                (*section)[line.substr(0, eqPos)] = line.substr(eqPos+1);
+            }
+        }
+    }
+
+    void RSGISTreeEnsemble::readLightGBMModel(RSGISModelSection &header, std::vector<RSGISModelSection> &trees)
+    {
+        if(header.count("num_class") == 0 || header.count("max_feature_idx") == 0 || header.count("objective") == 0)
+        {
+            throw RSGISClassificationException("LightGBM model is missing num_class, max_feature_idx or objective.");
+        }
+        this->numOutputs = this->parseInts(header, "num_class", 1).at(0);
+        this->numFeatures = this->parseInts(header, "max_feature_idx", 1).at(0) + 1;
+        this->averageOutput = (header.count("average_output") > 0);
+        this->averaged = false;
+
+        std::istringstream objStream(header["objective"]);
+        std::string objective = "";
+        objStream >> objective;
+        std::string param = "";
+        while(objStream >> param)
+        {
+            if(param.compare(0, 8, "sigmoid:") == 0)
+            {
+                this->sigmoidScale = std::strtod(param.substr(8).c_str(), NULL);
+            }
+        }
+        if((objective == "binary") || (objective == "cross_entropy"))
+        {
+            if(this->numOutputs != 1)
+            {
+                throw RSGISClassificationException("A LightGBM binary model should have a single output.");
+            }
+            this->transform = transformSigmoid;
+            this->numClasses = 2;
+        }
+        else if(objective == "multiclass")
+        {
+            this->transform = transformSoftmax;
+            this->numClasses = this->numOutputs;
+        }
+        else if(objective == "multiclassova")
+        {
+            this->transform = transformSigmoid;
+            this->numClasses = this->numOutputs;
+        }
+        else
+        {
+            throw RSGISClassificationException("Only LightGBM classification models (binary, multiclass and multiclassova objectives) are supported, not '" + objective + "'.");
+        }
+        this->baseScore.assign(this->numOutputs, 0.0);
+
+        for(size_t t = 0; t < trees.size(); ++t)
+        {
+            RSGISModelSection &tree = trees.at(t);
+            // Linear trees have a linear model in each leaf rather than a constant.
+            if((tree.count("is_linear") > 0) && (this->parseInts(tree, "is_linear", 1).at(0) != 0))
+            {
+                throw RSGISClassificationException("LightGBM models with linear trees (linear_tree) are not supported.");
+            }
+            int numLeaves = this->parseInts(tree, "num_leaves", 1).at(0);
+            if(numLeaves < 1)
+            {
+                throw RSGISClassificationException("LightGBM tree has no leaves.");
+            }
+            std::vector<double> leafValues = this->parseDoubles(tree, "leaf_value", numLeaves);
+            int base = this->nodes.size();
+            int numSplits = numLeaves - 1;
+            this->treeRoots.push_back(base);
+            this->treeOutputs.push_back(t % this->numOutputs);
+
+            RSGISTreeNode node;
+            if(numSplits > 0)
+            {
+                std::vector<int> splitFeature = this->parseInts(tree, "split_feature", numSplits);
+                std::vector<double> threshold = this->parseDoubles(tree, "threshold", numSplits);
+                std::vector<int> decisionType = this->parseInts(tree, "decision_type", numSplits);
+                std::vector<int> leftChild = this->parseInts(tree, "left_child", numSplits);
+                std::vector<int> rightChild = this->parseInts(tree, "right_child", numSplits);
+                for(int i = 0; i < numSplits; ++i)
+                {
+                    if(decisionType[i] & 1)
+                    {
+                        throw RSGISClassificationException("LightGBM models with categorical splits are not supported.");
+                    }
+                    node.feature = splitFeature[i];
+                    node.threshold = threshold[i];
+                    // Children >= 0 are splits, otherwise the leaf is ~child.
+                    node.left = base + ((leftChild[i] >= 0)?leftChild[i]:(numSplits + (~leftChild[i])));
+                    node.right = base + ((rightChild[i] >= 0)?rightChild[i]:(numSplits + (~rightChild[i])));
+                    node.flags = 0;
+                    if(decisionType[i] & 2)
+                    {
+                        node.flags |= nodeDefaultLeft;
+                    }
+                    int missingType = (decisionType[i] >> 2) & 3;
+                    if(missingType == 1)
+                    {
+                        node.flags |= nodeMissingZero;
+                    }
+                    else if(missingType == 2)
+                    {
+                        node.flags |= nodeMissingNaN;
+                    }
+                    this->nodes.push_back(node);
+                }
+            }
+            for(int i = 0; i < numLeaves; ++i)
+            {
+                node.feature = -1;
+                node.threshold = 0;
+                node.left = this->leafVals.size();
+                node.right = -1;
+                node.flags = 0;
+                this->nodes.push_back(node);
+                this->leafVals.push_back(leafValues[i]);
+            }
+        }
+    }
+
+    void RSGISTreeEnsemble::readRSGISModel(RSGISModelSection &header, std::vector<RSGISModelSection> &trees)
+    {
+        if(header.count("ensemble_type") == 0 || header.count("num_features") == 0 || header.count("num_classes") == 0)
+        {
+            throw RSGISClassificationException("Tree ensemble model is missing ensemble_type, num_features or num_classes.");
+        }
+        std::string ensembleType = header["ensemble_type"];
+        if(ensembleType == "average")
+        {
+            this->averaged = true;
+        }
+        else if(ensembleType == "boosted")
+        {
+            this->averaged = false;
+        }
+        else
+        {
+            throw RSGISClassificationException("Tree ensemble type must be 'average' or 'boosted'.");
+        }
+        this->numFeatures = this->parseInts(header, "num_features", 1).at(0);
+        this->numClasses = this->parseInts(header, "num_classes", 1).at(0);
+        this->numOutputs = this->numClasses;
+        if(header.count("num_outputs") > 0)
+        {
+            this->numOutputs = this->parseInts(header, "num_outputs", 1).at(0);
+        }
+
+        std::string transformStr = (header.count("output_transform") > 0)?header["output_transform"]:"none";
+        if(transformStr == "none")
+        {
+            this->transform = transformNone;
+        }
+        else if(transformStr == "sigmoid")
+        {
+            this->transform = transformSigmoid;
+        }
+        else if(transformStr == "softmax")
+        {
+            this->transform = transformSoftmax;
+        }
+        else
+        {
+            throw RSGISClassificationException("Tree ensemble output_transform must be 'none', 'sigmoid' or 'softmax'.");
+        }
+
+        if(this->averaged && (this->numOutputs != this->numClasses))
+        {
+            throw RSGISClassificationException("An averaged tree ensemble must have an output for each class.");
+        }
+        if((!this->averaged) && (this->numOutputs != this->numClasses) && ((this->numOutputs != 1) || (this->numClasses != 2) || (this->transform != transformSigmoid)))
+        {
+            throw RSGISClassificationException("A boosted tree ensemble with a single output must be binary (2 classes) with a sigmoid transform.");
+        }
+
+        this->baseScore.assign(this->numOutputs, 0.0);
+        if(header.count("base_score") > 0)
+        {
+            this->baseScore = this->parseDoubles(header, "base_score", this->numOutputs);
+        }
+
+        unsigned char compareFlag = 0;
+        if(header.count("split_compare") > 0)
+        {
+            if(header["split_compare"] == "lt")
+            {
+                compareFlag = nodeCompareLess;
+            }
+            else if(header["split_compare"] != "le")
+            {
+                throw RSGISClassificationException("Tree ensemble split_compare must be 'le' or 'lt'.");
+            }
+        }
+
+        size_t leafSize = this->averaged?this->numClasses:1;
+        for(size_t t = 0; t < trees.size(); ++t)
+        {
+            RSGISModelSection &tree = trees.at(t);
+            std::vector<int> splitFeature = this->parseInts(tree, "split_feature", 0);
+            size_t numTreeNodes = splitFeature.size();
+            if(numTreeNodes == 0)
+            {
+                throw RSGISClassificationException("Tree ensemble tree has no nodes.");
+            }
+            std::vector<double> threshold = this->parseDoubles(tree, "threshold", numTreeNodes);
+            std::vector<int> leftChild = this->parseInts(tree, "left_child", numTreeNodes);
+            std::vector<int> rightChild = this->parseInts(tree, "right_child", numTreeNodes);
+            std::vector<int> defaultLeft(numTreeNodes, 0);
+            if(tree.count("default_left") > 0)
+            {
+                defaultLeft = this->parseInts(tree, "default_left", numTreeNodes);
+            }
+            size_t numLeaves = 0;
+            for(size_t i = 0; i < numTreeNodes; ++i)
+            {
+                if(splitFeature[i] < 0)
+                {
+                    ++numLeaves;
+                }
+            }
+            std::vector<double> leafValues = this->parseDoubles(tree, "leaf_value", numLeaves * leafSize);
+
+            int base = this->nodes.size();
+            this->treeRoots.push_back(base);
+            unsigned int treeClass = 0;
+            if(tree.count("tree_class") > 0)
+            {
+                treeClass = this->parseInts(tree, "tree_class", 1).at(0);
+            }
+            this->treeOutputs.push_back(treeClass);
+
+            size_t leafIdx = 0;
+            RSGISTreeNode node;
+            for(size_t i = 0; i < numTreeNodes; ++i)
+            {
+                if(splitFeature[i] < 0)
+                {
+                    node.feature = -1;
+                    node.threshold = 0;
+                    node.left = this->leafVals.size();
+                    node.right = -1;
+                    node.flags = 0;
+                    this->leafVals.insert(this->leafVals.end(), leafValues.begin() + (leafIdx * leafSize), leafValues.begin() + ((leafIdx + 1) * leafSize));
+                    ++leafIdx;
+                }
+                else
+                {
+                    if((leftChild[i] < 0) || (rightChild[i] < 0) || (((size_t)leftChild[i]) >= numTreeNodes) || (((size_t)rightChild[i]) >= numTreeNodes))
+                    {
+                        throw RSGISClassificationException("Tree ensemble tree has an invalid child node.");
+                    }
+                    node.feature = splitFeature[i];
+                    node.threshold = threshold[i];
+                    node.left = base + leftChild[i];
+                    node.right = base + rightChild[i];
+                    node.flags = nodeMissingNaN | compareFlag;
+                    if(defaultLeft[i] != 0)
+                    {
+                        node.flags |= nodeDefaultLeft;
+                    }
+                }
+                this->nodes.push_back(node);
+            }
+        }
+    }
+
+    void RSGISTreeEnsemble::checkModel()
+    {
+        if(this->treeRoots.empty())
+        {
+            throw RSGISClassificationException("The tree ensemble does not have any trees.");
+        }
+        if((this->numFeatures == 0) || (this->numClasses < 2))
+        {
+            throw RSGISClassificationException("The tree ensemble must have at least 1 feature and 2 classes.");
+        }
+        for(size_t t = 0; t < this->treeOutputs.size(); ++t)
+        {
+            if(this->treeOutputs[t] >= this->numOutputs)
+            {
+                throw RSGISClassificationException("A tree of the ensemble is for a class outside of the model.");
+            }
+        }
+        size_t leafSize = this->averaged?this->numClasses:1;
+        int numNodes = this->nodes.size();
+        for(auto iterNode = this->nodes.begin(); iterNode != this->nodes.end(); ++iterNode)
+        {
+            if((*iterNode).feature < 0)
+            {
+                if(((*iterNode).left < 0) || ((((size_t)(*iterNode).left) + leafSize) > this->leafVals.size()))
+                {
+                    throw RSGISClassificationException("A leaf of the ensemble has an invalid value index.");
+                }
+            }
+            else
+            {
+                if(((unsigned int)(*iterNode).feature) >= this->numFeatures)
+                {
+                    throw RSGISClassificationException("A split of the ensemble uses a feature outside of the model.");
+                }
+                if(((*iterNode).left < 0) || ((*iterNode).left >= numNodes) || ((*iterNode).right < 0) || ((*iterNode).right >= numNodes))
+                {
+                    throw RSGISClassificationException("A split of the ensemble has an invalid child node.");
+                }
+            }
+        }
+    }
+
+    std::vector<double> RSGISTreeEnsemble::parseDoubles(RSGISModelSection &section, std::string key, size_t expectedNum)
+    {
+        if(section.count(key) == 0)
+        {
+            throw RSGISClassificationException("Model is missing '" + key + "'.");
+        }
+        std::vector<double> vals;
+        std::istringstream valStream(section[key]);
+        std::string token = "";
+        while(valStream >> token)
+        {
+            // strtod rather than the stream operator so inf and nan are read.
+            char *endPtr = NULL;
+            double val = std::strtod(token.c_str(), &endPtr);
+            if((endPtr == token.c_str()) || (*endPtr != '\0'))
+            {
+                throw RSGISClassificationException("Could not parse value '" + token + "' for '" + key + "'.");
+            }
+            vals.push_back(val);
+        }
+        if((expectedNum > 0) && (vals.size() != expectedNum))
+        {
+            throw RSGISClassificationException("Model has the wrong number of values for '" + key + "'.");
+        }
+        return vals;
+    }
+
+    std::vector<int> RSGISTreeEnsemble::parseInts(RSGISModelSection &section, std::string key, size_t expectedNum)
+    {
+        if(section.count(key) == 0)
+        {
+            throw RSGISClassificationException("Model is missing '" + key + "'.");
+        }
+        std::vector<int> vals;
+        std::istringstream valStream(section[key]);
+        std::string token = "";
+        while(valStream >> token)
+        {
+            char *endPtr = NULL;
+            long val = std::strtol(token.c_str(), &endPtr, 10);
+            if((endPtr == token.c_str()) || (*endPtr != '\0'))
+            {
+                throw RSGISClassificationException("Could not parse value '" + token + "' for '" + key + "'.");
+            }
+            vals.push_back((int)val);
+        }
+        if((expectedNum > 0) && (vals.size() != expectedNum))
+        {
+            throw RSGISClassificationException("Model has the wrong number of values for '" + key + "'.");
+        }
+        return vals;
+    }
+
+    RSGISTreeEnsemble::~RSGISTreeEnsemble()
+    {
+
+    }
+
+
+
+    RSGISApplyTreeEnsemble::RSGISApplyTreeEnsemble(RSGISTreeEnsemble *model, std::vector<unsigned int> featureBands, float maskVal, std::vector<unsigned int> clsOutIDs, bool outputProbs) : rsgis::img::RSGISCalcImageValue(outputProbs?model->getNumClasses():1)
+    {
+        if(featureBands.size() != model->getNumFeatures())
+        {
+            throw RSGISClassificationException("The number of image bands does not match the number of features of the model.");
+        }
+        if(clsOutIDs.size() != model->getNumClasses())
+        {
+            throw RSGISClassificationException("An output class ID must be provided for each class of the model.");
+        }
+        this->model = model;
+        this->featureBands = featureBands;
+        this->maskVal = maskVal;
+        this->clsOutIDs = clsOutIDs;
+        this->outputProbs = outputProbs;
+    }
+
+    void RSGISApplyTreeEnsemble::calcImageValue(float *bandValues, int numBands, double *output)
+    {
+        if(bandValues[0] != this->maskVal)
+        {
+            for(int i = 0; i < this->numOutBands; ++i)
+            {
+                output[i] = 0;
+            }
+        }
+        else if(this->outputProbs)
+        {
+            this->classifyPxl(bandValues, numBands, output);
+        }
+        else
+        {
+            // Per thread so the calculator can be used by several threads at once.
+            static thread_local std::vector<double> probs;
+            probs.resize(this->model->getNumClasses());
+            output[0] = this->classifyPxl(bandValues, numBands, probs.data());
+        }
+    }
+
+    void RSGISApplyTreeEnsemble::calcImageValue(float *bandValues, int numBands, double *output, double *outRefVal, unsigned int nOutRefVals)
+    {
+        if(bandValues[0] != this->maskVal)
+        {
+            for(int i = 0; i < this->numOutBands; ++i)
+            {
+                output[i] = 0;
+            }
+            outRefVal[0] = 0;
+        }
+        else
+        {
+            static thread_local std::vector<double> probs;
+            probs.resize(this->model->getNumClasses());
+            outRefVal[0] = this->classifyPxl(bandValues, numBands, probs.data());
+            if(this->outputProbs)
+            {
+                for(int i = 0; i < this->numOutBands; ++i)
+                {
+                    output[i] = probs[i];
+                }
+            }
+            else
+            {
+                output[0] = outRefVal[0];
+            }
+        }
+    }
+
+    unsigned int RSGISApplyTreeEnsemble::classifyPxl(float *bandValues, int numBands, double *probs)
+    {
+        static thread_local std::vector<float> features;
+        features.resize(this->featureBands.size());
+        for(size_t i = 0; i < this->featureBands.size(); ++i)
+        {
+            if(this->featureBands[i] >= (unsigned int)numBands)
+            {
+                throw rsgis::img::RSGISImageCalcException("A feature band is not within the input image bands.");
+            }
+            features[i] = bandValues[this->featureBands[i]];
+        }
+        return this->clsOutIDs[this->model->predict(features.data(), probs)];
+    }
+
+    RSGISApplyTreeEnsemble::~RSGISApplyTreeEnsemble()
+    {
+
+    }
+
+}}
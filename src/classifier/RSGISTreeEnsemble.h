@@ -0,0 +1,182 @@
+/*
+ *  RSGISTreeEnsemble.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISTreeEnsemble_H
+#define RSGISTreeEnsemble_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <limits>
+#include <cstdlib>
+
+#include "img/RSGISCalcImageValue.h"
+#include "img/RSGISImageCalcException.h"
+#include "common/RSGISClassificationException.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_classify_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{ namespace classifier{
+
+    /**
+     * A node of a flattened tree. Leaves have a feature of -1 and left is the
+     * offset of the leaf values; otherwise left and right are the indexes of the
+     * child nodes within the ensemble node array.
+     */
+    struct DllExport RSGISTreeNode
+    {
+        int feature;
+        double threshold;
+        int left;
+        int right;
+        unsigned char flags;
+    };
+
+    /**
+     * A tree ensemble classifier (random forest / extra trees or gradient boosted
+     * trees) held as a single flattened array of nodes which can be evaluated for
+     * many pixels concurrently (the model is not modified by predict).
+     *
+     * Models are read from LightGBM text model files (as saved by Booster.save_model)
+     * or the rsgislib tree ensemble text format, which rsgislib.classification writes
+     * for scikit-learn forests and XGBoost models:
+     *
+     *     rsgislib_tree_ensemble
+     *     ensemble_type=average|boosted
+     *     num_features=N
+     *     num_classes=K
+     *     output_transform=none|sigmoid|softmax
+     *     num_outputs=n (optional, default K; 1 for a binary boosted model with a sigmoid)
+     *     base_score=v (optional, num_outputs values)
+     *     split_compare=le|lt
+     *
+     *     Tree=0
+     *     tree_class=c (boosted, the class the tree contributes to)
+     *     split_feature=... (for each node, -1 for leaves)
+     *     threshold=...
+     *     left_child=... (node indexes, -1 for leaves)
+     *     right_child=...
+     *     default_left=... (1 if missing (NaN) values go left)
+     *     leaf_value=... (in node order for the leaves, K values per leaf if averaged, otherwise 1)
+     *
+     * For averaged ensembles the leaf values are the class probabilities which are
+     * averaged over the trees. For boosted ensembles the leaf values are summed for
+     * each class (with the base score) and transformed to probabilities; a binary
+     * model (sigmoid with a single output) gives 2 classes.
+     */
+    class DllExport RSGISTreeEnsemble
+    {
+    public:
+        RSGISTreeEnsemble();
+        void loadModel(std::string modelFile);
+        unsigned int getNumFeatures(){return this->numFeatures;};
+        unsigned int getNumClasses(){return this->numClasses;};
+        unsigned int getNumTrees(){return this->treeRoots.size();};
+        /** Calculates the probabilities (getNumClasses() values) for the features, returning the index of the most probable class. */
+        unsigned int predict(const float *features, double *probs) const;
+        ~RSGISTreeEnsemble();
+    protected:
+        enum RSGISTreeNodeFlags
+        {
+            nodeDefaultLeft = 1,
+            nodeMissingNaN = 2,
+            nodeMissingZero = 4,
+            nodeCompareLess = 8
+        };
+        enum RSGISTreeTransform
+        {
+            transformNone = 0,
+            transformSigmoid = 1,
+            transformSoftmax = 2
+        };
+        typedef std::map<std::string, std::string> RSGISModelSection;
+        void readSections(std::ifstream &modelStream, RSGISModelSection *header, std::vector<RSGISModelSection> *trees);
+        void readLightGBMModel(RSGISModelSection &header, std::vector<RSGISModelSection> &trees);
+        void readRSGISModel(RSGISModelSection &header, std::vector<RSGISModelSection> &trees);
+        void checkModel();
+        /** Parses the whitespace separated values of the key; if expectedNum > 0 there must be that many values. */
+        std::vector<double> parseDoubles(RSGISModelSection &section, std::string key, size_t expectedNum);
+        std::vector<int> parseInts(RSGISModelSection &section, std::string key, size_t expectedNum);
+        const RSGISTreeNode* findLeaf(const float *features, int root) const;
+        bool averaged;
+        bool averageOutput;
+        unsigned int numFeatures;
+        unsigned int numClasses;
+        unsigned int numOutputs;
+        RSGISTreeTransform transform;
+        double sigmoidScale;
+        std::vector<double> baseScore;
+        std::vector<RSGISTreeNode> nodes;
+        std::vector<double> leafVals;
+        std::vector<int> treeRoots;
+        std::vector<unsigned int> treeOutputs;
+    };
+
+    /**
+     * Applies a tree ensemble to an image. The first band is a mask and only
+     * pixels with the mask value are classified; the features are the bands
+     * (within all the input bands, starting at 0) in featureBands. The class IDs
+     * output for each class (index) are given by clsOutIDs. Pixels outside the
+     * mask are 0 in the outputs.
+     *
+     * calcImageValue(bandValues, numBands, output) outputs the class ID if
+     * outputProbs is false, otherwise the class probabilities. With the
+     * reference value (RSGISCalcImage::calcImage with an outputRefIntImage) the
+     * class probabilities are output and the class ID is the reference value.
+     * The calculation does not modify the calculator so can be used with
+     * RSGISCalcImage::setNumThreads.
+     */
+    class DllExport RSGISApplyTreeEnsemble : public rsgis::img::RSGISCalcImageValue
+    {
+    public:
+        RSGISApplyTreeEnsemble(RSGISTreeEnsemble *model, std::vector<unsigned int> featureBands, float maskVal, std::vector<unsigned int> clsOutIDs, bool outputProbs);
+        void calcImageValue(float *bandValues, int numBands, double *output);
+        void calcImageValue(float *bandValues, int numBands, double *output, double *outRefVal, unsigned int nOutRefVals);
+        ~RSGISApplyTreeEnsemble();
+    protected:
+        /** Returns the class ID for a pixel within the mask, with the class probabilities in probs. */
+        unsigned int classifyPxl(float *bandValues, int numBands, double *probs);
+        RSGISTreeEnsemble *model;
+        std::vector<unsigned int> featureBands;
+        float maskVal;
+        std::vector<unsigned int> clsOutIDs;
+        bool outputProbs;
+    };
+
+}}
+
+#endif
@@ -32,6 +32,9 @@
 
 #include "classifier/RSGISRATClassificationUtils.h"
 #include "classifier/RSGISGenAccuracyPoints.h"
+#include "classifier/RSGISTreeEnsemble.h"
+
+#include "img/RSGISCalcImage.h"
 
 #include "utils/RSGISFileUtils.h"
 
@@ -365,5 +368,102 @@ namespace rsgis{ namespace cmds {
         }
     }
 
+    void executeApplyTreeEnsemble(std::string modelFile, std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskVal, std::string outClassImage, std::string outProbsImage, std::string gdalFormat, std::vector<unsigned int> clsOutIDs, unsigned int numThreads)
+    {
+        GDALAllRegister();
+        GDALDataset **datasets = NULL;
+        unsigned int numDS = imageFiles.size() + 1;
+        try
+        {
+            rsgis::classifier::RSGISTreeEnsemble model;
+            model.loadModel(modelFile);
+            std::cout << "Loaded tree ensemble with " << model.getNumTrees() << " trees, " << model.getNumFeatures() << " features and " << model.getNumClasses() << " classes.\n";
+
+            if(clsOutIDs.empty())
+            {
+                for(unsigned int i = 0; i < model.getNumClasses(); ++i)
+                {
+                    clsOutIDs.push_back(i+1);
+                }
+            }
+
+            datasets = new GDALDataset*[numDS];
+            for(unsigned int i = 0; i < numDS; ++i)
+            {
+                datasets[i] = NULL;
+            }
+            datasets[0] = (GDALDataset *) GDALOpen(maskImage.c_str(), GA_ReadOnly);
+            if(datasets[0] == NULL)
+            {
+                std::string message = std::string("Could not open image ") + maskImage;
+                throw RSGISImageException(message.c_str());
+            }
+            if(datasets[0]->GetRasterCount() != 1)
+            {
+                throw RSGISImageException("Image mask must only have 1 image band.");
+            }
+
+            // The features are the selected bands within all the input bands (the mask is band 0).
+            std::vector<unsigned int> featureBands;
+            unsigned int cImgBandCount = 1;
+            for(unsigned int i = 0; i < imageFiles.size(); ++i)
+            {
+                datasets[i+1] = (GDALDataset *) GDALOpen(imageFiles.at(i).first.c_str(), GA_ReadOnly);
+                if(datasets[i+1] == NULL)
+                {
+                    std::string message = std::string("Could not open image ") + imageFiles.at(i).first;
+                    throw RSGISImageException(message.c_str());
+                }
+                for(auto iterBands = imageFiles.at(i).second.begin(); iterBands != imageFiles.at(i).second.end(); ++iterBands)
+                {
+                    if(((*iterBands) < 1) || ((*iterBands) > (unsigned int)datasets[i+1]->GetRasterCount()))
+                    {
+                        throw RSGISImageException("Band numbers start at 1 and equal or less than the number of bands within the image file.");
+                    }
+                    featureBands.push_back(cImgBandCount + ((*iterBands) - 1));
+                }
+                cImgBandCount += datasets[i+1]->GetRasterCount();
+            }
+
+            bool outputProbs = (outProbsImage != "");
+            rsgis::classifier::RSGISApplyTreeEnsemble applyModel(&model, featureBands, maskVal, clsOutIDs, outputProbs);
+            rsgis::img::RSGISCalcImage calcImg(&applyModel, "", true);
+            calcImg.setNumThreads(numThreads);
+            if(outputProbs)
+            {
+                calcImg.calcImage(datasets, numDS, outProbsImage, outClassImage, gdalFormat, GDT_Float32);
+            }
+            else
+            {
+                calcImg.calcImage(datasets, numDS, outClassImage, false, NULL, gdalFormat, GDT_UInt32);
+            }
+
+            for(unsigned int i = 0; i < numDS; ++i)
+            {
+                GDALClose(datasets[i]);
+            }
+            delete[] datasets;
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            if(datasets != NULL)
+            {
+                for(unsigned int i = 0; i < numDS; ++i)
+                {
+                    if(datasets[i] != NULL)
+                    {
+                        GDALClose(datasets[i]);
+                    }
+                }
+                delete[] datasets;
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+
 }}
 
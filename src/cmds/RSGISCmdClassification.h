@@ -61,6 +61,9 @@ namespace rsgis{ namespace cmds {
     /** A function to populate a set of points with the class information to assess the accuracy of a map */
     DllExport void executePopClassInfoAccuracyPts(std::string classImage, std::string vecFile, std::string vecLyr, std::string classImgCol, std::string classImgVecCol, std::string classRefVecCol="", bool addRefCol=false, std::string processVecCol="", bool addProcessCol=false);
 
+    /** A function to apply a tree ensemble classifier (LightGBM text model or rsgislib tree ensemble) to the pixels of the selected image bands within a mask, outputting the class IDs and optionally the class probabilities */
+    DllExport void executeApplyTreeEnsemble(std::string modelFile, std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskVal, std::string outClassImage, std::string outProbsImage="", std::string gdalFormat="KEA", std::vector<unsigned int> clsOutIDs=std::vector<unsigned int>(), unsigned int numThreads=0);
+
 }}
 #endif
 
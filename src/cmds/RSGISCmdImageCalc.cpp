@@ -52,10 +52,12 @@
 #include "img/RSGISApplyGainOffset2Img.h"
 #include "img/RSGISImgSummaryStatsFromMultiResImgs.h"
 #include "img/RSGISCalcImageLocalMin.h"
+#include "img/RSGISImageCalcValueBaysianNoPrior.h"
 
 #include "math/RSGISVectors.h"
 #include "math/RSGISMatrices.h"
 #include "math/RSGISMathsUtils.h"
+#include "math/RSGISFunctions.h"
 
 #include "utils/RSGISTextUtils.h"
 #include "utils/RSGISFileUtils.h"
@@ -71,7 +73,7 @@
 
 namespace rsgis{ namespace cmds {
 
-    void executeBandMaths(VariableStruct *variables, unsigned int numVars, std::string outputImage, std::string mathsExpression, std::string gdalFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg)
+    void executeBandMaths(VariableStruct *variables, unsigned int numVars, std::string outputImage, std::string mathsExpression, std::string gdalFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg, bool skipNoDataBlocks, float noDataVal)
     {
         GDALAllRegister();
         GDALDataset **datasets = NULL;
@@ -182,6 +184,7 @@ namespace rsgis{ namespace cmds {
 
             bandmaths = new rsgis::img::RSGISBandMath(1, processVaribles, numVars, muParser);
             calcImage = new rsgis::img::RSGISCalcImage(bandmaths, "", true);
+            calcImage->setSkipNoDataBlocks(skipNoDataBlocks, noDataVal, noDataVal, true);
             if(editOutputImg)
             {
                 calcImage->calcImagePartialOutput(datasets, total_n_imgs, outDataset);
@@ -236,7 +239,7 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    void executeImageMaths(std::string inputImage, std::string outputImage, std::string mathsExpression, std::string imageFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg)
+    void executeImageMaths(std::string inputImage, std::string outputImage, std::string mathsExpression, std::string imageFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg, bool skipNoDataBlocks, float noDataVal)
     {
         GDALAllRegister();
         GDALDataset **datasets = NULL;
@@ -296,6 +299,7 @@ namespace rsgis{ namespace cmds {
             imageMaths = new rsgis::img::RSGISImageMaths(numRasterBands, muParser);
 
             calcImage = new rsgis::img::RSGISCalcImage(imageMaths, "", true);
+            calcImage->setSkipNoDataBlocks(skipNoDataBlocks, noDataVal, noDataVal, true);
             
             if(editOutputImg)
             {
@@ -457,7 +461,7 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    void executeKMeansClustering(std::string inputImage, std::string outputMatrixFile, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, RSGISInitClustererMethods initClusterMethod)
+    void executeKMeansClustering(std::string inputImage, std::string outputMatrixFile, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, RSGISInitClustererMethods initClusterMethod, RSGISPxlSampleMethods sampleMethod, unsigned long numSamples, unsigned int rndSeed, unsigned int numThreads)
     {
         
         std::cout << "inputImage = " << inputImage << std::endl;
@@ -509,7 +513,7 @@ namespace rsgis{ namespace cmds {
                     break;
             }
 
-            rsgis::img::RSGISImageClustering imgClustering;
+            rsgis::img::RSGISImageClustering imgClustering((rsgis::img::RSGISImgSampleMethod)sampleMethod, numSamples, rndSeed, numThreads);
             imgClustering.findKMeansCentres(dataset, outputMatrixFile, numClusters, maxNumIterations, subSample, ignoreZeros, degreeOfChange, initMethod);
 
             GDALClose(dataset);
@@ -524,7 +528,7 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    void executeISODataClustering(std::string inputImage, std::string outputMatrixFile, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, RSGISInitClustererMethods initClusterMethod, float minDistBetweenClusters, unsigned int minNumFeatures, float maxStdDev, unsigned int minNumClusters, unsigned int startIteration, unsigned int endIteration)
+    void executeISODataClustering(std::string inputImage, std::string outputMatrixFile, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, RSGISInitClustererMethods initClusterMethod, float minDistBetweenClusters, unsigned int minNumFeatures, float maxStdDev, unsigned int minNumClusters, unsigned int startIteration, unsigned int endIteration, RSGISPxlSampleMethods sampleMethod, unsigned long numSamples, unsigned int rndSeed, unsigned int numThreads)
     {
         try
         {
@@ -563,7 +567,7 @@ namespace rsgis{ namespace cmds {
                     break;
             }
 
-            rsgis::img::RSGISImageClustering imgClustering;
+            rsgis::img::RSGISImageClustering imgClustering((rsgis::img::RSGISImgSampleMethod)sampleMethod, numSamples, rndSeed, numThreads);
             imgClustering.findISODataCentres(dataset, outputMatrixFile, numClusters, maxNumIterations, subSample, ignoreZeros, degreeOfChange, initMethod, minDistBetweenClusters, minNumFeatures, maxStdDev, minNumClusters, startIteration, endIteration);
 
             GDALClose(dataset);
@@ -1336,7 +1340,7 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    double executeCalculateRMSE(std::string inputImageA, int inputBandA, std::string inputImageB, int inputBandB)
+    double executeCalculateRMSE(std::string inputImageA, int inputBandA, std::string inputImageB, int inputBandB, unsigned int numThreads)
     {
         GDALAllRegister();
         GDALDataset **datasetsA = NULL;
@@ -1372,7 +1376,7 @@ namespace rsgis{ namespace cmds {
             }
 
             calculateRSME = new rsgis::img::RSGISCalcRMSE(1);
-            calcImgSingle = new rsgis::img::RSGISCalcImageSingle(calculateRSME);
+            calcImgSingle = new rsgis::img::RSGISCalcImageSingle(calculateRSME, numThreads);
             calcImgSingle->calcImage(datasetsA, datasetsB, 1, outRMSE, inputBandA, inputBandB);
             
             rmse = outRMSE[0];
@@ -1404,6 +1408,63 @@ namespace rsgis{ namespace cmds {
         return rmse;
     }
 
+    ImagePairStatsCmds executeCalcImageBandPairStats(std::string inputImageA, unsigned int inputBandA, std::string inputImageB, unsigned int inputBandB, unsigned int numThreads)
+    {
+        GDALAllRegister();
+        ImagePairStatsCmds pairStats;
+        GDALDataset *datasetA = NULL;
+        GDALDataset *datasetB = NULL;
+        try
+        {
+            datasetA = (GDALDataset *) GDALOpenShared(inputImageA.c_str(), GA_ReadOnly);
+            if(datasetA == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImageA;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            datasetB = (GDALDataset *) GDALOpenShared(inputImageB.c_str(), GA_ReadOnly);
+            if(datasetB == NULL)
+            {
+                GDALClose(datasetA);
+                std::string message = std::string("Could not open image ") + inputImageB;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            if((inputBandA == 0) || (inputBandB == 0))
+            {
+                GDALClose(datasetA);
+                GDALClose(datasetB);
+                throw rsgis::RSGISImageException("Band numbers start at 1.");
+            }
+
+            std::vector<std::pair<int, int> > bandPairs;
+            bandPairs.push_back(std::pair<int, int>(inputBandA-1, inputBandB-1));
+            std::vector<rsgis::img::RSGISImagePairMoments> moments;
+            rsgis::img::RSGISCalcImageSingle calcImgSingle(NULL, numThreads);
+            calcImgSingle.calcImagePairMoments(&datasetA, &datasetB, 1, bandPairs, &moments);
+
+            pairStats.n = moments[0].getN();
+            pairStats.meanA = moments[0].getMeanA();
+            pairStats.meanB = moments[0].getMeanB();
+            pairStats.varianceA = moments[0].getVarianceA();
+            pairStats.varianceB = moments[0].getVarianceB();
+            pairStats.covariance = moments[0].getCovariance();
+            pairStats.correlation = moments[0].getCorrelation();
+            pairStats.rmse = moments[0].getRMSE();
+
+            GDALClose(datasetA);
+            GDALClose(datasetB);
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return pairStats;
+    }
+
     void executeImageBandStats(std::string inputImage, std::string outputFile, bool ignoreZeros)
     {
         GDALAllRegister();
@@ -2777,9 +2838,8 @@ namespace rsgis{ namespace cmds {
             
             GDALDataType gdalDataType = dataset->GetRasterBand(1)->GetRasterDataType();
             
-            rsgis::img::RSGISCalcLocalMinInWin calcLclWinMin = rsgis::img::RSGISCalcLocalMinInWin(bands, noDataValue, useNoDataValue);
-            rsgis::img::RSGISCalcImage calcImage = rsgis::img::RSGISCalcImage(&calcLclWinMin, "", true);
-            calcImage.calcImageWindowData(&dataset, 1, outputImg, outputRefImg, winSize, gdalFormat, gdalDataType);
+            rsgis::img::RSGISFindLocalMinInWin findLclWinMin = rsgis::img::RSGISFindLocalMinInWin(bands, noDataValue, useNoDataValue);
+            findLclWinMin.findLocalMin(dataset, outputImg, outputRefImg, winSize, gdalFormat, gdalDataType);
             
             GDALClose(dataset);
         }
@@ -2848,6 +2908,49 @@ namespace rsgis{ namespace cmds {
         }
         return outImgVal;
     }
+    
+    void executeCalcBaysianPosteriorStats(std::string inputImg, std::string outputImg, std::string gdalFormat, std::string fxExpression, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, bool useCache, double cacheTolerance, unsigned long maxCacheEntries)
+    {
+        GDALDataset *dataset = NULL;
+        try
+        {
+            GDALAllRegister();
+            
+            dataset = (GDALDataset *) GDALOpen(inputImg.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImg;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            if(dataset->GetRasterCount() != 1)
+            {
+                throw rsgis::RSGISImageException("Input image must only have one image band.");
+            }
+            
+            rsgis::math::RSGISFunctionMuParser fxFunction(fxExpression);
+            rsgis::img::RSGISImageCalcValueBaysianNoPrior calcBaysian(5, &fxFunction, variance, interval, minVal, maxVal, lowerLimit, upperLimit, rsgis::math::area, useCache, cacheTolerance, maxCacheEntries);
+            rsgis::img::RSGISCalcImage calcImage = rsgis::img::RSGISCalcImage(&calcBaysian, "", true);
+            calcImage.calcImage(&dataset, 1, outputImg, false, NULL, gdalFormat, GDT_Float32);
+            
+            GDALClose(dataset);
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch (std::exception &e)
+        {
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+    }
                 
 }}
 
@@ -66,6 +66,18 @@ namespace rsgis{ namespace cmds {
         double mode;
 	};
 
+    struct DllExport ImagePairStatsCmds
+    {
+        unsigned long n;
+        double meanA;
+        double meanB;
+        double varianceA;
+        double varianceB;
+        double covariance;
+        double correlation;
+        double rmse;
+    };
+
     enum RSGISInitClustererMethods
     {
         rsgis_init_random,
@@ -76,6 +88,13 @@ namespace rsgis{ namespace cmds {
         rsgis_init_kpp
     };
     
+    enum RSGISPxlSampleMethods
+    {
+        rsgis_pxlsample_stride = 0,
+        rsgis_pxlsample_reservoir = 1,
+        rsgis_pxlsample_stratified = 2
+    };
+    
     enum RSGISCmdsSummariseStats
     {
         rsgiscmds_stat_none,
@@ -91,15 +110,15 @@ namespace rsgis{ namespace cmds {
     };
 
     /** Function to run the band maths tools */
-    DllExport void executeBandMaths(VariableStruct *variables, unsigned int numVars, std::string outputImage, std::string mathsExpression, std::string gdalFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg=false);
+    DllExport void executeBandMaths(VariableStruct *variables, unsigned int numVars, std::string outputImage, std::string mathsExpression, std::string gdalFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg=false, bool skipNoDataBlocks=false, float noDataVal=0.0);
     /** Function to run the image maths tools */
-    DllExport void executeImageMaths(std::string inputImage, std::string outputImage, std::string mathsExpression, std::string imageFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg=false);
+    DllExport void executeImageMaths(std::string inputImage, std::string outputImage, std::string mathsExpression, std::string imageFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg=false, bool skipNoDataBlocks=false, float noDataVal=0.0);
     /** Function to run the image band maths tools */
     DllExport void executeImageBandMaths(std::string inputImage, std::string outputImage, std::string mathsExpression, std::string imageFormat, RSGISLibDataType outDataType, bool useExpAsbandName, bool editOutputImg=false);
     /** Function to run the KMeans tool */
-    DllExport void executeKMeansClustering(std::string inputImage, std::string outputMatrixFile, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, RSGISInitClustererMethods initClusterMethod);
+    DllExport void executeKMeansClustering(std::string inputImage, std::string outputMatrixFile, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, RSGISInitClustererMethods initClusterMethod, RSGISPxlSampleMethods sampleMethod=rsgis_pxlsample_stride, unsigned long numSamples=0, unsigned int rndSeed=0, unsigned int numThreads=0);
     /** Function to run the KMeans tool */
-    DllExport void executeISODataClustering(std::string inputImage, std::string outputMatrixFile, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, RSGISInitClustererMethods initClusterMethod, float minDistBetweenClusters, unsigned int minNumFeatures, float maxStdDev, unsigned int minNumClusters, unsigned int startIteration, unsigned int endIteration);
+    DllExport void executeISODataClustering(std::string inputImage, std::string outputMatrixFile, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, RSGISInitClustererMethods initClusterMethod, float minDistBetweenClusters, unsigned int minNumFeatures, float maxStdDev, unsigned int minNumClusters, unsigned int startIteration, unsigned int endIteration, RSGISPxlSampleMethods sampleMethod=rsgis_pxlsample_stride, unsigned long numSamples=0, unsigned int rndSeed=0, unsigned int numThreads=0);
     /** Function to run mahalanobis distance Window Filter */
     DllExport void executeMahalanobisDistFilter(std::string inputImage, std::string outputImage, unsigned int winSize, std::string gdalFormat, RSGISLibDataType outDataType);
     /** Function to run mahalanobis distance Image to Window Filter */
@@ -123,7 +142,9 @@ namespace rsgis{ namespace cmds {
     /** Function that counts the number of values with a given range for each column*/
     DllExport void executeCountValsInCols(std::string inputImage, float upper, float lower, std::string outputImage);
     /** Function to calculate the root mean squared error between 2 images */
-    DllExport double executeCalculateRMSE(std::string inputImageA, int inputBandA, std::string inputImageB, int inputBandB);
+    DllExport double executeCalculateRMSE(std::string inputImageA, int inputBandA, std::string inputImageB, int inputBandB, unsigned int numThreads=0);
+    /** Function to calculate the RMSE, covariance and correlation (and the band means and variances) between bands of 2 images in a single pass. Bands start at 1. */
+    DllExport ImagePairStatsCmds executeCalcImageBandPairStats(std::string inputImageA, unsigned int inputBandA, std::string inputImageB, unsigned int inputBandB, unsigned int numThreads=0);
     /** Function to calculate statistics for individual image bands */
     DllExport void executeImageBandStats(std::string inputImage, std::string outputFile, bool ignoreZeros);
     /** Function to calculate the statistics for the whole image across all bands */
@@ -166,6 +187,8 @@ namespace rsgis{ namespace cmds {
     DllExport void executeIdentifyMinPxlValueInWin(std::string inputImg, std::string outputImg, std::string outputRefImg, std::vector<unsigned int> bands, unsigned int winSize, std::string gdalFormat, float noDataValue, bool useNoDataValue);
     /** A function to calculate a mean value across a number of image bands within a mask */
     DllExport float executeCalcImgMeanInMask(std::string inputImg, std::string inputImgMsk, int mskValue, std::vector<unsigned int> bands, float noDataValue, bool useNoDataValue);
+    /** A function to calculate the Bayesian (no prior) posterior summary (lower, maximum likelihood, upper, delta-, delta+) for each pixel of a single band image */
+    DllExport void executeCalcBaysianPosteriorStats(std::string inputImg, std::string outputImg, std::string gdalFormat, std::string fxExpression, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, bool useCache=true, double cacheTolerance=0.0, unsigned long maxCacheEntries=1048576);
 
 
 }}
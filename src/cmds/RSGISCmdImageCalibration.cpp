@@ -999,7 +999,7 @@ namespace rsgis{ namespace cmds {
                 
                 std::cout << "Apply cloud majority filter...\n";
                 rsgis::calib::RSGISCalcImageCloudMajorityFilter cloudMajFilter = rsgis::calib::RSGISCalcImageCloudMajorityFilter();
-                rsgis::img::RSGISCalcEditImage editImgCalc = rsgis::img::RSGISCalcEditImage(&cloudMajFilter);
+                rsgis::img::RSGISCalcEditImage editImgCalc = rsgis::img::RSGISCalcEditImage(&cloudMajFilter, 0);
                 editImgCalc.calcImageWindowData(cloudMaskDS, 5);
                 
                 
@@ -1126,7 +1126,7 @@ namespace rsgis{ namespace cmds {
                 
                 std::cout << "Apply cloud shadow majority filter...\n";
                 rsgis::calib::RSGISCalcImageCloudMajorityFilter cloudShadowMajFilter = rsgis::calib::RSGISCalcImageCloudMajorityFilter();
-                rsgis::img::RSGISCalcEditImage editImgCalcShadow = rsgis::img::RSGISCalcEditImage(&cloudShadowMajFilter);
+                rsgis::img::RSGISCalcEditImage editImgCalcShadow = rsgis::img::RSGISCalcEditImage(&cloudShadowMajFilter, 0);
                 editImgCalcShadow.calcImageWindowData(cloudShadowRegionsDS, 5);
                  
                 rsgis::math::RSGISMatrices matrixUtils;
@@ -1504,6 +1504,65 @@ namespace rsgis{ namespace cmds {
     }
     
                 
+    void executeCloudMajorityFilter(std::string inputImage, std::string outputImage, std::string gdalFormat, unsigned int winSize, unsigned int numThreads)
+    {
+        GDALDataset *dataset = NULL;
+        GDALDataset *outDataset = NULL;
+        try
+        {
+            GDALAllRegister();
+            
+            dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            if(dataset->GetRasterCount() != 1)
+            {
+                throw rsgis::RSGISImageException("The input image must only have 1 band.");
+            }
+            
+            rsgis::img::RSGISImageUtils imgUtils;
+            outDataset = imgUtils.createCopy(dataset, 1, outputImage, gdalFormat, GDT_Byte);
+            rsgis::img::RSGISCopyImage copyImage = rsgis::img::RSGISCopyImage(1);
+            rsgis::img::RSGISCalcImage calcImage = rsgis::img::RSGISCalcImage(&copyImage, "", true);
+            calcImage.calcImage(&dataset, 1, outDataset);
+            
+            // The filter is edited in place on the output image.
+            rsgis::calib::RSGISCalcImageCloudMajorityFilter cloudMajFilter = rsgis::calib::RSGISCalcImageCloudMajorityFilter();
+            rsgis::img::RSGISCalcEditImage editImgCalc = rsgis::img::RSGISCalcEditImage(&cloudMajFilter, numThreads);
+            editImgCalc.calcImageWindowData(outDataset, winSize);
+            
+            GDALClose(outDataset);
+            GDALClose(dataset);
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception &e)
+        {
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+    }
+    
     void executeCalcNadirImageViewAngle(std::string imgFootprint, std::string outViewAngleImg, std::string gdalFormat, double sateAltitude, std::string minXXCol, std::string minXYCol, std::string maxXXCol, std::string maxXYCol, std::string minYXCol, std::string minYYCol, std::string maxYXCol, std::string maxYYCol) 
     {
         try
@@ -1908,7 +1967,7 @@ namespace rsgis{ namespace cmds {
 
             std::cout << "Apply cloud shadow majority filter...\n";
             rsgis::calib::RSGISCalcImageCloudMajorityFilter cloudShadowMajFilter = rsgis::calib::RSGISCalcImageCloudMajorityFilter();
-            rsgis::img::RSGISCalcEditImage editImgCalcShadow = rsgis::img::RSGISCalcEditImage(&cloudShadowMajFilter);
+            rsgis::img::RSGISCalcEditImage editImgCalcShadow = rsgis::img::RSGISCalcEditImage(&cloudShadowMajFilter, 0);
             editImgCalcShadow.calcImageWindowData(cloudShadowRegionsDS, 5);
             
             rsgis::math::RSGISMatrices matrixUtils;
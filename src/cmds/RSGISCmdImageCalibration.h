@@ -186,6 +186,9 @@ namespace rsgis{ namespace cmds {
     /** Function to calculate the Earth / Sun distance for a julian day */
     DllExport float executeGetEarthSunDistance(unsigned int julianDay);
     
+    /** Function to apply the cloud majority filter (as used within the cloud masking) to a binary cloud mask */
+    DllExport void executeCloudMajorityFilter(std::string inputImage, std::string outputImage, std::string gdalFormat, unsigned int winSize, unsigned int numThreads);
+    
     /** Function to identify cloud shadows */
     DllExport void executePerformCloudShadowMasking(std::string cloudMsk, std::string inputImage, std::string validAreaImage, unsigned int darkFillBand, std::string outputImg, std::string gdalFormat, float scaleFactorIn, std::string tmpImgsBase, std::string tmpImgFileExt, bool rmTmpImgs, double sunAz, double sunZen, double senAz, double senZen);
     
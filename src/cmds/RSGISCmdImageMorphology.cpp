@@ -338,7 +338,7 @@ namespace rsgis{ namespace cmds {
     }
     
     /** A function to perform a morphological operation to find local minima */
-    void executeImageLocalMinima(std::string inImage, std::string outImage, bool outputSequencial, bool allowEquals, std::string morphOperatorFile, bool useOperatorFile, unsigned int morphOpSize, std::string gdalFormat, RSGISLibDataType outDataType)
+    void executeImageLocalMinima(std::string inImage, std::string outImage, bool outputSequencial, bool allowEquals, std::string morphOperatorFile, bool useOperatorFile, unsigned int morphOpSize, std::string gdalFormat, RSGISLibDataType outDataType, bool resolvePlateaus)
     {
         try
         {
@@ -373,7 +373,7 @@ namespace rsgis{ namespace cmds {
             }
             
             rsgis::filter::RSGISImageMorphologyFindExtrema morphObj;
-            morphObj.findMinima(&dataset, outImage, matrixOperator, minOutType, allowEquals, gdalFormat, RSGIS_to_GDAL_Type(outDataType));
+            morphObj.findMinima(&dataset, outImage, matrixOperator, minOutType, allowEquals, gdalFormat, RSGIS_to_GDAL_Type(outDataType), resolvePlateaus);
             
             GDALClose(dataset);
             matrixUtils.freeMatrix(matrixOperator);
@@ -393,7 +393,7 @@ namespace rsgis{ namespace cmds {
     }
     
     /** A function to perform a morphological operation to find local minima combining the results of the output bands into a single image band */
-    void executeImageLocalMinimaCombinedOut(std::string inImage, std::string outImage, bool outputSequencial, bool allowEquals, std::string morphOperatorFile, bool useOperatorFile, unsigned int morphOpSize, std::string gdalFormat, RSGISLibDataType outDataType)
+    void executeImageLocalMinimaCombinedOut(std::string inImage, std::string outImage, bool outputSequencial, bool allowEquals, std::string morphOperatorFile, bool useOperatorFile, unsigned int morphOpSize, std::string gdalFormat, RSGISLibDataType outDataType, bool resolvePlateaus)
     {
         try
         {
@@ -428,7 +428,7 @@ namespace rsgis{ namespace cmds {
             }
             
             rsgis::filter::RSGISImageMorphologyFindExtrema morphObj;
-            morphObj.findMinimaAll(&dataset, outImage, matrixOperator, minOutType, allowEquals, gdalFormat, RSGIS_to_GDAL_Type(outDataType));
+            morphObj.findMinimaAll(&dataset, outImage, matrixOperator, minOutType, allowEquals, gdalFormat, RSGIS_to_GDAL_Type(outDataType), resolvePlateaus);
             
             GDALClose(dataset);
             matrixUtils.freeMatrix(matrixOperator);
@@ -31,6 +31,7 @@
 #include "registration/RSGISStandardImageSimilarityMetrics.h"
 #include "registration/RSGISSingleConnectLayerImageRegistration.h"
 #include "registration/RSGISAddGCPsGDAL.h"
+#include "registration/RSGISWarpImageGCPs.h"
 #include "registration/RSGISFindImageOffset.h"
 
 
@@ -49,7 +50,8 @@ namespace rsgis{ namespace cmds {
                                                       std::vector<unsigned int> fltImageBands,
                                                       unsigned int xSearch, unsigned int ySearch,
                                                       unsigned int metricTypeInt,
-                                                      int subPixelResolution)
+                                                      int subPixelResolution, unsigned int numPyramidLevels,
+                                                      bool usePhaseCorr)
     {
         rsgis::utils::RSGISTextUtils txtUtils;
         GDALAllRegister();
@@ -125,6 +127,61 @@ namespace rsgis{ namespace cmds {
             }
         }
 
+        std::cout << "subPixelResolution = " << subPixelResolution << std::endl;
+        bool calcSubPxl = false;
+        if(subPixelResolution > 0)
+        {
+            calcSubPxl = true;
+        }
+
+        if((numPyramidLevels > 1) || usePhaseCorr)
+        {
+            rsgis::reg::RSGISImageSimilarityMetric *pyrSimilarityMetric = nullptr;
+            if(metricTypeInt == 1) // euclidean
+            {
+                pyrSimilarityMetric = new rsgis::reg::RSGISEuclideanSimilarityMetric();
+            }
+            else if(metricTypeInt == 2) // sqdiff
+            {
+                pyrSimilarityMetric = new rsgis::reg::RSGISSquaredDifferenceSimilarityMetric();
+            }
+            else if(metricTypeInt == 3) // manhatten
+            {
+                pyrSimilarityMetric = new rsgis::reg::RSGISManhattanSimilarityMetric();
+            }
+            else if(metricTypeInt == 4) // correlation
+            {
+                pyrSimilarityMetric = new rsgis::reg::RSGISCorrelationSimilarityMetric();
+            }
+            else
+            {
+                throw rsgis::cmds::RSGISCmdException("Metric not recognised!");
+            }
+
+            std::pair<double, double> imgOffsets;
+            try
+            {
+                rsgis::reg::RSGISFindImageOffset findImageOffset;
+                imgOffsets = findImageOffset.findImageOffsetPyramid(inRefDataset, inFloatDataset, refImageBands, fltImageBands,
+                                                                    xSearch, ySearch, pyrSimilarityMetric,
+                                                                    std::max(numPyramidLevels, (unsigned int)1), usePhaseCorr,
+                                                                    calcSubPxl, subPixelResolution);
+            }
+            catch(rsgis::RSGISException &e)
+            {
+                delete pyrSimilarityMetric;
+                GDALClose(inRefDataset);
+                GDALClose(inFloatDataset);
+                throw RSGISCmdException(e.what());
+            }
+
+            delete pyrSimilarityMetric;
+            GDALClose(inRefDataset);
+            GDALClose(inFloatDataset);
+
+            return imgOffsets;
+        }
+
         rsgis::reg::RSGISImageCalcSimilarityMetric *similarityMetric = nullptr;
         if(metricTypeInt == 1) // euclidean
         {
@@ -146,12 +203,6 @@ namespace rsgis{ namespace cmds {
         {
             throw rsgis::cmds::RSGISCmdException("Metric not recognised!");
         }
-        std::cout << "subPixelResolution = " << subPixelResolution << std::endl;
-        bool calcSubPxl = false;
-        if(subPixelResolution > 0)
-        {
-            calcSubPxl = true;
-        }
 
         // DO ANALYSIS!!
         rsgis::reg::RSGISFindImageOffset findImageOffset;
@@ -169,7 +220,7 @@ namespace rsgis{ namespace cmds {
     void excecuteBasicRegistration(std::string inputReferenceImage, std::string inputFloatingmage, int gcpGap,
                                                   float metricThreshold, int windowSize, int searchArea, float stdDevRefThreshold,
                                                   float stdDevFloatThreshold, int subPixelResolution, unsigned int metricTypeInt,
-                                                  unsigned int outputType, std::string outputGCPFile) 
+                                                  unsigned int outputType, std::string outputGCPFile, unsigned int numPyramidLevels)
     {
         
         try
@@ -216,7 +267,7 @@ namespace rsgis{ namespace cmds {
             
             rsgis::reg::RSGISImageRegistration *regImgs = new rsgis::reg::RSGISBasicImageRegistration(inRefDataset, inFloatDataset, gcpGap, metricThreshold,
                                                                                                       windowSize, searchArea, similarityMetric, stdDevRefThreshold,
-                                                                                                      stdDevFloatThreshold, subPixelResolution);
+                                                                                                      stdDevFloatThreshold, subPixelResolution, numPyramidLevels);
             
             regImgs->runCompleteRegistration();
             
@@ -378,27 +429,49 @@ namespace rsgis{ namespace cmds {
                 throw rsgis::RSGISImageException(message.c_str());
             }
             
+            // Copy the pixel values block by block in their native type rather than via calcImage.
+            GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+            if(gdalDriver == nullptr)
+            {
+                GDALClose(dataset);
+                throw rsgis::RSGISImageException("Requested GDAL driver does not exist.");
+            }
             unsigned int numBands = dataset->GetRasterCount();
-            
-            rsgis::img::RSGISCopyImage copyImage = rsgis::img::RSGISCopyImage(numBands);
-            rsgis::img::RSGISCalcImage *calcImage = new rsgis::img::RSGISCalcImage(&copyImage, "", true);
-            calcImage->calcImage(&dataset, 1, outputImage, false, nullptr, gdalFormat, RSGIS_to_GDAL_Type(outDataType));
-            
-            delete calcImage;
-            GDALClose(dataset);
-            
-            GDALDataset *outDataset = (GDALDataset *) GDALOpen(outputImage.c_str(), GA_Update);
+            rsgis::img::RSGISImageUtils imgUtils;
+            char **papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+            GDALDataset *outDataset = gdalDriver->Create(outputImage.c_str(), dataset->GetRasterXSize(), dataset->GetRasterYSize(), numBands, RSGIS_to_GDAL_Type(outDataType), papszOptions);
+            CSLDestroy(papszOptions);
             if(outDataset == nullptr)
             {
-                std::string message = std::string("Could not open image ") + outputImage;
+                GDALClose(dataset);
+                std::string message = std::string("Could not create image ") + outputImage;
                 throw rsgis::RSGISImageException(message.c_str());
             }
+            outDataset->SetProjection(dataset->GetProjectionRef());
+            for(unsigned int n = 0; n < numBands; ++n)
+            {
+                outDataset->GetRasterBand(n+1)->SetDescription(dataset->GetRasterBand(n+1)->GetDescription());
+                int hasNoData = false;
+                double noDataVal = dataset->GetRasterBand(n+1)->GetNoDataValue(&hasNoData);
+                if(hasNoData)
+                {
+                    outDataset->GetRasterBand(n+1)->SetNoDataValue(noDataVal);
+                }
+            }
+            if(GDALDatasetCopyWholeRaster(dataset, outDataset, nullptr, GDALTermProgress, nullptr) != CE_None)
+            {
+                GDALClose(outDataset);
+                GDALClose(dataset);
+                throw rsgis::RSGISImageException("Could not copy the image pixel values.");
+            }
+            
             double *trans = new double[6];
-            outDataset->GetGeoTransform(trans);
+            dataset->GetGeoTransform(trans);
             trans[0] = trans[0] + xOff;
             trans[3] = trans[3] + yOff;
             outDataset->SetGeoTransform(trans);
             GDALClose(outDataset);
+            GDALClose(dataset);
             delete[] trans;
         }
         catch(RSGISException& e)
@@ -413,5 +486,82 @@ namespace rsgis{ namespace cmds {
     
     
     
+    void executeWarpImageGCPs(std::string inputRefImage, std::string inputImage, std::string inputGCPs, std::string outputImage, std::string gdalFormat, RSGISLibDataType outDataType, unsigned int interpMethod, bool useTPS, unsigned int polyOrder, unsigned int gridStep, float noDataVal, unsigned int numThreads)
+    {
+        std::vector<rsgis::reg::RSGISGCPImg2MapNode*> gcps;
+        try
+        {
+            GDALAllRegister();
+            
+            rsgis::reg::RSGISWarpInterp interp = rsgis::reg::rsgis_warp_nearest;
+            if(interpMethod == 1)
+            {
+                interp = rsgis::reg::rsgis_warp_bilinear;
+            }
+            else if(interpMethod == 2)
+            {
+                interp = rsgis::reg::rsgis_warp_cubic;
+            }
+            else if(interpMethod != 0)
+            {
+                throw rsgis::RSGISImageException("The interpolation method must be nearest neighbour, bilinear or cubic.");
+            }
+            rsgis::reg::RSGISGCPTransformType transType = useTPS?rsgis::reg::rsgis_gcptrans_tps:rsgis::reg::rsgis_gcptrans_poly;
+            
+            rsgis::reg::RSGISAddGCPsGDAL gcpReader;
+            gcpReader.readGCPFile(inputGCPs, &gcps);
+            
+            GDALDataset *refDataset = (GDALDataset *) GDALOpen(inputRefImage.c_str(), GA_ReadOnly);
+            if(refDataset == nullptr)
+            {
+                std::string message = std::string("Could not open image ") + inputRefImage;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == nullptr)
+            {
+                GDALClose(refDataset);
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            
+            try
+            {
+                rsgis::reg::RSGISWarpImageGCPs warpImg = rsgis::reg::RSGISWarpImageGCPs(transType, polyOrder, interp, gridStep, noDataVal, numThreads);
+                warpImg.warpImage(refDataset, dataset, &gcps, outputImage, gdalFormat, RSGIS_to_GDAL_Type(outDataType));
+            }
+            catch(std::exception& e)
+            {
+                GDALClose(dataset);
+                GDALClose(refDataset);
+                throw;
+            }
+            
+            GDALClose(dataset);
+            GDALClose(refDataset);
+            for(auto iterGCPs = gcps.begin(); iterGCPs != gcps.end(); ++iterGCPs)
+            {
+                delete *iterGCPs;
+            }
+        }
+        catch(RSGISException& e)
+        {
+            for(auto iterGCPs = gcps.begin(); iterGCPs != gcps.end(); ++iterGCPs)
+            {
+                delete *iterGCPs;
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            for(auto iterGCPs = gcps.begin(); iterGCPs != gcps.end(); ++iterGCPs)
+            {
+                delete *iterGCPs;
+            }
+            throw RSGISCmdException(e.what());
+        }
+    }
+    
 }}
 
@@ -45,19 +45,20 @@
 
 namespace rsgis{ namespace cmds {
 
-    /** Find simple image offsets */
+    /** Find simple image offsets (using an image pyramid if numPyramidLevels > 1 or usePhaseCorr is true) */
     DllExport std::pair<double, double> excecuteFindImageOffset(std::string inputReferenceImage, std::string inputFloatingmage,
                                                                 std::vector<unsigned int> refImageBands,
                                                                 std::vector<unsigned int> fltImageBands,
                                                                 unsigned int xSearch, unsigned int ySearch,
                                                                 unsigned int metricTypeInt,
-                                                                int subPixelResolution);
+                                                                int subPixelResolution, unsigned int numPyramidLevels=0,
+                                                                bool usePhaseCorr=false);
 
     /** Basic image registration */
     DllExport void excecuteBasicRegistration(std::string inputReferenceImage, std::string inputFloatingmage, int gcpGap,
                                    float metricThreshold, int windowSize, int searchArea, float stdDevRefThreshold,
                                    float stdDevFloatThreshold, int subPixelResolution, unsigned int metricTypeInt,
-                                   unsigned int outputType, std::string outputGCPFile);
+                                   unsigned int outputType, std::string outputGCPFile, unsigned int numPyramidLevels=0);
     
     /** Single connected layer image registration */
     DllExport void excecuteSingleLayerConnectedRegistration(std::string inputReferenceImage, std::string inputFloatingmage, int gcpGap,
@@ -71,6 +72,9 @@ namespace rsgis{ namespace cmds {
     
     /** Apply offset to image file */
     DllExport void executeApplyOffset2Image(std::string inputImage, std::string outputImage, std::string gdalFormat, RSGISLibDataType outDataType, double xOff, double yOff);
+    
+    /** Warp an image onto the pixel grid of a reference image using tie points (polynomial or thin plate spline transform) */
+    DllExport void executeWarpImageGCPs(std::string inputRefImage, std::string inputImage, std::string inputGCPs, std::string outputImage, std::string gdalFormat, RSGISLibDataType outDataType, unsigned int interpMethod, bool useTPS=false, unsigned int polyOrder=2, unsigned int gridStep=16, float noDataVal=0.0, unsigned int numThreads=0);
 }}
 
 
@@ -39,11 +39,20 @@
 #include "img/RSGISStretchImage.h"
 #include "img/RSGISMaskImage.h"
 #include "img/RSGISImageMosaic.h"
+#include "img/RSGISImageFootprintIndex.h"
 #include "img/RSGISPopWithStats.h"
 #include "img/RSGISImageComposite.h"
 #include "img/RSGISSampleImage.h"
 #include "img/RSGISPanSharpen.h"
 #include "img/RSGISSharpenLowResImagery.h"
+#include "img/RSGISImageSubset2Polys.h"
+#include "img/RSGISCreateImagesForFeatures.h"
+#include "img/RSGISImageTilePlanner.h"
+#include "img/RSGISPixelCoordinates.h"
+#include "img/RSGISGridResampler.h"
+#include "img/RSGISImageBitFields.h"
+#include "img/RSGISMultiImageValidMask.h"
+#include "img/RSGISRelabelPixelValuesFromLUT.h"
 
 #include "rastergis/RSGISCalcImageStatsAndPyramids.h"
 #include "rastergis/RSGISRasterAttUtils.h"
@@ -259,6 +268,43 @@ namespace rsgis{ namespace cmds {
         }
     }
 
+    void executeRelabelPxlValsLUT(std::string inputImage, std::string outputImage, std::string gdalFormat, RSGISLibDataType outDataType, std::vector<double> inVals, std::vector<double> outVals, unsigned int numThreads)
+    {
+        GDALDataset *dataset = NULL;
+        try
+        {
+            GDALAllRegister();
+            dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw RSGISImageException(message.c_str());
+            }
+
+            rsgis::img::RSGISPixelValueLUT lut = rsgis::img::RSGISPixelValueLUT(inVals, outVals);
+            rsgis::img::RSGISRelabelPixelValuesFromLUT relabelImg = rsgis::img::RSGISRelabelPixelValuesFromLUT(numThreads);
+            relabelImg.relabelPixelValues(dataset, outputImage, lut, gdalFormat, RSGIS_to_GDAL_Type(outDataType));
+
+            GDALClose(dataset);
+        }
+        catch(RSGISException& e)
+        {
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+    }
+
     void executeCreateTiles(std::string inputImage, std::string outputImageBase, unsigned int width, unsigned int height, unsigned int tileOverlap, bool offsetTiling, std::string gdalFormat, RSGISLibDataType outDataType, std::string outFileExtension, std::vector<std::string> *outFileNames)
     {
         std::cout.precision(12);
@@ -883,14 +929,14 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    std::vector<std::string> executeOrderImageUsingValidDataProp(std::vector<std::string> images, float noDataValue) 
+    std::vector<std::string> executeOrderImageUsingValidDataProp(std::vector<std::string> images, float noDataValue, std::string footprintIdxFile) 
     {
         GDALAllRegister();
         std::vector<std::string> orderedImages;
         try
         {
             rsgis::img::RSGISImageMosaic mosaic;
-            mosaic.orderInImagesValidData(images, &orderedImages, noDataValue);
+            mosaic.orderInImagesValidData(images, &orderedImages, noDataValue, footprintIdxFile);
         }
         catch (RSGISImageException& e)
         {
@@ -903,6 +949,95 @@ namespace rsgis{ namespace cmds {
         return orderedImages;
     }
 
+    void executeCreateImageFootprintIndex(std::vector<std::string> images, std::string footprintIdxFile, int idxEPSG, bool calcValidFrac, bool useNoDataVal, float noDataVal)
+    {
+        GDALAllRegister();
+        try
+        {
+            rsgis::img::RSGISImageFootprintIndex::createIndex(images, footprintIdxFile, idxEPSG, calcValidFrac, useNoDataVal, noDataVal);
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+    size_t executeUpdateImageFootprintIndex(std::string footprintIdxFile, std::vector<std::string> images, bool removeMissing, bool calcValidFrac, bool useNoDataVal, float noDataVal)
+    {
+        GDALAllRegister();
+        size_t numRead = 0;
+        try
+        {
+            numRead = rsgis::img::RSGISImageFootprintIndex::updateIndex(footprintIdxFile, images, removeMissing, calcValidFrac, useNoDataVal, noDataVal);
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return numRead;
+    }
+
+    std::vector<RSGISCmdImageFootprintInfo> executeQueryImageFootprintIndex(std::string footprintIdxFile, bool useBBOX, double minX, double maxX, double minY, double maxY)
+    {
+        std::vector<RSGISCmdImageFootprintInfo> footprintInfo;
+        try
+        {
+            rsgis::img::RSGISImageFootprintIndex footprintIdx;
+            footprintIdx.openIndex(footprintIdxFile);
+
+            std::vector<size_t> idxs;
+            if(useBBOX)
+            {
+                footprintIdx.query(minX, maxX, minY, maxY, &idxs);
+            }
+            else
+            {
+                for(size_t i = 0; i < footprintIdx.getNumImages(); ++i)
+                {
+                    idxs.push_back(i);
+                }
+            }
+
+            footprintInfo.reserve(idxs.size());
+            for(std::vector<size_t>::iterator iterIdx = idxs.begin(); iterIdx != idxs.end(); ++iterIdx)
+            {
+                rsgis::img::RSGISImageFootprint footprint = footprintIdx.getFootprint(*iterIdx);
+                RSGISCmdImageFootprintInfo info;
+                info.imageFile = footprint.imageFile;
+                info.minX = footprint.bbox[0];
+                info.maxX = footprint.bbox[1];
+                info.minY = footprint.bbox[2];
+                info.maxY = footprint.bbox[3];
+                info.numBands = footprint.numBands;
+                info.xSize = footprint.xSize;
+                info.ySize = footprint.ySize;
+                info.hasNoData = footprint.hasNoData;
+                info.noDataVal = footprint.noDataVal;
+                info.validPxlFrac = footprint.validPxlFrac;
+                info.crsWKT = footprint.crsWKT;
+                footprintInfo.push_back(info);
+            }
+            footprintIdx.closeIndex();
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return footprintInfo;
+    }
+
     void executeImageInclude(std::string *inputImages, int numDS, std::string baseImage, bool bandsDefined, std::vector<int> bands, float skipVal, bool useSkipVal) 
     {
         try
@@ -1206,15 +1341,527 @@ namespace rsgis{ namespace cmds {
                 throw RSGISImageException(message.c_str());
             }
 
-            inDataset->SetGeoTransform(trans);
-            inDataset->SetProjection(wktString.c_str());
-
-            delete[] trans;
-            GDALClose(inDataset);
-        }
-        catch (RSGISImageException& e)
-        {
-            throw RSGISCmdException(e.what());
+            inDataset->SetGeoTransform(trans);
+            inDataset->SetProjection(wktString.c_str());
+
+            delete[] trans;
+            GDALClose(inDataset);
+        }
+        catch (RSGISImageException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+
+    void executeStackImageBands(std::string *imageFiles, std::string *imageBandNames, int numImages, std::string outputImage, bool skipPixels, float skipValue, float noDataValue, std::string gdalFormat, RSGISLibDataType outDataType, bool replaceBandNames)
+    {
+        try
+        {
+            GDALAllRegister();
+            std::cout << "There are " << numImages << " images to stack\n";
+            GDALDataset **datasets = new GDALDataset*[numImages];
+            for(int i = 0; i < numImages; i++)
+            {
+                std::cout << imageFiles[i] << std::endl;
+                datasets[i] = (GDALDataset *) GDALOpenShared(imageFiles[i].c_str(), GA_ReadOnly);
+                if(datasets[i] == NULL)
+                {
+                    std::string message = std::string("Could not open image ") + imageFiles[i];
+                    throw RSGISCmdException(message.c_str());
+                }
+            }
+
+            rsgis::img::RSGISAddBands stackbands;
+            stackbands.stackImages(datasets, numImages, outputImage, imageBandNames, skipPixels, skipValue, noDataValue, gdalFormat, RSGIS_to_GDAL_Type(outDataType), replaceBandNames);
+
+            if(datasets != NULL)
+            {
+                for(int i = 0; i < numImages; i++)
+                {
+                    if(datasets[i] != NULL)
+                    {
+                        GDALClose(datasets[i]);
+                    }
+                }
+                delete[] datasets;
+            }
+        }
+        catch (RSGISImageException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+    void executeSubsetImageBands(std::string inputImage, std::string outputImage, std::vector<unsigned int> bands, std::string gdalFormat, RSGISLibDataType outDataType)
+    {
+        try
+        {
+            GDALAllRegister();
+
+            GDALDataset *imageDS = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(imageDS == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw RSGISImageException(message.c_str());
+            }
+
+            unsigned int numBands = imageDS->GetRasterCount();
+
+            for(std::vector<unsigned int>::iterator iterBands = bands.begin(); iterBands != bands.end(); ++iterBands)
+            {
+                if(((*iterBands) == 0) || ((*iterBands) > numBands))
+                {
+                    throw RSGISImageException("Not all the image bands are present within the input image file (Note. Bands are numbered from 1).");
+                }
+            }
+
+            rsgis::img::RSGISCopyImageBandSelect *copyImageBands = new rsgis::img::RSGISCopyImageBandSelect(bands);
+            rsgis::img::RSGISCalcImage *calcImage = new rsgis::img::RSGISCalcImage(copyImageBands, "", true);
+
+            calcImage->calcImage(&imageDS, 1, outputImage, false, NULL, gdalFormat, RSGIS_to_GDAL_Type(outDataType));
+
+            GDALClose(imageDS);
+        }
+        catch (RSGISImageException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+
+    void executeSubset(std::string inputImage, std::string inputVecFile, std::string inputVecLyr, std::string outputImage, std::string imageFormat, RSGISLibDataType outDataType)
+    {
+        try
+        {
+            GDALAllRegister();
+            OGRRegisterAll();
+
+            GDALDataset **dataset = NULL;
+            GDALDataset *inputVecDS = NULL;
+            OGRLayer *inputVecLayer = NULL;
+
+            rsgis::img::RSGISCopyImage *copyImage = NULL;
+            rsgis::img::RSGISCalcImage *calcImage = NULL;
+
+            int numImageBands = 0;
+
+            // Open Image
+            dataset = new GDALDataset*[1];
+            std::cout << inputImage << std::endl;
+            dataset[0] = (GDALDataset *) GDALOpenShared(inputImage.c_str(), GA_ReadOnly);
+            if(dataset[0] == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            numImageBands = dataset[0]->GetRasterCount();
+            std::cout << "Raster Band Count = " << numImageBands << std::endl;
+
+            // Open vector
+            inputVecDS = (GDALDataset*) GDALOpenEx(inputVecFile.c_str(), GDAL_OF_VECTOR, NULL, NULL, NULL);
+            if(inputVecDS == NULL)
+            {
+                std::string message = std::string("Could not open vector file ") + inputVecFile;
+                throw RSGISFileException(message.c_str());
+            }
+            inputVecLayer = inputVecDS->GetLayerByName(inputVecLyr.c_str());
+            if(inputVecLayer == NULL)
+            {
+                std::string message = std::string("Could not open vector layer ") + inputVecLyr;
+                throw RSGISFileException(message.c_str());
+            }
+            OGREnvelope ogrExtent;
+            inputVecLayer->GetExtent(&ogrExtent);
+
+            copyImage = new rsgis::img::RSGISCopyImage(numImageBands);
+            calcImage = new rsgis::img::RSGISCalcImage(copyImage, "", true);
+            calcImage->calcImageInEnv(dataset, 1, outputImage, &ogrExtent, false, NULL, imageFormat, RSGIS_to_GDAL_Type(outDataType));
+
+            GDALClose(dataset[0]);
+            delete[] dataset;
+            GDALClose(inputVecDS);
+            delete calcImage;
+            delete copyImage;
+        }
+        catch (RSGISImageException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+    void executeSubsetBBox(std::string inputImage, std::string outputImage, std::string imageFormat, RSGISLibDataType outDataType, double xMin, double xMax, double yMin, double yMax) 
+    {
+        try
+        {
+            GDALAllRegister();
+            OGRRegisterAll();
+            
+            // Open Image
+            std::cout << inputImage << std::endl;
+            GDALDataset *dataset = (GDALDataset *) GDALOpenShared(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            int numImageBands = dataset->GetRasterCount();
+            std::cout << "Raster Band Count = " << numImageBands << std::endl;
+            
+            OGREnvelope extent = OGREnvelope();
+            extent.MinX = xMin;
+            extent.MaxX = xMax;
+            extent.MinY = yMin;
+            extent.MaxY = yMax;
+            
+            rsgis::img::RSGISCopyImage *copyImage = new rsgis::img::RSGISCopyImage(numImageBands);
+            rsgis::img::RSGISCalcImage calcImage = rsgis::img::RSGISCalcImage(copyImage, "", true);
+            calcImage.calcImageInEnv(&dataset, 1, outputImage, &extent, false, NULL, imageFormat, RSGIS_to_GDAL_Type(outDataType));
+            
+            GDALClose(dataset);
+            delete copyImage;
+        }
+        catch (RSGISImageException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+    void executeSubset2Polys(std::string inputImage, std::string inputVecFile, std::string inputVecLyr, std::string filenameAttribute, std::string outputImageBase, std::string imageFormat, RSGISLibDataType outDataType, std::string outFileExtension, std::vector<std::string> *outFileNames, bool maskToPoly, float noDataVal, unsigned int numThreads)
+    {
+        GDALDataset *dataset = NULL;
+        GDALDataset *inputVecDS = NULL;
+        try
+        {
+            GDALAllRegister();
+            OGRRegisterAll();
+
+            dataset = (GDALDataset *) GDALOpenShared(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+
+            inputVecDS = (GDALDataset*) GDALOpenEx(inputVecFile.c_str(), GDAL_OF_VECTOR, NULL, NULL, NULL);
+            if(inputVecDS == NULL)
+            {
+                std::string message = std::string("Could not open vector file ") + inputVecFile;
+                throw RSGISFileException(message.c_str());
+            }
+            OGRLayer *inputVecLayer = inputVecDS->GetLayerByName(inputVecLyr.c_str());
+            if(inputVecLayer == NULL)
+            {
+                std::string message = std::string("Could not open vector layer ") + inputVecLyr;
+                throw RSGISFileException(message.c_str());
+            }
+
+            rsgis::img::RSGISImageSubset2Polys subsetImg;
+            std::vector<std::string> outFiles = subsetImg.subsetImage(dataset, inputVecLayer, filenameAttribute, outputImageBase, outFileExtension, imageFormat, RSGIS_to_GDAL_Type(outDataType), maskToPoly, noDataVal, numThreads);
+            if(outFileNames != NULL)
+            {
+                outFileNames->insert(outFileNames->end(), outFiles.begin(), outFiles.end());
+            }
+
+            GDALClose(dataset);
+            GDALClose(inputVecDS);
+        }
+        catch (RSGISImageException& e)
+        {
+            if(inputVecDS != NULL)
+            {
+                GDALClose(inputVecDS);
+            }
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            if(inputVecDS != NULL)
+            {
+                GDALClose(inputVecDS);
+            }
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            if(inputVecDS != NULL)
+            {
+                GDALClose(inputVecDS);
+            }
+            if(dataset != NULL)
+            {
+                GDALClose(dataset);
+            }
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+    std::vector<std::string> executeCreateImgForEachVecFeat(std::string inputVecFile, std::string inputVecLyr, std::string fileNameCol, std::string outputImageBase, std::string outFileExtension, float pxlVal, unsigned int numBands, double imgRes, std::string imageFormat, RSGISLibDataType outDataType, bool snapToGrid, unsigned int numThreads)
+    {
+        std::vector<std::string> outFiles;
+        try
+        {
+            GDALAllRegister();
+            OGRRegisterAll();
+
+            if(imgRes <= 0)
+            {
+                throw RSGISImageException("The output image resolution must be greater than zero.");
+            }
+
+            GDALDataset *inputVecDS = (GDALDataset*) GDALOpenEx(inputVecFile.c_str(), GDAL_OF_VECTOR, NULL, NULL, NULL);
+            if(inputVecDS == NULL)
+            {
+                std::string message = std::string("Could not open vector file ") + inputVecFile;
+                throw RSGISFileException(message.c_str());
+            }
+            OGRLayer *inputVecLayer = inputVecDS->GetLayerByName(inputVecLyr.c_str());
+            if(inputVecLayer == NULL)
+            {
+                GDALClose(inputVecDS);
+                std::string message = std::string("Could not open vector layer ") + inputVecLyr;
+                throw RSGISFileException(message.c_str());
+            }
+
+            // When snapped, the images are on a grid of the output resolution with an origin at 0,0.
+            double gridTransform[6];
+            gridTransform[0] = 0.0;
+            gridTransform[1] = imgRes;
+            gridTransform[2] = 0.0;
+            gridTransform[3] = 0.0;
+            gridTransform[4] = 0.0;
+            gridTransform[5] = imgRes * (-1);
+
+            rsgis::img::RSGISCreateImagesForFeatures createImgs(numThreads);
+            try
+            {
+                outFiles = createImgs.createFeatureImages(inputVecLayer, fileNameCol, outputImageBase, outFileExtension, gridTransform, 0, 0, snapToGrid, "", false, pxlVal, 0.0, numBands, imageFormat, RSGIS_to_GDAL_Type(outDataType), false);
+            }
+            catch(RSGISException &e)
+            {
+                GDALClose(inputVecDS);
+                throw e;
+            }
+
+            GDALClose(inputVecDS);
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return outFiles;
+    }
+
+    std::vector<std::string> executeCreateVecFeatMaskImgs(std::string inputVecFile, std::string inputVecLyr, std::string refImage, std::string outputImageBase, std::string outFileExtension, std::string fileNameCol, float burnVal, std::string imageFormat, RSGISLibDataType outDataType, unsigned int numThreads)
+    {
+        std::vector<std::string> outFiles;
+        try
+        {
+            GDALAllRegister();
+            OGRRegisterAll();
+
+            GDALDataset *refDataset = (GDALDataset *) GDALOpen(refImage.c_str(), GA_ReadOnly);
+            if(refDataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + refImage;
+                throw RSGISImageException(message.c_str());
+            }
+            double gridTransform[6];
+            refDataset->GetGeoTransform(gridTransform);
+            long gridXSize = refDataset->GetRasterXSize();
+            long gridYSize = refDataset->GetRasterYSize();
+            std::string projWKT = std::string(refDataset->GetProjectionRef());
+            GDALClose(refDataset);
+
+            GDALDataset *inputVecDS = (GDALDataset*) GDALOpenEx(inputVecFile.c_str(), GDAL_OF_VECTOR, NULL, NULL, NULL);
+            if(inputVecDS == NULL)
+            {
+                std::string message = std::string("Could not open vector file ") + inputVecFile;
+                throw RSGISFileException(message.c_str());
+            }
+            OGRLayer *inputVecLayer = inputVecDS->GetLayerByName(inputVecLyr.c_str());
+            if(inputVecLayer == NULL)
+            {
+                GDALClose(inputVecDS);
+                std::string message = std::string("Could not open vector layer ") + inputVecLyr;
+                throw RSGISFileException(message.c_str());
+            }
+
+            rsgis::img::RSGISCreateImagesForFeatures createImgs(numThreads);
+            try
+            {
+                outFiles = createImgs.createFeatureImages(inputVecLayer, fileNameCol, outputImageBase, outFileExtension, gridTransform, gridXSize, gridYSize, true, projWKT, true, burnVal, 0.0, 1, imageFormat, RSGIS_to_GDAL_Type(outDataType), true);
+            }
+            catch(RSGISException &e)
+            {
+                GDALClose(inputVecDS);
+                throw e;
+            }
+
+            GDALClose(inputVecDS);
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return outFiles;
+    }
+
+    std::vector<std::string> executeCreateClumpMaskImgs(std::string clumpsImage, unsigned int clumpsBand, std::string outputImageBase, std::string outFileExtension, bool binaryOut, std::string imageFormat, RSGISLibDataType outDataType, unsigned int numThreads)
+    {
+        std::vector<std::string> outFiles;
+        try
+        {
+            GDALAllRegister();
+
+            GDALDataset *clumpsDataset = (GDALDataset *) GDALOpen(clumpsImage.c_str(), GA_ReadOnly);
+            if(clumpsDataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + clumpsImage;
+                throw RSGISImageException(message.c_str());
+            }
+
+            rsgis::img::RSGISCreateImagesForFeatures createImgs(numThreads);
+            try
+            {
+                outFiles = createImgs.createClumpImages(clumpsDataset, clumpsBand, outputImageBase, outFileExtension, binaryOut, imageFormat, RSGIS_to_GDAL_Type(outDataType), true);
+            }
+            catch(RSGISException &e)
+            {
+                GDALClose(clumpsDataset);
+                throw e;
+            }
+
+            GDALClose(clumpsDataset);
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return outFiles;
+    }
+
+    std::vector<RSGISCmdImageTileInfo> executePlanImageTiles(std::string inputImage, unsigned int tileWidth, unsigned int tileHeight, bool offset, bool useNoData, double noDataVal, float validThreshold, std::string maskImage, bool shrinkToValid, std::string outTilesImage, std::string tilesImageFormat, unsigned int numThreads)
+    {
+        std::vector<RSGISCmdImageTileInfo> tilesInfo;
+        try
+        {
+            GDALAllRegister();
+
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw RSGISImageException(message.c_str());
+            }
+
+            GDALDataset *maskDataset = NULL;
+            if(maskImage != "")
+            {
+                maskDataset = (GDALDataset *) GDALOpen(maskImage.c_str(), GA_ReadOnly);
+                if(maskDataset == NULL)
+                {
+                    GDALClose(dataset);
+                    std::string message = std::string("Could not open image ") + maskImage;
+                    throw RSGISImageException(message.c_str());
+                }
+            }
+
+            rsgis::img::RSGISImageTilePlanner tilePlanner(numThreads);
+            try
+            {
+                std::vector<rsgis::img::RSGISImageTile> tiles = tilePlanner.planTiles(dataset, tileWidth, tileHeight, offset, useNoData, noDataVal, validThreshold, maskDataset, shrinkToValid);
+                if(outTilesImage != "")
+                {
+                    tilePlanner.writeTilesImage(dataset, &tiles, outTilesImage, tilesImageFormat);
+                }
+                for(std::vector<rsgis::img::RSGISImageTile>::iterator iterTile = tiles.begin(); iterTile != tiles.end(); ++iterTile)
+                {
+                    RSGISCmdImageTileInfo tileInfo;
+                    tileInfo.name = (*iterTile).name;
+                    tileInfo.xMin = (*iterTile).xMin;
+                    tileInfo.xMax = (*iterTile).xMax;
+                    tileInfo.yMin = (*iterTile).yMin;
+                    tileInfo.yMax = (*iterTile).yMax;
+                    tileInfo.numValidPxls = (*iterTile).numValidPxls;
+                    tilesInfo.push_back(tileInfo);
+                }
+            }
+            catch(RSGISException &e)
+            {
+                GDALClose(dataset);
+                if(maskDataset != NULL)
+                {
+                    GDALClose(maskDataset);
+                }
+                throw e;
+            }
+
+            GDALClose(dataset);
+            if(maskDataset != NULL)
+            {
+                GDALClose(maskDataset);
+            }
         }
         catch (RSGISException& e)
         {
@@ -1224,45 +1871,45 @@ namespace rsgis{ namespace cmds {
         {
             throw RSGISCmdException(e.what());
         }
+        return tilesInfo;
     }
 
-
-    void executeStackImageBands(std::string *imageFiles, std::string *imageBandNames, int numImages, std::string outputImage, bool skipPixels, float skipValue, float noDataValue, std::string gdalFormat, RSGISLibDataType outDataType, bool replaceBandNames)
+    std::vector<std::string> executeCreateImageTiles(std::string inputImage, std::vector<RSGISCmdImageTileInfo> tiles, std::string outputImageBase, std::string outFileExtension, std::string imageFormat, RSGISLibDataType outDataType, unsigned int numThreads)
     {
+        std::vector<std::string> outFiles;
         try
         {
             GDALAllRegister();
-            std::cout << "There are " << numImages << " images to stack\n";
-            GDALDataset **datasets = new GDALDataset*[numImages];
-            for(int i = 0; i < numImages; i++)
+
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
             {
-                std::cout << imageFiles[i] << std::endl;
-                datasets[i] = (GDALDataset *) GDALOpenShared(imageFiles[i].c_str(), GA_ReadOnly);
-                if(datasets[i] == NULL)
-                {
-                    std::string message = std::string("Could not open image ") + imageFiles[i];
-                    throw RSGISCmdException(message.c_str());
-                }
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw RSGISImageException(message.c_str());
             }
+            long width = dataset->GetRasterXSize();
+            long height = dataset->GetRasterYSize();
+            GDALClose(dataset);
 
-            rsgis::img::RSGISAddBands stackbands;
-            stackbands.stackImages(datasets, numImages, outputImage, imageBandNames, skipPixels, skipValue, noDataValue, gdalFormat, RSGIS_to_GDAL_Type(outDataType), replaceBandNames);
-
-            if(datasets != NULL)
+            std::vector<rsgis::img::RSGISImageTile> imgTiles;
+            for(std::vector<RSGISCmdImageTileInfo>::iterator iterTile = tiles.begin(); iterTile != tiles.end(); ++iterTile)
             {
-                for(int i = 0; i < numImages; i++)
+                if(((*iterTile).xMin < 0) || ((*iterTile).yMin < 0) || ((*iterTile).xMax > width) || ((*iterTile).yMax > height) || ((*iterTile).xMin >= (*iterTile).xMax) || ((*iterTile).yMin >= (*iterTile).yMax))
                 {
-                    if(datasets[i] != NULL)
-                    {
-                        GDALClose(datasets[i]);
-                    }
+                    throw RSGISImageException("The pixel extent of tile '" + (*iterTile).name + "' is not within the input image.");
                 }
-                delete[] datasets;
+                rsgis::img::RSGISImageTile tile;
+                tile.name = (*iterTile).name;
+                tile.xMin = (*iterTile).xMin;
+                tile.xMax = (*iterTile).xMax;
+                tile.yMin = (*iterTile).yMin;
+                tile.yMax = (*iterTile).yMax;
+                tile.numValidPxls = (*iterTile).numValidPxls;
+                imgTiles.push_back(tile);
             }
-        }
-        catch (RSGISImageException& e)
-        {
-            throw RSGISCmdException(e.what());
+
+            rsgis::img::RSGISImageTilePlanner tilePlanner(numThreads);
+            outFiles = tilePlanner.writeTiles(inputImage, &imgTiles, outputImageBase, outFileExtension, imageFormat, RSGIS_to_GDAL_Type(outDataType));
         }
         catch (RSGISException& e)
         {
@@ -1272,41 +1919,49 @@ namespace rsgis{ namespace cmds {
         {
             throw RSGISCmdException(e.what());
         }
+        return outFiles;
     }
 
-    void executeSubsetImageBands(std::string inputImage, std::string outputImage, std::vector<unsigned int> bands, std::string gdalFormat, RSGISLibDataType outDataType)
+    void executeCalcPixelLocations(std::string inputImage, std::string outputImage, std::string imageFormat, int outEPSG)
     {
         try
         {
             GDALAllRegister();
 
-            GDALDataset *imageDS = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
-            if(imageDS == NULL)
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
             {
                 std::string message = std::string("Could not open image ") + inputImage;
                 throw RSGISImageException(message.c_str());
             }
 
-            unsigned int numBands = imageDS->GetRasterCount();
-
-            for(std::vector<unsigned int>::iterator iterBands = bands.begin(); iterBands != bands.end(); ++iterBands)
+            std::string outProjWKT = "";
+            if(outEPSG > 0)
             {
-                if(((*iterBands) == 0) || ((*iterBands) > numBands))
+                OGRSpatialReference outSpatRef;
+                if(outSpatRef.importFromEPSG(outEPSG) != OGRERR_NONE)
                 {
-                    throw RSGISImageException("Not all the image bands are present within the input image file (Note. Bands are numbered from 1).");
+                    GDALClose(dataset);
+                    throw RSGISImageException("Could not create the projection for the EPSG code " + std::to_string(outEPSG));
                 }
+                char *wktStr = NULL;
+                outSpatRef.exportToWkt(&wktStr);
+                outProjWKT = std::string(wktStr);
+                CPLFree(wktStr);
             }
 
-            rsgis::img::RSGISCopyImageBandSelect *copyImageBands = new rsgis::img::RSGISCopyImageBandSelect(bands);
-            rsgis::img::RSGISCalcImage *calcImage = new rsgis::img::RSGISCalcImage(copyImageBands, "", true);
-
-            calcImage->calcImage(&imageDS, 1, outputImage, false, NULL, gdalFormat, RSGIS_to_GDAL_Type(outDataType));
+            try
+            {
+                rsgis::img::RSGISPixelCoordinates pxlCoords(dataset, outProjWKT);
+                pxlCoords.writePixelLocations(outputImage, imageFormat);
+            }
+            catch(RSGISException &e)
+            {
+                GDALClose(dataset);
+                throw e;
+            }
 
-            GDALClose(imageDS);
-        }
-        catch (RSGISImageException& e)
-        {
-            throw RSGISCmdException(e.what());
+            GDALClose(dataset);
         }
         catch (RSGISException& e)
         {
@@ -1318,64 +1973,31 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-
-    void executeSubset(std::string inputImage, std::string inputVecFile, std::string inputVecLyr, std::string outputImage, std::string imageFormat, RSGISLibDataType outDataType)
+    void executeCalcPixelAreas(std::string inputImage, std::string outputImage, std::string imageFormat, double scale)
     {
         try
         {
             GDALAllRegister();
-            OGRRegisterAll();
-
-            GDALDataset **dataset = NULL;
-            GDALDataset *inputVecDS = NULL;
-            OGRLayer *inputVecLayer = NULL;
-
-            rsgis::img::RSGISCopyImage *copyImage = NULL;
-            rsgis::img::RSGISCalcImage *calcImage = NULL;
 
-            int numImageBands = 0;
-
-            // Open Image
-            dataset = new GDALDataset*[1];
-            std::cout << inputImage << std::endl;
-            dataset[0] = (GDALDataset *) GDALOpenShared(inputImage.c_str(), GA_ReadOnly);
-            if(dataset[0] == NULL)
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
             {
                 std::string message = std::string("Could not open image ") + inputImage;
-                throw rsgis::RSGISImageException(message.c_str());
+                throw RSGISImageException(message.c_str());
             }
-            numImageBands = dataset[0]->GetRasterCount();
-            std::cout << "Raster Band Count = " << numImageBands << std::endl;
 
-            // Open vector
-            inputVecDS = (GDALDataset*) GDALOpenEx(inputVecFile.c_str(), GDAL_OF_VECTOR, NULL, NULL, NULL);
-            if(inputVecDS == NULL)
+            try
             {
-                std::string message = std::string("Could not open vector file ") + inputVecFile;
-                throw RSGISFileException(message.c_str());
+                rsgis::img::RSGISPixelCoordinates pxlCoords(dataset);
+                pxlCoords.writePixelAreas(outputImage, imageFormat, scale);
             }
-            inputVecLayer = inputVecDS->GetLayerByName(inputVecLyr.c_str());
-            if(inputVecLayer == NULL)
+            catch(RSGISException &e)
             {
-                std::string message = std::string("Could not open vector layer ") + inputVecLyr;
-                throw RSGISFileException(message.c_str());
+                GDALClose(dataset);
+                throw e;
             }
-            OGREnvelope ogrExtent;
-            inputVecLayer->GetExtent(&ogrExtent);
-
-            copyImage = new rsgis::img::RSGISCopyImage(numImageBands);
-            calcImage = new rsgis::img::RSGISCalcImage(copyImage, "", true);
-            calcImage->calcImageInEnv(dataset, 1, outputImage, &ogrExtent, false, NULL, imageFormat, RSGIS_to_GDAL_Type(outDataType));
 
-            GDALClose(dataset[0]);
-            delete[] dataset;
-            GDALClose(inputVecDS);
-            delete calcImage;
-            delete copyImage;
-        }
-        catch (RSGISImageException& e)
-        {
-            throw RSGISCmdException(e.what());
+            GDALClose(dataset);
         }
         catch (RSGISException& e)
         {
@@ -1387,41 +2009,92 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    void executeSubsetBBox(std::string inputImage, std::string outputImage, std::string imageFormat, RSGISLibDataType outDataType, double xMin, double xMax, double yMin, double yMax) 
+    void executeCalcPixelSizes(std::string inputImage, std::string outputImage, std::string imageFormat)
     {
         try
         {
             GDALAllRegister();
-            OGRRegisterAll();
-            
-            // Open Image
-            std::cout << inputImage << std::endl;
-            GDALDataset *dataset = (GDALDataset *) GDALOpenShared(inputImage.c_str(), GA_ReadOnly);
+
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
             if(dataset == NULL)
             {
                 std::string message = std::string("Could not open image ") + inputImage;
-                throw rsgis::RSGISImageException(message.c_str());
+                throw RSGISImageException(message.c_str());
             }
-            int numImageBands = dataset->GetRasterCount();
-            std::cout << "Raster Band Count = " << numImageBands << std::endl;
-            
-            OGREnvelope extent = OGREnvelope();
-            extent.MinX = xMin;
-            extent.MaxX = xMax;
-            extent.MinY = yMin;
-            extent.MaxY = yMax;
-            
-            rsgis::img::RSGISCopyImage *copyImage = new rsgis::img::RSGISCopyImage(numImageBands);
-            rsgis::img::RSGISCalcImage calcImage = rsgis::img::RSGISCalcImage(copyImage, "", true);
-            calcImage.calcImageInEnv(&dataset, 1, outputImage, &extent, false, NULL, imageFormat, RSGIS_to_GDAL_Type(outDataType));
-            
+
+            try
+            {
+                rsgis::img::RSGISPixelCoordinates pxlCoords(dataset);
+                pxlCoords.writePixelSizes(outputImage, imageFormat);
+            }
+            catch(RSGISException &e)
+            {
+                GDALClose(dataset);
+                throw e;
+            }
+
             GDALClose(dataset);
-            delete copyImage;
         }
-        catch (RSGISImageException& e)
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
         {
             throw RSGISCmdException(e.what());
         }
+    }
+
+    void executeResampleImgsToMatch(std::string refImage, std::vector<std::string> inputImages, std::vector<std::string> outputImages, std::string imageFormat, int interpMethod, bool useOutDataType, RSGISLibDataType outDataType, bool useImgNoData, bool useNoData, double noDataVal, unsigned int numThreads)
+    {
+        try
+        {
+            GDALAllRegister();
+
+            rsgis::img::RSGISResampleKernel kernel = rsgis::img::rsgis_resample_nearest;
+            switch(interpMethod)
+            {
+                case rsgis::img::rsgis_resample_nearest:
+                    kernel = rsgis::img::rsgis_resample_nearest;
+                    break;
+                case rsgis::img::rsgis_resample_bilinear:
+                    kernel = rsgis::img::rsgis_resample_bilinear;
+                    break;
+                case rsgis::img::rsgis_resample_cubic:
+                    kernel = rsgis::img::rsgis_resample_cubic;
+                    break;
+                case rsgis::img::rsgis_resample_average:
+                    kernel = rsgis::img::rsgis_resample_average;
+                    break;
+                case rsgis::img::rsgis_resample_mode:
+                    kernel = rsgis::img::rsgis_resample_mode;
+                    break;
+                default:
+                    throw RSGISImageException("The interpolation method is not supported; use nearest, bilinear, cubic, average or mode.");
+            }
+
+            GDALDataset *refDataset = (GDALDataset *) GDALOpen(refImage.c_str(), GA_ReadOnly);
+            if(refDataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + refImage;
+                throw RSGISImageException(message.c_str());
+            }
+            double transform[6];
+            refDataset->GetGeoTransform(transform);
+            long xSize = refDataset->GetRasterXSize();
+            long ySize = refDataset->GetRasterYSize();
+            std::string projWKT = std::string(refDataset->GetProjectionRef());
+            GDALClose(refDataset);
+
+            GDALDataType gdalOutDataType = GDT_Unknown;
+            if(useOutDataType)
+            {
+                gdalOutDataType = RSGIS_to_GDAL_Type(outDataType);
+            }
+
+            rsgis::img::RSGISGridResampler resampler(transform, xSize, ySize, projWKT, numThreads);
+            resampler.resampleImages(inputImages, outputImages, imageFormat, gdalOutDataType, kernel, useImgNoData, useNoData, noDataVal);
+        }
         catch (RSGISException& e)
         {
             throw RSGISCmdException(e.what());
@@ -1907,6 +2580,51 @@ namespace rsgis{ namespace cmds {
         }
     }
 
+    void executeMultiImgValidMasks(std::vector<std::string> inputImages, std::string outputImage, std::string outPackedImage, std::string gdalFormat, double noDataVal, bool useImgNoData, bool checkFinite, unsigned int numThreads)
+    {
+        std::vector<GDALDataset*> datasets;
+        try
+        {
+            GDALAllRegister();
+            for(unsigned int i = 0; i < inputImages.size(); ++i)
+            {
+                std::cout << i << ") " << inputImages.at(i) << std::endl;
+                GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImages.at(i).c_str(), GA_ReadOnly);
+                if(dataset == NULL)
+                {
+                    std::string message = std::string("Could not open image ") + inputImages.at(i);
+                    throw RSGISImageException(message.c_str());
+                }
+                datasets.push_back(dataset);
+            }
+
+            rsgis::img::RSGISMultiImageValidMask multiImgValidMask = rsgis::img::RSGISMultiImageValidMask(noDataVal, useImgNoData, checkFinite, numThreads);
+            multiImgValidMask.calcValidMasks(datasets, outputImage, outPackedImage, gdalFormat);
+
+            // Tidy up
+            for(auto iterDS = datasets.begin(); iterDS != datasets.end(); ++iterDS)
+            {
+                GDALClose(*iterDS);
+            }
+        }
+        catch (RSGISException& e)
+        {
+            for(auto iterDS = datasets.begin(); iterDS != datasets.end(); ++iterDS)
+            {
+                GDALClose(*iterDS);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            for(auto iterDS = datasets.begin(); iterDS != datasets.end(); ++iterDS)
+            {
+                GDALClose(*iterDS);
+            }
+            throw RSGISCmdException(e.what());
+        }
+    }
+
 
     void executeImageEdgeMask(std::string inputImage, std::string outputImage, std::string gdalFormat, unsigned int nEdgePxls)
     {
@@ -2857,6 +3575,7 @@ namespace rsgis{ namespace cmds {
 
     void executeUnpackPxlValues(std::string inputImage, unsigned int inputImgBand, std::string outputImage, std::string gdalFormat)
     {
+        GDALDataset *dataset = NULL;
         try
         {
             GDALAllRegister();
@@ -2867,7 +3586,7 @@ namespace rsgis{ namespace cmds {
             }
 
             std::cout << "Opening: " << inputImage << std::endl;
-            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
             if(dataset == NULL)
             {
                 std::string message = std::string("Could not open image ") + inputImage;
@@ -2876,35 +3595,83 @@ namespace rsgis{ namespace cmds {
 
             if(inputImgBand > dataset->GetRasterCount())
             {
-                GDALClose(dataset);
                 throw RSGISImageException("The input image band is not within the input image.");
             }
 
-            GDALRasterBand *inGDALBandObj = dataset->GetRasterBand(inputImgBand);
-            GDALDataType gdalDataType = inGDALBandObj->GetRasterDataType();
-
-            int nOutBands = 0;
-            if(gdalDataType == GDT_Byte)
+            GDALDataType gdalDataType = dataset->GetRasterBand(inputImgBand)->GetRasterDataType();
+            if(rsgis::img::RSGISDecodeImageBitFields::getNumBits(gdalDataType) == 0)
             {
-                nOutBands = 8;
+                throw RSGISImageException("The input image is not an integer data type.");
             }
-            else if((gdalDataType == GDT_UInt16) | (gdalDataType == GDT_Int16))
+
+            std::vector<rsgis::img::RSGISBitFieldSpec> bitFields = rsgis::img::RSGISDecodeImageBitFields::getSingleBitFields(gdalDataType);
+            rsgis::img::RSGISDecodeImageBitFields decodeBitFields = rsgis::img::RSGISDecodeImageBitFields(bitFields, false);
+            decodeBitFields.decodeBitFields(dataset, inputImgBand, outputImage, gdalFormat);
+
+            // Tidy up
+            GDALClose(dataset);
+        }
+        catch (RSGISImageException& e)
+        {
+            if(dataset != NULL)
             {
-                nOutBands = 16;
+                GDALClose(dataset);
             }
-            else if((gdalDataType == GDT_UInt32) | (gdalDataType == GDT_Int32))
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            if(dataset != NULL)
             {
-                nOutBands = 16;
+                GDALClose(dataset);
             }
-            else
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            if(dataset != NULL)
             {
                 GDALClose(dataset);
-                throw RSGISImageException("The input image is not an integer data type.");
+            }
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+    void executeDecodeBitFields(std::string inputImage, unsigned int inputImgBand, std::string outputImage, std::string gdalFormat, std::vector<RSGISCmdBitField> bitFields, bool packMasks)
+    {
+        try
+        {
+            GDALAllRegister();
+
+            std::vector<rsgis::img::RSGISBitFieldSpec> imgBitFields;
+            for(auto iterField = bitFields.begin(); iterField != bitFields.end(); ++iterField)
+            {
+                rsgis::img::RSGISBitFieldSpec field;
+                field.name = (*iterField).name;
+                field.bitOffset = (*iterField).bitOffset;
+                field.bitLength = (*iterField).bitLength;
+                field.outBand = (*iterField).outBand;
+                imgBitFields.push_back(field);
+            }
+            rsgis::img::RSGISDecodeImageBitFields decodeBitFields = rsgis::img::RSGISDecodeImageBitFields(imgBitFields, packMasks);
+
+            std::cout << "Opening: " << inputImage << std::endl;
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw RSGISImageException(message.c_str());
             }
 
-            rsgis::img::RSGISCopyImageBandToBits copyImgBandToBits = rsgis::img::RSGISCopyImageBandToBits(nOutBands, inputImgBand, gdalDataType);
-            rsgis::img::RSGISCalcImage calcImg = rsgis::img::RSGISCalcImage(&copyImgBandToBits, "", true);
-            calcImg.calcImage(&dataset, 1, 0, outputImage, false, NULL, gdalFormat, GDT_Byte);
+            try
+            {
+                decodeBitFields.decodeBitFields(dataset, inputImgBand, outputImage, gdalFormat);
+            }
+            catch (RSGISImageException& e)
+            {
+                GDALClose(dataset);
+                throw e;
+            }
 
             // Tidy up
             GDALClose(dataset);
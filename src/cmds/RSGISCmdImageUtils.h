@@ -80,6 +80,40 @@ namespace rsgis{ namespace cmds {
         bool outRef;
     };
     
+    struct DllExport RSGISCmdBitField
+    {
+        std::string name;
+        unsigned int bitOffset;
+        unsigned int bitLength;
+        unsigned int outBand;
+    };
+    
+    struct DllExport RSGISCmdImageFootprintInfo
+    {
+        std::string imageFile;
+        double minX;
+        double maxX;
+        double minY;
+        double maxY;
+        unsigned int numBands;
+        unsigned int xSize;
+        unsigned int ySize;
+        bool hasNoData;
+        double noDataVal;
+        double validPxlFrac;
+        std::string crsWKT;
+    };
+    
+    struct DllExport RSGISCmdImageTileInfo
+    {
+        std::string name;
+        long xMin;
+        long xMax;
+        long yMin;
+        long yMax;
+        unsigned long numValidPxls;
+    };
+    
     /** Function to run the stretch image command */
     DllExport void executeStretchImageNoData(std::string inputImage, std::string outputImage, double inNoData, bool saveOutStats, std::string outStatsFile, bool onePassSD, std::string gdalFormat, RSGISLibDataType outDataType, RSGISStretches stretchType, float stretchParam);
     
@@ -92,6 +126,9 @@ namespace rsgis{ namespace cmds {
     /** Function to run the mask image command */
     DllExport void executeMaskImage(std::string inputImage, std::string imageMask, std::string outputImage, std::string gdalFormat, RSGISLibDataType outDataType, float outValue, std::vector<float> maskValues);
     
+    /** Function to relabel the pixel values of all the bands of an image using a LUT (values not in the LUT are unchanged) */
+    DllExport void executeRelabelPxlValsLUT(std::string inputImage, std::string outputImage, std::string gdalFormat, RSGISLibDataType outDataType, std::vector<double> inVals, std::vector<double> outVals, unsigned int numThreads=0);
+    
     /** A function to split an image into image tiles.
         An overlap between tiles may be specified.
         Optionally the tiles may be offset from the image boundries by half a pixel, useful for creating two overlapping lots of tiles.
@@ -124,7 +161,16 @@ namespace rsgis{ namespace cmds {
     DllExport void executeImageIncludeOverviews(std::string baseImage, std::vector<std::string> inputImages, std::vector<int> pyraScaleVals);
     
     /** A command to order a set of input images based on the proportion of valid data within each of the scenes */
-    DllExport std::vector<std::string> executeOrderImageUsingValidDataProp(std::vector<std::string> images, float noDataValue);
+    DllExport std::vector<std::string> executeOrderImageUsingValidDataProp(std::vector<std::string> images, float noDataValue, std::string footprintIdxFile="");
+    
+    /** A command to create a footprint index (packed R-tree with cached image metadata) for a set of images */
+    DllExport void executeCreateImageFootprintIndex(std::vector<std::string> images, std::string footprintIdxFile, int idxEPSG, bool calcValidFrac, bool useNoDataVal, float noDataVal);
+    
+    /** A command to add new or changed images to a footprint index, returning the number of images read */
+    DllExport size_t executeUpdateImageFootprintIndex(std::string footprintIdxFile, std::vector<std::string> images, bool removeMissing, bool calcValidFrac, bool useNoDataVal, float noDataVal);
+    
+    /** A command to get the images within a footprint index which intersect a bbox (all images if useBBOX is false) */
+    DllExport std::vector<RSGISCmdImageFootprintInfo> executeQueryImageFootprintIndex(std::string footprintIdxFile, bool useBBOX, double minX, double maxX, double minY, double maxY);
     
     /** A function to assign the projection on an image file */
     DllExport void executeAssignProj(std::string inputImage, std::string wktStr, bool readWKTFromFile=false, std::string wktFile="");
@@ -148,8 +194,35 @@ namespace rsgis{ namespace cmds {
     /** A function to subset an image to a bounding box */
     DllExport void executeSubsetBBox(std::string inputImage, std::string outputImage, std::string imageFormat, RSGISLibDataType outDataType, double xMin, double xMax, double yMin, double yMax);
     
-    /** A function to subset an image to polygons within shapefile */
-    DllExport void executeSubset2Polys(std::string inputImage, std::string inputVecFile, std::string inputVecLyr, std::string filenameAttribute, std::string outputImageBase, std::string imageFormat, RSGISLibDataType outDataType, std::string outFileExtension, std::vector<std::string> *outFileNames = NULL);
+    /** A function to subset an image to polygons within shapefile. All the subsets are created in a single pass of the input image, optionally masking each to its polygon. */
+    DllExport void executeSubset2Polys(std::string inputImage, std::string inputVecFile, std::string inputVecLyr, std::string filenameAttribute, std::string outputImageBase, std::string imageFormat, RSGISLibDataType outDataType, std::string outFileExtension, std::vector<std::string> *outFileNames = NULL, bool maskToPoly=false, float noDataVal=0.0, unsigned int numThreads=0);
+    
+    /** A function to create an image, filled with pxlVal, of the extent of each feature within a vector layer (named using fileNameCol), returning the output images */
+    DllExport std::vector<std::string> executeCreateImgForEachVecFeat(std::string inputVecFile, std::string inputVecLyr, std::string fileNameCol, std::string outputImageBase, std::string outFileExtension, float pxlVal, unsigned int numBands, double imgRes, std::string imageFormat, RSGISLibDataType outDataType, bool snapToGrid=false, unsigned int numThreads=1);
+    
+    /** A function to create a mask image, on the grid of the reference image, for each feature within a vector layer (named using fileNameCol or the feature number if empty), returning the output images */
+    DllExport std::vector<std::string> executeCreateVecFeatMaskImgs(std::string inputVecFile, std::string inputVecLyr, std::string refImage, std::string outputImageBase, std::string outFileExtension, std::string fileNameCol, float burnVal, std::string imageFormat, RSGISLibDataType outDataType, unsigned int numThreads=1);
+    
+    /** A function to create a mask image of the extent of each clump within a clumps image, returning the output images */
+    DllExport std::vector<std::string> executeCreateClumpMaskImgs(std::string clumpsImage, unsigned int clumpsBand, std::string outputImageBase, std::string outFileExtension, bool binaryOut, std::string imageFormat, RSGISLibDataType outDataType, unsigned int numThreads=1);
+    
+    /** A function to plan a tiling of an image from a single pass over the image, merging tiles with too little valid data with their neighbours and optionally writing an image of the tiles */
+    DllExport std::vector<RSGISCmdImageTileInfo> executePlanImageTiles(std::string inputImage, unsigned int tileWidth, unsigned int tileHeight, bool offset, bool useNoData, double noDataVal, float validThreshold, std::string maskImage="", bool shrinkToValid=false, std::string outTilesImage="", std::string tilesImageFormat="KEA", unsigned int numThreads=1);
+    
+    /** A function to write the tiles of an image (in parallel), returning the output images */
+    DllExport std::vector<std::string> executeCreateImageTiles(std::string inputImage, std::vector<RSGISCmdImageTileInfo> tiles, std::string outputImageBase, std::string outFileExtension, std::string imageFormat, RSGISLibDataType outDataType, unsigned int numThreads=1);
+    
+    /** A function to create a 2 band image with the X and Y coordinates of the pixel centres, optionally transformed to another projection (outEPSG > 0) */
+    DllExport void executeCalcPixelLocations(std::string inputImage, std::string outputImage, std::string imageFormat, int outEPSG=0);
+    
+    /** A function to create an image with the area of each pixel (in metres squared for a geographic image) divided by scale */
+    DllExport void executeCalcPixelAreas(std::string inputImage, std::string outputImage, std::string imageFormat, double scale=1.0);
+    
+    /** A function to create a 2 band image with the X and Y size of each pixel (in metres for a geographic image) */
+    DllExport void executeCalcPixelSizes(std::string inputImage, std::string outputImage, std::string imageFormat);
+    
+    /** A function to resample a set of images (in parallel) onto the pixel grid of a reference image, with interpMethod using the values of rsgislib.INTERP_* (nearest, bilinear, cubic, average or mode) */
+    DllExport void executeResampleImgsToMatch(std::string refImage, std::vector<std::string> inputImages, std::vector<std::string> outputImages, std::string imageFormat, int interpMethod, bool useOutDataType, RSGISLibDataType outDataType, bool useImgNoData, bool useNoData, double noDataVal, unsigned int numThreads=1);
     
     /** A function to subset an image to another image*/
     DllExport void executeSubset2Img(std::string inputImage, std::string inputROIImage, std::string outputImage, std::string imageFormat, RSGISLibDataType outDataType);
@@ -180,6 +253,9 @@ namespace rsgis{ namespace cmds {
         
     /** A function to produce a binary image for valid regions within all the input images (i.e., not the no data value) */
     DllExport void executeValidImageMask(std::vector<std::string> inputImages, std::string outputImage, std::string gdalFormat, float noDataVal=0.0);
+    
+    /** A function to calculate the number of valid images, all/any valid and first/last valid image for a stack of images in a single pass, optionally also outputting the validity of each image packed into the bits of a single band. */
+    DllExport void executeMultiImgValidMasks(std::vector<std::string> inputImages, std::string outputImage, std::string outPackedImage, std::string gdalFormat, double noDataVal=0.0, bool useImgNoData=true, bool checkFinite=true, unsigned int numThreads=0);
 
     /** A function to produce a binary mask with the edge pixels of the input image identified */
     DllExport void executeImageEdgeMask(std::string inputImage, std::string outputImage, std::string gdalFormat, unsigned int nEdgePxls);
@@ -217,6 +293,9 @@ namespace rsgis{ namespace cmds {
     /** A function which unpacks the image pixel values to a multi band image */
     DllExport void executeUnpackPxlValues(std::string inputImage, unsigned int inputImgBand, std::string outputImage, std::string gdalFormat);
     
+    /** A function which decodes bit fields (e.g., QA bands) to Byte image bands or, if packMasks is true, to boolean masks packed into the bits of a single band */
+    DllExport void executeDecodeBitFields(std::string inputImage, unsigned int inputImgBand, std::string outputImage, std::string gdalFormat, std::vector<RSGISCmdBitField> bitFields, bool packMasks=false);
+    
 }}
 
 
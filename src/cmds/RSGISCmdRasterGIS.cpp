@@ -1844,5 +1844,77 @@ namespace rsgis{ namespace cmds {
         }
     }
             
+    bool executeReadRATColumn(std::string clumpsImage, std::string colName, std::vector<int> *intVals, std::vector<double> *realVals, unsigned int ratBand)
+    {
+        bool isIntCol = false;
+        try
+        {
+            GDALAllRegister();
+            GDALDataset *clumpsDataset = (GDALDataset *) GDALOpen(clumpsImage.c_str(), GA_ReadOnly);
+            if(clumpsDataset == NULL)
+            {
+                std::string message = std::string("Could not open image ") + clumpsImage;
+                throw rsgis::RSGISImageException(message.c_str());
+            }
+            if((ratBand == 0) || (ratBand > clumpsDataset->GetRasterCount()))
+            {
+                GDALClose(clumpsDataset);
+                throw rsgis::RSGISImageException("RAT Band is not within the image.");
+            }
+            
+            GDALRasterAttributeTable *attTable = clumpsDataset->GetRasterBand(ratBand)->GetDefaultRAT();
+            if(attTable == NULL)
+            {
+                GDALClose(clumpsDataset);
+                throw rsgis::RSGISAttributeTableException("The image band does not have a RAT.");
+            }
+            
+            rsgis::rastergis::RSGISRasterAttUtils attUtils;
+            unsigned int colIdx = attUtils.findColumnIndex(attTable, colName);
+            int nRows = attTable->GetRowCount();
+            CPLErr err = CE_None;
+            if(attTable->GetTypeOfCol(colIdx) == GFT_Integer)
+            {
+                isIntCol = true;
+                intVals->resize(nRows);
+                if(nRows > 0)
+                {
+                    err = attTable->ValuesIO(GF_Read, colIdx, 0, nRows, intVals->data());
+                }
+            }
+            else if(attTable->GetTypeOfCol(colIdx) == GFT_Real)
+            {
+                realVals->resize(nRows);
+                if(nRows > 0)
+                {
+                    err = attTable->ValuesIO(GF_Read, colIdx, 0, nRows, realVals->data());
+                }
+            }
+            else
+            {
+                GDALClose(clumpsDataset);
+                throw rsgis::RSGISAttributeTableException("Only integer and real columns can be read as an array.");
+            }
+            GDALClose(clumpsDataset);
+            
+            if(err != CE_None)
+            {
+                throw rsgis::RSGISAttributeTableException("Could not read the column \'" + colName + "\'.");
+            }
+        }
+        catch(rsgis::RSGISAttributeTableException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (rsgis::RSGISException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return isIntCol;
+    }
+            
 }}
-
@@ -324,6 +324,9 @@ namespace rsgis{ namespace cmds {
     /** Function to export each clump to an individual image file */
     DllExport void executeExportClumps2Images(std::string clumpsImage, std::string outImgBase, std::string imgFileExt, std::string imageFormat, bool binaryOut, unsigned int ratBand=1);
     
+    /** Function to read an integer or real column of the RAT into a contiguous array. Returns true if the column is an integer column (intVals populated) and false if real (realVals populated). */
+    DllExport bool executeReadRATColumn(std::string clumpsImage, std::string colName, std::vector<int> *intVals, std::vector<double> *realVals, unsigned int ratBand=1);
+    
     
 }}
 
@@ -30,6 +30,7 @@
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISStretchImage.h"
 #include "img/RSGISImageUtils.h"
+#include "img/RSGISScratchRaster.h"
 
 #include "segmentation/RSGISLabelPixelsUsingClusters.h"
 #include "segmentation/RSGISEliminateSinglePixels.h"
@@ -103,9 +104,11 @@ namespace rsgis{ namespace cmds {
             }
             
             GDALDataset *pixelMaskDataset = NULL;
+            std::unique_ptr<rsgis::img::RSGISScratchRaster> pixelMaskScratch;
             if(processInMemory)
             {
-                pixelMaskDataset = imgUtils.createCopy(clumpsDataset, 1, "", "MEM", GDT_Byte , true, "");
+                pixelMaskScratch.reset(new rsgis::img::RSGISScratchRaster(clumpsDataset, 1, GDT_Byte));
+                pixelMaskDataset = pixelMaskScratch->getDataset();
             }
             else
             {
@@ -122,7 +125,14 @@ namespace rsgis{ namespace cmds {
             // Tidy up
             GDALClose(spectralDataset);
             GDALClose(clumpsDataset);
-            GDALClose(pixelMaskDataset);
+            if(pixelMaskScratch)
+            {
+                pixelMaskScratch.reset();
+            }
+            else
+            {
+                GDALClose(pixelMaskDataset);
+            }
         }
         catch (rsgis::RSGISException &e)
         {
@@ -26,6 +26,7 @@
 #include "RSGISCmdParent.h"
 
 #include "common/RSGISVectorException.h"
+#include "common/RSGISImageException.h"
 #include "common/RSGISException.h"
 
 #include "utils/RSGISTextUtils.h"
@@ -36,6 +37,7 @@
 #include "vec/RSGISCopyCheckPolygons.h"
 #include "vec/RSGISGetOGRGeometries.h"
 #include "vec/RSGISVectorIO.h"
+#include "vec/RSGISRasterPolygoniser.h"
 
 namespace rsgis{ namespace cmds {
 
@@ -399,6 +401,145 @@ namespace rsgis{ namespace cmds {
             throw RSGISCmdException(e.what());
         }
     }
-            
+
+    unsigned long executePolygoniseImage(std::string inputImg, unsigned int imgBand, std::string maskImg, unsigned int maskBand, std::string outputVectorFile, std::string outputVectorLyr, std::string outFormat, std::string pxlValFieldName, bool use8Conn, bool replaceFile, bool replaceLyr)
+    {
+        unsigned long numFeats = 0;
+        try
+        {
+            OGRRegisterAll();
+            GDALAllRegister();
+
+            rsgis::utils::RSGISFileUtils fileUtils;
+
+            // Convert to absolute path
+            outputVectorFile = boost::filesystem::absolute(outputVectorFile).string();
+
+            GDALDataset *imgDS = (GDALDataset *) GDALOpen(inputImg.c_str(), GA_ReadOnly);
+            if(imgDS == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImg;
+                throw RSGISImageException(message.c_str());
+            }
+            if((imgBand == 0) || (imgBand > (unsigned int)imgDS->GetRasterCount()))
+            {
+                GDALClose(imgDS);
+                throw RSGISImageException("The image band specified is not within the image.");
+            }
+            GDALRasterBand *band = imgDS->GetRasterBand(imgBand);
+
+            GDALDataset *maskDS = NULL;
+            GDALRasterBand *maskGDALBand = NULL;
+            if(maskImg != "")
+            {
+                maskDS = (GDALDataset *) GDALOpen(maskImg.c_str(), GA_ReadOnly);
+                if(maskDS == NULL)
+                {
+                    GDALClose(imgDS);
+                    std::string message = std::string("Could not open image ") + maskImg;
+                    throw RSGISImageException(message.c_str());
+                }
+                if((maskBand == 0) || (maskBand > (unsigned int)maskDS->GetRasterCount()))
+                {
+                    GDALClose(imgDS);
+                    GDALClose(maskDS);
+                    throw RSGISImageException("The mask band specified is not within the mask image.");
+                }
+                maskGDALBand = maskDS->GetRasterBand(maskBand);
+            }
+
+            GDALDataset *outputVecDS = NULL;
+            if((!replaceFile) && fileUtils.checkFilePresent(outputVectorFile))
+            {
+                outputVecDS = (GDALDataset*) GDALOpenEx(outputVectorFile.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE, NULL, NULL, NULL);
+            }
+            else
+            {
+                if(outFormat == "ESRI Shapefile")
+                {
+                    rsgis::vec::RSGISVectorUtils vecUtils;
+                    std::string outputDIR = fileUtils.getFileDirectoryPath(outputVectorFile);
+                    if(vecUtils.checkDIR4SHP(outputDIR, outputVectorLyr))
+                    {
+                        vecUtils.deleteSHP(outputDIR, outputVectorLyr);
+                    }
+                }
+                else
+                {
+                    fileUtils.removeFileIfPresent(outputVectorFile);
+                }
+                GDALDriver *ogrVecDriver = GetGDALDriverManager()->GetDriverByName(outFormat.c_str());
+                if( ogrVecDriver == NULL )
+                {
+                    throw rsgis::vec::RSGISVectorOutputException("Vector driver not available: " + outFormat);
+                }
+                outputVecDS = ogrVecDriver->Create(outputVectorFile.c_str(), 0, 0, 0, GDT_Unknown, NULL );
+            }
+            if( outputVecDS == NULL )
+            {
+                std::string message = std::string("Could not open or create vector file ") + outputVectorFile;
+                throw rsgis::vec::RSGISVectorOutputException(message.c_str());
+            }
+
+            char **papszOptions = NULL;
+            if(replaceLyr)
+            {
+                papszOptions = CSLSetNameValue(papszOptions, "OVERWRITE", "YES");
+            }
+            OGRSpatialReference imgSpatialRef(imgDS->GetProjectionRef());
+            // A 4 connected region has a single outer ring but with 8 connectivity a region can be a multi-polygon.
+            OGRLayer *outputVecLayer = outputVecDS->CreateLayer(outputVectorLyr.c_str(), &imgSpatialRef, use8Conn?wkbMultiPolygon:wkbPolygon, papszOptions );
+            CSLDestroy(papszOptions);
+            if( outputVecLayer == NULL )
+            {
+                std::string message = std::string("Could not create vector layer ") + outputVectorLyr;
+                throw rsgis::vec::RSGISVectorOutputException(message.c_str());
+            }
+
+            // Floating point images keep their value, as the regions are not defined on truncated values,
+            // and 32 bit unsigned integers are outside of the range of an OFTInteger field.
+            GDALDataType imgDataType = band->GetRasterDataType();
+            OGRFieldType valFieldType = OFTInteger;
+            if((imgDataType == GDT_Float32) || (imgDataType == GDT_Float64))
+            {
+                valFieldType = OFTReal;
+            }
+            else if(imgDataType == GDT_UInt32)
+            {
+                valFieldType = OFTInteger64;
+            }
+            OGRFieldDefn valField(pxlValFieldName.c_str(), valFieldType);
+            if(outputVecLayer->CreateField(&valField) != OGRERR_NONE)
+            {
+                std::string message = std::string("Creating field ") + pxlValFieldName + std::string(" has failed");
+                throw rsgis::vec::RSGISVectorOutputException(message.c_str());
+            }
+            int valFieldIdx = outputVecLayer->GetLayerDefn()->GetFieldIndex(pxlValFieldName.c_str());
+
+            rsgis::vec::RSGISRasterPolygoniser polygoniser(use8Conn);
+            numFeats = polygoniser.polygonise(band, maskGDALBand, outputVecLayer, valFieldIdx);
+
+            outputVecLayer->SyncToDisk();
+            GDALClose(outputVecDS);
+            GDALClose(imgDS);
+            if(maskDS != NULL)
+            {
+                GDALClose(maskDS);
+            }
+        }
+        catch(rsgis::RSGISVectorException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(rsgis::RSGISException &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (std::exception &e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return numFeats;
+    }
+
 }}
-            
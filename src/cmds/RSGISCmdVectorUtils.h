@@ -59,6 +59,9 @@ namespace rsgis{ namespace cmds{
 
     /** Function to check and validate the geometries within the vector file */
     DllExport void executeCheckValidateGeometries(std::string inputVectorFile, std::string inputVectorLyr, std::string outputVectorFile, std::string outputVectorLyr, std::string outFormat, bool printGeomErrs, bool delExistVec);
+
+    /** Function to polygonise an image band, outputting a feature for each connected region of the same pixel value. If maskImg is empty no mask is used. */
+    DllExport unsigned long executePolygoniseImage(std::string inputImg, unsigned int imgBand, std::string maskImg, unsigned int maskBand, std::string outputVectorFile, std::string outputVectorLyr, std::string outFormat, std::string pxlValFieldName, bool use8Conn, bool replaceFile, bool replaceLyr);
 }}
 
 
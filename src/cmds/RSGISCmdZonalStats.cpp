@@ -29,8 +29,13 @@
 
 #include "img/RSGISExtractImageValues.h"
 
+#include "utils/RSGISExportData2HDF.h"
+#include "utils/RSGISHDFSampleManager.h"
+
 #include "vec/RSGISZonalImage2HDF.h"
 #include "vec/RSGISExtractEndMembers2Matrix.h"
+#include "vec/RSGISZonalBandStats.h"
+#include "vec/RSGISPointBandSampler.h"
 
 
 namespace rsgis{ namespace cmds {
@@ -226,12 +231,13 @@ namespace rsgis{ namespace cmds {
         }
     }
 
-    void executeRandomSampleH5File(std::string inputH5, std::string outputH5, unsigned int nSample, int seed, RSGISLibDataType dataType)
+    unsigned int executeImageBandRasterZone2Array(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskVal, std::vector<float> *pxlVals)
     {
+        unsigned int numBands = 0;
         try
         {
             rsgis::img::RSGISExtractImageValues extractVals;
-            extractVals.sampleExtractedHDFData(inputH5, outputH5, nSample, seed, dataType);
+            numBands = extractVals.extractImgBandDataWithinMask(imageFiles, maskImage, maskVal, pxlVals);
         }
         catch (RSGISImageException& e)
         {
@@ -245,14 +251,15 @@ namespace rsgis{ namespace cmds {
         {
             throw RSGISCmdException(e.what());
         }
+        return numBands;
     }
 
-    void executeSplitSampleH5File(std::string inputH5, std::string outputP1H5, std::string outputP2H5, unsigned int nSample, int seed, RSGISLibDataType dataType)
+    void executeRandomSampleH5File(std::string inputH5, std::string outputH5, unsigned int nSample, int seed, RSGISLibDataType dataType, bool shuffle)
     {
         try
         {
             rsgis::img::RSGISExtractImageValues extractVals;
-            extractVals.splitExtractedHDFData(inputH5, outputP1H5, outputP2H5, nSample, seed, dataType);
+            extractVals.sampleExtractedHDFData(inputH5, outputH5, nSample, seed, dataType, shuffle);
         }
         catch (RSGISImageException& e)
         {
@@ -268,6 +275,357 @@ namespace rsgis{ namespace cmds {
         }
     }
 
+    void executeSplitSampleH5File(std::string inputH5, std::string outputP1H5, std::string outputP2H5, unsigned int nSample, int seed, RSGISLibDataType dataType, bool shuffle)
+    {
+        try
+        {
+            rsgis::img::RSGISExtractImageValues extractVals;
+            extractVals.splitExtractedHDFData(inputH5, outputP1H5, outputP2H5, nSample, seed, dataType, shuffle);
+        }
+        catch (RSGISImageException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
 
-}}
+    size_t executeMergeH5Files(std::vector<std::string> inputH5Files, std::string outputH5, RSGISLibDataType dataType, bool shuffle, int seed, unsigned int numThreads)
+    {
+        size_t numRows = 0;
+        try
+        {
+            rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
+            H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
+            rsgis::utils::RSGISHDFSampleManager sampleManager(numThreads);
+            numRows = sampleManager.mergeFiles(inputH5Files, outputH5, seed, h5DataType, shuffle);
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return numRows;
+    }
+
+    std::vector<size_t> executeSplitH5Files(std::vector<std::string> inputH5Files, std::vector<std::string> outputH5Files, std::vector<size_t> nSamples, int remainOut, int seed, RSGISLibDataType dataType, bool shuffle, unsigned int numThreads)
+    {
+        std::vector<size_t> outNumRows;
+        try
+        {
+            rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
+            H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
+            rsgis::utils::RSGISHDFSampleManager sampleManager(numThreads);
+            outNumRows = sampleManager.splitFiles(inputH5Files, outputH5Files, nSamples, remainOut, seed, h5DataType, shuffle);
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return outNumRows;
+    }
+
+    size_t executeImageBandChipZone2HDF(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskVal, unsigned int chipSize, std::string outputHDF, RSGISLibDataType dataType, std::string refImage, unsigned int refImgBand, unsigned int numThreads)
+    {
+        size_t numChips = 0;
+        try
+        {
+            rsgis::img::RSGISExtractImageValues extractVals;
+            numChips = extractVals.extractImgBandChipsWithinMask2HDF(imageFiles, maskImage, maskVal, chipSize, outputHDF, dataType, refImage, refImgBand, numThreads);
+        }
+        catch (RSGISImageException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return numChips;
+    }
+
+    size_t executeMergeChipH5Files(std::vector<std::string> inputH5Files, std::string outputH5, RSGISLibDataType dataType, bool withRef)
+    {
+        size_t numChips = 0;
+        try
+        {
+            if(inputH5Files.empty())
+            {
+                throw RSGISException("No input HDF5 files were provided.");
+            }
+
+            // The chip size and number of bands are taken from the first file.
+            H5::Exception::dontPrint();
+            hsize_t dims[4] = {0, 0, 0, 0};
+            {
+                H5::H5File firstH5File = H5::H5File(inputH5Files.at(0), H5F_ACC_RDONLY);
+                H5::DataSpace firstDataSpace = firstH5File.openDataSet("/DATA/DATA").getSpace();
+                if(firstDataSpace.getSimpleExtentNdims() != 4)
+                {
+                    throw RSGISException("The input file is not a chip file: " + inputH5Files.at(0));
+                }
+                firstDataSpace.getSimpleExtentDims(dims);
+                firstH5File.close();
+            }
+
+            rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
+            H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
+            rsgis::utils::RSGISExportChipData2HDF exportChips2HDF;
+            exportChips2HDF.createFile(outputH5, dims[1], dims[3], withRef, std::string("Merged"), h5DataType);
+            for(auto iterFile = inputH5Files.begin(); iterFile != inputH5Files.end(); ++iterFile)
+            {
+                exportChips2HDF.appendChipFile(*iterFile);
+            }
+            numChips = exportChips2HDF.getNumChips();
+            exportChips2HDF.close();
+        }
+        catch (H5::Exception& e)
+        {
+            throw RSGISCmdException(e.getCDetailMsg());
+        }
+        catch (RSGISException& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return numChips;
+    }
 
+
+    unsigned long executeCalcZonalBandStats(std::string vecFile, std::string vecLyr, std::string inputImage, unsigned int imgBand, double minThres, double maxThres, double outNoDataVal, std::vector<std::string> statFields, unsigned int numThreads)
+    {
+        GDALAllRegister();
+
+        GDALDataset *inputImageDS = NULL;
+        GDALDataset *vecDS = NULL;
+        unsigned long numFeats = 0;
+        try
+        {
+            if(statFields.size() != 8)
+            {
+                throw RSGISException("There must be 8 statistic field names (min, max, mean, stddev, sum, count, mode and median).");
+            }
+            rsgis::vec::RSGISZonalBandStatsFields fields;
+            fields.minField = statFields.at(0);
+            fields.maxField = statFields.at(1);
+            fields.meanField = statFields.at(2);
+            fields.stdDevField = statFields.at(3);
+            fields.sumField = statFields.at(4);
+            fields.countField = statFields.at(5);
+            fields.modeField = statFields.at(6);
+            fields.medianField = statFields.at(7);
+
+            inputImageDS = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(inputImageDS == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw RSGISException(message.c_str());
+            }
+
+            vecDS = (GDALDataset*) GDALOpenEx(vecFile.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE, NULL, NULL, NULL);
+            if(vecDS == NULL)
+            {
+                std::string message = std::string("Could not open vector file ") + vecFile;
+                throw RSGISException(message.c_str());
+            }
+            OGRLayer *vecLyrObj = vecDS->GetLayerByName(vecLyr.c_str());
+            if(vecLyrObj == NULL)
+            {
+                std::string message = std::string("Could not open vector layer ") + vecLyr;
+                throw RSGISException(message.c_str());
+            }
+
+            rsgis::vec::RSGISZonalBandStats zonalStats(numThreads);
+            numFeats = zonalStats.calcZonalStats(vecLyrObj, inputImageDS, imgBand, minThres, maxThres, outNoDataVal, fields);
+
+            GDALClose(inputImageDS);
+            GDALClose(vecDS);
+        }
+        catch(rsgis::RSGISException& e)
+        {
+            if(inputImageDS != NULL)
+            {
+                GDALClose(inputImageDS);
+            }
+            if(vecDS != NULL)
+            {
+                GDALClose(vecDS);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return numFeats;
+    }
+
+    unsigned long executeSamplePointBandValues(std::string vecFile, std::string vecLyr, std::string inputImage, std::vector<unsigned int> imgBands, std::vector<std::string> outFields, unsigned int sampleMethod, unsigned int winSize, double minThres, double maxThres, double outNoDataVal, bool reprojVec, int vecDefEPSG, unsigned int numThreads)
+    {
+        GDALAllRegister();
+
+        GDALDataset *inputImageDS = NULL;
+        GDALDataset *vecDS = NULL;
+        OGRSpatialReference *vecSpatRef = NULL;
+        OGRSpatialReference *imgSpatRef = NULL;
+        OGRCoordinateTransformation *transform = NULL;
+        unsigned long numFeats = 0;
+        try
+        {
+            if(sampleMethod > rsgis::vec::pointSampleWinStdDev)
+            {
+                throw RSGISException("The sample method is not recognised.");
+            }
+
+            inputImageDS = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(inputImageDS == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw RSGISException(message.c_str());
+            }
+
+            vecDS = (GDALDataset*) GDALOpenEx(vecFile.c_str(), GDAL_OF_VECTOR | GDAL_OF_UPDATE, NULL, NULL, NULL);
+            if(vecDS == NULL)
+            {
+                std::string message = std::string("Could not open vector file ") + vecFile;
+                throw RSGISException(message.c_str());
+            }
+            OGRLayer *vecLyrObj = vecDS->GetLayerByName(vecLyr.c_str());
+            if(vecLyrObj == NULL)
+            {
+                std::string message = std::string("Could not open vector layer ") + vecLyr;
+                throw RSGISException(message.c_str());
+            }
+
+            if(reprojVec)
+            {
+                imgSpatRef = new OGRSpatialReference(inputImageDS->GetProjectionRef());
+                if(vecDefEPSG > 0)
+                {
+                    vecSpatRef = new OGRSpatialReference();
+                    vecSpatRef->importFromEPSG(vecDefEPSG);
+                }
+                else if(vecLyrObj->GetSpatialRef() != NULL)
+                {
+                    vecSpatRef = vecLyrObj->GetSpatialRef()->Clone();
+                }
+                else
+                {
+                    throw RSGISException("Could not retrieve a projection from the vector layer, specify an EPSG code.");
+                }
+
+                if(!vecSpatRef->IsSame(imgSpatRef))
+                {
+                    vecSpatRef->SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+                    imgSpatRef->SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+                    transform = OGRCreateCoordinateTransformation(vecSpatRef, imgSpatRef);
+                    if(transform == NULL)
+                    {
+                        throw RSGISException("Could not create a transformation from the vector layer to the image projection.");
+                    }
+                }
+            }
+
+            rsgis::vec::RSGISPointBandSampler sampler(numThreads);
+            numFeats = sampler.samplePointsToLayer(vecLyrObj, inputImageDS, imgBands, outFields, (rsgis::vec::RSGISPointSampleMethod)sampleMethod, winSize, minThres, maxThres, outNoDataVal, transform);
+
+            if(transform != NULL)
+            {
+                OGRCoordinateTransformation::DestroyCT(transform);
+            }
+            delete vecSpatRef;
+            delete imgSpatRef;
+            GDALClose(inputImageDS);
+            GDALClose(vecDS);
+        }
+        catch(rsgis::RSGISException& e)
+        {
+            if(transform != NULL)
+            {
+                OGRCoordinateTransformation::DestroyCT(transform);
+            }
+            if(vecSpatRef != NULL)
+            {
+                delete vecSpatRef;
+            }
+            if(imgSpatRef != NULL)
+            {
+                delete imgSpatRef;
+            }
+            if(inputImageDS != NULL)
+            {
+                GDALClose(inputImageDS);
+            }
+            if(vecDS != NULL)
+            {
+                GDALClose(vecDS);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+        return numFeats;
+    }
+
+    void executeSampleImageBandValues(std::string inputImage, std::vector<unsigned int> imgBands, const std::vector<double> &xCoords, const std::vector<double> &yCoords, unsigned int sampleMethod, unsigned int winSize, double minThres, double maxThres, double outNoDataVal, std::vector<double> *outVals, unsigned int numThreads)
+    {
+        GDALAllRegister();
+
+        GDALDataset *inputImageDS = NULL;
+        try
+        {
+            if(sampleMethod > rsgis::vec::pointSampleWinStdDev)
+            {
+                throw RSGISException("The sample method is not recognised.");
+            }
+
+            inputImageDS = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(inputImageDS == NULL)
+            {
+                std::string message = std::string("Could not open image ") + inputImage;
+                throw RSGISException(message.c_str());
+            }
+
+            outVals->resize(xCoords.size() * imgBands.size());
+            rsgis::vec::RSGISPointBandSampler sampler(numThreads);
+            sampler.samplePoints(inputImageDS, imgBands, xCoords, yCoords, (rsgis::vec::RSGISPointSampleMethod)sampleMethod, winSize, minThres, maxThres, outNoDataVal, outVals->data());
+
+            GDALClose(inputImageDS);
+        }
+        catch(rsgis::RSGISException& e)
+        {
+            if(inputImageDS != NULL)
+            {
+                GDALClose(inputImageDS);
+            }
+            throw RSGISCmdException(e.what());
+        }
+        catch(std::exception& e)
+        {
+            throw RSGISCmdException(e.what());
+        }
+    }
+
+}}
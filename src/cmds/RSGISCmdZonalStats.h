@@ -57,11 +57,35 @@ namespace rsgis{ namespace cmds {
     /** A function to extract image band values to a HDF file */
     DllExport void executeImageBandRasterZone2HDF(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, std::string outputHDF, float maskVal, RSGISLibDataType dataType);
 
+    /** A function to extract image band values into memory as a contiguous (pixels x bands) matrix, returning the number of bands */
+    DllExport unsigned int executeImageBandRasterZone2Array(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskVal, std::vector<float> *pxlVals);
+
     /** A function to sample a list of values saved in a HDF5 file */
-    DllExport void executeRandomSampleH5File(std::string inputH5, std::string outputH5, unsigned int nSample, int seed, RSGISLibDataType dataType);
+    DllExport void executeRandomSampleH5File(std::string inputH5, std::string outputH5, unsigned int nSample, int seed, RSGISLibDataType dataType, bool shuffle=false);
 
     /** A function to sample a list of values saved in a HDF5 file */
-    DllExport void executeSplitSampleH5File(std::string inputH5, std::string outputP1H5, std::string outputP2H5, unsigned int nSample, int seed, RSGISLibDataType dataType);
+    DllExport void executeSplitSampleH5File(std::string inputH5, std::string outputP1H5, std::string outputP2H5, unsigned int nSample, int seed, RSGISLibDataType dataType, bool shuffle=false);
+
+    /** A function to merge the values saved in a list of HDF5 files (optionally block shuffled), returning the number of rows */
+    DllExport size_t executeMergeH5Files(std::vector<std::string> inputH5Files, std::string outputH5, RSGISLibDataType dataType, bool shuffle=false, int seed=42, unsigned int numThreads=1);
+
+    /** A function to randomly split the values saved in a list of HDF5 files into outputs with nSamples rows in each (the output remainOut, if >= 0, takes the remaining rows), returning the number of rows in each output */
+    DllExport std::vector<size_t> executeSplitH5Files(std::vector<std::string> inputH5Files, std::vector<std::string> outputH5Files, std::vector<size_t> nSamples, int remainOut, int seed, RSGISLibDataType dataType, bool shuffle=false, unsigned int numThreads=1);
+
+    /** A function to extract chips (chipSize x chipSize) of the image bands for the pixels within the mask to a HDF5 file, with the chips of a reference image band if refImage is not empty, returning the number of chips */
+    DllExport size_t executeImageBandChipZone2HDF(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskVal, unsigned int chipSize, std::string outputHDF, RSGISLibDataType dataType, std::string refImage="", unsigned int refImgBand=1, unsigned int numThreads=1);
+
+    /** A function to merge HDF5 chip files (with reference chips if withRef) into a single file, streaming a chunk at a time, returning the number of chips */
+    DllExport size_t executeMergeChipH5Files(std::vector<std::string> inputH5Files, std::string outputH5, RSGISLibDataType dataType, bool withRef=false);
+
+    /** A function to calculate zonal statistics (min, max, mean, std dev, sum, count, mode and median, in that order within statFields; an empty name skips the statistic) for an image band for all the polygons of a layer in a single pass over the image, returning the number of features */
+    DllExport unsigned long executeCalcZonalBandStats(std::string vecFile, std::string vecLyr, std::string inputImage, unsigned int imgBand, double minThres, double maxThres, double outNoDataVal, std::vector<std::string> statFields, unsigned int numThreads=1);
+
+    /** A function to sample image bands at the points (or polygon centroids) of a layer, reading each image tile once, writing the values for each band to outFields (the sampleMethod is one of rsgis::vec::RSGISPointSampleMethod). If reprojVec is true the points are transformed to the image projection (if different) otherwise they must be in the image projection. Returns the number of features */
+    DllExport unsigned long executeSamplePointBandValues(std::string vecFile, std::string vecLyr, std::string inputImage, std::vector<unsigned int> imgBands, std::vector<std::string> outFields, unsigned int sampleMethod, unsigned int winSize, double minThres, double maxThres, double outNoDataVal, bool reprojVec=false, int vecDefEPSG=0, unsigned int numThreads=1);
+
+    /** A function to sample image bands at points (in the image projection), outputting a (points x bands) matrix of values */
+    DllExport void executeSampleImageBandValues(std::string inputImage, std::vector<unsigned int> imgBands, const std::vector<double> &xCoords, const std::vector<double> &yCoords, unsigned int sampleMethod, unsigned int winSize, double minThres, double maxThres, double outNoDataVal, std::vector<double> *outVals, unsigned int numThreads=1);
 
 
 }}
@@ -0,0 +1,165 @@
+/*
+ *  RSGISThreadPool.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISThreadPool.h"
+
+namespace rsgis
+{
+    RSGISThreadPool::RSGISThreadPool(unsigned int numThreads, unsigned long maxQueueSize)
+    {
+        this->numThreads = RSGISThreadPool::findNumThreads(numThreads);
+        this->maxQueueSize = maxQueueSize;
+        this->numActive = 0;
+        this->stopping = false;
+        this->taskError = nullptr;
+        for(unsigned int i = 0; i < this->numThreads; ++i)
+        {
+            this->workers.push_back(std::thread(&RSGISThreadPool::runWorker, this));
+        }
+    }
+
+    unsigned int RSGISThreadPool::findNumThreads(unsigned int numThreads)
+    {
+        if(numThreads == 0)
+        {
+            numThreads = std::thread::hardware_concurrency();
+            if(numThreads == 0)
+            {
+                numThreads = 1;
+            }
+        }
+        return numThreads;
+    }
+
+    void RSGISThreadPool::submit(std::function<void()> task)
+    {
+        std::unique_lock<std::mutex> lock(this->poolMutex);
+        if(this->maxQueueSize > 0)
+        {
+            this->taskFinished.wait(lock, [this]{ return this->tasks.size() < this->maxQueueSize; });
+        }
+        this->tasks.push(task);
+        lock.unlock();
+        this->taskAvailable.notify_one();
+    }
+
+    void RSGISThreadPool::waitForAll()
+    {
+        std::unique_lock<std::mutex> lock(this->poolMutex);
+        this->taskFinished.wait(lock, [this]{ return this->tasks.empty() && (this->numActive == 0); });
+        if(this->taskError)
+        {
+            std::exception_ptr error = this->taskError;
+            this->taskError = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void RSGISThreadPool::parallelFor(unsigned long start, unsigned long end, std::function<void(unsigned long, unsigned long)> func, unsigned long minChunkSize)
+    {
+        if(end <= start)
+        {
+            return;
+        }
+        if(minChunkSize == 0)
+        {
+            minChunkSize = 1;
+        }
+        unsigned long numItems = end - start;
+        unsigned long chunkSize = numItems / this->numThreads;
+        if((numItems % this->numThreads) != 0)
+        {
+            chunkSize += 1;
+        }
+        if(chunkSize < minChunkSize)
+        {
+            chunkSize = minChunkSize;
+        }
+
+        for(unsigned long chunkStart = start; chunkStart < end; chunkStart += chunkSize)
+        {
+            unsigned long chunkEnd = chunkStart + chunkSize;
+            if(chunkEnd > end)
+            {
+                chunkEnd = end;
+            }
+            this->submit([func, chunkStart, chunkEnd]{ func(chunkStart, chunkEnd); });
+        }
+        this->waitForAll();
+    }
+
+    void RSGISThreadPool::runWorker()
+    {
+        while(true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(this->poolMutex);
+                this->taskAvailable.wait(lock, [this]{ return this->stopping || !this->tasks.empty(); });
+                if(this->stopping && this->tasks.empty())
+                {
+                    return;
+                }
+                task = this->tasks.front();
+                this->tasks.pop();
+                ++this->numActive;
+            }
+            // Space has become available in the queue.
+            this->taskFinished.notify_all();
+
+            try
+            {
+                task();
+            }
+            catch(...)
+            {
+                std::lock_guard<std::mutex> lock(this->poolMutex);
+                if(!this->taskError)
+                {
+                    this->taskError = std::current_exception();
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(this->poolMutex);
+                --this->numActive;
+            }
+            this->taskFinished.notify_all();
+        }
+    }
+
+    RSGISThreadPool::~RSGISThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->poolMutex);
+            this->stopping = true;
+        }
+        this->taskAvailable.notify_all();
+        for(std::vector<std::thread>::iterator iterThread = this->workers.begin(); iterThread != this->workers.end(); ++iterThread)
+        {
+            if((*iterThread).joinable())
+            {
+                (*iterThread).join();
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ *  RSGISThreadPool.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISThreadPool_H
+#define RSGISThreadPool_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_commons_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis
+{
+    /**
+     * A simple fixed size pool of worker threads. Tasks are run in the order
+     * they are submitted. If maxQueueSize is greater than zero then submit will
+     * block while the queue is full, bounding the memory held by queued tasks.
+     * The first exception thrown by a task is re-thrown from waitForAll.
+     *
+     * Note, GDAL datasets must not be shared between tasks; read on the
+     * calling thread and pass buffers to the tasks or open a dataset per task.
+     */
+    class DllExport RSGISThreadPool
+    {
+    public:
+        RSGISThreadPool(unsigned int numThreads=0, unsigned long maxQueueSize=0);
+        void submit(std::function<void()> task);
+        void waitForAll();
+        void parallelFor(unsigned long start, unsigned long end, std::function<void(unsigned long, unsigned long)> func, unsigned long minChunkSize=1);
+        unsigned int getNumThreads(){return this->numThreads;};
+        static unsigned int findNumThreads(unsigned int numThreads);
+        ~RSGISThreadPool();
+    private:
+        void runWorker();
+        unsigned int numThreads;
+        unsigned long maxQueueSize;
+        unsigned long numActive;
+        bool stopping;
+        std::vector<std::thread> workers;
+        std::queue< std::function<void()> > tasks;
+        std::mutex poolMutex;
+        std::condition_variable taskAvailable;
+        std::condition_variable taskFinished;
+        std::exception_ptr taskError;
+    };
+}
+
+#endif
@@ -29,55 +29,329 @@ namespace rsgis{namespace filter{
         
 	}
     
-    void RSGISImageMorphologyFindExtrema::findMinima(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, RSGISMinimaOutputs outputType, bool allowEquals, std::string format, GDALDataType outDataType)
+    void RSGISImageMorphologyFindExtrema::findMinima(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, RSGISMinimaOutputs outputType, bool allowEquals, std::string format, GDALDataType outDataType, bool resolvePlateaus)
 	{
         if(matrixOperator->n != matrixOperator->m)
         {
             throw rsgis::img::RSGISImageCalcException("Morphological operator must be a square matrix.");
         }
+        if((matrixOperator->n % 2) == 0)
+        {
+            throw rsgis::img::RSGISImageCalcException("Morphological operator size must be an odd number.");
+        }
         
-		int numBands = datasets[0]->GetRasterCount();
-		RSGISMorphologyFindLocalMinima *findMinima = new RSGISMorphologyFindLocalMinima(numBands, matrixOperator, outputType, allowEquals);
-		rsgis::img::RSGISCalcImage calcImg = rsgis::img::RSGISCalcImage(findMinima, "", true);
-        try 
+        GDALDataset *outDataset = NULL;
+        try
         {
-            calcImg.calcImageWindowData(datasets, 1, outputImage, matrixOperator->n, format, outDataType);
+            // Without resolving plateaus the neighbourhood (which does not include the centre row and column
+            // of the operator) and the zero padding at the image edges of the per-pixel implementation are kept.
+            rsgis::img::RSGISWindowMinFilter minFilter(this->getStructElem(matrixOperator, !resolvePlateaus), matrixOperator->n, true);
+            unsigned int winMid = (matrixOperator->n-1)/2;
+            float outsideVal = resolvePlateaus?std::numeric_limits<float>::infinity():0.0;
+            
+            unsigned int numBands = datasets[0]->GetRasterCount();
+            rsgis::img::RSGISImageUtils imgUtils;
+            outDataset = imgUtils.createCopy(datasets[0], numBands, outputImage, format, outDataType);
+            for(unsigned int b = 0; b < numBands; ++b)
+            {
+                std::cout << "Processing band " << b+1 << " of " << numBands << std::endl;
+                std::vector<unsigned int> bands(1, b+1);
+                this->findBandMinima(datasets[0], bands, outDataset->GetRasterBand(b+1), &minFilter, winMid, outsideVal, outputType, allowEquals, resolvePlateaus);
+            }
+            GDALClose(outDataset);
         }
-        catch(rsgis::img::RSGISImageCalcException &e)
+        catch(rsgis::RSGISException &e)
         {
-            throw e;
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            throw rsgis::img::RSGISImageCalcException(e.what());
         }
-        catch(rsgis::img::RSGISImageBandException &e)
+        catch(std::exception &e)
         {
-            throw e;
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            throw rsgis::img::RSGISImageCalcException(e.what());
         }
-        delete findMinima;
 	}
     
-    void RSGISImageMorphologyFindExtrema::findMinimaAll(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, RSGISMinimaOutputs outputType, bool allowEquals, std::string format, GDALDataType outDataType)
+    void RSGISImageMorphologyFindExtrema::findMinimaAll(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, RSGISMinimaOutputs outputType, bool allowEquals, std::string format, GDALDataType outDataType, bool resolvePlateaus)
 	{
         if(matrixOperator->n != matrixOperator->m)
         {
             throw rsgis::img::RSGISImageCalcException("Morphological operator must be a square matrix.");
         }
+        if((matrixOperator->n % 2) == 0)
+        {
+            throw rsgis::img::RSGISImageCalcException("Morphological operator size must be an odd number.");
+        }
         
-		RSGISMorphologyFindLocalMinimaAll *findMinima = new RSGISMorphologyFindLocalMinimaAll(1, matrixOperator, outputType, allowEquals);
-		rsgis::img::RSGISCalcImage calcImg = rsgis::img::RSGISCalcImage(findMinima, "", true);
-        try 
+        GDALDataset *outDataset = NULL;
+        try
         {
-            calcImg.calcImageWindowData(datasets, 1, outputImage, matrixOperator->n, format, outDataType);
+            // Without resolving plateaus the neighbourhood (which does not include the centre row and column
+            // of the operator) and the zero padding at the image edges of the per-pixel implementation are kept.
+            rsgis::img::RSGISWindowMinFilter minFilter(this->getStructElem(matrixOperator, !resolvePlateaus), matrixOperator->n, true);
+            unsigned int winMid = (matrixOperator->n-1)/2;
+            float outsideVal = resolvePlateaus?std::numeric_limits<float>::infinity():0.0;
+            
+            unsigned int numBands = datasets[0]->GetRasterCount();
+            std::vector<unsigned int> bands;
+            for(unsigned int b = 0; b < numBands; ++b)
+            {
+                bands.push_back(b+1);
+            }
+            rsgis::img::RSGISImageUtils imgUtils;
+            outDataset = imgUtils.createCopy(datasets[0], 1, outputImage, format, outDataType);
+            this->findBandMinima(datasets[0], bands, outDataset->GetRasterBand(1), &minFilter, winMid, outsideVal, outputType, allowEquals, resolvePlateaus);
+            GDALClose(outDataset);
         }
-        catch(rsgis::img::RSGISImageCalcException &e)
+        catch(rsgis::RSGISException &e)
         {
-            throw e;
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            throw rsgis::img::RSGISImageCalcException(e.what());
         }
-        catch(rsgis::img::RSGISImageBandException &e)
+        catch(std::exception &e)
         {
-            throw e;
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            throw rsgis::img::RSGISImageCalcException(e.what());
         }
-        delete findMinima;
 	}
     
+    void RSGISImageMorphologyFindExtrema::findBandMinima(GDALDataset *dataset, std::vector<unsigned int> bands, GDALRasterBand *outBand, rsgis::img::RSGISWindowMinFilter *minFilter, unsigned int winMid, float outsideVal, RSGISMinimaOutputs outputType, bool allowEquals, bool resolvePlateaus)
+    {
+        unsigned int width = dataset->GetRasterXSize();
+        unsigned int height = dataset->GetRasterYSize();
+        size_t nPxls = ((size_t)width) * ((size_t)height);
+        const float maxVal = std::numeric_limits<float>::infinity();
+        
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        dataset->GetRasterBand(bands.at(0))->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        // Process the image in strips (with a margin for the window) of whole blocks, at least 256 lines at a time.
+        unsigned int nRowsPerStrip = yBlockSize;
+        while(nRowsPerStrip < 256)
+        {
+            nRowsPerStrip += yBlockSize;
+        }
+        if(nRowsPerStrip > height)
+        {
+            nRowsPerStrip = height;
+        }
+        unsigned int nMaxRows = nRowsPerStrip + (2*winMid);
+        
+        std::vector<float> bandVals(((size_t)width) * nMaxRows);
+        std::vector<float> minVals(((size_t)width) * nMaxRows);
+        std::vector<float> filterVals(((size_t)width) * nMaxRows);
+        std::vector<float> winMinVals(((size_t)width) * nMaxRows);
+        std::vector<unsigned int> stripLabels;
+        
+        // Plateaus can span strips so the whole band is needed.
+        std::vector<float> allVals;
+        std::vector<unsigned char> isCand;
+        if(resolvePlateaus)
+        {
+            allVals.resize(nPxls);
+            isCand.resize(nPxls, 0);
+        }
+        else
+        {
+            stripLabels.resize(((size_t)width) * nRowsPerStrip);
+        }
+        
+        unsigned int label = 1;
+        rsgis_tqdm pbar;
+        for(unsigned int yStart = 0; yStart < height; yStart += nRowsPerStrip)
+        {
+            pbar.progress(yStart, height);
+            unsigned int yEnd = std::min(yStart + nRowsPerStrip, height);
+            unsigned int readStart = (yStart > winMid)?(yStart - winMid):0;
+            unsigned int readEnd = std::min(yEnd + winMid, height);
+            unsigned int nReadRows = readEnd - readStart;
+            size_t nReadPxls = ((size_t)width) * nReadRows;
+            
+            // Find the minimum across the bands, ignoring NaN.
+            for(size_t i = 0; i < bands.size(); ++i)
+            {
+                float *readBuf = (i == 0)?minVals.data():bandVals.data();
+                if(dataset->GetRasterBand(bands.at(i))->RasterIO(GF_Read, 0, readStart, width, nReadRows, readBuf, width, nReadRows, GDT_Float32, 0, 0) != CE_None)
+                {
+                    throw rsgis::img::RSGISImageCalcException("Could not read image data.");
+                }
+                if(i > 0)
+                {
+                    for(size_t n = 0; n < nReadPxls; ++n)
+                    {
+                        if(std::isnan(minVals[n]) || (bandVals[n] < minVals[n]))
+                        {
+                            minVals[n] = bandVals[n];
+                        }
+                    }
+                }
+            }
+            for(size_t n = 0; n < nReadPxls; ++n)
+            {
+                filterVals[n] = std::isnan(minVals[n])?maxVal:minVals[n];
+            }
+            minFilter->filter(filterVals.data(), winMinVals.data(), width, nReadRows, outsideVal);
+            
+            size_t rowOff = ((size_t)(yStart - readStart)) * width;
+            size_t nStripPxls = ((size_t)(yEnd - yStart)) * width;
+            for(size_t n = 0; n < nStripPxls; ++n)
+            {
+                float val = minVals[rowOff+n];
+                float winMin = winMinVals[rowOff+n];
+                bool isMinima = false;
+                if(!std::isnan(val))
+                {
+                    isMinima = (allowEquals || resolvePlateaus)?(val <= winMin):(val < winMin);
+                }
+                
+                if(resolvePlateaus)
+                {
+                    size_t idx = (((size_t)yStart) * width) + n;
+                    allVals[idx] = val;
+                    isCand[idx] = isMinima?1:0;
+                }
+                else if(isMinima)
+                {
+                    stripLabels[n] = label;
+                    if(outputType == RSGISImageMorphologyFindExtrema::sequential)
+                    {
+                        ++label;
+                    }
+                }
+                else
+                {
+                    stripLabels[n] = 0;
+                }
+            }
+            
+            if(!resolvePlateaus)
+            {
+                if(outBand->RasterIO(GF_Write, 0, yStart, width, (yEnd - yStart), stripLabels.data(), width, (yEnd - yStart), GDT_UInt32, 0, 0) != CE_None)
+                {
+                    throw rsgis::img::RSGISImageCalcException("Could not write output image data.");
+                }
+            }
+        }
+        pbar.finish();
+        
+        if(resolvePlateaus)
+        {
+            std::vector<unsigned int> labels(nPxls, 0);
+            this->labelPlateauMinima(allVals.data(), isCand.data(), labels.data(), width, height, outputType);
+            if(outBand->RasterIO(GF_Write, 0, 0, width, height, labels.data(), width, height, GDT_UInt32, 0, 0) != CE_None)
+            {
+                throw rsgis::img::RSGISImageCalcException("Could not write output image data.");
+            }
+        }
+    }
+    
+    void RSGISImageMorphologyFindExtrema::labelPlateauMinima(const float *vals, unsigned char *isCand, unsigned int *labels, unsigned int width, unsigned int height, RSGISMinimaOutputs outputType)
+    {
+        // isCand: bit 1 - the pixel is not above its window minimum; bit 2 - the pixel has been visited.
+        const unsigned char visited = 2;
+        size_t nPxls = ((size_t)width) * ((size_t)height);
+        std::vector<size_t> stack;
+        std::vector<size_t> plateau;
+        unsigned int label = 1;
+        for(size_t idx = 0; idx < nPxls; ++idx)
+        {
+            // Only start from candidates; the flood fill marks all other pixels of the plateau as visited.
+            if((isCand[idx] != 1) || std::isnan(vals[idx]))
+            {
+                continue;
+            }
+            
+            float val = vals[idx];
+            bool isMinima = true;
+            plateau.clear();
+            stack.clear();
+            stack.push_back(idx);
+            isCand[idx] |= visited;
+            while(!stack.empty())
+            {
+                size_t cIdx = stack.back();
+                stack.pop_back();
+                plateau.push_back(cIdx);
+                if(!(isCand[cIdx] & 1))
+                {
+                    isMinima = false;
+                }
+                
+                long cX = cIdx % width;
+                long cY = cIdx / width;
+                for(long dY = -1; dY <= 1; ++dY)
+                {
+                    long nY = cY + dY;
+                    if((nY < 0) || (nY >= (long)height))
+                    {
+                        continue;
+                    }
+                    for(long dX = -1; dX <= 1; ++dX)
+                    {
+                        long nX = cX + dX;
+                        if((nX < 0) || (nX >= (long)width) || ((dX == 0) && (dY == 0)))
+                        {
+                            continue;
+                        }
+                        size_t nIdx = (((size_t)nY) * width) + nX;
+                        if((!(isCand[nIdx] & visited)) && (vals[nIdx] == val))
+                        {
+                            isCand[nIdx] |= visited;
+                            stack.push_back(nIdx);
+                        }
+                    }
+                }
+            }
+            
+            if(isMinima)
+            {
+                for(std::vector<size_t>::iterator iterPxl = plateau.begin(); iterPxl != plateau.end(); ++iterPxl)
+                {
+                    labels[*iterPxl] = label;
+                }
+                if(outputType == RSGISImageMorphologyFindExtrema::sequential)
+                {
+                    ++label;
+                }
+            }
+        }
+    }
+    
+    std::vector<float> RSGISImageMorphologyFindExtrema::getStructElem(rsgis::math::Matrix *matrixOperator, bool excludeCentreRowCol)
+    {
+        int winMid = (matrixOperator->n-1)/2;
+        std::vector<float> structElem(matrixOperator->n * matrixOperator->m);
+        for(int i = 0; i < matrixOperator->m; ++i)
+        {
+            for(int j = 0; j < matrixOperator->n; ++j)
+            {
+                size_t idx = (i*matrixOperator->n)+j;
+                structElem[idx] = matrixOperator->matrix[idx];
+                if(excludeCentreRowCol && ((i == winMid) || (j == winMid)))
+                {
+                    structElem[idx] = 0;
+                }
+            }
+        }
+        return structElem;
+    }
+    
     
 	RSGISMorphologyFindLocalMinima::RSGISMorphologyFindLocalMinima(int numberOutBands, rsgis::math::Matrix *matrixOperator, RSGISImageMorphologyFindExtrema::RSGISMinimaOutputs outputType, bool allowEquals) : rsgis::img::RSGISCalcImageValue(numberOutBands)
 	{
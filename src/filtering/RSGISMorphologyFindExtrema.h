@@ -25,11 +25,17 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <cmath>
 #include "gdal_priv.h"
 
+#include "common/rsgis-tqdm.h"
+
 #include "img/RSGISImageBandException.h"
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISCalcImageValue.h"
+#include "img/RSGISImageUtils.h"
+#include "img/RSGISWindowMinFilter.h"
 
 #include "math/RSGISMatrices.h"
 
@@ -48,6 +54,26 @@
 
 namespace rsgis{namespace filter{
     
+    /**
+     * Finds the local minima of an image by comparing each pixel with the minimum
+     * of its neighbours within the operator window, which is calculated with
+     * RSGISWindowMinFilter so the cost does not depend on the window size. NaN
+     * pixels are never minima and are ignored as neighbours.
+     *
+     * If resolvePlateaus then plateaus (8-connected regions of equal value) are
+     * identified with a connected component pass and a plateau is a minimum if
+     * none of its pixels has a lower neighbour within the operator, where pixels
+     * outside the image are ignored. All the pixels of a plateau are given the
+     * same label and allowEquals is not used.
+     *
+     * Otherwise, each pixel is tested independently and allowEquals defines
+     * whether a pixel is a minimum when its value equals its lowest neighbour. As
+     * with RSGISMorphologyFindLocalMinima, the neighbours do not include the
+     * centre row and column of the operator and the image is padded with zeros.
+     *
+     * Sequential labels are assigned in raster order (by the first pixel of a
+     * plateau) starting at 1 for each band.
+     */
     class DllExport RSGISImageMorphologyFindExtrema
     {
     public:
@@ -57,9 +83,14 @@ namespace rsgis{namespace filter{
             sequential
         };
         RSGISImageMorphologyFindExtrema();
-        void findMinima(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, RSGISMinimaOutputs outputType, bool allowEquals, std::string format, GDALDataType outDataType);
-        void findMinimaAll(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, RSGISMinimaOutputs outputType, bool allowEquals, std::string format, GDALDataType outDataType);
+        void findMinima(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, RSGISMinimaOutputs outputType, bool allowEquals, std::string format, GDALDataType outDataType, bool resolvePlateaus=false);
+        /** The minima of the minimum value across all the image bands are output as a single band. */
+        void findMinimaAll(GDALDataset **datasets, std::string outputImage, rsgis::math::Matrix *matrixOperator, RSGISMinimaOutputs outputType, bool allowEquals, std::string format, GDALDataType outDataType, bool resolvePlateaus=false);
         ~RSGISImageMorphologyFindExtrema(){};
+    protected:
+        void findBandMinima(GDALDataset *dataset, std::vector<unsigned int> bands, GDALRasterBand *outBand, rsgis::img::RSGISWindowMinFilter *minFilter, unsigned int winMid, float outsideVal, RSGISMinimaOutputs outputType, bool allowEquals, bool resolvePlateaus);
+        void labelPlateauMinima(const float *vals, unsigned char *isCand, unsigned int *labels, unsigned int width, unsigned int height, RSGISMinimaOutputs outputType);
+        std::vector<float> getStructElem(rsgis::math::Matrix *matrixOperator, bool excludeCentreRowCol);
     };
     
     class DllExport RSGISMorphologyFindLocalMinima : public rsgis::img::RSGISCalcImageValue
@@ -46,15 +46,18 @@ namespace rsgis{namespace filter{
             outDataset = imgUtils.createCopy(dataset, outputImage, format, outDataType);
             imgUtils.zerosFloatGDALDataset(outDataset);
             
+            std::unique_ptr<rsgis::img::RSGISScratchRaster> tmpScratch;
             if(useMemory)
             {
-                tmpDataset = imgUtils.createCopy(dataset, tempImage, "MEM", outDataType);
+                // Zero initialised, in RAM or a memory mapped file if over the scratch memory budget.
+                tmpScratch.reset(new rsgis::img::RSGISScratchRaster(dataset, dataset->GetRasterCount(), outDataType));
+                tmpDataset = tmpScratch->getDataset();
             }
             else
             {
                 tmpDataset = imgUtils.createCopy(dataset, tempImage, format, outDataType);
+                imgUtils.zerosFloatGDALDataset(tmpDataset);
             }
-            imgUtils.zerosFloatGDALDataset(tmpDataset);
             
             
             rsgis::img::RSGISCalcImageValue *imgErode = new RSGISMorphologyErode(dataset->GetRasterCount(), matrixOperator);
@@ -81,7 +84,14 @@ namespace rsgis{namespace filter{
             delete[] tmpGDALDataArray;
             
             GDALClose(outDataset);
-            GDALClose(tmpDataset);
+            if(tmpScratch)
+            {
+                tmpScratch.reset();
+            }
+            else
+            {
+                GDALClose(tmpDataset);
+            }
         } 
         catch (rsgis::img::RSGISImageCalcException &e) 
         {
@@ -115,15 +125,18 @@ namespace rsgis{namespace filter{
             outDataset = imgUtils.createCopy(dataset, outputImage, format, outDataType);
             imgUtils.zerosFloatGDALDataset(outDataset);
             
+            std::unique_ptr<rsgis::img::RSGISScratchRaster> tmpScratch;
             if(useMemory)
             {
-                tmpDataset = imgUtils.createCopy(dataset, tempImage, "MEM", outDataType);
+                // Zero initialised, in RAM or a memory mapped file if over the scratch memory budget.
+                tmpScratch.reset(new rsgis::img::RSGISScratchRaster(dataset, dataset->GetRasterCount(), outDataType));
+                tmpDataset = tmpScratch->getDataset();
             }
             else
             {
                 tmpDataset = imgUtils.createCopy(dataset, tempImage, format, outDataType);
+                imgUtils.zerosFloatGDALDataset(tmpDataset);
             }
-            imgUtils.zerosFloatGDALDataset(tmpDataset);
             
             
             rsgis::img::RSGISCalcImageValue *imgErode = new RSGISMorphologyErode(dataset->GetRasterCount(), matrixOperator);
@@ -150,7 +163,14 @@ namespace rsgis{namespace filter{
             delete[] tmpGDALDataArray;
             
             GDALClose(outDataset);
-            GDALClose(tmpDataset);
+            if(tmpScratch)
+            {
+                tmpScratch.reset();
+            }
+            else
+            {
+                GDALClose(tmpDataset);
+            }
         } 
         catch (rsgis::img::RSGISImageCalcException &e) 
         {
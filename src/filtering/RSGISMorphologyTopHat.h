@@ -31,6 +31,7 @@
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISImageUtils.h"
+#include "img/RSGISScratchRaster.h"
 
 #include "filtering/RSGISMorphologyErode.h"
 #include "filtering/RSGISMorphologyDilate.h"
@@ -32,6 +32,8 @@ namespace rsgis{namespace img{
 		this->b = 0;
 		this->aSQ = 0;
 		this->bSQ = 0;
+		this->havePairMoments = false;
+		this->pairMomentsCC = 0;
 	}
 	
 	void RSGISCalcCC::calcImageValue(float *bandValuesImageA, float *bandValuesImageB, int numBands, int bandA, int bandB) 
@@ -55,8 +57,19 @@ namespace rsgis{namespace img{
 		bSQ += (bandValuesImageB[bandB] * bandValuesImageB[bandB]);
 	}
 
+	void RSGISCalcCC::setPairMoments(const RSGISImagePairMoments &moments, int bandA, int bandB)
+	{
+		this->pairMomentsCC = moments.getCorrelation();
+		this->havePairMoments = true;
+	}
+
 	double* RSGISCalcCC::getOutputValues()  
 	{
+		if(this->havePairMoments)
+		{
+			this->outputValues[0] = this->pairMomentsCC;
+			return this->outputValues;
+		}
 		double partA = n * ab;
 		double partB = a * b;
 		double topline = partA - partB;
@@ -77,6 +90,8 @@ namespace rsgis{namespace img{
 		this->b = 0;
 		this->aSQ = 0;
 		this->bSQ = 0;
+		this->havePairMoments = false;
+		this->pairMomentsCC = 0;
 	}
     
 }}
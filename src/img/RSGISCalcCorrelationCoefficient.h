@@ -52,6 +52,8 @@ namespace rsgis{namespace img{
 			void calcImageValue(float *bandValuesImageA, float *bandValuesImageB, int numBands, int bandA, int bandB);
 			double* getOutputValues();
 			void reset();
+			bool usesPairMoments() {return true;};
+			void setPairMoments(const RSGISImagePairMoments &moments, int bandA, int bandB);
 			void setBandA(int band);
 			void setBandB(int band);
 			int getBandA();
@@ -63,6 +65,8 @@ namespace rsgis{namespace img{
 			double b;
 			double aSQ;
 			double bSQ;
+			bool havePairMoments;
+			double pairMomentsCC;
 		}; 
     
 }}
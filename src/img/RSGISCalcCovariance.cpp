@@ -31,6 +31,8 @@ namespace rsgis{namespace img{
 		this->sum = 0;
 		this->aMeans = aMeans;
 		this->bMeans = bMeans;
+		this->havePairMoments = false;
+		this->pairMomentsCovar = 0;
 	}
 	
 	void RSGISCalcCovariance::calcImageValue(float *bandValuesImageA, float *bandValuesImageB, int numBands, int bandA, int bandB) 
@@ -50,8 +52,19 @@ namespace rsgis{namespace img{
 		sum += ((bandValuesImageA[bandA]-aMeans->matrix[bandA])*(bandValuesImageB[bandB]-bMeans->matrix[bandB]));
 	}
 
+	void RSGISCalcCovariance::setPairMoments(const RSGISImagePairMoments &moments, int bandA, int bandB)
+	{
+		this->pairMomentsCovar = moments.getCovariance(aMeans->matrix[bandA], bMeans->matrix[bandB]);
+		this->havePairMoments = true;
+	}
+
 	double* RSGISCalcCovariance::getOutputValues()  
 	{
+		if(this->havePairMoments)
+		{
+			this->outputValues[0] = this->pairMomentsCovar;
+			return outputValues;
+		}
 		this->outputValues[0] = sum/(n-1);
 		return outputValues;
 	}
@@ -60,6 +73,7 @@ namespace rsgis{namespace img{
 	{
 		this->n = 0;
 		this->sum = 0;
+		this->havePairMoments = false;
 	}
     
     
@@ -54,9 +54,13 @@ namespace rsgis{namespace img{
 			void calcImageValue(float *bandValuesImageA, float *bandValuesImageB, int numBands, int bandA, int bandB);
 			double* getOutputValues();
 			void reset();
+			bool usesPairMoments() {return true;};
+			void setPairMoments(const RSGISImagePairMoments &moments, int bandA, int bandB);
 		private:
 			int n;
 			double sum;
+			bool havePairMoments;
+			double pairMomentsCovar;
 			rsgis::math::Matrix *aMeans;
 			rsgis::math::Matrix *bMeans;
 		};
@@ -26,13 +26,20 @@ namespace rsgis
 {
 	namespace img
 	{
-        RSGISCalcEditImage::RSGISCalcEditImage(RSGISCalcImageValue *valueCalc)
+        RSGISCalcEditImage::RSGISCalcEditImage(RSGISCalcImageValue *valueCalc, unsigned int numThreads)
         {
             calc = valueCalc;
+            this->numThreads = numThreads;
         }
             
         void RSGISCalcEditImage::calcImage(GDALDataset *dataset)
         {
+            if(this->numThreads != 1)
+            {
+                this->calcImageInStrips(dataset, rsgis_edit_extent, 1, 0);
+                return;
+            }
+            
             RSGISImageUtils imgUtils;
             double *gdalTranslation = new double[6];
 
@@ -210,6 +217,12 @@ namespace rsgis
         
         void RSGISCalcEditImage::calcImageUseOut(GDALDataset *dataset)
         {
+            if(this->numThreads != 1)
+            {
+                this->calcImageInStrips(dataset, rsgis_edit_useout, 1, 0);
+                return;
+            }
+            
             RSGISImageUtils imgUtils;
             
             int height = 0;
@@ -466,6 +479,11 @@ namespace rsgis
             {
                 throw RSGISImageBandException("Dataset is not valid.");
             }
+            if(this->numThreads != 1)
+            {
+                this->calcImageInStrips(dataset, rsgis_edit_window, windowSize, fillval);
+                return;
+            }
             
             RSGISImageUtils imgUtils;
             int height = 0;
@@ -1293,6 +1311,197 @@ namespace rsgis
             }
         }
         
+        void RSGISCalcEditImage::calcImageInStrips(GDALDataset *dataset, RSGISEditMode editMode, int windowSize, float fillval)
+        {
+            if(dataset == NULL)
+            {
+                throw RSGISImageBandException("Dataset is not valid.");
+            }
+            int windowMid = 0;
+            if(editMode == rsgis_edit_window)
+            {
+                if(windowSize % 2 == 0)
+                {
+                    throw RSGISImageCalcException("Window size needs to be an odd number (min = 3).");
+                }
+                else if(windowSize < 3)
+                {
+                    throw RSGISImageCalcException("Window size needs to be 3 or greater and an odd number.");
+                }
+                windowMid = (windowSize-1)/2;
+            }
+            
+            int numBands = dataset->GetRasterCount();
+            int width = dataset->GetRasterXSize();
+            int height = dataset->GetRasterYSize();
+            if((numBands == 0) || (width == 0) || (height == 0))
+            {
+                return;
+            }
+            std::vector<GDALRasterBand*> rasterBands;
+            for(int i = 0; i < numBands; i++)
+            {
+                rasterBands.push_back(dataset->GetRasterBand(i+1));
+            }
+            
+            double gdalTranslation[6];
+            dataset->GetGeoTransform(gdalTranslation);
+            double pxlWidth = gdalTranslation[1];
+            double pxlHeight = gdalTranslation[5];
+            if(pxlHeight < 0)
+            {
+                pxlHeight *= (-1);
+            }
+            
+            int xBlockSize = 0;
+            int yBlockSize = 0;
+            rasterBands[0]->GetBlockSize(&xBlockSize, &yBlockSize);
+            if(yBlockSize < 1)
+            {
+                yBlockSize = 1;
+            }
+            // Read whole rows of blocks, at least 256 lines (and the window half size) at a time.
+            int nRowsPerRead = yBlockSize;
+            while((nRowsPerRead < 256) || (nRowsPerRead < windowMid))
+            {
+                nRowsPerRead += yBlockSize;
+            }
+            if(nRowsPerRead > height)
+            {
+                nRowsPerRead = height;
+            }
+            
+            // Each input strip has windowMid rows of halo above and below the rows being edited.
+            size_t rowLen = width;
+            size_t nBufRows = nRowsPerRead + (2 * windowMid);
+            std::vector<std::vector<float> > inData(numBands, std::vector<float>(nBufRows*rowLen, fillval));
+            std::vector<std::vector<double> > outData(numBands, std::vector<double>(((size_t)nRowsPerRead)*rowLen));
+            
+            RSGISThreadPool threadPool(this->numThreads);
+            int nReads = (height + nRowsPerRead - 1) / nRowsPerRead;
+            int prevNRows = 0;
+            rsgis_tqdm pbar;
+            for(int i = 0; i < nReads; i++)
+            {
+                pbar.progress(i, nReads);
+                int yOff = i * nRowsPerRead;
+                int nRows = std::min(nRowsPerRead, height - yOff);
+                
+                // The halo above is the unedited last rows of the previous strip, which have now been overwritten in the image.
+                if((i > 0) && (windowMid > 0))
+                {
+                    for(int n = 0; n < numBands; n++)
+                    {
+                        std::memmove(inData[n].data(), inData[n].data() + (((size_t)prevNRows) * rowLen), sizeof(float) * windowMid * rowLen);
+                    }
+                }
+                
+                int nLowerRows = std::min(windowMid, height - (yOff + nRows));
+                for(int n = 0; n < numBands; n++)
+                {
+                    float *stripData = inData[n].data() + (((size_t)windowMid) * rowLen);
+                    if(rasterBands[n]->RasterIO(GF_Read, 0, yOff, width, nRows, stripData, width, nRows, GDT_Float32, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageCalcException("Could not read image data.");
+                    }
+                    float *lowerData = stripData + (((size_t)nRows) * rowLen);
+                    if(nLowerRows > 0)
+                    {
+                        if(rasterBands[n]->RasterIO(GF_Read, 0, yOff+nRows, width, nLowerRows, lowerData, width, nLowerRows, GDT_Float32, 0, 0) != CE_None)
+                        {
+                            throw RSGISImageCalcException("Could not read image data.");
+                        }
+                    }
+                    std::fill(lowerData + (((size_t)std::max(nLowerRows, 0)) * rowLen), lowerData + (((size_t)windowMid) * rowLen), fillval);
+                }
+                
+                threadPool.parallelFor(0, nRows, [&](unsigned long startRow, unsigned long endRow)
+                {
+                    std::vector<float> inDataColumn(numBands);
+                    std::vector<double> outDataColumn(numBands);
+                    std::vector<float> winVals;
+                    std::vector<float*> winRows;
+                    std::vector<float**> winBands;
+                    if(editMode == rsgis_edit_window)
+                    {
+                        winVals.resize(((size_t)numBands) * windowSize * windowSize);
+                        winRows.resize(((size_t)numBands) * windowSize);
+                        winBands.resize(numBands);
+                        for(int n = 0; n < numBands; n++)
+                        {
+                            for(int y = 0; y < windowSize; y++)
+                            {
+                                winRows[(n*windowSize)+y] = winVals.data() + ((((size_t)n * windowSize) + y) * windowSize);
+                            }
+                            winBands[n] = winRows.data() + (n*windowSize);
+                        }
+                    }
+                    OGREnvelope extent;
+                    for(unsigned long r = startRow; r < endRow; ++r)
+                    {
+                        size_t outRowOff = r * rowLen;
+                        for(int j = 0; j < width; j++)
+                        {
+                            if(editMode == rsgis_edit_window)
+                            {
+                                for(int n = 0; n < numBands; n++)
+                                {
+                                    for(int y = 0; y < windowSize; y++)
+                                    {
+                                        // Buffer row of the window row is (windowMid + r) + (y - windowMid).
+                                        const float *inRow = inData[n].data() + ((r + y) * rowLen);
+                                        for(int x = 0; x < windowSize; x++)
+                                        {
+                                            int xIdx = j + (x - windowMid);
+                                            winBands[n][y][x] = ((xIdx < 0) || (xIdx >= width))?fillval:inRow[xIdx];
+                                        }
+                                    }
+                                }
+                                this->calc->calcImageValue(winBands.data(), numBands, windowSize, outDataColumn.data());
+                            }
+                            else
+                            {
+                                for(int n = 0; n < numBands; n++)
+                                {
+                                    inDataColumn[n] = inData[n][outRowOff + j];
+                                }
+                                if(editMode == rsgis_edit_extent)
+                                {
+                                    extent.MinX = gdalTranslation[0] + (j * pxlWidth);
+                                    extent.MaxX = extent.MinX + pxlWidth;
+                                    extent.MinY = gdalTranslation[3] - ((yOff + r) * pxlHeight);
+                                    extent.MaxY = extent.MinY - pxlHeight;
+                                    this->calc->calcImageValue(inDataColumn.data(), numBands, extent);
+                                    for(int n = 0; n < numBands; n++)
+                                    {
+                                        outDataColumn[n] = inDataColumn[n];
+                                    }
+                                }
+                                else
+                                {
+                                    this->calc->calcImageValue(inDataColumn.data(), numBands, outDataColumn.data());
+                                }
+                            }
+                            for(int n = 0; n < numBands; n++)
+                            {
+                                outData[n][outRowOff + j] = outDataColumn[n];
+                            }
+                        }
+                    }
+                });
+                
+                for(int n = 0; n < numBands; n++)
+                {
+                    if(rasterBands[n]->RasterIO(GF_Write, 0, yOff, width, nRows, outData[n].data(), width, nRows, GDT_Float64, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageCalcException("Could not write image data.");
+                    }
+                }
+                prevNRows = nRows;
+            }
+            pbar.finish();
+        }
+        
         RSGISCalcEditImage::~RSGISCalcEditImage()
         {
             
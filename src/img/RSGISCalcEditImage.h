@@ -25,10 +25,14 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
 
 #include "gdal_priv.h"
 
 #include "common/rsgis-tqdm.h"
+#include "common/RSGISThreadPool.h"
 
 #include "img/RSGISPixelInPoly.h"
 #include "img/RSGISImageCalcException.h"
@@ -52,16 +56,35 @@ namespace rsgis
 {
 	namespace img
 	{
+        /**
+         * Applies a RSGISCalcImageValue to a dataset, writing the result back to the same dataset.
+         *
+         * If numThreads is not 1 (0 uses all the available cores) the image is processed in strips
+         * of whole GDAL blocks, with the rows of each strip calculated in parallel; the calc must
+         * then be thread safe (i.e., calcImageValue must not modify the object). For window
+         * calculations the window rows above a strip are staged from the unedited values of the
+         * previous strip rather than re-read, so (as for the serial implementation) every window
+         * only contains the values from before the edit and the result does not depend on the
+         * number of threads.
+         */
 		class DllExport RSGISCalcEditImage
         {
         public:
-            RSGISCalcEditImage(RSGISCalcImageValue *valueCalc);
+            RSGISCalcEditImage(RSGISCalcImageValue *valueCalc, unsigned int numThreads=1);
             void calcImage(GDALDataset *dataset);
             void calcImageUseOut(GDALDataset *dataset);
             void calcImageWindowData(GDALDataset *dataset, int windowSize, float fillval=0);
             ~RSGISCalcEditImage();
         private:
+            enum RSGISEditMode
+            {
+                rsgis_edit_extent,
+                rsgis_edit_useout,
+                rsgis_edit_window
+            };
+            void calcImageInStrips(GDALDataset *dataset, RSGISEditMode editMode, int windowSize, float fillval);
             RSGISCalcImageValue *calc;
+            unsigned int numThreads;
         };
 	}
 }
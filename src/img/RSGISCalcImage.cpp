@@ -30,6 +30,11 @@ namespace rsgis{namespace img{
 		this->numOutBands = valueCalc->getNumOutBands();
 		this->proj = proj;
 		this->useImageProj = useImageProj;
+        this->skipNoDataBlocks = false;
+        this->inNoDataVal = 0.0;
+        this->outNoDataVal = 0.0;
+        this->useImgNoData = true;
+        this->threadPool = NULL;
 	}
     
     
@@ -145,6 +150,22 @@ namespace rsgis{namespace img{
 				outputData[i] = (double *) CPLMalloc(sizeof(double)*(width*yBlockSize));
 			}
 			outDataColumn = new double[this->numOutBands];
+            
+            float *inNoDataVals = NULL;
+            // Blocks are skipped a tile (the width of an image block) at a time within each row of blocks.
+            int xTileSize = ((xBlockSize > 0) && (xBlockSize < width))?xBlockSize:std::min(width, 256);
+            int nXTiles = (width + xTileSize - 1) / xTileSize;
+            unsigned long numSkippedTiles = 0;
+            if(this->skipNoDataBlocks)
+            {
+                inNoDataVals = new float[numInBands];
+                this->getBandsNoDataVals(inputRasterBands, numInBands, inNoDataVals);
+                for(int i = 0; i < this->numOutBands; i++)
+                {
+                    outputRasterBands[i]->SetNoDataValue(this->outNoDataVal);
+                }
+            }
+            size_t numBlockPxls = ((size_t)width) * ((size_t)yBlockSize);
                       
             int nYBlocks = floor(((double)height) / ((double)yBlockSize));
             int remainRows = height - (nYBlocks * yBlockSize);
@@ -154,13 +175,27 @@ namespace rsgis{namespace img{
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
-				for(int n = 0; n < numInBands; n++)
-				{
-                    rowOffset = bandOffsets[n][1] + (yBlockSize * i);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
-				}
+                if(this->skipNoDataBlocks)
+                {
+                    pbar.progress((i*yBlockSize), height);
+                    numSkippedTiles += this->calcBlockRowSkipNoData(inputRasterBands, bandOffsets, numInBands, inNoDataVals, inputData, outputData, width, xTileSize, (yBlockSize * i), yBlockSize);
+                }
+                else
+                {
+                    for(int n = 0; n < numInBands; n++)
+                    {
+                        rowOffset = bandOffsets[n][1] + (yBlockSize * i);
+                        inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
+                    }
+                    
+                    if(this->threadPool != NULL)
+                    {
+                        pbar.progress((i*yBlockSize), height);
+                        this->calcBlockPxls(inputData, numInBands, outputData, NULL, numBlockPxls);
+                    }
+                }
                 
-                for(int m = 0; m < yBlockSize; ++m)
+                for(int m = 0; (m < yBlockSize) && (!this->skipNoDataBlocks) && (this->threadPool == NULL); ++m)
                 {
                     pbar.progress((i*yBlockSize)+m, height);
                                         
@@ -190,13 +225,27 @@ namespace rsgis{namespace img{
             
             if(remainRows > 0)
             {
-                for(int n = 0; n < numInBands; n++)
-				{
-                    rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
-					inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
-				}
+                if(this->skipNoDataBlocks)
+                {
+                    pbar.progress((nYBlocks*yBlockSize), height);
+                    numSkippedTiles += this->calcBlockRowSkipNoData(inputRasterBands, bandOffsets, numInBands, inNoDataVals, inputData, outputData, width, xTileSize, (yBlockSize * nYBlocks), remainRows);
+                }
+                else
+                {
+                    for(int n = 0; n < numInBands; n++)
+                    {
+                        rowOffset = bandOffsets[n][1] + (yBlockSize * nYBlocks);
+                        inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
+                    }
+                    
+                    if(this->threadPool != NULL)
+                    {
+                        pbar.progress((nYBlocks*yBlockSize), height);
+                        this->calcBlockPxls(inputData, numInBands, outputData, NULL, ((size_t)width) * ((size_t)remainRows));
+                    }
+                }
                                 
-                for(int m = 0; m < remainRows; ++m)
+                for(int m = 0; (m < remainRows) && (!this->skipNoDataBlocks) && (this->threadPool == NULL); ++m)
                 {
                     pbar.progress((nYBlocks*yBlockSize)+m, height);
                     
@@ -224,6 +273,12 @@ namespace rsgis{namespace img{
 				}
             }
 			pbar.finish();
+            
+            if(this->skipNoDataBlocks)
+            {
+                std::cout << "Skipped " << numSkippedTiles << " of " << (((unsigned long)nXTiles) * (nYBlocks + ((remainRows > 0)?1:0))) << " blocks as no data." << std::endl;
+                delete[] inNoDataVals;
+            }
 		}
 		catch(RSGISImageCalcException& e)
 		{
@@ -600,7 +655,13 @@ namespace rsgis{namespace img{
                     inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, yBlockSize, inputData[n], width, yBlockSize, GDT_Float32, 0, 0);
                 }
                 
-                for(int m = 0; m < yBlockSize; ++m)
+                if(this->threadPool != NULL)
+                {
+                    pbar.progress((i*yBlockSize), height);
+                    this->calcBlockPxls(inputData, numInBands, outputData, outputRefData, ((size_t)width) * ((size_t)yBlockSize));
+                }
+                
+                for(int m = 0; (m < yBlockSize) && (this->threadPool == NULL); ++m)
                 {
                     pbar.progress((i*yBlockSize)+m, height);
                     
@@ -637,7 +698,13 @@ namespace rsgis{namespace img{
                     inputRasterBands[n]->RasterIO(GF_Read, bandOffsets[n][0], rowOffset, width, remainRows, inputData[n], width, remainRows, GDT_Float32, 0, 0);
                 }
                 
-                for(int m = 0; m < remainRows; ++m)
+                if(this->threadPool != NULL)
+                {
+                    pbar.progress((nYBlocks*yBlockSize), height);
+                    this->calcBlockPxls(inputData, numInBands, outputData, outputRefData, ((size_t)width) * ((size_t)remainRows));
+                }
+                
+                for(int m = 0; (m < remainRows) && (this->threadPool == NULL); ++m)
                 {
                     pbar.progress((nYBlocks*yBlockSize)+m, height);
                     
@@ -6364,7 +6431,6 @@ namespace rsgis{namespace img{
 		GDALRasterBand **inputRasterBands = NULL;
         
         OGREnvelope extent;
-		double pxlTLX = 0;
 		double pxlTLY = 0;
 		double pxlWidth = 0;
 		double pxlHeight = 0;
@@ -6387,7 +6453,6 @@ namespace rsgis{namespace img{
 				numInBands += datasets[i]->GetRasterCount();
 			}
 			
-			pxlTLX = gdalTranslation[0];
 			pxlTLY = gdalTranslation[3];
 			pxlWidth = gdalTranslation[1];
 			pxlHeight = gdalTranslation[5];
@@ -6426,9 +6491,18 @@ namespace rsgis{namespace img{
             {
                 pbar = new rsgis_tqdm();
             }
+            // The pixel edges are calculated from the transform for each column and row rather than accumulated.
+            // Only the origin and pixel size are used as the OGREnvelope passed to the calculators cannot hold a rotation.
+            std::vector<double> pxlColMinX(width);
+            for(int j = 0; j < width; j++)
+            {
+                pxlColMinX[j] = gdalTranslation[0] + (j * pxlWidth);
+            }
+            
 			// Loop images to process data
 			for(int i = 0; i < height; i++)
 			{
+				pxlTLY = gdalTranslation[3] - (i * pxlHeight);
 				if(!quiet)
                 {
                     pbar->progress(i, height);
@@ -6446,17 +6520,14 @@ namespace rsgis{namespace img{
 						inDataColumn[n] = inputData[n][j];
 					}
 					
-                    extent.MinX = pxlTLX;
-                    extent.MaxX = (pxlTLX+pxlWidth);
+                    extent.MinX = pxlColMinX[j];
+                    extent.MaxX = (pxlColMinX[j]+pxlWidth);
                     extent.MinY = (pxlTLY-pxlHeight);
                     extent.MaxY = pxlTLY;
 					
 					this->calc->calcImageValue(inDataColumn, numInBands, extent);
 					
-					pxlTLX += pxlWidth;
 				}
-				pxlTLY -= pxlHeight;
-				pxlTLX = gdalTranslation[0];
 			}
             if(!quiet)
             {
@@ -6656,7 +6727,6 @@ namespace rsgis{namespace img{
         OGREnvelope extent;
         double imgTLX = 0;
         double imgTLY = 0;
-        double pxlTLX = 0;
         double pxlTLY = 0;
         double pxlWidth = 0;
         double pxlHeight = 0;
@@ -6742,6 +6812,14 @@ namespace rsgis{namespace img{
             pxlTLY = imgTLY;
             
 			rsgis_tqdm pbar;
+            // The pixel edges are calculated from the transform for each column and row rather than accumulated.
+            // Only the origin and pixel size are used as the OGREnvelope passed to the calculators cannot hold a rotation.
+            std::vector<double> pxlColMinX(width);
+            for(int j = 0; j < width; j++)
+            {
+                pxlColMinX[j] = imgTLX + (j * pxlWidth);
+            }
+            
 			// Loop images to process data
 			for(int i = 0; i < nYBlocks; i++)
 			{
@@ -6760,8 +6838,8 @@ namespace rsgis{namespace img{
                 for(int m = 0; m < yBlockSize; ++m)
                 {
                     pbar.progress((i*yBlockSize)+m, height);
+                    pxlTLY = imgTLY - (((i*yBlockSize)+m) * pxlHeight);
                     
-                    pxlTLX = imgTLX;
                     for(int j = 0; j < width; j++)
                     {
                         for(int n = 0; n < numIntBands; n++)
@@ -6774,16 +6852,14 @@ namespace rsgis{namespace img{
                             inDataFloatColumn[n] = inputFloatData[n][(m*width)+j];
                         }
                         
-                        extent.MinX = pxlTLX;
-                        extent.MaxX = (pxlTLX+pxlWidth);
+                        extent.MinX = pxlColMinX[j];
+                        extent.MaxX = (pxlColMinX[j]+pxlWidth);
                         extent.MinY = (pxlTLY-pxlHeight);
                         extent.MaxY = pxlTLY;
                         
                         this->calc->calcImageValue(inDataIntColumn, numIntBands, inDataFloatColumn, numFloatBands, extent);
                         
-                        pxlTLX += pxlWidth;
                     }
-                    pxlTLY -= pxlHeight;
                 }
 			}
             
@@ -6805,8 +6881,8 @@ namespace rsgis{namespace img{
                 for(int m = 0; m < remainRows; ++m)
                 {
                     pbar.progress((nYBlocks*yBlockSize)+m, height);
+                    pxlTLY = imgTLY - (((nYBlocks*yBlockSize)+m) * pxlHeight);
                     
-                    pxlTLX = imgTLX;
                     for(int j = 0; j < width; j++)
                     {
                         for(int n = 0; n < numIntBands; n++)
@@ -6819,15 +6895,13 @@ namespace rsgis{namespace img{
                             inDataFloatColumn[n] = inputFloatData[n][(m*width)+j];
                         }
                         
-                        extent.MinX = pxlTLX;
-                        extent.MaxX = (pxlTLX+pxlWidth);
+                        extent.MinX = pxlColMinX[j];
+                        extent.MaxX = (pxlColMinX[j]+pxlWidth);
                         extent.MinY = (pxlTLY-pxlHeight);
                         extent.MaxY = pxlTLY;
                         
                         this->calc->calcImageValue(inDataIntColumn, numIntBands, inDataFloatColumn, numFloatBands, extent);
-                        pxlTLX += pxlWidth;
                     }
-                    pxlTLY -= pxlHeight;
                 }
             }
 			pbar.finish();
@@ -7120,7 +7194,6 @@ namespace rsgis{namespace img{
 		GDALRasterBand **outputRasterBands = NULL;
 		GDALDriver *gdalDriver = NULL;
 		OGREnvelope extent;
-		double pxlTLX = 0;
 		double pxlTLY = 0;
 		double pxlWidth = 0;
 		double pxlHeight = 0;
@@ -7160,7 +7233,6 @@ namespace rsgis{namespace img{
 				outputImageDS->SetProjection(proj.c_str());
 			}
 			
-			pxlTLX = gdalTranslation[0];
 			pxlTLY = gdalTranslation[3];
 			pxlWidth = gdalTranslation[1];
 			pxlHeight = gdalTranslation[5];
@@ -7209,9 +7281,18 @@ namespace rsgis{namespace img{
 			outDataColumn = new double[this->numOutBands];
 			
 			rsgis_tqdm pbar;
+            // The pixel edges are calculated from the transform for each column and row rather than accumulated.
+            // Only the origin and pixel size are used as the OGREnvelope passed to the calculators cannot hold a rotation.
+            std::vector<double> pxlColMinX(width);
+            for(int j = 0; j < width; j++)
+            {
+                pxlColMinX[j] = gdalTranslation[0] + (j * pxlWidth);
+            }
+            
 			// Loop images to process data
 			for(int i = 0; i < height; i++)
 			{
+				pxlTLY = gdalTranslation[3] - (i * pxlHeight);
 				pbar.progress(i, height);
 				
 				for(int n = 0; n < numInBands; n++)
@@ -7226,23 +7307,19 @@ namespace rsgis{namespace img{
 						inDataColumn[n] = inputData[n][j];
 					}
 					
-                    extent.MinX = pxlTLX;
-                    extent.MaxX = (pxlTLX+pxlWidth);
+                    extent.MinX = pxlColMinX[j];
+                    extent.MaxX = (pxlColMinX[j]+pxlWidth);
                     extent.MinY = (pxlTLY-pxlHeight);
                     extent.MaxY = pxlTLY;
 					
 					this->calc->calcImageValue(inDataColumn, numInBands, outDataColumn, extent);
 					
-					pxlTLX += pxlWidth;
-					
 					for(int n = 0; n < this->numOutBands; n++)
 					{
 						outputData[n][j] = outDataColumn[n];
 					}
 					
 				}
-				pxlTLY -= pxlHeight;
-				pxlTLX = gdalTranslation[0];
 				
 				for(int n = 0; n < this->numOutBands; n++)
 				{
@@ -14544,9 +14621,213 @@ namespace rsgis{namespace img{
         }
     }
     
+    void RSGISCalcImage::setSkipNoDataBlocks(bool skipNoDataBlocks, float inNoDataVal, double outNoDataVal, bool useImgNoData)
+    {
+        this->skipNoDataBlocks = skipNoDataBlocks;
+        this->inNoDataVal = inNoDataVal;
+        this->outNoDataVal = outNoDataVal;
+        this->useImgNoData = useImgNoData;
+    }
+    
+    void RSGISCalcImage::getBandsNoDataVals(GDALRasterBand **bands, int numBands, float *noDataVals)
+    {
+        for(int n = 0; n < numBands; n++)
+        {
+            int hasNoData = 0;
+            double bandNoDataVal = bands[n]->GetNoDataValue(&hasNoData);
+            if(this->useImgNoData && hasNoData)
+            {
+                noDataVals[n] = bandNoDataVal;
+            }
+            else
+            {
+                noDataVals[n] = this->inNoDataVal;
+            }
+        }
+    }
+    
+    bool RSGISCalcImage::blockCoverageEmpty(GDALRasterBand **bands, int **bandOffsets, int numBands, float *noDataVals, int xOff, int width, int blockRowOffset, int nRows)
+    {
+        for(int n = 0; n < numBands; n++)
+        {
+            // Empty (sparse) blocks are read as the band no data value or 0 if not defined.
+            int hasNoData = 0;
+            double fillVal = bands[n]->GetNoDataValue(&hasNoData);
+            if(!hasNoData)
+            {
+                fillVal = 0.0;
+            }
+            if(((float)fillVal) != noDataVals[n])
+            {
+                return false;
+            }
+            
+            int status = bands[n]->GetDataCoverageStatus(bandOffsets[n][0] + xOff, bandOffsets[n][1] + blockRowOffset, width, nRows, 0, NULL);
+            if((status & GDAL_DATA_COVERAGE_STATUS_UNIMPLEMENTED) || (status & GDAL_DATA_COVERAGE_STATUS_DATA))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    bool RSGISCalcImage::blockAllNoData(float **data, int numBands, float *noDataVals, int rowWidth, int xOff, int width, int nRows)
+    {
+        for(int n = 0; n < numBands; n++)
+        {
+            float noDataVal = noDataVals[n];
+            bool noDataIsNaN = std::isnan(noDataVal);
+            for(int m = 0; m < nRows; ++m)
+            {
+                float *rowData = data[n] + (((size_t)m) * rowWidth) + xOff;
+                for(int j = 0; j < width; ++j)
+                {
+                    if(noDataIsNaN?(!std::isnan(rowData[j])):(rowData[j] != noDataVal))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+    
+    unsigned long RSGISCalcImage::calcBlockRowSkipNoData(GDALRasterBand **bands, int **bandOffsets, int numInBands, float *noDataVals, float **inputData, double **outputData, int width, int xTileSize, int blockRowOffset, int nRows)
+    {
+        // Tiles the driver reports as empty for all the bands are not read, otherwise the row of
+        // blocks is read and each tile checked for any data.
+        int nXTiles = (width + xTileSize - 1) / xTileSize;
+        std::vector<unsigned char> tileEmpty(nXTiles, 0);
+        bool allEmpty = true;
+        for(int t = 0; t < nXTiles; ++t)
+        {
+            int xOff = t * xTileSize;
+            tileEmpty[t] = this->blockCoverageEmpty(bands, bandOffsets, numInBands, noDataVals, xOff, std::min(xTileSize, width - xOff), blockRowOffset, nRows);
+            allEmpty = allEmpty && tileEmpty[t];
+        }
+        if(!allEmpty)
+        {
+            for(int n = 0; n < numInBands; n++)
+            {
+                bands[n]->RasterIO(GF_Read, bandOffsets[n][0], bandOffsets[n][1] + blockRowOffset, width, nRows, inputData[n], width, nRows, GDT_Float32, 0, 0);
+            }
+            for(int t = 0; t < nXTiles; ++t)
+            {
+                if(!tileEmpty[t])
+                {
+                    int xOff = t * xTileSize;
+                    tileEmpty[t] = this->blockAllNoData(inputData, numInBands, noDataVals, width, xOff, std::min(xTileSize, width - xOff), nRows);
+                }
+            }
+        }
+        
+        auto calcRows = [&](unsigned long rowStart, unsigned long rowEnd)
+        {
+            std::vector<float> inDataColumn(numInBands);
+            std::vector<double> outDataColumn(this->numOutBands);
+            for(unsigned long m = rowStart; m < rowEnd; ++m)
+            {
+                size_t rowOff = ((size_t)m) * width;
+                for(int t = 0; t < nXTiles; ++t)
+                {
+                    int xOff = t * xTileSize;
+                    int xEnd = std::min(xOff + xTileSize, width);
+                    if(tileEmpty[t])
+                    {
+                        for(int n = 0; n < this->numOutBands; n++)
+                        {
+                            std::fill(outputData[n] + rowOff + xOff, outputData[n] + rowOff + xEnd, this->outNoDataVal);
+                        }
+                        continue;
+                    }
+                    for(int j = xOff; j < xEnd; j++)
+                    {
+                        for(int n = 0; n < numInBands; n++)
+                        {
+                            inDataColumn[n] = inputData[n][rowOff + j];
+                        }
+                        
+                        this->calc->calcImageValue(inDataColumn.data(), numInBands, outDataColumn.data());
+                        
+                        for(int n = 0; n < this->numOutBands; n++)
+                        {
+                            outputData[n][rowOff + j] = outDataColumn[n];
+                        }
+                    }
+                }
+            }
+        };
+        if(this->threadPool != NULL)
+        {
+            this->threadPool->parallelFor(0, nRows, calcRows, std::max<unsigned long>(1024 / std::max(width, 1), 1));
+        }
+        else
+        {
+            calcRows(0, nRows);
+        }
+        
+        unsigned long numSkipped = 0;
+        for(int t = 0; t < nXTiles; ++t)
+        {
+            if(tileEmpty[t])
+            {
+                ++numSkipped;
+            }
+        }
+        return numSkipped;
+    }
+    
+    void RSGISCalcImage::setNumThreads(unsigned int numThreads)
+    {
+        if(this->threadPool != NULL)
+        {
+            delete this->threadPool;
+            this->threadPool = NULL;
+        }
+        if(rsgis::RSGISThreadPool::findNumThreads(numThreads) > 1)
+        {
+            this->threadPool = new rsgis::RSGISThreadPool(numThreads);
+        }
+    }
+
+    void RSGISCalcImage::calcBlockPxls(float **inputData, int numInBands, double **outputData, double *outputRefData, size_t nPxls)
+    {
+        this->threadPool->parallelFor(0, nPxls, [&](unsigned long start, unsigned long end)
+        {
+            std::vector<float> inDataColumn(numInBands);
+            std::vector<double> outDataColumn(this->numOutBands);
+            double outRefData = 0;
+            for(unsigned long p = start; p < end; ++p)
+            {
+                for(int n = 0; n < numInBands; n++)
+                {
+                    inDataColumn[n] = inputData[n][p];
+                }
+
+                if(outputRefData != NULL)
+                {
+                    this->calc->calcImageValue(inDataColumn.data(), numInBands, outDataColumn.data(), &outRefData, 1);
+                    outputRefData[p] = outRefData;
+                }
+                else
+                {
+                    this->calc->calcImageValue(inDataColumn.data(), numInBands, outDataColumn.data());
+                }
+
+                for(int n = 0; n < this->numOutBands; n++)
+                {
+                    outputData[n][p] = outDataColumn[n];
+                }
+            }
+        }, 1024);
+    }
+
 	RSGISCalcImage::~RSGISCalcImage()
 	{
-		
+		if(this->threadPool != NULL)
+        {
+            delete this->threadPool;
+        }
 	}
     
     
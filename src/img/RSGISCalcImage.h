@@ -25,10 +25,14 @@
 
 #include <iostream>
 #include <string>
+#include <cmath>
+#include <algorithm>
+#include <vector>
 
 #include "gdal_priv.h"
 
 #include "common/rsgis-tqdm.h"
+#include "common/RSGISThreadPool.h"
 
 #include "img/RSGISPixelInPoly.h"
 #include "img/RSGISImageCalcException.h"
@@ -87,12 +91,39 @@ namespace rsgis
                 void calcImageWithinPolygonExtentInMem(GDALDataset **datasets, int numDS, OGREnvelope *env, OGRPolygon *poly, pixelInPolyOption pixelPolyOption);
 				void calcImageWithinRasterPolygon(GDALDataset **datasets, int numDS, OGREnvelope *env, long fid);
                 void calcImageBorderPixels(GDALDataset *dataset, bool returnInt);
+                /**
+                 * If enabled, blocks (each image block within a row of blocks) where every input band
+                 * is no data (using the band no data value if useImgNoData and it is defined, otherwise
+                 * inNoDataVal) are not passed to the calculator and the output is filled with outNoDataVal.
+                 * Where the driver reports (GetDataCoverageStatus) that all the blocks of a row are empty
+                 * for all the input bands the row is not read. Only used by calcImage(datasets, numDS,
+                 * outputImage, ...).
+                 */
+                void setSkipNoDataBlocks(bool skipNoDataBlocks, float inNoDataVal=0.0, double outNoDataVal=0.0, bool useImgNoData=true);
+                /**
+                 * Sets the number of threads (0 for the number of cores) over which the pixels of
+                 * each block are calculated, with the image I/O on the calling thread. Only used by
+                 * calcImage(datasets, numDS, outputImage, ...) and calcImage(datasets, numDS,
+                 * outputImage, outputRefIntImage, ...) and the calculator must be safe to call from
+                 * several threads at once (i.e., calcImageValue does not modify the calculator).
+                 */
+                void setNumThreads(unsigned int numThreads);
                 virtual ~RSGISCalcImage();
 			private:
+                void getBandsNoDataVals(GDALRasterBand **bands, int numBands, float *noDataVals);
+                bool blockCoverageEmpty(GDALRasterBand **bands, int **bandOffsets, int numBands, float *noDataVals, int xOff, int width, int blockRowOffset, int nRows);
+                bool blockAllNoData(float **data, int numBands, float *noDataVals, int rowWidth, int xOff, int width, int nRows);
+                unsigned long calcBlockRowSkipNoData(GDALRasterBand **bands, int **bandOffsets, int numInBands, float *noDataVals, float **inputData, double **outputData, int width, int xTileSize, int blockRowOffset, int nRows);
+                void calcBlockPxls(float **inputData, int numInBands, double **outputData, double *outputRefData, size_t nPxls);
 				RSGISCalcImageValue *calc;
 				int numOutBands;
 				std::string proj;
 				bool useImageProj;
+                bool skipNoDataBlocks;
+                float inNoDataVal;
+                double outNoDataVal;
+                bool useImgNoData;
+                rsgis::RSGISThreadPool *threadPool;
 			};
         
         
@@ -129,4 +129,165 @@ namespace rsgis{namespace img{
         delete[] this->first;
     }
     
+    
+    RSGISFindLocalMinInWin::RSGISFindLocalMinInWin(std::vector<unsigned int> bands, float noDataValue, bool useNoDataValue)
+    {
+        this->bands = bands;
+        this->noDataValue = noDataValue;
+        this->useNoDataValue = useNoDataValue;
+    }
+    
+    void RSGISFindLocalMinInWin::findLocalMin(GDALDataset *dataset, std::string outputImg, std::string outputRefImg, unsigned int winSize, std::string gdalFormat, GDALDataType gdalDataType)
+    {
+        if((winSize < 3) || ((winSize % 2) == 0))
+        {
+            throw RSGISImageCalcException("Window size needs to be 3 or greater and an odd number.");
+        }
+        unsigned int numBands = dataset->GetRasterCount();
+        for(std::vector<unsigned int>::iterator iterBands = this->bands.begin(); iterBands != this->bands.end(); ++iterBands)
+        {
+            if(((*iterBands) == 0) || ((*iterBands) > numBands))
+            {
+                throw RSGISImageCalcException("A band specified is not within the input image.");
+            }
+        }
+        
+        unsigned int width = dataset->GetRasterXSize();
+        unsigned int height = dataset->GetRasterYSize();
+        unsigned int winMid = (winSize-1)/2;
+        const float maxVal = std::numeric_limits<float>::infinity();
+        
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        dataset->GetRasterBand(1)->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        // Process the image in strips (with a margin for the window) of whole blocks, at least 256 lines at a time.
+        unsigned int nRowsPerStrip = yBlockSize;
+        while(nRowsPerStrip < 256)
+        {
+            nRowsPerStrip += yBlockSize;
+        }
+        if(nRowsPerStrip > height)
+        {
+            nRowsPerStrip = height;
+        }
+        size_t nMaxPxls = ((size_t)width) * (nRowsPerStrip + (2*winMid));
+        
+        RSGISImageUtils imgUtils;
+        GDALDataset *outDataset = NULL;
+        GDALDataset *outRefDataset = NULL;
+        try
+        {
+            outDataset = imgUtils.createCopy(dataset, 1, outputImg, gdalFormat, gdalDataType);
+            outRefDataset = imgUtils.createCopy(dataset, 1, outputRefImg, gdalFormat, GDT_UInt32);
+            
+            RSGISWindowMinFilter minFilter(winSize, false);
+            // As RSGISCalcLocalMinInWin, the image is padded with zeros (which are ignored if zero is no data).
+            float outsideVal = (this->useNoDataValue && (this->noDataValue == 0))?maxVal:0.0;
+            std::vector<float> bandVals(nMaxPxls);
+            std::vector<float> winMinVals(nMaxPxls);
+            std::vector<unsigned char> midNoData(nMaxPxls);
+            std::vector<double> outVals(((size_t)width) * nRowsPerStrip);
+            std::vector<unsigned int> outRefVals(((size_t)width) * nRowsPerStrip);
+            
+            rsgis_tqdm pbar;
+            for(unsigned int yStart = 0; yStart < height; yStart += nRowsPerStrip)
+            {
+                pbar.progress(yStart, height);
+                unsigned int yEnd = std::min(yStart + nRowsPerStrip, height);
+                unsigned int readStart = (yStart > winMid)?(yStart - winMid):0;
+                unsigned int readEnd = std::min(yEnd + winMid, height);
+                unsigned int nReadRows = readEnd - readStart;
+                size_t nReadPxls = ((size_t)width) * nReadRows;
+                size_t rowOff = ((size_t)(yStart - readStart)) * width;
+                size_t nStripPxls = ((size_t)(yEnd - yStart)) * width;
+                
+                std::fill(outVals.begin(), outVals.begin()+nStripPxls, 0.0);
+                std::fill(outRefVals.begin(), outRefVals.begin()+nStripPxls, 0);
+                
+                // The pixel is not analysed if it is no data in all the image bands.
+                std::fill(midNoData.begin(), midNoData.begin()+nStripPxls, 1);
+                if(this->useNoDataValue)
+                {
+                    for(unsigned int n = 0; n < numBands; ++n)
+                    {
+                        if(dataset->GetRasterBand(n+1)->RasterIO(GF_Read, 0, yStart, width, (yEnd - yStart), bandVals.data(), width, (yEnd - yStart), GDT_Float32, 0, 0) != CE_None)
+                        {
+                            throw RSGISImageCalcException("Could not read image data.");
+                        }
+                        for(size_t i = 0; i < nStripPxls; ++i)
+                        {
+                            if(bandVals[i] != this->noDataValue)
+                            {
+                                midNoData[i] = 0;
+                            }
+                        }
+                    }
+                }
+                
+                for(std::vector<unsigned int>::iterator iterBands = this->bands.begin(); iterBands != this->bands.end(); ++iterBands)
+                {
+                    if(dataset->GetRasterBand(*iterBands)->RasterIO(GF_Read, 0, readStart, width, nReadRows, bandVals.data(), width, nReadRows, GDT_Float32, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageCalcException("Could not read image data.");
+                    }
+                    for(size_t i = 0; i < nReadPxls; ++i)
+                    {
+                        if(std::isnan(bandVals[i]) || (this->useNoDataValue && (bandVals[i] == this->noDataValue)))
+                        {
+                            bandVals[i] = maxVal;
+                        }
+                    }
+                    minFilter.filter(bandVals.data(), winMinVals.data(), width, nReadRows, outsideVal);
+                    
+                    for(size_t i = 0; i < nStripPxls; ++i)
+                    {
+                        float winMin = winMinVals[rowOff+i];
+                        if((this->useNoDataValue && midNoData[i]) || (winMin == maxVal))
+                        {
+                            continue;
+                        }
+                        if((outRefVals[i] == 0) || (winMin < outVals[i]))
+                        {
+                            outVals[i] = winMin;
+                            outRefVals[i] = *iterBands;
+                        }
+                    }
+                }
+                
+                if(outDataset->GetRasterBand(1)->RasterIO(GF_Write, 0, yStart, width, (yEnd - yStart), outVals.data(), width, (yEnd - yStart), GDT_Float64, 0, 0) != CE_None)
+                {
+                    throw RSGISImageCalcException("Could not write output image data.");
+                }
+                if(outRefDataset->GetRasterBand(1)->RasterIO(GF_Write, 0, yStart, width, (yEnd - yStart), outRefVals.data(), width, (yEnd - yStart), GDT_UInt32, 0, 0) != CE_None)
+                {
+                    throw RSGISImageCalcException("Could not write output image data.");
+                }
+            }
+            pbar.finish();
+        }
+        catch(RSGISImageException &e)
+        {
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            if(outRefDataset != NULL)
+            {
+                GDALClose(outRefDataset);
+            }
+            throw RSGISImageCalcException(e.what());
+        }
+        GDALClose(outDataset);
+        GDALClose(outRefDataset);
+    }
+    
+    RSGISFindLocalMinInWin::~RSGISFindLocalMinInWin()
+    {
+        
+    }
+    
 }}
@@ -26,9 +26,17 @@
 #include <iostream>
 #include <cmath>
 #include <stdlib.h>
+#include <vector>
+#include <limits>
+
+#include "gdal_priv.h"
+
+#include "common/rsgis-tqdm.h"
 
 #include "img/RSGISImageCalcException.h"
 #include "img/RSGISCalcImageValue.h"
+#include "img/RSGISImageUtils.h"
+#include "img/RSGISWindowMinFilter.h"
 
 
 // mark all exported classes/functions with DllExport to have
@@ -59,6 +67,24 @@ namespace rsgis{namespace img{
             double *minVals;
             bool *first;
         };
+        
+        /**
+         * Finds the minimum value within a square window across the selected bands
+         * and the band it came from, as RSGISCalcLocalMinInWin, using RSGISWindowMinFilter
+         * so the cost does not depend on the window size. No data and NaN values are
+         * ignored and, as RSGISCalcLocalMinInWin, the image is padded with zeros.
+         */
+        class DllExport RSGISFindLocalMinInWin
+        {
+        public:
+            RSGISFindLocalMinInWin(std::vector<unsigned int> bands, float noDataValue, bool useNoDataValue);
+            void findLocalMin(GDALDataset *dataset, std::string outputImg, std::string outputRefImg, unsigned int winSize, std::string gdalFormat, GDALDataType gdalDataType);
+            ~RSGISFindLocalMinInWin();
+        protected:
+            std::vector<unsigned int> bands;
+            float noDataValue;
+            bool useNoDataValue;
+        };
     
 }}
 
@@ -66,6 +66,29 @@ namespace rsgis{namespace img{
 			outputMatrix->n = numInBandsDSB;
 			outputMatrix->matrix = new double[(outputMatrix->m * outputMatrix->n)];
 			
+			if(calcImageSingleValue->usesPairMoments())
+			{
+				// All the band pairs are reduced within a single pass over the images.
+				std::vector<std::pair<int, int> > bandPairs;
+				for(int i = 0; i < numInBandsDSA; i++)
+				{
+					for(int j = 0; j < numInBandsDSB; j++)
+					{
+						bandPairs.push_back(std::pair<int, int>(i, j));
+					}
+				}
+				std::vector<RSGISImagePairMoments> moments;
+				this->calcImage->calcImagePairMoments(datasetsA, datasetsB, numDS, bandPairs, &moments);
+				for(size_t p = 0; p < bandPairs.size(); ++p)
+				{
+					calcImageSingleValue->reset();
+					calcImageSingleValue->setPairMoments(moments[p], bandPairs[p].first, bandPairs[p].second);
+					outputMatrix->matrix[p] = calcImageSingleValue->getOutputValues()[0];
+				}
+				delete[] outputValue;
+				return outputMatrix;
+			}
+			
 			int counter = 0;
 			//matrix = new double*[numInBandsDSA];
 			for(int i = 0; i < numInBandsDSA; i++)
@@ -24,13 +24,29 @@
 
 namespace rsgis{namespace img{
 	
-	RSGISCalcImageSingle::RSGISCalcImageSingle(RSGISCalcImageSingleValue *valueCalc)
+	RSGISCalcImageSingle::RSGISCalcImageSingle(RSGISCalcImageSingleValue *valueCalc, unsigned int numThreads)
 	{
 		this->valueCalc = valueCalc;
+		this->numThreads = numThreads;
 	}
 	
 	void RSGISCalcImageSingle::calcImage(GDALDataset **datasetsA, GDALDataset **datasetsB, int numDS, double *outputValue, int bandA, int bandB)
 	{
+		if(this->valueCalc->usesPairMoments())
+		{
+			std::vector<std::pair<int, int> > bandPairs;
+			bandPairs.push_back(std::pair<int, int>(bandA, bandB));
+			std::vector<RSGISImagePairMoments> moments;
+			this->calcImagePairMoments(datasetsA, datasetsB, numDS, bandPairs, &moments);
+			this->valueCalc->setPairMoments(moments[0], bandA, bandB);
+			double *tempOutVal = this->valueCalc->getOutputValues();
+			for(int i = 0; i < this->valueCalc->getNumberOfOutValues(); i++)
+			{
+				outputValue[i] = tempOutVal[i];
+			}
+			return;
+		}
+		
 		GDALAllRegister();
 		RSGISImageUtils imgUtils;
 		double *gdalTranslation = NULL;
@@ -249,6 +265,174 @@ namespace rsgis{namespace img{
 		}
 	}
 	
+	void RSGISCalcImageSingle::calcImagePairMoments(GDALDataset **datasetsA, GDALDataset **datasetsB, int numDS, const std::vector<std::pair<int, int> > &bandPairs, std::vector<RSGISImagePairMoments> *moments)
+	{
+		// The number of pixels reduced by each task; fixed so the order of the merges does not depend on the number of threads.
+		const size_t nPxlsPerTask = 65536;
+		
+		RSGISImageUtils imgUtils;
+		int totalNumDS = numDS + numDS;
+		std::vector<GDALDataset*> datasets;
+		for(int i = 0; i < numDS; i++)
+		{
+			datasets.push_back(datasetsA[i]);
+		}
+		for(int i = 0; i < numDS; i++)
+		{
+			datasets.push_back(datasetsB[i]);
+		}
+		
+		int **dsOffsets = new int*[totalNumDS];
+		for(int i = 0; i < totalNumDS; i++)
+		{
+			dsOffsets[i] = new int[2];
+		}
+		int width = 0;
+		int height = 0;
+		int maxBlockX = 0;
+		int maxBlockY = 0;
+		double gdalTranslation[6];
+		
+		// The bands (with their offsets into the overlap) of the two image sets.
+		std::vector<GDALRasterBand*> bandsA;
+		std::vector<GDALRasterBand*> bandsB;
+		std::vector<std::pair<int, int> > offsetsA;
+		std::vector<std::pair<int, int> > offsetsB;
+		try
+		{
+			imgUtils.getImageOverlap(datasets.data(), totalNumDS, dsOffsets, &width, &height, gdalTranslation, &maxBlockX, &maxBlockY);
+			for(int i = 0; i < numDS; i++)
+			{
+				for(int j = 0; j < datasetsA[i]->GetRasterCount(); j++)
+				{
+					bandsA.push_back(datasetsA[i]->GetRasterBand(j+1));
+					offsetsA.push_back(std::pair<int, int>(dsOffsets[i][0], dsOffsets[i][1]));
+				}
+				for(int j = 0; j < datasetsB[i]->GetRasterCount(); j++)
+				{
+					bandsB.push_back(datasetsB[i]->GetRasterBand(j+1));
+					offsetsB.push_back(std::pair<int, int>(dsOffsets[i+numDS][0], dsOffsets[i+numDS][1]));
+				}
+			}
+		}
+		catch(RSGISImageBandException &e)
+		{
+			for(int i = 0; i < totalNumDS; i++)
+			{
+				delete[] dsOffsets[i];
+			}
+			delete[] dsOffsets;
+			throw;
+		}
+		for(int i = 0; i < totalNumDS; i++)
+		{
+			delete[] dsOffsets[i];
+		}
+		delete[] dsOffsets;
+		
+		// Each band is only read once, however many pairs it is within.
+		std::map<int, size_t> bufIdxsA;
+		std::map<int, size_t> bufIdxsB;
+		for(std::vector<std::pair<int, int> >::const_iterator iterPair = bandPairs.begin(); iterPair != bandPairs.end(); ++iterPair)
+		{
+			if((iterPair->first < 0) || (iterPair->first >= (int)bandsA.size()))
+			{
+				throw RSGISImageCalcException("The band A specificed is larger than the number of available bands.");
+			}
+			if((iterPair->second < 0) || (iterPair->second >= (int)bandsB.size()))
+			{
+				throw RSGISImageCalcException("The band B specificed is larger than the number of available bands.");
+			}
+			if(bufIdxsA.count(iterPair->first) == 0)
+			{
+				size_t idx = bufIdxsA.size();
+				bufIdxsA[iterPair->first] = idx;
+			}
+			if(bufIdxsB.count(iterPair->second) == 0)
+			{
+				size_t idx = bufIdxsB.size();
+				bufIdxsB[iterPair->second] = idx;
+			}
+		}
+		
+		if(maxBlockY < 1)
+		{
+			maxBlockY = 1;
+		}
+		int nRowsPerRead = maxBlockY;
+		while(nRowsPerRead < 256)
+		{
+			nRowsPerRead += maxBlockY;
+		}
+		if(nRowsPerRead > height)
+		{
+			nRowsPerRead = height;
+		}
+		size_t nStripPxls = ((size_t)width) * ((size_t)nRowsPerRead);
+		std::vector<std::vector<float> > dataA(bufIdxsA.size(), std::vector<float>(nStripPxls));
+		std::vector<std::vector<float> > dataB(bufIdxsB.size(), std::vector<float>(nStripPxls));
+		
+		size_t numPairs = bandPairs.size();
+		std::vector<size_t> pairBufA;
+		std::vector<size_t> pairBufB;
+		for(size_t p = 0; p < numPairs; ++p)
+		{
+			pairBufA.push_back(bufIdxsA[bandPairs[p].first]);
+			pairBufB.push_back(bufIdxsB[bandPairs[p].second]);
+		}
+		moments->assign(numPairs, RSGISImagePairMoments());
+		std::vector<RSGISImagePairMoments> taskMoments;
+		
+		RSGISThreadPool threadPool(this->numThreads);
+		int nReads = (nRowsPerRead > 0)?((height + nRowsPerRead - 1) / nRowsPerRead):0;
+		rsgis_tqdm pbar;
+		for(int n = 0; n < nReads; ++n)
+		{
+			pbar.progress(n, nReads);
+			int yOff = n * nRowsPerRead;
+			int nRows = std::min(nRowsPerRead, height - yOff);
+			size_t nPxls = ((size_t)width) * ((size_t)nRows);
+			
+			for(std::map<int, size_t>::iterator iterBand = bufIdxsA.begin(); iterBand != bufIdxsA.end(); ++iterBand)
+			{
+				if(bandsA[iterBand->first]->RasterIO(GF_Read, offsetsA[iterBand->first].first, offsetsA[iterBand->first].second+yOff, width, nRows, dataA[iterBand->second].data(), width, nRows, GDT_Float32, 0, 0) != CE_None)
+				{
+					throw RSGISImageCalcException("Could not read image data.");
+				}
+			}
+			for(std::map<int, size_t>::iterator iterBand = bufIdxsB.begin(); iterBand != bufIdxsB.end(); ++iterBand)
+			{
+				if(bandsB[iterBand->first]->RasterIO(GF_Read, offsetsB[iterBand->first].first, offsetsB[iterBand->first].second+yOff, width, nRows, dataB[iterBand->second].data(), width, nRows, GDT_Float32, 0, 0) != CE_None)
+				{
+					throw RSGISImageCalcException("Could not read image data.");
+				}
+			}
+			
+			size_t nTasks = (nPxls + nPxlsPerTask - 1) / nPxlsPerTask;
+			taskMoments.assign(nTasks * numPairs, RSGISImagePairMoments());
+			threadPool.parallelFor(0, nTasks, [&](unsigned long startTask, unsigned long endTask)
+			{
+				for(unsigned long t = startTask; t < endTask; ++t)
+				{
+					size_t startIdx = t * nPxlsPerTask;
+					size_t numVals = std::min(nPxlsPerTask, nPxls - startIdx);
+					for(size_t p = 0; p < numPairs; ++p)
+					{
+						taskMoments[(t*numPairs)+p].addValues(dataA[pairBufA[p]].data()+startIdx, dataB[pairBufB[p]].data()+startIdx, numVals);
+					}
+				}
+			});
+			for(size_t t = 0; t < nTasks; ++t)
+			{
+				for(size_t p = 0; p < numPairs; ++p)
+				{
+					(*moments)[p].merge(taskMoments[(t*numPairs)+p]);
+				}
+			}
+		}
+		pbar.finish();
+	}
+	
 	void RSGISCalcImageSingle::calcImage(GDALDataset **datasetsA, int numDS, double *outputValue, int band)
 	{
 		GDALAllRegister();
@@ -25,10 +25,13 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <map>
 
 #include "gdal_priv.h"
 
 #include "common/rsgis-tqdm.h"
+#include "common/RSGISThreadPool.h"
 
 #include "img/RSGISImageCalcException.h"
 #include "img/RSGISCalcImageSingleValue.h"
@@ -53,8 +56,16 @@ namespace rsgis{namespace img{
 	class DllExport RSGISCalcImageSingle
 		{
 		public:
-			RSGISCalcImageSingle(RSGISCalcImageSingleValue *valueCalc);
+			/** numThreads is used for the image pair reductions, 0 uses all the available cores. */
+			RSGISCalcImageSingle(RSGISCalcImageSingleValue *valueCalc, unsigned int numThreads=0);
 			void calcImage(GDALDataset **datasetsA, GDALDataset **datasetsB, int numDS, double *outputValue, int bandA, int bandB);
+			/**
+			 * Calculates the moments for each pair of band indexes (into the bands of datasetsA and
+			 * datasetsB) over the overlap of the images in a single pass. The images are read in
+			 * strips and each strip reduced in parallel with the blocks merged in order, so the
+			 * result does not depend on the number of threads.
+			 */
+			void calcImagePairMoments(GDALDataset **datasetsA, GDALDataset **datasetsB, int numDS, const std::vector<std::pair<int, int> > &bandPairs, std::vector<RSGISImagePairMoments> *moments);
 			void calcImage(GDALDataset **datasetsA, int numDS, double *outputValue, int band);
 			void calcImageWindow(GDALDataset **datasetsA, int numDS, double *outputValue);
 			void calcImageWithinPolygon(GDALDataset **datasets, int numDS, double *outputValue, OGREnvelope *env, OGRPolygon *poly, bool output, pixelInPolyOption pixelPolyOption);
@@ -63,6 +74,7 @@ namespace rsgis{namespace img{
 			virtual ~RSGISCalcImageSingle();
 		protected:
 			RSGISCalcImageSingleValue *valueCalc;
+			unsigned int numThreads;
 		};
 }}
 #endif
@@ -40,4 +40,122 @@ namespace rsgis{namespace img{
 	{
 		delete[] this->outputValues;
 	}
+	
+	
+	RSGISImagePairMoments::RSGISImagePairMoments()
+	{
+		this->reset();
+	}
+	
+	void RSGISImagePairMoments::addValues(const float *valsA, const float *valsB, size_t numVals)
+	{
+		if(numVals == 0)
+		{
+			return;
+		}
+		double sumA = 0.0;
+		double sumB = 0.0;
+		for(size_t i = 0; i < numVals; ++i)
+		{
+			sumA += valsA[i];
+			sumB += valsB[i];
+		}
+		
+		RSGISImagePairMoments blockMoments;
+		blockMoments.n = numVals;
+		blockMoments.meanA = sumA / numVals;
+		blockMoments.meanB = sumB / numVals;
+		double m2A = 0.0;
+		double m2B = 0.0;
+		double cAB = 0.0;
+		double sumSqDiff = 0.0;
+		for(size_t i = 0; i < numVals; ++i)
+		{
+			double diffA = valsA[i] - blockMoments.meanA;
+			double diffB = valsB[i] - blockMoments.meanB;
+			double diffAB = ((double)valsA[i]) - ((double)valsB[i]);
+			m2A += diffA * diffA;
+			m2B += diffB * diffB;
+			cAB += diffA * diffB;
+			sumSqDiff += diffAB * diffAB;
+		}
+		blockMoments.m2A = m2A;
+		blockMoments.m2B = m2B;
+		blockMoments.cAB = cAB;
+		blockMoments.sumSqDiff = sumSqDiff;
+		this->merge(blockMoments);
+	}
+	
+	void RSGISImagePairMoments::merge(const RSGISImagePairMoments &moments)
+	{
+		if(moments.n == 0)
+		{
+			return;
+		}
+		if(this->n == 0)
+		{
+			*this = moments;
+			return;
+		}
+		double nA = this->n;
+		double nB = moments.n;
+		double nTotal = nA + nB;
+		double deltaA = moments.meanA - this->meanA;
+		double deltaB = moments.meanB - this->meanB;
+		double factor = (nA * nB) / nTotal;
+		this->meanA += deltaA * (nB / nTotal);
+		this->meanB += deltaB * (nB / nTotal);
+		this->m2A += moments.m2A + (deltaA * deltaA * factor);
+		this->m2B += moments.m2B + (deltaB * deltaB * factor);
+		this->cAB += moments.cAB + (deltaA * deltaB * factor);
+		this->n += moments.n;
+		
+		double val = (moments.sumSqDiff - moments.sumSqDiffComp) - this->sumSqDiffComp;
+		double total = this->sumSqDiff + val;
+		this->sumSqDiffComp = (total - this->sumSqDiff) - val;
+		this->sumSqDiff = total;
+	}
+	
+	void RSGISImagePairMoments::reset()
+	{
+		this->n = 0;
+		this->meanA = 0.0;
+		this->meanB = 0.0;
+		this->m2A = 0.0;
+		this->m2B = 0.0;
+		this->cAB = 0.0;
+		this->sumSqDiff = 0.0;
+		this->sumSqDiffComp = 0.0;
+	}
+	
+	double RSGISImagePairMoments::getVarianceA() const
+	{
+		return this->m2A / (((double)this->n) - 1.0);
+	}
+	
+	double RSGISImagePairMoments::getVarianceB() const
+	{
+		return this->m2B / (((double)this->n) - 1.0);
+	}
+	
+	double RSGISImagePairMoments::getCovariance() const
+	{
+		return this->cAB / (((double)this->n) - 1.0);
+	}
+	
+	double RSGISImagePairMoments::getCovariance(double aMean, double bMean) const
+	{
+		double sum = this->cAB + (((double)this->n) * (this->meanA - aMean) * (this->meanB - bMean));
+		return sum / (((double)this->n) - 1.0);
+	}
+	
+	double RSGISImagePairMoments::getCorrelation() const
+	{
+		return this->cAB / sqrt(this->m2A * this->m2B);
+	}
+	
+	double RSGISImagePairMoments::getRMSE() const
+	{
+		return sqrt((this->sumSqDiff - this->sumSqDiffComp) / ((double)this->n));
+	}
 }}
@@ -44,6 +44,44 @@
 
 namespace rsgis{namespace img{
 	
+	/**
+	 * The count, means, sums of squared deviations and co-moment of a pair of
+	 * bands, with the sum of squared differences, from which the RMSE,
+	 * covariance and correlation can all be derived. Blocks of values are
+	 * added using two passes over the block (mean then deviations) and the
+	 * blocks merged using the pairwise update of Chan et al., so the result
+	 * does not suffer from the cancellation of the sum of squares formulae.
+	 */
+	class DllExport RSGISImagePairMoments
+		{
+		public:
+			RSGISImagePairMoments();
+			void addValues(const float *valsA, const float *valsB, size_t numVals);
+			void merge(const RSGISImagePairMoments &moments);
+			void reset();
+			unsigned long getN() const {return this->n;};
+			double getMeanA() const {return this->meanA;};
+			double getMeanB() const {return this->meanB;};
+			double getVarianceA() const;
+			double getVarianceB() const;
+			/** Sample covariance, about the means of the values. */
+			double getCovariance() const;
+			/** Sample covariance about the means provided. */
+			double getCovariance(double aMean, double bMean) const;
+			double getCorrelation() const;
+			double getRMSE() const;
+		protected:
+			unsigned long n;
+			double meanA;
+			double meanB;
+			double m2A;
+			double m2B;
+			double cAB;
+			// Kahan summation of the squared differences.
+			double sumSqDiff;
+			double sumSqDiffComp;
+		};
+	
 	class DllExport RSGISCalcImageSingleValue
 		{
 		public:
@@ -55,6 +93,9 @@ namespace rsgis{namespace img{
 			int getNumberOfOutValues();
 			virtual double* getOutputValues() {throw RSGISImageCalcException("Not Implemented - RSGISCalcImageSingleValue Base Class");};
 			virtual void reset() {throw RSGISImageCalcException("Not Implemented - RSGISCalcImageSingleValue Base Class");};
+			/** If true the output values can be calculated from RSGISImagePairMoments, allowing the image pair to be processed in parallel. */
+			virtual bool usesPairMoments() {return false;};
+			virtual void setPairMoments(const RSGISImagePairMoments &moments, int bandA, int bandB) {throw RSGISImageCalcException("Not Implemented - RSGISCalcImageSingleValue Base Class");};
 			virtual ~RSGISCalcImageSingleValue();
 		protected:
 			int numOutputValues;
@@ -31,6 +31,8 @@ namespace rsgis{namespace img{
 		this->sumSqDiff = 0;
 		this->rmseReturn = new double[1];
 		this->numVal = 0;
+		this->havePairMoments = false;
+		this->pairMomentsRMSE = 0;
 	}
 	
 	void RSGISCalcRMSE::calcImageValue(float *bandValuesImageA, float *bandValuesImageB, int numBands, int bandA, int bandB) 
@@ -39,8 +41,19 @@ namespace rsgis{namespace img{
 		this->numVal++;
 	}
 	
+	void RSGISCalcRMSE::setPairMoments(const RSGISImagePairMoments &moments, int bandA, int bandB)
+	{
+		this->pairMomentsRMSE = moments.getRMSE();
+		this->havePairMoments = true;
+	}
+	
 	double* RSGISCalcRMSE::getOutputValues() 
 	{
+		if(this->havePairMoments)
+		{
+			rmseReturn[0] = this->pairMomentsRMSE;
+			return rmseReturn;
+		}
 		rmseReturn[0] = sqrt(sumSqDiff / numVal);
 		return rmseReturn;
 	}
@@ -50,6 +63,7 @@ namespace rsgis{namespace img{
 		this->sumSqDiff = 0;
 		this->rmseReturn[0] = 0;
 		this->numVal = 0;
+		this->havePairMoments = false;
 	}
 	
 	RSGISCalcRMSE::~RSGISCalcRMSE()
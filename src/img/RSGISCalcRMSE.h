@@ -53,9 +53,13 @@ namespace rsgis{namespace img{
 		void calcImageValue(float *bandValuesImageA, float *bandValuesImageB, int numBands, int bandA, int bandB);
 		double* getOutputValues();
 		void reset();
+		bool usesPairMoments() {return true;};
+		void setPairMoments(const RSGISImagePairMoments &moments, int bandA, int bandB);
 		~RSGISCalcRMSE();
 	protected:
 		double *rmseReturn;
+		bool havePairMoments;
+		double pairMomentsRMSE;
 		long double sumSqDiff;
 		long int numVal;
 		int numOutputValues;
@@ -0,0 +1,556 @@
+/*
+ *  RSGISCreateImagesForFeatures.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISCreateImagesForFeatures.h"
+
+namespace rsgis{namespace img{
+
+    RSGISCreateImagesForFeatures::RSGISCreateImagesForFeatures(unsigned int numThreads, unsigned int stripHeight)
+    {
+        this->numThreads = numThreads;
+        this->stripHeight = std::max<unsigned int>(stripHeight, 1);
+        this->serialiseWrites = false;
+        for(int i = 0; i < 6; ++i)
+        {
+            this->gridTransform[i] = 0.0;
+        }
+    }
+
+    std::vector<std::string> RSGISCreateImagesForFeatures::createFeatureImages(OGRLayer *vecLayer, std::string filenameAttribute, std::string outputImageBase, std::string outFileExtension, double *gridTransform, long gridXSize, long gridYSize, bool snapToGrid, std::string projWKT, bool rasterise, double fgVal, double bgVal, unsigned int numBands, std::string gdalFormat, GDALDataType outDataType, bool thematic)
+    {
+        std::vector<std::string> outFiles;
+        std::vector<RSGISFeatureImage*> featImgs;
+        RSGISThreadPool *writePool = NULL;
+        char **papszOptions = NULL;
+        try
+        {
+            for(int i = 0; i < 6; ++i)
+            {
+                this->gridTransform[i] = gridTransform[i];
+            }
+            if((this->gridTransform[2] != 0) || (this->gridTransform[4] != 0))
+            {
+                throw RSGISImageException("The reference grid is rotated, this is not supported.");
+            }
+            if((this->gridTransform[1] == 0) || (this->gridTransform[5] == 0))
+            {
+                throw RSGISImageException("The resolution of the reference grid cannot be zero.");
+            }
+            if(numBands == 0)
+            {
+                throw RSGISImageException("The output images must have at least one band.");
+            }
+            // HDF5 based formats cannot be written from more than one thread at a time.
+            this->serialiseWrites = (gdalFormat == "KEA") || (gdalFormat == "HDF5") || (gdalFormat == "netCDF");
+
+            int fieldIdx = -1;
+            if(filenameAttribute != "")
+            {
+                fieldIdx = vecLayer->GetLayerDefn()->GetFieldIndex(filenameAttribute.c_str());
+                if(fieldIdx < 0)
+                {
+                    throw RSGISImageException("Could not find the field '" + filenameAttribute + "' within the vector layer.");
+                }
+            }
+            if(projWKT == "")
+            {
+                OGRSpatialReference *spatRef = vecLayer->GetSpatialRef();
+                if(spatRef != NULL)
+                {
+                    char *wktStr = NULL;
+                    spatRef->exportToWkt(&wktStr);
+                    projWKT = std::string(wktStr);
+                    CPLFree(wktStr);
+                }
+            }
+
+            RSGISImageUtils imgUtils;
+            papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+            unsigned int nWriteThreads = RSGISThreadPool::findNumThreads(this->numThreads);
+            // Bound the number of features waiting to be rasterised and written.
+            writePool = new RSGISThreadPool(nWriteThreads, nWriteThreads * 4);
+
+            double xRes = this->gridTransform[1];
+            double yRes = this->gridTransform[5];
+            double pxlTol = 1e-6;
+            double xPxlA, xPxlB, yPxlA, yPxlB = 0.0;
+            long xMinPxl, xMaxPxl, yMinPxl, yMaxPxl = 0;
+            OGREnvelope env;
+            long featIdx = 0;
+            long numFeats = vecLayer->GetFeatureCount(true);
+            std::map<std::string, unsigned long> nameCounts;
+            std::string featName = "";
+
+            rsgis_tqdm pbar;
+            OGRFeature *feat = NULL;
+            vecLayer->ResetReading();
+            while((feat = vecLayer->GetNextFeature()) != NULL)
+            {
+                ++featIdx;
+                if(featIdx <= numFeats)
+                {
+                    pbar.progress(featIdx, numFeats);
+                }
+                OGRGeometry *geom = feat->GetGeometryRef();
+                if((geom != NULL) && (!geom->IsEmpty()))
+                {
+                    geom->getEnvelope(&env);
+                    double tlX = this->gridTransform[0];
+                    double tlY = this->gridTransform[3];
+                    if(!snapToGrid)
+                    {
+                        // The image starts at the top-left of the envelope.
+                        tlX = (xRes > 0)?env.MinX:env.MaxX;
+                        tlY = (yRes < 0)?env.MaxY:env.MinY;
+                    }
+                    xPxlA = (env.MinX - tlX) / xRes;
+                    xPxlB = (env.MaxX - tlX) / xRes;
+                    yPxlA = (env.MaxY - tlY) / yRes;
+                    yPxlB = (env.MinY - tlY) / yRes;
+                    xMinPxl = floor(std::min(xPxlA, xPxlB) + pxlTol);
+                    xMaxPxl = ceil(std::max(xPxlA, xPxlB) - pxlTol);
+                    yMinPxl = floor(std::min(yPxlA, yPxlB) + pxlTol);
+                    yMaxPxl = ceil(std::max(yPxlA, yPxlB) - pxlTol);
+                    if(xMaxPxl <= xMinPxl)
+                    {
+                        xMaxPxl = xMinPxl + 1;
+                    }
+                    if(yMaxPxl <= yMinPxl)
+                    {
+                        yMaxPxl = yMinPxl + 1;
+                    }
+                    if(snapToGrid && (gridXSize > 0) && (gridYSize > 0))
+                    {
+                        xMinPxl = std::max(xMinPxl, 0L);
+                        yMinPxl = std::max(yMinPxl, 0L);
+                        xMaxPxl = std::min(xMaxPxl, gridXSize);
+                        yMaxPxl = std::min(yMaxPxl, gridYSize);
+                    }
+
+                    // Features outside of the grid are ignored.
+                    if((xMaxPxl > xMinPxl) && (yMaxPxl > yMinPxl))
+                    {
+                        RSGISFeatureImage *featImg = new RSGISFeatureImage();
+                        if(fieldIdx >= 0)
+                        {
+                            // Images are written in parallel so each must have a unique file name.
+                            featName = std::string(feat->GetFieldAsString(fieldIdx));
+                            unsigned long nameCount = ++nameCounts[featName];
+                            if(nameCount > 1)
+                            {
+                                std::cerr << "Warning: '" << featName << "' is used by more than one feature; a suffix has been added to the output file name.\n";
+                                featName = featName + std::string("_") + std::to_string(nameCount);
+                                while(nameCounts.count(featName) > 0)
+                                {
+                                    featName = featName + std::string("_") + std::to_string(nameCount);
+                                }
+                                nameCounts[featName] = 1;
+                            }
+                            featImg->outputImage = outputImageBase + featName + std::string(".") + outFileExtension;
+                        }
+                        else
+                        {
+                            featImg->outputImage = outputImageBase + std::to_string(featIdx) + std::string(".") + outFileExtension;
+                        }
+                        featImg->geom = NULL;
+                        if(rasterise)
+                        {
+                            featImg->geom = geom->clone();
+                        }
+                        featImg->xOff = xMinPxl;
+                        featImg->yOff = yMinPxl;
+                        featImg->xSize = xMaxPxl - xMinPxl;
+                        featImg->ySize = yMaxPxl - yMinPxl;
+                        featImg->tlX = tlX + (xMinPxl * xRes);
+                        featImg->tlY = tlY + (yMinPxl * yRes);
+                        featImg->clumpID = 0;
+                        featImg->numFgPxls = 0;
+                        featImg->data = NULL;
+                        featImgs.push_back(featImg);
+                        outFiles.push_back(featImg->outputImage);
+
+                        writePool->submit([this, featImg, rasterise, projWKT, fgVal, bgVal, numBands, gdalFormat, outDataType, papszOptions, thematic]{
+                            this->rasteriseFeature(featImg, rasterise);
+                            this->writeImage(featImg, projWKT, fgVal, bgVal, numBands, gdalFormat, outDataType, papszOptions, thematic);
+                        });
+                    }
+                }
+                OGRFeature::DestroyFeature(feat);
+            }
+            writePool->waitForAll();
+            pbar.finish();
+
+            delete writePool;
+            writePool = NULL;
+            CSLDestroy(papszOptions);
+            papszOptions = NULL;
+            this->deleteFeatureImages(&featImgs);
+        }
+        catch(std::exception &e)
+        {
+            if(writePool != NULL)
+            {
+                try
+                {
+                    writePool->waitForAll();
+                }
+                catch(std::exception &poolErr)
+                {
+                    // The original error is reported.
+                }
+                delete writePool;
+            }
+            if(papszOptions != NULL)
+            {
+                CSLDestroy(papszOptions);
+            }
+            this->deleteFeatureImages(&featImgs);
+            throw RSGISImageException(e.what());
+        }
+
+        return outFiles;
+    }
+
+    std::vector<std::string> RSGISCreateImagesForFeatures::createClumpImages(GDALDataset *clumpsDataset, unsigned int band, std::string outputImageBase, std::string outFileExtension, bool binaryOut, std::string gdalFormat, GDALDataType outDataType, bool thematic)
+    {
+        std::vector<std::string> outFiles;
+        std::vector<RSGISFeatureImage*> featImgs;
+        RSGISThreadPool *writePool = NULL;
+        char **papszOptions = NULL;
+        try
+        {
+            if((band == 0) || (band > ((unsigned int)clumpsDataset->GetRasterCount())))
+            {
+                throw RSGISImageException("The band specified is not within the clumps image.");
+            }
+            clumpsDataset->GetGeoTransform(this->gridTransform);
+            if((this->gridTransform[2] != 0) || (this->gridTransform[4] != 0))
+            {
+                throw RSGISImageException("The clumps image is rotated, this is not supported.");
+            }
+            std::string projWKT = std::string(clumpsDataset->GetProjectionRef());
+            // HDF5 based formats cannot be written from more than one thread at a time.
+            this->serialiseWrites = (gdalFormat == "KEA") || (gdalFormat == "HDF5") || (gdalFormat == "netCDF");
+
+            GDALRasterBand *clumpsBand = clumpsDataset->GetRasterBand(band);
+            long width = clumpsDataset->GetRasterXSize();
+            long height = clumpsDataset->GetRasterYSize();
+            long nStrips = (height + this->stripHeight - 1) / this->stripHeight;
+            std::vector<unsigned int> stripData(((size_t)width) * this->stripHeight);
+
+            // Find the extent of each clump (clump 0 is the background).
+            std::vector<long> minX, maxX, minY, maxY;
+            std::cout << "Finding the extent of the clumps\n";
+            rsgis_tqdm pbarExtent;
+            for(long s = 0; s < nStrips; ++s)
+            {
+                pbarExtent.progress(s, nStrips);
+                long y0 = s * this->stripHeight;
+                long nRows = std::min<long>(this->stripHeight, height - y0);
+                if(clumpsBand->RasterIO(GF_Read, 0, y0, width, nRows, stripData.data(), width, nRows, GDT_UInt32, 0, 0) != CE_None)
+                {
+                    throw RSGISImageException("Failed to read a strip from the clumps image.");
+                }
+                for(long y = 0; y < nRows; ++y)
+                {
+                    unsigned int *rowData = &stripData[((size_t)y) * width];
+                    for(long x = 0; x < width; ++x)
+                    {
+                        unsigned int clumpID = rowData[x];
+                        if(clumpID == 0)
+                        {
+                            continue;
+                        }
+                        if(clumpID >= minX.size())
+                        {
+                            minX.resize(clumpID+1, width);
+                            maxX.resize(clumpID+1, -1);
+                            minY.resize(clumpID+1, height);
+                            maxY.resize(clumpID+1, -1);
+                        }
+                        minX[clumpID] = std::min(minX[clumpID], x);
+                        maxX[clumpID] = std::max(maxX[clumpID], x);
+                        minY[clumpID] = std::min(minY[clumpID], y0 + y);
+                        maxY[clumpID] = std::max(maxY[clumpID], y0 + y);
+                    }
+                }
+            }
+            pbarExtent.finish();
+
+            // The clumps are written once the strip containing their last row has been read.
+            std::vector<RSGISFeatureImage*> clumpImgs(minX.size(), NULL);
+            std::vector< std::vector<RSGISFeatureImage*> > stripEndImgs(nStrips);
+            for(size_t clumpID = 1; clumpID < minX.size(); ++clumpID)
+            {
+                if(maxX[clumpID] < 0)
+                {
+                    continue;
+                }
+                RSGISFeatureImage *featImg = new RSGISFeatureImage();
+                featImg->outputImage = outputImageBase + "C" + std::to_string(clumpID) + std::string(".") + outFileExtension;
+                featImg->geom = NULL;
+                featImg->xOff = minX[clumpID];
+                featImg->yOff = minY[clumpID];
+                featImg->xSize = (maxX[clumpID] - minX[clumpID]) + 1;
+                featImg->ySize = (maxY[clumpID] - minY[clumpID]) + 1;
+                featImg->tlX = this->gridTransform[0] + (featImg->xOff * this->gridTransform[1]);
+                featImg->tlY = this->gridTransform[3] + (featImg->yOff * this->gridTransform[5]);
+                featImg->clumpID = clumpID;
+                featImg->numFgPxls = 0;
+                featImg->data = NULL;
+                featImgs.push_back(featImg);
+                outFiles.push_back(featImg->outputImage);
+                clumpImgs[clumpID] = featImg;
+                stripEndImgs[maxY[clumpID] / this->stripHeight].push_back(featImg);
+            }
+            std::cout << "There are " << featImgs.size() << " clumps.\n";
+
+            RSGISImageUtils imgUtils;
+            papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+            unsigned int nWriteThreads = RSGISThreadPool::findNumThreads(this->numThreads);
+            // Bound the number of completed clumps held in memory waiting to be written.
+            writePool = new RSGISThreadPool(nWriteThreads, nWriteThreads * 4);
+
+            rsgis_tqdm pbar;
+            for(long s = 0; s < nStrips; ++s)
+            {
+                pbar.progress(s, nStrips);
+                long y0 = s * this->stripHeight;
+                long nRows = std::min<long>(this->stripHeight, height - y0);
+                if(clumpsBand->RasterIO(GF_Read, 0, y0, width, nRows, stripData.data(), width, nRows, GDT_UInt32, 0, 0) != CE_None)
+                {
+                    throw RSGISImageException("Failed to read a strip from the clumps image.");
+                }
+                for(long y = 0; y < nRows; ++y)
+                {
+                    unsigned int *rowData = &stripData[((size_t)y) * width];
+                    for(long x = 0; x < width; ++x)
+                    {
+                        unsigned int clumpID = rowData[x];
+                        if(clumpID == 0)
+                        {
+                            continue;
+                        }
+                        RSGISFeatureImage *featImg = clumpImgs[clumpID];
+                        if(featImg->data == NULL)
+                        {
+                            featImg->data = (GByte *) CPLCalloc(((size_t)featImg->xSize) * featImg->ySize, 1);
+                        }
+                        featImg->data[(((size_t)((y0 + y) - featImg->yOff)) * featImg->xSize) + (x - featImg->xOff)] = 1;
+                        ++featImg->numFgPxls;
+                    }
+                }
+
+                for(std::vector<RSGISFeatureImage*>::iterator iterImg = stripEndImgs[s].begin(); iterImg != stripEndImgs[s].end(); ++iterImg)
+                {
+                    RSGISFeatureImage *featImg = *iterImg;
+                    double fgVal = binaryOut?1.0:((double)featImg->clumpID);
+                    writePool->submit([this, featImg, projWKT, fgVal, gdalFormat, outDataType, papszOptions, thematic]{ this->writeImage(featImg, projWKT, fgVal, 0.0, 1, gdalFormat, outDataType, papszOptions, thematic); });
+                }
+                std::vector<RSGISFeatureImage*>().swap(stripEndImgs[s]);
+            }
+            writePool->waitForAll();
+            pbar.finish();
+
+            delete writePool;
+            writePool = NULL;
+            CSLDestroy(papszOptions);
+            papszOptions = NULL;
+            this->deleteFeatureImages(&featImgs);
+        }
+        catch(std::exception &e)
+        {
+            if(writePool != NULL)
+            {
+                try
+                {
+                    writePool->waitForAll();
+                }
+                catch(std::exception &poolErr)
+                {
+                    // The original error is reported.
+                }
+                delete writePool;
+            }
+            if(papszOptions != NULL)
+            {
+                CSLDestroy(papszOptions);
+            }
+            this->deleteFeatureImages(&featImgs);
+            throw RSGISImageException(e.what());
+        }
+
+        return outFiles;
+    }
+
+    void RSGISCreateImagesForFeatures::rasteriseFeature(RSGISFeatureImage *featImg, bool rasterise)
+    {
+        size_t numPxls = ((size_t)featImg->xSize) * featImg->ySize;
+        if(!rasterise || (featImg->geom == NULL))
+        {
+            featImg->data = (GByte *) CPLMalloc(numPxls);
+            memset(featImg->data, 1, numPxls);
+            featImg->numFgPxls = numPxls;
+            return;
+        }
+
+        double featTransform[6];
+        featTransform[0] = featImg->tlX;
+        featTransform[1] = this->gridTransform[1];
+        featTransform[2] = 0.0;
+        featTransform[3] = featImg->tlY;
+        featTransform[4] = 0.0;
+        featTransform[5] = this->gridTransform[5];
+
+        // Pixels are within the feature if their centre is within the feature (as gdal.RasterizeLayer).
+        GDALDriver *memDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+        GDALDataset *maskDS = memDriver->Create("", featImg->xSize, featImg->ySize, 1, GDT_Byte, NULL);
+        if(maskDS == NULL)
+        {
+            throw RSGISImageException("Could not create an in memory mask for " + featImg->outputImage);
+        }
+        maskDS->SetGeoTransform(featTransform);
+        int maskBand = 1;
+        double burnVal = 1.0;
+        OGRGeometryH geomHdl = (OGRGeometryH) featImg->geom;
+        GDALRasterizeGeometries(maskDS, 1, &maskBand, 1, &geomHdl, NULL, NULL, &burnVal, NULL, NULL, NULL);
+
+        featImg->data = (GByte *) CPLMalloc(numPxls);
+        CPLErr err = maskDS->GetRasterBand(1)->RasterIO(GF_Read, 0, 0, featImg->xSize, featImg->ySize, featImg->data, featImg->xSize, featImg->ySize, GDT_Byte, 0, 0);
+        GDALClose(maskDS);
+        OGRGeometryFactory::destroyGeometry(featImg->geom);
+        featImg->geom = NULL;
+        if(err != CE_None)
+        {
+            throw RSGISImageException("Failed to rasterise the feature for " + featImg->outputImage);
+        }
+
+        featImg->numFgPxls = 0;
+        for(size_t i = 0; i < numPxls; ++i)
+        {
+            if(featImg->data[i] != 0)
+            {
+                ++featImg->numFgPxls;
+            }
+        }
+    }
+
+    void RSGISCreateImagesForFeatures::writeImage(RSGISFeatureImage *featImg, std::string projWKT, double fgVal, double bgVal, unsigned int numBands, std::string gdalFormat, GDALDataType outDataType, char **papszOptions, bool thematic)
+    {
+        int pxlBytes = GDALGetDataTypeSizeBytes(outDataType);
+        size_t numPxls = ((size_t)featImg->xSize) * featImg->ySize;
+
+        // Convert the mask to the output values.
+        GByte *fgPxl = new GByte[pxlBytes];
+        GByte *bgPxl = new GByte[pxlBytes];
+        GDALCopyWords(&fgVal, GDT_Float64, 0, fgPxl, outDataType, 0, 1);
+        GDALCopyWords(&bgVal, GDT_Float64, 0, bgPxl, outDataType, 0, 1);
+        GByte *outData = (GByte *) CPLMalloc(numPxls * pxlBytes);
+        for(size_t i = 0; i < numPxls; ++i)
+        {
+            memcpy(outData + (i * pxlBytes), (featImg->data[i] != 0)?fgPxl:bgPxl, pxlBytes);
+        }
+        delete[] fgPxl;
+        delete[] bgPxl;
+        CPLFree(featImg->data);
+        featImg->data = NULL;
+
+        double featTransform[6];
+        featTransform[0] = featImg->tlX;
+        featTransform[1] = this->gridTransform[1];
+        featTransform[2] = 0.0;
+        featTransform[3] = featImg->tlY;
+        featTransform[4] = 0.0;
+        featTransform[5] = this->gridTransform[5];
+
+        CPLErr err = CE_None;
+        {
+            std::unique_lock<std::mutex> writeLock(this->writeMutex, std::defer_lock);
+            if(this->serialiseWrites)
+            {
+                writeLock.lock();
+            }
+            GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+            if(gdalDriver == NULL)
+            {
+                CPLFree(outData);
+                throw RSGISImageException("Requested GDAL driver does not exists..");
+            }
+            GDALDataset *outDataset = gdalDriver->Create(featImg->outputImage.c_str(), featImg->xSize, featImg->ySize, numBands, outDataType, papszOptions);
+            if(outDataset == NULL)
+            {
+                CPLFree(outData);
+                throw RSGISImageException("Output image could not be created: " + featImg->outputImage);
+            }
+            outDataset->SetGeoTransform(featTransform);
+            outDataset->SetProjection(projWKT.c_str());
+            for(unsigned int n = 0; (n < numBands) && (err == CE_None); ++n)
+            {
+                GDALRasterBand *outBand = outDataset->GetRasterBand(n+1);
+                err = outBand->RasterIO(GF_Write, 0, 0, featImg->xSize, featImg->ySize, outData, featImg->xSize, featImg->ySize, outDataType, 0, 0);
+                if(thematic)
+                {
+                    // The only valid value is fgVal so the statistics do not need to be calculated from the image.
+                    outBand->SetMetadataItem("LAYER_TYPE", "thematic");
+                    outBand->SetNoDataValue(bgVal);
+                    if(featImg->numFgPxls > 0)
+                    {
+                        std::string fgValStr = std::to_string(fgVal);
+                        outBand->SetMetadataItem("STATISTICS_MINIMUM", fgValStr.c_str());
+                        outBand->SetMetadataItem("STATISTICS_MAXIMUM", fgValStr.c_str());
+                        outBand->SetMetadataItem("STATISTICS_MEAN", fgValStr.c_str());
+                        outBand->SetMetadataItem("STATISTICS_STDDEV", "0");
+                    }
+                }
+            }
+            GDALClose(outDataset);
+        }
+        CPLFree(outData);
+        if(err != CE_None)
+        {
+            throw RSGISImageException("Failed to write the image data to " + featImg->outputImage);
+        }
+    }
+
+    void RSGISCreateImagesForFeatures::deleteFeatureImages(std::vector<RSGISFeatureImage*> *featImgs)
+    {
+        for(std::vector<RSGISFeatureImage*>::iterator iterImg = featImgs->begin(); iterImg != featImgs->end(); ++iterImg)
+        {
+            if((*iterImg)->data != NULL)
+            {
+                CPLFree((*iterImg)->data);
+            }
+            if((*iterImg)->geom != NULL)
+            {
+                OGRGeometryFactory::destroyGeometry((*iterImg)->geom);
+            }
+            delete *iterImg;
+        }
+        featImgs->clear();
+    }
+
+    RSGISCreateImagesForFeatures::~RSGISCreateImagesForFeatures()
+    {
+
+    }
+
+}}
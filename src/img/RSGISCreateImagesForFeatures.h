@@ -0,0 +1,119 @@
+/*
+ *  RSGISCreateImagesForFeatures.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISCreateImagesForFeatures_H
+#define RSGISCreateImagesForFeatures_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <map>
+
+#include "gdal_priv.h"
+#include "gdal_alg.h"
+#include "ogrsf_frmts.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadPool.h"
+
+#include "img/RSGISImageUtils.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /** An output image for a feature or clump; the window is in pixels of the reference grid and data is a mask of the feature pixels. */
+    struct DllExport RSGISFeatureImage
+    {
+        std::string outputImage;
+        OGRGeometry *geom;
+        double tlX;
+        double tlY;
+        long xOff;
+        long yOff;
+        long xSize;
+        long ySize;
+        unsigned int clumpID;
+        unsigned long numFgPxls;
+        GByte *data;
+    };
+
+    /**
+     * Creates an image for each feature of a vector layer, or each clump of a
+     * clumps image, in a single pass over the features (or image), sized to the
+     * envelope of the feature snapped to a reference grid (e.g., the pixels of
+     * an image). The features are read once, and the rasterisation and writing
+     * of the output images is done on a pool of threads, holding only a bounded
+     * number of outputs in memory. For clumps, the clumps image is read in strips
+     * twice: first to find the extent of each clump and then to fill the output
+     * buffers, each of which is written as soon as the sweep has passed its last row.
+     */
+    class DllExport RSGISCreateImagesForFeatures
+    {
+    public:
+        RSGISCreateImagesForFeatures(unsigned int numThreads=0, unsigned int stripHeight=256);
+        /**
+         * Creates an image for each feature of the layer. The output is named using the value of
+         * filenameAttribute (or the feature number, starting at 1, if empty), with a suffix (_2, _3, ...)
+         * added where the attribute value has already been used. If snapToGrid is true
+         * the image is the feature envelope on the grid defined by gridTransform (clipped to
+         * gridXSize x gridYSize pixels if these are greater than zero), otherwise it starts at the
+         * top-left of the envelope with the grid resolution. If rasterise is true the pixels within
+         * the feature are fgVal and those outside bgVal, otherwise all the pixels are fgVal.
+         */
+        std::vector<std::string> createFeatureImages(OGRLayer *vecLayer, std::string filenameAttribute, std::string outputImageBase, std::string outFileExtension, double *gridTransform, long gridXSize, long gridYSize, bool snapToGrid, std::string projWKT, bool rasterise, double fgVal, double bgVal, unsigned int numBands, std::string gdalFormat, GDALDataType outDataType, bool thematic);
+        /**
+         * Creates an image, of the extent of the clump, for each clump of the clumps image
+         * (named outputImageBase + "C" + clump ID). The pixels of the clump are 1 if binaryOut
+         * is true, otherwise the clump ID, with all other pixels 0.
+         */
+        std::vector<std::string> createClumpImages(GDALDataset *clumpsDataset, unsigned int band, std::string outputImageBase, std::string outFileExtension, bool binaryOut, std::string gdalFormat, GDALDataType outDataType, bool thematic);
+        ~RSGISCreateImagesForFeatures();
+    protected:
+        void rasteriseFeature(RSGISFeatureImage *featImg, bool rasterise);
+        void writeImage(RSGISFeatureImage *featImg, std::string projWKT, double fgVal, double bgVal, unsigned int numBands, std::string gdalFormat, GDALDataType outDataType, char **papszOptions, bool thematic);
+        void deleteFeatureImages(std::vector<RSGISFeatureImage*> *featImgs);
+        unsigned int numThreads;
+        unsigned int stripHeight;
+        double gridTransform[6];
+        bool serialiseWrites;
+        std::mutex writeMutex;
+    };
+
+}}
+
+#endif
@@ -93,6 +93,38 @@ namespace rsgis{namespace img{
     
     void RSGISExtractImageValues::extractImgBandDataWithinMask2HDF(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, std::string outHDFFile, float maskValue, RSGISLibDataType dataType)
     {
+        try
+        {
+            std::vector<float> pxlVals;
+            unsigned int numOutImgBands = this->extractImgBandDataWithinMask(imageFiles, maskImage, maskValue, &pxlVals);
+            size_t numPxls = pxlVals.size() / numOutImgBands;
+            
+            rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
+            H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
+            exportCols2HDF.createFile(outHDFFile, numOutImgBands, std::string("Pixels Extracted"), h5DataType);
+            for(size_t j = 0; j < numPxls; ++j)
+            {
+                exportCols2HDF.addDataRow(&pxlVals[j*numOutImgBands], H5::PredType::NATIVE_FLOAT);
+            }
+            exportCols2HDF.close();
+        }
+        catch (RSGISImageException &e)
+        {
+            throw e;
+        }
+        catch (RSGISException &e)
+        {
+            throw RSGISImageException(e.what());
+        }
+        catch (std::exception &e)
+        {
+            throw RSGISImageException(e.what());
+        }
+    }
+    
+    unsigned int RSGISExtractImageValues::extractImgBandDataWithinMask(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskValue, std::vector<float> *pxlVals)
+    {
+        unsigned int numOutImgBands = 0;
         try
         {
             GDALAllRegister();
@@ -139,42 +171,22 @@ namespace rsgis{namespace img{
                 }
                 cImgBandCount += datasets[i+1]->GetRasterCount();
             }
+            numOutImgBands = imgBands.size();
+            if(numOutImgBands == 0)
+            {
+                throw RSGISImageException("No image bands were specified.");
+            }
             
-            std::vector<float*> *pxlVals = new std::vector<float*>();
-            unsigned int numOutImgBands = imgBands.size();
-            
+            pxlVals->clear();
             RSGISExtractImageBandValuesWithMask extractData = RSGISExtractImageBandValuesWithMask(pxlVals, imgBands, maskValue);
             RSGISCalcImage calcImg = RSGISCalcImage(&extractData, "", true);
             calcImg.calcImage(datasets, imageFiles.size()+1);
             
-            
             for(unsigned int i = 0; i < (imageFiles.size()+1); ++i)
             {
                 GDALClose(datasets[i]);
             }
             delete[] datasets;
-            
-            rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
-            H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
-            exportCols2HDF.createFile(outHDFFile, numOutImgBands, std::string("Pixels Extracted"), h5DataType);
-            float *row = new float[numOutImgBands];
-            for(unsigned int j = 0; j < pxlVals->size(); ++j)
-            {
-                for(unsigned int i = 0; i < numOutImgBands; ++i)
-                {
-                    row[i] = pxlVals->at(j)[i];
-                }
-                exportCols2HDF.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-            }
-            exportCols2HDF.close();
-            delete[] row;
-            
-            for(std::vector<float*>::iterator iterVals = pxlVals->begin(); iterVals != pxlVals->end(); ++iterVals)
-            {
-                delete[] *iterVals;
-            }
-            delete pxlVals;
-            
         }
         catch (RSGISImageException &e)
         {
@@ -188,82 +200,253 @@ namespace rsgis{namespace img{
         {
             throw RSGISImageException(e.what());
         }
+        return numOutImgBands;
     }
     
-    void RSGISExtractImageValues::sampleExtractedHDFData(std::string inputH5, std::string outputH5, unsigned int nSamples, int seed, RSGISLibDataType dataType)
+    size_t RSGISExtractImageValues::extractImgBandChipsWithinMask2HDF(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskValue, unsigned int chipSize, std::string outHDFFile, RSGISLibDataType dataType, std::string refImage, unsigned int refImgBand, unsigned int numThreads)
     {
+        std::vector<GDALDataset*> datasets;
+        size_t numChips = 0;
         try
         {
-            rsgis::utils::RSGISReadHDFColumnData readHDFCol;
-            readHDFCol.openFile(inputH5);
-            unsigned int nRows = readHDFCol.getNumRows();
-            unsigned int nCols = readHDFCol.getNumCols();
-
-            if(nRows > nSamples)
+            GDALAllRegister();
+            if(imageFiles.size() == 0)
             {
-                unsigned int blockSize = 1000;
-                unsigned int nFullBlocks = (int)floor(((double)nRows)/((double)blockSize));
-                unsigned int remain = nRows - (blockSize*nFullBlocks);
-                float *dataBlock = new float[nRows*nCols];
-
-                float propSamples = ((float)nSamples) / ((float)nRows);
-
-                unsigned int samplesPerBlock = (unsigned int)(ceil(((float)blockSize) * propSamples));
-                unsigned int samples4Remain = (unsigned int)(ceil(((float)remain) * propSamples));
-                //unsigned int totalSamples = (samplesPerBlock * nFullBlocks) + samples4Remain;
-
-                rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
-                H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
-                exportCols2HDF.createFile(outputH5, nCols, std::string("Sampled Pixels Extracted"), h5DataType);
-                float *row = new float[nCols];
-
-                boost::mt19937 randomGen;
-                randomGen.seed(seed);
-                boost::uniform_int<> randomDist(0, blockSize);
-                boost::variate_generator<boost::mt19937&, boost::uniform_int<> > randomVal(randomGen, randomDist);
-
-                unsigned int ranIdx = 0;
-                unsigned int nRowsOff = 0;
-                for(unsigned int i = 0; i < nFullBlocks; ++i)
+                throw RSGISImageException("There were no images provided.");
+            }
+            if(chipSize == 0)
+            {
+                throw RSGISImageException("The chip size must be greater than zero.");
+            }
+            
+            GDALDataset *maskDS = (GDALDataset *) GDALOpen(maskImage.c_str(), GA_ReadOnly);
+            if(maskDS == NULL)
+            {
+                std::string message = std::string("Could not open image ") + maskImage;
+                throw RSGISImageException(message.c_str());
+            }
+            datasets.push_back(maskDS);
+            if(maskDS->GetRasterCount() != 1)
+            {
+                throw RSGISImageException("Image mask must only have 1 image band.");
+            }
+            int width = maskDS->GetRasterXSize();
+            int height = maskDS->GetRasterYSize();
+            
+            std::vector<GDALRasterBand*> imgBands;
+            for(unsigned int i = 0; i < imageFiles.size(); ++i)
+            {
+                GDALDataset *imgDS = (GDALDataset *) GDALOpen(imageFiles.at(i).first.c_str(), GA_ReadOnly);
+                if(imgDS == NULL)
                 {
-                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, blockSize);
-
-                    for(unsigned int j = 0; j < samplesPerBlock; ++j)
+                    std::string message = std::string("Could not open image ") + imageFiles.at(i).first;
+                    throw RSGISImageException(message.c_str());
+                }
+                datasets.push_back(imgDS);
+                if((imgDS->GetRasterXSize() != width) || (imgDS->GetRasterYSize() != height))
+                {
+                    std::string message = std::string("The image is not the same size as the mask: ") + imageFiles.at(i).first;
+                    throw RSGISImageException(message.c_str());
+                }
+                
+                for(std::vector<unsigned int>::iterator iterBands = imageFiles.at(i).second.begin(); iterBands != imageFiles.at(i).second.end(); ++iterBands)
+                {
+                    if(((*iterBands) < 1) || ((*iterBands) > (unsigned int)imgDS->GetRasterCount()))
                     {
-                        ranIdx = randomVal();
-                        for(unsigned int n = 0; n < nCols; ++n)
+                        std::cout << "Error for band number in \'" << imageFiles.at(i).first << "\': " << imgDS->GetRasterCount() << "\n";
+                        throw RSGISImageException("Band numbers start at 1 and equal or less than the number of bands within the image file.");
+                    }
+                    imgBands.push_back(imgDS->GetRasterBand(*iterBands));
+                }
+            }
+            size_t numBands = imgBands.size();
+            if(numBands == 0)
+            {
+                throw RSGISImageException("No image bands were specified.");
+            }
+            
+            bool withRef = (refImage != "");
+            GDALRasterBand *refBand = NULL;
+            if(withRef)
+            {
+                GDALDataset *refDS = (GDALDataset *) GDALOpen(refImage.c_str(), GA_ReadOnly);
+                if(refDS == NULL)
+                {
+                    std::string message = std::string("Could not open image ") + refImage;
+                    throw RSGISImageException(message.c_str());
+                }
+                datasets.push_back(refDS);
+                if((refDS->GetRasterXSize() != width) || (refDS->GetRasterYSize() != height))
+                {
+                    throw RSGISImageException("The reference image is not the same size as the mask.");
+                }
+                if((refImgBand < 1) || (refImgBand > (unsigned int)refDS->GetRasterCount()))
+                {
+                    throw RSGISImageException("The reference image band is not within the reference image.");
+                }
+                refBand = refDS->GetRasterBand(refImgBand);
+            }
+            
+            rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
+            H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
+            rsgis::utils::RSGISExportChipData2HDF exportChips2HDF;
+            exportChips2HDF.createFile(outHDFFile, chipSize, numBands, withRef, withRef?std::string("IMAGE REF TILES"):std::string("IMAGE TILES"), h5DataType);
+            
+            // Strips of whole mask blocks (at least 256 rows) with the chip rows either side.
+            int chipHSize = chipSize / 2;
+            int blockXSize = 0;
+            int blockYSize = 0;
+            maskDS->GetRasterBand(1)->GetBlockSize(&blockXSize, &blockYSize);
+            blockYSize = std::max(blockYSize, 1);
+            int stripHeight = std::min(blockYSize * ((255 + blockYSize) / blockYSize), height);
+            size_t chipLen = ((size_t)chipSize) * chipSize * numBands;
+            size_t refLen = ((size_t)chipSize) * chipSize;
+            size_t batchChips = rsgis::utils::HDF5_WRITE_CHUNK_SIZE;
+            
+            std::vector<float> maskVals = std::vector<float>((size_t)width * stripHeight);
+            std::vector<std::vector<float> > stripVals = std::vector<std::vector<float> >(numBands);
+            std::vector<float> refStripVals;
+            std::vector<std::pair<int, int> > chipPxls;
+            std::vector<float> chipVals = std::vector<float>(chipLen * batchChips);
+            std::vector<unsigned short> refChipVals;
+            if(withRef)
+            {
+                refChipVals = std::vector<unsigned short>(refLen * batchChips);
+            }
+            rsgis::RSGISThreadPool threadPool(numThreads);
+            
+            int numStrips = (height + stripHeight - 1) / stripHeight;
+            rsgis_tqdm pbar;
+            for(int strip = 0; strip < numStrips; ++strip)
+            {
+                pbar.progress(strip, numStrips);
+                int stripY = strip * stripHeight;
+                int stripRows = std::min(stripHeight, height - stripY);
+                if(maskDS->GetRasterBand(1)->RasterIO(GF_Read, 0, stripY, width, stripRows, maskVals.data(), width, stripRows, GDT_Float32, 0, 0) != CE_None)
+                {
+                    throw RSGISImageException("Could not read the image mask.");
+                }
+                chipPxls.clear();
+                for(int y = 0; y < stripRows; ++y)
+                {
+                    for(int x = 0; x < width; ++x)
+                    {
+                        if(maskVals[((size_t)y * width) + x] == maskValue)
                         {
-                            row[n] = dataBlock[(ranIdx*nCols)+n];
+                            chipPxls.push_back(std::pair<int, int>(x, stripY + y));
                         }
-                        exportCols2HDF.addDataRow(row, H5::PredType::NATIVE_FLOAT);
                     }
-                    nRowsOff += blockSize;
                 }
-                if(remain > 0)
+                if(chipPxls.empty())
                 {
-                    boost::uniform_int<> randomDist(0, remain);
-                    boost::variate_generator<boost::mt19937&, boost::uniform_int<> > randomVal(randomGen, randomDist);
-
-                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, remain);
-                    for(unsigned int j = 0; j < samples4Remain; ++j)
+                    continue;
+                }
+                
+                // The rows covered by the chips; rows outside the image are left as 0.
+                int bufStartY = stripY - chipHSize;
+                int bufRows = stripRows + (int)chipSize - 1;
+                int readStartY = std::max(bufStartY, 0);
+                int readEndY = std::min(bufStartY + bufRows, height);
+                auto readStrip = [&](GDALRasterBand *band, std::vector<float> &vals)
+                {
+                    vals.assign((size_t)width * bufRows, 0.0);
+                    float *readVals = vals.data() + ((size_t)(readStartY - bufStartY) * width);
+                    if(band->RasterIO(GF_Read, 0, readStartY, width, readEndY - readStartY, readVals, width, readEndY - readStartY, GDT_Float32, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageException("Could not read the image band.");
+                    }
+                };
+                for(size_t b = 0; b < numBands; ++b)
+                {
+                    readStrip(imgBands[b], stripVals[b]);
+                }
+                if(withRef)
+                {
+                    readStrip(refBand, refStripVals);
+                }
+                
+                for(size_t batchStart = 0; batchStart < chipPxls.size(); batchStart += batchChips)
+                {
+                    size_t batchEnd = std::min(batchStart + batchChips, chipPxls.size());
+                    threadPool.parallelFor(batchStart, batchEnd, [&](size_t start, size_t end)
                     {
-                        ranIdx = randomVal();
-                        for(unsigned int n = 0; n < nCols; ++n)
+                        for(size_t i = start; i < end; ++i)
                         {
-                            row[n] = dataBlock[(ranIdx*nCols)+n];
+                            int xStart = chipPxls[i].first - chipHSize;
+                            int yStart = chipPxls[i].second - chipHSize - bufStartY;
+                            float *chip = &chipVals[(i - batchStart) * chipLen];
+                            unsigned short *refChip = withRef?&refChipVals[(i - batchStart) * refLen]:NULL;
+                            for(unsigned int cy = 0; cy < chipSize; ++cy)
+                            {
+                                size_t rowOff = ((size_t)(yStart + cy)) * width;
+                                for(unsigned int cx = 0; cx < chipSize; ++cx)
+                                {
+                                    int x = xStart + cx;
+                                    bool inImg = ((x >= 0) && (x < width));
+                                    // The chip values are ordered (x, y, band).
+                                    float *chipPxl = chip + ((((size_t)cx * chipSize) + cy) * numBands);
+                                    for(size_t b = 0; b < numBands; ++b)
+                                    {
+                                        chipPxl[b] = inImg?stripVals[b][rowOff + x]:0.0;
+                                    }
+                                    if(withRef)
+                                    {
+                                        refChip[(cy * chipSize) + cx] = inImg?((unsigned short)refStripVals[rowOff + x]):0;
+                                    }
+                                }
+                            }
                         }
-                        exportCols2HDF.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-                    }
+                    }, 16);
+                    exportChips2HDF.addChips(chipVals.data(), withRef?refChipVals.data():NULL, batchEnd - batchStart);
                 }
-                exportCols2HDF.close();
-                delete[] row;
-                delete[] dataBlock;
             }
-            else
+            pbar.finish();
+            
+            numChips = exportChips2HDF.getNumChips();
+            exportChips2HDF.close();
+            
+            for(auto iterDS = datasets.begin(); iterDS != datasets.end(); ++iterDS)
             {
-                throw RSGISException("There are not enough rows to create that sample.");
+                GDALClose(*iterDS);
+            }
+            datasets.clear();
+        }
+        catch (RSGISImageException &e)
+        {
+            for(auto iterDS = datasets.begin(); iterDS != datasets.end(); ++iterDS)
+            {
+                GDALClose(*iterDS);
+            }
+            throw e;
+        }
+        catch (RSGISException &e)
+        {
+            for(auto iterDS = datasets.begin(); iterDS != datasets.end(); ++iterDS)
+            {
+                GDALClose(*iterDS);
+            }
+            throw RSGISImageException(e.what());
+        }
+        catch (std::exception &e)
+        {
+            for(auto iterDS = datasets.begin(); iterDS != datasets.end(); ++iterDS)
+            {
+                GDALClose(*iterDS);
             }
-            readHDFCol.close();
+            throw RSGISImageException(e.what());
+        }
+        return numChips;
+    }
+    
+    void RSGISExtractImageValues::sampleExtractedHDFData(std::string inputH5, std::string outputH5, unsigned int nSamples, int seed, RSGISLibDataType dataType, bool shuffle)
+    {
+        try
+        {
+            rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
+            H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
+
+            rsgis::utils::RSGISHDFSampleManager sampleManager;
+            sampleManager.sampleFiles(std::vector<std::string>(1, inputH5), outputH5, nSamples, seed, h5DataType, shuffle);
         }
         catch (RSGISException &e)
         {
@@ -275,133 +458,29 @@ namespace rsgis{namespace img{
         }
     }
 
-    void RSGISExtractImageValues::splitExtractedHDFData(std::string inputH5, std::string outputP1H5, std::string outputP2H5, unsigned int nSamples, int seed, RSGISLibDataType dataType)
+    void RSGISExtractImageValues::splitExtractedHDFData(std::string inputH5, std::string outputP1H5, std::string outputP2H5, unsigned int nSamples, int seed, RSGISLibDataType dataType, bool shuffle)
     {
         try
         {
-            rsgis::utils::RSGISReadHDFColumnData readHDFCol;
-            readHDFCol.openFile(inputH5);
-            unsigned int nRows = readHDFCol.getNumRows();
-            unsigned int nCols = readHDFCol.getNumCols();
-
-            if(nRows > nSamples)
-            {
-                unsigned int blockSize = 1000;
-                unsigned int nFullBlocks = (int)floor(((double)nRows)/((double)blockSize));
-                unsigned int remain = nRows - (blockSize*nFullBlocks);
-                float *dataBlock = new float[nRows*nCols];
-
-                float propSamples = ((float)nSamples) / ((float)nRows);
-
-                unsigned int samplesPerBlock = (unsigned int)(ceil(((float)blockSize) * propSamples));
-                unsigned int samples4Remain = (unsigned int)(ceil(((float)remain) * propSamples));
-                //unsigned int totalSamples = (samplesPerBlock * nFullBlocks) + samples4Remain;
-
-                rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF_P1;
-                H5::DataType h5DataType = exportCols2HDF_P1.getH5DataType(dataType);
-                exportCols2HDF_P1.createFile(outputP1H5, nCols, std::string("Sampled Pixels Extracted"), h5DataType);
-                rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF_P2;
-                exportCols2HDF_P2.createFile(outputP2H5, nCols, std::string("Sampled Pixels Extracted"), h5DataType);
-                float *row = new float[nCols];
-                unsigned int *ranIdxes = new unsigned int[samplesPerBlock];
-
-                boost::mt19937 randomGen;
-                randomGen.seed(seed);
-                boost::uniform_int<> randomDist(0, blockSize);
-                boost::variate_generator<boost::mt19937&, boost::uniform_int<> > randomVal(randomGen, randomDist);
-
-                bool found = false;
-                unsigned int ranIdx = 0;
-                unsigned int nRowsOff = 0;
-                for(unsigned int i = 0; i < nFullBlocks; ++i)
-                {
-                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, blockSize);
-
-                    for(unsigned int j = 0; j < samplesPerBlock; ++j)
-                    {
-                        ranIdx = randomVal();
-                        for(unsigned int n = 0; n < nCols; ++n)
-                        {
-                            row[n] = dataBlock[(ranIdx*nCols)+n];
-                        }
-                        exportCols2HDF_P1.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-                        ranIdxes[j] = ranIdx;
-                    }
-
-                    for(unsigned int j = 0; j < blockSize; ++j)
-                    {
-                        found = false;
-                        for(unsigned int k = 0; k < samplesPerBlock; ++k)
-                        {
-                            if(ranIdxes[k] == j)
-                            {
-                                found = true;
-                                break;
-                            }
-                        }
-
-                        if(!found)
-                        {
-                            for(unsigned int n = 0; n < nCols; ++n)
-                            {
-                                row[n] = dataBlock[(j*nCols)+n];
-                            }
-                            exportCols2HDF_P2.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-                        }
-                    }
-
-                    nRowsOff += blockSize;
-                }
-                if(remain > 0)
-                {
-                    boost::uniform_int<> randomDist(0, remain);
-                    boost::variate_generator<boost::mt19937&, boost::uniform_int<> > randomVal(randomGen, randomDist);
-
-                    readHDFCol.getDataRows(dataBlock, nCols, blockSize, H5::PredType::NATIVE_FLOAT, nRowsOff, remain);
-                    for(unsigned int j = 0; j < samples4Remain; ++j)
-                    {
-                        ranIdx = randomVal();
-                        for(unsigned int n = 0; n < nCols; ++n)
-                        {
-                            row[n] = dataBlock[(ranIdx*nCols)+n];
-                        }
-                        exportCols2HDF_P1.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-                        ranIdxes[j] = ranIdx;
-                    }
-
-                    for(unsigned int j = 0; j < remain; ++j)
-                    {
-                        found = false;
-                        for(unsigned int k = 0; k < samples4Remain; ++k)
-                        {
-                            if(ranIdxes[k] == j)
-                            {
-                                found = true;
-                                break;
-                            }
-                        }
+            rsgis::utils::RSGISExportColumnData2HDF exportCols2HDF;
+            H5::DataType h5DataType = exportCols2HDF.getH5DataType(dataType);
 
-                        if(!found)
-                        {
-                            for(unsigned int n = 0; n < nCols; ++n)
-                            {
-                                row[n] = dataBlock[(j*nCols)+n];
-                            }
-                            exportCols2HDF_P2.addDataRow(row, H5::PredType::NATIVE_FLOAT);
-                        }
-                    }
-                }
-                exportCols2HDF_P1.close();
-                exportCols2HDF_P2.close();
-                delete[] row;
-                delete[] dataBlock;
-                delete[] ranIdxes;
-            }
-            else
+            rsgis::utils::RSGISHDFSampleManager sampleManager;
+            std::vector<std::string> inputH5Files(1, inputH5);
+            unsigned int nCols = 0;
+            size_t nRows = sampleManager.countRows(inputH5Files, &nCols);
+            if(nRows < nSamples)
             {
                 throw RSGISException("There are not enough rows to create that sample.");
             }
-            readHDFCol.close();
+
+            std::vector<std::string> outputH5Files;
+            outputH5Files.push_back(outputP1H5);
+            outputH5Files.push_back(outputP2H5);
+            std::vector<size_t> outNumRows;
+            outNumRows.push_back(nSamples);
+            outNumRows.push_back(nRows - nSamples);
+            sampleManager.distributeRows(inputH5Files, outputH5Files, outNumRows, seed, h5DataType, shuffle, "Sampled Pixels Extracted");
         }
         catch (RSGISException &e)
         {
@@ -453,6 +532,16 @@ namespace rsgis{namespace img{
     RSGISExtractImageBandValuesWithMask::RSGISExtractImageBandValuesWithMask(std::vector<float*> *pxlVals, std::vector<unsigned int> imgBands, float maskValue): RSGISCalcImageValue(0)
     {
         this->pxlVals = pxlVals;
+        this->pxlMatrix = NULL;
+        this->imgBands = imgBands;
+        this->maskValue = maskValue;
+        this->numOutVals = this->imgBands.size();
+    }
+    
+    RSGISExtractImageBandValuesWithMask::RSGISExtractImageBandValuesWithMask(std::vector<float> *pxlMatrix, std::vector<unsigned int> imgBands, float maskValue): RSGISCalcImageValue(0)
+    {
+        this->pxlVals = NULL;
+        this->pxlMatrix = pxlMatrix;
         this->imgBands = imgBands;
         this->maskValue = maskValue;
         this->numOutVals = this->imgBands.size();
@@ -462,6 +551,14 @@ namespace rsgis{namespace img{
     {
         if(bandValues[0] == maskValue)
         {
+            if(pxlMatrix != NULL)
+            {
+                for(unsigned i = 0; i < numOutVals; ++i)
+                {
+                    pxlMatrix->push_back(bandValues[imgBands[i]]);
+                }
+                return;
+            }
             float *data = new float[numOutVals];
             for(unsigned i = 0; i < numOutVals; ++i)
             {
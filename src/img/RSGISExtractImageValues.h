@@ -36,6 +36,10 @@
 #include "img/RSGISCalcImage.h"
 
 #include "utils/RSGISExportData2HDF.h"
+#include "utils/RSGISHDFSampleManager.h"
+
+#include "common/RSGISThreadPool.h"
+#include "common/rsgis-tqdm.h"
 
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int.hpp>
@@ -63,8 +67,24 @@ namespace rsgis{namespace img{
         RSGISExtractImageValues();
         void extractDataWithinMask2HDF(GDALDataset *mask, GDALDataset *image, std::string outHDFFile, float maskValue, RSGISLibDataType dataType);
         void extractImgBandDataWithinMask2HDF(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, std::string outHDFFile, float maskValue, RSGISLibDataType dataType);
-        void sampleExtractedHDFData(std::string inputH5, std::string outputH5, unsigned int nSamples, int seed, RSGISLibDataType dataType);
-        void splitExtractedHDFData(std::string inputH5, std::string outputP1H5, std::string outputP2H5, unsigned int nSamples, int seed, RSGISLibDataType dataType);
+        /**
+         * Extracts the values of the image bands for the pixels with maskValue in the mask into pxlVals, which
+         * is a contiguous row major (pixels x bands) matrix. Returns the number of bands (columns).
+         */
+        unsigned int extractImgBandDataWithinMask(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskValue, std::vector<float> *pxlVals);
+        /**
+         * Extracts chips (chipSize x chipSize, centred on the pixel for an odd size and with the
+         * pixel at (chipSize/2, chipSize/2) for an even size) of the image bands for the pixels with
+         * maskValue in the mask to a HDF5 chip file (see rsgis::utils::RSGISExportChipData2HDF).
+         * If refImage is not empty the chips of band refImgBand of refImage are also written. The
+         * image is read in strips (once, apart from the rows of the chips overlapping the next strip)
+         * and the chips are cut in parallel. Pixels outside the image are 0. Returns the number of chips.
+         */
+        size_t extractImgBandChipsWithinMask2HDF(std::vector<std::pair<std::string, std::vector<unsigned int> > > imageFiles, std::string maskImage, float maskValue, unsigned int chipSize, std::string outHDFFile, RSGISLibDataType dataType, std::string refImage="", unsigned int refImgBand=1, unsigned int numThreads=1);
+        /** Takes a random sample (without replacement) of nSamples rows from the input file. */
+        void sampleExtractedHDFData(std::string inputH5, std::string outputH5, unsigned int nSamples, int seed, RSGISLibDataType dataType, bool shuffle=false);
+        /** Splits the rows of the input file, with a random sample of nSamples rows in the first output and the remaining rows in the second. */
+        void splitExtractedHDFData(std::string inputH5, std::string outputP1H5, std::string outputP2H5, unsigned int nSamples, int seed, RSGISLibDataType dataType, bool shuffle=false);
         ~RSGISExtractImageValues();
     };
     
@@ -85,10 +105,13 @@ namespace rsgis{namespace img{
     {
     public:
         RSGISExtractImageBandValuesWithMask(std::vector<float*> *pxlVals, std::vector<unsigned int> imgBands, float maskValue);
+        /** Appends the band values of each pixel to the contiguous pxlMatrix (pixels x bands). */
+        RSGISExtractImageBandValuesWithMask(std::vector<float> *pxlMatrix, std::vector<unsigned int> imgBands, float maskValue);
         void calcImageValue(float *bandValues, int numBands);
         ~RSGISExtractImageBandValuesWithMask();
     private:
         std::vector<float*> *pxlVals;
+        std::vector<float> *pxlMatrix;
         std::vector<unsigned int> imgBands;
         unsigned int numOutVals;
         float maskValue;
@@ -0,0 +1,797 @@
+/*
+ *  RSGISGridResampler.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISGridResampler.h"
+
+namespace rsgis{namespace img{
+
+    RSGISGridResampler::RSGISGridResampler(double *transform, long xSize, long ySize, std::string projWKT, unsigned int numThreads, unsigned int latticeStep, unsigned int blockSize, unsigned long maxWinPxls)
+    {
+        for(int i = 0; i < 6; ++i)
+        {
+            this->transform[i] = transform[i];
+        }
+        this->xSize = xSize;
+        this->ySize = ySize;
+        this->projWKT = projWKT;
+        this->numThreads = numThreads;
+        this->latticeStep = std::max<unsigned int>(latticeStep, 1);
+        this->blockSize = std::max<unsigned int>(blockSize, 1);
+        this->maxWinPxls = std::max<unsigned long>(maxWinPxls, 1);
+    }
+
+    void RSGISGridResampler::resampleImage(GDALDataset *dataset, std::string outputImage, std::string gdalFormat, GDALDataType outDataType, RSGISResampleKernel kernel, bool useNoData, double noDataVal)
+    {
+        GDALDataset *outDataset = NULL;
+        char **papszOptions = NULL;
+        try
+        {
+            unsigned int numBands = dataset->GetRasterCount();
+            if(numBands == 0)
+            {
+                throw RSGISImageException("The input image does not have any image bands.");
+            }
+            if(outDataType == GDT_Unknown)
+            {
+                outDataType = dataset->GetRasterBand(1)->GetRasterDataType();
+            }
+
+            // The mapping from the source projection to the pixels of the source image.
+            double srcTransform[6];
+            dataset->GetGeoTransform(srcTransform);
+            double det = (srcTransform[1] * srcTransform[5]) - (srcTransform[2] * srcTransform[4]);
+            if(det == 0)
+            {
+                throw RSGISImageException("The geotransform of the input image cannot be inverted.");
+            }
+            double srcInvTransform[6];
+            srcInvTransform[0] = ((srcTransform[2] * srcTransform[3]) - (srcTransform[0] * srcTransform[5])) / det;
+            srcInvTransform[1] = srcTransform[5] / det;
+            srcInvTransform[2] = (-srcTransform[2]) / det;
+            srcInvTransform[3] = ((-srcTransform[1] * srcTransform[3]) + (srcTransform[0] * srcTransform[4])) / det;
+            srcInvTransform[4] = (-srcTransform[4]) / det;
+            srcInvTransform[5] = srcTransform[1] / det;
+
+            // The lattice must be accurate to an eighth of a source pixel.
+            double srcPxlSize = std::min(std::sqrt((srcTransform[1] * srcTransform[1]) + (srcTransform[4] * srcTransform[4])), std::sqrt((srcTransform[2] * srcTransform[2]) + (srcTransform[5] * srcTransform[5])));
+            RSGISTargetGridCoords *gridCoords = this->getGridCoords(std::string(dataset->GetProjectionRef()), srcPxlSize * 0.125);
+
+            // When downsampling with the average or mode the source window of each block grows
+            // with the number of source pixels under each output pixel, so the blocks are reduced.
+            long blockSize = this->blockSize;
+            if((kernel == rsgis_resample_average) || (kernel == rsgis_resample_mode))
+            {
+                double srcPxlScale = this->findSrcPxlScale(gridCoords, srcInvTransform);
+                double maxBlockPxls = ((double)this->maxWinPxls) / (srcPxlScale * numBands);
+                blockSize = std::min<long>(blockSize, std::max<long>((long)std::floor(std::sqrt(maxBlockPxls)), 1));
+            }
+
+            GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+            if(gdalDriver == NULL)
+            {
+                throw RSGISImageException("Requested GDAL driver does not exists..");
+            }
+            RSGISImageUtils imgUtils;
+            papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+            outDataset = gdalDriver->Create(outputImage.c_str(), this->xSize, this->ySize, numBands, outDataType, papszOptions);
+            if(outDataset == NULL)
+            {
+                throw RSGISImageException("Output image could not be created: " + outputImage);
+            }
+            outDataset->SetGeoTransform(this->transform);
+            outDataset->SetProjection(this->projWKT.c_str());
+            for(unsigned int n = 0; n < numBands; ++n)
+            {
+                GDALRasterBand *inBand = dataset->GetRasterBand(n+1);
+                GDALRasterBand *outBand = outDataset->GetRasterBand(n+1);
+                outBand->SetDescription(inBand->GetDescription());
+                const char *layerType = inBand->GetMetadataItem("LAYER_TYPE", "");
+                if(layerType != NULL)
+                {
+                    outBand->SetMetadataItem("LAYER_TYPE", layerType);
+                }
+                if(useNoData)
+                {
+                    outBand->SetNoDataValue(noDataVal);
+                }
+            }
+
+            long nXBlocks = (this->xSize + blockSize - 1) / blockSize;
+            long nYBlocks = (this->ySize + blockSize - 1) / blockSize;
+            long nBlocks = nXBlocks * nYBlocks;
+            unsigned int nPoolThreads = RSGISThreadPool::findNumThreads(this->numThreads);
+            {
+                // Bound the number of blocks waiting to be processed.
+                RSGISThreadPool pool(nPoolThreads, nPoolThreads * 2);
+                rsgis_tqdm pbar;
+                for(long b = 0; b < nBlocks; ++b)
+                {
+                    pbar.progress(b, nBlocks);
+                    long xOff = (b % nXBlocks) * blockSize;
+                    long yOff = (b / nXBlocks) * blockSize;
+                    long bXSize = std::min<long>(blockSize, this->xSize - xOff);
+                    long bYSize = std::min<long>(blockSize, this->ySize - yOff);
+                    pool.submit([this, dataset, outDataset, gridCoords, &srcInvTransform, xOff, yOff, bXSize, bYSize, kernel, useNoData, noDataVal]{
+                        this->resampleBlock(dataset, outDataset, gridCoords, srcInvTransform, xOff, yOff, bXSize, bYSize, kernel, useNoData, noDataVal);
+                    });
+                }
+                pool.waitForAll();
+                pbar.finish();
+            }
+
+            GDALClose(outDataset);
+            outDataset = NULL;
+            CSLDestroy(papszOptions);
+        }
+        catch(RSGISImageException &e)
+        {
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            if(papszOptions != NULL)
+            {
+                CSLDestroy(papszOptions);
+            }
+            throw e;
+        }
+        catch(std::exception &e)
+        {
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            if(papszOptions != NULL)
+            {
+                CSLDestroy(papszOptions);
+            }
+            throw RSGISImageException(e.what());
+        }
+    }
+
+    void RSGISGridResampler::resampleImages(std::vector<std::string> inputImages, std::vector<std::string> outputImages, std::string gdalFormat, GDALDataType outDataType, RSGISResampleKernel kernel, bool useImgNoData, bool useNoData, double noDataVal)
+    {
+        if(inputImages.size() != outputImages.size())
+        {
+            throw RSGISImageException("The number of input and output images must be the same.");
+        }
+        for(size_t i = 0; i < inputImages.size(); ++i)
+        {
+            std::cout << "Resampling image " << (i+1) << " of " << inputImages.size() << ": " << inputImages.at(i) << std::endl;
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImages.at(i).c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                throw RSGISImageException("Could not open image " + inputImages.at(i));
+            }
+            bool imgUseNoData = useNoData;
+            double imgNoDataVal = noDataVal;
+            if(useImgNoData && (dataset->GetRasterCount() > 0))
+            {
+                int hasNoData = false;
+                double bandNoDataVal = dataset->GetRasterBand(1)->GetNoDataValue(&hasNoData);
+                if(hasNoData)
+                {
+                    imgUseNoData = true;
+                    imgNoDataVal = bandNoDataVal;
+                }
+            }
+            try
+            {
+                this->resampleImage(dataset, outputImages.at(i), gdalFormat, outDataType, kernel, imgUseNoData, imgNoDataVal);
+            }
+            catch(RSGISImageException &e)
+            {
+                GDALClose(dataset);
+                throw e;
+            }
+            GDALClose(dataset);
+        }
+    }
+
+    RSGISTargetGridCoords* RSGISGridResampler::getGridCoords(std::string srcProjWKT, double maxError)
+    {
+        std::map<std::string, RSGISTargetGridCoords*>::iterator iterCoords = this->gridCoordsCache.find(srcProjWKT);
+        if(iterCoords != this->gridCoordsCache.end())
+        {
+            // A lattice checked against a larger error is rebuilt for the finer source pixels.
+            if(iterCoords->second->identity || (iterCoords->second->maxError <= maxError))
+            {
+                return iterCoords->second;
+            }
+            delete iterCoords->second;
+            this->gridCoordsCache.erase(iterCoords);
+        }
+
+        RSGISTargetGridCoords *gridCoords = new RSGISTargetGridCoords();
+        gridCoords->identity = true;
+        gridCoords->srcProjWKT = srcProjWKT;
+        gridCoords->maxError = maxError;
+        OGRSpatialReference srcSpatRef;
+        OGRSpatialReference tgtSpatRef;
+        if((srcProjWKT != "") && (this->projWKT != ""))
+        {
+            if((srcSpatRef.importFromWkt(srcProjWKT.c_str()) != OGRERR_NONE) || (tgtSpatRef.importFromWkt(this->projWKT.c_str()) != OGRERR_NONE))
+            {
+                delete gridCoords;
+                throw RSGISImageException("Could not read the projection of the input image or target grid.");
+            }
+            srcSpatRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+            tgtSpatRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+            gridCoords->identity = srcSpatRef.IsSame(&tgtSpatRef);
+        }
+
+        if(!gridCoords->identity)
+        {
+            OGRCoordinateTransformation *coordTransform = NULL;
+            try
+            {
+                coordTransform = this->createGridTransform(srcProjWKT);
+            }
+            catch(RSGISImageException &e)
+            {
+                delete gridCoords;
+                throw e;
+            }
+
+            for(long x = 0; x < (this->xSize-1); x += this->latticeStep)
+            {
+                gridCoords->nodeX.push_back(x);
+            }
+            gridCoords->nodeX.push_back(this->xSize-1);
+            for(long y = 0; y < (this->ySize-1); y += this->latticeStep)
+            {
+                gridCoords->nodeY.push_back(y);
+            }
+            gridCoords->nodeY.push_back(this->ySize-1);
+            long nNodesX = gridCoords->nodeX.size();
+            long nNodesY = gridCoords->nodeY.size();
+            gridCoords->nodeCoordX.resize(nNodesX * nNodesY);
+            gridCoords->nodeCoordY.resize(nNodesX * nNodesY);
+
+            // Each row of the lattice is transformed with a single call.
+            std::vector<int> success(nNodesX);
+            for(long r = 0; r < nNodesY; ++r)
+            {
+                double *rowX = &gridCoords->nodeCoordX[r * nNodesX];
+                double *rowY = &gridCoords->nodeCoordY[r * nNodesX];
+                double pxlY = gridCoords->nodeY[r] + 0.5;
+                for(long c = 0; c < nNodesX; ++c)
+                {
+                    double pxlX = gridCoords->nodeX[c] + 0.5;
+                    rowX[c] = this->transform[0] + (pxlX * this->transform[1]) + (pxlY * this->transform[2]);
+                    rowY[c] = this->transform[3] + (pxlX * this->transform[4]) + (pxlY * this->transform[5]);
+                }
+                coordTransform->Transform(nNodesX, rowX, rowY, NULL, success.data());
+                for(long c = 0; c < nNodesX; ++c)
+                {
+                    if(!success[c])
+                    {
+                        rowX[c] = std::numeric_limits<double>::quiet_NaN();
+                        rowY[c] = std::numeric_limits<double>::quiet_NaN();
+                    }
+                }
+            }
+
+            // Compare the interpolated coordinates at the centre of each cell with the exact
+            // transformation, a row of cells at a time.
+            long nCellsX = std::max<long>(nNodesX-1, 1);
+            long nCellsY = std::max<long>(nNodesY-1, 1);
+            gridCoords->cellExact.assign(nCellsX * nCellsY, 0);
+            std::vector<double> centreX(nCellsX);
+            std::vector<double> centreY(nCellsX);
+            std::vector<double> centreFX(nCellsX);
+            std::vector<int> centreSuccess(nCellsX);
+            long nExact = 0;
+            for(long r = 0; r < nCellsY; ++r)
+            {
+                long r1 = std::min<long>(r+1, nNodesY-1);
+                long cy = (gridCoords->nodeY[r] + gridCoords->nodeY[r1]) / 2;
+                double fy = (r1 > r)?(((double)(cy - gridCoords->nodeY[r])) / ((double)(gridCoords->nodeY[r1] - gridCoords->nodeY[r]))):0.0;
+                for(long c = 0; c < nCellsX; ++c)
+                {
+                    long c1 = std::min<long>(c+1, nNodesX-1);
+                    long cx = (gridCoords->nodeX[c] + gridCoords->nodeX[c1]) / 2;
+                    centreFX[c] = (c1 > c)?(((double)(cx - gridCoords->nodeX[c])) / ((double)(gridCoords->nodeX[c1] - gridCoords->nodeX[c]))):0.0;
+                    centreX[c] = this->transform[0] + ((cx + 0.5) * this->transform[1]) + ((cy + 0.5) * this->transform[2]);
+                    centreY[c] = this->transform[3] + ((cx + 0.5) * this->transform[4]) + ((cy + 0.5) * this->transform[5]);
+                }
+                coordTransform->Transform(nCellsX, centreX.data(), centreY.data(), NULL, centreSuccess.data());
+                for(long c = 0; c < nCellsX; ++c)
+                {
+                    long c1 = std::min<long>(c+1, nNodesX-1);
+                    double fx = centreFX[c];
+                    double w00 = (1.0 - fx) * (1.0 - fy);
+                    double w01 = fx * (1.0 - fy);
+                    double w10 = (1.0 - fx) * fy;
+                    double w11 = fx * fy;
+                    double interpX = (w00 * gridCoords->nodeCoordX[(r * nNodesX) + c]) + (w01 * gridCoords->nodeCoordX[(r * nNodesX) + c1]) + (w10 * gridCoords->nodeCoordX[(r1 * nNodesX) + c]) + (w11 * gridCoords->nodeCoordX[(r1 * nNodesX) + c1]);
+                    double interpY = (w00 * gridCoords->nodeCoordY[(r * nNodesX) + c]) + (w01 * gridCoords->nodeCoordY[(r * nNodesX) + c1]) + (w10 * gridCoords->nodeCoordY[(r1 * nNodesX) + c]) + (w11 * gridCoords->nodeCoordY[(r1 * nNodesX) + c1]);
+                    bool exact = true;
+                    if(centreSuccess[c] && std::isfinite(interpX) && std::isfinite(interpY))
+                    {
+                        exact = (std::fabs(interpX - centreX[c]) > maxError) || (std::fabs(interpY - centreY[c]) > maxError);
+                    }
+                    if(exact)
+                    {
+                        gridCoords->cellExact[(r * nCellsX) + c] = 1;
+                        ++nExact;
+                    }
+                }
+            }
+            OGRCoordinateTransformation::DestroyCT(coordTransform);
+            if(nExact > 0)
+            {
+                std::cout << nExact << " of " << (nCellsX * nCellsY) << " lattice cells are transformed exactly as they cannot be interpolated.\n";
+            }
+        }
+
+        this->gridCoordsCache[srcProjWKT] = gridCoords;
+        return gridCoords;
+    }
+
+    OGRCoordinateTransformation* RSGISGridResampler::createGridTransform(std::string srcProjWKT)
+    {
+        OGRSpatialReference srcSpatRef;
+        OGRSpatialReference tgtSpatRef;
+        if((srcSpatRef.importFromWkt(srcProjWKT.c_str()) != OGRERR_NONE) || (tgtSpatRef.importFromWkt(this->projWKT.c_str()) != OGRERR_NONE))
+        {
+            throw RSGISImageException("Could not read the projection of the input image or target grid.");
+        }
+        srcSpatRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+        tgtSpatRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+        OGRCoordinateTransformation *coordTransform = OGRCreateCoordinateTransformation(&tgtSpatRef, &srcSpatRef);
+        if(coordTransform == NULL)
+        {
+            throw RSGISImageException("Could not create a transformation from the target grid to the input image projection.");
+        }
+        return coordTransform;
+    }
+
+    double RSGISGridResampler::findSrcPxlScale(RSGISTargetGridCoords *gridCoords, double *srcInvTransform)
+    {
+        // The largest number of source pixels under an output pixel, from the source positions
+        // of a pixel and its neighbours at a sample of the output pixels.
+        long nSamples = 16;
+        long xStep = std::max<long>(this->xSize / nSamples, 1);
+        long yStep = std::max<long>(this->ySize / nSamples, 1);
+        double srcPxlX[4];
+        double srcPxlY[4];
+        double maxScale = 1.0;
+        for(long y = 0; y < this->ySize; y += yStep)
+        {
+            for(long x = 0; x < this->xSize; x += xStep)
+            {
+                this->getBlockSrcPxls(gridCoords, srcInvTransform, x, y, 2, 2, srcPxlX, srcPxlY);
+                double scaleX = std::fabs(srcPxlX[1] - srcPxlX[0]) + std::fabs(srcPxlX[2] - srcPxlX[0]);
+                double scaleY = std::fabs(srcPxlY[1] - srcPxlY[0]) + std::fabs(srcPxlY[2] - srcPxlY[0]);
+                if(std::isfinite(scaleX) && std::isfinite(scaleY))
+                {
+                    maxScale = std::max(maxScale, std::max(scaleX, 1.0) * std::max(scaleY, 1.0));
+                }
+            }
+        }
+        return maxScale;
+    }
+
+    void RSGISGridResampler::getBlockSrcPxls(RSGISTargetGridCoords *gridCoords, double *srcInvTransform, long xOff, long yOff, long bXSize, long bYSize, double *srcPxlX, double *srcPxlY)
+    {
+        // The lattice cell and position within it for each column of the block.
+        long nNodesX = gridCoords->nodeX.size();
+        long nNodesY = gridCoords->nodeY.size();
+        long nCellsX = std::max<long>(nNodesX-1, 1);
+        std::vector<long> colNode(bXSize, 0);
+        std::vector<double> colFrac(bXSize, 0.0);
+        if((!gridCoords->identity) && (nNodesX > 1))
+        {
+            for(long bx = 0; bx < bXSize; ++bx)
+            {
+                long x = xOff + bx;
+                long ix = std::min<long>(x / this->latticeStep, nNodesX-2);
+                colNode[bx] = ix;
+                colFrac[bx] = ((double)(x - gridCoords->nodeX[ix])) / ((double)(gridCoords->nodeX[ix+1] - gridCoords->nodeX[ix]));
+            }
+        }
+        std::vector<size_t> exactIdxs;
+        std::vector<double> exactX;
+        std::vector<double> exactY;
+
+        for(long by = 0; by < bYSize; ++by)
+        {
+            long y = yOff + by;
+            long iy = 0;
+            double fy = 0.0;
+            if((!gridCoords->identity) && (nNodesY > 1))
+            {
+                iy = std::min<long>(y / this->latticeStep, nNodesY-2);
+                fy = ((double)(y - gridCoords->nodeY[iy])) / ((double)(gridCoords->nodeY[iy+1] - gridCoords->nodeY[iy]));
+            }
+            long iy1 = std::min<long>(iy+1, nNodesY-1);
+
+            for(long bx = 0; bx < bXSize; ++bx)
+            {
+                long x = xOff + bx;
+                size_t idx = (((size_t)by) * bXSize) + bx;
+                double coordX = 0.0;
+                double coordY = 0.0;
+                if(gridCoords->identity)
+                {
+                    coordX = this->transform[0] + ((x + 0.5) * this->transform[1]) + ((y + 0.5) * this->transform[2]);
+                    coordY = this->transform[3] + ((x + 0.5) * this->transform[4]) + ((y + 0.5) * this->transform[5]);
+                }
+                else if(gridCoords->cellExact[(iy * nCellsX) + colNode[bx]])
+                {
+                    exactIdxs.push_back(idx);
+                    exactX.push_back(this->transform[0] + ((x + 0.5) * this->transform[1]) + ((y + 0.5) * this->transform[2]));
+                    exactY.push_back(this->transform[3] + ((x + 0.5) * this->transform[4]) + ((y + 0.5) * this->transform[5]));
+                    continue;
+                }
+                else
+                {
+                    long ix = colNode[bx];
+                    long ix1 = std::min<long>(ix+1, nNodesX-1);
+                    double fx = colFrac[bx];
+                    double w00 = (1.0 - fx) * (1.0 - fy);
+                    double w01 = fx * (1.0 - fy);
+                    double w10 = (1.0 - fx) * fy;
+                    double w11 = fx * fy;
+                    coordX = (w00 * gridCoords->nodeCoordX[(iy * nNodesX) + ix]) + (w01 * gridCoords->nodeCoordX[(iy * nNodesX) + ix1]) + (w10 * gridCoords->nodeCoordX[(iy1 * nNodesX) + ix]) + (w11 * gridCoords->nodeCoordX[(iy1 * nNodesX) + ix1]);
+                    coordY = (w00 * gridCoords->nodeCoordY[(iy * nNodesX) + ix]) + (w01 * gridCoords->nodeCoordY[(iy * nNodesX) + ix1]) + (w10 * gridCoords->nodeCoordY[(iy1 * nNodesX) + ix]) + (w11 * gridCoords->nodeCoordY[(iy1 * nNodesX) + ix1]);
+                }
+                srcPxlX[idx] = srcInvTransform[0] + (coordX * srcInvTransform[1]) + (coordY * srcInvTransform[2]);
+                srcPxlY[idx] = srcInvTransform[3] + (coordX * srcInvTransform[4]) + (coordY * srcInvTransform[5]);
+            }
+        }
+
+        // The pixels of the cells which cannot be interpolated are transformed together, with a
+        // transformation for the block as they are not safe to share between threads.
+        if(!exactIdxs.empty())
+        {
+            OGRCoordinateTransformation *coordTransform = this->createGridTransform(gridCoords->srcProjWKT);
+            std::vector<int> success(exactIdxs.size());
+            coordTransform->Transform(exactIdxs.size(), exactX.data(), exactY.data(), NULL, success.data());
+            OGRCoordinateTransformation::DestroyCT(coordTransform);
+            for(size_t i = 0; i < exactIdxs.size(); ++i)
+            {
+                if(success[i])
+                {
+                    srcPxlX[exactIdxs[i]] = srcInvTransform[0] + (exactX[i] * srcInvTransform[1]) + (exactY[i] * srcInvTransform[2]);
+                    srcPxlY[exactIdxs[i]] = srcInvTransform[3] + (exactX[i] * srcInvTransform[4]) + (exactY[i] * srcInvTransform[5]);
+                }
+                else
+                {
+                    srcPxlX[exactIdxs[i]] = std::numeric_limits<double>::quiet_NaN();
+                    srcPxlY[exactIdxs[i]] = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+        }
+    }
+
+    void RSGISGridResampler::resampleBlock(GDALDataset *dataset, GDALDataset *outDataset, RSGISTargetGridCoords *gridCoords, double *srcInvTransform, long xOff, long yOff, long bXSize, long bYSize, RSGISResampleKernel kernel, bool useNoData, double noDataVal)
+    {
+        unsigned int numBands = dataset->GetRasterCount();
+        long srcXSize = dataset->GetRasterXSize();
+        long srcYSize = dataset->GetRasterYSize();
+        double outNoDataVal = useNoData?noDataVal:0.0;
+
+        // The source pixel positions of the block, with an extra column and row used to find
+        // the footprint of each output pixel within the source image.
+        long eXSize = bXSize + 1;
+        long eYSize = bYSize + 1;
+        std::vector<double> srcPxlX(eXSize * eYSize);
+        std::vector<double> srcPxlY(eXSize * eYSize);
+        this->getBlockSrcPxls(gridCoords, srcInvTransform, xOff, yOff, eXSize, eYSize, srcPxlX.data(), srcPxlY.data());
+
+        bool useFootprint = (kernel == rsgis_resample_average) || (kernel == rsgis_resample_mode);
+        size_t nPxls = ((size_t)bXSize) * bYSize;
+        std::vector<double> halfX(useFootprint?nPxls:0, 0.0);
+        std::vector<double> halfY(useFootprint?nPxls:0, 0.0);
+        double kernelRadius = 0.0;
+        if(kernel == rsgis_resample_bilinear)
+        {
+            kernelRadius = 1.0;
+        }
+        else if(kernel == rsgis_resample_cubic)
+        {
+            kernelRadius = 2.0;
+        }
+
+        // Find the window of the source image needed for the block.
+        double minX = std::numeric_limits<double>::max();
+        double maxX = std::numeric_limits<double>::lowest();
+        double minY = std::numeric_limits<double>::max();
+        double maxY = std::numeric_limits<double>::lowest();
+        for(long by = 0; by < bYSize; ++by)
+        {
+            for(long bx = 0; bx < bXSize; ++bx)
+            {
+                size_t eIdx = (((size_t)by) * eXSize) + bx;
+                double px = srcPxlX[eIdx];
+                double py = srcPxlY[eIdx];
+                if(!(std::isfinite(px) && std::isfinite(py)))
+                {
+                    continue;
+                }
+                double radX = kernelRadius;
+                double radY = kernelRadius;
+                if(useFootprint)
+                {
+                    double hx = 0.5 * (std::fabs(srcPxlX[eIdx+1] - px) + std::fabs(srcPxlX[eIdx+eXSize] - px));
+                    double hy = 0.5 * (std::fabs(srcPxlY[eIdx+1] - py) + std::fabs(srcPxlY[eIdx+eXSize] - py));
+                    if(!(std::isfinite(hx) && std::isfinite(hy)))
+                    {
+                        hx = 0.0;
+                        hy = 0.0;
+                    }
+                    size_t idx = (((size_t)by) * bXSize) + bx;
+                    halfX[idx] = hx;
+                    halfY[idx] = hy;
+                    radX = hx + 1.0;
+                    radY = hy + 1.0;
+                }
+                minX = std::min(minX, px - radX);
+                maxX = std::max(maxX, px + radX);
+                minY = std::min(minY, py - radY);
+                maxY = std::max(maxY, py + radY);
+            }
+        }
+        long winX0 = std::max<long>((long)std::floor(std::max(minX, -1.0)), 0);
+        long winX1 = std::min<long>((long)std::ceil(std::min(maxX, (double)srcXSize + 1.0)), srcXSize);
+        long winY0 = std::max<long>((long)std::floor(std::max(minY, -1.0)), 0);
+        long winY1 = std::min<long>((long)std::ceil(std::min(maxY, (double)srcYSize + 1.0)), srcYSize);
+
+        std::vector<double> outData(nPxls * numBands, outNoDataVal);
+        if((minX <= maxX) && (winX0 < winX1) && (winY0 < winY1))
+        {
+            long winXSize = winX1 - winX0;
+            long winYSize = winY1 - winY0;
+            size_t winPxls = ((size_t)winXSize) * winYSize;
+            std::vector<double> winData(winPxls * numBands);
+            {
+                std::lock_guard<std::mutex> ioLock(this->ioMutex);
+                for(unsigned int n = 0; n < numBands; ++n)
+                {
+                    if(dataset->GetRasterBand(n+1)->RasterIO(GF_Read, winX0, winY0, winXSize, winYSize, &winData[n * winPxls], winXSize, winYSize, GDT_Float64, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageException("Failed to read a window from the input image.");
+                    }
+                }
+            }
+
+            // Returns false if the pixel is outside the window or no data.
+            auto getVal = [&](unsigned int n, long ix, long iy, double *val) -> bool
+            {
+                if((ix < winX0) || (ix >= winX1) || (iy < winY0) || (iy >= winY1))
+                {
+                    return false;
+                }
+                *val = winData[(n * winPxls) + (((size_t)(iy - winY0)) * winXSize) + (ix - winX0)];
+                if(!std::isfinite(*val))
+                {
+                    return false;
+                }
+                if(useNoData && (*val == noDataVal))
+                {
+                    return false;
+                }
+                return true;
+            };
+
+            auto cubicWeight = [](double d) -> double
+            {
+                // Keys cubic convolution with a = -0.5.
+                d = std::fabs(d);
+                if(d <= 1.0)
+                {
+                    return (1.5 * d * d * d) - (2.5 * d * d) + 1.0;
+                }
+                else if(d < 2.0)
+                {
+                    return (-0.5 * d * d * d) + (2.5 * d * d) - (4.0 * d) + 2.0;
+                }
+                return 0.0;
+            };
+
+            std::vector<double> modeVals;
+            for(long by = 0; by < bYSize; ++by)
+            {
+                for(long bx = 0; bx < bXSize; ++bx)
+                {
+                    size_t idx = (((size_t)by) * bXSize) + bx;
+                    size_t eIdx = (((size_t)by) * eXSize) + bx;
+                    double px = srcPxlX[eIdx];
+                    double py = srcPxlY[eIdx];
+                    if(!(std::isfinite(px) && std::isfinite(py)))
+                    {
+                        continue;
+                    }
+                    long nx = (long)std::floor(px);
+                    long ny = (long)std::floor(py);
+                    if((nx < 0) || (nx >= srcXSize) || (ny < 0) || (ny >= srcYSize))
+                    {
+                        continue;
+                    }
+
+                    for(unsigned int n = 0; n < numBands; ++n)
+                    {
+                        double val = 0.0;
+                        double *outVal = &outData[(n * nPxls) + idx];
+                        if(kernel == rsgis_resample_nearest)
+                        {
+                            if(getVal(n, nx, ny, &val))
+                            {
+                                *outVal = val;
+                            }
+                        }
+                        else if((kernel == rsgis_resample_bilinear) || (kernel == rsgis_resample_cubic))
+                        {
+                            double u = px - 0.5;
+                            double v = py - 0.5;
+                            long i0 = (long)std::floor(u);
+                            long j0 = (long)std::floor(v);
+                            double fu = u - i0;
+                            double fv = v - j0;
+                            bool done = false;
+                            if(kernel == rsgis_resample_cubic)
+                            {
+                                double sum = 0.0;
+                                bool allValid = true;
+                                for(long j = -1; (j <= 2) && allValid; ++j)
+                                {
+                                    double wy = cubicWeight(j - fv);
+                                    for(long i = -1; (i <= 2) && allValid; ++i)
+                                    {
+                                        if(getVal(n, i0 + i, j0 + j, &val))
+                                        {
+                                            sum += wy * cubicWeight(i - fu) * val;
+                                        }
+                                        else
+                                        {
+                                            allValid = false;
+                                        }
+                                    }
+                                }
+                                if(allValid)
+                                {
+                                    *outVal = sum;
+                                    done = true;
+                                }
+                            }
+                            if(!done)
+                            {
+                                // Bilinear, normalised by the weights of the valid neighbours.
+                                double sum = 0.0;
+                                double sumW = 0.0;
+                                for(long j = 0; j <= 1; ++j)
+                                {
+                                    double wy = (j == 0)?(1.0 - fv):fv;
+                                    for(long i = 0; i <= 1; ++i)
+                                    {
+                                        double w = wy * ((i == 0)?(1.0 - fu):fu);
+                                        if((w > 0) && getVal(n, i0 + i, j0 + j, &val))
+                                        {
+                                            sum += w * val;
+                                            sumW += w;
+                                        }
+                                    }
+                                }
+                                if(sumW > 0)
+                                {
+                                    *outVal = sum / sumW;
+                                }
+                            }
+                        }
+                        else
+                        {
+                            // Average or mode of the source pixels with their centre within the footprint.
+                            long x0 = (long)std::ceil(px - halfX[idx] - 0.5);
+                            long x1 = (long)std::ceil(px + halfX[idx] - 0.5) - 1;
+                            if(x1 < x0)
+                            {
+                                x0 = nx;
+                                x1 = nx;
+                            }
+                            long y0 = (long)std::ceil(py - halfY[idx] - 0.5);
+                            long y1 = (long)std::ceil(py + halfY[idx] - 0.5) - 1;
+                            if(y1 < y0)
+                            {
+                                y0 = ny;
+                                y1 = ny;
+                            }
+                            if(kernel == rsgis_resample_average)
+                            {
+                                double sum = 0.0;
+                                unsigned long count = 0;
+                                for(long iy = y0; iy <= y1; ++iy)
+                                {
+                                    for(long ix = x0; ix <= x1; ++ix)
+                                    {
+                                        if(getVal(n, ix, iy, &val))
+                                        {
+                                            sum += val;
+                                            ++count;
+                                        }
+                                    }
+                                }
+                                if(count > 0)
+                                {
+                                    *outVal = sum / count;
+                                }
+                            }
+                            else
+                            {
+                                modeVals.clear();
+                                for(long iy = y0; iy <= y1; ++iy)
+                                {
+                                    for(long ix = x0; ix <= x1; ++ix)
+                                    {
+                                        if(getVal(n, ix, iy, &val))
+                                        {
+                                            modeVals.push_back(val);
+                                        }
+                                    }
+                                }
+                                if(!modeVals.empty())
+                                {
+                                    std::sort(modeVals.begin(), modeVals.end());
+                                    double modeVal = modeVals[0];
+                                    size_t modeCount = 0;
+                                    size_t runStart = 0;
+                                    for(size_t i = 1; i <= modeVals.size(); ++i)
+                                    {
+                                        if((i == modeVals.size()) || (modeVals[i] != modeVals[runStart]))
+                                        {
+                                            if((i - runStart) > modeCount)
+                                            {
+                                                modeCount = i - runStart;
+                                                modeVal = modeVals[runStart];
+                                            }
+                                            runStart = i;
+                                        }
+                                    }
+                                    *outVal = modeVal;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> ioLock(this->ioMutex);
+        for(unsigned int n = 0; n < numBands; ++n)
+        {
+            if(outDataset->GetRasterBand(n+1)->RasterIO(GF_Write, xOff, yOff, bXSize, bYSize, &outData[n * nPxls], bXSize, bYSize, GDT_Float64, 0, 0) != CE_None)
+            {
+                throw RSGISImageException("Failed to write a block to the output image.");
+            }
+        }
+    }
+
+    RSGISGridResampler::~RSGISGridResampler()
+    {
+        for(std::map<std::string, RSGISTargetGridCoords*>::iterator iterCoords = this->gridCoordsCache.begin(); iterCoords != this->gridCoordsCache.end(); ++iterCoords)
+        {
+            delete iterCoords->second;
+        }
+    }
+
+}}
@@ -0,0 +1,140 @@
+/*
+ *  RSGISGridResampler.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISGridResampler_H
+#define RSGISGridResampler_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <mutex>
+
+#include "gdal_priv.h"
+#include "ogr_spatialref.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadPool.h"
+
+#include "img/RSGISImageUtils.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /** The resampling kernels, with the same values as rsgislib.INTERP_*. */
+    enum RSGISResampleKernel
+    {
+        rsgis_resample_nearest = 0,
+        rsgis_resample_bilinear = 1,
+        rsgis_resample_cubic = 2,
+        rsgis_resample_average = 5,
+        rsgis_resample_mode = 6
+    };
+
+    /**
+     * The coordinates, in a source projection, of the pixel centres of the target grid
+     * on a lattice of every latticeStep pixels (plus the last row and column). Between the
+     * lattice nodes the coordinates are bilinearly interpolated. If identity is true the
+     * source and target projections are the same and the lattice is not used.
+     *
+     * The interpolation is checked at the centre of each lattice cell; the cells where the
+     * error is above maxError (in the units of the source projection), or a node could not
+     * be transformed, are flagged in cellExact and their pixels are transformed exactly.
+     */
+    struct DllExport RSGISTargetGridCoords
+    {
+        bool identity;
+        std::string srcProjWKT;
+        double maxError;
+        std::vector<long> nodeX;
+        std::vector<long> nodeY;
+        std::vector<double> nodeCoordX;
+        std::vector<double> nodeCoordY;
+        std::vector<unsigned char> cellExact;
+    };
+
+    /**
+     * Resamples images onto a target grid (geotransform, size and projection). The mapping
+     * from the target pixels to the source projection is calculated once for each source
+     * projection, exactly at a lattice of the target pixels and interpolated between, and
+     * cached so a batch of images with the same projection share it; only the (affine)
+     * mapping from the source projection to the pixels of each image differs.
+     *
+     * The output is processed in blocks on a pool of threads; the I/O for each block (the
+     * window of the source image under the block and the output block) is serialised, while
+     * the resampling of the blocks is done in parallel. Pixels which are outside the source
+     * image, or only have no data within the kernel, are set to the no data value (or 0).
+     * For the average and mode kernels the blocks are made smaller when downsampling so the
+     * source window of a block (over all the bands) is no more than maxWinPxls pixels.
+     */
+    class DllExport RSGISGridResampler
+    {
+    public:
+        RSGISGridResampler(double *transform, long xSize, long ySize, std::string projWKT, unsigned int numThreads=0, unsigned int latticeStep=16, unsigned int blockSize=256, unsigned long maxWinPxls=16777216);
+        /**
+         * Resamples the image to the output image on the target grid. If outDataType is
+         * GDT_Unknown the data type of the first band of the input is used.
+         */
+        void resampleImage(GDALDataset *dataset, std::string outputImage, std::string gdalFormat, GDALDataType outDataType, RSGISResampleKernel kernel, bool useNoData, double noDataVal);
+        /**
+         * Resamples each of the input images to the output images. If useImgNoData is true the no data
+         * value of each image (where defined) is used, otherwise noDataVal if useNoData is true.
+         */
+        void resampleImages(std::vector<std::string> inputImages, std::vector<std::string> outputImages, std::string gdalFormat, GDALDataType outDataType, RSGISResampleKernel kernel, bool useImgNoData, bool useNoData, double noDataVal);
+        ~RSGISGridResampler();
+    protected:
+        RSGISTargetGridCoords* getGridCoords(std::string srcProjWKT, double maxError);
+        OGRCoordinateTransformation* createGridTransform(std::string srcProjWKT);
+        double findSrcPxlScale(RSGISTargetGridCoords *gridCoords, double *srcInvTransform);
+        void getBlockSrcPxls(RSGISTargetGridCoords *gridCoords, double *srcInvTransform, long xOff, long yOff, long bXSize, long bYSize, double *srcPxlX, double *srcPxlY);
+        void resampleBlock(GDALDataset *dataset, GDALDataset *outDataset, RSGISTargetGridCoords *gridCoords, double *srcInvTransform, long xOff, long yOff, long bXSize, long bYSize, RSGISResampleKernel kernel, bool useNoData, double noDataVal);
+        double transform[6];
+        long xSize;
+        long ySize;
+        std::string projWKT;
+        unsigned int numThreads;
+        unsigned int latticeStep;
+        unsigned int blockSize;
+        unsigned long maxWinPxls;
+        std::map<std::string, RSGISTargetGridCoords*> gridCoordsCache;
+        std::mutex ioMutex;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,362 @@
+/*
+ *  RSGISImageBitFields.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISImageBitFields.h"
+
+namespace rsgis{namespace img{
+
+    RSGISDecodeImageBitFields::RSGISDecodeImageBitFields(std::vector<RSGISBitFieldSpec> bitFields, bool packMasks)
+    {
+        if(bitFields.empty())
+        {
+            throw RSGISImageException("At least one bit field must be specified.");
+        }
+        this->bitFields = bitFields;
+        this->packMasks = packMasks;
+
+        this->numOutBands = 0;
+        for(auto iterField = bitFields.begin(); iterField != bitFields.end(); ++iterField)
+        {
+            if((*iterField).outBand == 0)
+            {
+                throw RSGISImageException("The output band for a bit field must be 1 or greater.");
+            }
+            if((*iterField).bitLength == 0)
+            {
+                throw RSGISImageException("The bit length of a bit field must be 1 or greater.");
+            }
+            if((!packMasks) && ((*iterField).bitLength > 8))
+            {
+                throw RSGISImageException("Bit fields longer than 8 bits cannot be written to a Byte output band.");
+            }
+            if((*iterField).outBand > this->numOutBands)
+            {
+                this->numOutBands = (*iterField).outBand;
+            }
+        }
+
+        // Each output band (or bit when packing) must be written by exactly one field.
+        std::vector<bool> bandUsed(this->numOutBands, false);
+        for(auto iterField = bitFields.begin(); iterField != bitFields.end(); ++iterField)
+        {
+            if(bandUsed.at((*iterField).outBand-1))
+            {
+                throw RSGISImageException("More than one bit field has been specified for output band " + std::to_string((*iterField).outBand) + ".");
+            }
+            bandUsed.at((*iterField).outBand-1) = true;
+        }
+        for(unsigned int i = 0; i < this->numOutBands; ++i)
+        {
+            if(!bandUsed.at(i))
+            {
+                throw RSGISImageException("No bit field has been specified for output band " + std::to_string(i+1) + ".");
+            }
+        }
+        if(packMasks && (this->numOutBands > 32))
+        {
+            throw RSGISImageException("No more than 32 masks can be packed into an output band.");
+        }
+    }
+
+    void RSGISDecodeImageBitFields::decodeBitFields(GDALDataset *dataset, unsigned int imgBand, std::string outputImage, std::string gdalFormat)
+    {
+        if((imgBand == 0) || (imgBand > dataset->GetRasterCount()))
+        {
+            throw RSGISImageException("The input image band is not within the input image.");
+        }
+
+        GDALRasterBand *inBand = dataset->GetRasterBand(imgBand);
+        GDALDataType inDataType = inBand->GetRasterDataType();
+        unsigned int numInBits = RSGISDecodeImageBitFields::getNumBits(inDataType);
+        if(numInBits == 0)
+        {
+            throw RSGISImageException("The input image is not an integer data type.");
+        }
+        for(auto iterField = this->bitFields.begin(); iterField != this->bitFields.end(); ++iterField)
+        {
+            if(((*iterField).bitOffset + (*iterField).bitLength) > numInBits)
+            {
+                throw RSGISImageException("Bit field '" + (*iterField).name + "' is outside of the " + std::to_string(numInBits) + " bits of the input image.");
+            }
+        }
+
+        GDALDataType outDataType = GDT_Byte;
+        unsigned int numOutImgBands = this->numOutBands;
+        if(this->packMasks)
+        {
+            numOutImgBands = 1;
+            if(this->numOutBands > 16)
+            {
+                outDataType = GDT_UInt32;
+            }
+            else if(this->numOutBands > 8)
+            {
+                outDataType = GDT_UInt16;
+            }
+        }
+
+        GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+        if(gdalDriver == NULL)
+        {
+            throw RSGISImageException("Requested GDAL driver does not exist.");
+        }
+
+        RSGISImageUtils imgUtils;
+        char **papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+        GDALDataset *outDataset = gdalDriver->Create(outputImage.c_str(), dataset->GetRasterXSize(), dataset->GetRasterYSize(), numOutImgBands, outDataType, papszOptions);
+        CSLDestroy(papszOptions);
+        if(outDataset == NULL)
+        {
+            throw RSGISImageException("Could not create image: " + outputImage);
+        }
+
+        double trans[6];
+        dataset->GetGeoTransform(trans);
+        outDataset->SetGeoTransform(trans);
+        outDataset->SetProjection(dataset->GetProjectionRef());
+
+        if(this->packMasks)
+        {
+            GDALRasterBand *outBand = outDataset->GetRasterBand(1);
+            outBand->SetDescription("packed_masks");
+            for(auto iterField = this->bitFields.begin(); iterField != this->bitFields.end(); ++iterField)
+            {
+                std::string bitKey = "BIT_" + std::to_string((*iterField).outBand-1);
+                outBand->SetMetadataItem(bitKey.c_str(), (*iterField).name.c_str());
+            }
+        }
+        else
+        {
+            for(auto iterField = this->bitFields.begin(); iterField != this->bitFields.end(); ++iterField)
+            {
+                outDataset->GetRasterBand((*iterField).outBand)->SetDescription((*iterField).name.c_str());
+            }
+        }
+
+        try
+        {
+            switch(inDataType)
+            {
+                case GDT_Byte:
+                    this->processImage<GByte>(inBand, outDataset, outDataType);
+                    break;
+                case GDT_UInt16:
+                    this->processImage<GUInt16>(inBand, outDataset, outDataType);
+                    break;
+                case GDT_Int16:
+                    this->processImage<GInt16>(inBand, outDataset, outDataType);
+                    break;
+                case GDT_UInt32:
+                    this->processImage<GUInt32>(inBand, outDataset, outDataType);
+                    break;
+                case GDT_Int32:
+                    this->processImage<GInt32>(inBand, outDataset, outDataType);
+                    break;
+                default:
+                    throw RSGISImageException("The input image is not an integer data type.");
+            }
+        }
+        catch(RSGISImageException &e)
+        {
+            GDALClose(outDataset);
+            throw e;
+        }
+        GDALClose(outDataset);
+    }
+
+    std::vector<RSGISBitFieldSpec> RSGISDecodeImageBitFields::getSingleBitFields(GDALDataType dataType)
+    {
+        unsigned int numBits = RSGISDecodeImageBitFields::getNumBits(dataType);
+        std::vector<RSGISBitFieldSpec> bitFields;
+        for(unsigned int i = 0; i < numBits; ++i)
+        {
+            RSGISBitFieldSpec field;
+            field.name = "Bit " + std::to_string(i);
+            field.bitOffset = i;
+            field.bitLength = 1;
+            field.outBand = i+1;
+            bitFields.push_back(field);
+        }
+        return bitFields;
+    }
+
+    unsigned int RSGISDecodeImageBitFields::getNumBits(GDALDataType dataType)
+    {
+        unsigned int numBits = 0;
+        if(dataType == GDT_Byte)
+        {
+            numBits = 8;
+        }
+        else if((dataType == GDT_UInt16) || (dataType == GDT_Int16))
+        {
+            numBits = 16;
+        }
+        else if((dataType == GDT_UInt32) || (dataType == GDT_Int32))
+        {
+            numBits = 32;
+        }
+        return numBits;
+    }
+
+    template<typename T> void RSGISDecodeImageBitFields::processImage(GDALRasterBand *inBand, GDALDataset *outDataset, GDALDataType outDataType)
+    {
+        int xSize = inBand->GetXSize();
+        int ySize = inBand->GetYSize();
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        inBand->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        // Read whole rows of blocks, using at least 256 lines per read so
+        // line interleaved formats are not read one row at a time.
+        int nRowsPerRead = yBlockSize;
+        while(nRowsPerRead < 256)
+        {
+            nRowsPerRead += yBlockSize;
+        }
+        if(nRowsPerRead > ySize)
+        {
+            nRowsPerRead = ySize;
+        }
+        size_t nBlockPxls = ((size_t)xSize) * ((size_t)nRowsPerRead);
+        GDALDataType inDataType = inBand->GetRasterDataType();
+        int outPxlSize = GDALGetDataTypeSizeBytes(outDataType);
+
+        T *inData = (T *) CPLMalloc(sizeof(T)*nBlockPxls);
+        GByte **outData = new GByte*[this->numOutBands];
+        unsigned int nOutBufs = this->packMasks?1:this->numOutBands;
+        for(unsigned int i = 0; i < nOutBufs; ++i)
+        {
+            outData[i] = (GByte *) CPLMalloc(outPxlSize*nBlockPxls);
+        }
+
+        try
+        {
+            int nReads = (ySize + nRowsPerRead - 1) / nRowsPerRead;
+            rsgis_tqdm pbar;
+            for(int n = 0; n < nReads; ++n)
+            {
+                pbar.progress(n, nReads);
+                int yOff = n * nRowsPerRead;
+                int nRows = nRowsPerRead;
+                if((yOff + nRows) > ySize)
+                {
+                    nRows = ySize - yOff;
+                }
+                size_t nPxls = ((size_t)xSize) * ((size_t)nRows);
+
+                if(inBand->RasterIO(GF_Read, 0, yOff, xSize, nRows, inData, xSize, nRows, inDataType, 0, 0) != CE_None)
+                {
+                    throw RSGISImageException("Could not read image data.");
+                }
+
+                if(this->packMasks)
+                {
+                    if(outDataType == GDT_UInt32)
+                    {
+                        this->packBlock<T, GUInt32>(inData, nPxls, (GUInt32 *)outData[0]);
+                    }
+                    else if(outDataType == GDT_UInt16)
+                    {
+                        this->packBlock<T, GUInt16>(inData, nPxls, (GUInt16 *)outData[0]);
+                    }
+                    else
+                    {
+                        this->packBlock<T, GByte>(inData, nPxls, outData[0]);
+                    }
+                }
+                else
+                {
+                    this->decodeBlock<T>(inData, nPxls, outData);
+                }
+
+                for(unsigned int i = 0; i < nOutBufs; ++i)
+                {
+                    if(outDataset->GetRasterBand(i+1)->RasterIO(GF_Write, 0, yOff, xSize, nRows, outData[i], xSize, nRows, outDataType, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageException("Could not write image data.");
+                    }
+                }
+            }
+            pbar.finish();
+        }
+        catch(RSGISImageException &e)
+        {
+            CPLFree(inData);
+            for(unsigned int i = 0; i < nOutBufs; ++i)
+            {
+                CPLFree(outData[i]);
+            }
+            delete[] outData;
+            throw e;
+        }
+
+        CPLFree(inData);
+        for(unsigned int i = 0; i < nOutBufs; ++i)
+        {
+            CPLFree(outData[i]);
+        }
+        delete[] outData;
+    }
+
+    template<typename T> void RSGISDecodeImageBitFields::decodeBlock(T *inData, size_t nPxls, GByte **outData)
+    {
+        // Shift in the unsigned type so signed inputs are not sign extended.
+        // The loops have no branches so the compiler can vectorise them.
+        typedef typename std::make_unsigned<T>::type UT;
+        const UT *uInData = reinterpret_cast<const UT*>(inData);
+        for(auto iterField = this->bitFields.begin(); iterField != this->bitFields.end(); ++iterField)
+        {
+            const unsigned int offset = (*iterField).bitOffset;
+            const UT mask = (UT)((1u << (*iterField).bitLength) - 1);
+            GByte *out = outData[(*iterField).outBand-1];
+            for(size_t i = 0; i < nPxls; ++i)
+            {
+                out[i] = (GByte)((uInData[i] >> offset) & mask);
+            }
+        }
+    }
+
+    template<typename T, typename P> void RSGISDecodeImageBitFields::packBlock(T *inData, size_t nPxls, P *outData)
+    {
+        typedef typename std::make_unsigned<T>::type UT;
+        const UT *uInData = reinterpret_cast<const UT*>(inData);
+        std::memset(outData, 0, sizeof(P)*nPxls);
+        for(auto iterField = this->bitFields.begin(); iterField != this->bitFields.end(); ++iterField)
+        {
+            const UT mask = (UT)((((unsigned long long)1) << (*iterField).bitLength) - 1) << (*iterField).bitOffset;
+            const unsigned int outBit = (*iterField).outBand-1;
+            for(size_t i = 0; i < nPxls; ++i)
+            {
+                outData[i] |= (P)(((P)((uInData[i] & mask) != 0)) << outBit);
+            }
+        }
+    }
+
+    RSGISDecodeImageBitFields::~RSGISDecodeImageBitFields()
+    {
+
+    }
+
+}}
@@ -0,0 +1,89 @@
+/*
+ *  RSGISImageBitFields.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISImageBitFields_H
+#define RSGISImageBitFields_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <type_traits>
+
+#include "gdal_priv.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+
+#include "img/RSGISImageUtils.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    struct DllExport RSGISBitFieldSpec
+    {
+        std::string name;
+        unsigned int bitOffset;
+        unsigned int bitLength;
+        unsigned int outBand;
+    };
+
+    /**
+     * Decodes bit fields (e.g., Landsat or Sentinel-2 QA bands) from an integer image band.
+     * Whole blocks of the input band are read in their native type and each field is
+     * extracted with a shift and a mask into a Byte output band (outBand, indexed from 1).
+     *
+     * If packMasks is true then each field is treated as a boolean (field != 0) and written
+     * to bit (outBand-1) of a single output band, so up to 32 flags are held per pixel.
+     */
+    class DllExport RSGISDecodeImageBitFields
+    {
+    public:
+        RSGISDecodeImageBitFields(std::vector<RSGISBitFieldSpec> bitFields, bool packMasks=false);
+        void decodeBitFields(GDALDataset *dataset, unsigned int imgBand, std::string outputImage, std::string gdalFormat);
+        static std::vector<RSGISBitFieldSpec> getSingleBitFields(GDALDataType dataType);
+        static unsigned int getNumBits(GDALDataType dataType);
+        ~RSGISDecodeImageBitFields();
+    protected:
+        template<typename T> void decodeBlock(T *inData, size_t nPxls, GByte **outData);
+        template<typename T, typename P> void packBlock(T *inData, size_t nPxls, P *outData);
+        template<typename T> void processImage(GDALRasterBand *inBand, GDALDataset *outDataset, GDALDataType outDataType);
+        std::vector<RSGISBitFieldSpec> bitFields;
+        bool packMasks;
+        unsigned int numOutBands;
+    };
+
+}}
+
+#endif
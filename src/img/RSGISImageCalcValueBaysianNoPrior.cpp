@@ -24,7 +24,7 @@
 
 namespace rsgis{namespace img{
 	
-	RSGISImageCalcValueBaysianNoPrior::RSGISImageCalcValueBaysianNoPrior(int numberOutBands, rsgis::math::RSGISMathFunction *function, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, rsgis::math::deltatypedef deltatype) : RSGISCalcImageValue(numberOutBands)
+	RSGISImageCalcValueBaysianNoPrior::RSGISImageCalcValueBaysianNoPrior(int numberOutBands, rsgis::math::RSGISMathFunction *function, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, rsgis::math::deltatypedef deltatype, bool useCache, double cacheTolerance, size_t maxCacheEntries) : RSGISCalcImageValue(numberOutBands)
 	{
 		this->function = function;
 		this->variance = variance;
@@ -34,13 +34,32 @@ namespace rsgis{namespace img{
 		this->upperLimit = upperLimit;
 		this->lowerLimit = lowerLimit;
 		this->deltatype = deltatype;
+		this->useCache = useCache;
+		this->statsCache = NULL;
+		if(useCache)
+		{
+			this->statsCache = new rsgis::math::RSGISBaysianStatsCache(cacheTolerance, maxCacheEntries);
+		}
 
 		baysianStats = new rsgis::math::RSGISBaysianStatsNoPrior(function, variance, interval, minVal, maxVal, lowerLimit, upperLimit, deltatype);
 	}
 	
 	void RSGISImageCalcValueBaysianNoPrior::calcImageValue(float *bandValues, int numBands, double *output) 
 	{				
-		outputVals = baysianStats->calcImageValueNoPrior(bandValues[0]);
+		double outputVals[3];
+		if(this->useCache)
+		{
+			float value = this->statsCache->binValue(bandValues[0]);
+			if(!this->statsCache->lookup(value, outputVals))
+			{
+				this->calcPosterior(value, outputVals);
+				this->statsCache->insert(value, outputVals);
+			}
+		}
+		else
+		{
+			this->calcPosterior(bandValues[0], outputVals);
+		}
 		
 		output[1] = outputVals[0]; // Maximum Likelyhood Value
 		output[0] = outputVals[1]; // Lower value
@@ -49,13 +68,27 @@ namespace rsgis{namespace img{
 		// Calculate delta- and delta +
 		output[3] = sqrt((output[1] - output[0])*(output[1] - output[0]));
 		output[4] = sqrt((output[2] - output[1])*(output[2] - output[1]));
-		delete[] outputVals;
 		
 	}
 	
+	void RSGISImageCalcValueBaysianNoPrior::calcPosterior(float value, double *outVals)
+	{
+		// The integration function holds the current value so is not thread safe.
+		std::lock_guard<std::mutex> lock(this->statsMutex);
+		double *vals = baysianStats->calcImageValueNoPrior(value);
+		outVals[0] = vals[0];
+		outVals[1] = vals[1];
+		outVals[2] = vals[2];
+		delete[] vals;
+	}
+	
 	RSGISImageCalcValueBaysianNoPrior::~RSGISImageCalcValueBaysianNoPrior()
 	{
 		delete baysianStats;
+		if(this->statsCache != NULL)
+		{
+			delete this->statsCache;
+		}
 	}
 }}
 
@@ -24,6 +24,7 @@
 #define RSGISImageCalcValueBaysianNoPrior_H
 
 #include <iostream>
+#include <mutex>
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISImageBandException.h"
@@ -31,6 +32,7 @@
 #include "math/RSGISBaysianStatsNoPrior.h"
 #include "math/RSGISBaysianStatsException.h"
 #include "math/RSGISBaysianDeltaType.h"
+#include "math/RSGISBaysianStatsCache.h"
 #include "common/RSGISImageException.h"
 
 #include "gdal_priv.h"
@@ -49,13 +51,20 @@
 #endif
 
 namespace rsgis{namespace img{
+	/**
+	 * If useCache the posterior summary is calculated once per distinct input
+	 * value (or per bin of width cacheTolerance, if greater than zero) and
+	 * reused. Once maxCacheEntries values are cached, other values are
+	 * calculated directly.
+	 */
 	class DllExport RSGISImageCalcValueBaysianNoPrior	: public RSGISCalcImageValue
 		{
 		public:
-			RSGISImageCalcValueBaysianNoPrior(int numberOutBands, rsgis::math::RSGISMathFunction *function, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, rsgis::math::deltatypedef deltatype);
+			RSGISImageCalcValueBaysianNoPrior(int numberOutBands, rsgis::math::RSGISMathFunction *function, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, rsgis::math::deltatypedef deltatype, bool useCache=true, double cacheTolerance=0.0, size_t maxCacheEntries=1048576);
 			void calcImageValue(float *bandValues, int numBands, double *output);
 			~RSGISImageCalcValueBaysianNoPrior();
 		protected:
+			void calcPosterior(float value, double *outVals);
 			rsgis::math::RSGISMathFunction *function;
 			rsgis::math::RSGISMathFunction *probDistro;
 			double variance;
@@ -64,9 +73,11 @@ namespace rsgis{namespace img{
 			double maxVal;
 			double upperLimit;
 			double lowerLimit;
-			double* outputVals;
 			rsgis::math::deltatypedef deltatype;
 			rsgis::math::RSGISBaysianStatsNoPrior *baysianStats;
+			bool useCache;
+			rsgis::math::RSGISBaysianStatsCache *statsCache;
+			std::mutex statsMutex;
 		};	
 }}
 #endif
@@ -24,7 +24,7 @@
 
 namespace rsgis{namespace img{
 	
-	RSGISImageCalcValueBaysianPrior::RSGISImageCalcValueBaysianPrior(int numberOutBands, rsgis::math::RSGISMathFunction *function, rsgis::math::RSGISProbDistro *probDistro, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, rsgis::math::deltatypedef deltatype) : RSGISCalcImageValue(numberOutBands)
+	RSGISImageCalcValueBaysianPrior::RSGISImageCalcValueBaysianPrior(int numberOutBands, rsgis::math::RSGISMathFunction *function, rsgis::math::RSGISProbDistro *probDistro, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, rsgis::math::deltatypedef deltatype, bool useCache, double cacheTolerance, size_t maxCacheEntries) : RSGISCalcImageValue(numberOutBands)
 	{
 		this->function = function;
 		this->probDistro = probDistro;
@@ -35,6 +35,12 @@ namespace rsgis{namespace img{
 		this->upperLimit = upperLimit;
 		this->lowerLimit = lowerLimit;
 		this->deltatype = deltatype;
+		this->useCache = useCache;
+		this->statsCache = NULL;
+		if(useCache)
+		{
+			this->statsCache = new rsgis::math::RSGISBaysianStatsCache(cacheTolerance, maxCacheEntries);
+		}
 		baysianStats = new rsgis::math::RSGISBaysianStatsPrior(function, probDistro, variance, interval, minVal, maxVal, upperLimit, lowerLimit, deltatype);
 		std::cout << "Delta type " << deltatype << std::endl;
 	}
@@ -42,7 +48,20 @@ namespace rsgis{namespace img{
 	void RSGISImageCalcValueBaysianPrior::calcImageValue(float *bandValues, int numBands, double *output) 
 	{
 		
-		outputVals = baysianStats->calcImageValuePrior(bandValues[0]);
+		double outputVals[3];
+		if(this->useCache)
+		{
+			float value = this->statsCache->binValue(bandValues[0]);
+			if(!this->statsCache->lookup(value, outputVals))
+			{
+				this->calcPosterior(value, outputVals);
+				this->statsCache->insert(value, outputVals);
+			}
+		}
+		else
+		{
+			this->calcPosterior(bandValues[0], outputVals);
+		}
 		
 		output[1] = outputVals[0]; // Maximum Likelyhood Value
 		output[0] = outputVals[1]; // Lower value
@@ -51,11 +70,25 @@ namespace rsgis{namespace img{
 		// Calculate delta- and delta +
 		output[3] = sqrt((output[1] - output[0])*(output[1] - output[0]));
 		output[4] = sqrt((output[2] - output[1])*(output[2] - output[1]));	
-		delete[] outputVals;
+	}
+	
+	void RSGISImageCalcValueBaysianPrior::calcPosterior(float value, double *outVals)
+	{
+		// The integration function holds the current value so is not thread safe.
+		std::lock_guard<std::mutex> lock(this->statsMutex);
+		double *vals = baysianStats->calcImageValuePrior(value);
+		outVals[0] = vals[0];
+		outVals[1] = vals[1];
+		outVals[2] = vals[2];
+		delete[] vals;
 	}
 	
 	RSGISImageCalcValueBaysianPrior::~RSGISImageCalcValueBaysianPrior()
 	{
 		delete baysianStats;
+		if(this->statsCache != NULL)
+		{
+			delete this->statsCache;
+		}
 	}
 }}
@@ -24,6 +24,7 @@
 #define RSGISImageCalcValueBaysianPrior_H
 
 #include <iostream>
+#include <mutex>
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISImageBandException.h"
@@ -31,6 +32,7 @@
 #include "math/RSGISBaysianStatsPrior.h"
 #include "math/RSGISBaysianStatsException.h"
 #include "math/RSGISBaysianDeltaType.h"
+#include "math/RSGISBaysianStatsCache.h"
 #include "math/RSGISProbDistro.h"
 #include "common/RSGISImageException.h"
 
@@ -50,13 +52,20 @@
 #endif
 
 namespace rsgis{namespace img{
+	/**
+	 * If useCache the posterior summary is calculated once per distinct input
+	 * value (or per bin of width cacheTolerance, if greater than zero) and
+	 * reused. Once maxCacheEntries values are cached, other values are
+	 * calculated directly.
+	 */
 	class DllExport RSGISImageCalcValueBaysianPrior	: public RSGISCalcImageValue
 		{
 		public:
-			RSGISImageCalcValueBaysianPrior(int numberOutBands, rsgis::math::RSGISMathFunction *function, rsgis::math::RSGISProbDistro *probDistro, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, rsgis::math::deltatypedef deltatype);
+			RSGISImageCalcValueBaysianPrior(int numberOutBands, rsgis::math::RSGISMathFunction *function, rsgis::math::RSGISProbDistro *probDistro, double variance, double interval, double minVal, double maxVal, double lowerLimit, double upperLimit, rsgis::math::deltatypedef deltatype, bool useCache=true, double cacheTolerance=0.0, size_t maxCacheEntries=1048576);
 			void calcImageValue(float *bandValues, int numBands, double *output);
 			~RSGISImageCalcValueBaysianPrior();
 		protected:
+			void calcPosterior(float value, double *outVals);
 			rsgis::math::RSGISMathFunction *function;
 			rsgis::math::RSGISProbDistro *probDistro;
 			double variance;
@@ -65,9 +74,11 @@ namespace rsgis{namespace img{
 			double maxVal;
 			double upperLimit;
 			double lowerLimit;
-			double* outputVals;
 			rsgis::math::deltatypedef deltatype;
 			rsgis::math::RSGISBaysianStatsPrior *baysianStats;
+			bool useCache;
+			rsgis::math::RSGISBaysianStatsCache *statsCache;
+			std::mutex statsMutex;
 		};	
 }}
 #endif
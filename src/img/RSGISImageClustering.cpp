@@ -26,9 +26,12 @@
 namespace rsgis{namespace img{
     
 
-    RSGISImageClustering::RSGISImageClustering()
+    RSGISImageClustering::RSGISImageClustering(RSGISImgSampleMethod sampleMethod, unsigned long numSamples, unsigned int rndSeed, unsigned int numThreads)
     {
-        
+        this->sampleMethod = sampleMethod;
+        this->numSamples = numSamples;
+        this->rndSeed = rndSeed;
+        this->numThreads = numThreads;
     }
         
     void RSGISImageClustering::findKMeansCentres(GDALDataset *dataset, std::string outputMatrix, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, rsgis::math::InitClustererMethods initMethod)
@@ -37,27 +40,16 @@ namespace rsgis{namespace img{
         {
             unsigned int numImgBands = dataset->GetRasterCount();
             std::cout << "Subsampling the image to read into memory\n";
-            std::vector< std::vector<float> > *pxlValues = this->sampleImage(dataset, subSample, ignoreZeros);
+            RSGISImagePxlSamples pxlValues;
+            this->sampleImage(dataset, subSample, ignoreZeros, &pxlValues);
+            std::cout << "Sampled " << pxlValues.numPts << " pixels\n";
             
             std::cout << "Performing clustering\n";
             rsgis::math::RSGISKMeansClusterer clusterer(initMethod);
-            std::vector< rsgis::math::RSGISClusterCentre > *clusterCentres = clusterer.calcClusterCentres(pxlValues, numImgBands, numClusters, maxNumIterations, degreeOfChange);
+            std::vector< rsgis::math::RSGISClusterCentre > *clusterCentres = clusterer.calcClusterCentres(pxlValues.getView(), numClusters, maxNumIterations, degreeOfChange);
             
             std::cout << "Exporting cluster centres to output file\n";
-            rsgis::math::RSGISMatrices matrixUtils;
-            rsgis::math::Matrix *clusterMatrix = matrixUtils.createMatrix(numImgBands, clusterCentres->size());
-            unsigned int matrixIdx = 0;
-            for(unsigned int i = 0; i < clusterCentres->size(); ++i)
-            {
-                for(unsigned int j = 0; j < numImgBands; ++j)
-                {
-                    matrixIdx = (j*clusterCentres->size())+i;
-                    clusterMatrix->matrix[matrixIdx] = clusterCentres->at(i).centre[j];
-                }
-            }
-            matrixUtils.saveMatrix2GridTxt(clusterMatrix, outputMatrix);
-            matrixUtils.freeMatrix(clusterMatrix);
-            delete pxlValues;
+            this->exportClusterCentres(clusterCentres, numImgBands, outputMatrix);
             delete clusterCentres;
         }
         catch (rsgis::RSGISImageException &e) 
@@ -77,27 +69,16 @@ namespace rsgis{namespace img{
         {
             unsigned int numImgBands = dataset->GetRasterCount();
             std::cout << "Subsampling the image to read into memory\n";
-            std::vector< std::vector<float> > *pxlValues = this->sampleImage(dataset, subSample, ignoreZeros);
+            RSGISImagePxlSamples pxlValues;
+            this->sampleImage(dataset, subSample, ignoreZeros, &pxlValues);
+            std::cout << "Sampled " << pxlValues.numPts << " pixels\n";
             
             std::cout << "Performing clustering\n";
             rsgis::math::RSGISISODataClusterer clusterer(initMethod, minDistBetweenClusters, minNumFeatures, maxStdDev, minNumClusters, startIteration, endIteration);
-            std::vector< rsgis::math::RSGISClusterCentre > *clusterCentres = clusterer.calcClusterCentres(pxlValues, dataset->GetRasterCount(), numClusters, maxNumIterations, degreeOfChange);
+            std::vector< rsgis::math::RSGISClusterCentre > *clusterCentres = clusterer.calcClusterCentres(pxlValues.getView(), numClusters, maxNumIterations, degreeOfChange);
             
             std::cout << "Exporting cluster centres to output file\n";
-            rsgis::math::RSGISMatrices matrixUtils;
-            rsgis::math::Matrix *clusterMatrix = matrixUtils.createMatrix(numImgBands, clusterCentres->size());
-            unsigned int matrixIdx = 0;
-            for(unsigned int i = 0; i < clusterCentres->size(); ++i)
-            {
-                for(unsigned int j = 0; j < numImgBands; ++j)
-                {
-                    matrixIdx = (j*clusterCentres->size())+i;
-                    clusterMatrix->matrix[matrixIdx] = clusterCentres->at(i).centre[j];
-                }
-            }
-            matrixUtils.saveMatrix2GridTxt(clusterMatrix, outputMatrix);
-            matrixUtils.freeMatrix(clusterMatrix);
-            delete pxlValues;
+            this->exportClusterCentres(clusterCentres, numImgBands, outputMatrix);
             delete clusterCentres;
         }
         catch (rsgis::RSGISImageException &e) 
@@ -111,74 +92,27 @@ namespace rsgis{namespace img{
     }
     
     
-    std::vector< std::vector<float> >* RSGISImageClustering::sampleImage(GDALDataset *dataset, unsigned int subSample, bool ignoreZeros)
+    void RSGISImageClustering::sampleImage(GDALDataset *dataset, unsigned int subSample, bool ignoreZeros, RSGISImagePxlSamples *samples)
     {
-        std::vector< std::vector<float> > *pxlValues = new std::vector< std::vector<float> >();
-        
-        unsigned int numImgBands = dataset->GetRasterCount();
-        
-        unsigned int width = dataset->GetRasterXSize();
-        unsigned int height = dataset->GetRasterYSize();
-        
-        float **dataRow = new float*[numImgBands];
-        GDALRasterBand **bands = new GDALRasterBand*[numImgBands];
-        for(unsigned n = 0; n < numImgBands; ++n)
-        {
-            bands[n] = dataset->GetRasterBand(n+1);
-            dataRow[n] = new float[width];
-        }
-        
-        bool nonZeroFound = false;
-        unsigned long pxlCount = 0;
-        for(unsigned int i = 0; i < height; ++i)
+        RSGISImageSampler sampler(this->sampleMethod, subSample, this->numSamples, ignoreZeros, this->rndSeed, this->numThreads);
+        sampler.sampleImage(dataset, samples);
+    }
+    
+    void RSGISImageClustering::exportClusterCentres(std::vector< rsgis::math::RSGISClusterCentre > *clusterCentres, unsigned int numImgBands, std::string outputMatrix)
+    {
+        rsgis::math::RSGISMatrices matrixUtils;
+        rsgis::math::Matrix *clusterMatrix = matrixUtils.createMatrix(numImgBands, clusterCentres->size());
+        unsigned int matrixIdx = 0;
+        for(unsigned int i = 0; i < clusterCentres->size(); ++i)
         {
-            for(unsigned n = 0; n < numImgBands; ++n)
-            {
-                bands[n]->RasterIO(GF_Read, 0, i, width, 1, dataRow[n], width, 1, GDT_Float32, 0, 0);
-            }
-            
-            for(unsigned int j = 0; j < width; ++j)
+            for(unsigned int j = 0; j < numImgBands; ++j)
             {
-                if((pxlCount % subSample) == 0)
-                {
-                    nonZeroFound = false;
-                    std::vector<float> col;
-                    col.reserve(numImgBands);
-                    for(unsigned n = 0; n < numImgBands; ++n)
-                    {
-                        col.push_back(dataRow[n][j]);
-                        if(dataRow[n][j] != 0)
-                        {
-                            nonZeroFound = true;
-                        }
-                    }
-                    
-                    if(ignoreZeros)
-                    {
-                        if(nonZeroFound)
-                        {
-                            pxlValues->push_back(col);
-                        }
-                    }
-                    else
-                    {
-                        pxlValues->push_back(col);
-                    }
-                }
-                
-                ++pxlCount;
+                matrixIdx = (j*clusterCentres->size())+i;
+                clusterMatrix->matrix[matrixIdx] = clusterCentres->at(i).centre[j];
             }
         }
-        
-        for(unsigned n = 0; n < numImgBands; ++n)
-        {
-            delete[] dataRow[n];
-        }
-        delete[] dataRow;
-        
-        delete[] bands;
-        
-        return pxlValues;
+        matrixUtils.saveMatrix2GridTxt(clusterMatrix, outputMatrix);
+        matrixUtils.freeMatrix(clusterMatrix);
     }
         
     RSGISImageClustering::~RSGISImageClustering()
@@ -33,6 +33,8 @@
 #include "math/RSGISClustererException.h"
 #include "math/RSGISMatrices.h"
 
+#include "img/RSGISImageSampler.h"
+
 #include "gdal_priv.h"
 #include "ogrsf_frmts.h"
 #include "ogr_api.h"
@@ -55,11 +57,17 @@ namespace rsgis{namespace img{
     class DllExport RSGISImageClustering
     {
     public:
-        RSGISImageClustering();
+        RSGISImageClustering(RSGISImgSampleMethod sampleMethod=rsgis_imgsample_stride, unsigned long numSamples=0, unsigned int rndSeed=0, unsigned int numThreads=0);
         void findKMeansCentres(GDALDataset *dataset, std::string outputMatrix, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, rsgis::math::InitClustererMethods initMethod);
         void findISODataCentres(GDALDataset *dataset, std::string outputMatrix, unsigned int numClusters, unsigned int maxNumIterations, unsigned int subSample, bool ignoreZeros, float degreeOfChange, rsgis::math::InitClustererMethods initMethod, float minDistBetweenClusters, unsigned int minNumFeatures, float maxStdDev, unsigned int minNumClusters, unsigned int startIteration, unsigned int endIteration);
-        std::vector< std::vector<float> >* sampleImage(GDALDataset *dataset, unsigned int subSample, bool ignoreZeros);
+        void sampleImage(GDALDataset *dataset, unsigned int subSample, bool ignoreZeros, RSGISImagePxlSamples *samples);
         ~RSGISImageClustering();
+    protected:
+        void exportClusterCentres(std::vector< rsgis::math::RSGISClusterCentre > *clusterCentres, unsigned int numImgBands, std::string outputMatrix);
+        RSGISImgSampleMethod sampleMethod;
+        unsigned long numSamples;
+        unsigned int rndSeed;
+        unsigned int numThreads;
     };
     
 }}
@@ -0,0 +1,780 @@
+/*
+ *  RSGISImageFootprintIndex.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISImageFootprintIndex.h"
+
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace rsgis{namespace img{
+
+    static const char RSGIS_FOOTPRINT_IDX_MAGIC[8] = {'R','S','G','I','S','F','P','I'};
+    static const uint32_t RSGIS_FOOTPRINT_IDX_VERSION = 1;
+
+    RSGISImageFootprintIndex::RSGISImageFootprintIndex()
+    {
+        this->data = NULL;
+        this->dataSize = 0;
+        this->header = NULL;
+        this->idxImages = NULL;
+        this->idxNodes = NULL;
+        this->pathOrder = NULL;
+        this->strings = NULL;
+    }
+
+    void RSGISImageFootprintIndex::openIndex(std::string indexFile)
+    {
+        this->closeIndex();
+#ifdef _WIN32
+        std::ifstream idxStream(indexFile.c_str(), std::ios::in | std::ios::binary);
+        if(!idxStream.is_open())
+        {
+            throw RSGISImageException("Could not open the footprint index: " + indexFile);
+        }
+        idxStream.seekg(0, std::ios::end);
+        this->dataSize = idxStream.tellg();
+        idxStream.seekg(0, std::ios::beg);
+        this->dataBuffer.resize(this->dataSize);
+        idxStream.read(this->dataBuffer.data(), this->dataSize);
+        idxStream.close();
+        this->data = this->dataBuffer.data();
+#else
+        int fd = open(indexFile.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            throw RSGISImageException("Could not open the footprint index: " + indexFile);
+        }
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) != 0)
+        {
+            ::close(fd);
+            throw RSGISImageException("Could not read the size of the footprint index: " + indexFile);
+        }
+        this->dataSize = fileStat.st_size;
+        if(this->dataSize >= sizeof(RSGISFootprintIdxHeader))
+        {
+            void *mapped = mmap(NULL, this->dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapped == MAP_FAILED)
+            {
+                ::close(fd);
+                throw RSGISImageException("Could not memory map the footprint index: " + indexFile);
+            }
+            this->data = (const char*)mapped;
+        }
+        ::close(fd);
+#endif
+        if((this->data == NULL) || (this->dataSize < sizeof(RSGISFootprintIdxHeader)))
+        {
+            this->closeIndex();
+            throw RSGISImageException("The file is not a footprint index: " + indexFile);
+        }
+
+        this->header = (const RSGISFootprintIdxHeader*)this->data;
+        if((std::memcmp(this->header->magic, RSGIS_FOOTPRINT_IDX_MAGIC, 8) != 0) || (this->header->version != RSGIS_FOOTPRINT_IDX_VERSION))
+        {
+            this->closeIndex();
+            throw RSGISImageException("The file is not a footprint index (or is an unsupported version): " + indexFile);
+        }
+        if((this->header->imagesOffset + this->header->numImages * sizeof(RSGISFootprintIdxImage) > this->dataSize) ||
+           (this->header->nodesOffset + this->header->numNodes * sizeof(RSGISFootprintIdxNode) > this->dataSize) ||
+           (this->header->pathOrderOffset + this->header->numImages * sizeof(uint64_t) > this->dataSize) ||
+           (this->header->stringsOffset + this->header->stringsSize > this->dataSize))
+        {
+            this->closeIndex();
+            throw RSGISImageException("The footprint index is truncated: " + indexFile);
+        }
+        this->idxImages = (const RSGISFootprintIdxImage*)(this->data + this->header->imagesOffset);
+        this->idxNodes = (const RSGISFootprintIdxNode*)(this->data + this->header->nodesOffset);
+        this->pathOrder = (const uint64_t*)(this->data + this->header->pathOrderOffset);
+        this->strings = this->data + this->header->stringsOffset;
+    }
+
+    void RSGISImageFootprintIndex::closeIndex()
+    {
+#ifndef _WIN32
+        if(this->data != NULL)
+        {
+            munmap((void*)this->data, this->dataSize);
+        }
+#endif
+        this->dataBuffer.clear();
+        this->dataBuffer.shrink_to_fit();
+        this->data = NULL;
+        this->dataSize = 0;
+        this->header = NULL;
+        this->idxImages = NULL;
+        this->idxNodes = NULL;
+        this->pathOrder = NULL;
+        this->strings = NULL;
+    }
+
+    size_t RSGISImageFootprintIndex::getNumImages() const
+    {
+        if(this->header == NULL)
+        {
+            throw RSGISImageException("The footprint index is not open.");
+        }
+        return this->header->numImages;
+    }
+
+    int RSGISImageFootprintIndex::getIndexEPSG() const
+    {
+        if(this->header == NULL)
+        {
+            throw RSGISImageException("The footprint index is not open.");
+        }
+        return this->header->idxEPSG;
+    }
+
+    void RSGISImageFootprintIndex::query(double minX, double maxX, double minY, double maxY, std::vector<size_t> *idxs) const
+    {
+        if(this->header == NULL)
+        {
+            throw RSGISImageException("The footprint index is not open.");
+        }
+        idxs->clear();
+        if(this->header->numNodes == 0)
+        {
+            return;
+        }
+
+        std::vector<uint64_t> nodeStack;
+        nodeStack.push_back(this->header->numNodes-1);
+        while(!nodeStack.empty())
+        {
+            uint64_t nodeIdx = nodeStack.back();
+            const RSGISFootprintIdxNode &node = this->idxNodes[nodeIdx];
+            nodeStack.pop_back();
+            if((node.bbox[0] > maxX) || (node.bbox[1] < minX) || (node.bbox[2] > maxY) || (node.bbox[3] < minY))
+            {
+                continue;
+            }
+            // The children of a node are images or nodes written before it, so anything else is a corrupt index.
+            uint64_t numEntries = node.leaf?this->header->numImages:nodeIdx;
+            if((node.first > numEntries) || (node.count > (numEntries - node.first)))
+            {
+                throw RSGISImageException("The footprint index is corrupt (a node refers to entries outside the index).");
+            }
+            for(uint64_t i = node.first; i < node.first+node.count; ++i)
+            {
+                if(node.leaf)
+                {
+                    const double *imgBBOX = this->idxImages[i].bbox;
+                    if((imgBBOX[0] <= maxX) && (imgBBOX[1] >= minX) && (imgBBOX[2] <= maxY) && (imgBBOX[3] >= minY))
+                    {
+                        idxs->push_back(i);
+                    }
+                }
+                else
+                {
+                    nodeStack.push_back(i);
+                }
+            }
+        }
+        std::sort(idxs->begin(), idxs->end());
+    }
+
+    const RSGISImageFootprintIndex::RSGISFootprintIdxImage* RSGISImageFootprintIndex::getIdxImage(size_t idx) const
+    {
+        if(this->header == NULL)
+        {
+            throw RSGISImageException("The footprint index is not open.");
+        }
+        if(idx >= this->header->numImages)
+        {
+            throw RSGISImageException("The image index is not within the footprint index.");
+        }
+        return &this->idxImages[idx];
+    }
+
+    std::string RSGISImageFootprintIndex::getString(uint64_t offset, uint32_t len) const
+    {
+        if(offset + len > this->header->stringsSize)
+        {
+            throw RSGISImageException("The footprint index strings are corrupt.");
+        }
+        return std::string(this->strings + offset, len);
+    }
+
+    RSGISImageFootprint RSGISImageFootprintIndex::getFootprint(size_t idx) const
+    {
+        const RSGISFootprintIdxImage *idxImage = this->getIdxImage(idx);
+        RSGISImageFootprint footprint;
+        footprint.imageFile = this->getString(idxImage->pathOffset, idxImage->pathLen);
+        for(int i = 0; i < 4; ++i)
+        {
+            footprint.bbox[i] = idxImage->bbox[i];
+        }
+        footprint.numBands = idxImage->numBands;
+        footprint.xSize = idxImage->xSize;
+        footprint.ySize = idxImage->ySize;
+        footprint.hasNoData = idxImage->hasNoData != 0;
+        footprint.noDataVal = idxImage->noDataVal;
+        footprint.validPxlFrac = idxImage->validPxlFrac;
+        footprint.validNoDataVal = idxImage->validNoDataVal;
+        footprint.crsWKT = this->getString(idxImage->crsOffset, idxImage->crsLen);
+        footprint.modTime = idxImage->modTime;
+        footprint.fileSize = idxImage->fileSize;
+        return footprint;
+    }
+
+    long long RSGISImageFootprintIndex::findImage(std::string imageFile) const
+    {
+        if(this->header == NULL)
+        {
+            throw RSGISImageException("The footprint index is not open.");
+        }
+        // Binary search of the images sorted by path.
+        uint64_t low = 0;
+        uint64_t high = this->header->numImages;
+        while(low < high)
+        {
+            uint64_t mid = low + (high - low) / 2;
+            const RSGISFootprintIdxImage &idxImage = this->idxImages[this->pathOrder[mid]];
+            int cmp = imageFile.compare(0, std::string::npos, this->strings + idxImage.pathOffset, idxImage.pathLen);
+            if(cmp == 0)
+            {
+                return this->pathOrder[mid];
+            }
+            else if(cmp > 0)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        return -1;
+    }
+
+    void RSGISImageFootprintIndex::getAllFootprints(std::vector<RSGISImageFootprint> *footprints) const
+    {
+        size_t numImages = this->getNumImages();
+        footprints->clear();
+        footprints->reserve(numImages);
+        for(size_t i = 0; i < numImages; ++i)
+        {
+            footprints->push_back(this->getFootprint(i));
+        }
+    }
+
+    void RSGISImageFootprintIndex::createIndex(std::vector<std::string> images, std::string indexFile, int idxEPSG, bool calcValidFrac, bool useNoDataVal, float noDataVal)
+    {
+        std::vector<RSGISImageFootprint> footprints;
+        footprints.reserve(images.size());
+        rsgis_tqdm pbar;
+        for(size_t i = 0; i < images.size(); ++i)
+        {
+            footprints.push_back(RSGISImageFootprintIndex::readImageFootprint(images.at(i), idxEPSG, calcValidFrac, useNoDataVal, noDataVal));
+            pbar.progress(i+1, images.size());
+        }
+        pbar.finish();
+
+        if(idxEPSG == 0)
+        {
+            RSGISImageFootprintIndex::checkProjections(footprints);
+        }
+        RSGISImageFootprintIndex::writeIndex(footprints, indexFile, idxEPSG);
+    }
+
+    size_t RSGISImageFootprintIndex::updateIndex(std::string indexFile, std::vector<std::string> images, bool removeMissing, bool calcValidFrac, bool useNoDataVal, float noDataVal)
+    {
+        std::vector<RSGISImageFootprint> footprints;
+        int idxEPSG = 0;
+        {
+            RSGISImageFootprintIndex footprintIdx;
+            footprintIdx.openIndex(indexFile);
+            footprintIdx.getAllFootprints(&footprints);
+            idxEPSG = footprintIdx.getIndexEPSG();
+            footprintIdx.closeIndex();
+        }
+
+        std::vector<RSGISImageFootprint> outFootprints;
+        std::map<std::string, size_t> footprintLUT;
+        long long modTime = 0;
+        unsigned long long fileSize = 0;
+        for(std::vector<RSGISImageFootprint>::iterator iterFP = footprints.begin(); iterFP != footprints.end(); ++iterFP)
+        {
+            if(removeMissing && !RSGISImageFootprintIndex::statImage((*iterFP).imageFile, &modTime, &fileSize))
+            {
+                continue;
+            }
+            footprintLUT[(*iterFP).imageFile] = outFootprints.size();
+            outFootprints.push_back(*iterFP);
+        }
+
+        size_t numRead = 0;
+        rsgis_tqdm pbar;
+        for(size_t i = 0; i < images.size(); ++i)
+        {
+            std::map<std::string, size_t>::iterator iterLUT = footprintLUT.find(images.at(i));
+            if(iterLUT == footprintLUT.end())
+            {
+                footprintLUT[images.at(i)] = outFootprints.size();
+                outFootprints.push_back(RSGISImageFootprintIndex::readImageFootprint(images.at(i), idxEPSG, calcValidFrac, useNoDataVal, noDataVal));
+                ++numRead;
+            }
+            else
+            {
+                RSGISImageFootprint &footprint = outFootprints.at(iterLUT->second);
+                if(!RSGISImageFootprintIndex::footprintCurrent(footprint) || (calcValidFrac && !RSGISImageFootprintIndex::validFracCurrent(footprint, useNoDataVal, noDataVal)))
+                {
+                    footprint = RSGISImageFootprintIndex::readImageFootprint(images.at(i), idxEPSG, calcValidFrac, useNoDataVal, noDataVal);
+                    ++numRead;
+                }
+            }
+            pbar.progress(i+1, images.size());
+        }
+        pbar.finish();
+
+        if(idxEPSG == 0)
+        {
+            RSGISImageFootprintIndex::checkProjections(outFootprints);
+        }
+        RSGISImageFootprintIndex::writeIndex(outFootprints, indexFile, idxEPSG);
+        return numRead;
+    }
+
+    RSGISImageFootprint RSGISImageFootprintIndex::readImageFootprint(std::string imageFile, int idxEPSG, bool calcValidFrac, bool useNoDataVal, float noDataVal)
+    {
+        RSGISImageFootprint footprint;
+        footprint.imageFile = imageFile;
+        if(!RSGISImageFootprintIndex::statImage(imageFile, &footprint.modTime, &footprint.fileSize))
+        {
+            throw RSGISImageException("Could not find the image: " + imageFile);
+        }
+
+        GDALDataset *dataset = (GDALDataset *) GDALOpen(imageFile.c_str(), GA_ReadOnly);
+        if(dataset == NULL)
+        {
+            std::string message = std::string("Could not open image ") + imageFile;
+            throw RSGISImageException(message.c_str());
+        }
+
+        OGRCoordinateTransformation *transform = NULL;
+        try
+        {
+            footprint.numBands = dataset->GetRasterCount();
+            footprint.xSize = dataset->GetRasterXSize();
+            footprint.ySize = dataset->GetRasterYSize();
+            footprint.hasNoData = false;
+            footprint.noDataVal = 0.0;
+            if(footprint.numBands > 0)
+            {
+                int hasNoData = false;
+                footprint.noDataVal = dataset->GetRasterBand(1)->GetNoDataValue(&hasNoData);
+                footprint.hasNoData = hasNoData;
+            }
+            footprint.crsWKT = std::string(dataset->GetProjectionRef());
+
+            double trans[6];
+            dataset->GetGeoTransform(trans);
+
+            // The outline of the image, densified if it is to be reprojected.
+            unsigned int nEdgePts = 1;
+            if(idxEPSG != 0)
+            {
+                OGRSpatialReference imgSpatRef;
+                if(imgSpatRef.importFromWkt(footprint.crsWKT.c_str()) != OGRERR_NONE)
+                {
+                    throw RSGISImageException("Could not read the projection of the image: " + imageFile);
+                }
+                OGRSpatialReference idxSpatRef;
+                if(idxSpatRef.importFromEPSG(idxEPSG) != OGRERR_NONE)
+                {
+                    throw RSGISImageException("Could not create the projection for the index EPSG code.");
+                }
+                imgSpatRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+                idxSpatRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+                if(!imgSpatRef.IsSame(&idxSpatRef))
+                {
+                    transform = OGRCreateCoordinateTransformation(&imgSpatRef, &idxSpatRef);
+                    if(transform == NULL)
+                    {
+                        throw RSGISImageException("Could not create a transformation from the image to the index projection: " + imageFile);
+                    }
+                    nEdgePts = 20;
+                }
+            }
+
+            std::vector<double> xPts;
+            std::vector<double> yPts;
+            const double cornerPxls[4][2] = {{0, 0}, {(double)footprint.xSize, 0}, {(double)footprint.xSize, (double)footprint.ySize}, {0, (double)footprint.ySize}};
+            for(int c = 0; c < 4; ++c)
+            {
+                const double *startPxl = cornerPxls[c];
+                const double *endPxl = cornerPxls[(c+1)%4];
+                for(unsigned int n = 0; n < nEdgePts; ++n)
+                {
+                    double frac = ((double)n) / nEdgePts;
+                    double pxlX = startPxl[0] + (endPxl[0] - startPxl[0]) * frac;
+                    double pxlY = startPxl[1] + (endPxl[1] - startPxl[1]) * frac;
+                    xPts.push_back(trans[0] + pxlX * trans[1] + pxlY * trans[2]);
+                    yPts.push_back(trans[3] + pxlX * trans[4] + pxlY * trans[5]);
+                }
+            }
+            if(transform != NULL)
+            {
+                if(!transform->Transform(xPts.size(), xPts.data(), yPts.data()))
+                {
+                    throw RSGISImageException("Could not transform the image footprint to the index projection: " + imageFile);
+                }
+                OGRCoordinateTransformation::DestroyCT(transform);
+                transform = NULL;
+            }
+            footprint.bbox[0] = *std::min_element(xPts.begin(), xPts.end());
+            footprint.bbox[1] = *std::max_element(xPts.begin(), xPts.end());
+            footprint.bbox[2] = *std::min_element(yPts.begin(), yPts.end());
+            footprint.bbox[3] = *std::max_element(yPts.begin(), yPts.end());
+
+            footprint.validPxlFrac = -1;
+            footprint.validNoDataVal = 0.0;
+            if(calcValidFrac)
+            {
+                if(useNoDataVal || footprint.hasNoData)
+                {
+                    footprint.validNoDataVal = useNoDataVal?noDataVal:((float)footprint.noDataVal);
+                    footprint.validPxlFrac = RSGISImageFootprintIndex::calcValidPxlFraction(dataset, footprint.validNoDataVal);
+                }
+                else
+                {
+                    // Without a no data value all the pixels are valid (NaN so it is not reused for a given no data value).
+                    footprint.validPxlFrac = 1.0;
+                    footprint.validNoDataVal = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+        }
+        catch(RSGISImageException &e)
+        {
+            if(transform != NULL)
+            {
+                OGRCoordinateTransformation::DestroyCT(transform);
+            }
+            GDALClose(dataset);
+            throw e;
+        }
+        GDALClose(dataset);
+        return footprint;
+    }
+
+    double RSGISImageFootprintIndex::calcValidPxlFraction(GDALDataset *dataset, float noDataVal)
+    {
+        RSGISImageValidDataMetric validPxlCountObj;
+        validPxlCountObj.totalNumPxls = 0;
+        validPxlCountObj.validPxlCount = 0;
+        validPxlCountObj.noDataPxlCount = 0;
+        RSGISCountValidPixels calcImageValidPxlCount(&validPxlCountObj, noDataVal);
+        RSGISCalcImage calcImg = RSGISCalcImage(&calcImageValidPxlCount, "", true);
+        calcImg.calcImage(&dataset, 1);
+        if(validPxlCountObj.totalNumPxls == 0)
+        {
+            return 0.0;
+        }
+        return ((double)validPxlCountObj.validPxlCount) / ((double)validPxlCountObj.totalNumPxls);
+    }
+
+    bool RSGISImageFootprintIndex::footprintCurrent(const RSGISImageFootprint &footprint)
+    {
+        long long modTime = 0;
+        unsigned long long fileSize = 0;
+        if(!RSGISImageFootprintIndex::statImage(footprint.imageFile, &modTime, &fileSize))
+        {
+            return false;
+        }
+        return (modTime == footprint.modTime) && (fileSize == footprint.fileSize);
+    }
+
+    bool RSGISImageFootprintIndex::validFracCurrent(const RSGISImageFootprint &footprint, bool useNoDataVal, float noDataVal)
+    {
+        if(footprint.validPxlFrac < 0)
+        {
+            return false;
+        }
+        if(useNoDataVal)
+        {
+            return ((float)footprint.validNoDataVal) == noDataVal;
+        }
+        if(footprint.hasNoData)
+        {
+            return ((float)footprint.validNoDataVal) == ((float)footprint.noDataVal);
+        }
+        return true;
+    }
+
+    bool RSGISImageFootprintIndex::statImage(std::string imageFile, long long *modTime, unsigned long long *fileSize)
+    {
+        VSIStatBufL statBuf;
+        if(VSIStatL(imageFile.c_str(), &statBuf) != 0)
+        {
+            return false;
+        }
+        *modTime = statBuf.st_mtime;
+        *fileSize = statBuf.st_size;
+        return true;
+    }
+
+    void RSGISImageFootprintIndex::checkProjections(const std::vector<RSGISImageFootprint> &footprints)
+    {
+        if(footprints.empty())
+        {
+            return;
+        }
+        OGRSpatialReference baseSpatRef;
+        baseSpatRef.importFromWkt(footprints.at(0).crsWKT.c_str());
+        // Only compare each distinct projection string once.
+        std::map<std::string, bool> checkedWKT;
+        checkedWKT[footprints.at(0).crsWKT] = true;
+        for(std::vector<RSGISImageFootprint>::const_iterator iterFP = footprints.begin(); iterFP != footprints.end(); ++iterFP)
+        {
+            if(checkedWKT.count((*iterFP).crsWKT) > 0)
+            {
+                continue;
+            }
+            OGRSpatialReference imgSpatRef;
+            imgSpatRef.importFromWkt((*iterFP).crsWKT.c_str());
+            if(!imgSpatRef.IsSame(&baseSpatRef))
+            {
+                throw RSGISImageException("The projections of the images do not match, specify an EPSG code for the index. (Base: '" + footprints.at(0).imageFile + "', Img: '" + (*iterFP).imageFile + "')");
+            }
+            checkedWKT[(*iterFP).crsWKT] = true;
+        }
+    }
+
+    std::vector<size_t> RSGISImageFootprintIndex::strOrder(const std::vector<double> &boxes, unsigned int nodeCapacity)
+    {
+        size_t numBoxes = boxes.size() / 4;
+        std::vector<size_t> order(numBoxes);
+        for(size_t i = 0; i < numBoxes; ++i)
+        {
+            order[i] = i;
+        }
+        if(numBoxes <= nodeCapacity)
+        {
+            return order;
+        }
+
+        // Sort by the centre x into vertical slices of sqrt(numNodes) nodes, then each slice by the centre y.
+        size_t numNodes = (numBoxes + nodeCapacity - 1) / nodeCapacity;
+        size_t numSlices = (size_t)std::ceil(std::sqrt((double)numNodes));
+        size_t sliceSize = ((numNodes + numSlices - 1) / numSlices) * nodeCapacity;
+        std::sort(order.begin(), order.end(), [&boxes](size_t a, size_t b){
+            return (boxes[a*4] + boxes[a*4+1]) < (boxes[b*4] + boxes[b*4+1]);
+        });
+        for(size_t s = 0; s < numBoxes; s += sliceSize)
+        {
+            std::vector<size_t>::iterator sliceEnd = order.begin() + std::min(s + sliceSize, numBoxes);
+            std::sort(order.begin() + s, sliceEnd, [&boxes](size_t a, size_t b){
+                return (boxes[a*4+2] + boxes[a*4+3]) < (boxes[b*4+2] + boxes[b*4+3]);
+            });
+        }
+        return order;
+    }
+
+    void RSGISImageFootprintIndex::writeIndex(std::vector<RSGISImageFootprint> &footprints, std::string indexFile, int idxEPSG, unsigned int nodeCapacity)
+    {
+        if(nodeCapacity < 2)
+        {
+            throw RSGISImageException("The node capacity of the footprint index must be at least 2.");
+        }
+        size_t numImages = footprints.size();
+
+        // Order the images so each leaf is a contiguous range.
+        std::vector<double> boxes(numImages*4);
+        for(size_t i = 0; i < numImages; ++i)
+        {
+            std::copy(footprints[i].bbox, footprints[i].bbox+4, boxes.begin()+i*4);
+        }
+        std::vector<size_t> order = RSGISImageFootprintIndex::strOrder(boxes, nodeCapacity);
+        std::vector<RSGISImageFootprint> orderedFootprints;
+        orderedFootprints.reserve(numImages);
+        for(size_t i = 0; i < numImages; ++i)
+        {
+            orderedFootprints.push_back(footprints[order[i]]);
+        }
+        footprints.swap(orderedFootprints);
+        orderedFootprints.clear();
+
+        // Build the tree a level at a time, packing the nodes of each level in STR order.
+        std::vector<RSGISFootprintIdxNode> nodes;
+        for(size_t i = 0; i < numImages; i += nodeCapacity)
+        {
+            RSGISFootprintIdxNode node;
+            node.first = i;
+            node.count = std::min<size_t>(nodeCapacity, numImages - i);
+            node.leaf = 1;
+            std::copy(footprints[i].bbox, footprints[i].bbox+4, node.bbox);
+            for(size_t j = i+1; j < i+node.count; ++j)
+            {
+                node.bbox[0] = std::min(node.bbox[0], footprints[j].bbox[0]);
+                node.bbox[1] = std::max(node.bbox[1], footprints[j].bbox[1]);
+                node.bbox[2] = std::min(node.bbox[2], footprints[j].bbox[2]);
+                node.bbox[3] = std::max(node.bbox[3], footprints[j].bbox[3]);
+            }
+            nodes.push_back(node);
+        }
+        size_t levelStart = 0;
+        size_t levelEnd = nodes.size();
+        while((levelEnd - levelStart) > 1)
+        {
+            size_t numLevelNodes = levelEnd - levelStart;
+            boxes.resize(numLevelNodes*4);
+            for(size_t i = 0; i < numLevelNodes; ++i)
+            {
+                std::copy(nodes[levelStart+i].bbox, nodes[levelStart+i].bbox+4, boxes.begin()+i*4);
+            }
+            order = RSGISImageFootprintIndex::strOrder(boxes, nodeCapacity);
+            std::vector<RSGISFootprintIdxNode> levelNodes(nodes.begin()+levelStart, nodes.begin()+levelEnd);
+            for(size_t i = 0; i < numLevelNodes; ++i)
+            {
+                nodes[levelStart+i] = levelNodes[order[i]];
+            }
+
+            for(size_t i = levelStart; i < levelEnd; i += nodeCapacity)
+            {
+                RSGISFootprintIdxNode node;
+                node.first = i;
+                node.count = std::min<size_t>(nodeCapacity, levelEnd - i);
+                node.leaf = 0;
+                std::copy(nodes[i].bbox, nodes[i].bbox+4, node.bbox);
+                for(size_t j = i+1; j < i+node.count; ++j)
+                {
+                    node.bbox[0] = std::min(node.bbox[0], nodes[j].bbox[0]);
+                    node.bbox[1] = std::max(node.bbox[1], nodes[j].bbox[1]);
+                    node.bbox[2] = std::min(node.bbox[2], nodes[j].bbox[2]);
+                    node.bbox[3] = std::max(node.bbox[3], nodes[j].bbox[3]);
+                }
+                nodes.push_back(node);
+            }
+            levelStart = levelEnd;
+            levelEnd = nodes.size();
+        }
+
+        // The paths and projections are held in a string table (projections are shared).
+        std::string stringTable;
+        std::map<std::string, uint64_t> crsOffsets;
+        std::vector<RSGISFootprintIdxImage> idxImages(numImages);
+        for(size_t i = 0; i < numImages; ++i)
+        {
+            const RSGISImageFootprint &footprint = footprints[i];
+            RSGISFootprintIdxImage &idxImage = idxImages[i];
+            std::memset(&idxImage, 0, sizeof(RSGISFootprintIdxImage));
+            std::copy(footprint.bbox, footprint.bbox+4, idxImage.bbox);
+            idxImage.noDataVal = footprint.noDataVal;
+            idxImage.validPxlFrac = footprint.validPxlFrac;
+            idxImage.validNoDataVal = footprint.validNoDataVal;
+            idxImage.modTime = footprint.modTime;
+            idxImage.fileSize = footprint.fileSize;
+            idxImage.numBands = footprint.numBands;
+            idxImage.xSize = footprint.xSize;
+            idxImage.ySize = footprint.ySize;
+            idxImage.hasNoData = footprint.hasNoData?1:0;
+            idxImage.pathOffset = stringTable.size();
+            idxImage.pathLen = footprint.imageFile.size();
+            stringTable += footprint.imageFile;
+            std::map<std::string, uint64_t>::iterator iterCRS = crsOffsets.find(footprint.crsWKT);
+            if(iterCRS == crsOffsets.end())
+            {
+                crsOffsets[footprint.crsWKT] = stringTable.size();
+                idxImage.crsOffset = stringTable.size();
+                stringTable += footprint.crsWKT;
+            }
+            else
+            {
+                idxImage.crsOffset = iterCRS->second;
+            }
+            idxImage.crsLen = footprint.crsWKT.size();
+        }
+
+        std::vector<uint64_t> pathOrder(numImages);
+        for(size_t i = 0; i < numImages; ++i)
+        {
+            pathOrder[i] = i;
+        }
+        std::sort(pathOrder.begin(), pathOrder.end(), [&footprints](uint64_t a, uint64_t b){
+            return footprints[a].imageFile < footprints[b].imageFile;
+        });
+        for(size_t i = 1; i < numImages; ++i)
+        {
+            if(footprints[pathOrder[i]].imageFile == footprints[pathOrder[i-1]].imageFile)
+            {
+                throw RSGISImageException("The image is in the list of images more than once: " + footprints[pathOrder[i]].imageFile);
+            }
+        }
+
+        RSGISFootprintIdxHeader header;
+        std::memset(&header, 0, sizeof(RSGISFootprintIdxHeader));
+        std::memcpy(header.magic, RSGIS_FOOTPRINT_IDX_MAGIC, 8);
+        header.version = RSGIS_FOOTPRINT_IDX_VERSION;
+        header.nodeCapacity = nodeCapacity;
+        header.numImages = numImages;
+        header.numNodes = nodes.size();
+        header.idxEPSG = idxEPSG;
+        header.imagesOffset = sizeof(RSGISFootprintIdxHeader);
+        header.nodesOffset = header.imagesOffset + numImages * sizeof(RSGISFootprintIdxImage);
+        header.pathOrderOffset = header.nodesOffset + nodes.size() * sizeof(RSGISFootprintIdxNode);
+        header.stringsOffset = header.pathOrderOffset + numImages * sizeof(uint64_t);
+        header.stringsSize = stringTable.size();
+
+        // Write to a temporary file and then replace the index so an open index is never partially written.
+        std::string tmpIndexFile = indexFile + ".tmp";
+        std::ofstream idxStream(tmpIndexFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!idxStream.is_open())
+        {
+            throw RSGISImageException("Could not create the footprint index: " + indexFile);
+        }
+        idxStream.write((const char*)&header, sizeof(RSGISFootprintIdxHeader));
+        idxStream.write((const char*)idxImages.data(), numImages * sizeof(RSGISFootprintIdxImage));
+        idxStream.write((const char*)nodes.data(), nodes.size() * sizeof(RSGISFootprintIdxNode));
+        idxStream.write((const char*)pathOrder.data(), numImages * sizeof(uint64_t));
+        idxStream.write(stringTable.data(), stringTable.size());
+        idxStream.close();
+        if(idxStream.fail())
+        {
+            std::remove(tmpIndexFile.c_str());
+            throw RSGISImageException("Could not write the footprint index: " + indexFile);
+        }
+#ifdef _WIN32
+        std::remove(indexFile.c_str());
+#endif
+        if(std::rename(tmpIndexFile.c_str(), indexFile.c_str()) != 0)
+        {
+            throw RSGISImageException("Could not write the footprint index: " + indexFile);
+        }
+    }
+
+    RSGISImageFootprintIndex::~RSGISImageFootprintIndex()
+    {
+        this->closeIndex();
+    }
+
+}}
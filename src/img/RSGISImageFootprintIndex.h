@@ -0,0 +1,195 @@
+/*
+ *  RSGISImageFootprintIndex.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISImageFootprintIndex_H
+#define RSGISImageFootprintIndex_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdint>
+
+#include "gdal_priv.h"
+#include "ogr_spatialref.h"
+
+#include "common/RSGISImageException.h"
+#include "common/rsgis-tqdm.h"
+
+#include "img/RSGISImageMosaic.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /**
+     * The footprint (bbox as minX, maxX, minY, maxY in the index projection) and
+     * cached metadata of an image. validPxlFrac is the proportion of pixels which
+     * are not the no data value (validNoDataVal) in all bands, or -1 if it has not
+     * been calculated. modTime and fileSize are used to identify images which have
+     * changed since they were indexed.
+     */
+    struct DllExport RSGISImageFootprint
+    {
+        std::string imageFile;
+        double bbox[4];
+        unsigned int numBands;
+        unsigned int xSize;
+        unsigned int ySize;
+        bool hasNoData;
+        double noDataVal;
+        double validPxlFrac;
+        double validNoDataVal;
+        std::string crsWKT;
+        long long modTime;
+        unsigned long long fileSize;
+    };
+
+    /**
+     * A persistent spatial index of image footprints for querying large archives
+     * of images. The footprints are stored with their metadata in a packed
+     * (Sort-Tile-Recursive) R-tree within a single binary file which is memory
+     * mapped when opened, so queries only touch the tree nodes and images which
+     * intersect the query bbox. The images are also indexed by file path so the
+     * cached metadata (e.g., the valid pixel fraction used for ordering images
+     * ahead of mosaicking) can be looked up.
+     *
+     * The packed tree is not modified in place; updateIndex reuses the footprints
+     * of the images which have not changed (same file size and modification
+     * time), reads the new or changed images and rewrites the index.
+     */
+    class DllExport RSGISImageFootprintIndex
+    {
+    public:
+        RSGISImageFootprintIndex();
+        void openIndex(std::string indexFile);
+        void closeIndex();
+        bool isOpen(){return this->data != NULL;};
+        size_t getNumImages() const;
+        /** The EPSG code of the footprints (0 if the footprints are in the image coordinates). */
+        int getIndexEPSG() const;
+        /** Finds the indexes of the images which intersect the bbox (minX, maxX, minY, maxY). */
+        void query(double minX, double maxX, double minY, double maxY, std::vector<size_t> *idxs) const;
+        RSGISImageFootprint getFootprint(size_t idx) const;
+        /** Returns the index of the image file, or -1 if it is not within the index. */
+        long long findImage(std::string imageFile) const;
+        void getAllFootprints(std::vector<RSGISImageFootprint> *footprints) const;
+
+        /**
+         * Creates an index for the images. If idxEPSG is not 0 the footprints are
+         * reprojected to that projection, otherwise all the images must be in the
+         * same projection. If calcValidFrac is true the valid pixel fraction is
+         * calculated using noDataVal if useNoDataVal is true, otherwise with the
+         * no data value of the image (images without a no data value are all valid).
+         */
+        static void createIndex(std::vector<std::string> images, std::string indexFile, int idxEPSG, bool calcValidFrac, bool useNoDataVal, float noDataVal);
+        /**
+         * Updates an existing index, adding the images which are not within the index
+         * and re-reading those which have changed. If removeMissing is true images
+         * within the index which no longer exist are removed. Returns the number of
+         * images which were read.
+         */
+        static size_t updateIndex(std::string indexFile, std::vector<std::string> images, bool removeMissing, bool calcValidFrac, bool useNoDataVal, float noDataVal);
+        /** Reads the footprint and metadata of an image, reprojecting the footprint to idxEPSG if not 0. */
+        static RSGISImageFootprint readImageFootprint(std::string imageFile, int idxEPSG, bool calcValidFrac, bool useNoDataVal, float noDataVal);
+        /** Calculates the proportion of pixels which are not noDataVal in all bands. */
+        static double calcValidPxlFraction(GDALDataset *dataset, float noDataVal);
+        /** Returns true if the file size and modification time of the image match the footprint. */
+        static bool footprintCurrent(const RSGISImageFootprint &footprint);
+        /** Writes the footprints as a packed R-tree index (the footprints are reordered). */
+        static void writeIndex(std::vector<RSGISImageFootprint> &footprints, std::string indexFile, int idxEPSG, unsigned int nodeCapacity=16);
+        ~RSGISImageFootprintIndex();
+    protected:
+        struct RSGISFootprintIdxHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t nodeCapacity;
+            uint64_t numImages;
+            uint64_t numNodes;
+            int32_t idxEPSG;
+            uint32_t reserved;
+            uint64_t imagesOffset;
+            uint64_t nodesOffset;
+            uint64_t pathOrderOffset;
+            uint64_t stringsOffset;
+            uint64_t stringsSize;
+        };
+        struct RSGISFootprintIdxImage
+        {
+            double bbox[4];
+            double noDataVal;
+            double validPxlFrac;
+            double validNoDataVal;
+            int64_t modTime;
+            uint64_t fileSize;
+            uint64_t pathOffset;
+            uint64_t crsOffset;
+            uint32_t pathLen;
+            uint32_t crsLen;
+            uint32_t numBands;
+            uint32_t xSize;
+            uint32_t ySize;
+            uint32_t hasNoData;
+        };
+        /** A tree node; the children are the images (leaves) or nodes [first, first+count). The root is the last node. */
+        struct RSGISFootprintIdxNode
+        {
+            double bbox[4];
+            uint64_t first;
+            uint32_t count;
+            uint32_t leaf;
+        };
+        /** Sorts the boxes (minX, maxX, minY, maxY) into Sort-Tile-Recursive order, returning the new order. */
+        static std::vector<size_t> strOrder(const std::vector<double> &boxes, unsigned int nodeCapacity);
+        /** Checks the footprints (in image coordinates) are all in the same projection. */
+        static void checkProjections(const std::vector<RSGISImageFootprint> &footprints);
+        /** Returns true if the cached valid pixel fraction was calculated with the no data value which would now be used. */
+        static bool validFracCurrent(const RSGISImageFootprint &footprint, bool useNoDataVal, float noDataVal);
+        static bool statImage(std::string imageFile, long long *modTime, unsigned long long *fileSize);
+        const RSGISFootprintIdxImage* getIdxImage(size_t idx) const;
+        std::string getString(uint64_t offset, uint32_t len) const;
+        const char *data;
+        size_t dataSize;
+        std::vector<char> dataBuffer;
+        const RSGISFootprintIdxHeader *header;
+        const RSGISFootprintIdxImage *idxImages;
+        const RSGISFootprintIdxNode *idxNodes;
+        const uint64_t *pathOrder;
+        const char *strings;
+    };
+
+}}
+
+#endif
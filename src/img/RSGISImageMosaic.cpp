@@ -29,6 +29,7 @@
  */
 
 #include "RSGISImageMosaic.h"
+#include "RSGISImageFootprintIndex.h"
 
 namespace rsgis{namespace img{
 
@@ -1730,10 +1731,16 @@ namespace rsgis{namespace img{
         }
     }
     
-    void RSGISImageMosaic::orderInImagesValidData(std::vector<std::string> images, std::vector<std::string> *orderedImages, float noDataValue)
+    void RSGISImageMosaic::orderInImagesValidData(std::vector<std::string> images, std::vector<std::string> *orderedImages, float noDataValue, std::string footprintIdxFile)
     {
         try
         {
+            RSGISImageFootprintIndex footprintIdx;
+            if(footprintIdxFile != "")
+            {
+                footprintIdx.openIndex(footprintIdxFile);
+            }
+
             RSGISImageValidDataMetric *validPxlCountObj = new RSGISImageValidDataMetric();
             RSGISCountValidPixels *calcImageValidPxlCount = new RSGISCountValidPixels(validPxlCountObj, noDataValue);
 			RSGISCalcImage calcImg = RSGISCalcImage(calcImageValidPxlCount, "", true);
@@ -1741,6 +1748,26 @@ namespace rsgis{namespace img{
             std::list<RSGISImageValidDataMetric> validDataImageMetrics;
             for(std::vector<std::string>::iterator iterImage = images.begin(); iterImage != images.end(); ++iterImage)
             {
+                if(footprintIdx.isOpen())
+                {
+                    long long idx = footprintIdx.findImage(*iterImage);
+                    if(idx >= 0)
+                    {
+                        RSGISImageFootprint footprint = footprintIdx.getFootprint(idx);
+                        if((footprint.validPxlFrac >= 0) && (((float)footprint.validNoDataVal) == noDataValue) && RSGISImageFootprintIndex::footprintCurrent(footprint))
+                        {
+                            RSGISImageValidDataMetric imgDataMetric;
+                            imgDataMetric.imageFile = (*iterImage);
+                            imgDataMetric.totalNumPxls = ((uint64_t)footprint.xSize) * ((uint64_t)footprint.ySize);
+                            imgDataMetric.validPxlCount = footprint.validPxlFrac * imgDataMetric.totalNumPxls;
+                            imgDataMetric.noDataPxlCount = imgDataMetric.totalNumPxls - imgDataMetric.validPxlCount;
+                            imgDataMetric.validPxlFunc = footprint.validPxlFrac;
+                            validDataImageMetrics.push_back(imgDataMetric);
+                            continue;
+                        }
+                    }
+                }
+
                 // Calculate Valid Pixel Count.
                 validPxlCountObj->totalNumPxls = 0;
                 validPxlCountObj->validPxlCount = 0;
@@ -30,6 +30,7 @@
 
 #include <iostream>
 #include <string>
+#include <cstdint>
 
 #include "libkea/KEAImageIO.h"
 
@@ -58,9 +59,9 @@ namespace rsgis{namespace img{
     struct DllExport RSGISImageValidDataMetric
     {
         std::string imageFile;
-        unsigned int validPxlCount;
-        unsigned int noDataPxlCount;
-        unsigned int totalNumPxls;
+        uint64_t validPxlCount;
+        uint64_t noDataPxlCount;
+        uint64_t totalNumPxls;
         double validPxlFunc;
     };
     
@@ -86,7 +87,8 @@ namespace rsgis{namespace img{
         void includeDatasets(GDALDataset *baseImage, std::string *inputImages, int numDS, std::vector<int> bands, bool bandsDefined);
         void includeDatasetsSkipVals(GDALDataset *baseImage, std::string *inputImages, int numDS, std::vector<int> bands, bool bandsDefined, float skipVal);
         void includeDatasetsIgnoreOverlap(GDALDataset *baseImage, std::string *inputImages, int numDS, int numOverlapPxls);
-        void orderInImagesValidData(std::vector<std::string> images, std::vector<std::string> *orderedImages, float noDataValue);
+        /** Orders the images by their valid pixel fraction; if footprintIdxFile is not empty the fractions cached within the footprint index are used where they are current. */
+        void orderInImagesValidData(std::vector<std::string> images, std::vector<std::string> *orderedImages, float noDataValue, std::string footprintIdxFile="");
         ~RSGISImageMosaic();
     };
     
@@ -0,0 +1,236 @@
+/*
+ *  RSGISImageSampler.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISImageSampler.h"
+
+namespace rsgis{namespace img{
+
+    RSGISImageSampler::RSGISImageSampler(RSGISImgSampleMethod method, unsigned int subSample, unsigned long numSamples, bool ignoreZeros, unsigned int seed, unsigned int numThreads)
+    {
+        this->method = method;
+        this->subSample = subSample;
+        this->numSamples = numSamples;
+        this->ignoreZeros = ignoreZeros;
+        this->seed = seed;
+        this->seedHash = RSGISImageSampler::mixHash(seed);
+        this->numThreads = numThreads;
+    }
+
+    void RSGISImageSampler::sampleImage(GDALDataset *dataset, RSGISImagePxlSamples *samples)
+    {
+        if(this->subSample == 0)
+        {
+            throw RSGISImageException("The sub-sample must be greater than zero.");
+        }
+        if((this->method == rsgis_imgsample_reservoir) && (this->numSamples == 0))
+        {
+            throw RSGISImageException("The number of samples must be greater than zero for reservoir sampling.");
+        }
+
+        unsigned int numBands = dataset->GetRasterCount();
+        if(numBands == 0)
+        {
+            throw RSGISImageException("The input image does not have any image bands.");
+        }
+        int width = dataset->GetRasterXSize();
+        int height = dataset->GetRasterYSize();
+
+        samples->data.clear();
+        samples->numPts = 0;
+        samples->numBands = numBands;
+
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        dataset->GetRasterBand(1)->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        // Read whole rows of blocks, at least 256 lines at a time.
+        int nRowsPerChunk = yBlockSize;
+        while(nRowsPerChunk < 256)
+        {
+            nRowsPerChunk += yBlockSize;
+        }
+        if(nRowsPerChunk > height)
+        {
+            nRowsPerChunk = height;
+        }
+        unsigned int nChunks = (height + nRowsPerChunk - 1) / nRowsPerChunk;
+
+        uint64_t numImgPxls = ((uint64_t)width) * ((uint64_t)height);
+        if(this->method == rsgis_imgsample_reservoir)
+        {
+            uint64_t nReserve = std::min<uint64_t>(this->numSamples, numImgPxls);
+            samples->data.reserve(nReserve * numBands);
+        }
+        else
+        {
+            samples->data.reserve(((numImgPxls + this->subSample - 1) / this->subSample) * numBands);
+        }
+
+        // Open a handle to the dataset per task, if the dataset can be reopened.
+        unsigned int numTasks = std::min(RSGISThreadPool::findNumThreads(this->numThreads), nChunks);
+        std::vector<GDALDataset*> handles;
+        handles.push_back(dataset);
+        std::string fileName = dataset->GetDescription();
+        for(unsigned int i = 1; (i < numTasks) && (fileName != ""); ++i)
+        {
+            GDALDataset *handle = (GDALDataset *) GDALOpen(fileName.c_str(), GA_ReadOnly);
+            if(handle == NULL)
+            {
+                break;
+            }
+            handles.push_back(handle);
+        }
+        numTasks = handles.size();
+
+        boost::mt19937 rng(this->seed);
+        uint64_t nEligible = 0;
+        try
+        {
+            RSGISThreadPool threadPool(numTasks);
+            std::vector< std::vector<float> > chunkPxls(numTasks);
+            rsgis_tqdm pbar;
+            for(unsigned int chunk = 0; chunk < nChunks; chunk += numTasks)
+            {
+                pbar.progress(chunk, nChunks);
+                unsigned int nRoundChunks = std::min(numTasks, nChunks - chunk);
+                for(unsigned int t = 0; t < nRoundChunks; ++t)
+                {
+                    int yOff = (chunk + t) * nRowsPerChunk;
+                    int nRows = std::min(nRowsPerChunk, height - yOff);
+                    uint64_t pxlIdxOff = ((uint64_t)yOff) * ((uint64_t)width);
+                    GDALDataset *handle = handles[t];
+                    std::vector<float> *pxls = &chunkPxls[t];
+                    threadPool.submit([this, handle, yOff, nRows, pxlIdxOff, pxls]{ this->readChunk(handle, yOff, nRows, pxlIdxOff, pxls); });
+                }
+                threadPool.waitForAll();
+
+                // Merge the chunks in order so the output does not depend on the number of threads.
+                for(unsigned int t = 0; t < nRoundChunks; ++t)
+                {
+                    std::vector<float> &pxls = chunkPxls[t];
+                    size_t nChunkPts = pxls.size() / numBands;
+                    if(this->method == rsgis_imgsample_reservoir)
+                    {
+                        for(size_t i = 0; i < nChunkPts; ++i)
+                        {
+                            if(nEligible < this->numSamples)
+                            {
+                                samples->data.insert(samples->data.end(), pxls.begin()+(i*numBands), pxls.begin()+((i+1)*numBands));
+                            }
+                            else
+                            {
+                                boost::random::uniform_int_distribution<uint64_t> idxDist(0, nEligible);
+                                uint64_t idx = idxDist(rng);
+                                if(idx < this->numSamples)
+                                {
+                                    std::copy(pxls.begin()+(i*numBands), pxls.begin()+((i+1)*numBands), samples->data.begin()+(idx*numBands));
+                                }
+                            }
+                            ++nEligible;
+                        }
+                    }
+                    else
+                    {
+                        samples->data.insert(samples->data.end(), pxls.begin(), pxls.end());
+                    }
+                }
+            }
+            pbar.finish();
+        }
+        catch(RSGISException &e)
+        {
+            for(unsigned int i = 1; i < handles.size(); ++i)
+            {
+                GDALClose(handles[i]);
+            }
+            throw RSGISImageException(e.what());
+        }
+        catch(std::exception &e)
+        {
+            for(unsigned int i = 1; i < handles.size(); ++i)
+            {
+                GDALClose(handles[i]);
+            }
+            throw RSGISImageException(e.what());
+        }
+        for(unsigned int i = 1; i < handles.size(); ++i)
+        {
+            GDALClose(handles[i]);
+        }
+
+        samples->numPts = samples->data.size() / numBands;
+    }
+
+    void RSGISImageSampler::readChunk(GDALDataset *dataset, int yOff, int nRows, uint64_t pxlIdxOff, std::vector<float> *pxls)
+    {
+        unsigned int numBands = dataset->GetRasterCount();
+        int width = dataset->GetRasterXSize();
+        size_t nPxls = ((size_t)width) * ((size_t)nRows);
+
+        std::vector<float> bandData(nPxls * numBands);
+        for(unsigned int n = 0; n < numBands; ++n)
+        {
+            if(dataset->GetRasterBand(n+1)->RasterIO(GF_Read, 0, yOff, width, nRows, bandData.data()+(n*nPxls), width, nRows, GDT_Float32, 0, 0) != CE_None)
+            {
+                throw RSGISImageException("Could not read image data.");
+            }
+        }
+
+        pxls->clear();
+        for(size_t i = 0; i < nPxls; ++i)
+        {
+            if(!this->selectPxl(pxlIdxOff + i))
+            {
+                continue;
+            }
+            if(this->ignoreZeros)
+            {
+                bool nonZeroFound = false;
+                for(unsigned int n = 0; n < numBands; ++n)
+                {
+                    if(bandData[(n*nPxls)+i] != 0)
+                    {
+                        nonZeroFound = true;
+                        break;
+                    }
+                }
+                if(!nonZeroFound)
+                {
+                    continue;
+                }
+            }
+            for(unsigned int n = 0; n < numBands; ++n)
+            {
+                pxls->push_back(bandData[(n*nPxls)+i]);
+            }
+        }
+    }
+
+    RSGISImageSampler::~RSGISImageSampler()
+    {
+
+    }
+
+}}
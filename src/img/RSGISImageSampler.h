@@ -0,0 +1,136 @@
+/*
+ *  RSGISImageSampler.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISImageSampler_H
+#define RSGISImageSampler_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#include "gdal_priv.h"
+
+#include "boost/random.hpp"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadPool.h"
+
+#include "math/RSGISClustering.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    enum RSGISImgSampleMethod
+    {
+        rsgis_imgsample_stride = 0,
+        rsgis_imgsample_reservoir = 1,
+        rsgis_imgsample_stratified = 2
+    };
+
+    /**
+     * Pixels sampled from an image held as a single contiguous row-major matrix
+     * (numPts x numBands).
+     */
+    struct DllExport RSGISImagePxlSamples
+    {
+        std::vector<float> data;
+        size_t numPts;
+        unsigned int numBands;
+        rsgis::math::RSGISClusterDataView getView() const
+        {
+            rsgis::math::RSGISClusterDataView view;
+            view.data = this->data.data();
+            view.numPts = this->numPts;
+            view.numFeatures = this->numBands;
+            return view;
+        };
+    };
+
+    /**
+     * Samples the pixels of an image into a contiguous matrix. Pixels are indexed
+     * in row-major order and, if ignoreZeros, pixels which are zero in all bands are
+     * not sampled. The sampling methods are:
+     *
+     *  - stride: every subSample'th pixel.
+     *  - reservoir: a uniform random sample of numSamples pixels (Algorithm R).
+     *  - stratified: one pixel selected at random from each run of subSample pixels.
+     *
+     * The random samples only depend on the seed, not the number of threads. Rows
+     * are read in chunks, with each chunk read and interleaved by a separate task
+     * on its own handle of the dataset where it can be reopened.
+     */
+    class DllExport RSGISImageSampler
+    {
+    public:
+        RSGISImageSampler(RSGISImgSampleMethod method=rsgis_imgsample_stride, unsigned int subSample=1, unsigned long numSamples=0, bool ignoreZeros=false, unsigned int seed=0, unsigned int numThreads=0);
+        void sampleImage(GDALDataset *dataset, RSGISImagePxlSamples *samples);
+        ~RSGISImageSampler();
+    protected:
+        void readChunk(GDALDataset *dataset, int yOff, int nRows, uint64_t pxlIdxOff, std::vector<float> *pxls);
+        inline bool selectPxl(uint64_t pxlIdx) const
+        {
+            if(this->method == rsgis_imgsample_stride)
+            {
+                return (pxlIdx % this->subSample) == 0;
+            }
+            else if(this->method == rsgis_imgsample_stratified)
+            {
+                uint64_t stratum = pxlIdx / this->subSample;
+                return (pxlIdx - (stratum * this->subSample)) == (RSGISImageSampler::mixHash(stratum ^ this->seedHash) % this->subSample);
+            }
+            return true;
+        };
+        static inline uint64_t mixHash(uint64_t val)
+        {
+            val += 0x9e3779b97f4a7c15ULL;
+            val = (val ^ (val >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            val = (val ^ (val >> 27)) * 0x94d049bb133111ebULL;
+            return val ^ (val >> 31);
+        };
+        RSGISImgSampleMethod method;
+        unsigned int subSample;
+        unsigned long numSamples;
+        bool ignoreZeros;
+        unsigned int seed;
+        uint64_t seedHash;
+        unsigned int numThreads;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,411 @@
+/*
+ *  RSGISImageSubset2Polys.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISImageSubset2Polys.h"
+
+namespace rsgis{namespace img{
+
+    RSGISImageSubset2Polys::RSGISImageSubset2Polys()
+    {
+        this->numBands = 0;
+        this->serialiseWrites = false;
+    }
+
+    std::vector<std::string> RSGISImageSubset2Polys::subsetImage(GDALDataset *dataset, OGRLayer *vecLayer, std::string filenameAttribute, std::string outputImageBase, std::string outFileExtension, std::string gdalFormat, GDALDataType outDataType, bool maskToPoly, double noDataVal, unsigned int numThreads)
+    {
+        std::vector<std::string> outFiles;
+        std::vector<RSGISImageChip*> chips;
+        RSGISThreadPool *writePool = NULL;
+        GByte *tileData = NULL;
+        char **papszOptions = NULL;
+        try
+        {
+            RSGISImageUtils imgUtils;
+            long width = dataset->GetRasterXSize();
+            long height = dataset->GetRasterYSize();
+            this->numBands = dataset->GetRasterCount();
+            dataset->GetGeoTransform(this->inTransform);
+            this->projWKT = std::string(dataset->GetProjectionRef());
+            this->bandNames.clear();
+            for(int n = 0; n < this->numBands; ++n)
+            {
+                this->bandNames.push_back(std::string(dataset->GetRasterBand(n+1)->GetDescription()));
+            }
+            // HDF5 based formats cannot be written from more than one thread at a time.
+            this->serialiseWrites = (gdalFormat == "KEA") || (gdalFormat == "HDF5") || (gdalFormat == "netCDF");
+
+            if((this->inTransform[2] != 0) || (this->inTransform[4] != 0))
+            {
+                throw RSGISImageException("The input image is rotated, this is not supported.");
+            }
+
+            int fieldIdx = vecLayer->GetLayerDefn()->GetFieldIndex(filenameAttribute.c_str());
+            if(fieldIdx < 0)
+            {
+                throw RSGISImageException("Could not find the field '" + filenameAttribute + "' within the vector layer.");
+            }
+
+            // Find the pixel window of each polygon within the input image.
+            double pxlTol = 1e-6;
+            double xPxlA, xPxlB, yPxlA, yPxlB = 0.0;
+            long xMinPxl, xMaxPxl, yMinPxl, yMaxPxl = 0;
+            OGREnvelope env;
+            OGRFeature *feat = NULL;
+            std::map<std::string, unsigned long> nameCounts;
+            std::string chipName = "";
+            vecLayer->ResetReading();
+            while((feat = vecLayer->GetNextFeature()) != NULL)
+            {
+                OGRGeometry *geom = feat->GetGeometryRef();
+                if((geom != NULL) && (!geom->IsEmpty()))
+                {
+                    geom->getEnvelope(&env);
+                    xPxlA = (env.MinX - this->inTransform[0]) / this->inTransform[1];
+                    xPxlB = (env.MaxX - this->inTransform[0]) / this->inTransform[1];
+                    yPxlA = (env.MaxY - this->inTransform[3]) / this->inTransform[5];
+                    yPxlB = (env.MinY - this->inTransform[3]) / this->inTransform[5];
+                    xMinPxl = floor(std::min(xPxlA, xPxlB) + pxlTol);
+                    xMaxPxl = ceil(std::max(xPxlA, xPxlB) - pxlTol);
+                    yMinPxl = floor(std::min(yPxlA, yPxlB) + pxlTol);
+                    yMaxPxl = ceil(std::max(yPxlA, yPxlB) - pxlTol);
+                    if(xMaxPxl <= xMinPxl)
+                    {
+                        xMaxPxl = xMinPxl + 1;
+                    }
+                    if(yMaxPxl <= yMinPxl)
+                    {
+                        yMaxPxl = yMinPxl + 1;
+                    }
+                    xMinPxl = std::max(xMinPxl, 0L);
+                    yMinPxl = std::max(yMinPxl, 0L);
+                    xMaxPxl = std::min(xMaxPxl, width);
+                    yMaxPxl = std::min(yMaxPxl, height);
+
+                    // Polygons outside of the image are ignored.
+                    if((xMaxPxl > xMinPxl) && (yMaxPxl > yMinPxl))
+                    {
+                        RSGISImageChip *chip = new RSGISImageChip();
+                        // Chips are written in parallel so each must have a unique file name.
+                        chipName = std::string(feat->GetFieldAsString(fieldIdx));
+                        unsigned long nameCount = ++nameCounts[chipName];
+                        if(nameCount > 1)
+                        {
+                            std::cerr << "Warning: '" << chipName << "' is used by more than one polygon; a suffix has been added to the output file name.\n";
+                            chipName = chipName + std::string("_") + std::to_string(nameCount);
+                            while(nameCounts.count(chipName) > 0)
+                            {
+                                chipName = chipName + std::string("_") + std::to_string(nameCount);
+                            }
+                            nameCounts[chipName] = 1;
+                        }
+                        chip->outputImage = outputImageBase + chipName + std::string(".") + outFileExtension;
+                        chip->geom = NULL;
+                        if(maskToPoly)
+                        {
+                            chip->geom = geom->clone();
+                        }
+                        chip->xOff = xMinPxl;
+                        chip->yOff = yMinPxl;
+                        chip->xSize = xMaxPxl - xMinPxl;
+                        chip->ySize = yMaxPxl - yMinPxl;
+                        chip->tilesRemaining = 0;
+                        chip->data = NULL;
+                        chips.push_back(chip);
+                    }
+                }
+                OGRFeature::DestroyFeature(feat);
+            }
+            std::cout << "There are " << chips.size() << " polygons which intersect with the image.\n";
+
+            // Build a grid index, aligned to the image blocks, of the chips intersecting each tile.
+            int xBlockSize = 0;
+            int yBlockSize = 0;
+            dataset->GetRasterBand(1)->GetBlockSize(&xBlockSize, &yBlockSize);
+            long tileXSize = xBlockSize;
+            long tileYSize = yBlockSize;
+            // Group scanline or strip blocks so tiles do not become too small.
+            long minTileSize = 64;
+            if(tileXSize < minTileSize)
+            {
+                tileXSize = ((minTileSize + xBlockSize - 1) / xBlockSize) * xBlockSize;
+            }
+            if(tileYSize < minTileSize)
+            {
+                tileYSize = ((minTileSize + yBlockSize - 1) / yBlockSize) * yBlockSize;
+            }
+            long nXTiles = (width + tileXSize - 1) / tileXSize;
+            long nYTiles = (height + tileYSize - 1) / tileYSize;
+
+            std::vector< std::vector<RSGISImageChip*> > tileChips(nXTiles * nYTiles);
+            for(std::vector<RSGISImageChip*>::iterator iterChip = chips.begin(); iterChip != chips.end(); ++iterChip)
+            {
+                long tX0 = (*iterChip)->xOff / tileXSize;
+                long tX1 = ((*iterChip)->xOff + (*iterChip)->xSize - 1) / tileXSize;
+                long tY0 = (*iterChip)->yOff / tileYSize;
+                long tY1 = ((*iterChip)->yOff + (*iterChip)->ySize - 1) / tileYSize;
+                for(long tY = tY0; tY <= tY1; ++tY)
+                {
+                    for(long tX = tX0; tX <= tX1; ++tX)
+                    {
+                        tileChips.at((tY * nXTiles) + tX).push_back(*iterChip);
+                        ++(*iterChip)->tilesRemaining;
+                    }
+                }
+            }
+
+            int pxlBytes = GDALGetDataTypeSizeBytes(outDataType);
+            papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+            unsigned int nWriteThreads = RSGISThreadPool::findNumThreads(numThreads);
+            // Bound the number of completed chips held in memory waiting to be written.
+            writePool = new RSGISThreadPool(nWriteThreads, nWriteThreads * 4);
+            tileData = (GByte *) CPLMalloc(((size_t)tileXSize) * tileYSize * this->numBands * pxlBytes);
+
+            rsgis_tqdm pbar;
+            long tileIdx = 0;
+            long nTiles = nXTiles * nYTiles;
+            for(long tY = 0; tY < nYTiles; ++tY)
+            {
+                for(long tX = 0; tX < nXTiles; ++tX)
+                {
+                    tileIdx = (tY * nXTiles) + tX;
+                    pbar.progress(tileIdx, nTiles);
+                    std::vector<RSGISImageChip*> *chipsInTile = &tileChips.at(tileIdx);
+                    if(chipsInTile->empty())
+                    {
+                        continue;
+                    }
+
+                    long tileX0 = tX * tileXSize;
+                    long tileX1 = std::min(tileX0 + tileXSize, width);
+                    long tileY0 = tY * tileYSize;
+                    long tileY1 = std::min(tileY0 + tileYSize, height);
+
+                    // Only read the part of the tile which is covered by chips.
+                    long readX0 = tileX1;
+                    long readX1 = tileX0;
+                    long readY0 = tileY1;
+                    long readY1 = tileY0;
+                    for(std::vector<RSGISImageChip*>::iterator iterChip = chipsInTile->begin(); iterChip != chipsInTile->end(); ++iterChip)
+                    {
+                        readX0 = std::min(readX0, std::max((*iterChip)->xOff, tileX0));
+                        readX1 = std::max(readX1, std::min((*iterChip)->xOff + (*iterChip)->xSize, tileX1));
+                        readY0 = std::min(readY0, std::max((*iterChip)->yOff, tileY0));
+                        readY1 = std::max(readY1, std::min((*iterChip)->yOff + (*iterChip)->ySize, tileY1));
+                    }
+                    long readWidth = readX1 - readX0;
+                    long readHeight = readY1 - readY0;
+
+                    if(dataset->RasterIO(GF_Read, readX0, readY0, readWidth, readHeight, tileData, readWidth, readHeight, outDataType, this->numBands, NULL, 0, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageException("Failed to read a block from the input image.");
+                    }
+
+                    for(std::vector<RSGISImageChip*>::iterator iterChip = chipsInTile->begin(); iterChip != chipsInTile->end(); ++iterChip)
+                    {
+                        RSGISImageChip *chip = *iterChip;
+                        if(chip->data == NULL)
+                        {
+                            chip->data = (GByte *) CPLMalloc(((size_t)chip->xSize) * chip->ySize * this->numBands * pxlBytes);
+                        }
+                        long cpX0 = std::max(chip->xOff, readX0);
+                        long cpX1 = std::min(chip->xOff + chip->xSize, readX1);
+                        long cpY0 = std::max(chip->yOff, readY0);
+                        long cpY1 = std::min(chip->yOff + chip->ySize, readY1);
+                        size_t rowBytes = ((size_t)(cpX1 - cpX0)) * pxlBytes;
+                        for(int n = 0; n < this->numBands; ++n)
+                        {
+                            for(long y = cpY0; y < cpY1; ++y)
+                            {
+                                size_t chipIdx = ((((size_t)n) * chip->ySize + (y - chip->yOff)) * chip->xSize) + (cpX0 - chip->xOff);
+                                size_t tileIdxPxl = ((((size_t)n) * readHeight + (y - readY0)) * readWidth) + (cpX0 - readX0);
+                                memcpy(chip->data + (chipIdx * pxlBytes), tileData + (tileIdxPxl * pxlBytes), rowBytes);
+                            }
+                        }
+
+                        --chip->tilesRemaining;
+                        if(chip->tilesRemaining == 0)
+                        {
+                            writePool->submit([this, chip, outDataType, gdalFormat, papszOptions, maskToPoly, noDataVal]{ this->writeChip(chip, outDataType, gdalFormat, papszOptions, maskToPoly, noDataVal); });
+                        }
+                    }
+                }
+            }
+            writePool->waitForAll();
+            pbar.finish();
+
+            delete writePool;
+            writePool = NULL;
+            CPLFree(tileData);
+            tileData = NULL;
+            CSLDestroy(papszOptions);
+            papszOptions = NULL;
+
+            for(std::vector<RSGISImageChip*>::iterator iterChip = chips.begin(); iterChip != chips.end(); ++iterChip)
+            {
+                outFiles.push_back((*iterChip)->outputImage);
+            }
+            this->deleteChips(&chips);
+        }
+        catch(std::exception &e)
+        {
+            if(writePool != NULL)
+            {
+                try
+                {
+                    writePool->waitForAll();
+                }
+                catch(std::exception &poolErr)
+                {
+                    // The original error is reported.
+                }
+                delete writePool;
+            }
+            if(tileData != NULL)
+            {
+                CPLFree(tileData);
+            }
+            if(papszOptions != NULL)
+            {
+                CSLDestroy(papszOptions);
+            }
+            this->deleteChips(&chips);
+            throw RSGISImageException(e.what());
+        }
+
+        return outFiles;
+    }
+
+    void RSGISImageSubset2Polys::writeChip(RSGISImageChip *chip, GDALDataType outDataType, std::string gdalFormat, char **papszOptions, bool maskToPoly, double noDataVal)
+    {
+        int pxlBytes = GDALGetDataTypeSizeBytes(outDataType);
+        size_t numPxls = ((size_t)chip->xSize) * chip->ySize;
+
+        double chipTransform[6];
+        chipTransform[0] = this->inTransform[0] + (chip->xOff * this->inTransform[1]);
+        chipTransform[1] = this->inTransform[1];
+        chipTransform[2] = 0.0;
+        chipTransform[3] = this->inTransform[3] + (chip->yOff * this->inTransform[5]);
+        chipTransform[4] = 0.0;
+        chipTransform[5] = this->inTransform[5];
+
+        if(maskToPoly && (chip->geom != NULL))
+        {
+            GDALDriver *memDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+            GDALDataset *maskDS = memDriver->Create("", chip->xSize, chip->ySize, 1, GDT_Byte, NULL);
+            if(maskDS == NULL)
+            {
+                throw RSGISImageException("Could not create an in memory mask for " + chip->outputImage);
+            }
+            maskDS->SetGeoTransform(chipTransform);
+            int maskBand = 1;
+            double burnVal = 1.0;
+            OGRGeometryH geomHdl = (OGRGeometryH) chip->geom;
+            GDALRasterizeGeometries(maskDS, 1, &maskBand, 1, &geomHdl, NULL, NULL, &burnVal, NULL, NULL, NULL);
+
+            GByte *maskData = (GByte *) CPLMalloc(numPxls);
+            maskDS->GetRasterBand(1)->RasterIO(GF_Read, 0, 0, chip->xSize, chip->ySize, maskData, chip->xSize, chip->ySize, GDT_Byte, 0, 0);
+            GDALClose(maskDS);
+
+            GByte *noDataPxl = new GByte[pxlBytes];
+            GDALCopyWords(&noDataVal, GDT_Float64, 0, noDataPxl, outDataType, 0, 1);
+            for(int n = 0; n < this->numBands; ++n)
+            {
+                GByte *bandData = chip->data + (((size_t)n) * numPxls * pxlBytes);
+                for(size_t i = 0; i < numPxls; ++i)
+                {
+                    if(maskData[i] == 0)
+                    {
+                        memcpy(bandData + (i * pxlBytes), noDataPxl, pxlBytes);
+                    }
+                }
+            }
+            delete[] noDataPxl;
+            CPLFree(maskData);
+        }
+
+        {
+            std::unique_lock<std::mutex> writeLock(this->writeMutex, std::defer_lock);
+            if(this->serialiseWrites)
+            {
+                writeLock.lock();
+            }
+            GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+            if(gdalDriver == NULL)
+            {
+                throw RSGISImageException("Requested GDAL driver does not exists..");
+            }
+            GDALDataset *outDataset = gdalDriver->Create(chip->outputImage.c_str(), chip->xSize, chip->ySize, this->numBands, outDataType, papszOptions);
+            if(outDataset == NULL)
+            {
+                throw RSGISImageException("Output image could not be created: " + chip->outputImage);
+            }
+            outDataset->SetGeoTransform(chipTransform);
+            outDataset->SetProjection(this->projWKT.c_str());
+            for(int n = 0; n < this->numBands; ++n)
+            {
+                GDALRasterBand *outBand = outDataset->GetRasterBand(n+1);
+                outBand->SetDescription(this->bandNames.at(n).c_str());
+                if(maskToPoly)
+                {
+                    outBand->SetNoDataValue(noDataVal);
+                }
+            }
+            CPLErr err = outDataset->RasterIO(GF_Write, 0, 0, chip->xSize, chip->ySize, chip->data, chip->xSize, chip->ySize, outDataType, this->numBands, NULL, 0, 0, 0);
+            GDALClose(outDataset);
+            if(err != CE_None)
+            {
+                throw RSGISImageException("Failed to write the image data to " + chip->outputImage);
+            }
+        }
+
+        CPLFree(chip->data);
+        chip->data = NULL;
+        if(chip->geom != NULL)
+        {
+            OGRGeometryFactory::destroyGeometry(chip->geom);
+            chip->geom = NULL;
+        }
+    }
+
+    void RSGISImageSubset2Polys::deleteChips(std::vector<RSGISImageChip*> *chips)
+    {
+        for(std::vector<RSGISImageChip*>::iterator iterChip = chips->begin(); iterChip != chips->end(); ++iterChip)
+        {
+            if((*iterChip)->data != NULL)
+            {
+                CPLFree((*iterChip)->data);
+            }
+            if((*iterChip)->geom != NULL)
+            {
+                OGRGeometryFactory::destroyGeometry((*iterChip)->geom);
+            }
+            delete *iterChip;
+        }
+        chips->clear();
+    }
+
+    RSGISImageSubset2Polys::~RSGISImageSubset2Polys()
+    {
+
+    }
+
+}}
@@ -0,0 +1,99 @@
+/*
+ *  RSGISImageSubset2Polys.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISImageSubset2Polys_H
+#define RSGISImageSubset2Polys_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <map>
+
+#include "gdal_priv.h"
+#include "gdal_alg.h"
+#include "ogrsf_frmts.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadPool.h"
+
+#include "img/RSGISImageUtils.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    struct DllExport RSGISImageChip
+    {
+        std::string outputImage;
+        OGRGeometry *geom;
+        long xOff;
+        long yOff;
+        long xSize;
+        long ySize;
+        unsigned long tilesRemaining;
+        GByte *data;
+    };
+
+    /**
+     * Subsets an image to the bounding box of each polygon within a vector layer
+     * in a single pass of the input image. The chip windows are indexed on a grid
+     * aligned with the image blocks, each block of the input image is read once
+     * and copied into every chip it intersects and chips are written out on a pool
+     * of threads as soon as their last block has been read. If the attribute has
+     * the same value for more than one polygon a suffix (_2, _3, ...) is added to
+     * the later output file names so each chip is written to its own file.
+     */
+    class DllExport RSGISImageSubset2Polys
+    {
+    public:
+        RSGISImageSubset2Polys();
+        std::vector<std::string> subsetImage(GDALDataset *dataset, OGRLayer *vecLayer, std::string filenameAttribute, std::string outputImageBase, std::string outFileExtension, std::string gdalFormat, GDALDataType outDataType, bool maskToPoly=false, double noDataVal=0.0, unsigned int numThreads=0);
+        ~RSGISImageSubset2Polys();
+    protected:
+        void writeChip(RSGISImageChip *chip, GDALDataType outDataType, std::string gdalFormat, char **papszOptions, bool maskToPoly, double noDataVal);
+        void deleteChips(std::vector<RSGISImageChip*> *chips);
+        double inTransform[6];
+        std::string projWKT;
+        std::vector<std::string> bandNames;
+        int numBands;
+        bool serialiseWrites;
+        std::mutex writeMutex;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,802 @@
+/*
+ *  RSGISImageTilePlanner.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISImageTilePlanner.h"
+
+namespace rsgis{namespace img{
+
+    /** A rectangle of cells [c0, c1] x [r0, r1] of the tile grid. */
+    struct RSGISTileRegion
+    {
+        long c0;
+        long c1;
+        long r0;
+        long r1;
+        bool alive;
+    };
+
+    RSGISImageTilePlanner::RSGISImageTilePlanner(unsigned int numThreads, unsigned int stripHeight)
+    {
+        this->numThreads = numThreads;
+        this->stripHeight = std::max<unsigned int>(stripHeight, 1);
+        this->serialiseIO = false;
+    }
+
+    std::vector<RSGISImageTile> RSGISImageTilePlanner::planTiles(GDALDataset *dataset, unsigned int tileWidth, unsigned int tileHeight, bool offset, bool useNoData, double noDataVal, float validThreshold, GDALDataset *maskDataset, bool shrinkToValid)
+    {
+        std::vector<RSGISImageTile> tiles;
+        try
+        {
+            if((tileWidth == 0) || (tileHeight == 0))
+            {
+                throw RSGISImageException("The tile width and height must be greater than zero.");
+            }
+            long width = dataset->GetRasterXSize();
+            long height = dataset->GetRasterYSize();
+            if(maskDataset != NULL)
+            {
+                if((maskDataset->GetRasterXSize() != width) || (maskDataset->GetRasterYSize() != height))
+                {
+                    throw RSGISImageException("The mask image must be the same size as the input image.");
+                }
+            }
+
+            // The edges of the tile grid, where the offset grid starts with a half tile.
+            std::vector<long> xEdges;
+            std::vector<long> yEdges;
+            long xStart = 0;
+            long yStart = 0;
+            xEdges.push_back(0);
+            yEdges.push_back(0);
+            if(offset)
+            {
+                if((width < (tileWidth/2)) || (height < (tileHeight/2)))
+                {
+                    throw RSGISImageException("Image must be larger that half tile size.");
+                }
+                xStart = tileWidth/2;
+                yStart = tileHeight/2;
+                if((xStart > 0) && (xStart < width))
+                {
+                    xEdges.push_back(xStart);
+                }
+                if((yStart > 0) && (yStart < height))
+                {
+                    yEdges.push_back(yStart);
+                }
+            }
+            for(long x = xStart + tileWidth; x < width; x += tileWidth)
+            {
+                xEdges.push_back(x);
+            }
+            xEdges.push_back(width);
+            for(long y = yStart + tileHeight; y < height; y += tileHeight)
+            {
+                yEdges.push_back(y);
+            }
+            yEdges.push_back(height);
+            long nCols = xEdges.size() - 1;
+            long nRows = yEdges.size() - 1;
+            long nCells = nCols * nRows;
+
+            // Count the valid pixels within each cell in a single pass over the image.
+            std::vector<unsigned long> validCounts(nCells, 0);
+            std::vector<long> validExtents(nCells * 4, 0);
+            std::vector<unsigned long> maskCounts;
+            this->countValidPixels(dataset, &xEdges, &yEdges, useNoData, noDataVal, &validCounts, &validExtents, maskDataset, &maskCounts);
+
+            // Summed-area table of the valid pixel counts.
+            std::vector<unsigned long> validSAT((nRows+1) * (nCols+1), 0);
+            for(long r = 0; r < nRows; ++r)
+            {
+                unsigned long rowSum = 0;
+                for(long c = 0; c < nCols; ++c)
+                {
+                    rowSum += validCounts[(r * nCols) + c];
+                    validSAT[((r+1) * (nCols+1)) + (c+1)] = validSAT[(r * (nCols+1)) + (c+1)] + rowSum;
+                }
+            }
+            auto regionValid = [&validSAT, nCols](const RSGISTileRegion &reg) -> unsigned long
+            {
+                return validSAT[((reg.r1+1) * (nCols+1)) + (reg.c1+1)] - validSAT[(reg.r0 * (nCols+1)) + (reg.c1+1)] - validSAT[((reg.r1+1) * (nCols+1)) + reg.c0] + validSAT[(reg.r0 * (nCols+1)) + reg.c0];
+            };
+            auto regionPxls = [&xEdges, &yEdges](const RSGISTileRegion &reg) -> unsigned long
+            {
+                return ((unsigned long)(xEdges[reg.c1+1] - xEdges[reg.c0])) * ((unsigned long)(yEdges[reg.r1+1] - yEdges[reg.r0]));
+            };
+            auto regionProp = [&regionValid, &regionPxls](const RSGISTileRegion &reg) -> double
+            {
+                return ((double)regionValid(reg)) / ((double)regionPxls(reg));
+            };
+
+            // Each cell starts as a region, other than those without any valid data.
+            std::vector<RSGISTileRegion> regions;
+            std::vector<long> cellRegion(nCells, -1);
+            for(long r = 0; r < nRows; ++r)
+            {
+                for(long c = 0; c < nCols; ++c)
+                {
+                    long cell = (r * nCols) + c;
+                    if(validCounts[cell] == 0)
+                    {
+                        continue;
+                    }
+                    if((maskDataset != NULL) && (maskCounts[cell] == 0))
+                    {
+                        continue;
+                    }
+                    RSGISTileRegion reg;
+                    reg.c0 = c;
+                    reg.c1 = c;
+                    reg.r0 = r;
+                    reg.r1 = r;
+                    reg.alive = true;
+                    cellRegion[cell] = regions.size();
+                    regions.push_back(reg);
+                }
+            }
+
+            // Merge the regions below the threshold, least valid first, with the smallest neighbour
+            // sharing a whole side (so the merged region is a rectangle), otherwise with the rectangle
+            // covering a neighbour and any regions it overlaps.
+            bool changed = true;
+            while(changed)
+            {
+                changed = false;
+                std::vector<std::pair<double, long> > belowThres;
+                for(size_t i = 0; i < regions.size(); ++i)
+                {
+                    if(regions[i].alive)
+                    {
+                        double prop = regionProp(regions[i]);
+                        if(prop < validThreshold)
+                        {
+                            belowThres.push_back(std::pair<double, long>(prop, i));
+                        }
+                    }
+                }
+                std::sort(belowThres.begin(), belowThres.end());
+
+                for(std::vector<std::pair<double, long> >::iterator iterReg = belowThres.begin(); iterReg != belowThres.end(); ++iterReg)
+                {
+                    RSGISTileRegion &reg = regions[iterReg->second];
+                    if((!reg.alive) || (regionProp(reg) >= validThreshold))
+                    {
+                        continue;
+                    }
+                    long candidates[4] = {-1, -1, -1, -1};
+                    if(reg.c0 > 0)
+                    {
+                        candidates[0] = cellRegion[(reg.r0 * nCols) + (reg.c0-1)];
+                    }
+                    if(reg.c1 < (nCols-1))
+                    {
+                        candidates[1] = cellRegion[(reg.r0 * nCols) + (reg.c1+1)];
+                    }
+                    if(reg.r0 > 0)
+                    {
+                        candidates[2] = cellRegion[((reg.r0-1) * nCols) + reg.c0];
+                    }
+                    if(reg.r1 < (nRows-1))
+                    {
+                        candidates[3] = cellRegion[((reg.r1+1) * nCols) + reg.c0];
+                    }
+
+                    long bestIdx = -1;
+                    unsigned long bestPxls = 0;
+                    double bestProp = 0.0;
+                    for(int n = 0; n < 4; ++n)
+                    {
+                        if(candidates[n] < 0)
+                        {
+                            continue;
+                        }
+                        RSGISTileRegion &nReg = regions[candidates[n]];
+                        bool sharesSide = (n < 2)?((nReg.r0 == reg.r0) && (nReg.r1 == reg.r1)):((nReg.c0 == reg.c0) && (nReg.c1 == reg.c1));
+                        if(!sharesSide)
+                        {
+                            continue;
+                        }
+                        RSGISTileRegion unionReg = reg;
+                        unionReg.c0 = std::min(reg.c0, nReg.c0);
+                        unionReg.c1 = std::max(reg.c1, nReg.c1);
+                        unionReg.r0 = std::min(reg.r0, nReg.r0);
+                        unionReg.r1 = std::max(reg.r1, nReg.r1);
+                        unsigned long nPxls = regionPxls(nReg);
+                        double unionProp = regionProp(unionReg);
+                        if((bestIdx < 0) || (nPxls < bestPxls) || ((nPxls == bestPxls) && (unionProp > bestProp)))
+                        {
+                            bestIdx = candidates[n];
+                            bestPxls = nPxls;
+                            bestProp = unionProp;
+                        }
+                    }
+
+                    if(bestIdx >= 0)
+                    {
+                        RSGISTileRegion &nReg = regions[bestIdx];
+                        nReg.c0 = std::min(reg.c0, nReg.c0);
+                        nReg.c1 = std::max(reg.c1, nReg.c1);
+                        nReg.r0 = std::min(reg.r0, nReg.r0);
+                        nReg.r1 = std::max(reg.r1, nReg.r1);
+                        for(long r = reg.r0; r <= reg.r1; ++r)
+                        {
+                            for(long c = reg.c0; c <= reg.c1; ++c)
+                            {
+                                cellRegion[(r * nCols) + c] = bestIdx;
+                            }
+                        }
+                        reg.alive = false;
+                        changed = true;
+                    }
+                    else
+                    {
+                        // Without a neighbour sharing a whole side, merge with the neighbour (including
+                        // diagonally) giving the smallest rectangle once any regions it overlaps are added.
+                        std::vector<long> ringIdxs;
+                        for(long r = std::max<long>(reg.r0-1, 0); r <= std::min<long>(reg.r1+1, nRows-1); ++r)
+                        {
+                            for(long c = std::max<long>(reg.c0-1, 0); c <= std::min<long>(reg.c1+1, nCols-1); ++c)
+                            {
+                                long idx = cellRegion[(r * nCols) + c];
+                                if((idx >= 0) && (idx != iterReg->second) && (std::find(ringIdxs.begin(), ringIdxs.end(), idx) == ringIdxs.end()))
+                                {
+                                    ringIdxs.push_back(idx);
+                                }
+                            }
+                        }
+
+                        std::vector<long> bestMembers;
+                        RSGISTileRegion bestReg = reg;
+                        unsigned long bestMergePxls = 0;
+                        double bestMergeProp = 0.0;
+                        for(std::vector<long>::iterator iterIdx = ringIdxs.begin(); iterIdx != ringIdxs.end(); ++iterIdx)
+                        {
+                            std::vector<long> members;
+                            members.push_back(iterReg->second);
+                            members.push_back(*iterIdx);
+                            RSGISTileRegion mergeReg = reg;
+                            mergeReg.c0 = std::min(reg.c0, regions[*iterIdx].c0);
+                            mergeReg.c1 = std::max(reg.c1, regions[*iterIdx].c1);
+                            mergeReg.r0 = std::min(reg.r0, regions[*iterIdx].r0);
+                            mergeReg.r1 = std::max(reg.r1, regions[*iterIdx].r1);
+                            bool grown = true;
+                            while(grown)
+                            {
+                                grown = false;
+                                for(long r = mergeReg.r0; r <= mergeReg.r1; ++r)
+                                {
+                                    for(long c = mergeReg.c0; c <= mergeReg.c1; ++c)
+                                    {
+                                        long idx = cellRegion[(r * nCols) + c];
+                                        if((idx >= 0) && (std::find(members.begin(), members.end(), idx) == members.end()))
+                                        {
+                                            members.push_back(idx);
+                                            if((regions[idx].c0 < mergeReg.c0) || (regions[idx].c1 > mergeReg.c1) || (regions[idx].r0 < mergeReg.r0) || (regions[idx].r1 > mergeReg.r1))
+                                            {
+                                                mergeReg.c0 = std::min(mergeReg.c0, regions[idx].c0);
+                                                mergeReg.c1 = std::max(mergeReg.c1, regions[idx].c1);
+                                                mergeReg.r0 = std::min(mergeReg.r0, regions[idx].r0);
+                                                mergeReg.r1 = std::max(mergeReg.r1, regions[idx].r1);
+                                                grown = true;
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                            unsigned long nPxls = regionPxls(mergeReg);
+                            double mergeProp = regionProp(mergeReg);
+                            if(bestMembers.empty() || (nPxls < bestMergePxls) || ((nPxls == bestMergePxls) && (mergeProp > bestMergeProp)))
+                            {
+                                bestMembers = members;
+                                bestReg = mergeReg;
+                                bestMergePxls = nPxls;
+                                bestMergeProp = mergeProp;
+                            }
+                        }
+
+                        if(!bestMembers.empty())
+                        {
+                            long keepIdx = bestMembers[1];
+                            for(std::vector<long>::iterator iterIdx = bestMembers.begin(); iterIdx != bestMembers.end(); ++iterIdx)
+                            {
+                                regions[*iterIdx].alive = false;
+                            }
+                            regions[keepIdx] = bestReg;
+                            regions[keepIdx].alive = true;
+                            for(long r = bestReg.r0; r <= bestReg.r1; ++r)
+                            {
+                                for(long c = bestReg.c0; c <= bestReg.c1; ++c)
+                                {
+                                    cellRegion[(r * nCols) + c] = keepIdx;
+                                }
+                            }
+                            changed = true;
+                        }
+                    }
+                }
+            }
+
+            // Only a region without any neighbouring regions can remain below the threshold.
+            unsigned long numBelowThres = 0;
+            for(size_t i = 0; i < regions.size(); ++i)
+            {
+                if(regions[i].alive && (regionProp(regions[i]) < validThreshold))
+                {
+                    ++numBelowThres;
+                }
+            }
+            if(numBelowThres > 0)
+            {
+                std::cerr << "Warning: " << numBelowThres << " tiles are below the valid threshold as there are no neighbouring tiles to merge them with.\n";
+            }
+
+            // Create the tiles, in row order of their top-left cell.
+            std::vector<long> regionIdxs;
+            for(size_t i = 0; i < regions.size(); ++i)
+            {
+                if(regions[i].alive)
+                {
+                    regionIdxs.push_back(i);
+                }
+            }
+            std::sort(regionIdxs.begin(), regionIdxs.end(), [&regions](long a, long b){ return (regions[a].r0 < regions[b].r0) || ((regions[a].r0 == regions[b].r0) && (regions[a].c0 < regions[b].c0)); });
+            for(std::vector<long>::iterator iterIdx = regionIdxs.begin(); iterIdx != regionIdxs.end(); ++iterIdx)
+            {
+                RSGISTileRegion &reg = regions[*iterIdx];
+                RSGISImageTile tile;
+                tile.name = std::string("x") + std::to_string(reg.c0+1) + std::string("y") + std::to_string(reg.r0+1);
+                tile.xMin = xEdges[reg.c0];
+                tile.xMax = xEdges[reg.c1+1];
+                tile.yMin = yEdges[reg.r0];
+                tile.yMax = yEdges[reg.r1+1];
+                tile.numValidPxls = regionValid(reg);
+                if(shrinkToValid)
+                {
+                    long minX = width;
+                    long maxX = -1;
+                    long minY = height;
+                    long maxY = -1;
+                    for(long r = reg.r0; r <= reg.r1; ++r)
+                    {
+                        for(long c = reg.c0; c <= reg.c1; ++c)
+                        {
+                            long cell = (r * nCols) + c;
+                            if(validCounts[cell] > 0)
+                            {
+                                minX = std::min(minX, validExtents[(cell*4)]);
+                                maxX = std::max(maxX, validExtents[(cell*4)+1]);
+                                minY = std::min(minY, validExtents[(cell*4)+2]);
+                                maxY = std::max(maxY, validExtents[(cell*4)+3]);
+                            }
+                        }
+                    }
+                    tile.xMin = minX;
+                    tile.xMax = maxX + 1;
+                    tile.yMin = minY;
+                    tile.yMax = maxY + 1;
+                }
+                tiles.push_back(tile);
+            }
+        }
+        catch(RSGISImageException &e)
+        {
+            throw e;
+        }
+        catch(std::exception &e)
+        {
+            throw RSGISImageException(e.what());
+        }
+        return tiles;
+    }
+
+    void RSGISImageTilePlanner::countValidPixels(GDALDataset *dataset, std::vector<long> *xEdges, std::vector<long> *yEdges, bool useNoData, double noDataVal, std::vector<unsigned long> *validCounts, std::vector<long> *validExtents, GDALDataset *maskDataset, std::vector<unsigned long> *maskCounts)
+    {
+        long width = dataset->GetRasterXSize();
+        long height = dataset->GetRasterYSize();
+        long nCols = xEdges->size() - 1;
+        long nRows = yEdges->size() - 1;
+        long nCells = nCols * nRows;
+        unsigned int numBands = dataset->GetRasterCount();
+        float noDataValF = noDataVal;
+
+        // The cell column of each image column and the cell row of each image row.
+        std::vector<long> colOfX(width);
+        for(long c = 0; c < nCols; ++c)
+        {
+            for(long x = (*xEdges)[c]; x < (*xEdges)[c+1]; ++x)
+            {
+                colOfX[x] = c;
+            }
+        }
+        std::vector<long> rowOfY(height);
+        for(long r = 0; r < nRows; ++r)
+        {
+            for(long y = (*yEdges)[r]; y < (*yEdges)[r+1]; ++y)
+            {
+                rowOfY[y] = r;
+            }
+        }
+
+        for(long cell = 0; cell < nCells; ++cell)
+        {
+            (*validExtents)[(cell*4)] = width;
+            (*validExtents)[(cell*4)+1] = -1;
+            (*validExtents)[(cell*4)+2] = height;
+            (*validExtents)[(cell*4)+3] = -1;
+        }
+        if(maskDataset != NULL)
+        {
+            maskCounts->assign(nCells, 0);
+        }
+
+        if(!useNoData)
+        {
+            // All the pixels are valid so the counts are the cell areas.
+            for(long r = 0; r < nRows; ++r)
+            {
+                for(long c = 0; c < nCols; ++c)
+                {
+                    long cell = (r * nCols) + c;
+                    (*validCounts)[cell] = ((unsigned long)((*xEdges)[c+1] - (*xEdges)[c])) * ((unsigned long)((*yEdges)[r+1] - (*yEdges)[r]));
+                    (*validExtents)[(cell*4)] = (*xEdges)[c];
+                    (*validExtents)[(cell*4)+1] = (*xEdges)[c+1] - 1;
+                    (*validExtents)[(cell*4)+2] = (*yEdges)[r];
+                    (*validExtents)[(cell*4)+3] = (*yEdges)[r+1] - 1;
+                }
+            }
+            if(maskDataset == NULL)
+            {
+                return;
+            }
+        }
+
+        RSGISThreadPool pool(this->numThreads);
+        std::mutex mergeMutex;
+        size_t stripPxls = ((size_t)width) * this->stripHeight;
+        std::vector<float> stripData;
+        if(useNoData)
+        {
+            stripData.resize(stripPxls * numBands);
+        }
+        std::vector<float> maskData;
+        if(maskDataset != NULL)
+        {
+            maskData.resize(stripPxls);
+        }
+
+        long nStrips = (height + this->stripHeight - 1) / this->stripHeight;
+        rsgis_tqdm pbar;
+        for(long s = 0; s < nStrips; ++s)
+        {
+            pbar.progress(s, nStrips);
+            long y0 = s * this->stripHeight;
+            long nStripRows = std::min<long>(this->stripHeight, height - y0);
+            if(useNoData)
+            {
+                for(unsigned int b = 0; b < numBands; ++b)
+                {
+                    if(dataset->GetRasterBand(b+1)->RasterIO(GF_Read, 0, y0, width, nStripRows, &stripData[b * stripPxls], width, nStripRows, GDT_Float32, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageException("Failed to read a strip from the input image.");
+                    }
+                }
+            }
+            if(maskDataset != NULL)
+            {
+                if(maskDataset->GetRasterBand(1)->RasterIO(GF_Read, 0, y0, width, nStripRows, maskData.data(), width, nStripRows, GDT_Float32, 0, 0) != CE_None)
+                {
+                    throw RSGISImageException("Failed to read a strip from the mask image.");
+                }
+            }
+
+            // The rows of the strip are counted in parallel, each chunk into its own counts which are then merged.
+            pool.parallelFor(0, nStripRows, [&](unsigned long rowStart, unsigned long rowEnd)
+            {
+                // Only the cells of the rows covered by the chunk are counted.
+                long cellOff = rowOfY[y0 + rowStart] * nCols;
+                long nChunkCells = ((rowOfY[y0 + rowEnd - 1] * nCols) + nCols) - cellOff;
+                std::vector<unsigned long> chunkCounts;
+                std::vector<long> chunkExtents;
+                std::vector<unsigned long> chunkMaskCounts;
+                if(useNoData)
+                {
+                    chunkCounts.assign(nChunkCells, 0);
+                    chunkExtents.resize(nChunkCells * 4);
+                    for(long cell = 0; cell < nChunkCells; ++cell)
+                    {
+                        chunkExtents[(cell*4)] = width;
+                        chunkExtents[(cell*4)+1] = -1;
+                        chunkExtents[(cell*4)+2] = height;
+                        chunkExtents[(cell*4)+3] = -1;
+                    }
+                }
+                if(maskDataset != NULL)
+                {
+                    chunkMaskCounts.assign(nChunkCells, 0);
+                }
+                for(unsigned long y = rowStart; y < rowEnd; ++y)
+                {
+                    long imgY = y0 + y;
+                    long rowCellOff = (rowOfY[imgY] * nCols) - cellOff;
+                    size_t rowOff = ((size_t)y) * width;
+                    for(long x = 0; x < width; ++x)
+                    {
+                        long cell = rowCellOff + colOfX[x];
+                        if(maskDataset != NULL)
+                        {
+                            float maskVal = maskData[rowOff + x];
+                            if(std::isfinite(maskVal) && (maskVal != noDataValF))
+                            {
+                                ++chunkMaskCounts[cell];
+                            }
+                        }
+                        if(useNoData)
+                        {
+                            bool valid = true;
+                            for(unsigned int b = 0; b < numBands; ++b)
+                            {
+                                float val = stripData[(b * stripPxls) + rowOff + x];
+                                if((!std::isfinite(val)) || (val == noDataValF))
+                                {
+                                    valid = false;
+                                    break;
+                                }
+                            }
+                            if(valid)
+                            {
+                                ++chunkCounts[cell];
+                                chunkExtents[(cell*4)] = std::min(chunkExtents[(cell*4)], x);
+                                chunkExtents[(cell*4)+1] = std::max(chunkExtents[(cell*4)+1], x);
+                                chunkExtents[(cell*4)+2] = std::min(chunkExtents[(cell*4)+2], imgY);
+                                chunkExtents[(cell*4)+3] = std::max(chunkExtents[(cell*4)+3], imgY);
+                            }
+                        }
+                    }
+                }
+
+                std::lock_guard<std::mutex> mergeLock(mergeMutex);
+                for(long cell = 0; cell < nChunkCells; ++cell)
+                {
+                    long gCell = cellOff + cell;
+                    if(useNoData && (chunkCounts[cell] > 0))
+                    {
+                        (*validCounts)[gCell] += chunkCounts[cell];
+                        (*validExtents)[(gCell*4)] = std::min((*validExtents)[(gCell*4)], chunkExtents[(cell*4)]);
+                        (*validExtents)[(gCell*4)+1] = std::max((*validExtents)[(gCell*4)+1], chunkExtents[(cell*4)+1]);
+                        (*validExtents)[(gCell*4)+2] = std::min((*validExtents)[(gCell*4)+2], chunkExtents[(cell*4)+2]);
+                        (*validExtents)[(gCell*4)+3] = std::max((*validExtents)[(gCell*4)+3], chunkExtents[(cell*4)+3]);
+                    }
+                    if(maskDataset != NULL)
+                    {
+                        (*maskCounts)[gCell] += chunkMaskCounts[cell];
+                    }
+                }
+            }, 16);
+        }
+        pbar.finish();
+    }
+
+    void RSGISImageTilePlanner::writeTilesImage(GDALDataset *dataset, std::vector<RSGISImageTile> *tiles, std::string outputImage, std::string gdalFormat)
+    {
+        char **papszOptions = NULL;
+        GDALDataset *outDataset = NULL;
+        try
+        {
+            long width = dataset->GetRasterXSize();
+            long height = dataset->GetRasterYSize();
+            double transform[6];
+            dataset->GetGeoTransform(transform);
+
+            GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+            if(gdalDriver == NULL)
+            {
+                throw RSGISImageException("Requested GDAL driver does not exists..");
+            }
+            RSGISImageUtils imgUtils;
+            papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+            outDataset = gdalDriver->Create(outputImage.c_str(), width, height, 1, GDT_UInt32, papszOptions);
+            if(outDataset == NULL)
+            {
+                throw RSGISImageException("Output image could not be created: " + outputImage);
+            }
+            outDataset->SetGeoTransform(transform);
+            outDataset->SetProjection(dataset->GetProjectionRef());
+            GDALRasterBand *outBand = outDataset->GetRasterBand(1);
+            outBand->SetMetadataItem("LAYER_TYPE", "thematic");
+
+            std::vector<unsigned int> stripData(((size_t)width) * this->stripHeight);
+            long nStrips = (height + this->stripHeight - 1) / this->stripHeight;
+            rsgis_tqdm pbar;
+            for(long s = 0; s < nStrips; ++s)
+            {
+                pbar.progress(s, nStrips);
+                long y0 = s * this->stripHeight;
+                long nStripRows = std::min<long>(this->stripHeight, height - y0);
+                std::fill(stripData.begin(), stripData.end(), 0);
+                for(size_t i = 0; i < tiles->size(); ++i)
+                {
+                    RSGISImageTile &tile = tiles->at(i);
+                    long tileY0 = std::max<long>(tile.yMin, y0);
+                    long tileY1 = std::min<long>(tile.yMax, y0 + nStripRows);
+                    for(long y = tileY0; y < tileY1; ++y)
+                    {
+                        unsigned int *rowData = &stripData[((size_t)(y - y0)) * width];
+                        std::fill(rowData + tile.xMin, rowData + tile.xMax, (unsigned int)(i+1));
+                    }
+                }
+                if(outBand->RasterIO(GF_Write, 0, y0, width, nStripRows, stripData.data(), width, nStripRows, GDT_UInt32, 0, 0) != CE_None)
+                {
+                    throw RSGISImageException("Failed to write a strip to the tiles image.");
+                }
+            }
+            pbar.finish();
+            GDALClose(outDataset);
+            outDataset = NULL;
+            CSLDestroy(papszOptions);
+        }
+        catch(RSGISImageException &e)
+        {
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            if(papszOptions != NULL)
+            {
+                CSLDestroy(papszOptions);
+            }
+            throw e;
+        }
+    }
+
+    std::vector<std::string> RSGISImageTilePlanner::writeTiles(std::string inputImage, std::vector<RSGISImageTile> *tiles, std::string outputImageBase, std::string outFileExtension, std::string gdalFormat, GDALDataType outDataType)
+    {
+        std::vector<std::string> outFiles;
+        char **papszOptions = NULL;
+        try
+        {
+            GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+            if(dataset == NULL)
+            {
+                throw RSGISImageException("Could not open image " + inputImage);
+            }
+            std::string inDriverName = std::string(dataset->GetDriver()->GetDescription());
+            GDALClose(dataset);
+            // HDF5 based formats cannot be read or written from more than one thread at a time.
+            this->serialiseIO = (gdalFormat == "KEA") || (gdalFormat == "HDF5") || (gdalFormat == "netCDF") || (inDriverName == "KEA") || (inDriverName == "HDF5") || (inDriverName == "netCDF");
+
+            for(std::vector<RSGISImageTile>::iterator iterTile = tiles->begin(); iterTile != tiles->end(); ++iterTile)
+            {
+                outFiles.push_back(outputImageBase + std::string("_") + (*iterTile).name + std::string(".") + outFileExtension);
+            }
+
+            RSGISImageUtils imgUtils;
+            papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+            RSGISThreadPool pool(this->numThreads);
+            for(size_t i = 0; i < tiles->size(); ++i)
+            {
+                RSGISImageTile *tile = &tiles->at(i);
+                std::string outputImage = outFiles.at(i);
+                pool.submit([this, inputImage, tile, outputImage, gdalFormat, outDataType, papszOptions]{ this->writeTile(inputImage, tile, outputImage, gdalFormat, outDataType, papszOptions); });
+            }
+            pool.waitForAll();
+            CSLDestroy(papszOptions);
+        }
+        catch(RSGISImageException &e)
+        {
+            if(papszOptions != NULL)
+            {
+                CSLDestroy(papszOptions);
+            }
+            throw e;
+        }
+        catch(std::exception &e)
+        {
+            if(papszOptions != NULL)
+            {
+                CSLDestroy(papszOptions);
+            }
+            throw RSGISImageException(e.what());
+        }
+        return outFiles;
+    }
+
+    void RSGISImageTilePlanner::writeTile(std::string inputImage, RSGISImageTile *tile, std::string outputImage, std::string gdalFormat, GDALDataType outDataType, char **papszOptions)
+    {
+        std::unique_lock<std::mutex> ioLock(this->ioMutex, std::defer_lock);
+        if(this->serialiseIO)
+        {
+            ioLock.lock();
+        }
+
+        GDALDataset *dataset = (GDALDataset *) GDALOpen(inputImage.c_str(), GA_ReadOnly);
+        if(dataset == NULL)
+        {
+            throw RSGISImageException("Could not open image " + inputImage);
+        }
+        long xSize = tile->xMax - tile->xMin;
+        long ySize = tile->yMax - tile->yMin;
+        unsigned int numBands = dataset->GetRasterCount();
+        double transform[6];
+        dataset->GetGeoTransform(transform);
+        double tileTransform[6];
+        tileTransform[0] = transform[0] + (tile->xMin * transform[1]) + (tile->yMin * transform[2]);
+        tileTransform[1] = transform[1];
+        tileTransform[2] = transform[2];
+        tileTransform[3] = transform[3] + (tile->xMin * transform[4]) + (tile->yMin * transform[5]);
+        tileTransform[4] = transform[4];
+        tileTransform[5] = transform[5];
+
+        GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+        if(gdalDriver == NULL)
+        {
+            GDALClose(dataset);
+            throw RSGISImageException("Requested GDAL driver does not exists..");
+        }
+        GDALDataset *outDataset = gdalDriver->Create(outputImage.c_str(), xSize, ySize, numBands, outDataType, papszOptions);
+        if(outDataset == NULL)
+        {
+            GDALClose(dataset);
+            throw RSGISImageException("Output image could not be created: " + outputImage);
+        }
+        outDataset->SetGeoTransform(tileTransform);
+        outDataset->SetProjection(dataset->GetProjectionRef());
+
+        int pxlBytes = GDALGetDataTypeSizeBytes(outDataType);
+        long tileStripHeight = std::min<long>(this->stripHeight, ySize);
+        std::vector<GByte> stripData(((size_t)xSize) * tileStripHeight * pxlBytes);
+        CPLErr err = CE_None;
+        for(unsigned int b = 0; (b < numBands) && (err == CE_None); ++b)
+        {
+            GDALRasterBand *inBand = dataset->GetRasterBand(b+1);
+            GDALRasterBand *outBand = outDataset->GetRasterBand(b+1);
+            int hasNoData = false;
+            double noDataVal = inBand->GetNoDataValue(&hasNoData);
+            if(hasNoData)
+            {
+                outBand->SetNoDataValue(noDataVal);
+            }
+            outBand->SetDescription(inBand->GetDescription());
+            for(long y = 0; (y < ySize) && (err == CE_None); y += tileStripHeight)
+            {
+                long nStripRows = std::min<long>(tileStripHeight, ySize - y);
+                err = inBand->RasterIO(GF_Read, tile->xMin, tile->yMin + y, xSize, nStripRows, stripData.data(), xSize, nStripRows, outDataType, 0, 0);
+                if(err == CE_None)
+                {
+                    err = outBand->RasterIO(GF_Write, 0, y, xSize, nStripRows, stripData.data(), xSize, nStripRows, outDataType, 0, 0);
+                }
+            }
+        }
+        GDALClose(outDataset);
+        GDALClose(dataset);
+        if(err != CE_None)
+        {
+            throw RSGISImageException("Failed to write the tile " + outputImage);
+        }
+    }
+
+    RSGISImageTilePlanner::~RSGISImageTilePlanner()
+    {
+
+    }
+
+}}
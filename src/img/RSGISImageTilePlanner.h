@@ -0,0 +1,112 @@
+/*
+ *  RSGISImageTilePlanner.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISImageTilePlanner_H
+#define RSGISImageTilePlanner_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <mutex>
+
+#include "gdal_priv.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadPool.h"
+
+#include "img/RSGISImageUtils.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /** A tile of an image; the pixel extent is [xMin, xMax) x [yMin, yMax) with row 0 at the top of the image. */
+    struct DllExport RSGISImageTile
+    {
+        std::string name;
+        long xMin;
+        long xMax;
+        long yMin;
+        long yMax;
+        unsigned long numValidPxls;
+    };
+
+    /**
+     * Plans and writes a tiling of an image. The image is read once, in strips, to
+     * count the valid pixels (those which are finite and not the no data value in
+     * all the bands) and find the extent of the valid pixels within each cell of a
+     * regular grid of tiles (optionally offset by half a tile). A summed-area table
+     * of the counts is then used to find the proportion of valid pixels for any
+     * rectangle of cells without reading the image again, so tiles with too little
+     * valid data can be merged with a neighbouring tile (where the union is still a
+     * rectangle) and tiles without any valid data dropped. A tile without a neighbour
+     * sharing a whole side is merged into the smallest rectangle covering it, a neighbour
+     * and any tiles that rectangle overlaps; a warning is printed for any tiles left
+     * below the threshold as they have no neighbours.
+     *
+     * The tiles are written by a pool of threads, each with its own handle on the
+     * input image.
+     */
+    class DllExport RSGISImageTilePlanner
+    {
+    public:
+        RSGISImageTilePlanner(unsigned int numThreads=0, unsigned int stripHeight=256);
+        /**
+         * Plans the tiles for the image. Tiles with a proportion of valid pixels below
+         * validThreshold are merged with a neighbour, if possible, and those without any
+         * valid pixels are removed, unless useNoData is false in which case all the pixels
+         * are valid. If a mask dataset (of the same size as the image) is provided then tiles
+         * which only contain no data in the first band of the mask are also removed. If
+         * shrinkToValid is true then each tile is reduced to the extent of its valid pixels.
+         */
+        std::vector<RSGISImageTile> planTiles(GDALDataset *dataset, unsigned int tileWidth, unsigned int tileHeight, bool offset, bool useNoData, double noDataVal, float validThreshold, GDALDataset *maskDataset, bool shrinkToValid);
+        /** Writes an image where the pixels of each tile are the index of the tile plus 1 (0 outside the tiles). */
+        void writeTilesImage(GDALDataset *dataset, std::vector<RSGISImageTile> *tiles, std::string outputImage, std::string gdalFormat);
+        /** Writes each tile of the input image to outputImageBase + "_" + tile name + "." + outFileExtension, returning the file names. */
+        std::vector<std::string> writeTiles(std::string inputImage, std::vector<RSGISImageTile> *tiles, std::string outputImageBase, std::string outFileExtension, std::string gdalFormat, GDALDataType outDataType);
+        ~RSGISImageTilePlanner();
+    protected:
+        void countValidPixels(GDALDataset *dataset, std::vector<long> *xEdges, std::vector<long> *yEdges, bool useNoData, double noDataVal, std::vector<unsigned long> *validCounts, std::vector<long> *validExtents, GDALDataset *maskDataset, std::vector<unsigned long> *maskCounts);
+        void writeTile(std::string inputImage, RSGISImageTile *tile, std::string outputImage, std::string gdalFormat, GDALDataType outDataType, char **papszOptions);
+        unsigned int numThreads;
+        unsigned int stripHeight;
+        bool serialiseIO;
+        std::mutex ioMutex;
+    };
+
+}}
+
+#endif
@@ -129,22 +129,14 @@ namespace rsgis{namespace img{
 	RSGISApplyImageMask::RSGISApplyImageMask(int numberOutBands, double outputValue, std::vector<float> maskValues) : RSGISCalcImageValue(numberOutBands)
 	{
 		this->outputValue = outputValue;
-        this->maskValues = maskValues;
+        std::vector<double> maskVals(maskValues.begin(), maskValues.end());
+        std::vector<double> lutVals(maskVals.size(), 1.0);
+        this->maskValsLUT.compile(maskVals, lutVals);
 	}
 	
 	void RSGISApplyImageMask::calcImageValue(float *bandValues, int numBands, double *output) 
 	{
-        bool foundMaskVal = false;
-        for(std::vector<float>::iterator iterVals = maskValues.begin(); iterVals != maskValues.end(); ++iterVals)
-        {
-            if(bandValues[0] == (*iterVals))
-            {
-                foundMaskVal = true;
-                break;
-            }
-        }
-        
-		if(foundMaskVal)
+		if(this->maskValsLUT.contains(bandValues[0]))
 		{
 			for(int i = 0; i < numOutBands; i++)
 			{
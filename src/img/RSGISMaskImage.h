@@ -32,6 +32,7 @@
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISImageUtils.h"
+#include "img/RSGISPixelValueLUT.h"
 
 #include "boost/math/special_functions/fpclassify.hpp"
 
@@ -68,7 +69,7 @@ namespace rsgis{namespace img{
 			~RSGISApplyImageMask();
 		protected:
 			double outputValue;
-            std::vector<float> maskValues;
+            RSGISPixelValueLUT maskValsLUT;
 		};
     
     class DllExport RSGISCreateFiniteImageMask : public RSGISCalcImageValue
@@ -0,0 +1,367 @@
+/*
+ *  RSGISMultiImageValidMask.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISMultiImageValidMask.h"
+
+namespace rsgis{namespace img{
+
+    RSGISMultiImageValidMask::RSGISMultiImageValidMask(double noDataVal, bool useImgNoData, bool checkFinite, unsigned int numThreads)
+    {
+        this->noDataVal = noDataVal;
+        this->useImgNoData = useImgNoData;
+        this->checkFinite = checkFinite;
+        this->numThreads = numThreads;
+    }
+
+    void RSGISMultiImageValidMask::calcValidMasks(std::vector<GDALDataset*> datasets, std::string outputImage, std::string outPackedImage, std::string gdalFormat)
+    {
+        unsigned int numImages = datasets.size();
+        if(numImages == 0)
+        {
+            throw RSGISImageException("At least one input image must be provided.");
+        }
+        if((outputImage == "") && (outPackedImage == ""))
+        {
+            throw RSGISImageException("At least one output image must be specified.");
+        }
+        if((outPackedImage != "") && (numImages > 32))
+        {
+            throw RSGISImageException("The validity of no more than 32 images can be packed into an output image.");
+        }
+
+        // Find the union of the image extents; all the images must share the same pixel grid.
+        double firstTrans[6];
+        datasets.at(0)->GetGeoTransform(firstTrans);
+        double xRes = firstTrans[1];
+        double yRes = firstTrans[5];
+        double tlX = firstTrans[0];
+        double tlY = firstTrans[3];
+        double brX = firstTrans[0] + (datasets.at(0)->GetRasterXSize() * xRes);
+        double brY = firstTrans[3] + (datasets.at(0)->GetRasterYSize() * yRes);
+        for(unsigned int i = 1; i < numImages; ++i)
+        {
+            double trans[6];
+            datasets.at(i)->GetGeoTransform(trans);
+            if((std::fabs(trans[1] - xRes) > std::fabs(xRes*1e-6)) || (std::fabs(trans[5] - yRes) > std::fabs(yRes*1e-6)))
+            {
+                throw RSGISImageException("All the input images must have the same pixel resolution.");
+            }
+            double xPxlOff = (trans[0] - firstTrans[0]) / xRes;
+            double yPxlOff = (trans[3] - firstTrans[3]) / yRes;
+            if((std::fabs(xPxlOff - std::round(xPxlOff)) > 0.01) || (std::fabs(yPxlOff - std::round(yPxlOff)) > 0.01))
+            {
+                throw RSGISImageException("All the input images must be on the same pixel grid.");
+            }
+            tlX = std::min(tlX, trans[0]);
+            tlY = std::max(tlY, trans[3]);
+            brX = std::max(brX, trans[0] + (datasets.at(i)->GetRasterXSize() * xRes));
+            brY = std::min(brY, trans[3] + (datasets.at(i)->GetRasterYSize() * yRes));
+        }
+        int width = (int)std::round((brX - tlX) / xRes);
+        int height = (int)std::round((brY - tlY) / yRes);
+
+        double outTrans[6];
+        outTrans[0] = tlX;
+        outTrans[1] = xRes;
+        outTrans[2] = 0.0;
+        outTrans[3] = tlY;
+        outTrans[4] = 0.0;
+        outTrans[5] = yRes;
+
+        std::vector<int> xOffs;
+        std::vector<int> yOffs;
+        std::vector< std::vector<double> > noDataVals;
+        for(unsigned int i = 0; i < numImages; ++i)
+        {
+            double trans[6];
+            datasets.at(i)->GetGeoTransform(trans);
+            xOffs.push_back((int)std::round((trans[0] - tlX) / xRes));
+            yOffs.push_back((int)std::round((trans[3] - tlY) / yRes));
+
+            // The no data value of each band, as bands can have differing no data values.
+            std::vector<double> bandNoDataVals;
+            for(int b = 0; b < datasets.at(i)->GetRasterCount(); ++b)
+            {
+                double bandNoDataVal = this->noDataVal;
+                if(this->useImgNoData)
+                {
+                    int hasNoData = false;
+                    double imgNoDataVal = datasets.at(i)->GetRasterBand(b+1)->GetNoDataValue(&hasNoData);
+                    if(hasNoData)
+                    {
+                        bandNoDataVal = imgNoDataVal;
+                    }
+                }
+                bandNoDataVals.push_back(bandNoDataVal);
+            }
+            noDataVals.push_back(bandNoDataVals);
+        }
+
+        // Summary bands use the smallest type which can hold the image count.
+        GDALDataType sumDataType = (numImages < 255)?GDT_Byte:GDT_UInt16;
+        GDALDataType packDataType = GDT_Byte;
+        if(numImages > 16)
+        {
+            packDataType = GDT_UInt32;
+        }
+        else if(numImages > 8)
+        {
+            packDataType = GDT_UInt16;
+        }
+
+        const char *projWKT = datasets.at(0)->GetProjectionRef();
+        GDALDataset *outDataset = NULL;
+        GDALDataset *outPackedDataset = NULL;
+        if(outputImage != "")
+        {
+            outDataset = this->createOutputImage(outputImage, gdalFormat, width, height, 5, sumDataType, outTrans, projWKT);
+            outDataset->GetRasterBand(1)->SetDescription("n_valid");
+            outDataset->GetRasterBand(2)->SetDescription("all_valid");
+            outDataset->GetRasterBand(3)->SetDescription("any_valid");
+            outDataset->GetRasterBand(4)->SetDescription("first_valid");
+            outDataset->GetRasterBand(5)->SetDescription("last_valid");
+        }
+        if(outPackedImage != "")
+        {
+            try
+            {
+                outPackedDataset = this->createOutputImage(outPackedImage, gdalFormat, width, height, 1, packDataType, outTrans, projWKT);
+            }
+            catch(RSGISImageException &e)
+            {
+                if(outDataset != NULL)
+                {
+                    GDALClose(outDataset);
+                }
+                throw e;
+            }
+            outPackedDataset->GetRasterBand(1)->SetDescription("valid_imgs");
+        }
+
+        int nRowsPerChunk = 256;
+        if(nRowsPerChunk > height)
+        {
+            nRowsPerChunk = height;
+        }
+        size_t nChunkPxls = ((size_t)width) * ((size_t)nRowsPerChunk);
+
+        // The images are processed one at a time into a single validity chunk so
+        // the memory used does not depend on the number of images.
+        GByte *valid = (GByte *) CPLMalloc(nChunkPxls);
+        GUInt16 *sumData = (GUInt16 *) CPLMalloc(sizeof(GUInt16)*nChunkPxls*5);
+        GUInt32 *packData = (GUInt32 *) CPLMalloc(sizeof(GUInt32)*nChunkPxls);
+
+        try
+        {
+            RSGISThreadPool threadPool(RSGISThreadPool::findNumThreads(this->numThreads));
+
+            int nChunks = (height + nRowsPerChunk - 1) / nRowsPerChunk;
+            rsgis_tqdm pbar;
+            for(int n = 0; n < nChunks; ++n)
+            {
+                pbar.progress(n, nChunks);
+                int rowStart = n * nRowsPerChunk;
+                int nRows = std::min(nRowsPerChunk, height - rowStart);
+                size_t nPxls = ((size_t)width) * ((size_t)nRows);
+
+                GUInt16 *nValid = sumData;
+                GUInt16 *allValid = &sumData[nPxls];
+                GUInt16 *anyValid = &sumData[nPxls*2];
+                GUInt16 *firstValid = &sumData[nPxls*3];
+                GUInt16 *lastValid = &sumData[nPxls*4];
+                std::memset(sumData, 0, sizeof(GUInt16)*nPxls*5);
+                std::memset(packData, 0, sizeof(GUInt32)*nPxls);
+                bool packOut = (outPackedDataset != NULL);
+                for(unsigned int i = 0; i < numImages; ++i)
+                {
+                    this->calcImgValidity(datasets.at(i), noDataVals.at(i), xOffs.at(i), yOffs.at(i), width, rowStart, nRows, valid);
+
+                    const GUInt16 imgIdx = (GUInt16)(i+1);
+                    threadPool.parallelFor(0, nPxls, [valid, nValid, firstValid, lastValid, packData, packOut, imgIdx, i](unsigned long start, unsigned long end){
+                        for(size_t j = start; j < end; ++j)
+                        {
+                            nValid[j] += valid[j];
+                            // Images are processed in order so the first valid is only set once.
+                            firstValid[j] = ((firstValid[j] == 0) && valid[j])?imgIdx:firstValid[j];
+                            lastValid[j] = valid[j]?imgIdx:lastValid[j];
+                        }
+                        if(packOut)
+                        {
+                            for(size_t j = start; j < end; ++j)
+                            {
+                                packData[j] |= ((GUInt32)valid[j]) << i;
+                            }
+                        }
+                    }, 4096);
+                }
+                for(size_t j = 0; j < nPxls; ++j)
+                {
+                    allValid[j] = (nValid[j] == numImages);
+                    anyValid[j] = (nValid[j] > 0);
+                }
+
+                if(outDataset != NULL)
+                {
+                    for(int b = 0; b < 5; ++b)
+                    {
+                        if(outDataset->GetRasterBand(b+1)->RasterIO(GF_Write, 0, rowStart, width, nRows, &sumData[nPxls*b], width, nRows, GDT_UInt16, 0, 0) != CE_None)
+                        {
+                            throw RSGISImageException("Could not write to the output image.");
+                        }
+                    }
+                }
+                if(outPackedDataset != NULL)
+                {
+                    if(outPackedDataset->GetRasterBand(1)->RasterIO(GF_Write, 0, rowStart, width, nRows, packData, width, nRows, GDT_UInt32, 0, 0) != CE_None)
+                    {
+                        throw RSGISImageException("Could not write to the output packed image.");
+                    }
+                }
+            }
+            pbar.finish();
+        }
+        catch(std::exception &e)
+        {
+            CPLFree(valid);
+            CPLFree(sumData);
+            CPLFree(packData);
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            if(outPackedDataset != NULL)
+            {
+                GDALClose(outPackedDataset);
+            }
+            throw RSGISImageException(e.what());
+        }
+
+        CPLFree(valid);
+        CPLFree(sumData);
+        CPLFree(packData);
+        if(outDataset != NULL)
+        {
+            GDALClose(outDataset);
+        }
+        if(outPackedDataset != NULL)
+        {
+            GDALClose(outPackedDataset);
+        }
+    }
+
+    void RSGISMultiImageValidMask::calcImgValidity(GDALDataset *dataset, std::vector<double> noDataVals, int xOff, int yOff, int width, int rowStart, int nRows, GByte *valid)
+    {
+        size_t nPxls = ((size_t)width) * ((size_t)nRows);
+        std::memset(valid, 0, nPxls);
+
+        // Find the region of the chunk covered by this image.
+        int imgXSize = dataset->GetRasterXSize();
+        int imgYSize = dataset->GetRasterYSize();
+        int chunkYStart = std::max(rowStart, yOff);
+        int chunkYEnd = std::min(rowStart + nRows, yOff + imgYSize);
+        if(chunkYEnd <= chunkYStart)
+        {
+            return;
+        }
+        int xStart = std::max(0, xOff);
+        int xEnd = std::min(width, xOff + imgXSize);
+        if(xEnd <= xStart)
+        {
+            return;
+        }
+        int readXSize = xEnd - xStart;
+        int readYSize = chunkYEnd - chunkYStart;
+        size_t nReadPxls = ((size_t)readXSize) * ((size_t)readYSize);
+
+        GByte *imgValid = (GByte *) CPLMalloc(nReadPxls);
+        double *inData = (double *) CPLMalloc(sizeof(double)*nReadPxls);
+        std::memset(imgValid, 1, nReadPxls);
+        int numBands = dataset->GetRasterCount();
+        for(int b = 0; b < numBands; ++b)
+        {
+            if(dataset->GetRasterBand(b+1)->RasterIO(GF_Read, xStart-xOff, chunkYStart-yOff, readXSize, readYSize, inData, readXSize, readYSize, GDT_Float64, 0, 0) != CE_None)
+            {
+                CPLFree(imgValid);
+                CPLFree(inData);
+                throw RSGISImageException("Could not read image data.");
+            }
+            double noDataVal = noDataVals.at(b);
+            if(this->checkFinite)
+            {
+                for(size_t j = 0; j < nReadPxls; ++j)
+                {
+                    imgValid[j] &= (GByte)((inData[j] != noDataVal) && std::isfinite(inData[j]));
+                }
+            }
+            else if(std::isnan(noDataVal))
+            {
+                // NaN never compares equal, so a NaN no data value must be tested for explicitly.
+                for(size_t j = 0; j < nReadPxls; ++j)
+                {
+                    imgValid[j] &= (GByte)(!std::isnan(inData[j]));
+                }
+            }
+            else
+            {
+                for(size_t j = 0; j < nReadPxls; ++j)
+                {
+                    imgValid[j] &= (GByte)(inData[j] != noDataVal);
+                }
+            }
+        }
+
+        for(int y = 0; y < readYSize; ++y)
+        {
+            size_t outRow = ((size_t)(chunkYStart - rowStart + y)) * ((size_t)width);
+            std::memcpy(&valid[outRow + xStart], &imgValid[((size_t)y) * ((size_t)readXSize)], readXSize);
+        }
+        CPLFree(imgValid);
+        CPLFree(inData);
+    }
+
+    GDALDataset* RSGISMultiImageValidMask::createOutputImage(std::string outputImage, std::string gdalFormat, int width, int height, unsigned int numBands, GDALDataType dataType, double *transform, const char *projWKT)
+    {
+        GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+        if(gdalDriver == NULL)
+        {
+            throw RSGISImageException("Requested GDAL driver does not exist.");
+        }
+
+        RSGISImageUtils imgUtils;
+        char **papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+        GDALDataset *outDataset = gdalDriver->Create(outputImage.c_str(), width, height, numBands, dataType, papszOptions);
+        CSLDestroy(papszOptions);
+        if(outDataset == NULL)
+        {
+            throw RSGISImageException("Could not create image: " + outputImage);
+        }
+        outDataset->SetGeoTransform(transform);
+        outDataset->SetProjection(projWKT);
+        return outDataset;
+    }
+
+    RSGISMultiImageValidMask::~RSGISMultiImageValidMask()
+    {
+
+    }
+
+}}
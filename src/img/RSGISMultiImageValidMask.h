@@ -0,0 +1,85 @@
+/*
+ *  RSGISMultiImageValidMask.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISMultiImageValidMask_H
+#define RSGISMultiImageValidMask_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+
+#include "gdal_priv.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadPool.h"
+
+#include "img/RSGISImageUtils.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /**
+     * Calculates the validity of a stack of images in a single blocked pass. A pixel
+     * is valid within an image if none of its bands equal the no data value (and, if
+     * checkFinite is true, all are finite), using the no data value of each band. The
+     * images are read one at a time into a chunk of rows, so the memory used does not
+     * depend on the number of images. The images must be on the same pixel grid
+     * but can have differing extents; the output covers the union of the images and
+     * pixels outside of an image are not valid for that image.
+     *
+     * The summary output has 5 bands: the number of valid images, all valid, any valid
+     * and the first and last valid image (indexed from 1, 0 if none are valid). The
+     * packed output has a single band with bit i set where image i is valid.
+     */
+    class DllExport RSGISMultiImageValidMask
+    {
+    public:
+        RSGISMultiImageValidMask(double noDataVal=0.0, bool useImgNoData=true, bool checkFinite=true, unsigned int numThreads=0);
+        void calcValidMasks(std::vector<GDALDataset*> datasets, std::string outputImage, std::string outPackedImage, std::string gdalFormat);
+        ~RSGISMultiImageValidMask();
+    protected:
+        void calcImgValidity(GDALDataset *dataset, std::vector<double> noDataVals, int xOff, int yOff, int width, int rowStart, int nRows, GByte *valid);
+        GDALDataset* createOutputImage(std::string outputImage, std::string gdalFormat, int width, int height, unsigned int numBands, GDALDataType dataType, double *transform, const char *projWKT);
+        double noDataVal;
+        bool useImgNoData;
+        bool checkFinite;
+        unsigned int numThreads;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ *  RSGISPixelCoordinates.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISPixelCoordinates.h"
+
+namespace rsgis{namespace img{
+
+    RSGISPixelCoordinates::RSGISPixelCoordinates(GDALDataset *dataset, std::string outProjWKT)
+    {
+        this->dataset = dataset;
+        this->xSize = dataset->GetRasterXSize();
+        this->ySize = dataset->GetRasterYSize();
+        this->coordTransform = NULL;
+        this->outProjWKT = outProjWKT;
+        this->stripHeight = 256;
+        dataset->GetGeoTransform(this->transform);
+
+        // Without a projection the image is assumed to be WGS84.
+        this->geographic = true;
+        this->semiMajor = 6378137.0;
+        this->invFlattening = 298.257223563;
+        std::string imgProjWKT = std::string(dataset->GetProjectionRef());
+        OGRSpatialReference imgSpatRef;
+        if(imgProjWKT != "")
+        {
+            if(imgSpatRef.importFromWkt(imgProjWKT.c_str()) != OGRERR_NONE)
+            {
+                throw RSGISImageException("Could not read the projection of the input image.");
+            }
+            this->geographic = imgSpatRef.IsGeographic();
+            if(this->geographic)
+            {
+                this->semiMajor = imgSpatRef.GetSemiMajor();
+                this->invFlattening = imgSpatRef.GetInvFlattening();
+            }
+        }
+
+        // The column terms of the pixel centre coordinates.
+        this->colX.resize(this->xSize);
+        this->colY.resize(this->xSize);
+        for(long c = 0; c < this->xSize; ++c)
+        {
+            this->colX[c] = this->transform[0] + ((c + 0.5) * this->transform[1]);
+            this->colY[c] = (c + 0.5) * this->transform[4];
+        }
+
+        if(outProjWKT != "")
+        {
+            if(imgProjWKT == "")
+            {
+                throw RSGISImageException("The input image does not have a projection so the coordinates cannot be transformed.");
+            }
+            OGRSpatialReference outSpatRef;
+            if(outSpatRef.importFromWkt(outProjWKT.c_str()) != OGRERR_NONE)
+            {
+                throw RSGISImageException("Could not read the output projection.");
+            }
+            imgSpatRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+            outSpatRef.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+            if(!imgSpatRef.IsSame(&outSpatRef))
+            {
+                this->coordTransform = OGRCreateCoordinateTransformation(&imgSpatRef, &outSpatRef);
+                if(this->coordTransform == NULL)
+                {
+                    throw RSGISImageException("Could not create a transformation from the image to the output projection.");
+                }
+            }
+        }
+    }
+
+    void RSGISPixelCoordinates::getRowCoords(long row, double *xCoords, double *yCoords)
+    {
+        double rowX = (row + 0.5) * this->transform[2];
+        double rowY = this->transform[3] + ((row + 0.5) * this->transform[5]);
+        for(long c = 0; c < this->xSize; ++c)
+        {
+            xCoords[c] = this->colX[c] + rowX;
+            yCoords[c] = this->colY[c] + rowY;
+        }
+        if(this->coordTransform != NULL)
+        {
+            if(!this->coordTransform->Transform(this->xSize, xCoords, yCoords))
+            {
+                throw RSGISImageException("Failed to transform the coordinates of row " + std::to_string(row));
+            }
+        }
+    }
+
+    double RSGISPixelCoordinates::getRowPxlArea(long row)
+    {
+        if(!this->geographic)
+        {
+            return std::fabs((this->transform[1] * this->transform[5]) - (this->transform[2] * this->transform[4]));
+        }
+        if((this->transform[2] != 0) || (this->transform[4] != 0))
+        {
+            throw RSGISImageException("The image is rotated, this is not supported for a geographic projection.");
+        }
+        double latTop = this->transform[3] + (row * this->transform[5]);
+        double latBottom = latTop + this->transform[5];
+        return RSGISPixelCoordinates::calcEllipsoidZoneArea(latTop, latBottom, this->transform[1], this->semiMajor, this->invFlattening);
+    }
+
+    void RSGISPixelCoordinates::getRowPxlSize(long row, double *xPxlSize, double *yPxlSize)
+    {
+        if(!this->geographic)
+        {
+            *xPxlSize = std::sqrt((this->transform[1] * this->transform[1]) + (this->transform[4] * this->transform[4]));
+            *yPxlSize = std::sqrt((this->transform[2] * this->transform[2]) + (this->transform[5] * this->transform[5]));
+            return;
+        }
+        if((this->transform[2] != 0) || (this->transform[4] != 0))
+        {
+            throw RSGISImageException("The image is rotated, this is not supported for a geographic projection.");
+        }
+        // Radii of curvature in the meridian and prime vertical at the latitude of the row centre.
+        double semiMinor = this->semiMajor;
+        if(this->invFlattening != 0)
+        {
+            semiMinor = this->semiMajor * (1.0 - (1.0 / this->invFlattening));
+        }
+        double radLat = (this->transform[3] + ((row + 0.5) * this->transform[5])) * (M_PI / 180.0);
+        double aCos = this->semiMajor * std::cos(radLat);
+        double bSin = semiMinor * std::sin(radLat);
+        double rSq = (aCos * aCos) + (bSin * bSin);
+        double mLat = ((this->semiMajor * semiMinor) * (this->semiMajor * semiMinor)) / std::pow(rSq, 1.5);
+        double nLon = (this->semiMajor * this->semiMajor) / std::sqrt(rSq);
+        *xPxlSize = (M_PI / 180.0) * std::cos(radLat) * nLon * std::fabs(this->transform[1]);
+        *yPxlSize = (M_PI / 180.0) * mLat * std::fabs(this->transform[5]);
+    }
+
+    double RSGISPixelCoordinates::calcEllipsoidZoneArea(double lat1, double lat2, double lonRange, double semiMajor, double invFlattening)
+    {
+        double eSq = 0.0;
+        if(invFlattening != 0)
+        {
+            double flattening = 1.0 / invFlattening;
+            eSq = flattening * (2.0 - flattening);
+        }
+        double e = std::sqrt(eSq);
+
+        // q of the authalic latitude, the area from the equator to a latitude is (a^2 / 2) * q * lonRange (in radians).
+        auto calcQ = [eSq, e](double lat) -> double
+        {
+            double sinLat = std::sin(lat * (M_PI / 180.0));
+            if(e == 0)
+            {
+                return 2.0 * sinLat;
+            }
+            double eSinLat = e * sinLat;
+            return (1.0 - eSq) * ((sinLat / (1.0 - (eSinLat * eSinLat))) - ((1.0 / (2.0 * e)) * std::log((1.0 - eSinLat) / (1.0 + eSinLat))));
+        };
+
+        double lonRangeRad = std::fabs(lonRange) * (M_PI / 180.0);
+        return ((semiMajor * semiMajor) / 2.0) * lonRangeRad * std::fabs(calcQ(lat1) - calcQ(lat2));
+    }
+
+    GDALDataset* RSGISPixelCoordinates::createOutput(std::string outputImage, std::string gdalFormat, unsigned int numBands, std::string *bandNames)
+    {
+        GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+        if(gdalDriver == NULL)
+        {
+            throw RSGISImageException("Requested GDAL driver does not exists..");
+        }
+        RSGISImageUtils imgUtils;
+        char **papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+        GDALDataset *outDataset = gdalDriver->Create(outputImage.c_str(), this->xSize, this->ySize, numBands, GDT_Float64, papszOptions);
+        CSLDestroy(papszOptions);
+        if(outDataset == NULL)
+        {
+            throw RSGISImageException("Output image could not be created: " + outputImage);
+        }
+        outDataset->SetGeoTransform(this->transform);
+        outDataset->SetProjection(this->dataset->GetProjectionRef());
+        if(bandNames != NULL)
+        {
+            for(unsigned int n = 0; n < numBands; ++n)
+            {
+                outDataset->GetRasterBand(n+1)->SetDescription(bandNames[n].c_str());
+            }
+        }
+        return outDataset;
+    }
+
+    void RSGISPixelCoordinates::writePixelLocations(std::string outputImage, std::string gdalFormat)
+    {
+        std::string bandNames[2] = {"X", "Y"};
+        GDALDataset *outDataset = this->createOutput(outputImage, gdalFormat, 2, bandNames);
+        size_t stripPxls = ((size_t)this->xSize) * this->stripHeight;
+        std::vector<double> xData(stripPxls);
+        std::vector<double> yData(stripPxls);
+        long nStrips = (this->ySize + this->stripHeight - 1) / this->stripHeight;
+        try
+        {
+            rsgis_tqdm pbar;
+            for(long s = 0; s < nStrips; ++s)
+            {
+                pbar.progress(s, nStrips);
+                long y0 = s * this->stripHeight;
+                long nRows = std::min<long>(this->stripHeight, this->ySize - y0);
+                for(long y = 0; y < nRows; ++y)
+                {
+                    this->getRowCoords(y0 + y, &xData[((size_t)y) * this->xSize], &yData[((size_t)y) * this->xSize]);
+                }
+                if((outDataset->GetRasterBand(1)->RasterIO(GF_Write, 0, y0, this->xSize, nRows, xData.data(), this->xSize, nRows, GDT_Float64, 0, 0) != CE_None) ||
+                   (outDataset->GetRasterBand(2)->RasterIO(GF_Write, 0, y0, this->xSize, nRows, yData.data(), this->xSize, nRows, GDT_Float64, 0, 0) != CE_None))
+                {
+                    throw RSGISImageException("Failed to write the pixel locations to " + outputImage);
+                }
+            }
+            pbar.finish();
+        }
+        catch(RSGISImageException &e)
+        {
+            GDALClose(outDataset);
+            throw e;
+        }
+        GDALClose(outDataset);
+    }
+
+    void RSGISPixelCoordinates::writePixelAreas(std::string outputImage, std::string gdalFormat, double scale)
+    {
+        if(scale == 0)
+        {
+            throw RSGISImageException("The scale for the pixel areas cannot be zero.");
+        }
+        std::string bandNames[1] = {"PxlArea"};
+        GDALDataset *outDataset = this->createOutput(outputImage, gdalFormat, 1, bandNames);
+        std::vector<double> areaData(((size_t)this->xSize) * this->stripHeight);
+        long nStrips = (this->ySize + this->stripHeight - 1) / this->stripHeight;
+        try
+        {
+            rsgis_tqdm pbar;
+            for(long s = 0; s < nStrips; ++s)
+            {
+                pbar.progress(s, nStrips);
+                long y0 = s * this->stripHeight;
+                long nRows = std::min<long>(this->stripHeight, this->ySize - y0);
+                for(long y = 0; y < nRows; ++y)
+                {
+                    double rowArea = this->getRowPxlArea(y0 + y) / scale;
+                    std::fill(areaData.begin() + (((size_t)y) * this->xSize), areaData.begin() + (((size_t)(y+1)) * this->xSize), rowArea);
+                }
+                if(outDataset->GetRasterBand(1)->RasterIO(GF_Write, 0, y0, this->xSize, nRows, areaData.data(), this->xSize, nRows, GDT_Float64, 0, 0) != CE_None)
+                {
+                    throw RSGISImageException("Failed to write the pixel areas to " + outputImage);
+                }
+            }
+            pbar.finish();
+        }
+        catch(RSGISImageException &e)
+        {
+            GDALClose(outDataset);
+            throw e;
+        }
+        GDALClose(outDataset);
+    }
+
+    void RSGISPixelCoordinates::writePixelSizes(std::string outputImage, std::string gdalFormat)
+    {
+        std::string bandNames[2] = {"XSize", "YSize"};
+        GDALDataset *outDataset = this->createOutput(outputImage, gdalFormat, 2, bandNames);
+        size_t stripPxls = ((size_t)this->xSize) * this->stripHeight;
+        std::vector<double> xData(stripPxls);
+        std::vector<double> yData(stripPxls);
+        long nStrips = (this->ySize + this->stripHeight - 1) / this->stripHeight;
+        try
+        {
+            rsgis_tqdm pbar;
+            for(long s = 0; s < nStrips; ++s)
+            {
+                pbar.progress(s, nStrips);
+                long y0 = s * this->stripHeight;
+                long nRows = std::min<long>(this->stripHeight, this->ySize - y0);
+                for(long y = 0; y < nRows; ++y)
+                {
+                    double xPxlSize = 0.0;
+                    double yPxlSize = 0.0;
+                    this->getRowPxlSize(y0 + y, &xPxlSize, &yPxlSize);
+                    std::fill(xData.begin() + (((size_t)y) * this->xSize), xData.begin() + (((size_t)(y+1)) * this->xSize), xPxlSize);
+                    std::fill(yData.begin() + (((size_t)y) * this->xSize), yData.begin() + (((size_t)(y+1)) * this->xSize), yPxlSize);
+                }
+                if((outDataset->GetRasterBand(1)->RasterIO(GF_Write, 0, y0, this->xSize, nRows, xData.data(), this->xSize, nRows, GDT_Float64, 0, 0) != CE_None) ||
+                   (outDataset->GetRasterBand(2)->RasterIO(GF_Write, 0, y0, this->xSize, nRows, yData.data(), this->xSize, nRows, GDT_Float64, 0, 0) != CE_None))
+                {
+                    throw RSGISImageException("Failed to write the pixel sizes to " + outputImage);
+                }
+            }
+            pbar.finish();
+        }
+        catch(RSGISImageException &e)
+        {
+            GDALClose(outDataset);
+            throw e;
+        }
+        GDALClose(outDataset);
+    }
+
+    RSGISPixelCoordinates::~RSGISPixelCoordinates()
+    {
+        if(this->coordTransform != NULL)
+        {
+            OGRCoordinateTransformation::DestroyCT(this->coordTransform);
+        }
+    }
+
+}}
@@ -0,0 +1,110 @@
+/*
+ *  RSGISPixelCoordinates.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISPixelCoordinates_H
+#define RSGISPixelCoordinates_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+
+#include "gdal_priv.h"
+#include "ogr_spatialref.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+
+#include "img/RSGISImageUtils.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /**
+     * Provides the coordinates, sizes and areas of the pixels of an image a row at a time.
+     * The column terms of the geotransform are calculated once, so the coordinates of a row
+     * are a sum of two precomputed arrays, and if an output projection is given the row is
+     * transformed with a single call to the coordinate transformation.
+     *
+     * For a geographic image the pixel areas are the area of the ellipsoid between the
+     * latitudes of the top and bottom of the row (which is the same for every pixel in the
+     * row), calculated analytically using the authalic latitude, and the pixel sizes (in
+     * metres) are from the radii of curvature at the latitude of the row. For a projected
+     * image the areas and sizes are from the geotransform.
+     */
+    class DllExport RSGISPixelCoordinates
+    {
+    public:
+        /** If outProjWKT is not empty the coordinates are transformed to that projection. */
+        RSGISPixelCoordinates(GDALDataset *dataset, std::string outProjWKT="");
+        long getXSize(){return this->xSize;};
+        long getYSize(){return this->ySize;};
+        bool isGeographic(){return this->geographic;};
+        /** Fills xCoords and yCoords (of length xSize) with the coordinates of the pixel centres in the row. */
+        void getRowCoords(long row, double *xCoords, double *yCoords);
+        /** Returns the area of the pixels in the row (in metres squared if geographic). */
+        double getRowPxlArea(long row);
+        /** Returns the size of the pixels in the row (in metres if geographic). */
+        void getRowPxlSize(long row, double *xPxlSize, double *yPxlSize);
+        /** Writes a 2 band image with the X and Y coordinates of the pixel centres. */
+        void writePixelLocations(std::string outputImage, std::string gdalFormat);
+        /** Writes an image with the area of each pixel divided by scale. */
+        void writePixelAreas(std::string outputImage, std::string gdalFormat, double scale);
+        /** Writes a 2 band image with the X and Y size of each pixel. */
+        void writePixelSizes(std::string outputImage, std::string gdalFormat);
+        /**
+         * Returns the area of the ellipsoid between two latitudes over a range of longitude (all
+         * in degrees) for the ellipsoid defined by its semi-major axis and inverse flattening.
+         */
+        static double calcEllipsoidZoneArea(double lat1, double lat2, double lonRange, double semiMajor, double invFlattening);
+        ~RSGISPixelCoordinates();
+    protected:
+        GDALDataset *createOutput(std::string outputImage, std::string gdalFormat, unsigned int numBands, std::string *bandNames);
+        GDALDataset *dataset;
+        long xSize;
+        long ySize;
+        double transform[6];
+        bool geographic;
+        double semiMajor;
+        double invFlattening;
+        std::vector<double> colX;
+        std::vector<double> colY;
+        OGRCoordinateTransformation *coordTransform;
+        std::string outProjWKT;
+        unsigned int stripHeight;
+    };
+
+}}
+
+#endif
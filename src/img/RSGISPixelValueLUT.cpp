@@ -0,0 +1,174 @@
+/*
+ *  RSGISPixelValueLUT.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISPixelValueLUT.h"
+
+namespace rsgis{namespace img{
+
+    RSGISPixelValueLUT::RSGISPixelValueLUT()
+    {
+        this->dense = false;
+        this->numVals = 0;
+        this->denseMin = 0.0;
+        this->denseMax = 0.0;
+        this->denseMinIdx = 0;
+        this->hashMask = 0;
+    }
+
+    RSGISPixelValueLUT::RSGISPixelValueLUT(const std::vector<double> &inVals, const std::vector<double> &outVals, size_t maxDenseSize)
+    {
+        this->compile(inVals, outVals, maxDenseSize);
+    }
+
+    void RSGISPixelValueLUT::compile(const std::vector<double> &inVals, const std::vector<double> &outVals, size_t maxDenseSize)
+    {
+        if(inVals.size() != outVals.size())
+        {
+            throw RSGISImageException("The number of input and output LUT values must be the same.");
+        }
+
+        this->dense = false;
+        this->numVals = 0;
+        this->denseMin = 0.0;
+        this->denseMax = 0.0;
+        this->denseMinIdx = 0;
+        this->denseVals.clear();
+        this->denseSet.clear();
+        this->hashMask = 0;
+        this->hashKeys.clear();
+        this->hashVals.clear();
+        this->hashSet.clear();
+
+        // Check whether the values are integers within a bounded range.
+        bool allInts = true;
+        bool first = true;
+        double minVal = 0.0;
+        double maxVal = 0.0;
+        size_t nMatchVals = 0;
+        for(size_t i = 0; i < inVals.size(); ++i)
+        {
+            if(std::isnan(inVals[i]))
+            {
+                continue;
+            }
+            ++nMatchVals;
+            if((!std::isfinite(inVals[i])) || (std::floor(inVals[i]) != inVals[i]) || (std::fabs(inVals[i]) > 9.0e15))
+            {
+                allInts = false;
+                break;
+            }
+            if(first)
+            {
+                minVal = inVals[i];
+                maxVal = inVals[i];
+                first = false;
+            }
+            else if(inVals[i] < minVal)
+            {
+                minVal = inVals[i];
+            }
+            else if(inVals[i] > maxVal)
+            {
+                maxVal = inVals[i];
+            }
+        }
+
+        if(first)
+        {
+            // No values which could be matched.
+            return;
+        }
+
+        // The dense array is only used if it is not much larger than the number of
+        // values (or small regardless), so a few widely spaced values use the hash table.
+        double denseRange = (maxVal - minVal) + 1.0;
+        double maxDenseRange = std::max<double>(65536.0, 8.0 * nMatchVals);
+        if(allInts && ((maxVal - minVal) < ((double)maxDenseSize)) && (denseRange <= maxDenseRange))
+        {
+            this->dense = true;
+            this->denseMin = minVal;
+            this->denseMax = maxVal;
+            this->denseMinIdx = (int64_t)minVal;
+            size_t nDense = (size_t)(maxVal - minVal) + 1;
+            this->denseVals.resize(nDense, 0.0);
+            this->denseSet.resize(nDense, 0);
+            for(size_t i = 0; i < inVals.size(); ++i)
+            {
+                if(std::isnan(inVals[i]))
+                {
+                    continue;
+                }
+                size_t idx = (size_t)(((int64_t)inVals[i]) - this->denseMinIdx);
+                if(!this->denseSet[idx])
+                {
+                    this->denseVals[idx] = outVals[i];
+                    this->denseSet[idx] = 1;
+                    ++this->numVals;
+                }
+            }
+        }
+        else
+        {
+            // Keep the load factor at or below 0.5.
+            size_t capacity = 16;
+            while(capacity < (inVals.size() * 2))
+            {
+                capacity *= 2;
+            }
+            this->hashMask = capacity - 1;
+            this->hashKeys.resize(capacity, 0.0);
+            this->hashVals.resize(capacity, 0.0);
+            this->hashSet.resize(capacity, 0);
+            for(size_t i = 0; i < inVals.size(); ++i)
+            {
+                if(std::isnan(inVals[i]))
+                {
+                    continue;
+                }
+                size_t idx = RSGISPixelValueLUT::hashValue(inVals[i]) & this->hashMask;
+                bool found = false;
+                while(this->hashSet[idx])
+                {
+                    if(this->hashKeys[idx] == inVals[i])
+                    {
+                        found = true;
+                        break;
+                    }
+                    idx = (idx + 1) & this->hashMask;
+                }
+                if(!found)
+                {
+                    this->hashKeys[idx] = inVals[i];
+                    this->hashVals[idx] = outVals[i];
+                    this->hashSet[idx] = 1;
+                    ++this->numVals;
+                }
+            }
+        }
+    }
+
+    RSGISPixelValueLUT::~RSGISPixelValueLUT()
+    {
+
+    }
+
+}}
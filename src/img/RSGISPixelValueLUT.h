@@ -0,0 +1,153 @@
+/*
+ *  RSGISPixelValueLUT.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISPixelValueLUT_H
+#define RSGISPixelValueLUT_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#include "common/RSGISImageException.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /**
+     * A lookup table from pixel values to output values which is compiled once
+     * so a lookup is O(1). If all the input values are integers within a range of
+     * no more than maxDenseSize values, and the range is no more than 8 times the
+     * number of values (or 65536), a dense array indexed by value is used,
+     * otherwise an open addressing hash table. Where an input value is repeated
+     * the first entry is used; NaN input values are never matched.
+     */
+    class DllExport RSGISPixelValueLUT
+    {
+    public:
+        RSGISPixelValueLUT();
+        RSGISPixelValueLUT(const std::vector<double> &inVals, const std::vector<double> &outVals, size_t maxDenseSize=16777216);
+        void compile(const std::vector<double> &inVals, const std::vector<double> &outVals, size_t maxDenseSize=16777216);
+        inline bool lookup(double val, double *outVal) const
+        {
+            if(this->dense)
+            {
+                if(std::isnan(val) || (val < this->denseMin) || (val > this->denseMax))
+                {
+                    return false;
+                }
+                int64_t idx = ((int64_t)val) - this->denseMinIdx;
+                if((((double)(idx + this->denseMinIdx)) != val) || (!this->denseSet[idx]))
+                {
+                    return false;
+                }
+                *outVal = this->denseVals[idx];
+                return true;
+            }
+            if(this->hashKeys.empty() || std::isnan(val))
+            {
+                return false;
+            }
+            size_t idx = RSGISPixelValueLUT::hashValue(val) & this->hashMask;
+            while(this->hashSet[idx])
+            {
+                if(this->hashKeys[idx] == val)
+                {
+                    *outVal = this->hashVals[idx];
+                    return true;
+                }
+                idx = (idx + 1) & this->hashMask;
+            }
+            return false;
+        };
+        inline bool contains(double val) const
+        {
+            double outVal = 0.0;
+            return this->lookup(val, &outVal);
+        };
+        /** Relabels nPxls values, where a value is not in the LUT the input value is copied. */
+        template<typename T> void apply(const T *inData, double *outData, size_t nPxls) const
+        {
+            double outVal = 0.0;
+            for(size_t i = 0; i < nPxls; ++i)
+            {
+                if(this->lookup((double)inData[i], &outVal))
+                {
+                    outData[i] = outVal;
+                }
+                else
+                {
+                    outData[i] = (double)inData[i];
+                }
+            }
+        };
+        bool isDense() const{return this->dense;};
+        size_t size() const{return this->numVals;};
+        ~RSGISPixelValueLUT();
+    protected:
+        static inline size_t hashValue(double val)
+        {
+            // -0.0 == 0.0 so both must have the same hash.
+            if(val == 0.0)
+            {
+                val = 0.0;
+            }
+            uint64_t bits = 0;
+            std::memcpy(&bits, &val, sizeof(double));
+            bits ^= bits >> 33;
+            bits *= 0xff51afd7ed558ccdULL;
+            bits ^= bits >> 33;
+            bits *= 0xc4ceb9fe1a85ec53ULL;
+            bits ^= bits >> 33;
+            return (size_t)bits;
+        };
+        bool dense;
+        size_t numVals;
+        double denseMin;
+        double denseMax;
+        int64_t denseMinIdx;
+        std::vector<double> denseVals;
+        std::vector<unsigned char> denseSet;
+        size_t hashMask;
+        std::vector<double> hashKeys;
+        std::vector<double> hashVals;
+        std::vector<unsigned char> hashSet;
+    };
+
+}}
+
+#endif
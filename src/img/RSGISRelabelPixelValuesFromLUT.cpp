@@ -26,34 +26,211 @@
 
 namespace rsgis { namespace img {
 
-    RSGISRelabelPixelValuesFromLUT::RSGISRelabelPixelValuesFromLUT()
+    RSGISRelabelPixelValuesFromLUT::RSGISRelabelPixelValuesFromLUT(unsigned int numThreads)
     {
-        
+        this->numThreads = numThreads;
     }
     
-    void RSGISRelabelPixelValuesFromLUT::relabelPixelValues(GDALDataset *inData, std::string outputFile, std::string matrixLUTFile, std::string imageFormat)
+    void RSGISRelabelPixelValuesFromLUT::relabelPixelValues(GDALDataset *inData, std::string outputFile, std::string matrixLUTFile, std::string imageFormat, GDALDataType outDataType)
     {
         try
         {
             rsgis::math::RSGISMatrices matrixUtils;
-            gsl_matrix *lut = matrixUtils.readGSLMatrixFromGridTxt(matrixLUTFile);
-            
-			RSGISCalcImageValue *calcImageValue = new RSGISRelabelPixelValuesFromLUTCalcVal(inData->GetRasterCount(), lut);            
-            RSGISCalcImage calcImage = RSGISCalcImage(calcImageValue, "", true);
+            gsl_matrix *lutMatrix = matrixUtils.readGSLMatrixFromGridTxt(matrixLUTFile);
+            RSGISPixelValueLUT lut;
+            try
+            {
+                lut = RSGISRelabelPixelValuesFromLUT::compileLUT(lutMatrix);
+            }
+            catch(RSGISException &e)
+            {
+                gsl_matrix_free(lutMatrix);
+                throw;
+            }
+            gsl_matrix_free(lutMatrix);
             
-            GDALDataset **datasets = new GDALDataset*[1];
-            datasets[0] = inData;
+            this->relabelPixelValues(inData, outputFile, lut, imageFormat, outDataType);
+        }
+        catch(RSGISImageCalcException &e)
+        {
+            throw;
+        }
+        catch(RSGISException &e)
+        {
+            throw RSGISImageCalcException(e.what());
+        }
+    }
+    
+    void RSGISRelabelPixelValuesFromLUT::relabelPixelValues(GDALDataset *inData, std::string outputFile, const RSGISPixelValueLUT &lut, std::string imageFormat, GDALDataType outDataType)
+    {
+        GDALDataset *outDataset = NULL;
+        try
+        {
+            int numBands = inData->GetRasterCount();
+            if(numBands < 1)
+            {
+                throw RSGISImageCalcException("The input image does not have any image bands.");
+            }
             
-            calcImage.calcImage(datasets, 1, outputFile, false, NULL, imageFormat);
+            GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(imageFormat.c_str());
+            if(gdalDriver == NULL)
+            {
+                throw RSGISImageCalcException("Requested GDAL driver does not exists..");
+            }
+            RSGISImageUtils imgUtils;
+            char **papszOptions = imgUtils.getGDALCreationOptionsForFormat(imageFormat);
+            outDataset = gdalDriver->Create(outputFile.c_str(), inData->GetRasterXSize(), inData->GetRasterYSize(), numBands, outDataType, papszOptions);
+            CSLDestroy(papszOptions);
+            if(outDataset == NULL)
+            {
+                throw RSGISImageCalcException("Output image could not be created. Check filepath.");
+            }
+            double *trans = new double[6];
+            inData->GetGeoTransform(trans);
+            outDataset->SetGeoTransform(trans);
+            delete[] trans;
+            outDataset->SetProjection(inData->GetProjectionRef());
             
-            delete[] datasets;
-            delete calcImageValue;
-            gsl_matrix_free(lut);
+            RSGISThreadPool threadPool(this->numThreads);
+            for(int n = 0; n < numBands; ++n)
+            {
+                std::cout << "Relabelling band " << (n+1) << " of " << numBands << std::endl;
+                GDALRasterBand *inBand = inData->GetRasterBand(n+1);
+                GDALRasterBand *outBand = outDataset->GetRasterBand(n+1);
+                outBand->SetDescription(inBand->GetDescription());
+                switch(inBand->GetRasterDataType())
+                {
+                    case GDT_Byte:
+                        this->relabelBand<GByte>(inBand, outBand, lut, &threadPool);
+                        break;
+                    case GDT_UInt16:
+                        this->relabelBand<GUInt16>(inBand, outBand, lut, &threadPool);
+                        break;
+                    case GDT_Int16:
+                        this->relabelBand<GInt16>(inBand, outBand, lut, &threadPool);
+                        break;
+                    case GDT_UInt32:
+                        this->relabelBand<GUInt32>(inBand, outBand, lut, &threadPool);
+                        break;
+                    case GDT_Int32:
+                        this->relabelBand<GInt32>(inBand, outBand, lut, &threadPool);
+                        break;
+                    case GDT_Float32:
+                        this->relabelBand<float>(inBand, outBand, lut, &threadPool);
+                        break;
+                    default:
+                        this->relabelBand<double>(inBand, outBand, lut, &threadPool);
+                        break;
+                }
+            }
+        }
+        catch(RSGISImageCalcException &e)
+        {
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
+            throw;
         }
         catch(RSGISException &e)
         {
+            if(outDataset != NULL)
+            {
+                GDALClose(outDataset);
+            }
             throw RSGISImageCalcException(e.what());
         }
+        GDALClose(outDataset);
+    }
+    
+    template<typename T> void RSGISRelabelPixelValuesFromLUT::relabelBand(GDALRasterBand *inBand, GDALRasterBand *outBand, const RSGISPixelValueLUT &lut, RSGISThreadPool *pool)
+    {
+        int xSize = inBand->GetXSize();
+        int ySize = inBand->GetYSize();
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        inBand->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        // Read whole rows of blocks, at least 256 lines at a time.
+        int nRowsPerRead = yBlockSize;
+        while(nRowsPerRead < 256)
+        {
+            nRowsPerRead += yBlockSize;
+        }
+        if(nRowsPerRead > ySize)
+        {
+            nRowsPerRead = ySize;
+        }
+        size_t nBlockPxls = ((size_t)xSize) * ((size_t)nRowsPerRead);
+        GDALDataType inDataType = inBand->GetRasterDataType();
+        if(std::is_same<T, double>::value)
+        {
+            inDataType = GDT_Float64;
+        }
+        
+        T *inData = (T *) CPLMalloc(sizeof(T)*nBlockPxls);
+        double *outData = (double *) CPLMalloc(sizeof(double)*nBlockPxls);
+        try
+        {
+            int nReads = (ySize + nRowsPerRead - 1) / nRowsPerRead;
+            rsgis_tqdm pbar;
+            for(int n = 0; n < nReads; ++n)
+            {
+                pbar.progress(n, nReads);
+                int yOff = n * nRowsPerRead;
+                int nRows = nRowsPerRead;
+                if((yOff + nRows) > ySize)
+                {
+                    nRows = ySize - yOff;
+                }
+                size_t nPxls = ((size_t)xSize) * ((size_t)nRows);
+                
+                if(inBand->RasterIO(GF_Read, 0, yOff, xSize, nRows, inData, xSize, nRows, inDataType, 0, 0) != CE_None)
+                {
+                    throw RSGISImageCalcException("Could not read image data.");
+                }
+                
+                pool->parallelFor(0, nPxls, [&](unsigned long startIdx, unsigned long endIdx)
+                {
+                    lut.apply<T>(inData+startIdx, outData+startIdx, endIdx-startIdx);
+                }, 65536);
+                
+                if(outBand->RasterIO(GF_Write, 0, yOff, xSize, nRows, outData, xSize, nRows, GDT_Float64, 0, 0) != CE_None)
+                {
+                    throw RSGISImageCalcException("Could not write image data.");
+                }
+            }
+            pbar.finish();
+        }
+        catch(RSGISException &e)
+        {
+            CPLFree(inData);
+            CPLFree(outData);
+            throw;
+        }
+        CPLFree(inData);
+        CPLFree(outData);
+    }
+    
+    RSGISPixelValueLUT RSGISRelabelPixelValuesFromLUT::compileLUT(gsl_matrix *lut)
+    {
+        if(lut->size2 < 2)
+        {
+            throw RSGISImageCalcException("The LUT must have at least two columns (input and output values).");
+        }
+        std::vector<double> inVals;
+        std::vector<double> outVals;
+        inVals.reserve(lut->size1);
+        outVals.reserve(lut->size1);
+        for(size_t j = 0; j < lut->size1; ++j)
+        {
+            inVals.push_back(gsl_matrix_get(lut, j, 0));
+            outVals.push_back(gsl_matrix_get(lut, j, 1));
+        }
+        return RSGISPixelValueLUT(inVals, outVals);
     }
     
     RSGISRelabelPixelValuesFromLUT::~RSGISRelabelPixelValuesFromLUT()
@@ -65,7 +242,7 @@ namespace rsgis { namespace img {
 
     RSGISRelabelPixelValuesFromLUTCalcVal::RSGISRelabelPixelValuesFromLUTCalcVal(int numOutBands, gsl_matrix *lut):RSGISCalcImageValue(numOutBands)
     {
-        this->lut = lut;
+        this->lut = RSGISRelabelPixelValuesFromLUT::compileLUT(lut);
     }
 		
     void RSGISRelabelPixelValuesFromLUTCalcVal::calcImageValue(float *bandValues, int numBands, double *output) 
@@ -74,25 +251,7 @@ namespace rsgis { namespace img {
         {
             throw RSGISImageCalcException("The number of output and input image bands should be the same.");
         }
-        bool found = false;
-        for(int i = 0; i < numBands; ++i)
-        {
-            found = false;
-            for(int j = 0; j < lut->size1; ++j)
-            {
-                if(gsl_matrix_get(lut, j, 0) == bandValues[i])
-                {
-                    output[i] = gsl_matrix_get(lut, j, 1);
-                    found = true;
-                    break;
-                }
-            }
-            if(!found)
-            {
-                output[i] = bandValues[i];
-            }
-        }
-        
+        this->lut.apply<float>(bandValues, output, numBands);
     }
     
     
@@ -26,11 +26,17 @@
 
 #include <cmath>
 #include <limits>
+#include <vector>
+#include <type_traits>
 
 #include "img/RSGISCalcImage.h"
 #include "img/RSGISCalcImageValue.h"
 #include "img/RSGISImageBandException.h"
 #include "img/RSGISImageCalcException.h"
+#include "img/RSGISPixelValueLUT.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISThreadPool.h"
 
 #include "math/RSGISMatrices.h"
 
@@ -51,12 +57,23 @@
 
 namespace rsgis { namespace img {
 	
+    /**
+     * Relabels all the bands of an image using a LUT (column 0 the input value and column 1
+     * the output value). The LUT is compiled once (see RSGISPixelValueLUT) and blocks of each
+     * band are read in their native data type and relabelled on a pool of threads. Values
+     * not within the LUT are copied to the output.
+     */
     class DllExport RSGISRelabelPixelValuesFromLUT
     {
     public:
-        RSGISRelabelPixelValuesFromLUT();
-        void relabelPixelValues(GDALDataset *inData, std::string outputFile, std::string matrixLUTFile, std::string imageFormat);
+        RSGISRelabelPixelValuesFromLUT(unsigned int numThreads=0);
+        void relabelPixelValues(GDALDataset *inData, std::string outputFile, std::string matrixLUTFile, std::string imageFormat, GDALDataType outDataType=GDT_Float32);
+        void relabelPixelValues(GDALDataset *inData, std::string outputFile, const RSGISPixelValueLUT &lut, std::string imageFormat, GDALDataType outDataType=GDT_Float32);
+        static RSGISPixelValueLUT compileLUT(gsl_matrix *lut);
         ~RSGISRelabelPixelValuesFromLUT();
+    protected:
+        template<typename T> void relabelBand(GDALRasterBand *inBand, GDALRasterBand *outBand, const RSGISPixelValueLUT &lut, RSGISThreadPool *pool);
+        unsigned int numThreads;
     };
     
 	
@@ -67,7 +84,7 @@ namespace rsgis { namespace img {
 		void calcImageValue(float *bandValues, int numBands, double *output);
 		~RSGISRelabelPixelValuesFromLUTCalcVal();
 	private:
-		gsl_matrix *lut;
+		RSGISPixelValueLUT lut;
 	};
 	
 }}
@@ -0,0 +1,320 @@
+/*
+ *  RSGISScratchRaster.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISScratchRaster.h"
+
+#include <vector>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <fcntl.h>
+#endif
+
+namespace rsgis{namespace img{
+
+    std::mutex RSGISScratchRaster::budgetMutex;
+    bool RSGISScratchRaster::budgetInit = false;
+    size_t RSGISScratchRaster::memBudget = ((size_t)1024) * 1024 * 1024;
+    size_t RSGISScratchRaster::memInUse = 0;
+    std::string RSGISScratchRaster::scratchDir = "";
+
+    RSGISScratchRaster::RSGISScratchRaster(GDALDataset *refDataset, unsigned int numBands, GDALDataType dataType)
+    {
+        if(refDataset == NULL)
+        {
+            throw RSGISImageException("The reference dataset for the scratch raster is not valid.");
+        }
+        this->width = refDataset->GetRasterXSize();
+        this->height = refDataset->GetRasterYSize();
+        this->numBands = numBands;
+        this->dataType = dataType;
+        this->haveGeoRef = (refDataset->GetGeoTransform(this->geoTransform) == CE_None);
+        if(refDataset->GetProjectionRef() != NULL)
+        {
+            this->projection = std::string(refDataset->GetProjectionRef());
+        }
+        this->allocate();
+    }
+
+    RSGISScratchRaster::RSGISScratchRaster(unsigned int width, unsigned int height, unsigned int numBands, GDALDataType dataType)
+    {
+        this->width = width;
+        this->height = height;
+        this->numBands = numBands;
+        this->dataType = dataType;
+        this->haveGeoRef = false;
+        this->projection = "";
+        this->allocate();
+    }
+
+    void RSGISScratchRaster::allocate()
+    {
+        this->data = NULL;
+        this->fileBacked = false;
+        this->dataset = NULL;
+#ifdef _WIN32
+        this->fileHandle = NULL;
+        this->mapHandle = NULL;
+#endif
+        int typeSize = GDALGetDataTypeSizeBytes(this->dataType);
+        if((this->width == 0) || (this->height == 0) || (this->numBands == 0) || (typeSize <= 0))
+        {
+            throw RSGISImageException("A scratch raster must have a size of at least 1 x 1 x 1 and a valid data type.");
+        }
+        this->bandBytes = ((size_t)this->width) * ((size_t)this->height) * ((size_t)typeSize);
+        this->totalBytes = this->bandBytes * this->numBands;
+
+        bool inRAM = false;
+        {
+            std::lock_guard<std::mutex> lock(budgetMutex);
+            initBudget();
+            if((memInUse + this->totalBytes) <= memBudget)
+            {
+                memInUse += this->totalBytes;
+                inRAM = true;
+            }
+        }
+
+        if(inRAM)
+        {
+            this->data = (unsigned char*)std::calloc(this->totalBytes, 1);
+            if(this->data == NULL)
+            {
+                std::lock_guard<std::mutex> lock(budgetMutex);
+                memInUse -= this->totalBytes;
+                inRAM = false;
+            }
+        }
+        if(!inRAM)
+        {
+            this->mapFile(this->totalBytes);
+        }
+    }
+
+    void RSGISScratchRaster::initBudget()
+    {
+        if(budgetInit)
+        {
+            return;
+        }
+        const char *budgetOpt = CPLGetConfigOption("RSGISLIB_SCRATCH_MEM_MB", NULL);
+        if(budgetOpt != NULL)
+        {
+            double budgetMB = std::atof(budgetOpt);
+            memBudget = (budgetMB > 0)?((size_t)(budgetMB * 1024 * 1024)):0;
+        }
+        const char *dirOpt = CPLGetConfigOption("RSGISLIB_SCRATCH_DIR", NULL);
+        if((dirOpt != NULL) && (scratchDir == ""))
+        {
+            scratchDir = std::string(dirOpt);
+        }
+        budgetInit = true;
+    }
+
+    void RSGISScratchRaster::mapFile(size_t nBytes)
+    {
+        std::string dir = getScratchDir();
+#ifdef _WIN32
+        char tmpPath[MAX_PATH];
+        if(GetTempFileNameA(dir.c_str(), "rsg", 0, tmpPath) == 0)
+        {
+            throw RSGISImageException("Could not create a scratch file in " + dir);
+        }
+        HANDLE hFile = CreateFileA(tmpPath, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+        if(hFile == INVALID_HANDLE_VALUE)
+        {
+            throw RSGISImageException("Could not create a scratch file in " + dir);
+        }
+        unsigned long long mapSize = nBytes;
+        HANDLE hMap = CreateFileMappingA(hFile, NULL, PAGE_READWRITE, (DWORD)(mapSize >> 32), (DWORD)(mapSize & 0xFFFFFFFF), NULL);
+        if(hMap == NULL)
+        {
+            CloseHandle(hFile);
+            throw RSGISImageException("Could not map the scratch file.");
+        }
+        void *mapData = MapViewOfFile(hMap, FILE_MAP_ALL_ACCESS, 0, 0, nBytes);
+        if(mapData == NULL)
+        {
+            CloseHandle(hMap);
+            CloseHandle(hFile);
+            throw RSGISImageException("Could not map the scratch file.");
+        }
+        this->fileHandle = hFile;
+        this->mapHandle = hMap;
+#else
+        std::string pathTemplate = dir + "/rsgislib_scratch_XXXXXX";
+        std::vector<char> filePath(pathTemplate.begin(), pathTemplate.end());
+        filePath.push_back('\0');
+        int fd = mkstemp(filePath.data());
+        if(fd < 0)
+        {
+            throw RSGISImageException("Could not create a scratch file in " + dir);
+        }
+        // Remove the file name straight away, the file is deleted when it is unmapped.
+        unlink(filePath.data());
+        if(ftruncate(fd, (off_t)nBytes) != 0)
+        {
+            close(fd);
+            throw RSGISImageException("Could not allocate the scratch file in " + dir);
+        }
+        void *mapData = mmap(NULL, nBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if(mapData == MAP_FAILED)
+        {
+            throw RSGISImageException("Could not map the scratch file.");
+        }
+#endif
+        this->data = (unsigned char*)mapData;
+        this->fileBacked = true;
+    }
+
+    void RSGISScratchRaster::unmapFile()
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(this->data);
+        CloseHandle((HANDLE)this->mapHandle);
+        CloseHandle((HANDLE)this->fileHandle);
+#else
+        munmap(this->data, this->totalBytes);
+#endif
+        this->data = NULL;
+    }
+
+    GDALDataset* RSGISScratchRaster::getDataset()
+    {
+        if(this->dataset != NULL)
+        {
+            return this->dataset;
+        }
+        GDALDriver *memDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+        if(memDriver == NULL)
+        {
+            throw RSGISImageException("The GDAL MEM driver is not available.");
+        }
+        GDALDataset *memDataset = memDriver->Create("", this->width, this->height, 0, this->dataType, NULL);
+        if(memDataset == NULL)
+        {
+            throw RSGISImageException("Could not create a MEM dataset for the scratch raster.");
+        }
+        for(unsigned int n = 0; n < this->numBands; ++n)
+        {
+            char pointerStr[64];
+            int strLen = CPLPrintPointer(pointerStr, this->data + (n * this->bandBytes), sizeof(pointerStr)-1);
+            pointerStr[strLen] = '\0';
+            char **bandOptions = CSLSetNameValue(NULL, "DATAPOINTER", pointerStr);
+            CPLErr err = memDataset->AddBand(this->dataType, bandOptions);
+            CSLDestroy(bandOptions);
+            if(err != CE_None)
+            {
+                GDALClose(memDataset);
+                throw RSGISImageException("Could not add a band to the scratch raster dataset.");
+            }
+        }
+        if(this->haveGeoRef)
+        {
+            memDataset->SetGeoTransform(this->geoTransform);
+        }
+        memDataset->SetProjection(this->projection.c_str());
+        this->dataset = memDataset;
+        return this->dataset;
+    }
+
+    void* RSGISScratchRaster::getBandData(unsigned int band)
+    {
+        if((band == 0) || (band > this->numBands))
+        {
+            throw RSGISImageException("Band is not within the scratch raster, band numbers start at 1.");
+        }
+        return this->data + ((band-1) * this->bandBytes);
+    }
+
+    void RSGISScratchRaster::setMemoryBudget(size_t nBytes)
+    {
+        std::lock_guard<std::mutex> lock(budgetMutex);
+        initBudget();
+        memBudget = nBytes;
+    }
+
+    size_t RSGISScratchRaster::getMemoryBudget()
+    {
+        std::lock_guard<std::mutex> lock(budgetMutex);
+        initBudget();
+        return memBudget;
+    }
+
+    void RSGISScratchRaster::setScratchDir(std::string dir)
+    {
+        std::lock_guard<std::mutex> lock(budgetMutex);
+        initBudget();
+        scratchDir = dir;
+    }
+
+    std::string RSGISScratchRaster::getScratchDir()
+    {
+        std::string dir = "";
+        {
+            std::lock_guard<std::mutex> lock(budgetMutex);
+            initBudget();
+            dir = scratchDir;
+        }
+        if(dir == "")
+        {
+#ifdef _WIN32
+            char tmpDir[MAX_PATH+1];
+            DWORD dirLen = GetTempPathA(MAX_PATH+1, tmpDir);
+            dir = (dirLen > 0)?std::string(tmpDir, dirLen):std::string(".");
+#else
+            const char *tmpDirEnv = std::getenv("TMPDIR");
+            dir = (tmpDirEnv != NULL)?std::string(tmpDirEnv):std::string("/tmp");
+#endif
+        }
+        return dir;
+    }
+
+    RSGISScratchRaster::~RSGISScratchRaster()
+    {
+        // The MEM dataset does not own the band data.
+        if(this->dataset != NULL)
+        {
+            GDALClose(this->dataset);
+            this->dataset = NULL;
+        }
+        if(this->data != NULL)
+        {
+            if(this->fileBacked)
+            {
+                this->unmapFile();
+            }
+            else
+            {
+                std::free(this->data);
+                this->data = NULL;
+                std::lock_guard<std::mutex> lock(budgetMutex);
+                memInUse -= this->totalBytes;
+            }
+        }
+    }
+
+}}
@@ -0,0 +1,130 @@
+/*
+ *  RSGISScratchRaster.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISScratchRaster_H
+#define RSGISScratchRaster_H
+
+#include <iostream>
+#include <string>
+#include <mutex>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+#include "common/RSGISImageException.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /**
+     * A typed raster for intermediate results which does not go through a GDAL
+     * file driver. The bands are held band sequential (each band a contiguous
+     * row major array) in RAM, or in a memory mapped temporary file once the
+     * scratch rasters in RAM would exceed the memory budget. The file is
+     * removed as soon as it is created (i.e., it only exists while mapped), so
+     * it is cleaned up however the process ends. The values are initialised to
+     * zero.
+     *
+     * getDataset() provides a GDAL MEM dataset over the buffer (with the size,
+     * geotransform and projection of the reference dataset, if given) so the
+     * scratch raster can be passed to RSGISCalcImage etc. in place of a
+     * temporary image.
+     *
+     * The budget (default 1024 MB) and the directory for the files (default the
+     * system temporary directory) can be set with the RSGISLIB_SCRATCH_MEM_MB and
+     * RSGISLIB_SCRATCH_DIR environment variables / GDAL config options, or with
+     * setMemoryBudget and setScratchDir.
+     */
+    class DllExport RSGISScratchRaster
+    {
+    public:
+        RSGISScratchRaster(GDALDataset *refDataset, unsigned int numBands, GDALDataType dataType);
+        RSGISScratchRaster(unsigned int width, unsigned int height, unsigned int numBands, GDALDataType dataType);
+        /** A MEM dataset over the buffer, which is owned by the scratch raster (do not close it). */
+        GDALDataset* getDataset();
+        /** The data for a band (starting at 1) as width x height values of the data type. */
+        void* getBandData(unsigned int band);
+        template<typename T> T* getRow(unsigned int band, unsigned int row)
+        {
+            return ((T*)this->getBandData(band)) + (((size_t)row) * this->width);
+        };
+        unsigned int getWidth(){return this->width;};
+        unsigned int getHeight(){return this->height;};
+        unsigned int getNumBands(){return this->numBands;};
+        GDALDataType getDataType(){return this->dataType;};
+        bool isFileBacked(){return this->fileBacked;};
+        static void setMemoryBudget(size_t nBytes);
+        static size_t getMemoryBudget();
+        static void setScratchDir(std::string dir);
+        static std::string getScratchDir();
+        ~RSGISScratchRaster();
+    protected:
+        void allocate();
+        void mapFile(size_t nBytes);
+        void unmapFile();
+        /** Reads the budget and directory from the config options on first use (budgetMutex must be held). */
+        static void initBudget();
+        unsigned int width;
+        unsigned int height;
+        unsigned int numBands;
+        GDALDataType dataType;
+        size_t bandBytes;
+        size_t totalBytes;
+        unsigned char *data;
+        bool fileBacked;
+        GDALDataset *dataset;
+        bool haveGeoRef;
+        double geoTransform[6];
+        std::string projection;
+#ifdef _WIN32
+        void *fileHandle;
+        void *mapHandle;
+#endif
+        static std::mutex budgetMutex;
+        static bool budgetInit;
+        static size_t memBudget;
+        static size_t memInUse;
+        static std::string scratchDir;
+    private:
+        RSGISScratchRaster(const RSGISScratchRaster&);
+        RSGISScratchRaster& operator=(const RSGISScratchRaster&);
+    };
+
+}}
+
+#endif
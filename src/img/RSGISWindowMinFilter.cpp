@@ -0,0 +1,238 @@
+/*
+ *  RSGISWindowMinFilter.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISWindowMinFilter.h"
+
+namespace rsgis{namespace img{
+
+    RSGISWindowMinFilter::RSGISWindowMinFilter(const std::vector<float> &structElem, unsigned int winSize, bool excludeCentre)
+    {
+        this->init(structElem, winSize, excludeCentre);
+    }
+
+    RSGISWindowMinFilter::RSGISWindowMinFilter(unsigned int winSize, bool excludeCentre)
+    {
+        std::vector<float> structElem(winSize*winSize, 1.0);
+        this->init(structElem, winSize, excludeCentre);
+    }
+
+    void RSGISWindowMinFilter::init(const std::vector<float> &structElem, unsigned int winSize, bool excludeCentre)
+    {
+        if((winSize % 2) == 0)
+        {
+            throw RSGISImageException("The window size must be an odd number.");
+        }
+        if(structElem.size() != (winSize*winSize))
+        {
+            throw RSGISImageException("The structuring element must have winSize x winSize values.");
+        }
+        this->winSize = winSize;
+        int winMid = (winSize-1)/2;
+        for(int r = 0; r < (int)winSize; ++r)
+        {
+            int runStart = -1;
+            for(int c = 0; c <= (int)winSize; ++c)
+            {
+                bool inWin = false;
+                if(c < (int)winSize)
+                {
+                    inWin = structElem[(r*winSize)+c] > 0;
+                    if(excludeCentre && (r == winMid) && (c == winMid))
+                    {
+                        inWin = false;
+                    }
+                }
+                if(inWin && (runStart < 0))
+                {
+                    runStart = c;
+                }
+                else if((!inWin) && (runStart >= 0))
+                {
+                    this->runs[std::pair<int, int>(runStart-winMid, (c-1)-winMid)].push_back(r-winMid);
+                    runStart = -1;
+                }
+            }
+        }
+    }
+
+    void RSGISWindowMinFilter::filter(const float *in, float *out, unsigned int width, unsigned int height, float outsideVal)
+    {
+        size_t nPxls = ((size_t)width) * ((size_t)height);
+        const float maxVal = std::numeric_limits<float>::infinity();
+        std::fill(out, out+nPxls, maxVal);
+        if(nPxls == 0)
+        {
+            return;
+        }
+        this->rowMins.resize(nPxls);
+        this->colMins.resize(nPxls);
+
+        for(std::map<std::pair<int, int>, std::vector<int> >::iterator iterRuns = this->runs.begin(); iterRuns != this->runs.end(); ++iterRuns)
+        {
+            this->filterRows(in, this->rowMins.data(), width, height, iterRuns->first.first, iterRuns->first.second, outsideVal);
+
+            // Apply each block of consecutive rows containing the run along the columns.
+            std::vector<int> &rowOffs = iterRuns->second;
+            size_t blockStart = 0;
+            for(size_t i = 1; i <= rowOffs.size(); ++i)
+            {
+                if((i == rowOffs.size()) || (rowOffs[i] != (rowOffs[i-1]+1)))
+                {
+                    this->filterCols(this->rowMins.data(), this->colMins.data(), width, height, rowOffs[blockStart], rowOffs[i-1], outsideVal);
+                    for(size_t n = 0; n < nPxls; ++n)
+                    {
+                        out[n] = std::min(out[n], this->colMins[n]);
+                    }
+                    blockStart = i;
+                }
+            }
+        }
+    }
+
+    void RSGISWindowMinFilter::filterRows(const float *in, float *out, unsigned int width, unsigned int height, int a, int b, float outsideVal)
+    {
+        int len = (b - a) + 1;
+        int nPad = width + len - 1;
+        this->gBuf.resize(nPad);
+        this->hBuf.resize(nPad);
+        float *g = this->gBuf.data();
+        float *h = this->hBuf.data();
+        for(unsigned int y = 0; y < height; ++y)
+        {
+            const float *inRow = in + (((size_t)y) * width);
+            float *outRow = out + (((size_t)y) * width);
+            // Padded index i holds the input value at i + a.
+            for(int i = 0; i < nPad; ++i)
+            {
+                int x = i + a;
+                float val = ((x >= 0) && (x < (int)width))?inRow[x]:outsideVal;
+                g[i] = ((i % len) == 0)?val:std::min(g[i-1], val);
+            }
+            for(int i = nPad-1; i >= 0; --i)
+            {
+                int x = i + a;
+                float val = ((x >= 0) && (x < (int)width))?inRow[x]:outsideVal;
+                h[i] = (((i % len) == (len-1)) || (i == (nPad-1)))?val:std::min(h[i+1], val);
+            }
+            for(unsigned int x = 0; x < width; ++x)
+            {
+                outRow[x] = std::min(h[x], g[x+len-1]);
+            }
+        }
+    }
+
+    void RSGISWindowMinFilter::filterCols(const float *in, float *out, unsigned int width, unsigned int height, int a, int b, float outsideVal)
+    {
+        // As filterRows but a whole row at a time so the inner loops are over contiguous memory.
+        int len = (b - a) + 1;
+        int nPad = height + len - 1;
+        this->gBuf.resize(((size_t)nPad) * width);
+        this->hBuf.resize(((size_t)nPad) * width);
+        float *g = this->gBuf.data();
+        float *h = this->hBuf.data();
+        for(int i = 0; i < nPad; ++i)
+        {
+            int y = i + a;
+            float *gRow = g + (((size_t)i) * width);
+            if((y < 0) || (y >= (int)height))
+            {
+                if((i % len) == 0)
+                {
+                    std::fill(gRow, gRow+width, outsideVal);
+                }
+                else
+                {
+                    const float *gPrevRow = gRow - width;
+                    for(unsigned int x = 0; x < width; ++x)
+                    {
+                        gRow[x] = std::min(gPrevRow[x], outsideVal);
+                    }
+                }
+                continue;
+            }
+            const float *inRow = in + (((size_t)y) * width);
+            if((i % len) == 0)
+            {
+                std::copy(inRow, inRow+width, gRow);
+            }
+            else
+            {
+                const float *gPrevRow = gRow - width;
+                for(unsigned int x = 0; x < width; ++x)
+                {
+                    gRow[x] = std::min(gPrevRow[x], inRow[x]);
+                }
+            }
+        }
+        for(int i = nPad-1; i >= 0; --i)
+        {
+            int y = i + a;
+            float *hRow = h + (((size_t)i) * width);
+            bool blockEnd = ((i % len) == (len-1)) || (i == (nPad-1));
+            if((y < 0) || (y >= (int)height))
+            {
+                if(blockEnd)
+                {
+                    std::fill(hRow, hRow+width, outsideVal);
+                }
+                else
+                {
+                    const float *hNextRow = hRow + width;
+                    for(unsigned int x = 0; x < width; ++x)
+                    {
+                        hRow[x] = std::min(hNextRow[x], outsideVal);
+                    }
+                }
+                continue;
+            }
+            const float *inRow = in + (((size_t)y) * width);
+            if(blockEnd)
+            {
+                std::copy(inRow, inRow+width, hRow);
+            }
+            else
+            {
+                const float *hNextRow = hRow + width;
+                for(unsigned int x = 0; x < width; ++x)
+                {
+                    hRow[x] = std::min(hNextRow[x], inRow[x]);
+                }
+            }
+        }
+        for(unsigned int y = 0; y < height; ++y)
+        {
+            const float *hRow = h + (((size_t)y) * width);
+            const float *gRow = g + (((size_t)(y+len-1)) * width);
+            float *outRow = out + (((size_t)y) * width);
+            for(unsigned int x = 0; x < width; ++x)
+            {
+                outRow[x] = std::min(hRow[x], gRow[x]);
+            }
+        }
+    }
+
+    RSGISWindowMinFilter::~RSGISWindowMinFilter()
+    {
+
+    }
+
+}}
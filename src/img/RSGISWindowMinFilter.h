@@ -0,0 +1,93 @@
+/*
+ *  RSGISWindowMinFilter.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISWindowMinFilter_H
+#define RSGISWindowMinFilter_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <limits>
+#include <algorithm>
+
+#include "common/RSGISImageException.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_img_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace img{
+
+    /**
+     * A minimum filter (greyscale erosion) with a flat structuring element whose
+     * cost does not depend on the window size. The structuring element is split
+     * into horizontal runs; each distinct run is applied along the rows and each
+     * block of consecutive rows sharing a run along the columns, both using the
+     * van Herk/Gil-Werman algorithm (3 comparisons per pixel for any length). For
+     * a square window this is a separable erosion.
+     *
+     * By default pixels outside the image are ignored (i.e., treated as +infinity)
+     * and the caller should set values to be ignored (e.g., no data) to +infinity.
+     * The input must not contain NaN.
+     */
+    class DllExport RSGISWindowMinFilter
+    {
+    public:
+        /**
+         * structElem is a winSize x winSize row-major mask, where values > 0 are
+         * part of the window. If excludeCentre the centre pixel is not included.
+         */
+        RSGISWindowMinFilter(const std::vector<float> &structElem, unsigned int winSize, bool excludeCentre=false);
+        /** A square window of size winSize. */
+        RSGISWindowMinFilter(unsigned int winSize, bool excludeCentre=false);
+        /**
+         * in and out are width x height row-major arrays and must not overlap.
+         * outsideVal is the value of the pixels outside the image.
+         */
+        void filter(const float *in, float *out, unsigned int width, unsigned int height, float outsideVal=std::numeric_limits<float>::infinity());
+        ~RSGISWindowMinFilter();
+    protected:
+        void init(const std::vector<float> &structElem, unsigned int winSize, bool excludeCentre);
+        void filterRows(const float *in, float *out, unsigned int width, unsigned int height, int a, int b, float outsideVal);
+        void filterCols(const float *in, float *out, unsigned int width, unsigned int height, int a, int b, float outsideVal);
+        unsigned int winSize;
+        // The horizontal runs [a, b] of the window, each with the (sorted) row offsets they occur on.
+        std::map<std::pair<int, int>, std::vector<int> > runs;
+        std::vector<float> gBuf;
+        std::vector<float> hBuf;
+        std::vector<float> rowMins;
+        std::vector<float> colMins;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ *  RSGISBaysianStatsCache.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISBaysianStatsCache.h"
+
+namespace rsgis{namespace math{
+
+    RSGISBaysianStatsCache::RSGISBaysianStatsCache(double tolerance, size_t maxEntries)
+    {
+        this->tolerance = (tolerance > 0.0)?tolerance:0.0;
+        this->maxEntries = maxEntries;
+    }
+
+    float RSGISBaysianStatsCache::binValue(float value) const
+    {
+        if((this->tolerance == 0.0) || (!std::isfinite(value)))
+        {
+            return value;
+        }
+        return (float)(std::floor((((double)value) / this->tolerance) + 0.5) * this->tolerance);
+    }
+
+    bool RSGISBaysianStatsCache::lookup(float value, double *outVals)
+    {
+        uint64_t key = 0;
+        if(!this->getKey(value, &key))
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(this->cacheMutex);
+        std::unordered_map<uint64_t, std::array<double, 3> >::const_iterator iterCache = this->cache.find(key);
+        if(iterCache == this->cache.end())
+        {
+            return false;
+        }
+        outVals[0] = iterCache->second[0];
+        outVals[1] = iterCache->second[1];
+        outVals[2] = iterCache->second[2];
+        return true;
+    }
+
+    bool RSGISBaysianStatsCache::insert(float value, const double *outVals)
+    {
+        uint64_t key = 0;
+        if(!this->getKey(value, &key))
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(this->cacheMutex);
+        if(this->cache.size() >= this->maxEntries)
+        {
+            return false;
+        }
+        std::array<double, 3> vals = {{outVals[0], outVals[1], outVals[2]}};
+        this->cache[key] = vals;
+        return true;
+    }
+
+    size_t RSGISBaysianStatsCache::size()
+    {
+        std::lock_guard<std::mutex> lock(this->cacheMutex);
+        return this->cache.size();
+    }
+
+    void RSGISBaysianStatsCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(this->cacheMutex);
+        this->cache.clear();
+    }
+
+    bool RSGISBaysianStatsCache::getKey(float value, uint64_t *key) const
+    {
+        if(std::isnan(value))
+        {
+            return false;
+        }
+        if(this->tolerance == 0.0)
+        {
+            // -0.0 == 0.0 so both must have the same key.
+            if(value == 0.0f)
+            {
+                value = 0.0f;
+            }
+            uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(float));
+            *key = bits;
+            return true;
+        }
+        double bin = std::floor((((double)value) / this->tolerance) + 0.5);
+        if((!std::isfinite(bin)) || (std::fabs(bin) > 9.0e15))
+        {
+            return false;
+        }
+        *key = (uint64_t)((int64_t)bin);
+        return true;
+    }
+
+    RSGISBaysianStatsCache::~RSGISBaysianStatsCache()
+    {
+
+    }
+
+}}
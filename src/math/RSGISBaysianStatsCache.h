@@ -0,0 +1,80 @@
+/*
+ *  RSGISBaysianStatsCache.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISBaysianStatsCache_H
+#define RSGISBaysianStatsCache_H
+
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_maths_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace math{
+
+    /**
+     * A thread safe cache of the posterior summary (maximum likelihood, lower
+     * and upper values) for each input value, so the numerical integration is
+     * only done once per distinct value. If tolerance is zero values are matched
+     * exactly, otherwise values are quantised into bins of width tolerance and
+     * the posterior is calculated for the bin centre (see binValue). Once the
+     * cache holds maxEntries values no more are added and callers should fall
+     * back to calculating the posterior directly.
+     */
+    class DllExport RSGISBaysianStatsCache
+    {
+    public:
+        RSGISBaysianStatsCache(double tolerance=0.0, size_t maxEntries=1048576);
+        /** Returns the value for which the posterior should be calculated. */
+        float binValue(float value) const;
+        bool lookup(float value, double *outVals);
+        /** Returns false if the value could not be added (i.e., the cache is full). */
+        bool insert(float value, const double *outVals);
+        size_t size();
+        void clear();
+        ~RSGISBaysianStatsCache();
+    protected:
+        bool getKey(float value, uint64_t *key) const;
+        double tolerance;
+        size_t maxEntries;
+        std::unordered_map<uint64_t, std::array<double, 3> > cache;
+        std::mutex cacheMutex;
+    };
+
+}}
+
+#endif
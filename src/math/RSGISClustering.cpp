@@ -25,99 +25,106 @@
 
 namespace rsgis {namespace math{
 
-    void RSGISClusterer::calcDataRanges(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max)
+    std::vector< RSGISClusterCentre >* RSGISClusterer::calcClusterCentres(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange)
     {
-        bool first = true;
-        std::vector< std::vector<float> >::iterator iterFeatures;
-        for(iterFeatures = input->begin(); iterFeatures != input->end(); ++iterFeatures)
+        std::vector<float> data;
+        data.reserve(input->size() * numFeatures);
+        for(std::vector< std::vector<float> >::iterator iterFeatures = input->begin(); iterFeatures != input->end(); ++iterFeatures)
         {
-            if(first)
+            if((*iterFeatures).size() < numFeatures)
+            {
+                throw RSGISClustererException("Input data point has fewer than the number of features.");
+            }
+            data.insert(data.end(), (*iterFeatures).begin(), (*iterFeatures).begin()+numFeatures);
+        }
+        RSGISClusterDataView view;
+        view.data = data.data();
+        view.numPts = input->size();
+        view.numFeatures = numFeatures;
+        return this->calcClusterCentres(view, numClusters, maxNumIterations, degreeOfChange);
+    }
+    
+    void RSGISClusterer::calcDataRanges(const RSGISClusterDataView &input, float *min, float *max)
+    {
+        unsigned int numFeatures = input.numFeatures;
+        for(size_t n = 0; n < input.numPts; ++n)
+        {
+            const float *pt = input.point(n);
+            if(n == 0)
             {
                 for(unsigned int i = 0; i < numFeatures; ++i)
                 {
-                    min[i] = (*iterFeatures)[i];
-                    max[i] = (*iterFeatures)[i];
+                    min[i] = pt[i];
+                    max[i] = pt[i];
                 }
-                first = false;
             }
             else
             {
                 for(unsigned int i = 0; i < numFeatures; ++i)
                 {
-                    if((*iterFeatures)[i] < min[i])
+                    if(pt[i] < min[i])
                     {
-                         min[i] = (*iterFeatures)[i];
+                         min[i] = pt[i];
                     }
-                    else if((*iterFeatures)[i] > max[i])
+                    else if(pt[i] > max[i])
                     {
-                        max[i] = (*iterFeatures)[i];
+                        max[i] = pt[i];
                     }
                 }
             }
         }
     }
     
-    void RSGISClusterer::calcDataStats(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max, float *mean, float *stddev)
+    void RSGISClusterer::calcDataStats(const RSGISClusterDataView &input, float *min, float *max, float *mean, float *stddev)
     {
-        bool first = true;
-        std::vector< std::vector<float> >::iterator iterFeatures;
-        for(iterFeatures = input->begin(); iterFeatures != input->end(); ++iterFeatures)
+        unsigned int numFeatures = input.numFeatures;
+        for(size_t n = 0; n < input.numPts; ++n)
         {
-            if(first)
+            const float *pt = input.point(n);
+            if(n == 0)
             {
                 for(unsigned int i = 0; i < numFeatures; ++i)
                 {
-                    min[i] = (*iterFeatures)[i];
-                    max[i] = (*iterFeatures)[i];
-                    mean[i] = (*iterFeatures)[i];
+                    min[i] = pt[i];
+                    max[i] = pt[i];
+                    mean[i] = pt[i];
                 }
-                first = false;
             }
             else
             {
                 for(unsigned int i = 0; i < numFeatures; ++i)
                 {
-                    if((*iterFeatures)[i] < min[i])
+                    if(pt[i] < min[i])
                     {
-                        min[i] = (*iterFeatures)[i];
+                        min[i] = pt[i];
                     }
-                    else if((*iterFeatures)[i] > max[i])
+                    else if(pt[i] > max[i])
                     {
-                        max[i] = (*iterFeatures)[i];
+                        max[i] = pt[i];
                     }
-                    mean[i] += (*iterFeatures)[i];
+                    mean[i] += pt[i];
                 }
             }
         }
         
         for(unsigned int i = 0; i < numFeatures; ++i)
         {
-            mean[i] = mean[i]/input->size();
+            mean[i] = mean[i]/input.numPts;
+            stddev[i] = 0;
         }
         
-        first = true;
-        for(iterFeatures = input->begin(); iterFeatures != input->end(); ++iterFeatures)
+        for(size_t n = 0; n < input.numPts; ++n)
         {
-            if(first)
-            {
-                for(unsigned int i = 0; i < numFeatures; ++i)
-                {
-                    stddev[i] = (((*iterFeatures)[i] - mean[i]) * ((*iterFeatures)[i] - mean[i]));
-                }
-                first = false;
-            }
-            else
+            const float *pt = input.point(n);
+            for(unsigned int i = 0; i < numFeatures; ++i)
             {
-                for(unsigned int i = 0; i < numFeatures; ++i)
-                {
-                    stddev[i] += (((*iterFeatures)[i] - mean[i]) * ((*iterFeatures)[i] - mean[i]));
-                }
+                stddev[i] += ((pt[i] - mean[i]) * (pt[i] - mean[i]));
             }
         }
         
         for(unsigned int i = 0; i < numFeatures; ++i)
         {
-            stddev[i] = sqrt(stddev[i]/input->size());
+            stddev[i] = sqrt(stddev[i]/input.numPts);
         }
         
     }
@@ -159,15 +166,16 @@ namespace rsgis {namespace math{
         return clusterCentres;
     }
     
-    std::vector< RSGISClusterCentre >* RSGISClusterer::initializeClusterCentresRandom(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters)
+    std::vector< RSGISClusterCentre >* RSGISClusterer::initializeClusterCentresRandom(const RSGISClusterDataView &input, unsigned int numClusters)
     {
+        unsigned int numFeatures = input.numFeatures;
         std::vector< RSGISClusterCentre > *clusterCentres = new std::vector< RSGISClusterCentre >();
         clusterCentres->reserve(numClusters);
         
         RSGISPsudoRandDistroUniformDouble probDist(0, 1);
         
         unsigned int sampleIndex = 0;
-        size_t numVals = input->size(); 
+        size_t numVals = input.numPts;
         
         if(numVals < numClusters)
         {
@@ -203,7 +211,7 @@ namespace rsgis {namespace math{
                     sameSeed = true;
                     for(unsigned int j = 0; j < numFeatures; ++j)
                     {
-                        if(input->at(*iterIdxs)[j] != input->at(sampleIndex)[j])
+                        if(input.point(*iterIdxs)[j] != input.point(sampleIndex)[j])
                         {
                             sameSeed = false;
                         }
@@ -224,7 +232,7 @@ namespace rsgis {namespace math{
                 }
             }
             
-            std::vector<float> sample = input->at(sampleIndex);
+            const float *sample = input.point(sampleIndex);
             
             for(unsigned int j = 0; j < numFeatures; ++j)
             {
@@ -401,8 +409,9 @@ namespace rsgis {namespace math{
         return clusterCentres;
     }
     
-    std::vector< RSGISClusterCentre >* RSGISClusterer::initializeClusterCentresDiagonal(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max, unsigned int numClusters)
+    std::vector< RSGISClusterCentre >* RSGISClusterer::initializeClusterCentresDiagonal(const RSGISClusterDataView &input, float *min, float *max, unsigned int numClusters)
     {
+        unsigned int numFeatures = input.numFeatures;
         std::vector< RSGISClusterCentre > *clusterCentres = new std::vector< RSGISClusterCentre >();
         clusterCentres->reserve(numClusters);
         try 
@@ -430,7 +439,7 @@ namespace rsgis {namespace math{
                     cCentre.stdDev.push_back(0);
                 }
 
-                this->assign2ClosestDataPoint(&cCentre, input, numFeatures, clusterCentres);
+                this->assign2ClosestDataPoint(&cCentre, input, clusterCentres);
                 clusterCentres->push_back(cCentre);
             }
             
@@ -444,8 +453,9 @@ namespace rsgis {namespace math{
         return clusterCentres;
     }
     
-    std::vector< RSGISClusterCentre >* RSGISClusterer::initializeClusterCentresDiagonal(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max, float *mean, float *stddev, unsigned int numClusters)
+    std::vector< RSGISClusterCentre >* RSGISClusterer::initializeClusterCentresDiagonal(const RSGISClusterDataView &input, float *min, float *max, float *mean, float *stddev, unsigned int numClusters)
     {
+        unsigned int numFeatures = input.numFeatures;
         std::vector< RSGISClusterCentre > *clusterCentres = new std::vector< RSGISClusterCentre >();
         clusterCentres->reserve(numClusters);
         
@@ -506,7 +516,7 @@ namespace rsgis {namespace math{
                 cCentreMin.centre.push_back(max[j]);
                 cCentreMin.stdDev.push_back(0);
             }
-            this->assign2ClosestDataPoint(&cCentreMin, input, numFeatures, clusterCentres);
+            this->assign2ClosestDataPoint(&cCentreMin, input, clusterCentres);
             clusterCentres->push_back(cCentreMin);
             
             RSGISClusterCentre cCentreMinMid;
@@ -518,7 +528,7 @@ namespace rsgis {namespace math{
                 cCentreMinMid.centre.push_back(min[j] + ((m2StdDev[j]-min[j])/2));
                 cCentreMinMid.stdDev.push_back(0);
             }
-            this->assign2ClosestDataPoint(&cCentreMinMid, input, numFeatures, clusterCentres);
+            this->assign2ClosestDataPoint(&cCentreMinMid, input, clusterCentres);
             clusterCentres->push_back(cCentreMinMid);
         }        
         
@@ -535,7 +545,7 @@ namespace rsgis {namespace math{
                 cCentre.centre.push_back(value);
                 cCentre.stdDev.push_back(0);
             }
-            this->assign2ClosestDataPoint(&cCentre, input, numFeatures, clusterCentres);
+            this->assign2ClosestDataPoint(&cCentre, input, clusterCentres);
             clusterCentres->push_back(cCentre);
         }
         
@@ -550,7 +560,7 @@ namespace rsgis {namespace math{
                 cCentreMaxMid.centre.push_back(p2StdDev[j] + ((max[j]-p2StdDev[j])/2));
                 cCentreMaxMid.stdDev.push_back(0);
             }
-            this->assign2ClosestDataPoint(&cCentreMaxMid, input, numFeatures, clusterCentres);
+            this->assign2ClosestDataPoint(&cCentreMaxMid, input, clusterCentres);
             clusterCentres->push_back(cCentreMaxMid);
             
             RSGISClusterCentre cCentreMax;
@@ -562,7 +572,7 @@ namespace rsgis {namespace math{
                 cCentreMax.centre.push_back(max[j]);
                 cCentreMax.stdDev.push_back(0);
             }
-            this->assign2ClosestDataPoint(&cCentreMax, input, numFeatures, clusterCentres);
+            this->assign2ClosestDataPoint(&cCentreMax, input, clusterCentres);
             clusterCentres->push_back(cCentreMax);            
         }
         
@@ -574,92 +584,52 @@ namespace rsgis {namespace math{
         return clusterCentres;
     }
         
-    std::vector< RSGISClusterCentre >* RSGISClusterer::initializeClusterCentresKPP(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max, unsigned int numClusters)
+    std::vector< RSGISClusterCentre >* RSGISClusterer::initializeClusterCentresKPP(const RSGISClusterDataView &input, float *min, float *max, unsigned int numClusters)
     {
         throw RSGISClustererException("initializeClusterCentresKPP is not implemented.");
         return NULL;
     }
         
-    std::vector< std::pair< unsigned int, std::vector<float> > >* RSGISClusterer::createClusterDataInitClusterIDs(std::vector< std::vector<float> > *input, std::vector< RSGISClusterCentre > *clusterCentres)
+    void RSGISClusterer::getCentresMatrix(std::vector< RSGISClusterCentre > *clusterCentres, unsigned int numFeatures, std::vector<float> *centres)
     {
-        float dist = 0;
-        float minDist = 0;
-        unsigned int clusterID = 0;
-        
-        std::vector< std::pair< unsigned int, std::vector<float> > > *clusterData = new std::vector< std::pair< unsigned int, std::vector<float> > >();
-        for(std::vector< std::vector<float> >::iterator iterInData = input->begin(); iterInData != input->end(); ++iterInData)
+        centres->resize(clusterCentres->size() * numFeatures);
+        for(unsigned int i = 0; i < clusterCentres->size(); ++i)
         {
-            dist = 0;
-            minDist = 0;
-            clusterID = 0;
-            
-            for(unsigned int i = 0; i < clusterCentres->size(); ++i)
+            for(unsigned int j = 0; j < numFeatures; ++j)
             {
-                dist = 0;
-                for(unsigned int j = 0; j < clusterCentres->at(i).centre.size(); ++j)
-                {
-                    dist += ((*iterInData)[j] - clusterCentres->at(i).centre[j]) * ((*iterInData)[j] - clusterCentres->at(i).centre[j]); 
-                }
-                
-                dist = sqrt(dist);
-                
-                if(i == 0)
-                {
-                    minDist = dist;
-                    clusterID = i;
-                }
-                else if(dist < minDist)
-                {
-                    minDist = dist;
-                    clusterID = i;
-                }
+                (*centres)[(i*numFeatures)+j] = clusterCentres->at(i).centre[j];
             }
-            
-            ++clusterCentres->at(clusterID).numPxl;
-            clusterData->push_back(std::pair< unsigned int, std::vector<float> >(clusterID, *iterInData));
         }
+    }
+    
+    void RSGISClusterer::initClusterIDs(const RSGISClusterDataView &input, std::vector< RSGISClusterCentre > *clusterCentres, std::vector<unsigned int> *clusterIDs)
+    {
+        std::vector<float> centres;
+        this->getCentresMatrix(clusterCentres, input.numFeatures, &centres);
+        unsigned int numCentres = clusterCentres->size();
         
-        return clusterData;
+        clusterIDs->resize(input.numPts);
+        for(size_t n = 0; n < input.numPts; ++n)
+        {
+            unsigned int clusterID = this->findClosestCentre(input.point(n), centres.data(), numCentres, input.numFeatures);
+            ++clusterCentres->at(clusterID).numPxl;
+            (*clusterIDs)[n] = clusterID;
+        }
     }
     
-    unsigned int RSGISClusterer::reassignClusterIDs( std::vector< std::pair< unsigned int, std::vector<float> > > *clusterData, std::vector< RSGISClusterCentre > *clusterCentres)
+    unsigned int RSGISClusterer::reassignClusterIDs(const RSGISClusterDataView &input, std::vector<unsigned int> *clusterIDs, std::vector< RSGISClusterCentre > *clusterCentres)
     {
-        unsigned int nChange = 0;
-        float dist = 0;
-        float minDist = 0;
-        unsigned int clusterID = 0;
+        std::vector<float> centres;
+        this->getCentresMatrix(clusterCentres, input.numFeatures, &centres);
+        unsigned int numCentres = clusterCentres->size();
         
-        for(std::vector< std::pair< unsigned int, std::vector<float> > >::iterator iterData = clusterData->begin(); iterData != clusterData->end(); ++iterData)
+        unsigned int nChange = 0;
+        for(size_t n = 0; n < input.numPts; ++n)
         {
-            dist = 0;
-            minDist = 0;
-            clusterID = 0;
-            
-            for(unsigned int i = 0; i < clusterCentres->size(); ++i)
-            {
-                dist = 0;
-                for(unsigned int j = 0; j < clusterCentres->at(i).centre.size(); ++j)
-                {
-                    dist += ((*iterData).second[j] - clusterCentres->at(i).centre[j]) * ((*iterData).second[j] - clusterCentres->at(i).centre[j]); 
-                }
-                
-                dist = sqrt(dist);
-                
-                if(i == 0)
-                {
-                    minDist = dist;
-                    clusterID = i;
-                }
-                else if(dist < minDist)
-                {
-                    minDist = dist;
-                    clusterID = i;
-                }
-            }
-            
-            if(clusterID != (*iterData).first)
+            unsigned int clusterID = this->findClosestCentre(input.point(n), centres.data(), numCentres, input.numFeatures);
+            if(clusterID != (*clusterIDs)[n])
             {
-                (*iterData).first = clusterID;
+                (*clusterIDs)[n] = clusterID;
                 ++nChange;
             }
         }
@@ -667,8 +637,9 @@ namespace rsgis {namespace math{
         return nChange;
     }
     
-    void RSGISClusterer::recalcClusterCentres( std::vector< std::pair< unsigned int, std::vector<float> > > *clusterData, std::vector< RSGISClusterCentre > *clusterCentres, bool calcStdDev)
+    void RSGISClusterer::recalcClusterCentres(const RSGISClusterDataView &input, std::vector<unsigned int> *clusterIDs, std::vector< RSGISClusterCentre > *clusterCentres, bool calcStdDev)
     {
+        unsigned int numFeatures = input.numFeatures;
         for(std::vector< RSGISClusterCentre >::iterator iterClusters = clusterCentres->begin(); iterClusters != clusterCentres->end(); ++iterClusters)
         {
             for(unsigned int i = 0; i < (*iterClusters).centre.size(); ++i)
@@ -679,16 +650,22 @@ namespace rsgis {namespace math{
             (*iterClusters).numPxl = 0;
         }
         
-        for(std::vector< std::pair< unsigned int, std::vector<float> > >::iterator iterData = clusterData->begin(); iterData != clusterData->end(); ++iterData)
+        for(size_t n = 0; n < input.numPts; ++n)
         {
-            ++clusterCentres->at((*iterData).first).numPxl;
-            for(unsigned int i = 0; i < (*iterData).second.size(); ++i)
+            const float *pt = input.point(n);
+            RSGISClusterCentre &cc = clusterCentres->at((*clusterIDs)[n]);
+            ++cc.numPxl;
+            for(unsigned int i = 0; i < numFeatures; ++i)
             {
-                clusterCentres->at((*iterData).first).centre[i] += (*iterData).second[i];
+                cc.centre[i] += pt[i];
             }
         }
 
-        for(std::vector< RSGISClusterCentre >::iterator iterClusters = clusterCentres->begin(); iterClusters != clusterCentres->end(); )
+        // Remove the empty clusters, updating the cluster IDs to the new indexes.
+        std::vector<unsigned int> newIdxs(clusterCentres->size(), 0);
+        unsigned int oldIdx = 0;
+        unsigned int newIdx = 0;
+        for(std::vector< RSGISClusterCentre >::iterator iterClusters = clusterCentres->begin(); iterClusters != clusterCentres->end(); ++oldIdx)
         {
             if((*iterClusters).numPxl == 0)
             {
@@ -700,17 +677,27 @@ namespace rsgis {namespace math{
                 {
                     (*iterClusters).centre[i] = (*iterClusters).centre[i]/(*iterClusters).numPxl;
                 }
+                newIdxs[oldIdx] = newIdx++;
                 ++iterClusters;
             }
         }
+        if(newIdx != newIdxs.size())
+        {
+            for(size_t n = 0; n < input.numPts; ++n)
+            {
+                (*clusterIDs)[n] = newIdxs[(*clusterIDs)[n]];
+            }
+        }
         
         if(calcStdDev)
         {
-            for(std::vector< std::pair< unsigned int, std::vector<float> > >::iterator iterData = clusterData->begin(); iterData != clusterData->end(); ++iterData)
+            for(size_t n = 0; n < input.numPts; ++n)
             {
-                for(unsigned int i = 0; i < (*iterData).second.size(); ++i)
+                const float *pt = input.point(n);
+                RSGISClusterCentre &cc = clusterCentres->at((*clusterIDs)[n]);
+                for(unsigned int i = 0; i < numFeatures; ++i)
                 {
-                    clusterCentres->at((*iterData).first).stdDev[i] += (clusterCentres->at((*iterData).first).centre[i] - (*iterData).second[i])*(clusterCentres->at((*iterData).first).centre[i] - (*iterData).second[i]);
+                    cc.stdDev[i] += (cc.centre[i] - pt[i])*(cc.centre[i] - pt[i]);
                 }
             }
             
@@ -724,114 +711,44 @@ namespace rsgis {namespace math{
         }
     }
     
-    void RSGISClusterer::assign2ClosestDataPoint(RSGISClusterCentre *cc, std::vector< std::vector<float> > *input, unsigned int numFeatures, std::vector< RSGISClusterCentre > *used)
+    void RSGISClusterer::assign2ClosestDataPoint(RSGISClusterCentre *cc, const RSGISClusterDataView &input, std::vector< RSGISClusterCentre > *used)
     {
+        unsigned int numFeatures = input.numFeatures;
         bool first = true;
-        bool alreadyUsed = 0;
         double minDist = 0;
         double dist = 0;
-        std::vector<float> cClosest;
-        cClosest.reserve(numFeatures);
-        for(unsigned int i = 0; i < numFeatures; ++i)
+        const float *cClosest = NULL;
+        for(size_t n = 0; n < input.numPts; ++n)
         {
-            cClosest.push_back(0);
-        }
-        try 
-        {
-            for(std::vector< std::vector<float> >::iterator iterData = input->begin(); iterData != input->end(); ++iterData)
+            const float *pt = input.point(n);
+            if(first)
             {
-                if(first)
-                {
-                    if(used->size() > 0)
-                    {
-                        for(std::vector< RSGISClusterCentre >::iterator iterCC = used->begin(); iterCC != used->end(); ++iterCC)
-                        {
-                            alreadyUsed = true;
-                            for(unsigned int i = 0; i < numFeatures; ++i)
-                            {
-                                if((*iterData)[i] != (*iterCC).centre[i])
-                                {
-                                    alreadyUsed = false;
-                                }
-                            }
-                            if(alreadyUsed)
-                            {
-                                break;
-                            }
-                        }
-                    }
-                    else
-                    {
-                        alreadyUsed = false; 
-                    }
-                    
-                    if(!alreadyUsed)
-                    {
-                        minDist = this->calcEucDistance(cc->centre, (*iterData));
-                        for(unsigned int i = 0; i < numFeatures; ++i)
-                        {
-                            cClosest[i] = (*iterData)[i];
-                        }
-                        first = false;
-                    }
-                }
-                else
+                if(!this->isUsedCentre(pt, numFeatures, used))
                 {
-                    dist = this->calcEucDistance(cc->centre, (*iterData));
-                    
-                    if(dist < minDist)
-                    {
-                        if(used->size() > 0)
-                        {
-                            for(std::vector< RSGISClusterCentre >::iterator iterCC = used->begin(); iterCC != used->end(); ++iterCC)
-                            {
-                                alreadyUsed = true;
-                                for(unsigned int i = 0; i < numFeatures; ++i)
-                                {
-                                    if((*iterData)[i] != (*iterCC).centre[i])
-                                    {
-                                        alreadyUsed = false;
-                                    }
-                                }
-                                if(alreadyUsed)
-                                {
-                                    break;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            alreadyUsed = false; 
-                        }
-                        
-                        if(!alreadyUsed)
-                        {
-                            minDist = dist;
-                            for(unsigned int i = 0; i < numFeatures; ++i)
-                            {
-                                cClosest[i] = (*iterData)[i];
-                            }
-                        }
-                    }
-                    
+                    minDist = this->calcEucDistance(cc->centre, pt);
+                    cClosest = pt;
+                    first = false;
                 }
             }
-            
-            if(first)
-            {
-                throw RSGISClustererException("All data points are already assigned to cluster centres. Not enough unique cluster centres.");
-            }
             else
             {
-                for(unsigned int i = 0; i < numFeatures; ++i)
+                dist = this->calcEucDistance(cc->centre, pt);
+                if((dist < minDist) && (!this->isUsedCentre(pt, numFeatures, used)))
                 {
-                    cc->centre[i] = cClosest[i];
+                    minDist = dist;
+                    cClosest = pt;
                 }
             }
         }
-        catch (RSGISClustererException &e) 
+        
+        if(first)
         {
-            throw e;
+            throw RSGISClustererException("All data points are already assigned to cluster centres. Not enough unique cluster centres.");
+        }
+        
+        for(unsigned int i = 0; i < numFeatures; ++i)
+        {
+            cc->centre[i] = cClosest[i];
         }
     }
     
@@ -842,8 +759,9 @@ namespace rsgis {namespace math{
         this->initCentres = initCentres;
     }
         
-    std::vector< RSGISClusterCentre >* RSGISKMeansClusterer::calcClusterCentres(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange)
+    std::vector< RSGISClusterCentre >* RSGISKMeansClusterer::calcClusterCentres(const RSGISClusterDataView &input, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange)
     {
+        unsigned int numFeatures = input.numFeatures;
         std::vector< RSGISClusterCentre > *clusterCentres = NULL;
         try 
         {
@@ -852,13 +770,13 @@ namespace rsgis {namespace math{
                        
             if(this->initCentres == init_random)
             {
-                //this->calcDataRanges(input, numFeatures, minVals, maxVals);
+                //this->calcDataRanges(input, minVals, maxVals);
                 //clusterCentres = this->initializeClusterCentresRandom(numFeatures, minVals, maxVals, numClusters);
-                clusterCentres = this->initializeClusterCentresRandom(input, numFeatures, numClusters);
+                clusterCentres = this->initializeClusterCentresRandom(input, numClusters);
             }
             else if(this->initCentres == init_diagonal_full)
             {
-                this->calcDataRanges(input, numFeatures, minVals, maxVals);
+                this->calcDataRanges(input, minVals, maxVals);
                 clusterCentres = this->initializeClusterCentresDiagonal(numFeatures, minVals, maxVals, numClusters);
             }
             else if(this->initCentres == init_diagonal_stddev)
@@ -866,7 +784,7 @@ namespace rsgis {namespace math{
                 float *meanVals = new float[numFeatures];
                 float *stddevVals = new float[numFeatures];
                 
-                this->calcDataStats(input, numFeatures, minVals, maxVals, meanVals, stddevVals);
+                this->calcDataStats(input, minVals, maxVals, meanVals, stddevVals);
                 clusterCentres = this->initializeClusterCentresDiagonal(numFeatures, minVals, maxVals, meanVals, stddevVals, numClusters);
                 
                 delete[] meanVals;
@@ -874,24 +792,24 @@ namespace rsgis {namespace math{
             }
             else if(this->initCentres == init_diagonal_full_attach)
             {
-                this->calcDataRanges(input, numFeatures, minVals, maxVals);
-                clusterCentres = this->initializeClusterCentresDiagonal(input, numFeatures, minVals, maxVals, numClusters);
+                this->calcDataRanges(input, minVals, maxVals);
+                clusterCentres = this->initializeClusterCentresDiagonal(input, minVals, maxVals, numClusters);
             }
             else if(this->initCentres == init_diagonal_stddev_attach)
             {
                 float *meanVals = new float[numFeatures];
                 float *stddevVals = new float[numFeatures];
                 
-                this->calcDataStats(input, numFeatures, minVals, maxVals, meanVals, stddevVals);
-                clusterCentres = this->initializeClusterCentresDiagonal(input, numFeatures, minVals, maxVals, meanVals, stddevVals, numClusters);
+                this->calcDataStats(input, minVals, maxVals, meanVals, stddevVals);
+                clusterCentres = this->initializeClusterCentresDiagonal(input, minVals, maxVals, meanVals, stddevVals, numClusters);
                 
                 delete[] meanVals;
                 delete[] stddevVals;
             }
             else if(this->initCentres == init_kpp)
             {
-                this->calcDataRanges(input, numFeatures, minVals, maxVals);
-                clusterCentres = this->initializeClusterCentresKPP(input, numFeatures, minVals, maxVals, numClusters);
+                this->calcDataRanges(input, minVals, maxVals);
+                clusterCentres = this->initializeClusterCentresKPP(input, minVals, maxVals, numClusters);
             }
             else
             {
@@ -901,7 +819,8 @@ namespace rsgis {namespace math{
             delete[] minVals;
             delete[] maxVals;
             
-            std::vector< std::pair< unsigned int, std::vector<float> > > *clusterData = this->createClusterDataInitClusterIDs(input, clusterCentres);
+            std::vector<unsigned int> clusterIDs;
+            this->initClusterIDs(input, clusterCentres, &clusterIDs);
             
             unsigned int nIter = 0;
             unsigned int nChange = 0;
@@ -913,11 +832,11 @@ namespace rsgis {namespace math{
             {
                 contProcess = false;
                 
-                this->recalcClusterCentres(clusterData, clusterCentres, false);
+                this->recalcClusterCentres(input, &clusterIDs, clusterCentres, false);
                 
-                nChange = this->reassignClusterIDs(clusterData, clusterCentres);
+                nChange = this->reassignClusterIDs(input, &clusterIDs, clusterCentres);
                 
-                amountOfChange = ((float)nChange)/clusterData->size();
+                amountOfChange = ((float)nChange)/clusterIDs.size();
                 
                 std::cout << "Iteration " << nIter << " has change " << amountOfChange*100 << " % of data clump IDs (" << clusterCentres->size() << " clusters).\n";
                 
@@ -957,8 +876,9 @@ namespace rsgis {namespace math{
         this->endIteration = endIteration;
     }
     
-    std::vector< RSGISClusterCentre >* RSGISISODataClusterer::calcClusterCentres(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange)
+    std::vector< RSGISClusterCentre >* RSGISISODataClusterer::calcClusterCentres(const RSGISClusterDataView &input, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange)
     {
+        unsigned int numFeatures = input.numFeatures;
         std::vector< RSGISClusterCentre > *clusterCentres = NULL;
         try 
         {
@@ -967,13 +887,13 @@ namespace rsgis {namespace math{
             
             if(this->initCentres == init_random)
             {
-                //this->calcDataRanges(input, numFeatures, minVals, maxVals);
+                //this->calcDataRanges(input, minVals, maxVals);
                 //clusterCentres = this->initializeClusterCentresRandom(numFeatures, minVals, maxVals, numClusters);
-                clusterCentres = this->initializeClusterCentresRandom(input, numFeatures, numClusters);
+                clusterCentres = this->initializeClusterCentresRandom(input, numClusters);
             }
             else if(this->initCentres == init_diagonal_full)
             {
-                this->calcDataRanges(input, numFeatures, minVals, maxVals);
+                this->calcDataRanges(input, minVals, maxVals);
                 clusterCentres = this->initializeClusterCentresDiagonal(numFeatures, minVals, maxVals, numClusters);
             }
             else if(this->initCentres == init_diagonal_stddev)
@@ -981,7 +901,7 @@ namespace rsgis {namespace math{
                 float *meanVals = new float[numFeatures];
                 float *stddevVals = new float[numFeatures];
                 
-                this->calcDataStats(input, numFeatures, minVals, maxVals, meanVals, stddevVals);
+                this->calcDataStats(input, minVals, maxVals, meanVals, stddevVals);
                 clusterCentres = this->initializeClusterCentresDiagonal(numFeatures, minVals, maxVals, numClusters);
                 
                 delete[] meanVals;
@@ -989,24 +909,24 @@ namespace rsgis {namespace math{
             }
             else if(this->initCentres == init_diagonal_full_attach)
             {
-                this->calcDataRanges(input, numFeatures, minVals, maxVals);
-                clusterCentres = this->initializeClusterCentresDiagonal(input, numFeatures, minVals, maxVals, numClusters);
+                this->calcDataRanges(input, minVals, maxVals);
+                clusterCentres = this->initializeClusterCentresDiagonal(input, minVals, maxVals, numClusters);
             }
             else if(this->initCentres == init_diagonal_stddev_attach)
             {
                 float *meanVals = new float[numFeatures];
                 float *stddevVals = new float[numFeatures];
                 
-                this->calcDataStats(input, numFeatures, minVals, maxVals, meanVals, stddevVals);
-                clusterCentres = this->initializeClusterCentresDiagonal(input, numFeatures, minVals, maxVals, meanVals, stddevVals, numClusters);
+                this->calcDataStats(input, minVals, maxVals, meanVals, stddevVals);
+                clusterCentres = this->initializeClusterCentresDiagonal(input, minVals, maxVals, meanVals, stddevVals, numClusters);
                 
                 delete[] meanVals;
                 delete[] stddevVals;
             }
             else if(this->initCentres == init_kpp)
             {
-                this->calcDataRanges(input, numFeatures, minVals, maxVals);
-                clusterCentres = this->initializeClusterCentresKPP(input, numFeatures, minVals, maxVals, numClusters);
+                this->calcDataRanges(input, minVals, maxVals);
+                clusterCentres = this->initializeClusterCentresKPP(input, minVals, maxVals, numClusters);
             }
             else
             {
@@ -1016,7 +936,8 @@ namespace rsgis {namespace math{
             delete[] minVals;
             delete[] maxVals;
             
-            std::vector< std::pair< unsigned int, std::vector<float> > > *clusterData = this->createClusterDataInitClusterIDs(input, clusterCentres);
+            std::vector<unsigned int> clusterIDs;
+            this->initClusterIDs(input, clusterCentres, &clusterIDs);
             
             unsigned int nIter = 0;
             unsigned int nChange = 0;
@@ -1028,16 +949,16 @@ namespace rsgis {namespace math{
             {
                 contProcess = false;
                 
-                this->recalcClusterCentres(clusterData, clusterCentres, true);
+                this->recalcClusterCentres(input, &clusterIDs, clusterCentres, true);
                 
                 if((nIter > this->startIteration) & (nIter < this->endIteration))
                 {
                     this->addRemoveClusters(clusterCentres);
                 }                
                 
-                nChange = this->reassignClusterIDs(clusterData, clusterCentres);
+                nChange = this->reassignClusterIDs(input, &clusterIDs, clusterCentres);
                 
-                amountOfChange = ((float)nChange)/clusterData->size();
+                amountOfChange = ((float)nChange)/clusterIDs.size();
                 
                 std::cout << "Iteration " << nIter << " has change " << amountOfChange*100 << " % of data clump IDs for " << clusterCentres->size() << " cluster centres.\n";
                 
@@ -46,6 +46,16 @@
 
 namespace rsgis {namespace math{
 	
+    enum InitClustererMethods
+    {
+        init_random,
+        init_diagonal_full,
+        init_diagonal_stddev,
+        init_diagonal_full_attach,
+        init_diagonal_stddev_attach,
+        init_kpp
+    };
+    
     struct DllExport RSGISClusterCentre
     {
         std::vector<float> centre;
@@ -53,35 +63,66 @@ namespace rsgis {namespace math{
         std::vector<float> stdDev;
     };
     
+    /**
+     * A read only view of a row-major matrix of data points (numPts x numFeatures)
+     * held in a single contiguous block of memory. The view does not own the data.
+     */
+    struct DllExport RSGISClusterDataView
+    {
+        const float *data;
+        size_t numPts;
+        unsigned int numFeatures;
+        inline const float* point(size_t i) const {return this->data + (i*this->numFeatures);};
+    };
+    
     class DllExport RSGISClusterer
 	{
 	public:
 		RSGISClusterer(){};
-        virtual std::vector< RSGISClusterCentre >* calcClusterCentres(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange) = 0;
-        void calcDataRanges(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max);
-        void calcDataStats(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max, float *mean, float *stddev);
+        virtual std::vector< RSGISClusterCentre >* calcClusterCentres(const RSGISClusterDataView &input, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange) = 0;
+        std::vector< RSGISClusterCentre >* calcClusterCentres(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange);
+        void calcDataRanges(const RSGISClusterDataView &input, float *min, float *max);
+        void calcDataStats(const RSGISClusterDataView &input, float *min, float *max, float *mean, float *stddev);
         std::vector< RSGISClusterCentre >* initializeClusterCentresRandom(unsigned int numFeatures, float *min, float *max, unsigned int numClusters);
-        std::vector< RSGISClusterCentre >* initializeClusterCentresRandom(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters);
+        std::vector< RSGISClusterCentre >* initializeClusterCentresRandom(const RSGISClusterDataView &input, unsigned int numClusters);
         std::vector< RSGISClusterCentre >* initializeClusterCentresDiagonal(unsigned int numFeatures, float *min, float *max, unsigned int numClusters);
         std::vector< RSGISClusterCentre >* initializeClusterCentresDiagonal(unsigned int numFeatures, float *min, float *max, float *mean, float *stddev, unsigned int numClusters);
-        std::vector< RSGISClusterCentre >* initializeClusterCentresDiagonal(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max, unsigned int numClusters);
-        std::vector< RSGISClusterCentre >* initializeClusterCentresDiagonal(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max, float *mean, float *stddev, unsigned int numClusters);
-        std::vector< RSGISClusterCentre >* initializeClusterCentresKPP(std::vector< std::vector<float> > *input, unsigned int numFeatures, float *min, float *max, unsigned int numClusters);
+        std::vector< RSGISClusterCentre >* initializeClusterCentresDiagonal(const RSGISClusterDataView &input, float *min, float *max, unsigned int numClusters);
+        std::vector< RSGISClusterCentre >* initializeClusterCentresDiagonal(const RSGISClusterDataView &input, float *min, float *max, float *mean, float *stddev, unsigned int numClusters);
+        std::vector< RSGISClusterCentre >* initializeClusterCentresKPP(const RSGISClusterDataView &input, float *min, float *max, unsigned int numClusters);
         
-        std::vector< std::pair< unsigned int, std::vector<float> > >* createClusterDataInitClusterIDs(std::vector< std::vector<float> > *input, std::vector< RSGISClusterCentre > *clusterCentres);
-        unsigned int reassignClusterIDs( std::vector< std::pair< unsigned int, std::vector<float> > > *clusterData, std::vector< RSGISClusterCentre > *clusterCentres);
-        void recalcClusterCentres( std::vector< std::pair< unsigned int, std::vector<float> > > *clusterData, std::vector< RSGISClusterCentre > *clusterCentres, bool calcStdDev);
-        void assign2ClosestDataPoint(RSGISClusterCentre *cc, std::vector< std::vector<float> > *input, unsigned int numFeatures, std::vector< RSGISClusterCentre > *used);
+        void initClusterIDs(const RSGISClusterDataView &input, std::vector< RSGISClusterCentre > *clusterCentres, std::vector<unsigned int> *clusterIDs);
+        unsigned int reassignClusterIDs(const RSGISClusterDataView &input, std::vector<unsigned int> *clusterIDs, std::vector< RSGISClusterCentre > *clusterCentres);
+        void recalcClusterCentres(const RSGISClusterDataView &input, std::vector<unsigned int> *clusterIDs, std::vector< RSGISClusterCentre > *clusterCentres, bool calcStdDev);
+        void assign2ClosestDataPoint(RSGISClusterCentre *cc, const RSGISClusterDataView &input, std::vector< RSGISClusterCentre > *used);
         
-        ~RSGISClusterer(){};
+        virtual ~RSGISClusterer(){};
     protected:
-        double calcEucDistance(std::vector<float> d1, std::vector<float> d2)
+        void getCentresMatrix(std::vector< RSGISClusterCentre > *clusterCentres, unsigned int numFeatures, std::vector<float> *centres);
+        inline unsigned int findClosestCentre(const float *pt, const float *centres, unsigned int numCentres, unsigned int numFeatures)
         {
-            unsigned int numVals = d1.size(); 
-            if(numVals != d2.size())
+            unsigned int clusterID = 0;
+            float minDist = 0;
+            float dist = 0;
+            for(unsigned int i = 0; i < numCentres; ++i)
             {
-                throw RSGISClustererException("Cannot calculate Euclidean distance for vectors of different length.");
+                const float *centre = centres + (i*numFeatures);
+                dist = 0;
+                for(unsigned int j = 0; j < numFeatures; ++j)
+                {
+                    dist += (pt[j] - centre[j]) * (pt[j] - centre[j]);
+                }
+                if((i == 0) || (dist < minDist))
+                {
+                    minDist = dist;
+                    clusterID = i;
+                }
             }
+            return clusterID;
+        };
+        double calcEucDistance(const std::vector<float> &d1, const float *d2)
+        {
+            unsigned int numVals = d1.size();
             double dist = 0;
             for(unsigned int i = 0; i < numVals; ++i)
             {
@@ -95,23 +136,35 @@ namespace rsgis {namespace math{
             
             return dist;
         };
+        bool isUsedCentre(const float *pt, unsigned int numFeatures, std::vector< RSGISClusterCentre > *used)
+        {
+            for(std::vector< RSGISClusterCentre >::iterator iterCC = used->begin(); iterCC != used->end(); ++iterCC)
+            {
+                bool alreadyUsed = true;
+                for(unsigned int i = 0; i < numFeatures; ++i)
+                {
+                    if(pt[i] != (*iterCC).centre[i])
+                    {
+                        alreadyUsed = false;
+                        break;
+                    }
+                }
+                if(alreadyUsed)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
 	};
     
-    enum InitClustererMethods
-    {
-        init_random,
-        init_diagonal_full,
-        init_diagonal_stddev,
-        init_diagonal_full_attach,
-        init_diagonal_stddev_attach,
-        init_kpp
-    };
     
     class DllExport RSGISKMeansClusterer: public RSGISClusterer
     {
     public:
 		RSGISKMeansClusterer(InitClustererMethods initCentres);
-        std::vector< RSGISClusterCentre >* calcClusterCentres(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange);
+        using RSGISClusterer::calcClusterCentres;
+        std::vector< RSGISClusterCentre >* calcClusterCentres(const RSGISClusterDataView &input, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange);
 		~RSGISKMeansClusterer();
     private:
         InitClustererMethods initCentres;
@@ -121,7 +174,8 @@ namespace rsgis {namespace math{
     {
     public:
 		RSGISISODataClusterer(InitClustererMethods initCentres, float minDistBetweenClusters, unsigned int minNumFeatures, float maxStdDev, unsigned int minNumClusters, unsigned int startIteration, unsigned int endIteration);
-        std::vector< RSGISClusterCentre >* calcClusterCentres(std::vector< std::vector<float> > *input, unsigned int numFeatures, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange);
+        using RSGISClusterer::calcClusterCentres;
+        std::vector< RSGISClusterCentre >* calcClusterCentres(const RSGISClusterDataView &input, unsigned int numClusters, unsigned int maxNumIterations, float degreeOfChange);
 		void addRemoveClusters(std::vector< RSGISClusterCentre > *clusterCentres);
         ~RSGISISODataClusterer();
     private:
@@ -62,6 +62,7 @@ namespace rsgis{namespace reg{
 	class DllExport RSGISAddGCPsGDAL
 	{
 	public:
+        RSGISAddGCPsGDAL(){};
         RSGISAddGCPsGDAL(std::string inFileName, std::string gcpFilePath, std::string outFileName = "",  std::string gdalFormat = "KEA", GDALDataType gdalDataType = GDT_Float32);
         void readGCPFile(std::string gcpFilePath, std::vector<RSGISGCPImg2MapNode*> *gcps);
         void convertRSGIS2GDALGCP(std::vector<RSGISGCPImg2MapNode*> *gcps, GDAL_GCP *gdalGCPList);
@@ -26,7 +26,7 @@
 
 namespace rsgis{namespace reg{
 
-	RSGISBasicImageRegistration::RSGISBasicImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution):RSGISImageRegistration(reference, floating), tiePoints(NULL), gap(1), metricThreshold(0), initExecuted(false), windowSize(0), searchArea(0), metric(NULL), stdDevRefThreshold(0), stdDevFloatThreshold(0), subPixelResolution(0)
+	RSGISBasicImageRegistration::RSGISBasicImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution, unsigned int numPyramidLevels):RSGISImageRegistration(reference, floating), tiePoints(NULL), gap(1), metricThreshold(0), initExecuted(false), windowSize(0), searchArea(0), metric(NULL), stdDevRefThreshold(0), stdDevFloatThreshold(0), subPixelResolution(0), numPyramidLevels(0)
 	{
 		tiePoints = new std::list<TiePoint*>();
 		this->gap = gap;
@@ -37,6 +37,7 @@ namespace rsgis{namespace reg{
 		this->stdDevRefThreshold = stdDevRefThreshold;
 		this->stdDevFloatThreshold = stdDevFloatThreshold;
 		this->subPixelResolution = subPixelResolution;
+		this->numPyramidLevels = numPyramidLevels;
 	}
 		
 	void RSGISBasicImageRegistration::initRegistration()
@@ -110,6 +111,11 @@ namespace rsgis{namespace reg{
         
         std::cout << tiePoints->size() << " are remaining following removal of tie points with low standard deviation of image regions\n";
 		
+		if(numPyramidLevels > 1)
+		{
+			this->buildPyramids(numPyramidLevels);
+		}
+		
 		initExecuted = true;
 	}
 	
@@ -135,6 +141,10 @@ namespace rsgis{namespace reg{
 		float xShift = 0;
 		float yShift = 0;
 		
+		// With the pyramids the shift is found at the coarser levels so only needs refining here.
+		bool usePyramids = (refPyramid != NULL) && (refPyramid->getNumLevels() > 1);
+		unsigned int nativeSearchArea = usePyramids?std::min(searchArea, (unsigned int)2):searchArea;
+		
 		std::list<TiePoint*>::iterator iterTiePts;
 		for(iterTiePts = tiePoints->begin(); iterTiePts != tiePoints->end(); ++iterTiePts)
 		{
@@ -144,7 +154,27 @@ namespace rsgis{namespace reg{
 				feedbackVal += 10;
 			}
 			
-			this->findTiePointLocation(*iterTiePts, windowSize, searchArea, metric, metricThreshold, subPixelResolution, &xShift, &yShift);            
+			if(usePyramids)
+			{
+				double initXShift = (*iterTiePts)->xShift;
+				double initYShift = (*iterTiePts)->yShift;
+				bool coarseFound = this->findTiePointCoarseShift(*iterTiePts, windowSize, searchArea, metric);
+				if(coarseFound)
+				{
+					this->findTiePointLocation(*iterTiePts, windowSize, nativeSearchArea, metric, metricThreshold, subPixelResolution, &xShift, &yShift);
+				}
+				if((!coarseFound) || (boost::math::isnan)((*iterTiePts)->metricVal))
+				{
+					// The coarse shift was not confirmed at the native resolution so the tie point is invalid.
+					(*iterTiePts)->xShift = initXShift;
+					(*iterTiePts)->yShift = initYShift;
+					(*iterTiePts)->metricVal = std::numeric_limits<double>::signaling_NaN();
+				}
+			}
+			else
+			{
+				this->findTiePointLocation(*iterTiePts, windowSize, nativeSearchArea, metric, metricThreshold, subPixelResolution, &xShift, &yShift);
+			}
 			++counter;
 		}
 		std::cout << ". Complete\n";
@@ -59,7 +59,7 @@ namespace rsgis{namespace reg{
 	class DllExport RSGISBasicImageRegistration : public RSGISImageRegistration
 	{
 	public:
-		RSGISBasicImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution);
+		RSGISBasicImageRegistration(GDALDataset *reference, GDALDataset *floating, unsigned int gap, float metricThreshold, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float stdDevRefThreshold, float stdDevFloatThreshold, unsigned int subPixelResolution, unsigned int numPyramidLevels=0);
 		void initRegistration();
 		void executeRegistration();
 		void finaliseRegistration();
@@ -79,6 +79,7 @@ namespace rsgis{namespace reg{
 		float stdDevRefThreshold;
 		float stdDevFloatThreshold;
 		unsigned int subPixelResolution;
+		unsigned int numPyramidLevels;
 	};
 }}
 
@@ -253,6 +253,223 @@ namespace rsgis{namespace reg{
     }
 
 
+    std::pair<double, double> RSGISFindImageOffset::findImageOffsetPyramid(GDALDataset *refDataset, GDALDataset *fltDataset,
+                                                                           std::vector<unsigned int> refBands, std::vector<unsigned int> fltBands,
+                                                                           unsigned int xSearch, unsigned int ySearch,
+                                                                           RSGISImageSimilarityMetric *metric, unsigned int numLevels,
+                                                                           bool usePhaseCorr, bool calcSubPixelRes, unsigned int subPixelRes)
+    {
+        if(refBands.size() != fltBands.size())
+        {
+            throw RSGISRegistrationException("The number of bands specified from the reference and floating images must be the same.");
+        }
+
+        double refTransform[6];
+        double fltTransform[6];
+        refDataset->GetGeoTransform(refTransform);
+        fltDataset->GetGeoTransform(fltTransform);
+        double pxlResX = fabs(refTransform[1]);
+        double pxlResY = fabs(refTransform[5]);
+        if((fabs(fabs(fltTransform[1]) - pxlResX) > (pxlResX * 0.001)) || (fabs(fabs(fltTransform[5]) - pxlResY) > (pxlResY * 0.001)))
+        {
+            throw RSGISRegistrationException("The reference and floating images must have the same pixel resolution.");
+        }
+
+        // Before any offset, reference pixel (x, y) is at the same location as floating pixel (x + baseX, y + baseY).
+        int baseX = floor(((refTransform[0] - fltTransform[0]) / pxlResX) + 0.5);
+        int baseY = floor(((fltTransform[3] - refTransform[3]) / pxlResY) + 0.5);
+
+        int refX0 = std::max(0, baseX * (-1));
+        int refY0 = std::max(0, baseY * (-1));
+        int refX1 = std::min(refDataset->GetRasterXSize(), fltDataset->GetRasterXSize() - baseX);
+        int refY1 = std::min(refDataset->GetRasterYSize(), fltDataset->GetRasterYSize() - baseY);
+        if((refX1 <= refX0) || (refY1 <= refY0))
+        {
+            throw RSGISRegistrationException("The reference and floating images do not overlap.");
+        }
+        unsigned int overlapWidth = refX1 - refX0;
+        unsigned int overlapHeight = refY1 - refY0;
+
+        RSGISImagePyramid refPyramid(refDataset, refBands, refX0, refY0, overlapWidth, overlapHeight, numLevels);
+        numLevels = refPyramid.getNumLevels();
+
+        // The floating window has a margin of the search distance (rounded up to a whole
+        // pixel at the coarsest level) so it aligns with the reference at every level.
+        int coarseScale = 1 << (numLevels-1);
+        int marginX = ((xSearch + coarseScale - 1) / coarseScale) * coarseScale;
+        int marginY = ((ySearch + coarseScale - 1) / coarseScale) * coarseScale;
+        RSGISImagePyramid fltPyramid(fltDataset, fltBands, (refX0 + baseX - marginX), (refY0 + baseY - marginY), (overlapWidth + (2*marginX)), (overlapHeight + (2*marginY)), numLevels, 1);
+
+        std::cout << "Searching for the offset using " << numLevels << " pyramid levels\n";
+
+        // Shifts (xShift, yShift) are in pixels of the current level, such that reference
+        // pixel (x, y) is compared to floating pixel (x + xShift, y + yShift).
+        int bestXShift = 0;
+        int bestYShift = 0;
+        double bestMetricVal = 0.0;
+        std::vector<int> xShifts;
+        std::vector<int> yShifts;
+        std::vector<double> xMetricVals;
+        std::vector<double> yMetricVals;
+        for(int level = numLevels-1; level >= 0; --level)
+        {
+            int scale = 1 << level;
+            int lvlMarginX = marginX / scale;
+            int lvlMarginY = marginY / scale;
+            int maxXShift = (xSearch + scale - 1) / scale;
+            int maxYShift = (ySearch + scale - 1) / scale;
+            unsigned int lvlWidth = refPyramid.getWidth(level);
+            unsigned int lvlHeight = refPyramid.getHeight(level);
+
+            int xStart = maxXShift * (-1);
+            int xEnd = maxXShift;
+            int yStart = maxYShift * (-1);
+            int yEnd = maxYShift;
+            if(level < ((int)numLevels-1))
+            {
+                int radius = (level == 0)?2:1;
+                bestXShift *= 2;
+                bestYShift *= 2;
+                xStart = std::max(bestXShift - radius, xStart);
+                xEnd = std::min(bestXShift + radius, xEnd);
+                yStart = std::max(bestYShift - radius, yStart);
+                yEnd = std::min(bestYShift + radius, yEnd);
+            }
+            else if(usePhaseCorr)
+            {
+                std::vector<float> refPlane;
+                std::vector<float> fltPlane;
+                this->meanBandPlane(&refPyramid, level, 0, 0, lvlWidth, lvlHeight, &refPlane);
+                this->meanBandPlane(&fltPyramid, level, lvlMarginX, lvlMarginY, lvlWidth, lvlHeight, &fltPlane);
+                RSGISPhaseCorrelation phaseCorr;
+                int pcXShift = 0;
+                int pcYShift = 0;
+                double peakVal = phaseCorr.findShift(refPlane.data(), fltPlane.data(), lvlWidth, lvlHeight, &pcXShift, &pcYShift);
+                std::cout << "Phase correlation shift: [" << (pcXShift * scale * (-1)) << ", " << (pcYShift * scale) << "] (peak " << peakVal << ")\n";
+                pcXShift = std::min(std::max(pcXShift, xStart), xEnd);
+                pcYShift = std::min(std::max(pcYShift, yStart), yEnd);
+                xStart = std::max(pcXShift - 1, xStart);
+                xEnd = std::min(pcXShift + 1, xEnd);
+                yStart = std::max(pcYShift - 1, yStart);
+                yEnd = std::min(pcYShift + 1, yEnd);
+            }
+
+            unsigned int nXShifts = (xEnd - xStart) + 1;
+            std::vector<double> metricVals(nXShifts * ((yEnd - yStart) + 1), std::numeric_limits<double>::quiet_NaN());
+            bool first = true;
+            for(int yShift = yStart; yShift <= yEnd; ++yShift)
+            {
+                for(int xShift = xStart; xShift <= xEnd; ++xShift)
+                {
+                    double metricVal = refPyramid.calcMetric(&fltPyramid, level, 0, 0, lvlWidth, lvlHeight, (lvlMarginX + xShift), (lvlMarginY + yShift), metric);
+                    metricVals[((yShift - yStart) * nXShifts) + (xShift - xStart)] = metricVal;
+                    if((boost::math::isnan)(metricVal))
+                    {
+                        continue;
+                    }
+                    if(first || (metric->findMin() && (metricVal < bestMetricVal)) || ((!metric->findMin()) && (metricVal > bestMetricVal)))
+                    {
+                        bestMetricVal = metricVal;
+                        bestXShift = xShift;
+                        bestYShift = yShift;
+                        first = false;
+                    }
+                }
+            }
+            if(first)
+            {
+                throw RSGISRegistrationException("The similarity metric could not be calculated for any of the offsets.");
+            }
+            std::cout << "Level " << level << ": Pixel Shift [" << (bestXShift * scale * (-1)) << ", " << (bestYShift * scale) << "] Metric: " << bestMetricVal << std::endl;
+
+            if(level == 0)
+            {
+                for(int xShift = xStart; xShift <= xEnd; ++xShift)
+                {
+                    xShifts.push_back(xShift);
+                    xMetricVals.push_back(metricVals[((bestYShift - yStart) * nXShifts) + (xShift - xStart)]);
+                }
+                for(int yShift = yStart; yShift <= yEnd; ++yShift)
+                {
+                    yShifts.push_back(yShift);
+                    yMetricVals.push_back(metricVals[((yShift - yStart) * nXShifts) + (bestXShift - xStart)]);
+                }
+            }
+        }
+
+        double outShiftX = bestXShift;
+        double outShiftY = bestYShift;
+        if(calcSubPixelRes)
+        {
+            outShiftX = this->fitSubPixelShift(metric->findMin(), xShifts, xMetricVals, bestXShift, subPixelRes);
+            outShiftY = this->fitSubPixelShift(metric->findMin(), yShifts, yMetricVals, bestYShift, subPixelRes);
+        }
+
+        // Convert to the offset of the floating image (i.e., as returned by findImageOffset).
+        outShiftX = 0.0 - outShiftX;
+
+        std::cout << "Optimal Metric: " << bestMetricVal << std::endl;
+        std::cout << "Pixel Shift: [" << outShiftX << ", " << outShiftY <<"]\n\n";
+
+        return std::pair<double, double>(outShiftX, outShiftY);
+    }
+
+    void RSGISFindImageOffset::meanBandPlane(RSGISImagePyramid *pyramid, unsigned int level, int x0, int y0, unsigned int width, unsigned int height, std::vector<float> *plane)
+    {
+        plane->assign(((size_t)width) * ((size_t)height), 0.0);
+        unsigned int lvlWidth = pyramid->getWidth(level);
+        for(unsigned int n = 0; n < pyramid->getNumBands(); ++n)
+        {
+            float *bandData = pyramid->getBandData(level, n);
+            for(unsigned int y = 0; y < height; ++y)
+            {
+                for(unsigned int x = 0; x < width; ++x)
+                {
+                    (*plane)[(((size_t)y) * width) + x] += bandData[(((size_t)(y + y0)) * lvlWidth) + (x + x0)] / pyramid->getNumBands();
+                }
+            }
+        }
+    }
+
+    double RSGISFindImageOffset::fitSubPixelShift(bool findMin, std::vector<int> &shifts, std::vector<double> &metricVals, int bestShift, unsigned int subPixelRes)
+    {
+        std::vector<unsigned int> validIdxs;
+        for(unsigned int i = 0; i < shifts.size(); ++i)
+        {
+            if(!((boost::math::isnan)(metricVals[i])))
+            {
+                validIdxs.push_back(i);
+            }
+        }
+        if(validIdxs.size() < 3)
+        {
+            return bestShift;
+        }
+
+        rsgis::math::RSGISPolyFit polyFit;
+        gsl_matrix *inputDataMatrix = gsl_matrix_alloc(validIdxs.size(), 2);
+        for(unsigned int i = 0; i < validIdxs.size(); ++i)
+        {
+            gsl_matrix_set(inputDataMatrix, i, 0, shifts[validIdxs[i]]);
+            gsl_matrix_set(inputDataMatrix, i, 1, metricVals[validIdxs[i]]);
+        }
+        int order = 3; // 2nd Order - starts at zero.
+        gsl_vector *coefficients = polyFit.PolyfitOneDimensionQuiet(order, inputDataMatrix);
+
+        float subPixelMetric = 0.0;
+        double subPixelShift = findExtreme(findMin, coefficients, order, bestShift-1, bestShift+1, subPixelRes, &subPixelMetric);
+
+        gsl_matrix_free(inputDataMatrix);
+        gsl_vector_free(coefficients);
+
+        if((boost::math::isnan)(subPixelShift) || (subPixelShift < (bestShift-1)) || (subPixelShift > (bestShift+1)))
+        {
+            return bestShift;
+        }
+        return subPixelShift;
+    }
+
+
     float RSGISFindImageOffset::findExtreme(bool findMin, gsl_vector *coefficients, unsigned int order, float minRange, float maxRange, unsigned int resolution, float *extremeVal)
     {
         double division = ((float)1)/((float)resolution);
@@ -35,6 +35,7 @@
 #include "img/RSGISImageUtils.h"
 #include "img/RSGISCalcImage.h"
 #include "registration/RSGISImageSimilarityMetric.h"
+#include "registration/RSGISImagePyramid.h"
 #include "math/RSGISPolyFit.h"
 
 #include <gsl/gsl_vector.h>
@@ -65,9 +66,25 @@ namespace rsgis{namespace reg{
                                                   unsigned int xSearch, unsigned int ySearch,
                                                   RSGISImageCalcSimilarityMetric *metric,
                                                   bool calcSubPixelRes=false, unsigned int subPixelRes=0);
+        /**
+         * Finds the offset as findImageOffset but using in-memory image pyramids of
+         * the overlapping region: the full search is only carried out at the coarsest
+         * level (or the offset estimated using phase correlation) and the offset is
+         * then refined within a small window at each finer level.
+         */
+        std::pair<double, double> findImageOffsetPyramid(GDALDataset *refDataset, GDALDataset *fltDataset,
+                                                         std::vector<unsigned int> refBands, std::vector<unsigned int> fltBands,
+                                                         unsigned int xSearch, unsigned int ySearch,
+                                                         RSGISImageSimilarityMetric *metric, unsigned int numLevels,
+                                                         bool usePhaseCorr=false, bool calcSubPixelRes=false, unsigned int subPixelRes=0);
         float findExtreme(bool findMin, gsl_vector *coefficients, unsigned int order, float minRange,
                           float maxRange, unsigned int resolution, float *extremeVal);
         ~RSGISFindImageOffset();
+    protected:
+        /** The mean of the bands for a window of a pyramid level (NaN where any band is NaN). */
+        void meanBandPlane(RSGISImagePyramid *pyramid, unsigned int level, int x0, int y0, unsigned int width, unsigned int height, std::vector<float> *plane);
+        /** Fits a quadratic to the metric values around the best shift; returns the best shift if the fit fails. */
+        double fitSubPixelShift(bool findMin, std::vector<int> &shifts, std::vector<double> &metricVals, int bestShift, unsigned int subPixelRes);
     };
 
 
@@ -0,0 +1,401 @@
+/*
+ *  RSGISImagePyramid.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISImagePyramid.h"
+
+namespace rsgis{namespace reg{
+
+    RSGISImagePyramid::RSGISImagePyramid(GDALDataset *dataset, std::vector<unsigned int> bands, int xOff, int yOff, unsigned int width, unsigned int height, unsigned int numLevels, unsigned int minLevelSize, unsigned int firstLevel)
+    {
+        if(bands.empty())
+        {
+            throw RSGISRegistrationException("At least one image band is needed to create an image pyramid.");
+        }
+        if((width == 0) || (height == 0))
+        {
+            throw RSGISRegistrationException("The image pyramid window is empty.");
+        }
+        if(numLevels < 1)
+        {
+            numLevels = 1;
+        }
+        if(firstLevel >= numLevels)
+        {
+            firstLevel = numLevels - 1;
+        }
+        if(firstLevel > 30)
+        {
+            throw RSGISRegistrationException("The first level of the image pyramid is too coarse.");
+        }
+        this->numBands = bands.size();
+        this->firstLevel = firstLevel;
+        this->readBaseLevel(dataset, bands, xOff, yOff, width, height);
+        while(this->getNumLevels() < numLevels)
+        {
+            RSGISPyramidLevel &prevLevel = this->levels.back();
+            if((((prevLevel.width+1)/2) < minLevelSize) || (((prevLevel.height+1)/2) < minLevelSize))
+            {
+                break;
+            }
+            this->createNextLevel();
+        }
+    }
+
+    RSGISImagePyramid::RSGISPyramidLevel& RSGISImagePyramid::getLevel(unsigned int level)
+    {
+        if((level < this->firstLevel) || ((level - this->firstLevel) >= this->levels.size()))
+        {
+            throw RSGISRegistrationException("The pyramid level is not available.");
+        }
+        return this->levels[level - this->firstLevel];
+    }
+
+    void RSGISImagePyramid::readBaseLevel(GDALDataset *dataset, std::vector<unsigned int> &bands, int xOff, int yOff, unsigned int width, unsigned int height)
+    {
+        // Each pixel of the first level covers scale x scale pixels of the image.
+        int scale = 1 << this->firstLevel;
+        RSGISPyramidLevel baseLevel;
+        baseLevel.width = (width + scale - 1) / scale;
+        baseLevel.height = (height + scale - 1) / scale;
+        size_t nPxls = ((size_t)baseLevel.width) * ((size_t)baseLevel.height);
+        baseLevel.data.resize(this->numBands);
+
+        // Intersection of the window with the image.
+        int imgXSize = dataset->GetRasterXSize();
+        int imgYSize = dataset->GetRasterYSize();
+        int readX0 = std::max(xOff, 0);
+        int readY0 = std::max(yOff, 0);
+        int readX1 = std::min(xOff + ((int)width), imgXSize);
+        int readY1 = std::min(yOff + ((int)height), imgYSize);
+
+        // The level pixels the intersection covers.
+        int lvlX0 = (readX0 - xOff) / scale;
+        int lvlY0 = (readY0 - yOff) / scale;
+        int lvlX1 = ((readX1 - xOff) + scale - 1) / scale;
+        int lvlY1 = ((readY1 - yOff) + scale - 1) / scale;
+
+        GDALRasterIOExtraArg extraArg;
+        INIT_RASTERIO_EXTRA_ARG(extraArg);
+        if(scale > 1)
+        {
+            extraArg.eResampleAlg = GRIORA_Average;
+        }
+
+        for(unsigned int n = 0; n < this->numBands; ++n)
+        {
+            if((bands[n] < 1) || (bands[n] > ((unsigned int)dataset->GetRasterCount())))
+            {
+                throw RSGISRegistrationException("Image band is not within the image.");
+            }
+            std::vector<float> &bandData = baseLevel.data[n];
+            bandData.assign(nPxls, std::numeric_limits<float>::quiet_NaN());
+            if((readX1 <= readX0) || (readY1 <= readY0))
+            {
+                continue;
+            }
+
+            GDALRasterBand *band = dataset->GetRasterBand(bands[n]);
+            float *startPxl = bandData.data() + ((((size_t)lvlY0) * baseLevel.width) + lvlX0);
+            CPLErr err = band->RasterIO(GF_Read, readX0, readY0, (readX1-readX0), (readY1-readY0), startPxl, (lvlX1-lvlX0), (lvlY1-lvlY0), GDT_Float32, 0, ((GSpacing)baseLevel.width)*sizeof(float), &extraArg);
+            if(err != CE_None)
+            {
+                throw RSGISRegistrationException("Could not read the image data for the image pyramid.");
+            }
+
+            int hasNoData = false;
+            float noDataVal = band->GetNoDataValue(&hasNoData);
+            if(hasNoData)
+            {
+                for(size_t i = 0; i < nPxls; ++i)
+                {
+                    if(bandData[i] == noDataVal)
+                    {
+                        bandData[i] = std::numeric_limits<float>::quiet_NaN();
+                    }
+                }
+            }
+        }
+        this->levels.push_back(baseLevel);
+    }
+
+    void RSGISImagePyramid::createNextLevel()
+    {
+        RSGISPyramidLevel nextLevel;
+        unsigned int prevWidth = this->levels.back().width;
+        unsigned int prevHeight = this->levels.back().height;
+        nextLevel.width = (prevWidth+1)/2;
+        nextLevel.height = (prevHeight+1)/2;
+        nextLevel.data.resize(this->numBands);
+
+        for(unsigned int n = 0; n < this->numBands; ++n)
+        {
+            const float *prevData = this->levels.back().data[n].data();
+            std::vector<float> &bandData = nextLevel.data[n];
+            bandData.resize(((size_t)nextLevel.width) * ((size_t)nextLevel.height));
+            for(unsigned int y = 0; y < nextLevel.height; ++y)
+            {
+                unsigned int prevY1 = std::min((y*2)+1, prevHeight-1);
+                for(unsigned int x = 0; x < nextLevel.width; ++x)
+                {
+                    unsigned int prevX1 = std::min((x*2)+1, prevWidth-1);
+                    double sum = 0.0;
+                    unsigned int count = 0;
+                    for(unsigned int py = y*2; py <= prevY1; ++py)
+                    {
+                        for(unsigned int px = x*2; px <= prevX1; ++px)
+                        {
+                            float val = prevData[(((size_t)py) * prevWidth) + px];
+                            if(!std::isnan(val))
+                            {
+                                sum += val;
+                                ++count;
+                            }
+                        }
+                    }
+                    bandData[(((size_t)y) * nextLevel.width) + x] = (count > 0)?(sum/count):std::numeric_limits<float>::quiet_NaN();
+                }
+            }
+        }
+        this->levels.push_back(nextLevel);
+    }
+
+    float RSGISImagePyramid::calcMetric(RSGISImagePyramid *floating, unsigned int level, int x0, int y0, unsigned int width, unsigned int height, int xOff, int yOff, RSGISImageSimilarityMetric *metric)
+    {
+        if(floating->getNumBands() != this->numBands)
+        {
+            throw RSGISRegistrationException("The image pyramids have a different number of bands.");
+        }
+        if((level < this->firstLevel) || (level >= this->getNumLevels()) || (level < floating->getFirstLevel()) || (level >= floating->getNumLevels()))
+        {
+            throw RSGISRegistrationException("The pyramid level is not available for both images.");
+        }
+        RSGISPyramidLevel &refLevel = this->levels[level - this->firstLevel];
+        int refWidth = refLevel.width;
+        int refHeight = refLevel.height;
+        int fltWidth = floating->getWidth(level);
+        int fltHeight = floating->getHeight(level);
+
+        // Clip the window to the pixels within both pyramids.
+        int xStart = std::max(std::max(x0, 0), -xOff);
+        int yStart = std::max(std::max(y0, 0), -yOff);
+        int xEnd = std::min(std::min(x0 + ((int)width), refWidth), fltWidth - xOff);
+        int yEnd = std::min(std::min(y0 + ((int)height), refHeight), fltHeight - yOff);
+        if((xEnd <= xStart) || (yEnd <= yStart))
+        {
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+
+        this->refVals.resize(this->numBands);
+        this->fltVals.resize(this->numBands);
+        for(unsigned int n = 0; n < this->numBands; ++n)
+        {
+            this->refVals[n].clear();
+            this->fltVals[n].clear();
+        }
+
+        for(int y = yStart; y < yEnd; ++y)
+        {
+            size_t refRowIdx = ((size_t)y) * refWidth;
+            size_t fltRowIdx = ((size_t)(y + yOff)) * fltWidth;
+            for(int x = xStart; x < xEnd; ++x)
+            {
+                bool valid = true;
+                for(unsigned int n = 0; n < this->numBands; ++n)
+                {
+                    if(std::isnan(refLevel.data[n][refRowIdx + x]) || std::isnan(floating->getBandData(level, n)[fltRowIdx + x + xOff]))
+                    {
+                        valid = false;
+                        break;
+                    }
+                }
+                if(valid)
+                {
+                    for(unsigned int n = 0; n < this->numBands; ++n)
+                    {
+                        this->refVals[n].push_back(refLevel.data[n][refRowIdx + x]);
+                        this->fltVals[n].push_back(floating->getBandData(level, n)[fltRowIdx + x + xOff]);
+                    }
+                }
+            }
+        }
+
+        unsigned int numVals = this->refVals[0].size();
+        if(numVals == 0)
+        {
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+
+        std::vector<float*> refPtrs(this->numBands);
+        std::vector<float*> fltPtrs(this->numBands);
+        for(unsigned int n = 0; n < this->numBands; ++n)
+        {
+            refPtrs[n] = this->refVals[n].data();
+            fltPtrs[n] = this->fltVals[n].data();
+        }
+        return metric->calcValue(refPtrs.data(), fltPtrs.data(), numVals, this->numBands);
+    }
+
+    RSGISImagePyramid::~RSGISImagePyramid()
+    {
+
+    }
+
+
+
+    double RSGISPhaseCorrelation::findShift(const float *imgA, const float *imgB, unsigned int width, unsigned int height, int *xShift, int *yShift)
+    {
+        if((width == 0) || (height == 0))
+        {
+            throw RSGISRegistrationException("Phase correlation requires images with at least one pixel.");
+        }
+        unsigned int padWidth = 1;
+        while(padWidth < width)
+        {
+            padWidth *= 2;
+        }
+        unsigned int padHeight = 1;
+        while(padHeight < height)
+        {
+            padHeight *= 2;
+        }
+
+        std::vector<double> dataA;
+        std::vector<double> dataB;
+        this->fillPadded(imgA, width, height, padWidth, padHeight, &dataA);
+        this->fillPadded(imgB, width, height, padWidth, padHeight, &dataB);
+        this->fft2D(&dataA, padWidth, padHeight, false);
+        this->fft2D(&dataB, padWidth, padHeight, false);
+
+        // Normalised cross power spectrum (A x conj(B)) / |A x conj(B)|, stored in dataA.
+        size_t nPxls = ((size_t)padWidth) * ((size_t)padHeight);
+        for(size_t i = 0; i < nPxls; ++i)
+        {
+            double aRe = dataA[i*2];
+            double aIm = dataA[(i*2)+1];
+            double bRe = dataB[i*2];
+            double bIm = dataB[(i*2)+1];
+            double re = (aRe * bRe) + (aIm * bIm);
+            double im = (aIm * bRe) - (aRe * bIm);
+            double mag = std::sqrt((re * re) + (im * im));
+            if(mag > 1e-12)
+            {
+                dataA[i*2] = re / mag;
+                dataA[(i*2)+1] = im / mag;
+            }
+            else
+            {
+                dataA[i*2] = 0.0;
+                dataA[(i*2)+1] = 0.0;
+            }
+        }
+        this->fft2D(&dataA, padWidth, padHeight, true);
+
+        size_t peakIdx = 0;
+        double peakVal = dataA[0];
+        for(size_t i = 1; i < nPxls; ++i)
+        {
+            if(dataA[i*2] > peakVal)
+            {
+                peakVal = dataA[i*2];
+                peakIdx = i;
+            }
+        }
+
+        // A peak at p means imgA(x) = imgB(x - p), with p wrapping around the padded image.
+        int peakX = peakIdx % padWidth;
+        int peakY = peakIdx / padWidth;
+        if(peakX > ((int)padWidth/2))
+        {
+            peakX -= padWidth;
+        }
+        if(peakY > ((int)padHeight/2))
+        {
+            peakY -= padHeight;
+        }
+        *xShift = peakX * (-1);
+        *yShift = peakY * (-1);
+
+        return peakVal;
+    }
+
+    void RSGISPhaseCorrelation::fillPadded(const float *img, unsigned int width, unsigned int height, unsigned int padWidth, unsigned int padHeight, std::vector<double> *data)
+    {
+        double sum = 0.0;
+        size_t count = 0;
+        size_t nPxls = ((size_t)width) * ((size_t)height);
+        for(size_t i = 0; i < nPxls; ++i)
+        {
+            if(!std::isnan(img[i]))
+            {
+                sum += img[i];
+                ++count;
+            }
+        }
+        double mean = (count > 0)?(sum/count):0.0;
+
+        data->assign(((size_t)padWidth) * ((size_t)padHeight) * 2, 0.0);
+        for(unsigned int y = 0; y < height; ++y)
+        {
+            double winY = (height > 1)?(0.5 - (0.5 * std::cos((2.0 * M_PI * y)/(height-1)))):1.0;
+            for(unsigned int x = 0; x < width; ++x)
+            {
+                double winX = (width > 1)?(0.5 - (0.5 * std::cos((2.0 * M_PI * x)/(width-1)))):1.0;
+                float val = img[(((size_t)y) * width) + x];
+                if(!std::isnan(val))
+                {
+                    (*data)[((((size_t)y) * padWidth) + x) * 2] = (val - mean) * winX * winY;
+                }
+            }
+        }
+    }
+
+    void RSGISPhaseCorrelation::fft2D(std::vector<double> *data, unsigned int padWidth, unsigned int padHeight, bool inverse)
+    {
+        // Rows and then columns, each as a strided 1D transform over the interleaved complex values.
+        double *vals = data->data();
+        for(unsigned int y = 0; y < padHeight; ++y)
+        {
+            double *row = vals + (((size_t)y) * padWidth * 2);
+            if(inverse)
+            {
+                gsl_fft_complex_radix2_inverse(row, 1, padWidth);
+            }
+            else
+            {
+                gsl_fft_complex_radix2_forward(row, 1, padWidth);
+            }
+        }
+        for(unsigned int x = 0; x < padWidth; ++x)
+        {
+            double *col = vals + (((size_t)x) * 2);
+            if(inverse)
+            {
+                gsl_fft_complex_radix2_inverse(col, padWidth, padHeight);
+            }
+            else
+            {
+                gsl_fft_complex_radix2_forward(col, padWidth, padHeight);
+            }
+        }
+    }
+
+}}
@@ -0,0 +1,132 @@
+/*
+ *  RSGISImagePyramid.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISImagePyramid_H
+#define RSGISImagePyramid_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "gdal_priv.h"
+
+#include "common/RSGISRegistrationException.h"
+
+#include "registration/RSGISImageSimilarityMetric.h"
+
+#include <gsl/gsl_fft_complex.h>
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_registration_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace reg{
+
+    /**
+     * An in-memory image pyramid of a window of an image for coarse-to-fine
+     * matching. Level 0 is the window at the native resolution and each
+     * following level halves the resolution, each pixel being the mean of the
+     * 2x2 pixels of the level below. Pixels outside the image or which are the
+     * band no data value are NaN and are ignored when the levels are averaged.
+     * Levels are not created once the width or height would be less than
+     * minLevelSize pixels. Where only the coarser levels are needed, the
+     * levels below firstLevel are not held and firstLevel is read directly
+     * with a decimated (averaging) read, rather than reading the window at the
+     * native resolution.
+     */
+    class DllExport RSGISImagePyramid
+    {
+    public:
+        /** bands start at 1; the window can extend beyond the image (those pixels are NaN). */
+        RSGISImagePyramid(GDALDataset *dataset, std::vector<unsigned int> bands, int xOff, int yOff, unsigned int width, unsigned int height, unsigned int numLevels, unsigned int minLevelSize=8, unsigned int firstLevel=0);
+        /** The number of levels, including those below the first level which are not held. */
+        unsigned int getNumLevels(){return this->firstLevel + this->levels.size();};
+        unsigned int getFirstLevel(){return this->firstLevel;};
+        unsigned int getNumBands(){return this->numBands;};
+        unsigned int getWidth(unsigned int level){return this->getLevel(level).width;};
+        unsigned int getHeight(unsigned int level){return this->getLevel(level).height;};
+        /** The data for a band (starting at 0) of a level as width x height values. */
+        float* getBandData(unsigned int level, unsigned int band){return this->getLevel(level).data[band].data();};
+        /**
+         * Compares the window [x0, x0+width) x [y0, y0+height) of the level with the
+         * same level of the floating pyramid, where pixel (x, y) is compared with
+         * floating pixel (x + xOff, y + yOff). Pixels outside either pyramid are
+         * ignored and NaN is returned if there are no pixels to compare.
+         */
+        float calcMetric(RSGISImagePyramid *floating, unsigned int level, int x0, int y0, unsigned int width, unsigned int height, int xOff, int yOff, RSGISImageSimilarityMetric *metric);
+        ~RSGISImagePyramid();
+    protected:
+        struct RSGISPyramidLevel
+        {
+            unsigned int width;
+            unsigned int height;
+            std::vector<std::vector<float> > data;
+        };
+        RSGISPyramidLevel& getLevel(unsigned int level);
+        void readBaseLevel(GDALDataset *dataset, std::vector<unsigned int> &bands, int xOff, int yOff, unsigned int width, unsigned int height);
+        void createNextLevel();
+        unsigned int numBands;
+        unsigned int firstLevel;
+        std::vector<RSGISPyramidLevel> levels;
+        std::vector<std::vector<float> > refVals;
+        std::vector<std::vector<float> > fltVals;
+    };
+
+    /**
+     * Estimates the translation between two images using phase correlation,
+     * where the peak of the inverse transform of the normalised cross power
+     * spectrum gives the shift. The images are padded to a power of 2, the
+     * mean removed and a Hann window applied to reduce the edge effects;
+     * NaN values are replaced by the mean.
+     */
+    class DllExport RSGISPhaseCorrelation
+    {
+    public:
+        RSGISPhaseCorrelation(){};
+        /**
+         * Finds the shift (xShift, yShift) where imgA(x, y) best matches
+         * imgB(x + xShift, y + yShift). The images are width x height and the
+         * shift is limited to half the padded image size. Returns the peak of
+         * the correlation surface (1 for a perfect match).
+         */
+        double findShift(const float *imgA, const float *imgB, unsigned int width, unsigned int height, int *xShift, int *yShift);
+        ~RSGISPhaseCorrelation(){};
+    protected:
+        void fillPadded(const float *img, unsigned int width, unsigned int height, unsigned int padWidth, unsigned int padHeight, std::vector<double> *data);
+        void fft2D(std::vector<double> *data, unsigned int padWidth, unsigned int padHeight, bool inverse);
+    };
+
+}}
+
+#endif
@@ -28,7 +28,7 @@
 namespace rsgis{namespace reg{
 
 		
-	RSGISImageRegistration::RSGISImageRegistration(GDALDataset *reference, GDALDataset *floating): referenceIMG(NULL), floatingIMG(NULL), overlap(NULL), overlapDefined(false)
+	RSGISImageRegistration::RSGISImageRegistration(GDALDataset *reference, GDALDataset *floating): referenceIMG(NULL), floatingIMG(NULL), overlap(NULL), overlapDefined(false), refPyramid(NULL), floatPyramid(NULL)
 	{
 		this->referenceIMG = reference;
 		this->floatingIMG = floating;
@@ -686,6 +686,118 @@ namespace rsgis{namespace reg{
 		return distanceMoved;
 	}
 	
+    void RSGISImageRegistration::buildPyramids(unsigned int numLevels)
+    {
+        if(referenceIMG->GetRasterCount() != floatingIMG->GetRasterCount())
+        {
+            throw RSGISRegistrationException("Both images need to have the same number of image bands.");
+        }
+        if(refPyramid != NULL)
+        {
+            delete refPyramid;
+        }
+        if(floatPyramid != NULL)
+        {
+            delete floatPyramid;
+        }
+
+        std::vector<unsigned int> bands;
+        for(int i = 1; i <= referenceIMG->GetRasterCount(); ++i)
+        {
+            bands.push_back(i);
+        }
+        // The coarse search stops at level 1 (the native level is searched from the images) so level 0 is not read.
+        unsigned int firstLevel = (numLevels > 1)?1:0;
+        refPyramid = new RSGISImagePyramid(referenceIMG, bands, 0, 0, referenceIMG->GetRasterXSize(), referenceIMG->GetRasterYSize(), numLevels, 8, firstLevel);
+        floatPyramid = new RSGISImagePyramid(floatingIMG, bands, 0, 0, floatingIMG->GetRasterXSize(), floatingIMG->GetRasterYSize(), refPyramid->getNumLevels(), 1, firstLevel);
+        std::cout << "Created image pyramids with " << refPyramid->getNumLevels() << " levels\n";
+    }
+
+    bool RSGISImageRegistration::findTiePointCoarseShift(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric)
+    {
+        if(!overlapDefined)
+        {
+            throw RSGISRegistrationException("The overlap needs to be defined before tie location can be defined.");
+        }
+        if((refPyramid == NULL) || (floatPyramid == NULL))
+        {
+            throw RSGISRegistrationException("The image pyramids need to be built before they can be searched.");
+        }
+        int numLevels = refPyramid->getNumLevels();
+        if(numLevels < 2)
+        {
+            return true;
+        }
+
+        // Floating pixel for reference pixel x is x + floatOffX - xShift.
+        double floatOffX = overlap->floatXStart - overlap->refXStart;
+        double floatOffY = overlap->floatYStart - overlap->refYStart;
+
+        bool found = false;
+        int bestXShift = 0;
+        int bestYShift = 0;
+        for(int level = numLevels-1; level >= 1; --level)
+        {
+            int scale = 1 << level;
+            int maxShift = (searchArea + scale - 1) / scale;
+            int x0 = floor((((double)tiePt->xRef) - windowSize) / scale);
+            int y0 = floor((((double)tiePt->yRef) - windowSize) / scale);
+            unsigned int lvlWinSize = std::max((((2 * windowSize) + 1) + scale - 1) / scale, (unsigned int)1);
+            int baseXOff = floor(((floatOffX - tiePt->xShift) / scale) + 0.5);
+            int baseYOff = floor(((floatOffY - tiePt->yShift) / scale) + 0.5);
+
+            int xStart = maxShift * (-1);
+            int xEnd = maxShift;
+            int yStart = maxShift * (-1);
+            int yEnd = maxShift;
+            if(found)
+            {
+                bestXShift *= 2;
+                bestYShift *= 2;
+                xStart = std::max(bestXShift - 1, xStart);
+                xEnd = std::min(bestXShift + 1, xEnd);
+                yStart = std::max(bestYShift - 1, yStart);
+                yEnd = std::min(bestYShift + 1, yEnd);
+            }
+
+            bool first = true;
+            double bestMetricVal = 0;
+            int lvlBestXShift = bestXShift;
+            int lvlBestYShift = bestYShift;
+            for(int yShift = yStart; yShift <= yEnd; ++yShift)
+            {
+                for(int xShift = xStart; xShift <= xEnd; ++xShift)
+                {
+                    double metricVal = refPyramid->calcMetric(floatPyramid, level, x0, y0, lvlWinSize, lvlWinSize, (baseXOff - xShift), (baseYOff - yShift), metric);
+                    if((boost::math::isnan)(metricVal))
+                    {
+                        continue;
+                    }
+                    if(first || (metric->findMin() && (metricVal < bestMetricVal)) || ((!metric->findMin()) && (metricVal > bestMetricVal)))
+                    {
+                        bestMetricVal = metricVal;
+                        lvlBestXShift = xShift;
+                        lvlBestYShift = yShift;
+                        first = false;
+                    }
+                }
+            }
+            if(!first)
+            {
+                bestXShift = lvlBestXShift;
+                bestYShift = lvlBestYShift;
+                found = true;
+            }
+        }
+
+        if(found)
+        {
+            tiePt->xShift += bestXShift * 2;
+            tiePt->yShift += bestYShift * 2;
+        }
+        return found;
+    }
+
 	float RSGISImageRegistration::findExtreme(bool findMin, gsl_vector *coefficients, unsigned int order, float minRange, float maxRange, unsigned int resolution, float *extremeVal)
 	{
 		double division = ((float)1)/((float)resolution);
@@ -1492,6 +1604,14 @@ namespace rsgis{namespace reg{
 		{
 			delete overlap;
 		}
+		if(refPyramid != NULL)
+		{
+			delete refPyramid;
+		}
+		if(floatPyramid != NULL)
+		{
+			delete floatPyramid;
+		}
 	}
 	
 
@@ -37,6 +37,7 @@
 #include "common/RSGISRegistrationException.h"
 
 #include "registration/RSGISImageSimilarityMetric.h"
+#include "registration/RSGISImagePyramid.h"
 
 #include "img/RSGISImageBandException.h"
 #include "img/RSGISImageUtils.h"
@@ -149,6 +150,15 @@ namespace rsgis{namespace reg{
 		void defineFirstTiePoint(unsigned int *startXOff, unsigned int *startYOff, unsigned int numXPts, unsigned int numYPts, unsigned int gap);
 		float findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, float metricThreshold, unsigned int subPixelResolution, float *moveInX, float *moveInY);
         float findTiePointLocation(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric, unsigned int subPixelResolution, float *moveInX, float *moveInY);
+        /** Builds in-memory image pyramids of the reference and floating images for findTiePointCoarseShift. */
+        void buildPyramids(unsigned int numLevels);
+        /**
+         * Searches for the tie point shift from the coarsest pyramid level down to level 1,
+         * refining the shift by a pixel either side at each level, and adds the shift found
+         * to the tie point so it only needs to be refined at the native resolution. Returns
+         * false if the metric could not be calculated at any level (the tie point is unchanged).
+         */
+        bool findTiePointCoarseShift(TiePoint *tiePt, unsigned int windowSize, unsigned int searchArea, RSGISImageSimilarityMetric *metric);
 		float findExtreme(bool findMin, gsl_vector *coefficients, unsigned int order, float minRange, float maxRange, unsigned int resolution, float *extremeVal);
         void getImageOverlapFloat(GDALDataset **datasets, int numDS,  float **dsOffsets, int *width, int *height, double *gdalTransform);
 		void getImageOverlapWithFloatShift(float xShift, float yShift, int **dsOffsets, int *width, int *height, double *gdalTransform, OGREnvelope *env, float *remainderX, float *remainderY);
@@ -162,6 +172,8 @@ namespace rsgis{namespace reg{
 		GDALDataset *floatingIMG;
 		OverlapRegion* overlap;
 		bool overlapDefined;
+		RSGISImagePyramid *refPyramid;
+		RSGISImagePyramid *floatPyramid;
 	};
 }}
 
@@ -0,0 +1,575 @@
+/*
+ *  RSGISWarpImageGCPs.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISWarpImageGCPs.h"
+
+namespace rsgis{namespace reg{
+
+    RSGISGCPTransform::RSGISGCPTransform(RSGISGCPTransformType transType, unsigned int polyOrder)
+    {
+        if((transType == rsgis_gcptrans_poly) && ((polyOrder < 1) || (polyOrder > 3)))
+        {
+            throw RSGISImageException("The polynomial order must be 1, 2 or 3.");
+        }
+        this->transType = transType;
+        this->polyOrder = polyOrder;
+        this->meanX = 0.0;
+        this->meanY = 0.0;
+        this->scale = 1.0;
+    }
+
+    void RSGISGCPTransform::fit(const std::vector<double> &inX, const std::vector<double> &inY, const std::vector<double> &outX, const std::vector<double> &outY)
+    {
+        size_t nPts = inX.size();
+        if((inY.size() != nPts) || (outX.size() != nPts) || (outY.size() != nPts))
+        {
+            throw RSGISImageException("The control point coordinate lists must be the same length.");
+        }
+        if(nPts < 3)
+        {
+            throw RSGISImageException("At least 3 control points are required to fit a transform.");
+        }
+
+        // Normalise the input coordinates to zero mean and unit spread.
+        this->meanX = 0.0;
+        this->meanY = 0.0;
+        for(size_t i = 0; i < nPts; ++i)
+        {
+            this->meanX += inX.at(i);
+            this->meanY += inY.at(i);
+        }
+        this->meanX /= nPts;
+        this->meanY /= nPts;
+        double sumSqDist = 0.0;
+        for(size_t i = 0; i < nPts; ++i)
+        {
+            sumSqDist += ((inX.at(i) - this->meanX) * (inX.at(i) - this->meanX)) + ((inY.at(i) - this->meanY) * (inY.at(i) - this->meanY));
+        }
+        this->scale = std::sqrt(sumSqDist / nPts);
+        if(this->scale == 0.0)
+        {
+            throw RSGISImageException("The control points are all at the same location.");
+        }
+
+        std::vector<double> nX(nPts);
+        std::vector<double> nY(nPts);
+        for(size_t i = 0; i < nPts; ++i)
+        {
+            nX.at(i) = (inX.at(i) - this->meanX) / this->scale;
+            nY.at(i) = (inY.at(i) - this->meanY) / this->scale;
+        }
+
+        if(this->transType == rsgis_gcptrans_tps)
+        {
+            this->fitTPS(nX, nY, outX, outY);
+        }
+        else
+        {
+            this->fitPoly(nX, nY, outX, outY);
+        }
+    }
+
+    void RSGISGCPTransform::transform(double inX, double inY, double *outX, double *outY) const
+    {
+        double x = (inX - this->meanX) / this->scale;
+        double y = (inY - this->meanY) / this->scale;
+        if(this->transType == rsgis_gcptrans_tps)
+        {
+            size_t nPts = this->ctrlX.size();
+            double valX = this->coeffsX[nPts] + (this->coeffsX[nPts+1] * x) + (this->coeffsX[nPts+2] * y);
+            double valY = this->coeffsY[nPts] + (this->coeffsY[nPts+1] * x) + (this->coeffsY[nPts+2] * y);
+            for(size_t i = 0; i < nPts; ++i)
+            {
+                double dX = x - this->ctrlX[i];
+                double dY = y - this->ctrlY[i];
+                double r2 = (dX * dX) + (dY * dY);
+                double u = (r2 > 0.0)?(r2 * std::log(r2)):0.0;
+                valX += this->coeffsX[i] * u;
+                valY += this->coeffsY[i] * u;
+            }
+            *outX = valX;
+            *outY = valY;
+        }
+        else
+        {
+            double terms[10];
+            this->polyTerms(x, y, terms);
+            unsigned int nTerms = this->numPolyTerms();
+            double valX = 0.0;
+            double valY = 0.0;
+            for(unsigned int i = 0; i < nTerms; ++i)
+            {
+                valX += this->coeffsX[i] * terms[i];
+                valY += this->coeffsY[i] * terms[i];
+            }
+            *outX = valX;
+            *outY = valY;
+        }
+    }
+
+    void RSGISGCPTransform::fitPoly(const std::vector<double> &nX, const std::vector<double> &nY, const std::vector<double> &outX, const std::vector<double> &outY)
+    {
+        size_t nPts = nX.size();
+        unsigned int nTerms = this->numPolyTerms();
+        if(nPts < nTerms)
+        {
+            throw RSGISImageException("There are not enough control points for a polynomial of order " + std::to_string(this->polyOrder) + " (" + std::to_string(nTerms) + " are required).");
+        }
+
+        gsl_matrix *a = gsl_matrix_alloc(nPts, nTerms);
+        gsl_vector *bX = gsl_vector_alloc(nPts);
+        gsl_vector *bY = gsl_vector_alloc(nPts);
+        gsl_vector *cX = gsl_vector_alloc(nTerms);
+        gsl_vector *cY = gsl_vector_alloc(nTerms);
+        gsl_matrix *cov = gsl_matrix_alloc(nTerms, nTerms);
+        double terms[10];
+        for(size_t i = 0; i < nPts; ++i)
+        {
+            this->polyTerms(nX.at(i), nY.at(i), terms);
+            for(unsigned int j = 0; j < nTerms; ++j)
+            {
+                gsl_matrix_set(a, i, j, terms[j]);
+            }
+            gsl_vector_set(bX, i, outX.at(i));
+            gsl_vector_set(bY, i, outY.at(i));
+        }
+
+        double chisq = 0.0;
+        gsl_multifit_linear_workspace *workspace = gsl_multifit_linear_alloc(nPts, nTerms);
+        gsl_multifit_linear(a, bX, cX, cov, &chisq, workspace);
+        gsl_multifit_linear(a, bY, cY, cov, &chisq, workspace);
+        gsl_multifit_linear_free(workspace);
+
+        this->coeffsX.assign(nTerms, 0.0);
+        this->coeffsY.assign(nTerms, 0.0);
+        for(unsigned int j = 0; j < nTerms; ++j)
+        {
+            this->coeffsX.at(j) = gsl_vector_get(cX, j);
+            this->coeffsY.at(j) = gsl_vector_get(cY, j);
+        }
+
+        gsl_matrix_free(a);
+        gsl_vector_free(bX);
+        gsl_vector_free(bY);
+        gsl_vector_free(cX);
+        gsl_vector_free(cY);
+        gsl_matrix_free(cov);
+    }
+
+    void RSGISGCPTransform::fitTPS(const std::vector<double> &nX, const std::vector<double> &nY, const std::vector<double> &outX, const std::vector<double> &outY)
+    {
+        // Duplicate control points make the system singular so only keep the first.
+        std::vector<size_t> idxs;
+        for(size_t i = 0; i < nX.size(); ++i)
+        {
+            bool duplicate = false;
+            for(auto iterIdx = idxs.begin(); iterIdx != idxs.end(); ++iterIdx)
+            {
+                if((nX.at(*iterIdx) == nX.at(i)) && (nY.at(*iterIdx) == nY.at(i)))
+                {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if(!duplicate)
+            {
+                idxs.push_back(i);
+            }
+        }
+        size_t nPts = idxs.size();
+        size_t nDims = nPts + 3;
+
+        this->ctrlX.assign(nPts, 0.0);
+        this->ctrlY.assign(nPts, 0.0);
+        for(size_t i = 0; i < nPts; ++i)
+        {
+            this->ctrlX.at(i) = nX.at(idxs.at(i));
+            this->ctrlY.at(i) = nY.at(idxs.at(i));
+        }
+
+        gsl_matrix *l = gsl_matrix_calloc(nDims, nDims);
+        gsl_vector *bX = gsl_vector_calloc(nDims);
+        gsl_vector *bY = gsl_vector_calloc(nDims);
+        gsl_vector *wX = gsl_vector_alloc(nDims);
+        gsl_vector *wY = gsl_vector_alloc(nDims);
+        gsl_permutation *perm = gsl_permutation_alloc(nDims);
+        for(size_t i = 0; i < nPts; ++i)
+        {
+            for(size_t j = i+1; j < nPts; ++j)
+            {
+                double dX = this->ctrlX.at(i) - this->ctrlX.at(j);
+                double dY = this->ctrlY.at(i) - this->ctrlY.at(j);
+                double r2 = (dX * dX) + (dY * dY);
+                double u = r2 * std::log(r2);
+                gsl_matrix_set(l, i, j, u);
+                gsl_matrix_set(l, j, i, u);
+            }
+            gsl_matrix_set(l, i, nPts, 1.0);
+            gsl_matrix_set(l, i, nPts+1, this->ctrlX.at(i));
+            gsl_matrix_set(l, i, nPts+2, this->ctrlY.at(i));
+            gsl_matrix_set(l, nPts, i, 1.0);
+            gsl_matrix_set(l, nPts+1, i, this->ctrlX.at(i));
+            gsl_matrix_set(l, nPts+2, i, this->ctrlY.at(i));
+            gsl_vector_set(bX, i, outX.at(idxs.at(i)));
+            gsl_vector_set(bY, i, outY.at(idxs.at(i)));
+        }
+
+        gsl_set_error_handler_off();
+        int signum = 0;
+        int status = gsl_linalg_LU_decomp(l, perm, &signum);
+        if(status == 0)
+        {
+            status = gsl_linalg_LU_solve(l, perm, bX, wX);
+        }
+        if(status == 0)
+        {
+            status = gsl_linalg_LU_solve(l, perm, bY, wY);
+        }
+
+        this->coeffsX.assign(nDims, 0.0);
+        this->coeffsY.assign(nDims, 0.0);
+        bool validSoln = (status == 0);
+        for(size_t i = 0; (i < nDims) && validSoln; ++i)
+        {
+            this->coeffsX.at(i) = gsl_vector_get(wX, i);
+            this->coeffsY.at(i) = gsl_vector_get(wY, i);
+            validSoln = std::isfinite(this->coeffsX.at(i)) && std::isfinite(this->coeffsY.at(i));
+        }
+
+        gsl_matrix_free(l);
+        gsl_vector_free(bX);
+        gsl_vector_free(bY);
+        gsl_vector_free(wX);
+        gsl_vector_free(wY);
+        gsl_permutation_free(perm);
+
+        if(!validSoln)
+        {
+            throw RSGISImageException("Could not fit a thin plate spline to the control points (are they collinear?).");
+        }
+    }
+
+    unsigned int RSGISGCPTransform::numPolyTerms() const
+    {
+        return ((this->polyOrder + 1) * (this->polyOrder + 2)) / 2;
+    }
+
+    void RSGISGCPTransform::polyTerms(double x, double y, double *terms) const
+    {
+        // 1, x, y, x^2, xy, y^2, x^3, x^2y, xy^2, y^3
+        unsigned int idx = 0;
+        for(unsigned int i = 0; i <= this->polyOrder; ++i)
+        {
+            for(unsigned int j = 0; j <= i; ++j)
+            {
+                terms[idx++] = std::pow(x, (double)(i-j)) * std::pow(y, (double)j);
+            }
+        }
+    }
+
+    RSGISGCPTransform::~RSGISGCPTransform()
+    {
+
+    }
+
+
+
+
+    RSGISWarpImageGCPs::RSGISWarpImageGCPs(RSGISGCPTransformType transType, unsigned int polyOrder, RSGISWarpInterp interp, unsigned int gridStep, float noDataVal, unsigned int numThreads)
+    {
+        this->transType = transType;
+        this->polyOrder = polyOrder;
+        this->interp = interp;
+        this->gridStep = (gridStep == 0)?1:gridStep;
+        this->noDataVal = noDataVal;
+        this->numThreads = numThreads;
+    }
+
+    void RSGISWarpImageGCPs::warpImage(GDALDataset *refDataset, GDALDataset *inDataset, std::vector<RSGISGCPImg2MapNode*> *gcps, std::string outputImage, std::string gdalFormat, GDALDataType outDataType)
+    {
+        // Fit the map to image transform once; the GCP image coordinates start at 1.
+        std::vector<double> mapX;
+        std::vector<double> mapY;
+        std::vector<double> imgX;
+        std::vector<double> imgY;
+        for(auto iterGCPs = gcps->begin(); iterGCPs != gcps->end(); ++iterGCPs)
+        {
+            mapX.push_back((*iterGCPs)->eastings());
+            mapY.push_back((*iterGCPs)->northings());
+            imgX.push_back((*iterGCPs)->imgX()-1);
+            imgY.push_back((*iterGCPs)->imgY()-1);
+        }
+        RSGISGCPTransform map2Img = RSGISGCPTransform(this->transType, this->polyOrder);
+        map2Img.fit(mapX, mapY, imgX, imgY);
+
+        int inXSize = inDataset->GetRasterXSize();
+        int inYSize = inDataset->GetRasterYSize();
+        int numBands = inDataset->GetRasterCount();
+        int hasNoData = false;
+        float inNoDataVal = (float)inDataset->GetRasterBand(1)->GetNoDataValue(&hasNoData);
+        if(!hasNoData)
+        {
+            inNoDataVal = this->noDataVal;
+        }
+
+        int width = refDataset->GetRasterXSize();
+        int height = refDataset->GetRasterYSize();
+        double refTrans[6];
+        refDataset->GetGeoTransform(refTrans);
+
+        GDALDriver *gdalDriver = GetGDALDriverManager()->GetDriverByName(gdalFormat.c_str());
+        if(gdalDriver == NULL)
+        {
+            throw RSGISImageException("Requested GDAL driver does not exist.");
+        }
+        rsgis::img::RSGISImageUtils imgUtils;
+        char **papszOptions = imgUtils.getGDALCreationOptionsForFormat(gdalFormat);
+        GDALDataset *outDataset = gdalDriver->Create(outputImage.c_str(), width, height, numBands, outDataType, papszOptions);
+        CSLDestroy(papszOptions);
+        if(outDataset == NULL)
+        {
+            throw RSGISImageException("Could not create image: " + outputImage);
+        }
+        outDataset->SetGeoTransform(refTrans);
+        outDataset->SetProjection(refDataset->GetProjectionRef());
+        for(int n = 0; n < numBands; ++n)
+        {
+            GDALRasterBand *outBand = outDataset->GetRasterBand(n+1);
+            outBand->SetNoDataValue(this->noDataVal);
+            outBand->SetDescription(inDataset->GetRasterBand(n+1)->GetDescription());
+        }
+
+        // Chunks of output rows are a multiple of the grid step so the grid rows line up.
+        int nRowsPerChunk = this->gridStep * std::max(1u, 256u / this->gridStep);
+        if(nRowsPerChunk > height)
+        {
+            nRowsPerChunk = height;
+        }
+        int nGridCols = ((width - 1) / (int)this->gridStep) + 2;
+        int nGridRows = ((nRowsPerChunk - 1) / (int)this->gridStep) + 2;
+        std::vector<double> gridX((size_t)nGridCols * nGridRows);
+        std::vector<double> gridY((size_t)nGridCols * nGridRows);
+        size_t nChunkPxls = ((size_t)width) * ((size_t)nRowsPerChunk);
+        float *outData = (float *) CPLMalloc(sizeof(float)*nChunkPxls*numBands);
+        float *inData = NULL;
+        // Kernel half width, in pixels, needed around the source window.
+        int kernelPad = (this->interp == rsgis_warp_cubic)?2:1;
+
+        try
+        {
+            RSGISThreadPool threadPool(this->numThreads);
+            double step = this->gridStep;
+            int nChunks = (height + nRowsPerChunk - 1) / nRowsPerChunk;
+            rsgis_tqdm pbar;
+            for(int c = 0; c < nChunks; ++c)
+            {
+                pbar.progress(c, nChunks);
+                int rowStart = c * nRowsPerChunk;
+                int nRows = std::min(nRowsPerChunk, height - rowStart);
+
+                // Evaluate the transform at the grid nodes (pixel centres).
+                threadPool.parallelFor(0, nGridRows, [&](unsigned long gStart, unsigned long gEnd){
+                    for(unsigned long gr = gStart; gr < gEnd; ++gr)
+                    {
+                        double outRow = rowStart + (gr * step) + 0.5;
+                        for(int gc = 0; gc < nGridCols; ++gc)
+                        {
+                            double outCol = (gc * step) + 0.5;
+                            double eastings = refTrans[0] + (outCol * refTrans[1]) + (outRow * refTrans[2]);
+                            double northings = refTrans[3] + (outCol * refTrans[4]) + (outRow * refTrans[5]);
+                            size_t idx = (gr * nGridCols) + gc;
+                            map2Img.transform(eastings, northings, &gridX[idx], &gridY[idx]);
+                        }
+                    }
+                });
+
+                // Find the source window covered by this chunk.
+                int gridRowsUsed = std::min(nGridRows, ((nRows - 1) / (int)this->gridStep) + 2);
+                double minX = gridX[0];
+                double maxX = gridX[0];
+                double minY = gridY[0];
+                double maxY = gridY[0];
+                for(size_t i = 0; i < ((size_t)gridRowsUsed) * nGridCols; ++i)
+                {
+                    minX = std::min(minX, gridX[i]);
+                    maxX = std::max(maxX, gridX[i]);
+                    minY = std::min(minY, gridY[i]);
+                    maxY = std::max(maxY, gridY[i]);
+                }
+                int winXOff = std::max(0, (int)std::floor(minX) - kernelPad);
+                int winYOff = std::max(0, (int)std::floor(minY) - kernelPad);
+                int winXEnd = std::min(inXSize, (int)std::ceil(maxX) + kernelPad + 1);
+                int winYEnd = std::min(inYSize, (int)std::ceil(maxY) + kernelPad + 1);
+                int winXSize = winXEnd - winXOff;
+                int winYSize = winYEnd - winYOff;
+                size_t nWinPxls = ((size_t)width) * ((size_t)nRows);
+
+                if((winXSize <= 0) || (winYSize <= 0))
+                {
+                    for(size_t i = 0; i < nWinPxls*numBands; ++i)
+                    {
+                        outData[i] = this->noDataVal;
+                    }
+                }
+                else
+                {
+                    size_t nInPxls = ((size_t)winXSize) * ((size_t)winYSize);
+                    inData = (float *) CPLMalloc(sizeof(float)*nInPxls*numBands);
+                    if(inDataset->RasterIO(GF_Read, winXOff, winYOff, winXSize, winYSize, inData, winXSize, winYSize, GDT_Float32, numBands, NULL, 0, 0, sizeof(float)*nInPxls) != CE_None)
+                    {
+                        throw RSGISImageException("Could not read the input image.");
+                    }
+
+                    threadPool.parallelFor(0, nRows, [&](unsigned long rStart, unsigned long rEnd){
+                        for(unsigned long r = rStart; r < rEnd; ++r)
+                        {
+                            unsigned long gr = r / this->gridStep;
+                            double fy = (r - (gr * step)) / step;
+                            for(int col = 0; col < width; ++col)
+                            {
+                                int gc = col / this->gridStep;
+                                double fx = (col - (gc * step)) / step;
+                                size_t idx = (gr * nGridCols) + gc;
+                                double srcX = ((1-fy) * (((1-fx) * gridX[idx]) + (fx * gridX[idx+1]))) + (fy * (((1-fx) * gridX[idx+nGridCols]) + (fx * gridX[idx+nGridCols+1])));
+                                double srcY = ((1-fy) * (((1-fx) * gridY[idx]) + (fx * gridY[idx+1]))) + (fy * (((1-fx) * gridY[idx+nGridCols]) + (fx * gridY[idx+nGridCols+1])));
+                                size_t outIdx = (r * width) + col;
+                                for(int n = 0; n < numBands; ++n)
+                                {
+                                    if((srcX < 0) || (srcY < 0) || (srcX >= inXSize) || (srcY >= inYSize))
+                                    {
+                                        outData[(n*nWinPxls) + outIdx] = this->noDataVal;
+                                    }
+                                    else
+                                    {
+                                        // Image coordinates are at the pixel corner; shift to centres.
+                                        outData[(n*nWinPxls) + outIdx] = this->samplePixel(&inData[n*nInPxls], winXSize, winYSize, srcX - 0.5 - winXOff, srcY - 0.5 - winYOff, inNoDataVal);
+                                    }
+                                }
+                            }
+                        }
+                    }, 8);
+                    CPLFree(inData);
+                    inData = NULL;
+                }
+
+                if(outDataset->RasterIO(GF_Write, 0, rowStart, width, nRows, outData, width, nRows, GDT_Float32, numBands, NULL, 0, 0, sizeof(float)*nWinPxls) != CE_None)
+                {
+                    throw RSGISImageException("Could not write to the output image.");
+                }
+            }
+            pbar.finish();
+        }
+        catch(std::exception &e)
+        {
+            if(inData != NULL)
+            {
+                CPLFree(inData);
+            }
+            CPLFree(outData);
+            GDALClose(outDataset);
+            throw RSGISImageException(e.what());
+        }
+
+        CPLFree(outData);
+        GDALClose(outDataset);
+    }
+
+    float RSGISWarpImageGCPs::samplePixel(const float *data, int winXSize, int winYSize, double x, double y, float inNoDataVal) const
+    {
+        int nearX = std::min(std::max((int)std::floor(x + 0.5), 0), winXSize-1);
+        int nearY = std::min(std::max((int)std::floor(y + 0.5), 0), winYSize-1);
+        float nearVal = data[(((size_t)nearY) * winXSize) + nearX];
+        if((this->interp == rsgis_warp_nearest) || (nearVal == inNoDataVal))
+        {
+            return (nearVal == inNoDataVal)?this->noDataVal:nearVal;
+        }
+
+        int x0 = (int)std::floor(x);
+        int y0 = (int)std::floor(y);
+        double dx = x - x0;
+        double dy = y - y0;
+        double sum = 0.0;
+        double sumWeights = 0.0;
+        if(this->interp == rsgis_warp_bilinear)
+        {
+            for(int j = 0; j < 2; ++j)
+            {
+                int yIdx = std::min(std::max(y0 + j, 0), winYSize-1);
+                double wY = (j == 0)?(1-dy):dy;
+                for(int i = 0; i < 2; ++i)
+                {
+                    int xIdx = std::min(std::max(x0 + i, 0), winXSize-1);
+                    float val = data[(((size_t)yIdx) * winXSize) + xIdx];
+                    if(val == inNoDataVal)
+                    {
+                        return nearVal;
+                    }
+                    double w = wY * ((i == 0)?(1-dx):dx);
+                    sum += w * val;
+                    sumWeights += w;
+                }
+            }
+        }
+        else
+        {
+            for(int j = -1; j < 3; ++j)
+            {
+                int yIdx = std::min(std::max(y0 + j, 0), winYSize-1);
+                double wY = cubicWeight(j - dy);
+                for(int i = -1; i < 3; ++i)
+                {
+                    int xIdx = std::min(std::max(x0 + i, 0), winXSize-1);
+                    float val = data[(((size_t)yIdx) * winXSize) + xIdx];
+                    if(val == inNoDataVal)
+                    {
+                        return nearVal;
+                    }
+                    double w = wY * cubicWeight(i - dx);
+                    sum += w * val;
+                    sumWeights += w;
+                }
+            }
+        }
+        return (float)(sum / sumWeights);
+    }
+
+    inline double RSGISWarpImageGCPs::cubicWeight(double d)
+    {
+        // Keys cubic convolution kernel with a = -0.5.
+        d = std::fabs(d);
+        if(d < 1.0)
+        {
+            return (((1.5 * d) - 2.5) * d * d) + 1.0;
+        }
+        else if(d < 2.0)
+        {
+            return (((((-0.5 * d) + 2.5) * d) - 4.0) * d) + 2.0;
+        }
+        return 0.0;
+    }
+
+    RSGISWarpImageGCPs::~RSGISWarpImageGCPs()
+    {
+
+    }
+
+}}
@@ -0,0 +1,131 @@
+/*
+ *  RSGISWarpImageGCPs.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISWarpImageGCPs_H
+#define RSGISWarpImageGCPs_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include "gdal_priv.h"
+
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_multifit.h>
+#include <gsl/gsl_permutation.h>
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISImageException.h"
+#include "common/RSGISThreadPool.h"
+
+#include "img/RSGISImageUtils.h"
+
+#include "registration/RSGISGCPImg2MapNode.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_registration_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace reg{
+
+    enum RSGISGCPTransformType
+    {
+        rsgis_gcptrans_poly = 0,
+        rsgis_gcptrans_tps = 1
+    };
+
+    enum RSGISWarpInterp
+    {
+        rsgis_warp_nearest = 0,
+        rsgis_warp_bilinear = 1,
+        rsgis_warp_cubic = 2
+    };
+
+    /**
+     * A 2D transform fitted to a set of control points, either a least squares
+     * polynomial (order 1-3) or an exact thin plate spline. The input coordinates
+     * are normalised before fitting to keep the systems well conditioned.
+     */
+    class DllExport RSGISGCPTransform
+    {
+    public:
+        RSGISGCPTransform(RSGISGCPTransformType transType, unsigned int polyOrder=1);
+        void fit(const std::vector<double> &inX, const std::vector<double> &inY, const std::vector<double> &outX, const std::vector<double> &outY);
+        void transform(double inX, double inY, double *outX, double *outY) const;
+        ~RSGISGCPTransform();
+    protected:
+        void fitPoly(const std::vector<double> &nX, const std::vector<double> &nY, const std::vector<double> &outX, const std::vector<double> &outY);
+        void fitTPS(const std::vector<double> &nX, const std::vector<double> &nY, const std::vector<double> &outX, const std::vector<double> &outY);
+        unsigned int numPolyTerms() const;
+        void polyTerms(double x, double y, double *terms) const;
+        RSGISGCPTransformType transType;
+        unsigned int polyOrder;
+        double meanX;
+        double meanY;
+        double scale;
+        std::vector<double> coeffsX;
+        std::vector<double> coeffsY;
+        std::vector<double> ctrlX;
+        std::vector<double> ctrlY;
+    };
+
+    /**
+     * Warps an image onto the pixel grid of a reference image using a set of GCPs
+     * (e.g., from RSGISBasicImageRegistration). The map to image transform is fitted
+     * once and evaluated on a coarse grid of output pixels (every gridStep pixels),
+     * with the source location of each output pixel bilinearly interpolated from the
+     * grid. Chunks of output rows are read once and resampled on a pool of threads.
+     */
+    class DllExport RSGISWarpImageGCPs
+    {
+    public:
+        RSGISWarpImageGCPs(RSGISGCPTransformType transType, unsigned int polyOrder, RSGISWarpInterp interp, unsigned int gridStep=16, float noDataVal=0.0, unsigned int numThreads=0);
+        void warpImage(GDALDataset *refDataset, GDALDataset *inDataset, std::vector<RSGISGCPImg2MapNode*> *gcps, std::string outputImage, std::string gdalFormat, GDALDataType outDataType);
+        ~RSGISWarpImageGCPs();
+    protected:
+        float samplePixel(const float *data, int winXSize, int winYSize, double x, double y, float inNoDataVal) const;
+        static inline double cubicWeight(double d);
+        RSGISGCPTransformType transType;
+        unsigned int polyOrder;
+        RSGISWarpInterp interp;
+        unsigned int gridStep;
+        float noDataVal;
+        unsigned int numThreads;
+    };
+
+}}
+
+#endif
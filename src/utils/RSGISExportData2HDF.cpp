@@ -28,7 +28,7 @@ namespace rsgis{namespace utils{
     
     RSGISExportColumnData2HDF::RSGISExportColumnData2HDF()
     {
-        
+        this->dataH5File = NULL;
     }
 
     H5::DataType RSGISExportColumnData2HDF::getH5DataType(RSGISLibDataType rsgis_datatype)
@@ -215,17 +215,76 @@ namespace rsgis{namespace utils{
         }
     }
     
+    void RSGISExportColumnData2HDF::addDataRows(void *data, size_t nRows, H5::DataType h5Datatype)
+    {
+        if(nRows == 0)
+        {
+            return;
+        }
+        try
+        {
+            H5::Exception::dontPrint();
+            
+            hsize_t extendDatasetTo[2];
+            extendDatasetTo[0] = this->numColsWritten + nRows;
+            extendDatasetTo[1] = this->numCols;
+            columnDataSet.extend( extendDatasetTo );
+            
+            hsize_t dataOffset[2];
+            dataOffset[0] = this->numColsWritten;
+            dataOffset[1] = 0;
+            hsize_t dataDims[2];
+            dataDims[0] = nRows;
+            dataDims[1] = numCols;
+            
+            H5::DataSpace colWriteDataSpace = columnDataSet.getSpace();
+            colWriteDataSpace.selectHyperslab(H5S_SELECT_SET, dataDims, dataOffset);
+            H5::DataSpace newDataspace = H5::DataSpace(2, dataDims);
+            
+            columnDataSet.write(data, h5Datatype, newDataspace, colWriteDataSpace);
+            
+            this->numColsWritten += nRows;
+        }
+        catch (rsgis::RSGISFileException &e)
+        {
+            throw e;
+        }
+        catch (H5::Exception &e)
+        {
+            throw RSGISFileException(e.getCDetailMsg());
+        }
+        catch ( std::exception &e)
+        {
+            throw RSGISFileException(e.what());
+        }
+    }
+    
     void RSGISExportColumnData2HDF::close()
     {
         this->columnDataSet.close();
         this->dataH5File->flush(H5F_SCOPE_GLOBAL);
         this->dataH5File->close();
         delete this->dataH5File;
+        this->dataH5File = NULL;
     }
 		
     RSGISExportColumnData2HDF::~RSGISExportColumnData2HDF()
     {
-        
+        // Only still open if an error stopped the export before close().
+        if(this->dataH5File != NULL)
+        {
+            try
+            {
+                this->columnDataSet.close();
+                this->dataH5File->close();
+            }
+            catch (H5::Exception &e)
+            {
+                std::cerr << "WARNING: Could not close the HDF5 file: " << e.getCDetailMsg() << std::endl;
+            }
+            delete this->dataH5File;
+            this->dataH5File = NULL;
+        }
     }
 
 
@@ -235,6 +294,272 @@ namespace rsgis{namespace utils{
 
 
     
+    RSGISExportChipData2HDF::RSGISExportChipData2HDF()
+    {
+        this->dataH5File = NULL;
+        this->withRef = false;
+        this->numChipsWritten = 0;
+        this->numBuffered = 0;
+    }
+    
+    void RSGISExportChipData2HDF::createFile(std::string filePath, unsigned int chipSize, unsigned int numBands, bool withRef, std::string description, H5::DataType dataType, unsigned int chunkChips)
+    {
+        try
+        {
+            H5::Exception::dontPrint();
+            
+            if((chipSize == 0) || (numBands == 0) || (chunkChips == 0))
+            {
+                throw RSGISFileException("The chip size, number of bands and chunk size must be greater than zero.");
+            }
+            
+            H5::FileAccPropList dataAccessPlist = H5::FileAccPropList(H5::FileAccPropList::DEFAULT);
+            dataAccessPlist.setCache(HDF5_WRITE_MDC_NELMTS, HDF5_WRITE_RDCC_NELMTS, HDF5_WRITE_RDCC_NBYTES, HDF5_WRITE_RDCC_W0);
+            dataAccessPlist.setSieveBufSize(HDF5_WRITE_SIEVE_BUF);
+            hsize_t metaBlockSize = HDF5_WRITE_META_BLOCKSIZE;
+            dataAccessPlist.setMetaBlockSize(metaBlockSize);
+            
+            const H5std_string dataFilePath( filePath );
+            this->dataH5File = new H5::H5File( dataFilePath, H5F_ACC_TRUNC, H5::FileCreatPropList::DEFAULT, dataAccessPlist);
+            
+            // Create the data folders.
+            this->dataH5File->createGroup( "/DATA" );
+            this->dataH5File->createGroup( "/META-DATA" );
+            
+            // Create the data description.
+            hsize_t dims1Str[1];
+            dims1Str[0] = 1;
+            H5::DataSpace dataspaceStrAll(1, dims1Str);
+            H5::StrType strTypeAll(0, H5T_VARIABLE);
+            H5::DataSet datasetDescription = this->dataH5File->createDataSet( "/META-DATA/DESCRIPTION", strTypeAll, dataspaceStrAll);
+            const char *wStrdata[1] = {description.c_str()};
+            datasetDescription.write((void*)wStrdata, strTypeAll);
+            datasetDescription.close();
+            
+            this->chipSize = chipSize;
+            this->numBands = numBands;
+            this->withRef = withRef;
+            this->chunkChips = chunkChips;
+            this->chipLen = ((size_t)chipSize) * chipSize * numBands;
+            this->refLen = ((size_t)chipSize) * chipSize;
+            this->numChipsWritten = 0;
+            this->numBuffered = 0;
+            this->chipBuffer = std::vector<float>(this->chipLen * chunkChips);
+            if(withRef)
+            {
+                this->refBuffer = std::vector<unsigned short>(this->refLen * chunkChips);
+            }
+            
+            int initFillVal = 0;
+            hsize_t dimsDataChunk[] = { chunkChips, chipSize, chipSize, numBands };
+            H5::DSetCreatPropList initParamsData;
+            initParamsData.setChunk(4, dimsDataChunk);
+            initParamsData.setShuffle();
+            initParamsData.setDeflate(HDF5_WRITE_DEFLATE);
+            initParamsData.setFillValue( H5::PredType::NATIVE_INT, &initFillVal);
+            
+            hsize_t initDataDims[] = { 0, chipSize, chipSize, numBands };
+            hsize_t maxDataDims[] = { H5S_UNLIMITED, chipSize, chipSize, numBands };
+            H5::DataSpace dataSpaceData(4, initDataDims, maxDataDims);
+            this->chipDataSet = this->dataH5File->createDataSet("/DATA/DATA", dataType, dataSpaceData, initParamsData);
+            
+            if(withRef)
+            {
+                H5::DSetCreatPropList initParamsRef;
+                initParamsRef.setChunk(3, dimsDataChunk);
+                initParamsRef.setShuffle();
+                initParamsRef.setDeflate(HDF5_WRITE_DEFLATE);
+                initParamsRef.setFillValue( H5::PredType::NATIVE_INT, &initFillVal);
+                
+                H5::DataSpace dataSpaceRef(3, initDataDims, maxDataDims);
+                this->refDataSet = this->dataH5File->createDataSet("/DATA/REF", H5::PredType::STD_U16LE, dataSpaceRef, initParamsRef);
+            }
+        }
+        catch (rsgis::RSGISFileException &e)
+        {
+            throw e;
+        }
+        catch (H5::Exception &e)
+        {
+            throw RSGISFileException(e.getCDetailMsg());
+        }
+        catch ( std::exception &e)
+        {
+            throw RSGISFileException(e.what());
+        }
+    }
+    
+    void RSGISExportChipData2HDF::addChips(const float *chipVals, const unsigned short *refVals, size_t numChips)
+    {
+        if(this->withRef && (refVals == NULL))
+        {
+            throw RSGISFileException("Reference chips must be provided.");
+        }
+        size_t chipIdx = 0;
+        while(chipIdx < numChips)
+        {
+            size_t numCopy = std::min(numChips - chipIdx, (size_t)(this->chunkChips - this->numBuffered));
+            std::copy(chipVals + (chipIdx * this->chipLen), chipVals + ((chipIdx + numCopy) * this->chipLen), this->chipBuffer.begin() + (this->numBuffered * this->chipLen));
+            if(this->withRef)
+            {
+                std::copy(refVals + (chipIdx * this->refLen), refVals + ((chipIdx + numCopy) * this->refLen), this->refBuffer.begin() + (this->numBuffered * this->refLen));
+            }
+            this->numBuffered += numCopy;
+            chipIdx += numCopy;
+            if(this->numBuffered == this->chunkChips)
+            {
+                this->writeBuffer();
+            }
+        }
+    }
+    
+    void RSGISExportChipData2HDF::appendChipFile(std::string filePath)
+    {
+        try
+        {
+            H5::Exception::dontPrint();
+            
+            const H5std_string h5FilePath(filePath);
+            H5::H5File inH5File = H5::H5File(h5FilePath, H5F_ACC_RDONLY);
+            H5::DataSet inDataSet = inH5File.openDataSet("/DATA/DATA");
+            H5::DataSpace inDataSpace = inDataSet.getSpace();
+            if(inDataSpace.getSimpleExtentNdims() != 4)
+            {
+                throw RSGISFileException("The input file is not a chip file: " + filePath);
+            }
+            hsize_t dims[4];
+            inDataSpace.getSimpleExtentDims(dims);
+            if((dims[1] != this->chipSize) || (dims[2] != this->chipSize) || (dims[3] != this->numBands))
+            {
+                throw RSGISFileException("The chip size and number of bands must be the same for all the files: " + filePath);
+            }
+            
+            H5::DataSet inRefDataSet;
+            H5::DataSpace inRefDataSpace;
+            if(this->withRef)
+            {
+                inRefDataSet = inH5File.openDataSet("/DATA/REF");
+                inRefDataSpace = inRefDataSet.getSpace();
+            }
+            
+            // Read a chunk of chips at a time straight into the write buffer.
+            size_t numInChips = dims[0];
+            size_t chipIdx = 0;
+            while(chipIdx < numInChips)
+            {
+                hsize_t numRead = std::min(numInChips - chipIdx, (size_t)(this->chunkChips - this->numBuffered));
+                hsize_t dataOffset[4] = {chipIdx, 0, 0, 0};
+                hsize_t dataDims[4] = {numRead, this->chipSize, this->chipSize, this->numBands};
+                H5::DataSpace memDataSpace = H5::DataSpace(4, dataDims);
+                inDataSpace.selectHyperslab(H5S_SELECT_SET, dataDims, dataOffset);
+                inDataSet.read(&this->chipBuffer[this->numBuffered * this->chipLen], H5::PredType::NATIVE_FLOAT, memDataSpace, inDataSpace);
+                if(this->withRef)
+                {
+                    H5::DataSpace memRefDataSpace = H5::DataSpace(3, dataDims);
+                    inRefDataSpace.selectHyperslab(H5S_SELECT_SET, dataDims, dataOffset);
+                    inRefDataSet.read(&this->refBuffer[this->numBuffered * this->refLen], H5::PredType::NATIVE_USHORT, memRefDataSpace, inRefDataSpace);
+                }
+                this->numBuffered += numRead;
+                chipIdx += numRead;
+                if(this->numBuffered == this->chunkChips)
+                {
+                    this->writeBuffer();
+                }
+            }
+            inH5File.close();
+        }
+        catch (rsgis::RSGISFileException &e)
+        {
+            throw e;
+        }
+        catch (H5::Exception &e)
+        {
+            throw RSGISFileException(e.getCDetailMsg());
+        }
+    }
+    
+    void RSGISExportChipData2HDF::writeBuffer()
+    {
+        if(this->numBuffered == 0)
+        {
+            return;
+        }
+        try
+        {
+            H5::Exception::dontPrint();
+            
+            hsize_t extendDatasetTo[4] = {this->numChipsWritten + this->numBuffered, this->chipSize, this->chipSize, this->numBands};
+            hsize_t dataOffset[4] = {this->numChipsWritten, 0, 0, 0};
+            hsize_t dataDims[4] = {this->numBuffered, this->chipSize, this->chipSize, this->numBands};
+            
+            this->chipDataSet.extend( extendDatasetTo );
+            H5::DataSpace chipWriteDataSpace = this->chipDataSet.getSpace();
+            chipWriteDataSpace.selectHyperslab(H5S_SELECT_SET, dataDims, dataOffset);
+            H5::DataSpace newDataspace = H5::DataSpace(4, dataDims);
+            this->chipDataSet.write(this->chipBuffer.data(), H5::PredType::NATIVE_FLOAT, newDataspace, chipWriteDataSpace);
+            
+            if(this->withRef)
+            {
+                this->refDataSet.extend( extendDatasetTo );
+                H5::DataSpace refWriteDataSpace = this->refDataSet.getSpace();
+                refWriteDataSpace.selectHyperslab(H5S_SELECT_SET, dataDims, dataOffset);
+                H5::DataSpace newRefDataspace = H5::DataSpace(3, dataDims);
+                this->refDataSet.write(this->refBuffer.data(), H5::PredType::NATIVE_USHORT, newRefDataspace, refWriteDataSpace);
+            }
+            
+            this->numChipsWritten += this->numBuffered;
+            this->numBuffered = 0;
+        }
+        catch (H5::Exception &e)
+        {
+            throw RSGISFileException(e.getCDetailMsg());
+        }
+    }
+    
+    void RSGISExportChipData2HDF::close()
+    {
+        this->writeBuffer();
+        this->chipDataSet.close();
+        if(this->withRef)
+        {
+            this->refDataSet.close();
+        }
+        this->dataH5File->flush(H5F_SCOPE_GLOBAL);
+        this->dataH5File->close();
+        delete this->dataH5File;
+        this->dataH5File = NULL;
+    }
+    
+    RSGISExportChipData2HDF::~RSGISExportChipData2HDF()
+    {
+        // The file is only still open if an error stopped the export before close().
+        if(this->dataH5File != NULL)
+        {
+            try
+            {
+                this->chipDataSet.close();
+                if(this->withRef)
+                {
+                    this->refDataSet.close();
+                }
+                this->dataH5File->close();
+            }
+            catch (H5::Exception &e)
+            {
+                std::cerr << "WARNING: Could not close the chip HDF5 file: " << e.getCDetailMsg() << std::endl;
+            }
+            delete this->dataH5File;
+            this->dataH5File = NULL;
+        }
+    }
+    
+    
+    
+    
+    
+    
+    
+    
     RSGISReadHDFColumnData::RSGISReadHDFColumnData()
     {
         fileOpen = false;
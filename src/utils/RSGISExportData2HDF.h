@@ -26,6 +26,8 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 #include <boost/cstdint.hpp>
 
@@ -72,6 +74,9 @@ namespace rsgis{namespace utils{
         H5::DataType getH5DataType(RSGISLibDataType rsgis_datatype);
         void createFile(std::string filePath, unsigned int numCols, std::string description, H5::DataType dataType);
         void addDataRow(void *data, H5::DataType h5Datatype);
+        /** Adds nRows rows (row-major, numCols values per row) with a single extend and write. */
+        void addDataRows(void *data, size_t nRows, H5::DataType h5Datatype);
+        size_t getNumRows(){return this->numColsWritten;};
         void close();
 		~RSGISExportColumnData2HDF();
     protected:
@@ -79,9 +84,45 @@ namespace rsgis{namespace utils{
         H5::DataSet columnDataSet;
         unsigned int numCols;
         unsigned int blockSize;
-        unsigned int numColsWritten;
+        size_t numColsWritten;
 	};
     
+    /**
+     * Writes image chips to a HDF5 file as /DATA/DATA (chips, chipSize, chipSize, bands), with
+     * the values of each chip ordered (x, y, band), and optionally reference chips as /DATA/REF
+     * (chips, chipSize, chipSize) of uint16, ordered (y, x), as the rsgislib.zonalstats chip
+     * functions. Chips are buffered and written a whole (compressed) chunk at a time so each
+     * chunk is only written once.
+     */
+    class DllExport RSGISExportChipData2HDF
+    {
+    public:
+        RSGISExportChipData2HDF();
+        void createFile(std::string filePath, unsigned int chipSize, unsigned int numBands, bool withRef, std::string description, H5::DataType dataType, unsigned int chunkChips=HDF5_WRITE_CHUNK_SIZE);
+        /** Adds chips of chipSize x chipSize x numBands values and, if withRef, chipSize x chipSize reference values. */
+        void addChips(const float *chipVals, const unsigned short *refVals, size_t numChips);
+        /** Appends the chips of an existing chip file, reading it a chunk at a time. */
+        void appendChipFile(std::string filePath);
+        size_t getNumChips(){return this->numChipsWritten + this->numBuffered;};
+        void close();
+        ~RSGISExportChipData2HDF();
+    protected:
+        void writeBuffer();
+        H5::H5File *dataH5File;
+        H5::DataSet chipDataSet;
+        H5::DataSet refDataSet;
+        unsigned int chipSize;
+        unsigned int numBands;
+        bool withRef;
+        unsigned int chunkChips;
+        size_t chipLen;
+        size_t refLen;
+        size_t numChipsWritten;
+        size_t numBuffered;
+        std::vector<float> chipBuffer;
+        std::vector<unsigned short> refBuffer;
+    };
+    
     class DllExport RSGISReadHDFColumnData
     {
     public:
@@ -0,0 +1,326 @@
+/*
+ *  RSGISHDFSampleManager.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISHDFSampleManager.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace rsgis{namespace utils{
+
+    RSGISHDFSampleManager::RSGISHDFSampleManager(unsigned int numThreads, size_t blockRows, size_t shuffleWindowBlocks)
+    {
+        this->numThreads = numThreads;
+        this->blockRows = std::max<size_t>(blockRows, 1);
+        this->shuffleWindowBlocks = std::max<size_t>(shuffleWindowBlocks, 1);
+    }
+
+    size_t RSGISHDFSampleManager::countRows(std::vector<std::string> inputH5Files, unsigned int *numCols)
+    {
+        if(inputH5Files.empty())
+        {
+            throw RSGISFileException("No input HDF5 files were provided.");
+        }
+        size_t numRows = 0;
+        *numCols = 0;
+        for(size_t i = 0; i < inputH5Files.size(); ++i)
+        {
+            RSGISReadHDFColumnData readHDFCol;
+            readHDFCol.openFile(inputH5Files.at(i));
+            unsigned int fileNumCols = readHDFCol.getNumCols();
+            if(i == 0)
+            {
+                *numCols = fileNumCols;
+            }
+            else if(fileNumCols != *numCols)
+            {
+                readHDFCol.close();
+                throw RSGISFileException("The number of variables within the input HDF5 files is not the same: " + inputH5Files.at(i));
+            }
+            numRows += readHDFCol.getNumRows();
+            readHDFCol.close();
+        }
+        return numRows;
+    }
+
+    void RSGISHDFSampleManager::distributeRows(std::vector<std::string> inputH5Files, std::vector<std::string> outputH5Files, std::vector<size_t> outNumRows, int seed, H5::DataType dataType, bool shuffle, std::string description)
+    {
+        if(outputH5Files.size() != outNumRows.size())
+        {
+            throw RSGISFileException("The number of output files and the number of rows for each output are not the same.");
+        }
+        unsigned int numCols = 0;
+        size_t numRows = this->countRows(inputH5Files, &numCols);
+        size_t numSelect = 0;
+        for(size_t k = 0; k < outNumRows.size(); ++k)
+        {
+            numSelect += outNumRows.at(k);
+        }
+        if(numSelect > numRows)
+        {
+            throw RSGISFileException("There are not enough rows within the input files for the samples requested.");
+        }
+
+        std::mt19937_64 randomGen(seed);
+        size_t numOuts = outputH5Files.size();
+
+        // When shuffling the selected rows are written (as doubles, so no values are changed) to a temporary file first.
+        std::vector<std::string> writeH5Files = outputH5Files;
+        H5::DataType writeDataType = dataType;
+        if(shuffle)
+        {
+            for(size_t k = 0; k < numOuts; ++k)
+            {
+                writeH5Files.at(k) = outputH5Files.at(k) + ".unshuffled.tmp";
+            }
+            writeDataType = H5::PredType::IEEE_F64LE;
+        }
+        try
+        {
+            std::vector<RSGISExportColumnData2HDF> writers(numOuts);
+            for(size_t k = 0; k < numOuts; ++k)
+            {
+                writers.at(k).createFile(writeH5Files.at(k), numCols, description, writeDataType);
+            }
+
+            std::vector<std::vector<double> > outBuffers(numOuts);
+            std::vector<size_t> outBufferRows(numOuts, 0);
+            for(size_t k = 0; k < numOuts; ++k)
+            {
+                outBuffers.at(k).resize(this->blockRows * numCols);
+            }
+            std::vector<double> inBlock(this->blockRows * numCols);
+            std::vector<int> rowOuts(this->blockRows);
+
+            std::vector<size_t> remainNeeded = outNumRows;
+            size_t remainNeededTotal = numSelect;
+            size_t remainRows = numRows;
+            size_t numRowsDone = 0;
+
+            rsgis_tqdm pbar;
+            for(size_t i = 0; (i < inputH5Files.size()) && (remainNeededTotal > 0); ++i)
+            {
+                RSGISReadHDFColumnData readHDFCol;
+                readHDFCol.openFile(inputH5Files.at(i));
+                size_t fileNumRows = readHDFCol.getNumRows();
+                for(size_t rowOff = 0; (rowOff < fileNumRows) && (remainNeededTotal > 0); rowOff += this->blockRows)
+                {
+                    size_t nBlockRows = std::min(this->blockRows, fileNumRows - rowOff);
+
+                    // Selection sampling: each row is selected with probability (rows needed / rows remaining).
+                    bool anySelected = false;
+                    for(size_t r = 0; r < nBlockRows; ++r)
+                    {
+                        rowOuts[r] = -1;
+                        if(remainNeededTotal > 0)
+                        {
+                            std::uniform_int_distribution<size_t> randomDist(0, remainRows-1);
+                            size_t randomVal = randomDist(randomGen);
+                            if(randomVal < remainNeededTotal)
+                            {
+                                size_t cumNeeded = 0;
+                                for(size_t k = 0; k < numOuts; ++k)
+                                {
+                                    cumNeeded += remainNeeded[k];
+                                    if(randomVal < cumNeeded)
+                                    {
+                                        rowOuts[r] = k;
+                                        --remainNeeded[k];
+                                        break;
+                                    }
+                                }
+                                --remainNeededTotal;
+                                anySelected = true;
+                            }
+                        }
+                        --remainRows;
+                    }
+
+                    if(anySelected)
+                    {
+                        readHDFCol.getDataRows(inBlock.data(), numCols, nBlockRows, H5::PredType::NATIVE_DOUBLE, rowOff, nBlockRows);
+                        for(size_t r = 0; r < nBlockRows; ++r)
+                        {
+                            if(rowOuts[r] >= 0)
+                            {
+                                int k = rowOuts[r];
+                                std::memcpy(&outBuffers[k][outBufferRows[k]*numCols], &inBlock[r*numCols], numCols*sizeof(double));
+                                ++outBufferRows[k];
+                                if(outBufferRows[k] == this->blockRows)
+                                {
+                                    writers[k].addDataRows(outBuffers[k].data(), outBufferRows[k], H5::PredType::NATIVE_DOUBLE);
+                                    outBufferRows[k] = 0;
+                                }
+                            }
+                        }
+                    }
+                    numRowsDone += nBlockRows;
+                    pbar.progress(numRowsDone, numRows);
+                }
+                readHDFCol.close();
+            }
+            pbar.finish();
+
+            for(size_t k = 0; k < numOuts; ++k)
+            {
+                writers[k].addDataRows(outBuffers[k].data(), outBufferRows[k], H5::PredType::NATIVE_DOUBLE);
+                writers[k].close();
+            }
+            outBuffers.clear();
+
+            if(shuffle)
+            {
+                for(size_t k = 0; k < numOuts; ++k)
+                {
+                    this->shuffleFile(writeH5Files.at(k), outputH5Files.at(k), dataType, description, randomGen);
+                    std::remove(writeH5Files.at(k).c_str());
+                }
+            }
+        }
+        catch(...)
+        {
+            // Remove the temporary files (the writers have been closed by now) before passing the error on.
+            if(shuffle)
+            {
+                for(size_t k = 0; k < numOuts; ++k)
+                {
+                    std::remove(writeH5Files.at(k).c_str());
+                }
+            }
+            throw;
+        }
+    }
+
+    void RSGISHDFSampleManager::shuffleFile(std::string inputH5File, std::string outputH5File, H5::DataType dataType, std::string description, std::mt19937_64 &randomGen)
+    {
+        RSGISReadHDFColumnData readHDFCol;
+        readHDFCol.openFile(inputH5File);
+        size_t numRows = readHDFCol.getNumRows();
+        unsigned int numCols = readHDFCol.getNumCols();
+
+        RSGISExportColumnData2HDF exportCols2HDF;
+        exportCols2HDF.createFile(outputH5File, numCols, description, dataType);
+
+        size_t numBlocks = (numRows + this->blockRows - 1) / this->blockRows;
+        std::vector<size_t> blockOrder(numBlocks);
+        for(size_t i = 0; i < numBlocks; ++i)
+        {
+            blockOrder[i] = i;
+        }
+        std::shuffle(blockOrder.begin(), blockOrder.end(), randomGen);
+
+        size_t windowRows = this->shuffleWindowBlocks * this->blockRows;
+        std::vector<double> windowVals(windowRows * numCols);
+        std::vector<double> shuffledVals(windowRows * numCols);
+        std::vector<size_t> rowOrder;
+        rsgis::RSGISThreadPool threadPool(this->numThreads);
+
+        rsgis_tqdm pbar;
+        for(size_t w = 0; w < numBlocks; w += this->shuffleWindowBlocks)
+        {
+            size_t nWindowRows = 0;
+            for(size_t b = w; b < std::min(w + this->shuffleWindowBlocks, numBlocks); ++b)
+            {
+                size_t rowOff = blockOrder[b] * this->blockRows;
+                size_t nBlockRows = std::min(this->blockRows, numRows - rowOff);
+                readHDFCol.getDataRows(&windowVals[nWindowRows*numCols], numCols, nBlockRows, H5::PredType::NATIVE_DOUBLE, rowOff, nBlockRows);
+                nWindowRows += nBlockRows;
+            }
+
+            rowOrder.resize(nWindowRows);
+            for(size_t r = 0; r < nWindowRows; ++r)
+            {
+                rowOrder[r] = r;
+            }
+            std::shuffle(rowOrder.begin(), rowOrder.end(), randomGen);
+
+            threadPool.parallelFor(0, nWindowRows, [&](size_t start, size_t end){
+                for(size_t r = start; r < end; ++r)
+                {
+                    std::memcpy(&shuffledVals[r*numCols], &windowVals[rowOrder[r]*numCols], numCols*sizeof(double));
+                }
+            }, 1000);
+
+            exportCols2HDF.addDataRows(shuffledVals.data(), nWindowRows, H5::PredType::NATIVE_DOUBLE);
+            pbar.progress(std::min(w + this->shuffleWindowBlocks, numBlocks), numBlocks);
+        }
+        pbar.finish();
+        exportCols2HDF.close();
+        readHDFCol.close();
+    }
+
+    size_t RSGISHDFSampleManager::mergeFiles(std::vector<std::string> inputH5Files, std::string outputH5File, int seed, H5::DataType dataType, bool shuffle)
+    {
+        unsigned int numCols = 0;
+        size_t numRows = this->countRows(inputH5Files, &numCols);
+        std::vector<std::string> outputH5Files(1, outputH5File);
+        std::vector<size_t> outNumRows(1, numRows);
+        this->distributeRows(inputH5Files, outputH5Files, outNumRows, seed, dataType, shuffle, "Merged");
+        return numRows;
+    }
+
+    void RSGISHDFSampleManager::sampleFiles(std::vector<std::string> inputH5Files, std::string outputH5File, size_t nSamples, int seed, H5::DataType dataType, bool shuffle)
+    {
+        std::vector<std::string> outputH5Files(1, outputH5File);
+        std::vector<size_t> outNumRows(1, nSamples);
+        this->distributeRows(inputH5Files, outputH5Files, outNumRows, seed, dataType, shuffle, "Sampled Pixels Extracted");
+    }
+
+    std::vector<size_t> RSGISHDFSampleManager::splitFiles(std::vector<std::string> inputH5Files, std::vector<std::string> outputH5Files, std::vector<size_t> outNumRows, int remainOut, int seed, H5::DataType dataType, bool shuffle)
+    {
+        if(outputH5Files.size() != outNumRows.size())
+        {
+            throw RSGISFileException("The number of output files and the number of samples for each output are not the same.");
+        }
+        if(remainOut >= ((int)outNumRows.size()))
+        {
+            throw RSGISFileException("The index of the output for the remaining rows is not an output.");
+        }
+        if(remainOut >= 0)
+        {
+            unsigned int numCols = 0;
+            size_t numRows = this->countRows(inputH5Files, &numCols);
+            size_t numAssigned = 0;
+            for(size_t k = 0; k < outNumRows.size(); ++k)
+            {
+                if(((int)k) != remainOut)
+                {
+                    numAssigned += outNumRows.at(k);
+                }
+            }
+            if(numAssigned > numRows)
+            {
+                throw RSGISFileException("There are not enough rows within the input files for the samples requested.");
+            }
+            outNumRows.at(remainOut) = numRows - numAssigned;
+        }
+
+        this->distributeRows(inputH5Files, outputH5Files, outNumRows, seed, dataType, shuffle, "Split Pixels Extracted");
+        return outNumRows;
+    }
+
+    RSGISHDFSampleManager::~RSGISHDFSampleManager()
+    {
+
+    }
+
+}}
@@ -0,0 +1,106 @@
+/*
+ *  RSGISHDFSampleManager.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISHDFSampleManager_H
+#define RSGISHDFSampleManager_H
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdio>
+
+#include "common/RSGISCommons.h"
+#include "common/RSGISFileException.h"
+#include "common/RSGISThreadPool.h"
+#include "common/rsgis-tqdm.h"
+
+#include "utils/RSGISExportData2HDF.h"
+
+#include "H5Cpp.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_utils_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace utils{
+
+    /**
+     * Merges, samples, shuffles and splits the row samples within HDF5 files
+     * (/DATA/DATA of rows x variables, as written by RSGISExportColumnData2HDF)
+     * with memory bounded by the block size rather than the number of rows.
+     *
+     * The rows of the input files (treated as a single set of rows) are read a
+     * block at a time and each is assigned to one of the outputs (or none) by
+     * sequential selection sampling, so each output receives exactly the number
+     * of rows requested as a uniformly random sample without replacement.
+     * Blocks without any selected rows are not read.
+     *
+     * If shuffled, the rows are first written to a temporary file and then
+     * block shuffled: the blocks are read in a random order, a window of blocks
+     * at a time, and the rows within each window are shuffled (gathered in
+     * parallel) before being written.
+     */
+    class DllExport RSGISHDFSampleManager
+    {
+    public:
+        RSGISHDFSampleManager(unsigned int numThreads=1, size_t blockRows=1000, size_t shuffleWindowBlocks=64);
+        /** Returns the total number of rows within the files, which must have the same number of columns. */
+        size_t countRows(std::vector<std::string> inputH5Files, unsigned int *numCols);
+        /**
+         * Randomly distributes the rows of the input files to the outputs, with outNumRows
+         * rows in each output. Rows not assigned to an output are discarded.
+         */
+        void distributeRows(std::vector<std::string> inputH5Files, std::vector<std::string> outputH5Files, std::vector<size_t> outNumRows, int seed, H5::DataType dataType, bool shuffle, std::string description);
+        /** Merges all the rows of the input files, returning the number of rows. */
+        size_t mergeFiles(std::vector<std::string> inputH5Files, std::string outputH5File, int seed, H5::DataType dataType, bool shuffle);
+        /** Takes a random sample of nSamples rows from the input files. */
+        void sampleFiles(std::vector<std::string> inputH5Files, std::string outputH5File, size_t nSamples, int seed, H5::DataType dataType, bool shuffle);
+        /**
+         * Splits the rows of the input files into the outputs, with outNumRows rows in each.
+         * If remainOut is not negative the output with that index takes all the rows not
+         * within the other outputs (its outNumRows value is ignored); otherwise the rows
+         * not within an output are discarded. Returns the number of rows in each output.
+         */
+        std::vector<size_t> splitFiles(std::vector<std::string> inputH5Files, std::vector<std::string> outputH5Files, std::vector<size_t> outNumRows, int remainOut, int seed, H5::DataType dataType, bool shuffle);
+        ~RSGISHDFSampleManager();
+    protected:
+        /** Writes the rows of the input file to the output in a block shuffled order. */
+        void shuffleFile(std::string inputH5File, std::string outputH5File, H5::DataType dataType, std::string description, std::mt19937_64 &randomGen);
+        unsigned int numThreads;
+        size_t blockRows;
+        size_t shuffleWindowBlocks;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,428 @@
+/*
+ *  RSGISPointBandSampler.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISPointBandSampler.h"
+
+namespace rsgis{namespace vec{
+
+    RSGISPointBandSampler::RSGISPointBandSampler(unsigned int numThreads)
+    {
+        this->numThreads = numThreads;
+    }
+
+    void RSGISPointBandSampler::samplePoints(GDALDataset *image, std::vector<unsigned int> bands, const std::vector<double> &xCoords, const std::vector<double> &yCoords, RSGISPointSampleMethod method, unsigned int winSize, double minThres, double maxThres, double outNoDataVal, double *outVals)
+    {
+        if(xCoords.size() != yCoords.size())
+        {
+            throw RSGISVectorException("The number of x and y coordinates must be the same.");
+        }
+        if(bands.empty())
+        {
+            throw RSGISVectorException("At least one image band must be specified.");
+        }
+        if((method >= pointSampleWinMean) && ((winSize % 2) == 0))
+        {
+            throw RSGISVectorException("The window size must be an odd number.");
+        }
+
+        size_t numPts = xCoords.size();
+        size_t numBands = bands.size();
+        for(size_t i = 0; i < (numPts * numBands); ++i)
+        {
+            outVals[i] = outNoDataVal;
+        }
+        if(numPts == 0)
+        {
+            return;
+        }
+
+        int width = image->GetRasterXSize();
+        int height = image->GetRasterYSize();
+        std::vector<GDALRasterBand*> imgBands;
+        std::vector<double> noDataVals;
+        std::vector<bool> useNoDataVals;
+        for(auto iterBand = bands.begin(); iterBand != bands.end(); ++iterBand)
+        {
+            if(((*iterBand) == 0) || ((*iterBand) > (unsigned int)image->GetRasterCount()))
+            {
+                throw RSGISVectorException("An image band is not within the image (bands start at 1).");
+            }
+            GDALRasterBand *band = image->GetRasterBand(*iterBand);
+            int hasNoData = false;
+            double noDataVal = band->GetNoDataValue(&hasNoData);
+            imgBands.push_back(band);
+            noDataVals.push_back(noDataVal);
+            useNoDataVals.push_back(hasNoData != 0);
+        }
+
+        double geoTrans[6];
+        double invGeoTrans[6];
+        image->GetGeoTransform(geoTrans);
+        if(!GDALInvGeoTransform(geoTrans, invGeoTrans))
+        {
+            throw RSGISVectorException("The image geotransform could not be inverted.");
+        }
+
+        // The tiles are a whole number of blocks and at least 256 x 256 pixels.
+        int blockXSize = 0;
+        int blockYSize = 0;
+        imgBands.at(0)->GetBlockSize(&blockXSize, &blockYSize);
+        blockXSize = std::max(blockXSize, 1);
+        blockYSize = std::max(blockYSize, 1);
+        int tileXSize = std::min(blockXSize * ((255 + blockXSize) / blockXSize), width);
+        int tileYSize = std::min(blockYSize * ((255 + blockYSize) / blockYSize), height);
+        size_t numTilesX = (width + tileXSize - 1) / tileXSize;
+        size_t numTilesY = (height + tileYSize - 1) / tileYSize;
+        size_t numTiles = numTilesX * numTilesY;
+
+        // Bucket the points within the image by tile (counting sort).
+        std::vector<double> pxlX = std::vector<double>(numPts);
+        std::vector<double> pxlY = std::vector<double>(numPts);
+        std::vector<size_t> ptTile = std::vector<size_t>(numPts, numTiles);
+        std::vector<size_t> tileStarts = std::vector<size_t>(numTiles+1, 0);
+        for(size_t i = 0; i < numPts; ++i)
+        {
+            pxlX[i] = invGeoTrans[0] + (xCoords[i] * invGeoTrans[1]) + (yCoords[i] * invGeoTrans[2]);
+            pxlY[i] = invGeoTrans[3] + (xCoords[i] * invGeoTrans[4]) + (yCoords[i] * invGeoTrans[5]);
+            double col = std::floor(pxlX[i]);
+            double row = std::floor(pxlY[i]);
+            if((col >= 0) && (col < width) && (row >= 0) && (row < height))
+            {
+                ptTile[i] = (((size_t)row / tileYSize) * numTilesX) + ((size_t)col / tileXSize);
+                ++tileStarts[ptTile[i]+1];
+            }
+        }
+        for(size_t i = 0; i < numTiles; ++i)
+        {
+            tileStarts[i+1] += tileStarts[i];
+        }
+        std::vector<size_t> tilePts = std::vector<size_t>(tileStarts[numTiles]);
+        std::vector<size_t> tileFill = std::vector<size_t>(tileStarts.begin(), tileStarts.end()-1);
+        for(size_t i = 0; i < numPts; ++i)
+        {
+            if(ptTile[i] < numTiles)
+            {
+                tilePts[tileFill[ptTile[i]]++] = i;
+            }
+        }
+
+        int halo = this->findHalo(method, winSize);
+        int winHalo = (method >= pointSampleWinMean)?((int)winSize / 2):0;
+        rsgis::RSGISThreadPool threadPool(this->numThreads);
+        std::vector<double> tileVals;
+
+        rsgis_tqdm pbar;
+        for(size_t tile = 0; tile < numTiles; ++tile)
+        {
+            pbar.progress(tile, numTiles);
+            size_t tileStart = tileStarts[tile];
+            size_t tileEnd = tileStarts[tile+1];
+            if(tileStart == tileEnd)
+            {
+                continue;
+            }
+
+            int tileX = (int)(tile % numTilesX) * tileXSize;
+            int tileY = (int)(tile / numTilesX) * tileYSize;
+            int readX = std::max(tileX - halo, 0);
+            int readY = std::max(tileY - halo, 0);
+            int readXEnd = std::min(tileX + tileXSize + halo, width);
+            int readYEnd = std::min(tileY + tileYSize + halo, height);
+            int readWidth = readXEnd - readX;
+            int readHeight = readYEnd - readY;
+            tileVals.resize((size_t)readWidth * readHeight);
+
+            for(size_t b = 0; b < numBands; ++b)
+            {
+                if(imgBands[b]->RasterIO(GF_Read, readX, readY, readWidth, readHeight, tileVals.data(), readWidth, readHeight, GDT_Float64, 0, 0) != CE_None)
+                {
+                    throw RSGISVectorException("Could not read the image band.");
+                }
+
+                const double *vals = tileVals.data();
+                double noDataVal = noDataVals[b];
+                bool useNoData = useNoDataVals[b];
+                threadPool.parallelFor(tileStart, tileEnd, [&](size_t start, size_t end)
+                {
+                    for(size_t i = start; i < end; ++i)
+                    {
+                        size_t pt = tilePts[i];
+                        outVals[(pt * numBands) + b] = RSGISPointBandSampler::samplePointValue(vals, readWidth, readHeight, pxlX[pt] - readX, pxlY[pt] - readY, method, winHalo, noDataVal, useNoData, minThres, maxThres, outNoDataVal);
+                    }
+                }, 256);
+            }
+        }
+        pbar.finish();
+    }
+
+    unsigned long RSGISPointBandSampler::samplePointsToLayer(OGRLayer *layer, GDALDataset *image, std::vector<unsigned int> bands, std::vector<std::string> fields, RSGISPointSampleMethod method, unsigned int winSize, double minThres, double maxThres, double outNoDataVal, OGRCoordinateTransformation *transform)
+    {
+        if(fields.size() != bands.size())
+        {
+            throw RSGISVectorException("There must be an output field for each image band.");
+        }
+
+        std::vector<int> fieldIdxs;
+        for(auto iterField = fields.begin(); iterField != fields.end(); ++iterField)
+        {
+            int fieldIdx = layer->GetLayerDefn()->GetFieldIndex((*iterField).c_str());
+            if(fieldIdx < 0)
+            {
+                OGRFieldDefn fieldDefn((*iterField).c_str(), OFTReal);
+                if(layer->CreateField(&fieldDefn) != OGRERR_NONE)
+                {
+                    std::string message = std::string("Creating field ") + (*iterField) + std::string(" has failed");
+                    throw RSGISVectorException(message);
+                }
+                fieldIdx = layer->GetLayerDefn()->GetFieldIndex((*iterField).c_str());
+            }
+            fieldIdxs.push_back(fieldIdx);
+        }
+
+        // Read all the points (or centroids) so the image can be read in tile order.
+        std::vector<double> xCoords;
+        std::vector<double> yCoords;
+        std::vector<bool> hasPt;
+        OGRPoint centroid;
+        layer->ResetReading();
+        OGRFeature *feat = NULL;
+        while((feat = layer->GetNextFeature()) != NULL)
+        {
+            OGRGeometry *geom = feat->GetGeometryRef();
+            double x = 0.0;
+            double y = 0.0;
+            bool validPt = false;
+            if((geom != NULL) && (!geom->IsEmpty()))
+            {
+                if(wkbFlatten(geom->getGeometryType()) == wkbPoint)
+                {
+                    x = ((OGRPoint*)geom)->getX();
+                    y = ((OGRPoint*)geom)->getY();
+                    validPt = true;
+                }
+                else if(geom->Centroid(&centroid) == OGRERR_NONE)
+                {
+                    x = centroid.getX();
+                    y = centroid.getY();
+                    validPt = true;
+                }
+                if(validPt && (transform != NULL))
+                {
+                    validPt = transform->Transform(1, &x, &y);
+                }
+            }
+            xCoords.push_back(validPt?x:std::numeric_limits<double>::quiet_NaN());
+            yCoords.push_back(validPt?y:std::numeric_limits<double>::quiet_NaN());
+            hasPt.push_back(validPt);
+            OGRFeature::DestroyFeature(feat);
+        }
+
+        size_t numFeats = xCoords.size();
+        size_t numBands = bands.size();
+        std::vector<double> ptVals = std::vector<double>(numFeats * numBands);
+        this->samplePoints(image, bands, xCoords, yCoords, method, winSize, minThres, maxThres, outNoDataVal, ptVals.data());
+
+        // Write the values in batched transactions.
+        const size_t transactionStep = 20000;
+        bool useTransactions = (layer->TestCapability(OLCTransactions) != 0);
+        bool openTransaction = false;
+        size_t featIdx = 0;
+        layer->ResetReading();
+        while((featIdx < numFeats) && ((feat = layer->GetNextFeature()) != NULL))
+        {
+            if(hasPt[featIdx])
+            {
+                if(useTransactions && !openTransaction)
+                {
+                    openTransaction = (layer->StartTransaction() == OGRERR_NONE);
+                }
+                for(size_t b = 0; b < numBands; ++b)
+                {
+                    feat->SetField(fieldIdxs[b], ptVals[(featIdx * numBands) + b]);
+                }
+                if(layer->SetFeature(feat) != OGRERR_NONE)
+                {
+                    OGRFeature::DestroyFeature(feat);
+                    throw RSGISVectorException("Failed to write the values to the feature.");
+                }
+            }
+            OGRFeature::DestroyFeature(feat);
+            ++featIdx;
+
+            if(openTransaction && ((featIdx % transactionStep) == 0))
+            {
+                if(layer->CommitTransaction() != OGRERR_NONE)
+                {
+                    throw RSGISVectorException("Could not commit the values to the layer.");
+                }
+                openTransaction = false;
+            }
+        }
+        if(openTransaction && (layer->CommitTransaction() != OGRERR_NONE))
+        {
+            throw RSGISVectorException("Could not commit the values to the layer.");
+        }
+
+        return numFeats;
+    }
+
+    double RSGISPointBandSampler::samplePointValue(const double *vals, int width, int height, double px, double py, RSGISPointSampleMethod method, int winHalo, double noDataVal, bool useNoData, double minThres, double maxThres, double outNoDataVal)
+    {
+        auto validVal = [&](double val)
+        {
+            return !(std::isnan(val) || (useNoData && (val == noDataVal)) || (val < minThres) || (val > maxThres));
+        };
+
+        int col = (int)std::floor(px);
+        int row = (int)std::floor(py);
+        if((col < 0) || (col >= width) || (row < 0) || (row >= height))
+        {
+            return outNoDataVal;
+        }
+
+        if(method == pointSampleNearest)
+        {
+            double val = vals[((size_t)row * width) + col];
+            return validVal(val)?val:outNoDataVal;
+        }
+        else if(method == pointSampleBilinear)
+        {
+            // Interpolate between the centres of the four nearest pixels, ignoring
+            // those outside the block or not valid.
+            double cx = px - 0.5;
+            double cy = py - 0.5;
+            int x0 = (int)std::floor(cx);
+            int y0 = (int)std::floor(cy);
+            double fx = cx - x0;
+            double fy = cy - y0;
+            double sumVals = 0.0;
+            double sumWeights = 0.0;
+            for(int j = 0; j < 2; ++j)
+            {
+                int y = y0 + j;
+                double wy = (j == 0)?(1.0 - fy):fy;
+                for(int i = 0; i < 2; ++i)
+                {
+                    int x = x0 + i;
+                    double w = wy * ((i == 0)?(1.0 - fx):fx);
+                    if((x < 0) || (x >= width) || (y < 0) || (y >= height) || (w <= 0.0))
+                    {
+                        continue;
+                    }
+                    double val = vals[((size_t)y * width) + x];
+                    if(validVal(val))
+                    {
+                        sumVals += w * val;
+                        sumWeights += w;
+                    }
+                }
+            }
+            if(sumWeights > 0.0)
+            {
+                return sumVals / sumWeights;
+            }
+            double val = vals[((size_t)row * width) + col];
+            return validVal(val)?val:outNoDataVal;
+        }
+
+        static thread_local std::vector<double> winVals;
+        winVals.clear();
+        int xStart = std::max(col - winHalo, 0);
+        int xEnd = std::min(col + winHalo + 1, width);
+        int yStart = std::max(row - winHalo, 0);
+        int yEnd = std::min(row + winHalo + 1, height);
+        for(int y = yStart; y < yEnd; ++y)
+        {
+            for(int x = xStart; x < xEnd; ++x)
+            {
+                double val = vals[((size_t)y * width) + x];
+                if(validVal(val))
+                {
+                    winVals.push_back(val);
+                }
+            }
+        }
+        if(winVals.empty())
+        {
+            return outNoDataVal;
+        }
+
+        double outVal = outNoDataVal;
+        if(method == pointSampleWinMin)
+        {
+            outVal = *std::min_element(winVals.begin(), winVals.end());
+        }
+        else if(method == pointSampleWinMax)
+        {
+            outVal = *std::max_element(winVals.begin(), winVals.end());
+        }
+        else if(method == pointSampleWinMedian)
+        {
+            size_t mid = winVals.size() / 2;
+            std::nth_element(winVals.begin(), winVals.begin() + mid, winVals.end());
+            outVal = winVals[mid];
+            if((winVals.size() % 2) == 0)
+            {
+                outVal = (outVal + *std::max_element(winVals.begin(), winVals.begin() + mid)) / 2.0;
+            }
+        }
+        else
+        {
+            double sum = 0.0;
+            for(auto iterVal = winVals.begin(); iterVal != winVals.end(); ++iterVal)
+            {
+                sum += *iterVal;
+            }
+            double mean = sum / winVals.size();
+            outVal = mean;
+            if(method == pointSampleWinStdDev)
+            {
+                double sumSq = 0.0;
+                for(auto iterVal = winVals.begin(); iterVal != winVals.end(); ++iterVal)
+                {
+                    sumSq += ((*iterVal) - mean) * ((*iterVal) - mean);
+                }
+                outVal = std::sqrt(sumSq / winVals.size());
+            }
+        }
+        return outVal;
+    }
+
+    int RSGISPointBandSampler::findHalo(RSGISPointSampleMethod method, unsigned int winSize)
+    {
+        if(method == pointSampleNearest)
+        {
+            return 0;
+        }
+        else if(method == pointSampleBilinear)
+        {
+            return 1;
+        }
+        return (int)winSize / 2;
+    }
+
+    RSGISPointBandSampler::~RSGISPointBandSampler()
+    {
+
+    }
+
+}}
@@ -0,0 +1,111 @@
+/*
+ *  RSGISPointBandSampler.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISPointBandSampler_H
+#define RSGISPointBandSampler_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gdal_priv.h"
+#include "ogrsf_frmts.h"
+#include "ogr_spatialref.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISVectorException.h"
+#include "common/RSGISThreadPool.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_vec_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace vec{
+
+    enum RSGISPointSampleMethod
+    {
+        pointSampleNearest = 0,
+        pointSampleBilinear = 1,
+        pointSampleWinMean = 2,
+        pointSampleWinMin = 3,
+        pointSampleWinMax = 4,
+        pointSampleWinMedian = 5,
+        pointSampleWinStdDev = 6
+    };
+
+    /**
+     * Samples the bands of an image at a set of points. Rather than reading the
+     * image for each point, the points are converted to pixel coordinates and
+     * bucketed by the image tile (a whole number of GDAL blocks) they fall
+     * within. Each tile with points is then read once for each band (with a halo
+     * for the bilinear and window methods) and the points within it are sampled
+     * in parallel.
+     *
+     * The nearest method takes the pixel containing the point; bilinear
+     * interpolates between the four nearest pixel centres (re-weighting if some
+     * are not valid) and the window methods calculate a statistic for the
+     * winSize x winSize pixels centred on the pixel containing the point. Values
+     * which are the band no data value, NaN or outside [minThres, maxThres] are
+     * not valid; points outside the image or without any valid values are given
+     * outNoDataVal.
+     */
+    class DllExport RSGISPointBandSampler
+    {
+    public:
+        RSGISPointBandSampler(unsigned int numThreads=1);
+        /** Samples the bands (starting at 1) at the points (in image coordinates) into outVals (nPts x nBands). */
+        void samplePoints(GDALDataset *image, std::vector<unsigned int> bands, const std::vector<double> &xCoords, const std::vector<double> &yCoords, RSGISPointSampleMethod method, unsigned int winSize, double minThres, double maxThres, double outNoDataVal, double *outVals);
+        /**
+         * Samples the bands at the features of the layer (points or, for other geometries,
+         * the centroid), writing the values to the fields (one for each band, created if
+         * not present) in batched transactions. If transform is not NULL the points are
+         * transformed to the image projection. Returns the number of features.
+         */
+        unsigned long samplePointsToLayer(OGRLayer *layer, GDALDataset *image, std::vector<unsigned int> bands, std::vector<std::string> fields, RSGISPointSampleMethod method, unsigned int winSize, double minThres, double maxThres, double outNoDataVal, OGRCoordinateTransformation *transform);
+        /**
+         * Calculates the value for a point from a block of pixels (row-major, width x height) with the
+         * point position within it (pixel coordinates from the top-left of the block). The window
+         * methods use the pixels within winHalo of the pixel containing the point (clipped to the block).
+         */
+        static double samplePointValue(const double *vals, int width, int height, double px, double py, RSGISPointSampleMethod method, int winHalo, double noDataVal, bool useNoData, double minThres, double maxThres, double outNoDataVal);
+        ~RSGISPointBandSampler();
+    protected:
+        /** The pixels either side of the pixel containing a point which are needed by the method. */
+        int findHalo(RSGISPointSampleMethod method, unsigned int winSize);
+        unsigned int numThreads;
+    };
+
+}}
+
+#endif
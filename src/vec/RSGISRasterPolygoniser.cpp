@@ -0,0 +1,692 @@
+/*
+ *  RSGISRasterPolygoniser.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISRasterPolygoniser.h"
+
+namespace rsgis{namespace vec{
+
+    RSGISRasterPolygoniser::RSGISRasterPolygoniser(bool use8Conn, unsigned int featBatchSize)
+    {
+        this->use8Conn = use8Conn;
+        this->featBatchSize = (featBatchSize > 0)?featBatchSize:1;
+        this->layer = NULL;
+        this->valFieldIdx = -1;
+        this->valFieldIsReal = false;
+        this->useTransactions = false;
+        this->numFeats = 0;
+        this->numFeatsInBatch = 0;
+    }
+
+    unsigned long RSGISRasterPolygoniser::polygonise(GDALRasterBand *band, GDALRasterBand *maskBand, OGRLayer *layer, int valFieldIdx)
+    {
+        const size_t noRegion = std::numeric_limits<size_t>::max();
+        unsigned int width = band->GetXSize();
+        unsigned int height = band->GetYSize();
+        if((maskBand != NULL) && ((maskBand->GetXSize() != (int)width) || (maskBand->GetYSize() != (int)height)))
+        {
+            throw RSGISVectorException("The mask band must be the same size as the image band.");
+        }
+
+        this->layer = layer;
+        this->valFieldIdx = valFieldIdx;
+        this->valFieldIsReal = false;
+        if(valFieldIdx >= 0)
+        {
+            this->valFieldIsReal = (layer->GetLayerDefn()->GetFieldDefn(valFieldIdx)->GetType() == OFTReal);
+        }
+        this->numFeats = 0;
+        this->numFeatsInBatch = 0;
+        this->regions.clear();
+        this->freeRegionIDs.clear();
+
+        this->geoTrans[0] = 0.0;
+        this->geoTrans[1] = 1.0;
+        this->geoTrans[2] = 0.0;
+        this->geoTrans[3] = 0.0;
+        this->geoTrans[4] = 0.0;
+        this->geoTrans[5] = 1.0;
+        GDALDataset *dataset = band->GetDataset();
+        if(dataset != NULL)
+        {
+            if(dataset->GetGeoTransform(this->geoTrans) != CE_None)
+            {
+                this->geoTrans[0] = 0.0;
+                this->geoTrans[1] = 1.0;
+                this->geoTrans[2] = 0.0;
+                this->geoTrans[3] = 0.0;
+                this->geoTrans[4] = 0.0;
+                this->geoTrans[5] = 1.0;
+            }
+        }
+
+        int hasNoData = false;
+        double noDataVal = band->GetNoDataValue(&hasNoData);
+
+        int xBlockSize = 0;
+        int yBlockSize = 0;
+        band->GetBlockSize(&xBlockSize, &yBlockSize);
+        if(yBlockSize < 1)
+        {
+            yBlockSize = 1;
+        }
+        unsigned int nRowsPerRead = yBlockSize;
+        while(nRowsPerRead < 256)
+        {
+            nRowsPerRead += yBlockSize;
+        }
+        if(nRowsPerRead > height)
+        {
+            nRowsPerRead = height;
+        }
+
+        std::vector<double> vals(((size_t)width) * nRowsPerRead);
+        std::vector<unsigned char> mask;
+        if(maskBand != NULL)
+        {
+            mask.resize(((size_t)width) * nRowsPerRead);
+        }
+
+        this->useTransactions = (layer->TestCapability(OLCTransactions) != 0);
+        if(this->useTransactions && (layer->StartTransaction() != OGRERR_NONE))
+        {
+            this->useTransactions = false;
+        }
+
+        unsigned int conn = this->use8Conn?1:0;
+        std::vector<RSGISRowRun> prevRuns;
+        std::vector<RSGISRowRun> curRuns;
+        std::vector<size_t> mergedIDs;
+        rsgis_tqdm pbar;
+        for(unsigned int yStart = 0; yStart < height; yStart += nRowsPerRead)
+        {
+            pbar.progress(yStart, height);
+            unsigned int nRows = std::min(nRowsPerRead, height - yStart);
+            if(band->RasterIO(GF_Read, 0, yStart, width, nRows, vals.data(), width, nRows, GDT_Float64, 0, 0) != CE_None)
+            {
+                throw RSGISVectorException("Could not read image data.");
+            }
+            if(maskBand != NULL)
+            {
+                if(maskBand->RasterIO(GF_Read, 0, yStart, width, nRows, mask.data(), width, nRows, GDT_Byte, 0, 0) != CE_None)
+                {
+                    throw RSGISVectorException("Could not read mask data.");
+                }
+            }
+
+            for(unsigned int r = 0; r < nRows; ++r)
+            {
+                unsigned int y = yStart + r;
+                size_t rowOff = ((size_t)r) * width;
+
+                // Split the row into runs of equal value.
+                curRuns.clear();
+                unsigned int x = 0;
+                while(x < width)
+                {
+                    double val = vals[rowOff+x];
+                    bool valid = !std::isnan(val) && !(hasNoData && (val == noDataVal)) && ((maskBand == NULL) || (mask[rowOff+x] != 0));
+                    if(!valid)
+                    {
+                        ++x;
+                        continue;
+                    }
+                    unsigned int xEnd = x + 1;
+                    while((xEnd < width) && (vals[rowOff+xEnd] == val) && ((maskBand == NULL) || (mask[rowOff+xEnd] != 0)))
+                    {
+                        ++xEnd;
+                    }
+                    RSGISRowRun run;
+                    run.x0 = x;
+                    run.x1 = xEnd;
+                    run.val = val;
+                    run.regionID = noRegion;
+                    curRuns.push_back(run);
+                    x = xEnd;
+                }
+
+                // Link the runs to the touching runs of the same value on the previous row.
+                mergedIDs.clear();
+                size_t j = 0;
+                for(std::vector<RSGISRowRun>::iterator iterRun = curRuns.begin(); iterRun != curRuns.end(); ++iterRun)
+                {
+                    while((j < prevRuns.size()) && ((prevRuns[j].x1 + conn) <= iterRun->x0))
+                    {
+                        ++j;
+                    }
+                    for(size_t k = j; (k < prevRuns.size()) && (prevRuns[k].x0 < (iterRun->x1 + conn)); ++k)
+                    {
+                        if(prevRuns[k].val != iterRun->val)
+                        {
+                            continue;
+                        }
+                        size_t prevRegion = this->findRegion(prevRuns[k].regionID);
+                        if(iterRun->regionID == noRegion)
+                        {
+                            iterRun->regionID = prevRegion;
+                        }
+                        else
+                        {
+                            size_t curRegion = this->findRegion(iterRun->regionID);
+                            if(curRegion != prevRegion)
+                            {
+                                iterRun->regionID = this->mergeRegions(curRegion, prevRegion);
+                                mergedIDs.push_back((iterRun->regionID == curRegion)?prevRegion:curRegion);
+                            }
+                        }
+                    }
+                    if(iterRun->regionID == noRegion)
+                    {
+                        iterRun->regionID = this->createRegion(iterRun->val);
+                    }
+                    RSGISPxlRun pxlRun;
+                    pxlRun.x0 = iterRun->x0;
+                    pxlRun.x1 = iterRun->x1;
+                    pxlRun.y = y;
+                    this->regions[this->findRegion(iterRun->regionID)].runs.push_back(pxlRun);
+                }
+                for(std::vector<RSGISRowRun>::iterator iterRun = curRuns.begin(); iterRun != curRuns.end(); ++iterRun)
+                {
+                    iterRun->regionID = this->findRegion(iterRun->regionID);
+                    this->regions[iterRun->regionID].lastRow = y;
+                }
+
+                // Regions without a run on this row are closed.
+                for(std::vector<RSGISRowRun>::iterator iterRun = prevRuns.begin(); iterRun != prevRuns.end(); ++iterRun)
+                {
+                    size_t regionID = this->findRegion(iterRun->regionID);
+                    if(this->regions[regionID].inUse && (this->regions[regionID].lastRow != y))
+                    {
+                        this->writeRegion(regionID);
+                        this->freeRegion(regionID);
+                    }
+                }
+                for(std::vector<size_t>::iterator iterID = mergedIDs.begin(); iterID != mergedIDs.end(); ++iterID)
+                {
+                    this->freeRegion(*iterID);
+                }
+                prevRuns.swap(curRuns);
+            }
+        }
+        for(std::vector<RSGISRowRun>::iterator iterRun = prevRuns.begin(); iterRun != prevRuns.end(); ++iterRun)
+        {
+            size_t regionID = this->findRegion(iterRun->regionID);
+            if(this->regions[regionID].inUse)
+            {
+                this->writeRegion(regionID);
+                this->freeRegion(regionID);
+            }
+        }
+        pbar.finish();
+
+        if(this->useTransactions && (layer->CommitTransaction() != OGRERR_NONE))
+        {
+            throw RSGISVectorException("Could not commit the features to the output layer.");
+        }
+        this->regions.clear();
+        this->freeRegionIDs.clear();
+        return this->numFeats;
+    }
+
+    void RSGISRasterPolygoniser::traceRings(std::vector<RSGISPxlRun> &runs, std::vector<RSGISPxlRing> *rings)
+    {
+        // Directions: 0 = +x, 1 = +y, 2 = -x, 3 = -y (y is down). The edges are directed with the region on the right.
+        const long dirX[4] = {1, 0, -1, 0};
+        const long dirY[4] = {0, 1, 0, -1};
+        struct PxlEdge
+        {
+            long x;
+            long y;
+            int dir;
+            long len;
+            bool used;
+        };
+        struct VertexEdges
+        {
+            size_t edges[2];
+            int n;
+        };
+
+        std::sort(runs.begin(), runs.end(), [](const RSGISPxlRun &a, const RSGISPxlRun &b){return (a.y < b.y) || ((a.y == b.y) && (a.x0 < b.x0));});
+
+        // The start and end of the runs for each row.
+        std::vector<std::pair<size_t, size_t> > rows;
+        size_t rowStart = 0;
+        for(size_t i = 1; i <= runs.size(); ++i)
+        {
+            if((i == runs.size()) || (runs[i].y != runs[rowStart].y))
+            {
+                rows.push_back(std::pair<size_t, size_t>(rowStart, i));
+                rowStart = i;
+            }
+        }
+
+        std::vector<PxlEdge> edges;
+        // Adds the segments of [x0, x1) not covered by the runs [cStart, cEnd) as edges along row y.
+        auto addUncovered = [&edges, &runs](unsigned int x0, unsigned int x1, size_t cStart, size_t cEnd, long y, bool top)
+        {
+            unsigned int x = x0;
+            for(size_t c = cStart; (c < cEnd) && (x < x1); ++c)
+            {
+                if(runs[c].x1 <= x)
+                {
+                    continue;
+                }
+                if(runs[c].x0 >= x1)
+                {
+                    break;
+                }
+                if(runs[c].x0 > x)
+                {
+                    PxlEdge edge;
+                    edge.x = top?x:runs[c].x0;
+                    edge.y = y;
+                    edge.dir = top?0:2;
+                    edge.len = runs[c].x0 - x;
+                    edge.used = false;
+                    edges.push_back(edge);
+                }
+                x = runs[c].x1;
+            }
+            if(x < x1)
+            {
+                PxlEdge edge;
+                edge.x = top?x:x1;
+                edge.y = y;
+                edge.dir = top?0:2;
+                edge.len = x1 - x;
+                edge.used = false;
+                edges.push_back(edge);
+            }
+        };
+
+        for(size_t r = 0; r < rows.size(); ++r)
+        {
+            unsigned int y = runs[rows[r].first].y;
+            bool hasAbove = (r > 0) && (runs[rows[r-1].first].y == (y-1));
+            bool hasBelow = ((r+1) < rows.size()) && (runs[rows[r+1].first].y == (y+1));
+            for(size_t i = rows[r].first; i < rows[r].second; ++i)
+            {
+                if(hasAbove)
+                {
+                    addUncovered(runs[i].x0, runs[i].x1, rows[r-1].first, rows[r-1].second, y, true);
+                }
+                else
+                {
+                    addUncovered(runs[i].x0, runs[i].x1, 0, 0, y, true);
+                }
+                if(hasBelow)
+                {
+                    addUncovered(runs[i].x0, runs[i].x1, rows[r+1].first, rows[r+1].second, y+1, false);
+                }
+                else
+                {
+                    addUncovered(runs[i].x0, runs[i].x1, 0, 0, y+1, false);
+                }
+                PxlEdge rightEdge;
+                rightEdge.x = runs[i].x1;
+                rightEdge.y = y;
+                rightEdge.dir = 1;
+                rightEdge.len = 1;
+                rightEdge.used = false;
+                edges.push_back(rightEdge);
+                PxlEdge leftEdge;
+                leftEdge.x = runs[i].x0;
+                leftEdge.y = y+1;
+                leftEdge.dir = 3;
+                leftEdge.len = 1;
+                leftEdge.used = false;
+                edges.push_back(leftEdge);
+            }
+        }
+
+        // Index the edges by their start vertex; a vertex has two edges where regions touch diagonally.
+        std::unordered_map<uint64_t, VertexEdges> vertexEdges;
+        vertexEdges.reserve(edges.size());
+        for(size_t i = 0; i < edges.size(); ++i)
+        {
+            uint64_t key = (((uint64_t)edges[i].x) << 32) | ((uint64_t)edges[i].y);
+            VertexEdges &vEdges = vertexEdges[key];
+            if(vEdges.n == 0)
+            {
+                vEdges.edges[0] = i;
+                vEdges.n = 1;
+            }
+            else
+            {
+                vEdges.edges[1] = i;
+                vEdges.n = 2;
+            }
+        }
+
+        std::vector<size_t> ringEdges;
+        RSGISPxlRing ring;
+        RSGISPxlRing splitRing;
+        std::unordered_map<uint64_t, size_t> ringVtxPos;
+        for(size_t i = 0; i < edges.size(); ++i)
+        {
+            if(edges[i].used)
+            {
+                continue;
+            }
+            ringEdges.clear();
+            size_t cEdge = i;
+            while(true)
+            {
+                edges[cEdge].used = true;
+                ringEdges.push_back(cEdge);
+                long endX = edges[cEdge].x + (dirX[edges[cEdge].dir] * edges[cEdge].len);
+                long endY = edges[cEdge].y + (dirY[edges[cEdge].dir] * edges[cEdge].len);
+                uint64_t key = (((uint64_t)endX) << 32) | ((uint64_t)endY);
+                std::unordered_map<uint64_t, VertexEdges>::iterator iterVertex = vertexEdges.find(key);
+                if(iterVertex == vertexEdges.end())
+                {
+                    throw RSGISVectorException("The boundary of a region could not be traced.");
+                }
+                VertexEdges &vEdges = iterVertex->second;
+                size_t nextEdge = edges.size();
+                for(int n = 0; n < vEdges.n; ++n)
+                {
+                    if(!edges[vEdges.edges[n]].used)
+                    {
+                        // Where there is a choice turn right, so rings are split where regions touch diagonally.
+                        if((nextEdge == edges.size()) || (edges[vEdges.edges[n]].dir == ((edges[cEdge].dir + 1) % 4)))
+                        {
+                            nextEdge = vEdges.edges[n];
+                        }
+                    }
+                }
+                if(nextEdge == edges.size())
+                {
+                    break;
+                }
+                cEdge = nextEdge;
+            }
+
+            // Only keep the vertices where the direction changes.
+            ring.clear();
+            for(size_t n = 0; n < ringEdges.size(); ++n)
+            {
+                size_t prevEdge = ringEdges[(n == 0)?(ringEdges.size()-1):(n-1)];
+                if(edges[ringEdges[n]].dir != edges[prevEdge].dir)
+                {
+                    ring.push_back(std::pair<long, long>(edges[ringEdges[n]].x, edges[ringEdges[n]].y));
+                }
+            }
+
+            // A ring which passes through a vertex twice (where pixels touch diagonally) is not
+            // a valid ring, so it is split at the vertex. The direction always changes at such a
+            // vertex so it is within the ring and remains a corner of both parts.
+            splitRing.clear();
+            ringVtxPos.clear();
+            for(size_t n = 0; n < ring.size(); ++n)
+            {
+                uint64_t key = (((uint64_t)ring[n].first) << 32) | ((uint64_t)ring[n].second);
+                std::unordered_map<uint64_t, size_t>::iterator iterPos = ringVtxPos.find(key);
+                if(iterPos == ringVtxPos.end())
+                {
+                    ringVtxPos[key] = splitRing.size();
+                    splitRing.push_back(ring[n]);
+                }
+                else
+                {
+                    // The vertices since the previous visit form a closed ring.
+                    size_t pos = iterPos->second;
+                    RSGISPxlRing subRing(splitRing.begin() + pos, splitRing.end());
+                    for(size_t k = pos + 1; k < splitRing.size(); ++k)
+                    {
+                        ringVtxPos.erase((((uint64_t)splitRing[k].first) << 32) | ((uint64_t)splitRing[k].second));
+                    }
+                    splitRing.resize(pos + 1);
+                    rings->push_back(subRing);
+                }
+            }
+            rings->push_back(splitRing);
+        }
+    }
+
+    double RSGISRasterPolygoniser::ringArea(const RSGISPxlRing &ring)
+    {
+        double area = 0.0;
+        for(size_t i = 0; i < ring.size(); ++i)
+        {
+            const std::pair<long, long> &p1 = ring[i];
+            const std::pair<long, long> &p2 = ring[(i+1) % ring.size()];
+            area += (((double)p1.first) * ((double)p2.second)) - (((double)p2.first) * ((double)p1.second));
+        }
+        return area / 2.0;
+    }
+
+    bool RSGISRasterPolygoniser::pointInRing(double x, double y, const RSGISPxlRing &ring)
+    {
+        bool inside = false;
+        for(size_t i = 0, j = ring.size()-1; i < ring.size(); j = i++)
+        {
+            double xi = ring[i].first;
+            double yi = ring[i].second;
+            double xj = ring[j].first;
+            double yj = ring[j].second;
+            if(((yi > y) != (yj > y)) && (x < (((xj - xi) * (y - yi)) / (yj - yi)) + xi))
+            {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+
+    size_t RSGISRasterPolygoniser::createRegion(double val)
+    {
+        size_t regionID = 0;
+        if(this->freeRegionIDs.empty())
+        {
+            regionID = this->regions.size();
+            this->regions.push_back(RSGISPolyRegion());
+        }
+        else
+        {
+            regionID = this->freeRegionIDs.back();
+            this->freeRegionIDs.pop_back();
+        }
+        RSGISPolyRegion &region = this->regions[regionID];
+        region.parent = regionID;
+        region.val = val;
+        region.lastRow = 0;
+        region.inUse = true;
+        region.runs.clear();
+        return regionID;
+    }
+
+    size_t RSGISRasterPolygoniser::findRegion(size_t regionID)
+    {
+        size_t root = regionID;
+        while(this->regions[root].parent != root)
+        {
+            root = this->regions[root].parent;
+        }
+        while(this->regions[regionID].parent != root)
+        {
+            size_t next = this->regions[regionID].parent;
+            this->regions[regionID].parent = root;
+            regionID = next;
+        }
+        return root;
+    }
+
+    size_t RSGISRasterPolygoniser::mergeRegions(size_t regionA, size_t regionB)
+    {
+        // Move the smaller list of runs.
+        if(this->regions[regionA].runs.size() < this->regions[regionB].runs.size())
+        {
+            std::swap(regionA, regionB);
+        }
+        std::vector<RSGISPxlRun> &runsA = this->regions[regionA].runs;
+        std::vector<RSGISPxlRun> &runsB = this->regions[regionB].runs;
+        runsA.insert(runsA.end(), runsB.begin(), runsB.end());
+        std::vector<RSGISPxlRun>().swap(runsB);
+        this->regions[regionB].parent = regionA;
+        this->regions[regionA].lastRow = std::max(this->regions[regionA].lastRow, this->regions[regionB].lastRow);
+        return regionA;
+    }
+
+    void RSGISRasterPolygoniser::freeRegion(size_t regionID)
+    {
+        RSGISPolyRegion &region = this->regions[regionID];
+        region.inUse = false;
+        region.parent = regionID;
+        std::vector<RSGISPxlRun>().swap(region.runs);
+        this->freeRegionIDs.push_back(regionID);
+    }
+
+    void RSGISRasterPolygoniser::writeRegion(size_t regionID)
+    {
+        std::vector<RSGISPxlRing> rings;
+        RSGISRasterPolygoniser::traceRings(this->regions[regionID].runs, &rings);
+
+        OGRFeature *feature = OGRFeature::CreateFeature(this->layer->GetLayerDefn());
+        if(this->valFieldIdx >= 0)
+        {
+            if(this->valFieldIsReal)
+            {
+                feature->SetField(this->valFieldIdx, this->regions[regionID].val);
+            }
+            else
+            {
+                feature->SetField(this->valFieldIdx, (GIntBig)this->regions[regionID].val);
+            }
+        }
+        feature->SetGeometryDirectly(this->createGeometry(rings));
+        if(this->layer->CreateFeature(feature) != OGRERR_NONE)
+        {
+            OGRFeature::DestroyFeature(feature);
+            throw RSGISVectorException("Failed to write feature to the output layer.");
+        }
+        OGRFeature::DestroyFeature(feature);
+        ++this->numFeats;
+        ++this->numFeatsInBatch;
+
+        if(this->useTransactions && (this->numFeatsInBatch >= this->featBatchSize))
+        {
+            if((this->layer->CommitTransaction() != OGRERR_NONE) || (this->layer->StartTransaction() != OGRERR_NONE))
+            {
+                throw RSGISVectorException("Could not commit the features to the output layer.");
+            }
+            this->numFeatsInBatch = 0;
+        }
+    }
+
+    OGRGeometry* RSGISRasterPolygoniser::createGeometry(std::vector<RSGISPxlRing> &rings)
+    {
+        const long dirX[4] = {1, 0, -1, 0};
+        const long dirY[4] = {0, 1, 0, -1};
+
+        std::vector<size_t> outers;
+        std::vector<double> outerAreas;
+        std::vector<std::vector<size_t> > outerHoles;
+        std::vector<size_t> holes;
+        for(size_t i = 0; i < rings.size(); ++i)
+        {
+            double area = RSGISRasterPolygoniser::ringArea(rings[i]);
+            if(area > 0)
+            {
+                outers.push_back(i);
+                outerAreas.push_back(area);
+                outerHoles.push_back(std::vector<size_t>());
+            }
+            else
+            {
+                holes.push_back(i);
+            }
+        }
+
+        for(std::vector<size_t>::iterator iterHole = holes.begin(); iterHole != holes.end(); ++iterHole)
+        {
+            if(outers.size() == 1)
+            {
+                outerHoles[0].push_back(*iterHole);
+                continue;
+            }
+            // Test the centre of the region pixel on the right of the first edge of the hole.
+            RSGISPxlRing &hole = rings[*iterHole];
+            long dX = hole[1].first - hole[0].first;
+            long dY = hole[1].second - hole[0].second;
+            int dir = (dX > 0)?0:((dY > 0)?1:((dX < 0)?2:3));
+            double ptX = hole[0].first + (0.5 * dirX[dir]) + (0.5 * dirX[(dir+1)%4]);
+            double ptY = hole[0].second + (0.5 * dirY[dir]) + (0.5 * dirY[(dir+1)%4]);
+            size_t bestOuter = 0;
+            bool found = false;
+            for(size_t n = 0; n < outers.size(); ++n)
+            {
+                if(RSGISRasterPolygoniser::pointInRing(ptX, ptY, rings[outers[n]]))
+                {
+                    if((!found) || (outerAreas[n] < outerAreas[bestOuter]))
+                    {
+                        bestOuter = n;
+                        found = true;
+                    }
+                }
+            }
+            if(!found)
+            {
+                throw RSGISVectorException("Could not find the outer ring for a hole.");
+            }
+            outerHoles[bestOuter].push_back(*iterHole);
+        }
+
+        std::vector<OGRPolygon*> polys;
+        for(size_t n = 0; n < outers.size(); ++n)
+        {
+            OGRPolygon *poly = new OGRPolygon();
+            for(int r = -1; r < (int)outerHoles[n].size(); ++r)
+            {
+                RSGISPxlRing &ring = rings[(r < 0)?outers[n]:outerHoles[n][r]];
+                OGRLinearRing *ogrRing = new OGRLinearRing();
+                ogrRing->setNumPoints(ring.size()+1);
+                for(size_t i = 0; i <= ring.size(); ++i)
+                {
+                    const std::pair<long, long> &pt = ring[i % ring.size()];
+                    double x = this->geoTrans[0] + (pt.first * this->geoTrans[1]) + (pt.second * this->geoTrans[2]);
+                    double y = this->geoTrans[3] + (pt.first * this->geoTrans[4]) + (pt.second * this->geoTrans[5]);
+                    ogrRing->setPoint(i, x, y);
+                }
+                poly->addRingDirectly(ogrRing);
+            }
+            polys.push_back(poly);
+        }
+
+        // With 8 connectivity the layer is a multi-polygon layer so all the features are multi-polygons.
+        if((polys.size() == 1) && (!this->use8Conn))
+        {
+            return polys[0];
+        }
+        OGRMultiPolygon *multiPoly = new OGRMultiPolygon();
+        for(std::vector<OGRPolygon*>::iterator iterPoly = polys.begin(); iterPoly != polys.end(); ++iterPoly)
+        {
+            multiPoly->addGeometryDirectly(*iterPoly);
+        }
+        return multiPoly;
+    }
+
+    RSGISRasterPolygoniser::~RSGISRasterPolygoniser()
+    {
+
+    }
+
+}}
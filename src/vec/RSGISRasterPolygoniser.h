@@ -0,0 +1,133 @@
+/*
+ *  RSGISRasterPolygoniser.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISRasterPolygoniser_H
+#define RSGISRasterPolygoniser_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "gdal_priv.h"
+#include "ogrsf_frmts.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISVectorException.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_vec_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace vec{
+
+    /** A run of pixels [x0, x1) on row y. */
+    struct DllExport RSGISPxlRun
+    {
+        unsigned int x0;
+        unsigned int x1;
+        unsigned int y;
+    };
+
+    /** A ring of pixel corner coordinates; the first vertex is not repeated at the end. */
+    typedef std::vector<std::pair<long, long> > RSGISPxlRing;
+
+    /**
+     * Converts a raster to polygons, one feature per connected region of equal
+     * pixel value. The image is read in strips and each row is converted to runs
+     * of equal value which are linked to the runs of the previous row with a
+     * union-find, so only the runs of the regions which are still open are held
+     * in memory. Once a region is closed (i.e., it has no runs on the current row)
+     * its boundary is traced from the runs into rings and it is written to the
+     * layer, with features written in transactions of featBatchSize.
+     *
+     * Pixels which are 0 in the mask band (if provided), are the band no data
+     * value or are NaN are not polygonised. Where pixels touch diagonally the
+     * rings are split at the shared vertex, so each ring is simple (rings only
+     * touch at a vertex, as allowed for valid polygons). A 4 connected region is
+     * output as a polygon; with 8 connectivity all the regions are output as
+     * multi-polygons, as regions connected only diagonally have more than one
+     * outer ring.
+     */
+    class DllExport RSGISRasterPolygoniser
+    {
+    public:
+        RSGISRasterPolygoniser(bool use8Conn=false, unsigned int featBatchSize=10000);
+        /** Returns the number of features written. */
+        unsigned long polygonise(GDALRasterBand *band, GDALRasterBand *maskBand, OGRLayer *layer, int valFieldIdx);
+        /** Traces the boundary of a region into rings, outer rings have a positive area and holes negative. */
+        static void traceRings(std::vector<RSGISPxlRun> &runs, std::vector<RSGISPxlRing> *rings);
+        /** The signed area of a ring (in pixels). */
+        static double ringArea(const RSGISPxlRing &ring);
+        /** Tests whether a point is within a ring (even-odd rule). */
+        static bool pointInRing(double x, double y, const RSGISPxlRing &ring);
+        ~RSGISRasterPolygoniser();
+    protected:
+        struct RSGISPolyRegion
+        {
+            size_t parent;
+            double val;
+            unsigned int lastRow;
+            bool inUse;
+            std::vector<RSGISPxlRun> runs;
+        };
+        struct RSGISRowRun
+        {
+            unsigned int x0;
+            unsigned int x1;
+            double val;
+            size_t regionID;
+        };
+        size_t createRegion(double val);
+        size_t findRegion(size_t regionID);
+        size_t mergeRegions(size_t regionA, size_t regionB);
+        void freeRegion(size_t regionID);
+        void writeRegion(size_t regionID);
+        OGRGeometry* createGeometry(std::vector<RSGISPxlRing> &rings);
+        bool use8Conn;
+        unsigned int featBatchSize;
+        std::vector<RSGISPolyRegion> regions;
+        std::vector<size_t> freeRegionIDs;
+        OGRLayer *layer;
+        int valFieldIdx;
+        bool valFieldIsReal;
+        bool useTransactions;
+        unsigned long numFeats;
+        unsigned long numFeatsInBatch;
+        double geoTrans[6];
+    };
+
+}}
+
+#endif
@@ -0,0 +1,513 @@
+/*
+ *  RSGISZonalBandStats.cpp
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RSGISZonalBandStats.h"
+
+namespace rsgis{namespace vec{
+
+    RSGISZonalBandStats::RSGISZonalBandStats(unsigned int numThreads, unsigned int stripHeight)
+    {
+        this->numThreads = numThreads;
+        this->stripHeight = (stripHeight > 0)?stripHeight:1;
+        this->calcValStats = false;
+    }
+
+    unsigned long RSGISZonalBandStats::calcZonalStats(OGRLayer *layer, GDALDataset *image, unsigned int band, double minThres, double maxThres, double outNoDataVal, RSGISZonalBandStatsFields fields)
+    {
+        if((band < 1) || (band > (unsigned int)image->GetRasterCount()))
+        {
+            throw RSGISVectorException("The band specified is not within the image.");
+        }
+        GDALRasterBand *imgBand = image->GetRasterBand(band);
+        int width = image->GetRasterXSize();
+        int height = image->GetRasterYSize();
+
+        double geoTrans[6];
+        image->GetGeoTransform(geoTrans);
+        if((geoTrans[2] != 0) || (geoTrans[4] != 0))
+        {
+            throw RSGISVectorException("Rotated images are not supported.");
+        }
+
+        // The output fields (as the layer field index and the statistic), which are created if not present.
+        std::string fieldNames[numZonalStats] = {fields.minField, fields.maxField, fields.meanField, fields.stdDevField, fields.sumField, fields.countField, fields.modeField, fields.medianField};
+        std::vector<std::pair<int, int> > outFields;
+        this->calcValStats = false;
+        for(int i = 0; i < numZonalStats; ++i)
+        {
+            if(fieldNames[i] == "")
+            {
+                continue;
+            }
+            int fieldIdx = layer->GetLayerDefn()->GetFieldIndex(fieldNames[i].c_str());
+            if(fieldIdx < 0)
+            {
+                OGRFieldDefn fieldDefn(fieldNames[i].c_str(), OFTReal);
+                if(layer->CreateField(&fieldDefn) != OGRERR_NONE)
+                {
+                    throw RSGISVectorException("Could not create the field '" + fieldNames[i] + "'.");
+                }
+                fieldIdx = layer->GetLayerDefn()->GetFieldIndex(fieldNames[i].c_str());
+            }
+            outFields.push_back(std::pair<int, int>(fieldIdx, i));
+            if((i == zoneMode) || (i == zoneMedian))
+            {
+                this->calcValStats = true;
+            }
+        }
+        if(outFields.empty())
+        {
+            throw RSGISVectorException("At least one output field must be specified.");
+        }
+
+        this->readPolygons(layer, geoTrans, width, height);
+        size_t numFeats = this->polys.size();
+
+        RSGISZoneAccum initAccum;
+        initAccum.min = std::numeric_limits<double>::max();
+        initAccum.max = -std::numeric_limits<double>::max();
+        initAccum.sum = 0;
+        initAccum.mean = 0;
+        initAccum.m2 = 0;
+        initAccum.count = 0;
+        this->accums.assign(numFeats, initAccum);
+        this->results.assign(numFeats * numZonalStats, outNoDataVal);
+        this->zoneVals.clear();
+        if(this->calcValStats)
+        {
+            this->zoneVals.resize(numFeats);
+        }
+
+        // Polygons in the order of their first row; those outside the image are finalised now.
+        std::vector<size_t> order;
+        order.reserve(numFeats);
+        for(size_t i = 0; i < numFeats; ++i)
+        {
+            if(this->polys[i].minRow <= this->polys[i].maxRow)
+            {
+                order.push_back(i);
+            }
+            else
+            {
+                this->finaliseZone(i, outNoDataVal);
+            }
+        }
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b){return this->polys[a].minRow < this->polys[b].minRow;});
+
+        int hasNoData = 0;
+        double noDataVal = imgBand->GetNoDataValue(&hasNoData);
+        bool useNoData = (hasNoData != 0) && (!std::isnan(noDataVal));
+
+        rsgis::RSGISThreadPool pool(this->numThreads);
+        std::vector<double> data(((size_t)width) * this->stripHeight);
+        std::vector<size_t> active;
+        size_t nextPoly = 0;
+        std::mutex mergeMutex;
+        rsgis_tqdm pbar;
+        for(int stripStart = 0; (stripStart < height) && ((nextPoly < order.size()) || (!active.empty())); stripStart += this->stripHeight)
+        {
+            pbar.progress(stripStart, height);
+            int nRows = std::min((int)this->stripHeight, height - stripStart);
+            int stripEnd = stripStart + nRows;
+            while((nextPoly < order.size()) && (this->polys[order[nextPoly]].minRow < stripEnd))
+            {
+                active.push_back(order[nextPoly]);
+                ++nextPoly;
+            }
+            if(active.empty())
+            {
+                continue;
+            }
+
+            if(imgBand->RasterIO(GF_Read, 0, stripStart, width, nRows, data.data(), width, nRows, GDT_Float64, 0, 0) != CE_None)
+            {
+                throw RSGISVectorException("Could not read image data.");
+            }
+
+            pool.parallelFor(0, nRows, [&](unsigned long rStart, unsigned long rEnd)
+            {
+                std::vector<RSGISZoneAccum> localAccums(active.size(), initAccum);
+                std::vector<std::vector<double> > localVals(this->calcValStats?active.size():0);
+                std::vector<double> crossings;
+                std::vector<std::pair<int, int> > spans;
+                for(unsigned long r = rStart; r < rEnd; ++r)
+                {
+                    int y = stripStart + r;
+                    const double *rowData = data.data() + (r * width);
+                    for(size_t k = 0; k < active.size(); ++k)
+                    {
+                        const RSGISZonePolygon &poly = this->polys[active[k]];
+                        if((y < poly.minRow) || (y > poly.maxRow))
+                        {
+                            continue;
+                        }
+                        RSGISZonalBandStats::findRowSpans(poly, y, width, &crossings, &spans);
+                        RSGISZoneAccum &acc = localAccums[k];
+                        for(auto iterSpan = spans.begin(); iterSpan != spans.end(); ++iterSpan)
+                        {
+                            for(int x = (*iterSpan).first; x < (*iterSpan).second; ++x)
+                            {
+                                double val = rowData[x];
+                                if(std::isnan(val) || (useNoData && (val == noDataVal)) || (val < minThres) || (val > maxThres))
+                                {
+                                    continue;
+                                }
+                                if(val < acc.min)
+                                {
+                                    acc.min = val;
+                                }
+                                if(val > acc.max)
+                                {
+                                    acc.max = val;
+                                }
+                                acc.sum += val;
+                                ++acc.count;
+                                double delta = val - acc.mean;
+                                acc.mean += delta / acc.count;
+                                acc.m2 += delta * (val - acc.mean);
+                                if(this->calcValStats)
+                                {
+                                    localVals[k].push_back(val);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(mergeMutex);
+                for(size_t k = 0; k < active.size(); ++k)
+                {
+                    if(localAccums[k].count == 0)
+                    {
+                        continue;
+                    }
+                    RSGISZoneAccum &acc = this->accums[active[k]];
+                    RSGISZoneAccum &local = localAccums[k];
+                    acc.min = std::min(acc.min, local.min);
+                    acc.max = std::max(acc.max, local.max);
+                    acc.sum += local.sum;
+                    // Merge the mean and sum of squared differences from the mean (Chan et al.).
+                    double nA = acc.count;
+                    double nB = local.count;
+                    double nTotal = nA + nB;
+                    double delta = local.mean - acc.mean;
+                    acc.mean += delta * (nB / nTotal);
+                    acc.m2 += local.m2 + (delta * delta * ((nA * nB) / nTotal));
+                    acc.count += local.count;
+                    if(this->calcValStats)
+                    {
+                        std::vector<double> &vals = this->zoneVals[active[k]];
+                        vals.insert(vals.end(), localVals[k].begin(), localVals[k].end());
+                    }
+                }
+            }, 8);
+
+            // Finalise the polygons the sweep has passed.
+            size_t nActive = 0;
+            for(size_t k = 0; k < active.size(); ++k)
+            {
+                if(this->polys[active[k]].maxRow < stripEnd)
+                {
+                    this->finaliseZone(active[k], outNoDataVal);
+                }
+                else
+                {
+                    active[nActive++] = active[k];
+                }
+            }
+            active.resize(nActive);
+        }
+        pbar.finish();
+
+        for(size_t k = 0; k < active.size(); ++k)
+        {
+            this->finaliseZone(active[k], outNoDataVal);
+        }
+
+        this->writeFields(layer, outFields);
+
+        this->polys.clear();
+        this->accums.clear();
+        this->zoneVals.clear();
+        this->results.clear();
+
+        return numFeats;
+    }
+
+    void RSGISZonalBandStats::findRowSpans(const RSGISZonePolygon &poly, int y, int width, std::vector<double> *crossings, std::vector<std::pair<int, int> > *spans)
+    {
+        crossings->clear();
+        spans->clear();
+        double yc = y + 0.5;
+        size_t numRings = poly.ringStarts.size();
+        for(size_t r = 0; r < numRings; ++r)
+        {
+            size_t start = poly.ringStarts[r];
+            size_t end = (r+1 < numRings)?poly.ringStarts[r+1]:(poly.verts.size()/2);
+            if(end - start < 2)
+            {
+                continue;
+            }
+            for(size_t i = start; i < end; ++i)
+            {
+                size_t j = (i+1 < end)?(i+1):start;
+                double x0 = poly.verts[i*2];
+                double y0 = poly.verts[i*2+1];
+                double x1 = poly.verts[j*2];
+                double y1 = poly.verts[j*2+1];
+                // Half open so a vertex on the row centre is only counted once.
+                if((y0 <= yc) != (y1 <= yc))
+                {
+                    crossings->push_back(x0 + ((yc - y0) * (x1 - x0) / (y1 - y0)));
+                }
+            }
+        }
+        std::sort(crossings->begin(), crossings->end());
+
+        for(size_t i = 0; i+1 < crossings->size(); i += 2)
+        {
+            // The pixels with centres in [xa, xb).
+            double xStart = std::ceil(crossings->at(i) - 0.5);
+            double xEnd = std::ceil(crossings->at(i+1) - 0.5);
+            xStart = std::max(xStart, 0.0);
+            xEnd = std::min(xEnd, (double)width);
+            if(xEnd > xStart)
+            {
+                spans->push_back(std::pair<int, int>((int)xStart, (int)xEnd));
+            }
+        }
+    }
+
+    double RSGISZonalBandStats::calcMedian(std::vector<double> &vals)
+    {
+        if(vals.empty())
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        size_t mid = vals.size() / 2;
+        std::nth_element(vals.begin(), vals.begin() + mid, vals.end());
+        double median = vals[mid];
+        if((vals.size() % 2) == 0)
+        {
+            double lower = *std::max_element(vals.begin(), vals.begin() + mid);
+            median = (lower + median) / 2.0;
+        }
+        return median;
+    }
+
+    double RSGISZonalBandStats::calcMode(std::vector<double> &vals)
+    {
+        if(vals.empty())
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        std::sort(vals.begin(), vals.end());
+        double mode = vals[0];
+        size_t modeCount = 0;
+        size_t i = 0;
+        while(i < vals.size())
+        {
+            size_t j = i + 1;
+            while((j < vals.size()) && (vals[j] == vals[i]))
+            {
+                ++j;
+            }
+            if((j - i) > modeCount)
+            {
+                modeCount = j - i;
+                mode = vals[i];
+            }
+            i = j;
+        }
+        return mode;
+    }
+
+    void RSGISZonalBandStats::readPolygons(OGRLayer *layer, double *geoTrans, int width, int height)
+    {
+        this->polys.clear();
+        layer->ResetReading();
+        OGRFeature *feat = NULL;
+        while((feat = layer->GetNextFeature()) != NULL)
+        {
+            RSGISZonePolygon poly;
+            poly.featIdx = this->polys.size();
+            poly.minRow = 1;
+            poly.maxRow = 0;
+            OGRGeometry *geom = feat->GetGeometryRef();
+            if(geom != NULL)
+            {
+                this->addGeometry(geom, geoTrans, &poly);
+            }
+            OGRFeature::DestroyFeature(feat);
+
+            if(poly.verts.size() >= 6)
+            {
+                double minY = poly.verts[1];
+                double maxY = poly.verts[1];
+                for(size_t i = 3; i < poly.verts.size(); i += 2)
+                {
+                    minY = std::min(minY, poly.verts[i]);
+                    maxY = std::max(maxY, poly.verts[i]);
+                }
+                // The rows whose pixel centres are within the polygon's extent.
+                double minRow = std::max(std::ceil(minY - 0.5), 0.0);
+                double maxRow = std::min(std::floor(maxY - 0.5), (double)(height-1));
+                if(minRow <= maxRow)
+                {
+                    poly.minRow = (int)minRow;
+                    poly.maxRow = (int)maxRow;
+                }
+                // Polygons entirely to the left or right of the image have no pixels.
+                double minX = poly.verts[0];
+                double maxX = poly.verts[0];
+                for(size_t i = 2; i < poly.verts.size(); i += 2)
+                {
+                    minX = std::min(minX, poly.verts[i]);
+                    maxX = std::max(maxX, poly.verts[i]);
+                }
+                if((maxX < 0) || (minX > width))
+                {
+                    poly.minRow = 1;
+                    poly.maxRow = 0;
+                }
+            }
+            if(poly.minRow > poly.maxRow)
+            {
+                poly.verts.clear();
+                poly.ringStarts.clear();
+            }
+            this->polys.push_back(poly);
+        }
+    }
+
+    void RSGISZonalBandStats::addGeometry(OGRGeometry *geom, double *geoTrans, RSGISZonePolygon *poly)
+    {
+        OGRwkbGeometryType geomType = wkbFlatten(geom->getGeometryType());
+        if(geomType == wkbPolygon)
+        {
+            OGRPolygon *polygon = (OGRPolygon*)geom;
+            int numRings = polygon->getNumInteriorRings() + 1;
+            for(int r = 0; r < numRings; ++r)
+            {
+                OGRLinearRing *ring = (r == 0)?polygon->getExteriorRing():polygon->getInteriorRing(r-1);
+                if(ring == NULL)
+                {
+                    continue;
+                }
+                int numPts = ring->getNumPoints();
+                if(numPts < 3)
+                {
+                    continue;
+                }
+                poly->ringStarts.push_back(poly->verts.size()/2);
+                for(int i = 0; i < numPts; ++i)
+                {
+                    poly->verts.push_back((ring->getX(i) - geoTrans[0]) / geoTrans[1]);
+                    poly->verts.push_back((ring->getY(i) - geoTrans[3]) / geoTrans[5]);
+                }
+            }
+        }
+        else if((geomType == wkbMultiPolygon) || (geomType == wkbGeometryCollection))
+        {
+            OGRGeometryCollection *geomColl = (OGRGeometryCollection*)geom;
+            for(int i = 0; i < geomColl->getNumGeometries(); ++i)
+            {
+                this->addGeometry(geomColl->getGeometryRef(i), geoTrans, poly);
+            }
+        }
+    }
+
+    void RSGISZonalBandStats::finaliseZone(size_t featIdx, double outNoDataVal)
+    {
+        RSGISZoneAccum &acc = this->accums[featIdx];
+        double *res = &this->results[featIdx * numZonalStats];
+        if(acc.count > 0)
+        {
+            double var = acc.m2 / acc.count;
+            res[zoneMin] = acc.min;
+            res[zoneMax] = acc.max;
+            res[zoneMean] = acc.mean;
+            res[zoneStdDev] = (var > 0)?std::sqrt(var):0.0;
+            res[zoneSum] = acc.sum;
+            res[zoneCount] = acc.count;
+            if(this->calcValStats)
+            {
+                std::vector<double> &vals = this->zoneVals[featIdx];
+                res[zoneMedian] = RSGISZonalBandStats::calcMedian(vals);
+                res[zoneMode] = RSGISZonalBandStats::calcMode(vals);
+            }
+        }
+        if(this->calcValStats)
+        {
+            std::vector<double>().swap(this->zoneVals[featIdx]);
+        }
+        std::vector<double>().swap(this->polys[featIdx].verts);
+        std::vector<size_t>().swap(this->polys[featIdx].ringStarts);
+    }
+
+    void RSGISZonalBandStats::writeFields(OGRLayer *layer, std::vector<std::pair<int, int> > &outFields)
+    {
+        bool useTransactions = (layer->TestCapability(OLCTransactions) != 0);
+        if(useTransactions && (layer->StartTransaction() != OGRERR_NONE))
+        {
+            useTransactions = false;
+        }
+
+        size_t numFeats = this->polys.size();
+        size_t featIdx = 0;
+        layer->ResetReading();
+        OGRFeature *feat = NULL;
+        while((featIdx < numFeats) && ((feat = layer->GetNextFeature()) != NULL))
+        {
+            // Features without a geometry or outside the image are left unchanged.
+            if(this->polys[featIdx].minRow > this->polys[featIdx].maxRow)
+            {
+                OGRFeature::DestroyFeature(feat);
+                ++featIdx;
+                continue;
+            }
+            double *res = &this->results[featIdx * numZonalStats];
+            for(auto iterField = outFields.begin(); iterField != outFields.end(); ++iterField)
+            {
+                feat->SetField((*iterField).first, res[(*iterField).second]);
+            }
+            if(layer->SetFeature(feat) != OGRERR_NONE)
+            {
+                OGRFeature::DestroyFeature(feat);
+                throw RSGISVectorException("Failed to write the statistics to the feature.");
+            }
+            OGRFeature::DestroyFeature(feat);
+            ++featIdx;
+        }
+
+        if(useTransactions && (layer->CommitTransaction() != OGRERR_NONE))
+        {
+            throw RSGISVectorException("Could not commit the statistics to the layer.");
+        }
+    }
+
+    RSGISZonalBandStats::~RSGISZonalBandStats()
+    {
+
+    }
+
+}}
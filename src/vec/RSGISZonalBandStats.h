@@ -0,0 +1,152 @@
+/*
+ *  RSGISZonalBandStats.h
+ *  RSGIS_LIB
+ *
+ *  Created on 18/10/2026.
+ *  Copyright 2026 RSGISLib.
+ *
+ *  RSGISLib is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  RSGISLib is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with RSGISLib.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RSGISZonalBandStats_H
+#define RSGISZonalBandStats_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include "gdal_priv.h"
+#include "ogrsf_frmts.h"
+
+#include "common/rsgis-tqdm.h"
+#include "common/RSGISVectorException.h"
+#include "common/RSGISThreadPool.h"
+
+// mark all exported classes/functions with DllExport to have
+// them exported by Visual Studio
+#undef DllExport
+#ifdef _MSC_VER
+    #ifdef rsgis_vec_EXPORTS
+        #define DllExport   __declspec( dllexport )
+    #else
+        #define DllExport   __declspec( dllimport )
+    #endif
+#else
+    #define DllExport
+#endif
+
+namespace rsgis{namespace vec{
+
+    /** The output field names for the zonal statistics; an empty name means the statistic is not calculated. */
+    struct DllExport RSGISZonalBandStatsFields
+    {
+        std::string minField;
+        std::string maxField;
+        std::string meanField;
+        std::string stdDevField;
+        std::string sumField;
+        std::string countField;
+        std::string modeField;
+        std::string medianField;
+    };
+
+    /** A polygon in image pixel coordinates, as rings of vertices (x, y interleaved) with the start of each ring. */
+    struct DllExport RSGISZonePolygon
+    {
+        size_t featIdx;
+        int minRow;
+        int maxRow;
+        std::vector<double> verts;
+        std::vector<size_t> ringStarts;
+    };
+
+    /**
+     * Calculates zonal statistics for a band of an image for all the polygons of
+     * a layer in a single pass over the image (rather than a read and rasterisation
+     * per polygon). The polygons are read and converted to pixel coordinates, sorted
+     * by their first row and the image is then read in strips. For each row of a
+     * strip the polygons covering the row are rasterised into spans of pixels whose
+     * centres are within the polygon (as gdal.RasterizeLayer) and those pixels
+     * accumulated for the polygon, so overlapping polygons each get all their pixels.
+     * The rows of a strip are processed in parallel with accumulators for each block
+     * of rows which are merged once the block is complete. Once the sweep has passed
+     * a polygon its statistics are finalised (freeing the values held for the median
+     * and mode) and once the whole image has been processed the fields are written
+     * back to the layer in a single transaction.
+     *
+     * The standard deviation is from the running mean and sum of squared
+     * differences from the mean (Welford), so it does not lose precision for
+     * values far from zero.
+     *
+     * Pixels which are the band no data value, NaN or outside [minThres, maxThres]
+     * are ignored; polygons within the image without any valid pixels are given
+     * outNoDataVal, while the fields of features without a geometry or outside
+     * the image are not written.
+     */
+    class DllExport RSGISZonalBandStats
+    {
+    public:
+        RSGISZonalBandStats(unsigned int numThreads=1, unsigned int stripHeight=256);
+        /** Returns the number of features for which the statistics were calculated. */
+        unsigned long calcZonalStats(OGRLayer *layer, GDALDataset *image, unsigned int band, double minThres, double maxThres, double outNoDataVal, RSGISZonalBandStatsFields fields);
+        /** The spans [first, second) of the pixels on row y (0 to width-1) whose centres are within the polygon (even-odd rule). */
+        static void findRowSpans(const RSGISZonePolygon &poly, int y, int width, std::vector<double> *crossings, std::vector<std::pair<int, int> > *spans);
+        /** The median of the values (the mean of the two middle values for an even number); the values are reordered. */
+        static double calcMedian(std::vector<double> &vals);
+        /** The most frequent value (the smallest if there is more than one); the values are sorted. */
+        static double calcMode(std::vector<double> &vals);
+        ~RSGISZonalBandStats();
+    protected:
+        struct RSGISZoneAccum
+        {
+            double min;
+            double max;
+            double sum;
+            double mean;
+            double m2;
+            unsigned long count;
+        };
+        enum RSGISZonalStatIdx
+        {
+            zoneMin = 0,
+            zoneMax = 1,
+            zoneMean = 2,
+            zoneStdDev = 3,
+            zoneSum = 4,
+            zoneCount = 5,
+            zoneMode = 6,
+            zoneMedian = 7,
+            numZonalStats = 8
+        };
+        void readPolygons(OGRLayer *layer, double *geoTrans, int width, int height);
+        void addGeometry(OGRGeometry *geom, double *geoTrans, RSGISZonePolygon *poly);
+        void finaliseZone(size_t featIdx, double outNoDataVal);
+        void writeFields(OGRLayer *layer, std::vector<std::pair<int, int> > &outFields);
+        unsigned int numThreads;
+        unsigned int stripHeight;
+        bool calcValStats;
+        std::vector<RSGISZonePolygon> polys;
+        std::vector<RSGISZoneAccum> accums;
+        std::vector<std::vector<double> > zoneVals;
+        std::vector<double> results;
+    };
+
+}}
+
+#endif